@@ -120,6 +120,13 @@ public:
     ALWAYS_INLINE size_t size() const { return m_size; }
     size_t capacity() const { return m_capacity; }
 
+    // Lets code that can't call data(), like JIT-compiled code, find the elements.
+    static constexpr size_t outline_buffer_offset()
+    requires(inline_capacity == 0)
+    {
+        return __builtin_offsetof(Vector, m_outline_buffer);
+    }
+
     ALWAYS_INLINE StorageType* data()
     {
         if constexpr (inline_capacity > 0)
@@ -42,6 +42,9 @@ public:
 
     void revoke() { m_ptr = nullptr; }
 
+    // Lets code that can't call into C++, like JIT-compiled code, follow the link.
+    static constexpr size_t pointer_offset() { return __builtin_offsetof(WeakLink, m_ptr); }
+
 private:
     template<typename T>
     explicit WeakLink(T& weakable)
@@ -72,6 +72,9 @@ enum class NeedsBigProcessLock {
     S(dump_backtrace, NeedsBigProcessLock::No)             \
     S(dup2, NeedsBigProcessLock::No)                       \
     S(emuctl, NeedsBigProcessLock::No)                     \
+    S(epoll_create1, NeedsBigProcessLock::No)              \
+    S(epoll_ctl, NeedsBigProcessLock::No)                  \
+    S(epoll_pwait, NeedsBigProcessLock::No)                \
     S(execve, NeedsBigProcessLock::Yes)                    \
     S(exit, NeedsBigProcessLock::Yes)                      \
     S(exit_thread, NeedsBigProcessLock::Yes)               \
@@ -138,6 +141,7 @@ enum class NeedsBigProcessLock {
     S(pipe, NeedsBigProcessLock::No)                       \
     S(pledge, NeedsBigProcessLock::No)                     \
     S(poll, NeedsBigProcessLock::No)                       \
+    S(posix_fadvise, NeedsBigProcessLock::No)              \
     S(posix_fallocate, NeedsBigProcessLock::No)            \
     S(prctl, NeedsBigProcessLock::No)                      \
     S(profiling_disable, NeedsBigProcessLock::Yes)         \
@@ -184,6 +188,7 @@ enum class NeedsBigProcessLock {
     S(sigtimedwait, NeedsBigProcessLock::No)               \
     S(socket, NeedsBigProcessLock::No)                     \
     S(socketpair, NeedsBigProcessLock::No)                 \
+    S(splice, NeedsBigProcessLock::Yes)                    \
     S(stat, NeedsBigProcessLock::No)                       \
     S(statvfs, NeedsBigProcessLock::No)                    \
     S(symlink, NeedsBigProcessLock::No)                    \
@@ -267,6 +272,30 @@ struct SC_poll_params {
     u32 const* sigmask;
 };
 
+struct SC_splice_params {
+    int fd_in;
+    off_t* offset_in;
+    int fd_out;
+    off_t* offset_out;
+    size_t length;
+    unsigned flags;
+};
+
+struct SC_epoll_ctl_params {
+    int epfd;
+    int op;
+    int fd;
+    struct epoll_event* event;
+};
+
+struct SC_epoll_pwait_params {
+    int epfd;
+    struct epoll_event* events;
+    int maxevents;
+    const struct timespec* timeout;
+    u32 const* sigmask;
+};
+
 struct SC_clock_nanosleep_params {
     int clock_id;
     int flags;
@@ -252,6 +252,17 @@ UNMAP_AFTER_INIT bool CommandLine::disable_virtio() const
     return contains("disable_virtio"sv);
 }
 
+Optional<u64> CommandLine::disk_cache_size_limit() const
+{
+    auto value = lookup("disk_cache_size"sv);
+    if (!value.has_value())
+        return {};
+    auto size_in_mib = value->to_number<u64>();
+    if (!size_in_mib.has_value())
+        PANIC("Invalid disk_cache_size value: {}", *value);
+    return size_in_mib.value() * MiB;
+}
+
 UNMAP_AFTER_INIT AHCIResetMode CommandLine::ahci_reset_mode() const
 {
     auto const ahci_reset_mode = lookup("ahci_reset_mode"sv).value_or("controllers"sv);
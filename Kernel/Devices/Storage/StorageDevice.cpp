@@ -86,10 +86,10 @@ ErrorOr<size_t> StorageDevice::read(OpenFileDescription&, u64 offset, UserOrKern
     size_t whole_blocks = nread >> block_size_log();
     size_t remaining = nread - (whole_blocks << block_size_log());
 
-    // PATAChannel will chuck a wobbly if we try to read more than PAGE_SIZE
-    // at a time, because it uses a single page for its DMA buffer.
-    if (whole_blocks >= m_blocks_per_page) {
-        whole_blocks = m_blocks_per_page;
+    // Most drivers will chuck a wobbly if we try to read more than PAGE_SIZE
+    // at a time, because they use a single page for their DMA buffer.
+    if (whole_blocks >= max_blocks_per_request()) {
+        whole_blocks = max_blocks_per_request();
         remaining = 0;
     }
 
@@ -151,10 +151,10 @@ ErrorOr<size_t> StorageDevice::write(OpenFileDescription&, u64 offset, UserOrKer
     size_t whole_blocks = nwrite >> block_size_log();
     size_t remaining = nwrite - (whole_blocks << block_size_log());
 
-    // PATAChannel will chuck a wobbly if we try to write more than PAGE_SIZE
-    // at a time, because it uses a single page for its DMA buffer.
-    if (whole_blocks >= m_blocks_per_page) {
-        whole_blocks = m_blocks_per_page;
+    // Most drivers will chuck a wobbly if we try to write more than PAGE_SIZE
+    // at a time, because they use a single page for their DMA buffer.
+    if (whole_blocks >= max_blocks_per_request()) {
+        whole_blocks = max_blocks_per_request();
         remaining = 0;
     }
 
@@ -88,6 +88,9 @@ protected:
     // ^DiskDevice
     virtual StringView class_name() const override;
 
+    // The largest number of blocks we hand to the driver in a single request.
+    virtual size_t max_blocks_per_request() const { return m_blocks_per_page; }
+
 private:
     virtual ErrorOr<void> after_inserting() override;
     virtual void will_be_destroyed() override;
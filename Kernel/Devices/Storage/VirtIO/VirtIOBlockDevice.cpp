@@ -123,6 +123,12 @@ UNMAP_AFTER_INIT ErrorOr<void> VirtIOBlockDevice::initialize_virtio_resources()
     return {};
 }
 
+size_t VirtIOBlockDevice::max_blocks_per_request() const
+{
+    // NOTE: We leave a page of room for the request trailer that follows the data.
+    return (INFLIGHT_BUFFER_SIZE - PAGE_SIZE) / SECTOR_SIZE;
+}
+
 ErrorOr<void> VirtIOBlockDevice::handle_device_config_change()
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIOBlockDevice::handle_device_config_change");
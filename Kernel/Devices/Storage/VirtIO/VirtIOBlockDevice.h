@@ -25,6 +25,9 @@ public:
     virtual void start_request(AsyncBlockDeviceRequest&) override;
 
 protected:
+    // ^StorageDevice
+    virtual size_t max_blocks_per_request() const override;
+
     // ^VirtIO::Device
     virtual ErrorOr<void> initialize_virtio_resources() override;
     virtual void handle_queue_update(u16 queue_index) override;
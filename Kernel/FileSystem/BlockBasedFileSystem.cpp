@@ -4,97 +4,187 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashTable.h>
 #include <AK/IntrusiveList.h>
+#include <AK/QuickSort.h>
+#include <Kernel/Boot/CommandLine.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Tasks/Process.h>
 
 namespace Kernel {
 
+struct DiskCacheChunk;
+
 struct CacheEntry {
     IntrusiveListNode<CacheEntry> list_node;
+    IntrusiveListNode<CacheEntry> dirty_list_node;
     BlockBasedFileSystem::BlockIndex block_index { 0 };
     u8* data { nullptr };
+    DiskCacheChunk* chunk { nullptr };
     bool has_data { false };
+    bool is_in_use { false };
+    bool is_frequently_used { false };
 };
 
-class DiskCache {
+// The cache grows and shrinks in chunks of entries, each with its own backing memory for the block data.
+struct DiskCacheChunk {
+    static constexpr size_t EntryCount = 256;
+
+    ~DiskCacheChunk()
+    {
+        for (size_t i = 0; i < EntryCount; ++i)
+            entries()[i].~CacheEntry();
+    }
+
+    CacheEntry* entries() { return (CacheEntry*)entries_buffer->data(); }
+
+    NonnullOwnPtr<KBuffer> block_data;
+    NonnullOwnPtr<KBuffer> entries_buffer;
+};
+
+// A shard of the disk cache, responsible for a fixed subset of the block indices.
+// Replacement follows the 2Q policy: blocks seen for the first time go into a FIFO
+// of recently used entries, and only blocks that are requested again after falling
+// out of it (which we remember in a bounded "ghost" set) make it into the LRU list
+// of frequently used entries. That way a single pass over a large file can only
+// ever evict other blocks that were also only used once.
+class DiskCacheShard {
 public:
-    static constexpr size_t EntryCount = 10000;
-    explicit DiskCache(BlockBasedFileSystem& fs, NonnullOwnPtr<KBuffer> cached_block_data, NonnullOwnPtr<KBuffer> entries_buffer)
-        : m_fs(fs)
-        , m_cached_block_data(move(cached_block_data))
-        , m_entries(move(entries_buffer))
+    DiskCacheShard() = default;
+
+    ~DiskCacheShard()
     {
-        for (size_t i = 0; i < EntryCount; ++i) {
-            entries()[i].data = m_cached_block_data->data() + i * m_fs->logical_block_size();
-            m_clean_list.append(entries()[i]);
-        }
+        m_free_list.clear();
+        m_recently_used_list.clear();
+        m_frequently_used_list.clear();
+        m_dirty_list.clear();
     }
 
-    ~DiskCache() = default;
+    size_t chunk_count() const { return m_chunks.size(); }
+    bool has_free_entries() const { return !m_free_list.is_empty(); }
 
     bool is_dirty() const { return !m_dirty_list.is_empty(); }
-    bool entry_is_dirty(CacheEntry const& entry) const { return m_dirty_list.contains(entry); }
+    bool entry_is_dirty(CacheEntry const& entry) const { return entry.dirty_list_node.is_in_list(); }
+
+    // Bumped whenever a block of this shard is written or written back, so that BlockBasedFileSystem::prefetch_blocks()
+    // can tell that what it read may be stale. Evicting doesn't have to bump it, as only clean blocks are evicted.
+    u64 generation() const { return m_generation; }
 
     void mark_all_clean()
     {
-        while (auto* entry = m_dirty_list.first())
-            m_clean_list.prepend(*entry);
+        m_dirty_list.clear();
+        ++m_generation;
     }
 
     void mark_dirty(CacheEntry& entry)
     {
-        m_dirty_list.prepend(entry);
+        if (!entry_is_dirty(entry))
+            m_dirty_list.append(entry);
+        ++m_generation;
     }
 
     void mark_clean(CacheEntry& entry)
     {
-        m_clean_list.prepend(entry);
+        m_dirty_list.remove(entry);
+        ++m_generation;
+    }
+
+    ErrorOr<void> add_chunk(size_t block_size)
+    {
+        auto block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, DiskCacheChunk::EntryCount * block_size));
+        auto entries_buffer = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, DiskCacheChunk::EntryCount * sizeof(CacheEntry)));
+        auto chunk = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCacheChunk { move(block_data), move(entries_buffer) }));
+        TRY(m_chunks.try_ensure_capacity(m_chunks.size() + 1));
+
+        for (size_t i = 0; i < DiskCacheChunk::EntryCount; ++i) {
+            auto* entry = new (&chunk->entries()[i]) CacheEntry;
+            entry->data = chunk->block_data->data() + i * block_size;
+            entry->chunk = chunk.ptr();
+            m_free_list.append(*entry);
+        }
+        m_chunks.unchecked_append(move(chunk));
+        return {};
     }
 
-    CacheEntry* get(BlockBasedFileSystem::BlockIndex block_index) const
+    CacheEntry* get(BlockBasedFileSystem::BlockIndex block_index)
     {
         auto it = m_hash.find(block_index);
         if (it == m_hash.end())
             return nullptr;
-        auto& entry = const_cast<CacheEntry&>(*it->value);
+        auto& entry = *it->value;
         VERIFY(entry.block_index == block_index);
-        if (!entry_is_dirty(entry) && (m_clean_list.first() != &entry)) {
-            // Cache hit! Promote the entry to the front of the list.
-            m_clean_list.prepend(entry);
-        }
+        // Cache hit! Frequently used entries are kept in LRU order, recently used
+        // ones stay in FIFO order so that repeated accesses in quick succession
+        // (e.g. several small reads from the same block) don't promote them.
+        if (entry.is_frequently_used && m_frequently_used_list.first() != &entry)
+            m_frequently_used_list.prepend(entry);
         return &entry;
     }
 
-    ErrorOr<CacheEntry*> ensure(BlockBasedFileSystem::BlockIndex block_index) const
+    // Returns an entry for the given block, which may have to be evicted from the cache first.
+    // If the only entries we could evict are dirty, flush_dirty_entries is called to write them back.
+    template<typename FlushDirtyEntries>
+    ErrorOr<CacheEntry*> ensure(BlockBasedFileSystem::BlockIndex block_index, FlushDirtyEntries flush_dirty_entries)
     {
         if (auto* entry = get(block_index))
             return entry;
 
-        if (m_clean_list.is_empty()) {
-            // Not a single clean entry! Flush writes and try again.
-            // NOTE: We want to make sure we only call FileBackedFileSystem flush here,
-            //       not some FileBackedFileSystem subclass flush!
-            m_fs->flush_writes_impl();
-            return ensure(block_index);
+        auto* new_entry = m_free_list.take_first();
+        if (!new_entry) {
+            new_entry = find_entry_to_evict();
+            if (entry_is_dirty(*new_entry)) {
+                flush_dirty_entries(*this);
+                mark_all_clean();
+            }
+            evict(*new_entry);
+            new_entry = m_free_list.take_first();
+            VERIFY(new_entry);
         }
 
-        VERIFY(m_clean_list.last());
-        auto& new_entry = *m_clean_list.last();
-        m_clean_list.prepend(new_entry);
-
-        m_hash.remove(new_entry.block_index);
-        TRY(m_hash.try_set(block_index, &new_entry));
+        if (auto result = m_hash.try_set(block_index, new_entry); result.is_error()) {
+            m_free_list.append(*new_entry);
+            return result.release_error();
+        }
 
-        new_entry.block_index = block_index;
-        new_entry.has_data = false;
+        new_entry->block_index = block_index;
+        new_entry->has_data = false;
+        new_entry->is_in_use = true;
+        new_entry->is_frequently_used = m_ghosts.remove(block_index);
+        if (new_entry->is_frequently_used) {
+            m_frequently_used_list.prepend(*new_entry);
+        } else {
+            m_recently_used_list.prepend(*new_entry);
+            ++m_recently_used_count;
+        }
+        return new_entry;
+    }
 
-        return &new_entry;
+    // Drops the given block from the cache, e.g. because it was written to the device directly.
+    void forget(BlockBasedFileSystem::BlockIndex block_index)
+    {
+        auto* entry = m_hash.get(block_index).value_or(nullptr);
+        if (!entry)
+            return;
+        mark_clean(*entry);
+        evict(*entry, RememberEvictedBlock::No);
     }
 
-    CacheEntry const* entries() const { return (CacheEntry const*)m_entries->data(); }
-    CacheEntry* entries() { return (CacheEntry*)m_entries->data(); }
+    // Gives back the memory of the most recently added chunk, evicting all of its entries.
+    // The caller has to make sure that none of them are dirty.
+    void release_last_chunk()
+    {
+        VERIFY(!m_chunks.is_empty());
+        auto chunk = m_chunks.take_last();
+        for (size_t i = 0; i < DiskCacheChunk::EntryCount; ++i) {
+            auto& entry = chunk->entries()[i];
+            VERIFY(!entry_is_dirty(entry));
+            if (entry.is_in_use)
+                evict(entry, RememberEvictedBlock::No);
+            m_free_list.remove(entry);
+        }
+    }
 
     template<typename Callback>
     void for_each_dirty_entry(Callback callback)
@@ -104,15 +194,160 @@ public:
     }
 
 private:
+    size_t capacity() const { return m_chunks.size() * DiskCacheChunk::EntryCount; }
+
+    // As suggested by the 2Q paper, a quarter of the shard holds blocks that were only
+    // used once, and we remember half a shard's worth of blocks that we evicted from it.
+    size_t recently_used_target() const { return max<size_t>(capacity() / 4, 1); }
+    size_t ghost_capacity() const { return capacity() / 2; }
+
+    CacheEntry* find_entry_to_evict()
+    {
+        auto* entry = m_recently_used_count >= recently_used_target() ? m_recently_used_list.last() : m_frequently_used_list.last();
+        if (!entry)
+            entry = m_recently_used_list.last();
+        if (!entry)
+            entry = m_frequently_used_list.last();
+        VERIFY(entry);
+        return entry;
+    }
+
+    enum class RememberEvictedBlock {
+        No,
+        Yes,
+    };
+
+    void evict(CacheEntry& entry, RememberEvictedBlock remember_evicted_block = RememberEvictedBlock::Yes)
+    {
+        VERIFY(entry.is_in_use);
+        VERIFY(!entry_is_dirty(entry));
+        m_hash.remove(entry.block_index);
+        if (!entry.is_frequently_used) {
+            --m_recently_used_count;
+            if (remember_evicted_block == RememberEvictedBlock::Yes)
+                remember_ghost(entry.block_index);
+        }
+        entry.is_in_use = false;
+        entry.is_frequently_used = false;
+        entry.has_data = false;
+        m_free_list.append(entry);
+    }
+
+    void remember_ghost(BlockBasedFileSystem::BlockIndex block_index)
+    {
+        if (ghost_capacity() == 0)
+            return;
+        if (m_ghost_queue.size() < ghost_capacity()) {
+            if (m_ghost_queue.try_append(block_index).is_error())
+                return;
+        } else {
+            m_ghost_queue_head %= m_ghost_queue.size();
+            m_ghosts.remove(m_ghost_queue[m_ghost_queue_head]);
+            m_ghost_queue[m_ghost_queue_head++] = block_index;
+        }
+        (void)m_ghosts.try_set(block_index);
+    }
+
+    Vector<NonnullOwnPtr<DiskCacheChunk>> m_chunks;
+
+    // NOTE: The lists must be cleared before m_chunks is destroyed, as their entries are allocated from it.
+    IntrusiveList<&CacheEntry::list_node> m_free_list;
+    IntrusiveList<&CacheEntry::list_node> m_recently_used_list;
+    IntrusiveList<&CacheEntry::list_node> m_frequently_used_list;
+    IntrusiveList<&CacheEntry::dirty_list_node> m_dirty_list;
+    size_t m_recently_used_count { 0 };
+
+    HashMap<BlockBasedFileSystem::BlockIndex, CacheEntry*> m_hash;
+
+    HashTable<BlockBasedFileSystem::BlockIndex> m_ghosts;
+    Vector<BlockBasedFileSystem::BlockIndex> m_ghost_queue;
+    size_t m_ghost_queue_head { 0 };
+
+    u64 m_generation { 0 };
+};
+
+class DiskCache {
+public:
+    // Blocks are spread over the shards by index, so that accesses to different
+    // blocks of the same filesystem rarely have to wait for each other.
+    // Runs of consecutive blocks stay in the same shard, so that we can write them back together.
+    static constexpr size_t ShardCount = 16;
+    static constexpr size_t BlocksPerShardStripe = 64;
+
+    static ErrorOr<NonnullOwnPtr<DiskCache>> try_create(BlockBasedFileSystem& fs)
+    {
+        auto cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(fs)));
+        for (auto& shard : cache->m_shards) {
+            TRY(shard.with_exclusive([&](auto& shard) {
+                return shard.add_chunk(fs.logical_block_size());
+            }));
+        }
+        cache->m_chunk_count = ShardCount;
+        return cache;
+    }
+
+    ~DiskCache() = default;
+
+    template<typename Callback>
+    decltype(auto) with_shard_for(BlockBasedFileSystem::BlockIndex block_index, Callback callback) const
+    {
+        return m_shards[u64_hash(block_index.value() / BlocksPerShardStripe) % ShardCount].with_exclusive([&](DiskCacheShard& shard) {
+            return callback(shard);
+        });
+    }
+
+    template<typename Callback>
+    void for_each_shard(Callback callback) const
+    {
+        for (auto& shard : m_shards) {
+            shard.with_exclusive([&](DiskCacheShard& shard) {
+                callback(shard);
+            });
+        }
+    }
+
+    // Called with the shard locked when it has no free entries left. Rather than evicting
+    // something, we'd like to grow the shard, as long as there is plenty of free memory.
+    void try_grow(DiskCacheShard& shard) const
+    {
+        if (m_chunk_count * chunk_size() >= m_maximum_size)
+            return;
+        auto memory_info = MM.get_system_memory_info();
+        if (memory_info.physical_pages_uncommitted < memory_info.physical_pages / 8)
+            return;
+        if (shard.add_chunk(m_fs->logical_block_size()).is_error())
+            return;
+        ++m_chunk_count;
+    }
+
+    // Gives memory back to the system when it is running low. Dirty blocks have to
+    // be flushed before calling this.
+    void shrink_if_under_memory_pressure(DiskCacheShard& shard) const
+    {
+        if (shard.chunk_count() <= 1 || shard.is_dirty())
+            return;
+        auto memory_info = MM.get_system_memory_info();
+        if (memory_info.physical_pages_uncommitted >= memory_info.physical_pages / 16)
+            return;
+        shard.release_last_chunk();
+        --m_chunk_count;
+    }
+
+    size_t size() const { return m_chunk_count * chunk_size(); }
+
+private:
+    explicit DiskCache(BlockBasedFileSystem& fs)
+        : m_fs(fs)
+        , m_maximum_size(kernel_command_line().disk_cache_size_limit().value_or(NumericLimits<u64>::max()))
+    {
+    }
+
+    size_t chunk_size() const { return DiskCacheChunk::EntryCount * m_fs->logical_block_size(); }
+
     mutable NonnullRefPtr<BlockBasedFileSystem> m_fs;
-    NonnullOwnPtr<KBuffer> m_cached_block_data;
-
-    // NOTE: m_entries must be declared before m_dirty_list and m_clean_list because their entries are allocated from it.
-    // We need to ensure that the destructors of m_dirty_list and m_clean_list are called before m_entries is destroyed.
-    NonnullOwnPtr<KBuffer> m_entries;
-    mutable IntrusiveList<&CacheEntry::list_node> m_dirty_list;
-    mutable IntrusiveList<&CacheEntry::list_node> m_clean_list;
-    mutable HashMap<BlockBasedFileSystem::BlockIndex, CacheEntry*> m_hash;
+    mutable Array<MutexProtected<DiskCacheShard>, ShardCount> m_shards;
+    u64 const m_maximum_size;
+    mutable Atomic<size_t> m_chunk_count { 0 };
 };
 
 BlockBasedFileSystem::BlockBasedFileSystem(OpenFileDescription& file_description)
@@ -136,9 +371,7 @@ ErrorOr<void> BlockBasedFileSystem::initialize_while_locked()
     VERIFY(m_lock.is_locked());
     VERIFY(!is_initialized_while_locked());
     VERIFY(logical_block_size() != 0);
-    auto cached_block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, DiskCache::EntryCount * logical_block_size()));
-    auto entries_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, DiskCache::EntryCount * sizeof(CacheEntry)));
-    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(*this, move(cached_block_data), move(entries_data))));
+    auto disk_cache = TRY(DiskCache::try_create(*this));
 
     m_cache.with_exclusive([&](auto& cache) {
         cache = move(disk_cache);
@@ -159,25 +392,32 @@ ErrorOr<void> BlockBasedFileSystem::write_block(BlockIndex index, UserOrKernelBu
 
     TRY(data.read(buffered_data.bytes()));
 
-    return m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
+    return m_cache.with_shared([&](auto& cache) -> ErrorOr<void> {
         if (!allow_cache) {
-            flush_specific_block_if_needed(index);
+            ++m_direct_write_generation;
+            flush_specific_block_if_needed(*cache, index);
             u64 base_offset = index.value() * logical_block_size() + offset;
             auto nwritten = TRY(file_description().write(base_offset, data, count));
             VERIFY(nwritten == count);
+            // Make sure we neither hand out nor write back the stale cached copy later on.
+            cache->with_shard_for(index, [&](DiskCacheShard& shard) {
+                shard.forget(index);
+            });
             return {};
         }
 
-        auto entry = TRY(cache->ensure(index));
-        if (count < logical_block_size()) {
-            // Fill the cache first.
-            TRY(read_block(index, nullptr, logical_block_size()));
-        }
-        memcpy(entry->data + offset, buffered_data.data(), count);
+        return cache->with_shard_for(index, [&](DiskCacheShard& shard) -> ErrorOr<void> {
+            auto* entry = TRY(ensure_cache_entry(*cache, shard, index));
+            if (count < logical_block_size()) {
+                // Fill the cache first.
+                TRY(fill_cache_entry(*entry));
+            }
+            memcpy(entry->data + offset, buffered_data.data(), count);
 
-        cache->mark_dirty(*entry);
-        entry->has_data = true;
-        return {};
+            shard.mark_dirty(*entry);
+            entry->has_data = true;
+            return {};
+        });
     });
 }
 
@@ -191,6 +431,7 @@ ErrorOr<void> BlockBasedFileSystem::raw_read(BlockIndex index, UserOrKernelBuffe
 
 ErrorOr<void> BlockBasedFileSystem::raw_write(BlockIndex index, UserOrKernelBuffer const& buffer)
 {
+    ++m_direct_write_generation;
     auto base_offset = index.value() * m_device_block_size;
     auto nwritten = TRY(file_description().write(base_offset, buffer, m_device_block_size));
     VERIFY(nwritten == m_device_block_size);
@@ -233,26 +474,22 @@ ErrorOr<void> BlockBasedFileSystem::read_block(BlockIndex index, UserOrKernelBuf
     VERIFY(offset + count <= logical_block_size());
     dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem::read_block {}", index);
 
-    return m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
+    return m_cache.with_shared([&](auto& cache) -> ErrorOr<void> {
         if (!allow_cache) {
-            const_cast<BlockBasedFileSystem*>(this)->flush_specific_block_if_needed(index);
+            const_cast<BlockBasedFileSystem*>(this)->flush_specific_block_if_needed(*cache, index);
             u64 base_offset = index.value() * logical_block_size() + offset;
             auto nread = TRY(file_description().read(*buffer, base_offset, count));
             VERIFY(nread == count);
             return {};
         }
 
-        auto* entry = TRY(cache->ensure(index));
-        if (!entry->has_data) {
-            auto base_offset = index.value() * logical_block_size();
-            auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry->data);
-            auto nread = TRY(file_description().read(entry_data_buffer, base_offset, logical_block_size()));
-            VERIFY(nread == logical_block_size());
-            entry->has_data = true;
-        }
-        if (buffer)
-            TRY(buffer->write(entry->data + offset, count));
-        return {};
+        return cache->with_shard_for(index, [&](DiskCacheShard& shard) -> ErrorOr<void> {
+            auto* entry = TRY(ensure_cache_entry(*cache, shard, index));
+            TRY(fill_cache_entry(*entry));
+            if (buffer)
+                TRY(buffer->write(entry->data + offset, count));
+            return {};
+        });
     });
 }
 
@@ -272,15 +509,108 @@ ErrorOr<void> BlockBasedFileSystem::read_blocks(BlockIndex index, unsigned count
     return {};
 }
 
-void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
+ErrorOr<void> BlockBasedFileSystem::prefetch_blocks(BlockIndex index, size_t count) const
 {
-    m_cache.with_exclusive([&](auto& cache) {
-        if (!cache->is_dirty())
+    VERIFY(m_device_block_size);
+    dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem::prefetch_blocks {}, count={}", index, count);
+
+    return m_cache.with_shared([&](auto& cache) -> ErrorOr<void> {
+        // The filesystem is being unmounted.
+        if (!cache)
+            return {};
+
+        auto is_cached = [&](BlockIndex block_index) {
+            return cache->with_shard_for(block_index, [&](DiskCacheShard& shard) {
+                auto* entry = shard.get(block_index);
+                return entry && entry->has_data;
+            });
+        };
+        while (count > 0 && is_cached(index)) {
+            index = index.value() + 1;
+            --count;
+        }
+        while (count > 0 && is_cached(index.value() + count - 1))
+            --count;
+        if (count == 0)
+            return {};
+
+        auto block_size = logical_block_size();
+        auto data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Prefetch"sv, count * block_size));
+
+        // Remember what each block's shard looked like before reading, so we can tell whether the block
+        // may have changed while we were reading it.
+        Vector<u64> shard_generations;
+        TRY(shard_generations.try_ensure_capacity(count));
+        for (size_t i = 0; i < count; ++i) {
+            cache->with_shard_for(index.value() + i, [&](DiskCacheShard& shard) {
+                shard_generations.unchecked_append(shard.generation());
+            });
+        }
+        auto direct_write_generation = m_direct_write_generation.load();
+
+        // NOTE: The device may split this up into several requests, so keep going until we have everything.
+        auto base_offset = index.value() * block_size;
+        size_t nread = 0;
+        while (nread < count * block_size) {
+            auto data_buffer = UserOrKernelBuffer::for_kernel_buffer(data->data() + nread);
+            auto nread_now = TRY(file_description().read(data_buffer, base_offset + nread, count * block_size - nread));
+            if (nread_now == 0)
+                return EIO;
+            nread += nread_now;
+        }
+
+        // If anything was written in the meantime, the blocks we read may be stale.
+        // Prefetching is only a hint, so we just forget about them.
+        for (size_t i = 0; i < count; ++i) {
+            BlockIndex block_index = index.value() + i;
+            TRY(cache->with_shard_for(block_index, [&](DiskCacheShard& shard) -> ErrorOr<void> {
+                if (direct_write_generation != m_direct_write_generation.load())
+                    return {};
+                // Anything in the cache is at least as recent as what we read, and if the shard changed since
+                // we started reading, this block may have been written (and maybe written back and evicted) since.
+                if (shard.get(block_index) || shard.generation() != shard_generations[i])
+                    return {};
+                auto* entry = TRY(ensure_cache_entry(*cache, shard, block_index));
+                VERIFY(!entry->has_data);
+                memcpy(entry->data, data->data() + i * block_size, block_size);
+                entry->has_data = true;
+                return {};
+            }));
+        }
+        return {};
+    });
+}
+
+ErrorOr<CacheEntry*> BlockBasedFileSystem::ensure_cache_entry(DiskCache const& cache, DiskCacheShard& shard, BlockIndex index) const
+{
+    if (!shard.has_free_entries() && !shard.get(index))
+        cache.try_grow(shard);
+    return shard.ensure(index, [&](DiskCacheShard& shard) {
+        const_cast<BlockBasedFileSystem*>(this)->flush_dirty_entries(shard);
+    });
+}
+
+ErrorOr<void> BlockBasedFileSystem::fill_cache_entry(CacheEntry& entry) const
+{
+    if (entry.has_data)
+        return {};
+    auto base_offset = entry.block_index.value() * logical_block_size();
+    auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
+    auto nread = TRY(file_description().read(entry_data_buffer, base_offset, logical_block_size()));
+    VERIFY(nread == logical_block_size());
+    entry.has_data = true;
+    return {};
+}
+
+void BlockBasedFileSystem::flush_specific_block_if_needed(DiskCache const& cache, BlockIndex index)
+{
+    cache.with_shard_for(index, [&](DiskCacheShard& shard) {
+        if (!shard.is_dirty())
             return;
-        auto* entry = cache->get(index);
+        auto* entry = shard.get(index);
         if (!entry)
             return;
-        if (!cache->entry_is_dirty(*entry))
+        if (!shard.entry_is_dirty(*entry))
             return;
         size_t base_offset = entry->block_index.value() * logical_block_size();
         auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry->data);
@@ -288,21 +618,77 @@ void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
     });
 }
 
+size_t BlockBasedFileSystem::flush_dirty_entries(DiskCacheShard& shard)
+{
+    Vector<CacheEntry*> dirty_entries;
+    size_t count = 0;
+    shard.for_each_dirty_entry([&](CacheEntry& entry) {
+        ++count;
+        if (dirty_entries.try_append(&entry).is_error()) {
+            CacheEntry* entry_pointer = &entry;
+            write_back_entries({ &entry_pointer, 1 });
+        }
+    });
+    write_back_entries(dirty_entries.span());
+    shard.mark_all_clean();
+    return count;
+}
+
+void BlockBasedFileSystem::write_back_entries(Span<CacheEntry*> entries)
+{
+    quick_sort(entries, [](auto* a, auto* b) { return a->block_index < b->block_index; });
+
+    auto block_size = logical_block_size();
+    OwnPtr<KBuffer> staging_buffer;
+
+    for (size_t i = 0; i < entries.size();) {
+        auto first_block_index = entries[i]->block_index;
+        size_t run_length = 1;
+        while (i + run_length < entries.size() && run_length < DiskCache::BlocksPerShardStripe && entries[i + run_length]->block_index.value() == first_block_index.value() + run_length)
+            ++run_length;
+
+        // If we can't get a staging buffer, we simply write every block on its own.
+        if (run_length > 1 && !staging_buffer) {
+            auto staging_buffer_or_error = KBuffer::try_create_with_size("BlockBasedFS: Writeback"sv, DiskCache::BlocksPerShardStripe * block_size);
+            if (staging_buffer_or_error.is_error())
+                run_length = 1;
+            else
+                staging_buffer = staging_buffer_or_error.release_value();
+        }
+
+        u8* data = entries[i]->data;
+        if (run_length > 1) {
+            for (size_t j = 0; j < run_length; ++j)
+                memcpy(staging_buffer->data() + j * block_size, entries[i + j]->data, block_size);
+            data = staging_buffer->data();
+        }
+
+        // NOTE: The device may split this up into several requests, so keep going until everything is written.
+        auto base_offset = first_block_index.value() * block_size;
+        size_t nwritten = 0;
+        while (nwritten < run_length * block_size) {
+            auto data_buffer = UserOrKernelBuffer::for_kernel_buffer(data + nwritten);
+            auto nwritten_or_error = file_description().write(base_offset + nwritten, data_buffer, run_length * block_size - nwritten);
+            if (nwritten_or_error.is_error() || nwritten_or_error.value() == 0)
+                break;
+            nwritten += nwritten_or_error.value();
+        }
+        i += run_length;
+    }
+}
+
 void BlockBasedFileSystem::flush_writes_impl()
 {
     size_t count = 0;
-    m_cache.with_exclusive([&](auto& cache) {
-        if (!cache->is_dirty())
-            return;
-        cache->for_each_dirty_entry([&](CacheEntry& entry) {
-            auto base_offset = entry.block_index.value() * logical_block_size();
-            auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
-            [[maybe_unused]] auto rc = file_description().write(base_offset, entry_data_buffer, logical_block_size());
-            ++count;
+    m_cache.with_shared([&](auto& cache) {
+        cache->for_each_shard([&](DiskCacheShard& shard) {
+            if (shard.is_dirty())
+                count += flush_dirty_entries(shard);
+            cache->shrink_if_under_memory_pressure(shard);
         });
-        cache->mark_all_clean();
-        dbgln("{}: Flushed {} blocks to disk", class_name(), count);
     });
+    if (count)
+        dbgln("{}: Flushed {} blocks to disk", class_name(), count);
 }
 
 ErrorOr<void> BlockBasedFileSystem::flush_writes()
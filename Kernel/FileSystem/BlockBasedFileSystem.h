@@ -11,6 +11,9 @@
 
 namespace Kernel {
 
+struct CacheEntry;
+class DiskCacheShard;
+
 class BlockBasedFileSystem : public FileBackedFileSystem {
 public:
     AK_TYPEDEF_DISTINCT_ORDERED_ID(u64, BlockIndex);
@@ -36,6 +39,9 @@ protected:
     ErrorOr<void> raw_read_blocks(BlockIndex index, size_t count, UserOrKernelBuffer&);
     ErrorOr<void> raw_write_blocks(BlockIndex index, size_t count, UserOrKernelBuffer const&);
 
+    // Reads the given range of blocks into the cache with as few device requests as possible.
+    ErrorOr<void> prefetch_blocks(BlockIndex, size_t count) const;
+
     ErrorOr<void> write_block(BlockIndex, UserOrKernelBuffer const&, size_t count, u64 offset = 0, bool allow_cache = true);
     ErrorOr<void> write_blocks(BlockIndex, unsigned count, UserOrKernelBuffer const&, bool allow_cache = true);
 
@@ -44,9 +50,17 @@ protected:
     void remove_disk_cache_before_last_unmount();
 
 private:
-    void flush_specific_block_if_needed(BlockIndex index);
+    ErrorOr<CacheEntry*> ensure_cache_entry(DiskCache const&, DiskCacheShard&, BlockIndex) const;
+    ErrorOr<void> fill_cache_entry(CacheEntry&) const;
+    void flush_specific_block_if_needed(DiskCache const&, BlockIndex);
+    size_t flush_dirty_entries(DiskCacheShard&);
+    void write_back_entries(Span<CacheEntry*>);
 
     mutable MutexProtected<OwnPtr<DiskCache>> m_cache;
+
+    // Bumped on every write that bypasses the cache, so that a prefetch can tell that the data it read may be stale.
+    // Writes through the cache are tracked by each cache shard.
+    Atomic<u64> m_direct_write_generation { 0 };
 };
 
 }
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/EventPoll.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+// Guards the interest sets of all EventPolls and the watch lists of all open file
+// descriptions, since a watch can be torn down from either side.
+// Lock order: s_event_poll_lock -> FileBlockerSet -> EventPoll::m_ready_lock.
+static Spinlock<LockRank::None> s_event_poll_lock {};
+
+static BlockFlags block_flags_for_events(u32 events)
+{
+    BlockFlags block_flags = BlockFlags::WriteError | BlockFlags::WriteHangUp; // EPOLLERR and EPOLLHUP are always reported
+    if (events & EPOLLIN)
+        block_flags |= BlockFlags::Read;
+    if (events & EPOLLOUT)
+        block_flags |= BlockFlags::Write;
+    if (events & EPOLLPRI)
+        block_flags |= BlockFlags::ReadPriority;
+    if (events & EPOLLWRBAND)
+        block_flags |= BlockFlags::WritePriority;
+    if (events & EPOLLRDHUP)
+        block_flags |= BlockFlags::ReadHangUp;
+    return block_flags;
+}
+
+static u32 events_for_unblock_flags(BlockFlags unblock_flags)
+{
+    u32 events = 0;
+    if (has_flag(unblock_flags, BlockFlags::Read))
+        events |= EPOLLIN;
+    if (has_flag(unblock_flags, BlockFlags::WriteHangUp))
+        events |= EPOLLHUP;
+    else if (has_flag(unblock_flags, BlockFlags::Write))
+        events |= EPOLLOUT;
+    if (has_flag(unblock_flags, BlockFlags::ReadPriority))
+        events |= EPOLLPRI;
+    if (has_flag(unblock_flags, BlockFlags::WritePriority))
+        events |= EPOLLWRBAND;
+    if (has_flag(unblock_flags, BlockFlags::ReadHangUp))
+        events |= EPOLLRDHUP;
+    if (has_flag(unblock_flags, BlockFlags::WriteError))
+        events |= EPOLLERR;
+    return events;
+}
+
+EventPollWatch::EventPollWatch(EventPoll& event_poll, OpenFileDescription& description, int fd, epoll_event const& event)
+    : m_event_poll(event_poll)
+    , m_blocker_set(description.blocker_set())
+    , m_fd(fd)
+    , m_description(&description)
+    , m_events(event.events)
+    , m_data(event.data)
+{
+}
+
+void EventPollWatch::file_state_did_change()
+{
+    m_event_poll.watch_did_change(*this);
+}
+
+ErrorOr<NonnullRefPtr<EventPoll>> EventPoll::try_create()
+{
+    return adopt_nonnull_ref_or_enomem(new (nothrow) EventPoll);
+}
+
+EventPoll::~EventPoll()
+{
+    (void)close();
+}
+
+bool EventPoll::can_read(OpenFileDescription const&, u64) const
+{
+    SpinlockLocker locker(m_ready_lock);
+    return !m_ready_watches.is_empty();
+}
+
+ErrorOr<void> EventPoll::close()
+{
+    SpinlockLocker locker(s_event_poll_lock);
+    while (!m_watches.is_empty())
+        detach_watch(*m_watches.begin()->value);
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<KString>> EventPoll::pseudo_path(OpenFileDescription const&) const
+{
+    SpinlockLocker locker(s_event_poll_lock);
+    return KString::formatted("EventPoll:({})", m_watches.size());
+}
+
+void EventPoll::watch_did_change(EventPollWatch& watch)
+{
+    {
+        SpinlockLocker locker(m_ready_lock);
+        if (watch.m_is_disabled)
+            return;
+        ++watch.m_notification_count;
+        if (!watch.m_ready_list_node.is_in_list())
+            m_ready_watches.append(watch);
+    }
+    evaluate_block_conditions();
+}
+
+void EventPoll::detach_watch(EventPollWatch& watch)
+{
+    VERIFY(s_event_poll_lock.is_locked());
+
+    // Once the observer is gone the file can't put the watch back on the ready list.
+    watch.m_blocker_set.remove_observer(watch);
+    {
+        SpinlockLocker locker(m_ready_lock);
+        if (watch.m_ready_list_node.is_in_list())
+            m_ready_watches.remove(watch);
+    }
+
+    WatchKey key { watch.m_description, watch.m_fd };
+    watch.m_description_list_node.remove();
+    watch.m_description = nullptr;
+    m_watches.remove(key);
+}
+
+ErrorOr<void> EventPoll::add_watch(OpenFileDescription& description, int fd, epoll_event const& event)
+{
+    // Nested event polls would make the lock order between their blocker sets depend on userspace.
+    if (description.is_event_poll())
+        return EINVAL;
+
+    auto watch = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) EventPollWatch(*this, description, fd, event)));
+
+    SpinlockLocker locker(s_event_poll_lock);
+    WatchKey key { &description, fd };
+    if (m_watches.contains(key))
+        return EEXIST;
+    TRY(m_watches.try_set(key, watch));
+    description.event_poll_watches({}).append(*watch);
+    watch->m_blocker_set.add_observer(*watch);
+
+    // The file may well be ready already, so let the next wait have a look at it.
+    watch_did_change(*watch);
+    return {};
+}
+
+ErrorOr<void> EventPoll::modify_watch(OpenFileDescription& description, int fd, epoll_event const& event)
+{
+    SpinlockLocker locker(s_event_poll_lock);
+    auto it = m_watches.find({ &description, fd });
+    if (it == m_watches.end())
+        return ENOENT;
+
+    auto& watch = *it->value;
+    {
+        SpinlockLocker ready_locker(m_ready_lock);
+        watch.m_events = event.events;
+        watch.m_data = event.data;
+        watch.m_is_disabled = false;
+    }
+    watch_did_change(watch);
+    return {};
+}
+
+ErrorOr<void> EventPoll::remove_watch(OpenFileDescription& description, int fd)
+{
+    SpinlockLocker locker(s_event_poll_lock);
+    auto it = m_watches.find({ &description, fd });
+    if (it == m_watches.end())
+        return ENOENT;
+    detach_watch(*it->value);
+    return {};
+}
+
+void EventPoll::description_will_be_destroyed(Badge<OpenFileDescription>, OpenFileDescription& description)
+{
+    SpinlockLocker locker(s_event_poll_lock);
+    auto& watches = description.event_poll_watches({});
+    while (!watches.is_empty()) {
+        auto& watch = *watches.first();
+        watch.m_event_poll.detach_watch(watch);
+    }
+}
+
+ErrorOr<size_t> EventPoll::collect_ready_events(Span<epoll_event> events)
+{
+    struct Candidate {
+        NonnullRefPtr<EventPollWatch> watch;
+        NonnullRefPtr<OpenFileDescription> description;
+        u32 events { 0 };
+        u64 notification_count { 0 };
+    };
+
+    // Only the watches that were notified since the last wait are looked at. The
+    // descriptions are referenced so they can be queried without holding any locks,
+    // and the ones that are being destroyed right now are skipped.
+    Vector<Candidate> candidates;
+    TRY(candidates.try_ensure_capacity(events.size()));
+    {
+        SpinlockLocker locker(s_event_poll_lock);
+        SpinlockLocker ready_locker(m_ready_lock);
+        for (auto& watch : m_ready_watches) {
+            if (candidates.size() == events.size())
+                break;
+            if (!watch.m_description->try_ref())
+                continue;
+            candidates.unchecked_append({ watch, adopt_ref(*watch.m_description), watch.m_events, watch.m_notification_count });
+        }
+    }
+
+    size_t count = 0;
+    for (auto& candidate : candidates) {
+        auto unblock_flags = candidate.description->should_unblock(block_flags_for_events(candidate.events));
+        auto ready_events = events_for_unblock_flags(unblock_flags) & (candidate.events | EPOLLERR | EPOLLHUP);
+
+        SpinlockLocker locker(m_ready_lock);
+        auto& watch = *candidate.watch;
+        // The watch was removed, modified or disabled in the meantime.
+        if (!watch.m_ready_list_node.is_in_list() || watch.m_is_disabled)
+            continue;
+        bool was_notified_again = watch.m_notification_count != candidate.notification_count;
+
+        if (ready_events == 0) {
+            // Not actually ready, so wait for the file to change before looking at it again.
+            if (!was_notified_again)
+                m_ready_watches.remove(watch);
+            continue;
+        }
+
+        events[count++] = { ready_events, watch.m_data };
+
+        m_ready_watches.remove(watch);
+        if (watch.m_events & EPOLLONESHOT) {
+            // Stays quiet until userspace re-arms it with EPOLL_CTL_MOD.
+            watch.m_is_disabled = true;
+        } else if (!(watch.m_events & EPOLLET) || was_notified_again) {
+            // Level-triggered watches are reported until they're no longer ready. Put them
+            // at the back so that a busy fd can't starve the others when events is small.
+            m_ready_watches.append(watch);
+        }
+    }
+    return count;
+}
+
+}
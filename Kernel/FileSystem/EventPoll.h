@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/Badge.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <Kernel/API/POSIX/sys/epoll.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Locking/Spinlock.h>
+
+namespace Kernel {
+
+class EventPoll;
+
+// A file descriptor in the interest set of an EventPoll. Like on Linux, a watch
+// is keyed by the fd number together with the open file description it referred
+// to when it was added, and it goes away once that description is destroyed.
+class EventPollWatch final
+    : public AtomicRefCounted<EventPollWatch>
+    , public FileBlockerSet::Observer {
+public:
+    virtual void file_state_did_change() override;
+
+private:
+    friend class EventPoll;
+
+    EventPollWatch(EventPoll&, OpenFileDescription&, int fd, epoll_event const&);
+
+    EventPoll& m_event_poll;
+    FileBlockerSet& m_blocker_set;
+    int const m_fd { -1 };
+
+    // Protected by the global EventPoll lock, cleared once the description is gone.
+    OpenFileDescription* m_description { nullptr };
+    IntrusiveListNode<EventPollWatch> m_description_list_node;
+
+    // Protected by EventPoll::m_ready_lock.
+    u32 m_events { 0 };
+    epoll_data_t m_data {};
+    bool m_is_disabled { false };
+    u64 m_notification_count { 0 };
+    IntrusiveListNode<EventPollWatch> m_ready_list_node;
+
+public:
+    using DescriptionList = IntrusiveList<&EventPollWatch::m_description_list_node>;
+    using ReadyList = IntrusiveList<&EventPollWatch::m_ready_list_node>;
+};
+
+// The file behind an epoll fd. Every watched file tells it about state changes
+// through its FileBlockerSet, so waiting only ever looks at the watches that were
+// notified since the last wait, no matter how many idle fds are in the interest set.
+class EventPoll final : public File {
+public:
+    static ErrorOr<NonnullRefPtr<EventPoll>> try_create();
+    virtual ~EventPoll() override;
+
+    virtual bool can_read(OpenFileDescription const&, u64) const override;
+    virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual bool can_write(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override { return EINVAL; }
+    virtual ErrorOr<void> close() override;
+
+    virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual StringView class_name() const override { return "EventPoll"sv; }
+    virtual bool is_event_poll() const override { return true; }
+
+    ErrorOr<void> add_watch(OpenFileDescription&, int fd, epoll_event const&);
+    ErrorOr<void> modify_watch(OpenFileDescription&, int fd, epoll_event const&);
+    ErrorOr<void> remove_watch(OpenFileDescription&, int fd);
+
+    // Fills events with the watches that are ready right now and returns how many
+    // there were. Level-triggered watches stay ready until their file says otherwise.
+    ErrorOr<size_t> collect_ready_events(Span<epoll_event> events);
+
+    static void description_will_be_destroyed(Badge<OpenFileDescription>, OpenFileDescription&);
+
+private:
+    friend class EventPollWatch;
+
+    EventPoll() = default;
+
+    void watch_did_change(EventPollWatch&);
+    void detach_watch(EventPollWatch&);
+
+    struct WatchKey {
+        OpenFileDescription* description { nullptr };
+        int fd { -1 };
+
+        bool operator==(WatchKey const&) const = default;
+    };
+    struct WatchKeyTraits : public DefaultTraits<WatchKey> {
+        static unsigned hash(WatchKey const& key) { return pair_int_hash(ptr_hash(key.description), int_hash(key.fd)); }
+    };
+
+    // Protected by the global EventPoll lock.
+    HashMap<WatchKey, NonnullRefPtr<EventPollWatch>, WatchKeyTraits> m_watches;
+
+    mutable Spinlock<LockRank::None> m_ready_lock {};
+    EventPollWatch::ReadyList m_ready_watches;
+};
+
+}
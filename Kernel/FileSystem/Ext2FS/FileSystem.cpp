@@ -29,7 +29,10 @@ Ext2FS::~Ext2FS() = default;
 ErrorOr<void> Ext2FS::flush_super_block()
 {
     MutexLocker locker(m_lock);
-    auto super_block_buffer = UserOrKernelBuffer::for_kernel_buffer((u8*)&m_super_block);
+    // Reserved blocks are still free on disk.
+    auto super_block = m_super_block;
+    super_block.s_free_blocks_count += m_reserved_blocks.size();
+    auto super_block_buffer = UserOrKernelBuffer::for_kernel_buffer((u8*)&super_block);
     auto const superblock_physical_block_count = (sizeof(ext2_super_block) / device_block_size());
 
     // FIXME: We currently have no ability of writing within a device block, but the ability to do so would allow us to use device block sizes larger than 1024.
@@ -223,9 +226,9 @@ ErrorOr<void> Ext2FS::write_ext2_inode(InodeIndex inode, ext2_inode const& e2ino
     return write_block(block_index, buffer, inode_size(), offset);
 }
 
-auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) -> ErrorOr<Vector<BlockIndex>>
+auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count, BlockIndex goal) -> ErrorOr<Vector<BlockIndex>>
 {
-    dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_blocks(preferred group: {}, count {})", preferred_group_index, count);
+    dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_blocks(preferred group: {}, count {}, goal {})", preferred_group_index, count, goal);
     if (count == 0)
         return Vector<BlockIndex> {};
 
@@ -233,6 +236,32 @@ auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) ->
     TRY(blocks.try_ensure_capacity(count));
 
     MutexLocker locker(m_lock);
+
+    // If we were given a goal (usually the block right after the last one of a file), we first take
+    // as many free blocks as we can starting from there, so that the file stays contiguous on disk.
+    if (goal != 0 && goal < super_block().s_blocks_count) {
+        auto goal_group_index = group_index_from_block_index(goal);
+        auto const& bgd = group_descriptor(goal_group_index);
+        if (bgd.bg_free_blocks_count) {
+            auto* cached_bitmap = TRY(get_bitmap_block(bgd.bg_block_bitmap));
+
+            size_t blocks_in_group = min(blocks_per_group(), super_block().s_blocks_count);
+            auto block_bitmap = cached_bitmap->bitmap(blocks_in_group);
+
+            BlockIndex first_block_in_group = first_block_of_group(goal_group_index);
+            for (size_t bit_index = goal.value() - first_block_in_group.value(); bit_index < blocks_in_group && !block_bitmap.get(bit_index); ++bit_index) {
+                BlockIndex block_index = bit_index + first_block_in_group.value();
+                if (block_index >= super_block().s_blocks_count)
+                    break;
+                TRY(set_block_allocation_state(block_index, true));
+                blocks.unchecked_append(block_index);
+                if (blocks.size() == count)
+                    return blocks;
+            }
+        }
+        preferred_group_index = goal_group_index;
+    }
+
     auto group_index = preferred_group_index;
 
     if (!group_descriptor(preferred_group_index).bg_free_blocks_count) {
@@ -433,20 +462,80 @@ ErrorOr<Ext2FS::CachedBitmap*> Ext2FS::get_bitmap_block(BlockIndex bitmap_block_
     return m_cached_bitmaps.last().ptr();
 }
 
+unsigned Ext2FS::block_bitmap_bit_index(BlockIndex block_index) const
+{
+    auto group_index = group_index_from_block_index(block_index);
+    unsigned index_in_group = (block_index.value() - first_block_index().value()) - ((group_index.value() - 1) * blocks_per_group());
+    return index_in_group % blocks_per_group();
+}
+
 ErrorOr<void> Ext2FS::set_block_allocation_state(BlockIndex block_index, bool new_state)
 {
     VERIFY(block_index != 0);
     MutexLocker locker(m_lock);
 
     auto group_index = group_index_from_block_index(block_index);
-    unsigned index_in_group = (block_index.value() - first_block_index().value()) - ((group_index.value() - 1) * blocks_per_group());
-    unsigned bit_index = index_in_group % blocks_per_group();
+    unsigned bit_index = block_bitmap_bit_index(block_index);
     auto& bgd = const_cast<ext2_group_desc&>(group_descriptor(group_index));
 
     dbgln_if(EXT2_DEBUG, "Ext2FS: Block {} state -> {} (in bitmap block {})", block_index, new_state, bgd.bg_block_bitmap);
     return update_bitmap_block(bgd.bg_block_bitmap, bit_index, new_state, m_super_block.s_free_blocks_count, bgd.bg_free_blocks_count);
 }
 
+auto Ext2FS::reserve_blocks(GroupIndex preferred_group_index, size_t count, BlockIndex goal) -> ErrorOr<Vector<BlockIndex>>
+{
+    MutexLocker locker(m_lock);
+    TRY(m_reserved_blocks.try_ensure_capacity(m_reserved_blocks.size() + count));
+    auto blocks = TRY(allocate_blocks(preferred_group_index, count, goal));
+    for (auto block : blocks)
+        m_reserved_blocks.set(block);
+    return blocks;
+}
+
+ErrorOr<void> Ext2FS::claim_reserved_block(BlockIndex block_index)
+{
+    MutexLocker locker(m_lock);
+    auto const& bgd = group_descriptor(group_index_from_block_index(block_index));
+    auto* cached_bitmap = TRY(get_bitmap_block(bgd.bg_block_bitmap));
+    bool was_reserved = m_reserved_blocks.remove(block_index);
+    VERIFY(was_reserved);
+
+    // The block is already allocated in memory, it only has to be written out as such now.
+    cached_bitmap->dirty = true;
+    m_super_block_dirty = true;
+    m_block_group_descriptors_dirty = true;
+    return {};
+}
+
+ErrorOr<void> Ext2FS::release_reserved_block(BlockIndex block_index)
+{
+    MutexLocker locker(m_lock);
+    bool was_reserved = m_reserved_blocks.remove(block_index);
+    VERIFY(was_reserved);
+    return set_block_allocation_state(block_index, false);
+}
+
+ErrorOr<void> Ext2FS::write_bitmap_block(CachedBitmap& cached_bitmap)
+{
+    VERIFY(m_lock.is_locked());
+    auto buffer = UserOrKernelBuffer::for_kernel_buffer(cached_bitmap.buffer->data());
+
+    // Reserved blocks are only allocated in memory, so they have to be written out as free.
+    OwnPtr<KBuffer> on_disk_bitmap;
+    for (auto block_index : m_reserved_blocks) {
+        if (group_descriptor(group_index_from_block_index(block_index)).bg_block_bitmap != cached_bitmap.bitmap_block_index)
+            continue;
+        if (!on_disk_bitmap) {
+            on_disk_bitmap = TRY(KBuffer::try_create_with_size("Ext2FS: On-disk bitmap block"sv, logical_block_size()));
+            memcpy(on_disk_bitmap->data(), cached_bitmap.buffer->data(), logical_block_size());
+            buffer = UserOrKernelBuffer::for_kernel_buffer(on_disk_bitmap->data());
+        }
+        Bitmap { on_disk_bitmap->data(), blocks_per_group() }.set(block_bitmap_bit_index(block_index), false);
+    }
+
+    return write_block(cached_bitmap.bitmap_block_index, buffer, logical_block_size());
+}
+
 ErrorOr<NonnullRefPtr<Inode>> Ext2FS::create_directory(Ext2FSInode& parent_inode, StringView name, mode_t mode, UserID uid, GroupID gid)
 {
     MutexLocker locker(m_lock);
@@ -567,6 +656,9 @@ ErrorOr<void> Ext2FS::prepare_to_clear_last_mount(Inode& mount_guest_inode)
     m_inode_cache.clear();
     m_root_inode = nullptr;
 
+    // The inodes we just got rid of may have given back their preallocated blocks, so flush the bitmaps once more.
+    TRY(flush_writes());
+
     // Mark filesystem as valid before unmount.
     dmesgln("Ext2FS: Clean unmount, setting superblock to valid state");
     m_super_block.s_state = EXT2_VALID_FS;
@@ -622,6 +714,22 @@ void Ext2FS::flush_block_group_descriptor_table()
     auto blocks_to_write = ceil_div(m_block_group_count * sizeof(ext2_group_desc), logical_block_size());
     auto first_block_of_bgdt = first_block_of_block_group_descriptors();
     auto buffer = UserOrKernelBuffer::for_kernel_buffer((u8*)block_group_descriptors());
+
+    // Reserved blocks are still free on disk.
+    OwnPtr<KBuffer> on_disk_table;
+    if (!m_reserved_blocks.is_empty()) {
+        auto on_disk_table_or_error = KBuffer::try_create_with_size("Ext2FS: On-disk block group descriptors"sv, m_cached_group_descriptor_table->size());
+        if (on_disk_table_or_error.is_error()) {
+            dbgln("Ext2FS[{}]::flush_block_group_descriptor_table(): Failed to allocate buffer: {}", fsid(), on_disk_table_or_error.error());
+            return;
+        }
+        on_disk_table = on_disk_table_or_error.release_value();
+        memcpy(on_disk_table->data(), m_cached_group_descriptor_table->data(), m_cached_group_descriptor_table->size());
+        auto* on_disk_descriptors = (ext2_group_desc*)on_disk_table->data();
+        for (auto block_index : m_reserved_blocks)
+            ++on_disk_descriptors[group_index_from_block_index(block_index).value() - 1].bg_free_blocks_count;
+        buffer = UserOrKernelBuffer::for_kernel_buffer(on_disk_table->data());
+    }
     auto write_bgdt_to_block = [&](BlockIndex index) {
         if (auto result = write_blocks(index, blocks_to_write, buffer); result.is_error())
             dbgln("Ext2FS[{}]::flush_block_group_descriptor_table(): Failed to write blocks: {}", fsid(), result.error());
@@ -660,8 +768,7 @@ ErrorOr<void> Ext2FS::flush_writes()
         }
         for (auto& cached_bitmap : m_cached_bitmaps) {
             if (cached_bitmap->dirty) {
-                auto buffer = UserOrKernelBuffer::for_kernel_buffer(cached_bitmap->buffer->data());
-                if (auto result = write_block(cached_bitmap->bitmap_block_index, buffer, logical_block_size()); result.is_error()) {
+                if (auto result = write_bitmap_block(*cached_bitmap); result.is_error()) {
                     dbgln("Ext2FS[{}]::flush_writes(): Failed to write blocks: {}", fsid(), result.error());
                 }
                 cached_bitmap->dirty = false;
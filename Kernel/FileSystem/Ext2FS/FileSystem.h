@@ -8,6 +8,7 @@
 
 #include <AK/Bitmap.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
 #include <Kernel/FileSystem/Ext2FS/Definitions.h>
 #include <Kernel/FileSystem/FileSystemSpecificOption.h>
@@ -92,7 +93,13 @@ private:
     BlockIndex first_block_index() const;
     BlockIndex first_block_of_block_group_descriptors() const;
     ErrorOr<InodeIndex> allocate_inode(GroupIndex preferred_group = 0);
-    ErrorOr<Vector<BlockIndex>> allocate_blocks(GroupIndex preferred_group_index, size_t count);
+    ErrorOr<Vector<BlockIndex>> allocate_blocks(GroupIndex preferred_group_index, size_t count, BlockIndex goal = 0);
+
+    // Reserved blocks are allocated as far as the in-memory bitmaps are concerned, but stay free on disk until they are
+    // claimed. That way, blocks that inodes set aside for themselves can't leak if we crash before they are used.
+    ErrorOr<Vector<BlockIndex>> reserve_blocks(GroupIndex preferred_group_index, size_t count, BlockIndex goal = 0);
+    ErrorOr<void> claim_reserved_block(BlockIndex);
+    ErrorOr<void> release_reserved_block(BlockIndex);
     GroupIndex group_index_from_inode(InodeIndex) const;
     GroupIndex group_index_from_block_index(BlockIndex) const;
     BlockIndex first_block_of_group(GroupIndex) const;
@@ -100,6 +107,7 @@ private:
     ErrorOr<bool> get_inode_allocation_state(InodeIndex) const;
     ErrorOr<void> set_inode_allocation_state(InodeIndex, bool);
     ErrorOr<void> set_block_allocation_state(BlockIndex, bool);
+    unsigned block_bitmap_bit_index(BlockIndex) const;
 
     void uncache_inode(InodeIndex);
     ErrorOr<void> free_inode(Ext2FSInode&);
@@ -130,8 +138,10 @@ private:
 
     ErrorOr<CachedBitmap*> get_bitmap_block(BlockIndex);
     ErrorOr<void> update_bitmap_block(BlockIndex bitmap_block, size_t bit_index, bool new_state, u32& super_block_counter, u16& group_descriptor_counter);
+    ErrorOr<void> write_bitmap_block(CachedBitmap&);
 
     Vector<OwnPtr<CachedBitmap>> m_cached_bitmaps;
+    HashTable<BlockIndex> m_reserved_blocks;
     RefPtr<Ext2FSInode> m_root_inode;
 };
 
@@ -12,6 +12,8 @@
 #include <Kernel/FileSystem/Ext2FS/FileSystem.h>
 #include <Kernel/FileSystem/Ext2FS/Inode.h>
 #include <Kernel/FileSystem/InodeMetadata.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/WorkQueue.h>
 #include <Kernel/UnixTypes.h>
 
 namespace Kernel {
@@ -348,6 +350,7 @@ Ext2FSInode::Ext2FSInode(Ext2FS& fs, InodeIndex index)
 
 Ext2FSInode::~Ext2FSInode()
 {
+    discard_preallocated_blocks();
     if (m_raw_inode.i_links_count == 0) {
         // Alas, we have nowhere to propagate any errors that occur here.
         (void)fs().free_inode(*this);
@@ -420,6 +423,81 @@ ErrorOr<void> Ext2FSInode::compute_block_list_with_exclusive_locking()
     return {};
 }
 
+// The readahead window starts out small and doubles with every sequential read, up to a limit.
+// This also limits how much we try to read from the device at once.
+static constexpr u64 minimum_readahead_window_size = 16 * KiB;
+static constexpr u64 maximum_readahead_window_size = 256 * KiB;
+
+template<typename Callback>
+ErrorOr<void> Ext2FSInode::for_each_contiguous_block_run(BlockBasedFileSystem::BlockIndex first_logical_block_index, u64 count, Callback callback) const
+{
+    u64 const maximum_run_length = maximum_readahead_window_size / fs().logical_block_size();
+    BlockBasedFileSystem::BlockIndex run_start = 0;
+    u64 run_length = 0;
+    for (u64 i = 0; i < count; ++i) {
+        auto block_index = get_block(first_logical_block_index.value() + i);
+        if (run_length > 0 && run_length < maximum_run_length && block_index.value() == run_start.value() + run_length) {
+            ++run_length;
+            continue;
+        }
+        if (run_length > 0)
+            TRY(callback(run_start, run_length));
+        // Holes don't start a run.
+        run_start = block_index;
+        run_length = block_index.value() == 0 ? 0 : 1;
+    }
+    if (run_length > 0)
+        TRY(callback(run_start, run_length));
+    return {};
+}
+
+void Ext2FSInode::read_ahead(OpenFileDescription& description, u64 offset, u64 count) const
+{
+    auto access_pattern = description.access_pattern();
+    if (access_pattern == OpenFileDescription::AccessPattern::Random)
+        return;
+
+    struct ReadaheadRange {
+        u64 start;
+        u64 end;
+    };
+    auto end_of_read = offset + count;
+    auto range = description.with_readahead_state([&](auto& state) -> Optional<ReadaheadRange> {
+        bool is_sequential = access_pattern == OpenFileDescription::AccessPattern::Sequential || offset == state.next_offset;
+        if (!is_sequential) {
+            state = { .next_offset = end_of_read };
+            return {};
+        }
+        state.next_offset = end_of_read;
+        state.window_size = clamp(state.window_size * 2, minimum_readahead_window_size, maximum_readahead_window_size);
+        // Don't queue any more work until the reader has caught up with half of what we already read ahead.
+        if (state.readahead_end >= end_of_read + state.window_size / 2)
+            return {};
+        auto start = max(state.readahead_end, end_of_read);
+        state.readahead_end = end_of_read + state.window_size;
+        return ReadaheadRange { start, state.readahead_end };
+    });
+    if (!range.has_value())
+        return;
+
+    auto end = min(range->end, size());
+    if (range->start >= end)
+        return;
+
+    auto block_size = fs().logical_block_size();
+    BlockBasedFileSystem::BlockIndex first_block_logical_index = range->start / block_size;
+    u64 block_count = ceil_div(end, block_size) - first_block_logical_index.value();
+    dbgln_if(EXT2_VERY_DEBUG, "Ext2FSInode[{}]::read_ahead(): Reading ahead {} blocks from index {}", identifier(), block_count, first_block_logical_index);
+
+    // NOTE: The block list can only be accessed while we hold the inode lock, so we look
+    //       up the blocks now and only leave the actual reading to the work queue.
+    [[maybe_unused]] auto result = for_each_contiguous_block_run(first_block_logical_index, block_count, [&](auto block_index, auto count) -> ErrorOr<void> {
+        return g_readahead_work->try_queue([fs = NonnullRefPtr { const_cast<Ext2FS&>(fs()) }, block_index, count] {
+            [[maybe_unused]] auto result = fs->prefetch_blocks(block_index, count);
+        });
+    });
+}
+
 ErrorOr<size_t> Ext2FSInode::read_bytes_locked(off_t offset, size_t count, UserOrKernelBuffer& buffer, OpenFileDescription* description) const
 {
     VERIFY(m_inode_lock.is_locked());
@@ -458,6 +536,20 @@ ErrorOr<size_t> Ext2FSInode::read_bytes_locked(off_t offset, size_t count, UserO
     auto remaining_count = min((off_t)count, (off_t)size() - offset);
     auto current_block_logical_index = first_block_logical_index;
 
+    if (allow_cache) {
+        // Bring in all the blocks that aren't cached yet with as few device requests as possible,
+        // so that the loop below only has to copy them out of the cache.
+        // NOTE: This is only an optimization, any errors will surface when reading the blocks again below.
+        BlockBasedFileSystem::BlockIndex last_block_logical_index = (offset + remaining_count - 1) / block_size;
+        if (last_block_logical_index > first_block_logical_index) {
+            [[maybe_unused]] auto result = for_each_contiguous_block_run(first_block_logical_index, last_block_logical_index.value() - first_block_logical_index.value() + 1, [&](auto block_index, auto count) {
+                return fs().prefetch_blocks(block_index, count);
+            });
+        }
+        if (description)
+            read_ahead(*description, offset, remaining_count);
+    }
+
     dbgln_if(EXT2_VERY_DEBUG, "Ext2FSInode[{}]::read_bytes(): Reading up to {} bytes, {} bytes into inode to {}", identifier(), count, offset, buffer.user_or_kernel_ptr());
 
     while (remaining_count) {
@@ -492,6 +584,8 @@ ErrorOr<void> Ext2FSInode::resize(u64 new_size)
         return ENOSPC;
 
     if (new_size < size()) {
+        discard_preallocated_blocks();
+
         auto block_size = fs().logical_block_size();
         BlockBasedFileSystem::BlockIndex first_block_logical_index = ceil_div(new_size, block_size);
         BlockBasedFileSystem::BlockIndex last_block_logical_index = size() / block_size;
@@ -564,6 +658,20 @@ ErrorOr<size_t> Ext2FSInode::write_bytes_locked(off_t offset, size_t count, User
     dbgln_if(EXT2_VERY_DEBUG, "Ext2FSInode[{}]::write_bytes_locked(): Writing {} bytes, {} bytes into inode from {}", identifier(), count, offset, data.user_or_kernel_ptr());
     auto old_block_list = TRY(m_block_list.clone());
 
+    // Reserve all the blocks this write is going to need at once, so that we get them in one contiguous run if possible.
+    Optional<BlockBasedFileSystem::BlockIndex> first_unallocated_block_logical_index;
+    size_t unallocated_block_count = 0;
+    BlockBasedFileSystem::BlockIndex last_block_logical_index = (offset + remaining_count - 1) / block_size;
+    for (auto logical_block_index = first_block_logical_index; logical_block_index <= last_block_logical_index; logical_block_index = logical_block_index.value() + 1) {
+        if (m_block_list.contains(logical_block_index))
+            continue;
+        if (!first_unallocated_block_logical_index.has_value())
+            first_unallocated_block_logical_index = logical_block_index;
+        ++unallocated_block_count;
+    }
+    if (first_unallocated_block_logical_index.has_value())
+        TRY(preallocate_blocks(*first_unallocated_block_logical_index, unallocated_block_count));
+
     while (remaining_count) {
         size_t offset_into_block = (current_block_logical_index == first_block_logical_index) ? offset_into_first_block : 0;
         size_t num_bytes_to_copy = min((size_t)block_size - offset_into_block, (size_t)remaining_count);
@@ -688,12 +796,14 @@ ErrorOr<BlockBasedFileSystem::BlockIndex> Ext2FSInode::get_or_allocate_block(Blo
         return block;
     }
 
-    // FIXME: Preallocate some extra blocks here.
-    auto blocks = TRY(fs().allocate_blocks(fs().group_index_from_inode(index()), 1));
-
-    VERIFY(blocks.size() == 1);
-    auto block = blocks.first();
+    TRY(preallocate_blocks(block_index, 1));
+    auto block = m_preallocated_blocks.last();
     TRY(m_block_list.try_set(block_index, block));
+    if (auto result = fs().claim_reserved_block(block); result.is_error()) {
+        m_block_list.remove(block_index);
+        return result.release_error();
+    }
+    m_preallocated_blocks.take_last();
 
     if (zero_newly_allocated_block) {
         u8 zero_buffer[PAGE_SIZE] {};
@@ -706,6 +816,59 @@ ErrorOr<BlockBasedFileSystem::BlockIndex> Ext2FSInode::get_or_allocate_block(Blo
     return block;
 }
 
+// When a file grows, we reserve a few more blocks than we need right away,
+// so that the blocks of files that grow bit by bit end up next to each other.
+static constexpr size_t minimum_preallocation_block_count = 8;
+static constexpr size_t maximum_preallocation_block_count = 1024;
+
+ErrorOr<void> Ext2FSInode::preallocate_blocks(BlockBasedFileSystem::BlockIndex first_logical_block_index, size_t count)
+{
+    count = min(count, maximum_preallocation_block_count);
+
+    // Ideally, the new blocks continue right where the previous block of the file is.
+    BlockBasedFileSystem::BlockIndex goal = 0;
+    if (first_logical_block_index.value() > 0) {
+        auto previous_block = get_block(first_logical_block_index.value() - 1);
+        if (previous_block != 0)
+            goal = previous_block.value() + 1;
+    }
+
+    if (goal != 0) {
+        if (auto goal_index = m_preallocated_blocks.find_first_index(goal); goal_index.has_value()) {
+            // The window is handed out from the back, so move the blocks that would be handed out before the goal
+            // to the front. That way, they're still around for later.
+            auto skipped_block_count = m_preallocated_blocks.size() - *goal_index - 1;
+            for (size_t i = 0; i < skipped_block_count; ++i)
+                m_preallocated_blocks.prepend(m_preallocated_blocks.take_last());
+        } else {
+            // The window doesn't continue the file, so it's of no use here.
+            discard_preallocated_blocks();
+        }
+    }
+
+    if (m_preallocated_blocks.size() >= count)
+        return {};
+
+    // Grow the window, right after its last block if possible.
+    if (!m_preallocated_blocks.is_empty())
+        goal = m_preallocated_blocks.first().value() + 1;
+    auto block_count = max(count - m_preallocated_blocks.size(), minimum_preallocation_block_count);
+    TRY(m_preallocated_blocks.try_ensure_capacity(m_preallocated_blocks.size() + block_count));
+    auto blocks = TRY(fs().reserve_blocks(fs().group_index_from_inode(index()), block_count, goal));
+    blocks.reverse();
+    m_preallocated_blocks.prepend(move(blocks));
+    return {};
+}
+
+void Ext2FSInode::discard_preallocated_blocks()
+{
+    for (auto block : m_preallocated_blocks) {
+        if (auto result = fs().release_reserved_block(block); result.is_error())
+            dbgln("Ext2FSInode[{}]::discard_preallocated_blocks(): Failed to free block {}: {}", identifier(), block, result.error());
+    }
+    m_preallocated_blocks.clear();
+}
+
 BlockBasedFileSystem::BlockIndex Ext2FSInode::get_block(BlockBasedFileSystem::BlockIndex block_index) const
 {
     auto it = m_block_list.find(block_index);
@@ -46,7 +46,12 @@ private:
     virtual ErrorOr<int> get_block_address(int) override;
 
     ErrorOr<BlockBasedFileSystem::BlockIndex> get_or_allocate_block(BlockBasedFileSystem::BlockIndex, bool zero_newly_allocated_block, bool allow_cache);
+    ErrorOr<void> preallocate_blocks(BlockBasedFileSystem::BlockIndex first_logical_block_index, size_t count);
+    void discard_preallocated_blocks();
     BlockBasedFileSystem::BlockIndex get_block(BlockBasedFileSystem::BlockIndex) const;
+    template<typename Callback>
+    ErrorOr<void> for_each_contiguous_block_run(BlockBasedFileSystem::BlockIndex first_logical_block_index, u64 count, Callback) const;
+    void read_ahead(OpenFileDescription&, u64 offset, u64 count) const;
     ErrorOr<u32> allocate_and_zero_block();
 
     ErrorOr<void> write_directory(Vector<Ext2FSDirectoryEntry>&);
@@ -86,6 +91,8 @@ private:
     Ext2FSInode(Ext2FS&, InodeIndex);
 
     Ext2FS::BlockList m_block_list;
+    // Blocks that are reserved for upcoming writes (see Ext2FS::reserve_blocks()), in reverse order.
+    Vector<BlockBasedFileSystem::BlockIndex> m_preallocated_blocks;
     HashMap<NonnullOwnPtr<KString>, InodeIndex> m_lookup_cache;
     ext2_inode m_raw_inode {};
 
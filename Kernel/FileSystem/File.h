@@ -8,6 +8,7 @@
 
 #include <AK/AtomicRefCounted.h>
 #include <AK/Error.h>
+#include <AK/IntrusiveList.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 #include <Kernel/Forward.h>
@@ -23,8 +24,32 @@ class File;
 
 class FileBlockerSet final : public Thread::BlockerSet {
 public:
+    // Gets told about every state change of the file without blocking a thread,
+    // which is how an EventPoll keeps its ready list up to date.
+    class Observer {
+    public:
+        virtual ~Observer() = default;
+        virtual void file_state_did_change() = 0;
+
+    private:
+        friend class FileBlockerSet;
+        IntrusiveListNode<Observer> m_observer_list_node;
+    };
+
     FileBlockerSet() { }
 
+    void add_observer(Observer& observer)
+    {
+        SpinlockLocker lock(m_lock);
+        m_observers.append(observer);
+    }
+
+    void remove_observer(Observer& observer)
+    {
+        SpinlockLocker lock(m_lock);
+        m_observers.remove(observer);
+    }
+
     virtual bool should_add_blocker(Thread::Blocker& b, void* data) override
     {
         VERIFY(b.blocker_type() == Thread::Blocker::Type::File);
@@ -40,7 +65,12 @@ public:
             auto& blocker = static_cast<Thread::FileBlocker&>(b);
             return blocker.unblock_if_conditions_are_met(false, data);
         });
+        for (auto& observer : m_observers)
+            observer.file_state_did_change();
     }
+
+private:
+    IntrusiveList<&Observer::m_observer_list_node> m_observers;
 };
 
 // File is the base class for anything that can be referenced by a OpenFileDescription.
@@ -114,6 +144,7 @@ public:
     virtual bool is_character_device() const { return false; }
     virtual bool is_socket() const { return false; }
     virtual bool is_inode_watcher() const { return false; }
+    virtual bool is_event_poll() const { return false; }
     virtual bool is_mount_file() const { return false; }
     virtual bool is_loop_device() const { return false; }
 
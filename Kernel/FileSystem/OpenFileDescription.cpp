@@ -53,6 +53,10 @@ OpenFileDescription::OpenFileDescription(File& file)
 
 OpenFileDescription::~OpenFileDescription()
 {
+    // Nobody else can add a watch while we're being destroyed, so only descriptions
+    // that are actually watched have to take the EventPoll lock.
+    if (!m_event_poll_watches.is_empty())
+        EventPoll::description_will_be_destroyed({}, *this);
     m_file->detach(*this);
     // FIXME: Should this error path be observed somehow?
     (void)m_file->close();
@@ -313,6 +317,18 @@ InodeWatcher* OpenFileDescription::inode_watcher()
     return static_cast<InodeWatcher*>(m_file.ptr());
 }
 
+bool OpenFileDescription::is_event_poll() const
+{
+    return m_file->is_event_poll();
+}
+
+EventPoll* OpenFileDescription::event_poll()
+{
+    if (!is_event_poll())
+        return nullptr;
+    return static_cast<EventPoll*>(m_file.ptr());
+}
+
 bool OpenFileDescription::is_mount_file() const
 {
     return m_file->is_mount_file();
@@ -498,6 +514,19 @@ bool OpenFileDescription::is_direct() const
     return m_state.with([](auto& state) { return state.direct; });
 }
 
+OpenFileDescription::AccessPattern OpenFileDescription::access_pattern() const
+{
+    return m_state.with([](auto& state) { return state.access_pattern; });
+}
+
+void OpenFileDescription::set_access_pattern(AccessPattern access_pattern)
+{
+    m_state.with([&](auto& state) {
+        state.access_pattern = access_pattern;
+        state.readahead = {};
+    });
+}
+
 bool OpenFileDescription::is_directory() const
 {
     return m_state.with([](auto& state) { return state.is_directory; });
@@ -10,6 +10,7 @@
 #include <AK/Badge.h>
 #include <AK/RefPtr.h>
 #include <Kernel/FileSystem/Custody.h>
+#include <Kernel/FileSystem/EventPoll.h>
 #include <Kernel/FileSystem/FIFO.h>
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/FileSystem/InodeMetadata.h>
@@ -65,6 +66,27 @@ public:
 
     bool is_directory() const;
 
+    enum class AccessPattern : u8 {
+        Normal,
+        Sequential,
+        Random,
+    };
+    AccessPattern access_pattern() const;
+    void set_access_pattern(AccessPattern);
+
+    // Used by filesystems to detect sequential reads through this description and read ahead of them.
+    struct ReadaheadState {
+        u64 next_offset { 0 };
+        u64 window_size { 0 };
+        u64 readahead_end { 0 };
+    };
+
+    template<typename Callback>
+    decltype(auto) with_readahead_state(Callback callback)
+    {
+        return m_state.with([&](auto& state) { return callback(state.readahead); });
+    }
+
     File& file() { return *m_file; }
     File const& file() const { return *m_file; }
 
@@ -80,6 +102,11 @@ public:
     InodeWatcher const* inode_watcher() const;
     InodeWatcher* inode_watcher();
 
+    bool is_event_poll() const;
+    EventPoll* event_poll();
+
+    EventPollWatch::DescriptionList& event_poll_watches(Badge<EventPoll>) { return m_event_poll_watches; }
+
     bool is_mount_file() const;
     MountFile const* mount_file() const;
     MountFile* mount_file();
@@ -157,8 +184,13 @@ private:
         bool should_append : 1 { false };
         bool direct : 1 { false };
         FIFO::Direction fifo_direction : 2 { FIFO::Direction::Neither };
+        AccessPattern access_pattern : 2 { AccessPattern::Normal };
+        ReadaheadState readahead;
     };
 
     SpinlockProtected<State, LockRank::None> m_state {};
+
+    // Protected by the EventPoll lock.
+    EventPollWatch::DescriptionList m_event_poll_watches;
 };
 }
@@ -37,6 +37,10 @@ ErrorOr<void> SysFSMemoryStatus::try_generate(KBufferBuilder& builder)
     TRY(json.add("physical_uncommitted"sv, system_memory.physical_pages_uncommitted));
     TRY(json.add("kmalloc_call_count"sv, stats.kmalloc_call_count));
     TRY(json.add("kfree_call_count"sv, stats.kfree_call_count));
+    TRY(json.add("kmalloc_cache_hits"sv, stats.processor_cache_hits));
+    TRY(json.add("kmalloc_cache_misses"sv, stats.processor_cache_misses));
+    TRY(json.add("kmalloc_cache_refills"sv, stats.processor_cache_refills));
+    TRY(json.add("kmalloc_cache_drains"sv, stats.processor_cache_drains));
     TRY(json.finish());
     return {};
 }
@@ -41,6 +41,20 @@ ErrorOr<void> SysFSNetworkTCPStats::try_generate(KBufferBuilder& builder)
         TRY(obj.add("bytes_in"sv, socket.bytes_in()));
         TRY(obj.add("packets_out"sv, socket.packets_out()));
         TRY(obj.add("bytes_out"sv, socket.bytes_out()));
+        auto congestion_state = socket.congestion_state();
+        TRY(obj.add("congestion_control"sv, TCPCongestionControl::to_string(congestion_state.algorithm)));
+        TRY(obj.add("maximum_segment_size"sv, congestion_state.maximum_segment_size));
+        TRY(obj.add("congestion_window"sv, congestion_state.congestion_window));
+        TRY(obj.add("slow_start_threshold"sv, congestion_state.slow_start_threshold));
+        if (auto smoothed_rtt = socket.smoothed_rtt(); smoothed_rtt.has_value()) {
+            TRY(obj.add("smoothed_rtt_us"sv, smoothed_rtt->to_microseconds()));
+            TRY(obj.add("rtt_variance_us"sv, socket.rtt_variance().to_microseconds()));
+        }
+        TRY(obj.add("retransmission_timeout_ms"sv, socket.retransmission_timeout().to_milliseconds()));
+        TRY(obj.add("retransmitted_packets"sv, socket.retransmitted_packets()));
+        TRY(obj.add("fast_retransmits"sv, socket.fast_retransmits()));
+        TRY(obj.add("retransmit_timeouts"sv, socket.retransmit_timeouts()));
+        TRY(obj.add("sack_permitted"sv, socket.is_sack_permitted()));
         auto current_process_credentials = Process::current().credentials();
         if (current_process_credentials->is_superuser() || current_process_credentials->uid() == socket.origin_uid()) {
             TRY(obj.add("origin_pid"sv, socket.origin_pid().value()));
@@ -23,6 +23,8 @@ class Device;
 class DeviceControlDevice;
 class DiskCache;
 class DoubleBuffer;
+class EventPoll;
+class EventPollWatch;
 class File;
 class FATInode;
 class OpenFileDescription;
@@ -10,6 +10,7 @@
 #include <Kernel/Debug.h>
 #include <Kernel/Heap/Heap.h>
 #include <Kernel/Heap/kmalloc.h>
+#include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/KSyms.h>
 #include <Kernel/Library/Panic.h>
 #include <Kernel/Library/StdLib.h>
@@ -29,6 +30,14 @@ static_assert(is_power_of_two(CHUNK_SIZE));
 static constexpr size_t INITIAL_KMALLOC_MEMORY_SIZE = 2 * MiB;
 static constexpr size_t KMALLOC_DEFAULT_ALIGNMENT = 16;
 
+#ifdef HAS_ADDRESS_SANITIZER
+// Slabs sitting in a processor cache look allocated to the sanitizer,
+// so go straight to the slabheaps to keep use-after-free detection working.
+static constexpr bool KMALLOC_USE_PROCESSOR_CACHES = false;
+#else
+static constexpr bool KMALLOC_USE_PROCESSOR_CACHES = true;
+#endif
+
 // Treat the heap as logically separate from .bss
 __attribute__((section(".heap"))) static u8 initial_kmalloc_memory[INITIAL_KMALLOC_MEMORY_SIZE];
 
@@ -95,6 +104,13 @@ public:
         m_freelist = freelist_entry;
     }
 
+    static KmallocSlabBlock& containing(void* ptr)
+    {
+        return *(KmallocSlabBlock*)((FlatPtr)ptr & block_mask);
+    }
+
+    size_t slab_size() const { return m_slab_size; }
+
     bool is_full() const
     {
         return m_freelist == nullptr;
@@ -168,7 +184,8 @@ public:
         memset(ptr, KFREE_SCRUB_BYTE, m_slab_size);
 #endif
 
-        auto* block = (KmallocSlabBlock*)((FlatPtr)ptr & KmallocSlabBlock::block_mask);
+        auto* block = &KmallocSlabBlock::containing(ptr);
+        VERIFY(block->slab_size() == m_slab_size);
         bool block_was_full = block->is_full();
         block->deallocate(ptr);
         if (block_was_full)
@@ -223,6 +240,8 @@ private:
     KmallocSlabBlock::List m_full_blocks;
 };
 
+static void drain_processor_caches();
+
 struct KmallocGlobalData {
     static constexpr size_t minimum_subheap_size = 1 * MiB;
 
@@ -257,6 +276,11 @@ struct KmallocGlobalData {
         if (size <= KmallocSlabBlock::block_size * 2 + sizeof(ptrdiff_t) + sizeof(size_t)) {
             // FIXME: We should propagate a freed pointer, to find the specific subheap it belonged to
             //        This would save us iterating over them in the next step and remove a recursion
+
+            // Free slabs sitting in the processor caches would keep their blocks from being purged.
+            if constexpr (KMALLOC_USE_PROCESSOR_CACHES)
+                drain_processor_caches();
+
             bool did_purge = false;
             for (auto& slabheap : slabheaps) {
                 if (slabheap.try_purge()) {
@@ -282,10 +306,8 @@ struct KmallocGlobalData {
         VERIFY(!expansion_in_progress);
         VERIFY(is_valid_kmalloc_address(VirtualAddress { ptr }));
 
-        for (auto& slabheap : slabheaps) {
-            if (size <= slabheap.slab_size())
-                return slabheap.deallocate(ptr);
-        }
+        if (auto index = slabheap_index_for_deallocation(ptr, size); index.has_value())
+            return slabheaps[*index].deallocate(ptr);
 
         for (auto& subheap : subheaps) {
             if (subheap.allocator.contains(ptr)) {
@@ -297,6 +319,21 @@ struct KmallocGlobalData {
         PANIC("Bogus pointer passed to kfree_sized({:p}, {})", ptr, size);
     }
 
+    // Over-aligned allocations are served from a bigger size class than their size falls into, so slabs are
+    // handed back to the slabheap recorded in their block rather than picking one by size.
+    Optional<size_t> slabheap_index_for_deallocation(void* ptr, size_t size) const
+    {
+        if (size > slabheaps[slabheap_count - 1].slab_size())
+            return {};
+        VERIFY(is_valid_kmalloc_address(VirtualAddress { ptr }));
+        auto slab_size = KmallocSlabBlock::containing(ptr).slab_size();
+        for (size_t i = 0; i < slabheap_count; ++i) {
+            if (slabheaps[i].slab_size() == slab_size)
+                return i;
+        }
+        PANIC("Bogus pointer passed to kfree_sized({:p}, {})", ptr, size);
+    }
+
     size_t allocated_bytes() const
     {
         size_t total = 0;
@@ -412,7 +449,8 @@ struct KmallocGlobalData {
 
     KmallocSubheap::List subheaps;
 
-    KmallocSlabheap slabheaps[6] = { 16, 32, 64, 128, 256, 512 };
+    static constexpr size_t slabheap_count = 6;
+    KmallocSlabheap slabheaps[slabheap_count] = { 16, 32, 64, 128, 256, 512 };
 
     bool expansion_in_progress { false };
 };
@@ -420,9 +458,40 @@ struct KmallocGlobalData {
 READONLY_AFTER_INIT static KmallocGlobalData* g_kmalloc_global;
 alignas(KmallocGlobalData) static u8 g_kmalloc_global_heap[sizeof(KmallocGlobalData)];
 
+// Every processor keeps a small stack ("magazine") of free slabs for each slabheap size class.
+// These are only ever touched by their own processor with interrupts disabled, so the common
+// case of kmalloc() and kfree_sized() for small objects never has to take s_lock. Magazines are
+// refilled from and drained to the shared slabheaps in batches.
+//
+// When the slabheaps need to purge empty blocks, every processor hands back all of its cached slabs: the one
+// purging right away, the others the next time they use their caches.
+struct KmallocProcessorCache {
+    struct Magazine {
+        static constexpr size_t capacity = 16;
+        static constexpr size_t batch_size = capacity / 2;
+
+        size_t count { 0 };
+        void* slabs[capacity];
+    };
+
+    Magazine magazines[KmallocGlobalData::slabheap_count];
+    u32 drain_generation { 0 };
+
+    size_t kmalloc_call_count { 0 };
+    size_t kfree_call_count { 0 };
+    size_t nested_kfree_calls { 0 };
+
+    size_t hits { 0 };
+    size_t misses { 0 };
+    size_t refills { 0 };
+    size_t drains { 0 };
+};
+
+static KmallocProcessorCache s_processor_caches[MAX_CPU_COUNT];
+static Atomic<u32> s_processor_cache_drain_generation { 0 };
+
 static size_t g_kmalloc_call_count;
 static size_t g_kfree_call_count;
-static size_t g_nested_kfree_calls;
 bool g_dump_kmalloc_stacks;
 
 void kmalloc_enable_expand()
@@ -439,6 +508,111 @@ UNMAP_AFTER_INIT void kmalloc_init()
     s_lock.initialize();
 }
 
+static KmallocProcessorCache& current_processor_cache()
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    return s_processor_caches[Processor::current_id()];
+}
+
+static void drain_processor_cache(KmallocProcessorCache& cache)
+{
+    VERIFY(s_lock.is_locked_by_current_processor());
+    cache.drain_generation = s_processor_cache_drain_generation.load(AK::MemoryOrder::memory_order_relaxed);
+    for (size_t i = 0; i < KmallocGlobalData::slabheap_count; ++i) {
+        auto& magazine = cache.magazines[i];
+        if (magazine.count == 0)
+            continue;
+        ++cache.drains;
+        for (size_t j = 0; j < magazine.count; ++j)
+            g_kmalloc_global->slabheaps[i].deallocate(magazine.slabs[j]);
+        magazine.count = 0;
+    }
+}
+
+static void drain_processor_caches()
+{
+    // The other processors' caches may only be touched by themselves, so we just ask them to drain.
+    s_processor_cache_drain_generation.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    drain_processor_cache(current_processor_cache());
+}
+
+static void drain_processor_cache_if_requested(KmallocProcessorCache& cache)
+{
+    if (cache.drain_generation == s_processor_cache_drain_generation.load(AK::MemoryOrder::memory_order_relaxed))
+        return;
+    SpinlockLocker lock(s_lock);
+    drain_processor_cache(cache);
+}
+
+static Optional<size_t> cached_slabheap_index_for(size_t size, size_t alignment)
+{
+    if constexpr (!KMALLOC_USE_PROCESSOR_CACHES)
+        return {};
+    // NOTE: There's no need to take the kmalloc lock, as the kmalloc slab-heaps (and their sizes) are constant
+    for (size_t i = 0; i < KmallocGlobalData::slabheap_count; ++i) {
+        auto slab_size = g_kmalloc_global->slabheaps[i].slab_size();
+        if (size <= slab_size && alignment <= slab_size)
+            return i;
+    }
+    return {};
+}
+
+static void* allocate_from_processor_cache(size_t slabheap_index, size_t size, CallerWillInitializeMemory caller_will_initialize_memory)
+{
+    auto& cache = current_processor_cache();
+    auto& magazine = cache.magazines[slabheap_index];
+    auto& slabheap = g_kmalloc_global->slabheaps[slabheap_index];
+    ++cache.kmalloc_call_count;
+    drain_processor_cache_if_requested(cache);
+
+    if (magazine.count == 0) {
+        ++cache.misses;
+        SpinlockLocker lock(s_lock);
+        ++cache.refills;
+        while (magazine.count < KmallocProcessorCache::Magazine::batch_size) {
+            auto* ptr = slabheap.allocate(size, CallerWillInitializeMemory::Yes);
+            if (!ptr)
+                break;
+            magazine.slabs[magazine.count++] = ptr;
+        }
+        if (magazine.count == 0)
+            return nullptr;
+    } else {
+        ++cache.hits;
+    }
+
+    auto* ptr = magazine.slabs[--magazine.count];
+    if (caller_will_initialize_memory == CallerWillInitializeMemory::No)
+        memset(ptr, KMALLOC_SCRUB_BYTE, slabheap.slab_size());
+    return ptr;
+}
+
+static void deallocate_to_processor_cache(size_t slabheap_index, void* ptr)
+{
+    auto& cache = current_processor_cache();
+    auto& magazine = cache.magazines[slabheap_index];
+    auto& slabheap = g_kmalloc_global->slabheaps[slabheap_index];
+    ++cache.kfree_call_count;
+    drain_processor_cache_if_requested(cache);
+
+    VERIFY(g_kmalloc_global->is_valid_kmalloc_address(VirtualAddress { ptr }));
+
+    if (magazine.count == KmallocProcessorCache::Magazine::capacity) {
+        ++cache.drains;
+        SpinlockLocker lock(s_lock);
+        // Hand back the slabs that have been sitting in the magazine the longest,
+        // the recently freed ones are more likely to still be in our caches.
+        constexpr auto batch_size = KmallocProcessorCache::Magazine::batch_size;
+        for (size_t i = 0; i < batch_size; ++i)
+            slabheap.deallocate(magazine.slabs[i]);
+        magazine.count -= batch_size;
+        memmove(magazine.slabs, magazine.slabs + batch_size, magazine.count * sizeof(void*));
+    }
+
+    memset(ptr, KFREE_SCRUB_BYTE, slabheap.slab_size());
+    magazine.slabs[magazine.count++] = ptr;
+}
+
 static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMemory caller_will_initialize_memory)
 {
     // Catch bad callers allocating under spinlock.
@@ -449,15 +623,21 @@ static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMem
     // Alignment must be a power of two.
     VERIFY(is_power_of_two(alignment));
 
-    SpinlockLocker lock(s_lock);
-    ++g_kmalloc_call_count;
+    InterruptDisabler disabler;
 
     if (g_dump_kmalloc_stacks && Kernel::g_kernel_symbols_available.was_set()) {
         dbgln("kmalloc({})", size);
         Kernel::dump_backtrace();
     }
 
-    void* ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+    void* ptr = nullptr;
+    if (auto slabheap_index = cached_slabheap_index_for(size, alignment); slabheap_index.has_value()) {
+        ptr = allocate_from_processor_cache(*slabheap_index, size, caller_will_initialize_memory);
+    } else {
+        SpinlockLocker lock(s_lock);
+        ++g_kmalloc_call_count;
+        ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+    }
 
     Thread* current_thread = Thread::current();
     if (!current_thread)
@@ -500,11 +680,11 @@ void kfree_sized(void* ptr, size_t size)
         Processor::verify_no_spinlocks_held();
     }
 
-    SpinlockLocker lock(s_lock);
-    ++g_kfree_call_count;
-    ++g_nested_kfree_calls;
+    InterruptDisabler disabler;
+    auto& cache = current_processor_cache();
+    ++cache.nested_kfree_calls;
 
-    if (g_nested_kfree_calls == 1) {
+    if (cache.nested_kfree_calls == 1) {
         Thread* current_thread = Thread::current();
         if (!current_thread)
             current_thread = Processor::idle_thread();
@@ -514,8 +694,17 @@ void kfree_sized(void* ptr, size_t size)
         }
     }
 
-    g_kmalloc_global->deallocate(ptr, size);
-    --g_nested_kfree_calls;
+    Optional<size_t> slabheap_index;
+    if constexpr (KMALLOC_USE_PROCESSOR_CACHES)
+        slabheap_index = g_kmalloc_global->slabheap_index_for_deallocation(ptr, size);
+    if (slabheap_index.has_value()) {
+        deallocate_to_processor_cache(*slabheap_index, ptr);
+    } else {
+        SpinlockLocker lock(s_lock);
+        ++g_kfree_call_count;
+        g_kmalloc_global->deallocate(ptr, size);
+    }
+    --cache.nested_kfree_calls;
 }
 
 size_t kmalloc_good_size(size_t size)
@@ -604,4 +793,25 @@ void get_kmalloc_stats(kmalloc_stats& stats)
     stats.bytes_free = g_kmalloc_global->free_bytes();
     stats.kmalloc_call_count = g_kmalloc_call_count;
     stats.kfree_call_count = g_kfree_call_count;
+    stats.processor_cache_hits = 0;
+    stats.processor_cache_misses = 0;
+    stats.processor_cache_refills = 0;
+    stats.processor_cache_drains = 0;
+
+    // NOTE: The processor caches are updated without holding s_lock, so this is only a snapshot.
+    for (auto const& cache : s_processor_caches) {
+        stats.kmalloc_call_count += cache.kmalloc_call_count;
+        stats.kfree_call_count += cache.kfree_call_count;
+        stats.processor_cache_hits += cache.hits;
+        stats.processor_cache_misses += cache.misses;
+        stats.processor_cache_refills += cache.refills;
+        stats.processor_cache_drains += cache.drains;
+
+        // Slabs waiting in a magazine are free as far as kmalloc's users are concerned.
+        for (size_t i = 0; i < KmallocGlobalData::slabheap_count; ++i) {
+            auto cached_bytes = cache.magazines[i].count * g_kmalloc_global->slabheaps[i].slab_size();
+            stats.bytes_allocated -= cached_bytes;
+            stats.bytes_free += cached_bytes;
+        }
+    }
 }
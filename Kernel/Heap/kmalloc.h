@@ -52,6 +52,10 @@ struct kmalloc_stats {
     size_t bytes_free;
     size_t kmalloc_call_count;
     size_t kfree_call_count;
+    size_t processor_cache_hits;
+    size_t processor_cache_misses;
+    size_t processor_cache_refills;
+    size_t processor_cache_drains;
 };
 void get_kmalloc_stats(kmalloc_stats&);
 
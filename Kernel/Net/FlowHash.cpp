@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Library/StdLib.h>
+#include <Kernel/Net/EtherType.h>
+#include <Kernel/Net/EthernetFrameHeader.h>
+#include <Kernel/Net/FlowHash.h>
+#include <Kernel/Net/IPv4/IPv4.h>
+
+namespace Kernel {
+
+u8 const default_flow_hash_key[40] = {
+    0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+    0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+    0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+    0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+    0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa
+};
+
+u32 toeplitz_hash(ReadonlyBytes key, ReadonlyBytes input)
+{
+    VERIFY(key.size() >= input.size() + sizeof(u32));
+
+    // For every set bit of the input, XOR in the 32 bits of the key that start at that bit.
+    u32 result = 0;
+    u32 window = (key[0] << 24) | (key[1] << 16) | (key[2] << 8) | key[3];
+    for (size_t i = 0; i < input.size(); ++i) {
+        for (int bit = 7; bit >= 0; --bit) {
+            if (input[i] & (1 << bit))
+                result ^= window;
+            window <<= 1;
+            if (key[i + sizeof(u32)] & (1 << bit))
+                window |= 1;
+        }
+    }
+    return result;
+}
+
+u32 compute_flow_hash(ReadonlyBytes ethernet_frame)
+{
+    if (ethernet_frame.size() < sizeof(EthernetFrameHeader) + sizeof(IPv4Packet))
+        return 0;
+    auto const& eth = *reinterpret_cast<EthernetFrameHeader const*>(ethernet_frame.data());
+    if (eth.ether_type() != EtherType::IPv4)
+        return 0;
+
+    auto ipv4_header = ethernet_frame.slice(sizeof(EthernetFrameHeader));
+    auto const& ipv4_packet = *reinterpret_cast<IPv4Packet const*>(ipv4_header.data());
+    size_t header_length = ipv4_packet.internet_header_length() * sizeof(u32);
+    if (header_length < sizeof(IPv4Packet))
+        return 0;
+
+    // The source and destination addresses are adjacent in the header, and so are
+    // the ports in TCP and UDP headers, which gives the standard RSS input layout.
+    u8 input[12];
+    memcpy(input, ipv4_header.offset_pointer(12), 8);
+    size_t input_size = 8;
+
+    auto protocol = static_cast<IPv4Protocol>(ipv4_packet.protocol());
+    bool has_ports = protocol == IPv4Protocol::TCP || protocol == IPv4Protocol::UDP;
+    if (has_ports && !ipv4_packet.is_a_fragment() && ipv4_header.size() >= header_length + 2 * sizeof(u16)) {
+        memcpy(input + 8, ipv4_header.offset_pointer(header_length), 2 * sizeof(u16));
+        input_size = 12;
+    }
+
+    return toeplitz_hash({ default_flow_hash_key, sizeof(default_flow_hash_key) }, { input, input_size });
+}
+
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// Receive Side Scaling: every packet of a connection must end up on the same
+// network worker, so that the packets of a flow are processed in order.
+
+// The well-known default RSS key, so that hashes computed by hardware that was
+// programmed with it match the ones we compute in software.
+extern u8 const default_flow_hash_key[40];
+
+u32 toeplitz_hash(ReadonlyBytes key, ReadonlyBytes input);
+
+// Hashes the IPv4 addresses and, for unfragmented TCP and UDP packets, the ports
+// of an Ethernet frame. Returns 0 for anything that isn't IPv4.
+u32 compute_flow_hash(ReadonlyBytes ethernet_frame);
+
+}
@@ -12,6 +12,7 @@
 #include <Kernel/Bus/PCI/Device.h>
 #include <Kernel/Interrupts/IRQHandler.h>
 #include <Kernel/Library/IOWindow.h>
+#include <Kernel/Locking/Mutex.h>
 #include <Kernel/Net/NetworkAdapter.h>
 #include <Kernel/Security/Random.h>
 
@@ -102,5 +103,7 @@ protected:
     EntropySource m_entropy_source;
 
     WaitQueue m_wait_queue;
+    // The network workers of all processors may transmit at the same time.
+    Mutex m_send_lock { "E1000NetworkAdapter"sv };
 };
 }
@@ -5,9 +5,9 @@
  */
 
 #include <Kernel/Heap/kmalloc.h>
-#include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/Library/StdLib.h>
 #include <Kernel/Net/EtherType.h>
+#include <Kernel/Net/FlowHash.h>
 #include <Kernel/Net/NetworkAdapter.h>
 #include <Kernel/Net/NetworkingManagement.h>
 #include <Kernel/Tasks/Process.h>
@@ -69,38 +69,51 @@ void NetworkAdapter::fill_in_ipv4_header(PacketWithTimestamp& packet, IPv4Addres
     ipv4.set_checksum(ipv4.compute_checksum());
 }
 
-void NetworkAdapter::did_receive(ReadonlyBytes payload)
+void NetworkAdapter::did_receive(ReadonlyBytes payload, Optional<u32> flow_hash)
 {
-    InterruptDisabler disabler;
     m_packets_in++;
     m_bytes_in += payload.size();
 
-    if (m_packet_queue_size == max_packet_buffers) {
+    if (m_packet_queue_size.fetch_add(1) >= max_packet_buffers) {
+        m_packet_queue_size--;
         m_packets_dropped++;
         return;
     }
 
     auto packet = acquire_packet_buffer(payload.size());
     if (!packet) {
+        m_packet_queue_size--;
         dbgln("Discarding packet because we're out of memory");
         return;
     }
 
     memcpy(packet->buffer->data(), payload.data(), payload.size());
 
-    m_packet_queue.append(*packet);
-    m_packet_queue_size++;
+    auto queue_index = NetworkTask::worker_for_flow_hash(flow_hash.has_value() ? *flow_hash : compute_flow_hash(payload));
+    m_receive_queues[queue_index].with([&](auto& queue) {
+        queue.append(*packet);
+    });
 
     if (on_receive)
-        on_receive();
+        on_receive(queue_index);
 }
 
-size_t NetworkAdapter::dequeue_packet(u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp)
+bool NetworkAdapter::has_queued_packets(size_t queue_index) const
 {
-    InterruptDisabler disabler;
-    if (m_packet_queue.is_empty())
+    return m_receive_queues[queue_index].with([](auto const& queue) {
+        return !queue.is_empty();
+    });
+}
+
+size_t NetworkAdapter::dequeue_packet(size_t queue_index, u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp)
+{
+    auto packet_with_timestamp = m_receive_queues[queue_index].with([](auto& queue) -> RefPtr<PacketWithTimestamp> {
+        if (queue.is_empty())
+            return nullptr;
+        return queue.take_first();
+    });
+    if (!packet_with_timestamp)
         return 0;
-    auto packet_with_timestamp = m_packet_queue.take_first();
     m_packet_queue_size--;
     packet_timestamp = packet_with_timestamp->timestamp;
     auto& packet_buffer = packet_with_timestamp->buffer;
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/AtomicRefCounted.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Function.h>
@@ -17,10 +18,12 @@
 #include <Kernel/Library/LockWeakPtr.h>
 #include <Kernel/Library/LockWeakable.h>
 #include <Kernel/Library/UserOrKernelBuffer.h>
+#include <Kernel/Locking/SpinlockProtected.h>
 #include <Kernel/Net/EthernetFrameHeader.h>
 #include <Kernel/Net/ICMP.h>
 #include <Kernel/Net/IPv4/ARP.h>
 #include <Kernel/Net/IPv4/IPv4.h>
+#include <Kernel/Net/NetworkTask.h>
 
 namespace Kernel {
 
@@ -79,9 +82,9 @@ public:
     void send(MACAddress const&, ARPPacket const&);
     void fill_in_ipv4_header(PacketWithTimestamp&, IPv4Address const&, MACAddress const&, IPv4Address const&, IPv4Protocol, size_t, u8 type_of_service, u8 ttl);
 
-    size_t dequeue_packet(u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp);
+    size_t dequeue_packet(size_t queue_index, u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp);
 
-    bool has_queued_packets() const { return !m_packet_queue.is_empty(); }
+    bool has_queued_packets(size_t queue_index) const;
 
     u32 mtu() const { return m_mtu; }
     void set_mtu(u32 mtu) { m_mtu = mtu; }
@@ -98,14 +101,18 @@ public:
     constexpr size_t layer3_payload_offset() const { return sizeof(EthernetFrameHeader); }
     constexpr size_t ipv4_payload_offset() const { return layer3_payload_offset() + sizeof(IPv4Packet); }
 
-    Function<void()> on_receive;
+    // Called with the index of the receive queue, which is also the index of
+    // the network worker that is going to process the packet.
+    Function<void(size_t queue_index)> on_receive;
 
     void send_packet(ReadonlyBytes);
 
 protected:
     NetworkAdapter(StringView);
     void set_mac_address(MACAddress const& mac_address) { m_mac_address = mac_address; }
-    void did_receive(ReadonlyBytes);
+    // Drivers whose hardware computed the flow hash with default_flow_hash_key
+    // can pass it along, which saves us from hashing the packet again.
+    void did_receive(ReadonlyBytes, Optional<u32> flow_hash = {});
     virtual void send_raw(ReadonlyBytes) = 0;
 
 private:
@@ -118,16 +125,17 @@ private:
 
     using PacketList = IntrusiveList<&PacketWithTimestamp::packet_node>;
 
-    PacketList m_packet_queue;
-    size_t m_packet_queue_size { 0 };
+    Array<SpinlockProtected<PacketList, LockRank::None>, NetworkTask::maximum_worker_count> m_receive_queues {};
+    Atomic<size_t> m_packet_queue_size { 0 };
     SpinlockProtected<PacketList, LockRank::None> m_unused_packets {};
     FixedStringBuffer<IFNAMSIZ> m_name;
-    u32 m_packets_in { 0 };
-    u32 m_bytes_in { 0 };
-    u32 m_packets_out { 0 };
-    u32 m_bytes_out { 0 };
+    // Packets are sent and received on all processors at once.
+    Atomic<u32, AK::MemoryOrder::memory_order_relaxed> m_packets_in { 0 };
+    Atomic<u32, AK::MemoryOrder::memory_order_relaxed> m_bytes_in { 0 };
+    Atomic<u32, AK::MemoryOrder::memory_order_relaxed> m_packets_out { 0 };
+    Atomic<u32, AK::MemoryOrder::memory_order_relaxed> m_bytes_out { 0 };
     u32 m_mtu { 1500 };
-    u32 m_packets_dropped { 0 };
+    Atomic<u32, AK::MemoryOrder::memory_order_relaxed> m_packets_dropped { 0 };
 };
 
 }
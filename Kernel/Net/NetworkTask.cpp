@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/Debug.h>
+#include <Kernel/Library/KString.h>
 #include <Kernel/Locking/Mutex.h>
 #include <Kernel/Locking/MutexProtected.h>
 #include <Kernel/Net/EtherType.h>
@@ -35,28 +37,28 @@ static void send_tcp_rst(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_pac
 static void flush_delayed_tcp_acks();
 static void retransmit_tcp_packets();
 
-static Thread* network_task = nullptr;
-static HashTable<NonnullRefPtr<TCPSocket>>* delayed_ack_sockets;
+struct NetworkWorker {
+    size_t index { 0 };
+    Thread* thread { nullptr };
+    WaitQueue packet_wait_queue;
+    // Packets may have been queued before the worker existed.
+    Atomic<bool> has_pending_packets { true };
+    // A flow is always handled by the same worker, and so are its delayed ACKs.
+    HashTable<NonnullRefPtr<TCPSocket>> delayed_ack_sockets;
+};
+
+static Process* network_process = nullptr;
+static Array<NetworkWorker*, NetworkTask::maximum_worker_count> workers {};
 
 [[noreturn]] static void NetworkTask_main(void*);
 
 void NetworkTask::spawn()
 {
-    auto [_, first_thread] = MUST(Process::create_kernel_process("Network Task"sv, NetworkTask_main, nullptr));
-    network_task = first_thread;
-}
-
-bool NetworkTask::is_current()
-{
-    return Thread::current() == network_task;
-}
-
-void NetworkTask_main(void*)
-{
-    delayed_ack_sockets = new HashTable<NonnullRefPtr<TCPSocket>>;
+    for (size_t i = 0; i < worker_count(); ++i) {
+        workers[i] = new NetworkWorker;
+        workers[i]->index = i;
+    }
 
-    WaitQueue packet_wait_queue;
-    int pending_packets = 0;
     NetworkingManagement::the().for_each([&](auto& adapter) {
         dmesgln("NetworkTask: {} network adapter found: hw={}", adapter.class_name(), adapter.mac_address().to_string());
 
@@ -65,23 +67,61 @@ void NetworkTask_main(void*)
             adapter.set_ipv4_netmask({ 255, 0, 0, 0 });
         }
 
-        adapter.on_receive = [&]() {
-            pending_packets++;
-            packet_wait_queue.wake_all();
+        adapter.on_receive = [](size_t queue_index) {
+            auto& worker = *workers[queue_index];
+            worker.has_pending_packets = true;
+            worker.packet_wait_queue.wake_all();
         };
     });
 
-    auto dequeue_packet = [&pending_packets](u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp) -> size_t {
-        if (pending_packets == 0)
+    // Each worker is pinned to its own processor, so that the packets of a flow
+    // stay in the caches of the processor that handles them.
+    auto [process, _] = MUST(Process::create_kernel_process("Network Task"sv, NetworkTask_main, workers[0], 1u << 0));
+    network_process = process.ptr();
+    for (size_t i = 1; i < worker_count(); ++i) {
+        auto name = MUST(KString::formatted("Network Task #{}", i));
+        (void)MUST(process->create_kernel_thread(NetworkTask_main, workers[i], THREAD_PRIORITY_NORMAL, name->view(), 1u << i, false));
+    }
+}
+
+bool NetworkTask::is_current()
+{
+    return network_process && &Process::current() == network_process;
+}
+
+size_t NetworkTask::worker_count()
+{
+    // Adapters start receiving before we spawn, so this must not depend on spawn() having run.
+    return clamp(Processor::count(), 1u, maximum_worker_count);
+}
+
+static NetworkWorker& current_worker()
+{
+    for (size_t i = 0; i < NetworkTask::worker_count(); ++i) {
+        if (workers[i]->thread == Thread::current())
+            return *workers[i];
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void NetworkTask_main(void* data)
+{
+    auto& worker = *static_cast<NetworkWorker*>(data);
+    worker.thread = Thread::current();
+
+    auto dequeue_packet = [&worker](u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp) -> size_t {
+        if (!worker.has_pending_packets.exchange(false))
             return 0;
         size_t packet_size = 0;
         NetworkingManagement::the().for_each([&](auto& adapter) {
-            if (packet_size || !adapter.has_queued_packets())
+            if (packet_size || !adapter.has_queued_packets(worker.index))
                 return;
-            packet_size = adapter.dequeue_packet(buffer, buffer_size, packet_timestamp);
-            pending_packets--;
-            dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes)", adapter.name(), packet_size);
+            packet_size = adapter.dequeue_packet(worker.index, buffer, buffer_size, packet_timestamp);
+            dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes) on worker {}", adapter.name(), packet_size, worker.index);
         });
+        // There may be more packets queued up behind this one.
+        if (packet_size)
+            worker.has_pending_packets = true;
         return packet_size;
     };
 
@@ -95,12 +135,14 @@ void NetworkTask_main(void*)
 
     while (!Process::current().is_dying()) {
         flush_delayed_tcp_acks();
-        retransmit_tcp_packets();
+        // Retransmissions aren't tied to incoming packets, so the first worker handles all of them.
+        if (worker.index == 0)
+            retransmit_tcp_packets();
         size_t packet_size = dequeue_packet(buffer, buffer_size, packet_timestamp);
         if (!packet_size) {
             auto timeout_time = Duration::from_milliseconds(500);
             auto timeout = Thread::BlockTimeout { false, &timeout_time };
-            [[maybe_unused]] auto result = packet_wait_queue.wait_on(timeout, "NetworkTask"sv);
+            [[maybe_unused]] auto result = worker.packet_wait_queue.wait_on(timeout, "NetworkTask"sv);
             continue;
         }
         if (packet_size < sizeof(EthernetFrameHeader)) {
@@ -124,7 +166,9 @@ void NetworkTask_main(void*)
             dbgln_if(ETHERNET_DEBUG, "NetworkTask: Unknown ethernet type {:#04x}", eth.ether_type());
         }
     }
-    Process::current().sys$exit(0);
+    if (worker.index == 0)
+        Process::current().sys$exit(0);
+    Thread::current()->exit();
     VERIFY_NOT_REACHED();
 }
 
@@ -308,13 +352,14 @@ void send_delayed_tcp_ack(TCPSocket& socket)
         return;
     }
 
-    delayed_ack_sockets->set(move(socket));
+    current_worker().delayed_ack_sockets.set(move(socket));
 }
 
 void flush_delayed_tcp_acks()
 {
+    auto& delayed_ack_sockets = current_worker().delayed_ack_sockets;
     Vector<NonnullRefPtr<TCPSocket>, 32> remaining_sockets;
-    for (auto& socket : *delayed_ack_sockets) {
+    for (auto& socket : delayed_ack_sockets) {
         MutexLocker locker(socket->mutex());
         if (socket->should_delay_next_ack()) {
             MUST(remaining_sockets.try_append(*socket));
@@ -323,12 +368,12 @@ void flush_delayed_tcp_acks()
         [[maybe_unused]] auto result = socket->send_ack();
     }
 
-    if (remaining_sockets.size() != delayed_ack_sockets->size()) {
-        delayed_ack_sockets->clear();
+    if (remaining_sockets.size() != delayed_ack_sockets.size()) {
+        delayed_ack_sockets.clear();
         if (remaining_sockets.size() > 0)
             dbgln("flush_delayed_tcp_acks: {} sockets remaining", remaining_sockets.size());
         for (auto&& socket : remaining_sockets)
-            delayed_ack_sockets->set(move(socket));
+            delayed_ack_sockets.set(move(socket));
     }
 }
 
@@ -431,19 +476,46 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
 
     socket->receive_tcp_packet(tcp_packet, ipv4_packet.payload_size());
     Optional<u8> send_window_scale;
+    Optional<u16> peer_maximum_segment_size;
+    bool sack_permitted = false;
     if (tcp_packet.has_syn()) {
-        tcp_packet.for_each_option([&send_window_scale](auto const& option) {
-            if (option.kind() != TCPOptionKind::WindowScale)
+        tcp_packet.for_each_option([&](auto const& option) {
+            switch (option.kind()) {
+            case TCPOptionKind::WindowScale: {
+                if (option.length() != sizeof(TCPOptionWindowScale))
+                    return;
+                auto scale = static_cast<TCPOptionWindowScale const&>(option).value();
+                if (scale > 14)
+                    return; // Maximum allowed as per RFC7323
+                send_window_scale = scale;
                 return;
-            if (option.length() != sizeof(TCPOptionWindowScale))
+            }
+            case TCPOptionKind::MSS:
+                if (option.length() != sizeof(TCPOptionMSS))
+                    return;
+                peer_maximum_segment_size = static_cast<TCPOptionMSS const&>(option).value();
                 return;
-            auto scale = static_cast<TCPOptionWindowScale const&>(option).value();
-            if (scale > 14)
-                return; // Maximum allowed as per RFC7323
-            send_window_scale = scale;
+            case TCPOptionKind::SACKPermitted:
+                if (option.length() != sizeof(TCPOptionSACKPermitted))
+                    return;
+                sack_permitted = true;
+                return;
+            default:
+                return;
+            }
         });
     }
 
+    auto apply_syn_options = [&](TCPSocket& syn_socket) {
+        if (send_window_scale.has_value())
+            syn_socket.set_send_window_scale(*send_window_scale);
+        if (peer_maximum_segment_size.has_value())
+            syn_socket.set_peer_maximum_segment_size(*peer_maximum_segment_size);
+        // RFC 2018: We always offer SACK-Permitted in our own SYN.
+        if (sack_permitted)
+            syn_socket.set_sack_permitted();
+    };
+
     switch (socket->state()) {
     case TCPSocket::State::Closed:
         dbgln("handle_tcp: unexpected flags in Closed state ({:x}) for socket with tuple {}", tcp_packet.flags(), tuple.to_string());
@@ -477,8 +549,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
             client->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
             [[maybe_unused]] auto rc2 = client->send_tcp_packet(TCPFlags::SYN | TCPFlags::ACK);
             client->set_state(TCPSocket::State::SynReceived);
-            if (send_window_scale.has_value())
-                client->set_send_window_scale(*send_window_scale);
+            apply_syn_options(*client);
             return;
         }
         default:
@@ -492,8 +563,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
             socket->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
             (void)socket->send_tcp_packet(TCPFlags::SYN | TCPFlags::ACK);
             socket->set_state(TCPSocket::State::SynReceived);
-            if (send_window_scale.has_value())
-                socket->set_send_window_scale(*send_window_scale);
+            apply_syn_options(*socket);
             return;
         case TCPFlags::ACK | TCPFlags::SYN:
             socket->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
@@ -501,8 +571,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
             socket->set_state(TCPSocket::State::Established);
             socket->set_setup_state(Socket::SetupState::Completed);
             socket->set_connected(true);
-            if (send_window_scale.has_value())
-                socket->set_send_window_scale(*send_window_scale);
+            apply_syn_options(*socket);
             return;
         case TCPFlags::ACK | TCPFlags::FIN:
             socket->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
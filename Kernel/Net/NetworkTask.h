@@ -6,10 +6,19 @@
 
 #pragma once
 
+#include <AK/Types.h>
+
 namespace Kernel {
 class NetworkTask {
 public:
+    // Incoming packets are processed by one worker thread per processor. Packets
+    // are steered to a worker by their flow hash, so each flow stays in order.
+    static constexpr size_t maximum_worker_count = 16;
+
     static void spawn();
     static bool is_current();
+
+    static size_t worker_count();
+    static size_t worker_for_flow_hash(u32 flow_hash) { return flow_hash % worker_count(); }
 };
 }
@@ -74,7 +74,38 @@ private:
     NetworkOrdered<u8> m_value;
 };
 
+class [[gnu::packed]] TCPOptionSACKPermitted : public TCPOption {
+public:
+    TCPOptionSACKPermitted()
+        : TCPOption(TCPOptionKind::SACKPermitted, sizeof(TCPOptionSACKPermitted))
+    {
+    }
+};
+
+// RFC 2018: Blocks of data the receiver holds beyond the cumulative acknowledgment.
+class [[gnu::packed]] TCPOptionSACK : public TCPOption {
+public:
+    struct [[gnu::packed]] Block {
+        NetworkOrdered<u32> left_edge;
+        NetworkOrdered<u32> right_edge;
+    };
+
+    // RFC 2018, 3: An option can't hold more than 4 blocks, as it has to fit into the 40 bytes of TCP options.
+    static constexpr size_t maximum_block_count = 4;
+
+    bool is_valid() const
+    {
+        auto blocks_size = length() - sizeof(TCPOption);
+        return blocks_size % sizeof(Block) == 0 && blocks_size / sizeof(Block) >= 1 && blocks_size / sizeof(Block) <= maximum_block_count;
+    }
+
+    size_t block_count() const { return (length() - sizeof(TCPOption)) / sizeof(Block); }
+    Block const& block(size_t index) const { return reinterpret_cast<Block const*>(this + 1)[index]; }
+};
+
 static_assert(AssertSize<TCPOptionMSS, 4>());
+static_assert(AssertSize<TCPOptionSACKPermitted, 2>());
+static_assert(AssertSize<TCPOptionSACK::Block, 8>());
 
 class [[gnu::packed]] TCPPacket {
 public:
@@ -135,6 +166,8 @@ public:
             }
             if (option->length() < sizeof(TCPOption))
                 return; // minimal option length
+            if (option->length() > (size_t)options_end - (size_t)next_option)
+                return; // The option runs past the end of the header
             callback(*option);
             next_option += option->length();
         }
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Checked.h>
+#include <Kernel/Net/TCPCongestionControl.h>
+
+namespace Kernel {
+
+StringView TCPCongestionControl::to_string(Algorithm algorithm)
+{
+    switch (algorithm) {
+    case Algorithm::NewReno:
+        return "newreno"sv;
+    case Algorithm::Cubic:
+        return "cubic"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+Optional<TCPCongestionControl::Algorithm> TCPCongestionControl::algorithm_from_string(StringView name)
+{
+    if (name == "newreno"sv || name == "reno"sv)
+        return Algorithm::NewReno;
+    if (name == "cubic"sv)
+        return Algorithm::Cubic;
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<TCPCongestionControl>> TCPCongestionControl::try_create(Algorithm algorithm, u32 maximum_segment_size)
+{
+    switch (algorithm) {
+    case Algorithm::NewReno:
+        return adopt_nonnull_own_or_enomem<TCPCongestionControl>(new (nothrow) TCPNewReno(maximum_segment_size));
+    case Algorithm::Cubic:
+        return adopt_nonnull_own_or_enomem<TCPCongestionControl>(new (nothrow) TCPCubic(maximum_segment_size));
+    }
+    VERIFY_NOT_REACHED();
+}
+
+TCPCongestionControl::TCPCongestionControl(u32 maximum_segment_size)
+{
+    set_maximum_segment_size(maximum_segment_size);
+}
+
+void TCPCongestionControl::set_maximum_segment_size(u32 maximum_segment_size)
+{
+    // RFC 879 guarantees that every host accepts segments of at least 536 bytes,
+    // so anything smaller than that must be a bogus route MTU or MSS option.
+    m_maximum_segment_size = max(maximum_segment_size, 536u);
+
+    // RFC 6928: "IW = min (10*MSS, max (2*MSS, 14600))"
+    if (!m_has_seen_ack)
+        m_congestion_window = min(10 * m_maximum_segment_size, max(2 * m_maximum_segment_size, 14600u));
+}
+
+void TCPCongestionControl::inherit_window_from(TCPCongestionControl const& other)
+{
+    m_congestion_window = other.m_congestion_window;
+    m_slow_start_threshold = other.m_slow_start_threshold;
+    m_has_seen_ack = other.m_has_seen_ack;
+}
+
+void TCPCongestionControl::on_ack(u32 bytes_acknowledged, MonotonicTime now, Optional<Duration> smoothed_rtt)
+{
+    // The ACK for our SYN doesn't acknowledge any data, so it must not stop
+    // set_maximum_segment_size() from sizing the initial window.
+    if (bytes_acknowledged == 0)
+        return;
+    m_has_seen_ack = true;
+
+    if (is_in_slow_start()) {
+        // RFC 5681, 3.1: "cwnd += min (N, SMSS)"
+        m_congestion_window = Checked<u32>::saturating_add(m_congestion_window, min(bytes_acknowledged, m_maximum_segment_size));
+        return;
+    }
+
+    grow_in_congestion_avoidance(bytes_acknowledged, now, smoothed_rtt);
+}
+
+void TCPCongestionControl::on_fast_retransmit(u32 bytes_in_flight, bool inflate_window)
+{
+    m_has_seen_ack = true;
+    m_slow_start_threshold = slow_start_threshold_after_loss(bytes_in_flight);
+
+    // RFC 6582, 3.2 step 2: "set cwnd to ssthresh plus 3*SMSS". With SACK the
+    // socket counts the segments that have left the network itself (RFC 6675),
+    // so the window must not be inflated for them as well.
+    m_congestion_window = m_slow_start_threshold;
+    if (inflate_window)
+        m_congestion_window = Checked<u32>::saturating_add(m_congestion_window, 3 * m_maximum_segment_size);
+
+    did_reset_window();
+}
+
+void TCPCongestionControl::on_duplicate_ack_during_recovery()
+{
+    // RFC 6582, 3.2 step 4: "increment cwnd by SMSS".
+    m_congestion_window = Checked<u32>::saturating_add(m_congestion_window, m_maximum_segment_size);
+}
+
+void TCPCongestionControl::on_partial_ack(u32 bytes_acknowledged)
+{
+    // RFC 6582, 3.2 step 5: "deflate the congestion window by the amount of new data
+    // acknowledged by the cumulative acknowledgment field. If the partial ACK
+    // acknowledges at least one SMSS of new data, then add back SMSS bytes".
+    m_congestion_window = m_congestion_window > bytes_acknowledged ? m_congestion_window - bytes_acknowledged : 0;
+    if (bytes_acknowledged >= m_maximum_segment_size)
+        m_congestion_window += m_maximum_segment_size;
+    m_congestion_window = max(m_congestion_window, m_maximum_segment_size);
+}
+
+void TCPCongestionControl::on_recovery_complete()
+{
+    // RFC 6582, 3.2 step 6: "Set cwnd to ssthresh".
+    m_congestion_window = m_slow_start_threshold;
+}
+
+void TCPCongestionControl::on_retransmit_timeout(u32 bytes_in_flight)
+{
+    m_has_seen_ack = true;
+    m_slow_start_threshold = slow_start_threshold_after_loss(bytes_in_flight);
+    m_congestion_window = m_maximum_segment_size;
+    did_reset_window();
+}
+
+void TCPNewReno::grow_in_congestion_avoidance(u32 bytes_acknowledged, MonotonicTime, Optional<Duration>)
+{
+    // RFC 5681, 3.1: grow by one SMSS per round trip, counting acknowledged bytes
+    // rather than ACKs so that delayed ACKs don't slow us down (RFC 3465).
+    m_bytes_acknowledged += bytes_acknowledged;
+    if (m_bytes_acknowledged < m_congestion_window)
+        return;
+    m_bytes_acknowledged -= m_congestion_window;
+    m_congestion_window = Checked<u32>::saturating_add(m_congestion_window, m_maximum_segment_size);
+}
+
+u32 TCPNewReno::slow_start_threshold_after_loss(u32 bytes_in_flight)
+{
+    // RFC 5681, 3.1: "ssthresh = max (FlightSize / 2, 2*SMSS)"
+    return max(bytes_in_flight / 2, 2 * m_maximum_segment_size);
+}
+
+// RFC 9438, 4.6: beta_cubic = 0.7, and 4.2: C = 0.4.
+static constexpr u64 cubic_beta_numerator = 7;
+static constexpr u64 cubic_beta_denominator = 10;
+static constexpr i64 cubic_c_numerator = 4;
+static constexpr i64 cubic_c_denominator = 10;
+
+// Keeps (t - K)^3 in milliseconds comfortably inside an i64.
+static constexpr i64 maximum_cubic_time_offset = 100'000;
+
+static u64 integer_cube_root(u64 value)
+{
+    u64 low = 0;
+    u64 high = 1ull << 21;
+    while (low < high) {
+        u64 middle = (low + high + 1) / 2;
+        if (middle * middle * middle <= value)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+    return low;
+}
+
+void TCPCubic::did_reset_window()
+{
+    m_epoch_start.clear();
+    m_window_increment_remainder = 0;
+    m_reno_increment_remainder = 0;
+}
+
+u32 TCPCubic::slow_start_threshold_after_loss(u32)
+{
+    // RFC 9438, 4.7: With fast convergence, a flow that keeps losing below its
+    // previous maximum releases bandwidth for newer flows faster.
+    if (m_congestion_window < m_maximum_window)
+        m_maximum_window = static_cast<u64>(m_congestion_window) * (cubic_beta_denominator + cubic_beta_numerator) / (2 * cubic_beta_denominator);
+    else
+        m_maximum_window = m_congestion_window;
+
+    // RFC 9438, 4.6: "ssthresh = cwnd * beta_cubic"
+    auto reduced_window = static_cast<u64>(m_congestion_window) * cubic_beta_numerator / cubic_beta_denominator;
+    return max(static_cast<u32>(reduced_window), 2 * m_maximum_segment_size);
+}
+
+u64 TCPCubic::cubic_window_at(i64 milliseconds_since_epoch_start) const
+{
+    // RFC 9438, 4.2: "W_cubic(t) = C * (t - K)^3 + W_max", with t and K in seconds
+    // and the windows in segments.
+    auto offset = clamp(milliseconds_since_epoch_start - m_time_to_maximum_window, -maximum_cubic_time_offset, maximum_cubic_time_offset);
+    auto cubed_seconds_times_million = offset * offset * offset / 1000;
+    auto delta = cubed_seconds_times_million * cubic_c_numerator * m_maximum_segment_size / (cubic_c_denominator * 1'000'000);
+    auto window = static_cast<i64>(m_maximum_window) + delta;
+    return max(window, static_cast<i64>(m_maximum_segment_size));
+}
+
+void TCPCubic::grow_in_congestion_avoidance(u32 bytes_acknowledged, MonotonicTime now, Optional<Duration> smoothed_rtt)
+{
+    if (!m_epoch_start.has_value()) {
+        m_epoch_start = now;
+        m_reno_friendly_window = m_congestion_window;
+        if (m_congestion_window < m_maximum_window) {
+            // RFC 9438, 4.2: "K = cubic_root((W_max - cwnd_epoch) / C)"
+            u64 segments = (m_maximum_window - m_congestion_window) / m_maximum_segment_size;
+            m_time_to_maximum_window = integer_cube_root(segments * cubic_c_denominator * 1'000'000'000 / cubic_c_numerator);
+        } else {
+            m_time_to_maximum_window = 0;
+            m_maximum_window = m_congestion_window;
+        }
+    }
+
+    auto window = static_cast<u64>(m_congestion_window);
+    auto elapsed = (now - *m_epoch_start).to_milliseconds();
+
+    // RFC 9438, 4.3: In the Reno-friendly region CUBIC grows at least as fast as
+    // Reno would, by alpha_cubic = 3 * (1 - beta) / (1 + beta) segments per round trip.
+    m_reno_increment_remainder += static_cast<u64>(bytes_acknowledged) * m_maximum_segment_size * 3 * (cubic_beta_denominator - cubic_beta_numerator);
+    auto reno_divisor = window * (cubic_beta_denominator + cubic_beta_numerator);
+    m_reno_friendly_window = Checked<u32>::saturating_add(m_reno_friendly_window, min(m_reno_increment_remainder / reno_divisor, NumericLimits<u32>::max()));
+    m_reno_increment_remainder %= reno_divisor;
+
+    if (cubic_window_at(elapsed) < m_reno_friendly_window) {
+        m_congestion_window = max(m_congestion_window, m_reno_friendly_window);
+        return;
+    }
+
+    // RFC 9438, 4.4: Aim for where the cubic function will be one round trip from
+    // now, but never grow by more than half the window per round trip.
+    auto rtt = smoothed_rtt.has_value() ? smoothed_rtt->to_milliseconds() : 0;
+    auto target = clamp(cubic_window_at(elapsed + rtt), window, window * 3 / 2);
+
+    // "cwnd += (target - cwnd) / cwnd" for every SMSS acknowledged.
+    m_window_increment_remainder += (target - window) * bytes_acknowledged;
+    m_congestion_window = Checked<u32>::saturating_add(m_congestion_window, min(m_window_increment_remainder / window, NumericLimits<u32>::max()));
+    m_window_increment_remainder %= window;
+}
+
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+
+namespace Kernel {
+
+// The congestion window of a TCPSocket. The socket detects losses and runs
+// fast recovery (RFC 6582) itself; an algorithm only decides how the window
+// grows while data is acknowledged and how far it backs off after a loss.
+class TCPCongestionControl {
+public:
+    enum class Algorithm {
+        NewReno,
+        Cubic,
+    };
+
+    static constexpr Algorithm default_algorithm = Algorithm::Cubic;
+
+    static StringView to_string(Algorithm);
+    static Optional<Algorithm> algorithm_from_string(StringView);
+
+    static ErrorOr<NonnullOwnPtr<TCPCongestionControl>> try_create(Algorithm, u32 maximum_segment_size);
+    virtual ~TCPCongestionControl() = default;
+
+    virtual Algorithm algorithm() const = 0;
+
+    u32 maximum_segment_size() const { return m_maximum_segment_size; }
+    void set_maximum_segment_size(u32);
+
+    u32 congestion_window() const { return m_congestion_window; }
+    u32 slow_start_threshold() const { return m_slow_start_threshold; }
+    bool is_in_slow_start() const { return m_congestion_window < m_slow_start_threshold; }
+
+    // Takes over the window of a socket that switches algorithms mid-connection.
+    void inherit_window_from(TCPCongestionControl const&);
+
+    // New data was acknowledged while not recovering from a fast retransmit.
+    void on_ack(u32 bytes_acknowledged, MonotonicTime now, Optional<Duration> smoothed_rtt);
+
+    // RFC 6582 fast retransmit and fast recovery.
+    void on_fast_retransmit(u32 bytes_in_flight, bool inflate_window);
+    void on_duplicate_ack_during_recovery();
+    void on_partial_ack(u32 bytes_acknowledged);
+    void on_recovery_complete();
+
+    // RFC 5681, 3.1: "the congestion window MUST be set to no more than the loss window".
+    void on_retransmit_timeout(u32 bytes_in_flight);
+
+protected:
+    explicit TCPCongestionControl(u32 maximum_segment_size);
+
+    virtual void grow_in_congestion_avoidance(u32 bytes_acknowledged, MonotonicTime now, Optional<Duration> smoothed_rtt) = 0;
+    virtual u32 slow_start_threshold_after_loss(u32 bytes_in_flight) = 0;
+    virtual void did_reset_window() { }
+
+    u32 m_maximum_segment_size { 0 };
+    u32 m_congestion_window { 0 };
+    u32 m_slow_start_threshold { NumericLimits<u32>::max() };
+
+private:
+    bool m_has_seen_ack { false };
+};
+
+// RFC 5681 congestion avoidance with Appropriate Byte Counting (RFC 3465).
+class TCPNewReno final : public TCPCongestionControl {
+public:
+    explicit TCPNewReno(u32 maximum_segment_size)
+        : TCPCongestionControl(maximum_segment_size)
+    {
+    }
+
+    virtual Algorithm algorithm() const override { return Algorithm::NewReno; }
+
+private:
+    virtual void grow_in_congestion_avoidance(u32 bytes_acknowledged, MonotonicTime, Optional<Duration>) override;
+    virtual u32 slow_start_threshold_after_loss(u32 bytes_in_flight) override;
+    virtual void did_reset_window() override { m_bytes_acknowledged = 0; }
+
+    u32 m_bytes_acknowledged { 0 };
+};
+
+// RFC 9438 CUBIC, in fixed point since the kernel can't use the FPU.
+class TCPCubic final : public TCPCongestionControl {
+public:
+    explicit TCPCubic(u32 maximum_segment_size)
+        : TCPCongestionControl(maximum_segment_size)
+    {
+    }
+
+    virtual Algorithm algorithm() const override { return Algorithm::Cubic; }
+
+private:
+    virtual void grow_in_congestion_avoidance(u32 bytes_acknowledged, MonotonicTime, Optional<Duration> smoothed_rtt) override;
+    virtual u32 slow_start_threshold_after_loss(u32 bytes_in_flight) override;
+    virtual void did_reset_window() override;
+
+    u64 cubic_window_at(i64 milliseconds_since_epoch_start) const;
+
+    // Window size (in bytes) just before the last reduction.
+    u32 m_maximum_window { 0 };
+    Optional<MonotonicTime> m_epoch_start;
+    // Milliseconds until the cubic function reaches m_maximum_window again.
+    i64 m_time_to_maximum_window { 0 };
+    // The window a Reno flow would have had in the same situation.
+    u32 m_reno_friendly_window { 0 };
+    u64 m_window_increment_remainder { 0 };
+    u64 m_reno_increment_remainder { 0 };
+};
+
+}
@@ -23,6 +23,17 @@
 
 namespace Kernel {
 
+// RFC 9293, 3.4: Sequence numbers wrap around, so compare them modulo 2^32.
+static bool sequence_number_before(u32 a, u32 b)
+{
+    return static_cast<i32>(a - b) < 0;
+}
+
+static bool sequence_number_after(u32 a, u32 b)
+{
+    return sequence_number_before(b, a);
+}
+
 void TCPSocket::for_each(Function<void(TCPSocket const&)> callback)
 {
     sockets_by_tuple().for_each_shared([&](auto const& it) {
@@ -160,6 +171,7 @@ ErrorOr<NonnullRefPtr<TCPSocket>> TCPSocket::try_create_client(IPv4Address const
         client->set_bound();
         client->set_direction(Direction::Incoming);
         client->set_originator(*this);
+        TRY(client->set_congestion_control_algorithm(congestion_state().algorithm));
 
         m_pending_release_for_accept.set(tuple, client);
         client->m_registered_socket_tuple = tuple;
@@ -184,10 +196,11 @@ void TCPSocket::release_for_accept(NonnullRefPtr<TCPSocket> socket)
     [[maybe_unused]] auto rc = queue_connection_from(move(socket));
 }
 
-TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullRefPtr<Timer> timer)
+TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullRefPtr<Timer> timer, NonnullOwnPtr<TCPCongestionControl> congestion_control)
     : IPv4Socket(SOCK_STREAM, protocol, move(receive_buffer), move(scratch_buffer))
+    , m_congestion_control(move(congestion_control))
     , m_last_ack_sent_time(TimeManagement::the().monotonic_time())
-    , m_last_retransmit_time(TimeManagement::the().monotonic_time())
+    , m_retransmit_timer_start(TimeManagement::the().monotonic_time())
     , m_timer(timer)
 {
 }
@@ -204,7 +217,41 @@ ErrorOr<NonnullRefPtr<TCPSocket>> TCPSocket::try_create(int protocol, NonnullOwn
     // Note: Scratch buffer is only used for SOCK_STREAM sockets.
     auto scratch_buffer = TRY(KBuffer::try_create_with_size("TCPSocket: Scratch buffer"sv, 65536));
     auto timer = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) Timer));
-    return adopt_nonnull_ref_or_enomem(new (nothrow) TCPSocket(protocol, move(receive_buffer), move(scratch_buffer), timer));
+    auto congestion_control = TRY(TCPCongestionControl::try_create(TCPCongestionControl::default_algorithm, default_maximum_segment_size));
+    return adopt_nonnull_ref_or_enomem(new (nothrow) TCPSocket(protocol, move(receive_buffer), move(scratch_buffer), timer, move(congestion_control)));
+}
+
+ErrorOr<void> TCPSocket::set_congestion_control_algorithm(TCPCongestionControl::Algorithm algorithm)
+{
+    auto state = congestion_state();
+    if (state.algorithm == algorithm)
+        return {};
+
+    auto congestion_control = TRY(TCPCongestionControl::try_create(algorithm, state.maximum_segment_size));
+    m_congestion_control.with([&](auto& current_congestion_control) {
+        congestion_control->inherit_window_from(*current_congestion_control);
+        swap(current_congestion_control, congestion_control);
+    });
+    return {};
+}
+
+TCPSocket::CongestionState TCPSocket::congestion_state() const
+{
+    return m_congestion_control.with([](auto const& congestion_control) {
+        return CongestionState {
+            .algorithm = congestion_control->algorithm(),
+            .maximum_segment_size = congestion_control->maximum_segment_size(),
+            .congestion_window = congestion_control->congestion_window(),
+            .slow_start_threshold = congestion_control->slow_start_threshold(),
+        };
+    });
+}
+
+size_t TCPSocket::maximum_segment_size(RoutingDecision const& routing_decision) const
+{
+    size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
+    // RFC 9293, 3.7.1: Without an MSS option from the peer we must assume 536 bytes.
+    return min(mss, m_peer_maximum_segment_size.value_or(default_maximum_segment_size));
 }
 
 ErrorOr<size_t> TCPSocket::protocol_size(ReadonlyBytes raw_ipv4_packet)
@@ -231,7 +278,10 @@ ErrorOr<size_t> TCPSocket::protocol_send(UserOrKernelBuffer const& data, size_t
     RoutingDecision routing_decision = route_to(peer_address(), local_address(), adapter);
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
-    size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
+    size_t mss = maximum_segment_size(routing_decision);
+    m_congestion_control.with([mss](auto& congestion_control) {
+        congestion_control->set_maximum_segment_size(mss);
+    });
 
     if (!m_no_delay) {
         // RFC 896 (Nagle’s algorithm): https://www.ietf.org/rfc/rfc0896
@@ -245,7 +295,12 @@ ErrorOr<size_t> TCPSocket::protocol_send(UserOrKernelBuffer const& data, size_t
             return set_so_error(EAGAIN);
     }
 
-    data_length = min(data_length, mss);
+    // RFC 5681, 3.1: Never have more than min(cwnd, rwnd) outstanding.
+    auto sendable = m_unacked_packets.with_shared([&](auto const& packets) { return sendable_bytes(packets); });
+    if (sendable == 0)
+        return set_so_error(EAGAIN);
+
+    data_length = min(min(data_length, mss), sendable);
     TRY(send_tcp_packet(TCPFlags::PSH | TCPFlags::ACK, &data, data_length, &routing_decision));
     return data_length;
 }
@@ -268,7 +323,8 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
 
     bool const has_mss_option = flags & TCPFlags::SYN;
     bool const has_window_scale_option = flags & TCPFlags::SYN;
-    size_t const options_size = (has_mss_option ? sizeof(TCPOptionMSS) : 0) + (has_window_scale_option ? sizeof(TCPOptionWindowScale) : 0);
+    bool const has_sack_permitted_option = flags & TCPFlags::SYN;
+    size_t const options_size = (has_mss_option ? sizeof(TCPOptionMSS) : 0) + (has_window_scale_option ? sizeof(TCPOptionWindowScale) : 0) + (has_sack_permitted_option ? sizeof(TCPOptionSACKPermitted) : 0);
     size_t const tcp_header_size = sizeof(TCPPacket) + align_up_to(options_size, 4);
     size_t const buffer_size = ipv4_payload_offset + tcp_header_size + payload_size;
     auto packet = routing_decision.adapter->acquire_packet_buffer(buffer_size);
@@ -303,6 +359,7 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
         tcp_packet.set_ack_number(m_ack_number);
     }
 
+    auto sequence_number = m_sequence_number;
     if (flags & TCPFlags::SYN) {
         ++m_sequence_number;
     } else {
@@ -321,6 +378,11 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
         memcpy(next_option, &window_scale_option, sizeof(window_scale_option));
         next_option += sizeof(window_scale_option);
     }
+    if (has_sack_permitted_option) {
+        TCPOptionSACKPermitted sack_permitted_option;
+        memcpy(next_option, &sack_permitted_option, sizeof(sack_permitted_option));
+        next_option += sizeof(sack_permitted_option);
+    }
     if ((options_size % 4) != 0)
         *next_option = to_underlying(TCPOptionKind::End);
 
@@ -329,8 +391,12 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
     bool expect_ack { tcp_packet.has_syn() || payload_size > 0 };
     if (expect_ack) {
         bool append_failed { false };
+        auto now = TimeManagement::the().monotonic_time(TimePrecision::Precise);
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter });
+            // RFC 6298, 5.1: Start the retransmission timer if it isn't running already.
+            if (unacked_packets.packets.is_empty())
+                m_retransmit_timer_start = now;
+            auto result = unacked_packets.packets.try_append({ sequence_number, m_sequence_number, payload_size, packet, ipv4_payload_offset, *routing_decision.adapter, now });
             if (result.is_error()) {
                 dbgln("TCPSocket: Dropped outbound packet because try_append() failed");
                 append_failed = true;
@@ -356,30 +422,108 @@ void TCPSocket::receive_tcp_packet(TCPPacket const& packet, u16 size)
 {
     if (packet.has_ack()) {
         u32 ack_number = packet.ack_number();
+        size_t payload_size = size - packet.header_size();
+        auto now = TimeManagement::the().monotonic_time(TimePrecision::Precise);
 
         dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet: {}", ack_number);
 
-        int removed = 0;
+        // RFC 7323, 2.2: "The window field in a segment where the SYN bit is set
+        // (i.e., a <SYN> or <SYN,ACK>) MUST NOT be scaled."
+        u32 send_window_size = packet.window_size();
+        if (!packet.has_syn())
+            send_window_size <<= m_send_window_scale;
+        bool window_changed = send_window_size != m_send_window_size;
+        m_send_window_size = send_window_size;
+
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+            if (m_sack_permitted)
+                process_sack_option(packet, unacked_packets);
+
+            bool is_duplicate_ack = !unacked_packets.packets.is_empty()
+                && unacked_packets.packets.first().sequence_number == ack_number
+                && payload_size == 0 && !packet.has_syn() && !packet.has_fin() && !window_changed;
+
+            int removed = 0;
+            size_t bytes_acknowledged = 0;
+            Optional<MonotonicTime> rtt_sample_sent_time;
             while (!unacked_packets.packets.is_empty()) {
-                auto& packet = unacked_packets.packets.first();
+                auto& outgoing_packet = unacked_packets.packets.first();
 
-                dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", packet.ack_number);
+                dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", outgoing_packet.ack_number);
 
-                if (packet.ack_number <= ack_number) {
-                    auto old_adapter = packet.adapter.strong_ref();
-                    if (old_adapter)
-                        old_adapter->release_packet_buffer(*packet.buffer);
-                    TCPPacket& tcp_packet = *(TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                    if (m_send_window_size != tcp_packet.window_size()) {
-                        m_send_window_size = tcp_packet.window_size() << m_send_window_scale;
+                if (sequence_number_after(outgoing_packet.ack_number, ack_number))
+                    break;
+
+                auto old_adapter = outgoing_packet.adapter.strong_ref();
+                if (old_adapter)
+                    old_adapter->release_packet_buffer(*outgoing_packet.buffer);
+                // RFC 6298, 3: Karn's algorithm. An ACK for a retransmitted segment is
+                // ambiguous, so only segments that were sent once can be timed.
+                if (outgoing_packet.tx_counter == 0)
+                    rtt_sample_sent_time = outgoing_packet.sent_time;
+                bytes_acknowledged += outgoing_packet.payload_size;
+                unacked_packets.size -= outgoing_packet.payload_size;
+                unacked_packets.packets.take_first();
+                removed++;
+            }
+
+            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
+
+            if (removed > 0) {
+                if (rtt_sample_sent_time.has_value())
+                    update_rtt_estimate(now - *rtt_sample_sent_time);
+
+                // RFC 6298, 5.3: Restart the timer whenever new data is acknowledged.
+                m_retransmit_timer_start = now;
+                m_retransmit_attempts = 0;
+                m_duplicate_acks_received = 0;
+
+                bool has_recovered = !sequence_number_before(ack_number, m_recovery_point);
+                switch (m_recovery_state) {
+                case RecoveryState::None:
+                    m_congestion_control.with([&](auto& congestion_control) {
+                        congestion_control->on_ack(bytes_acknowledged, now, m_smoothed_rtt);
+                    });
+                    break;
+                case RecoveryState::FastRecovery:
+                    if (has_recovered) {
+                        m_congestion_control.with([](auto& congestion_control) { congestion_control->on_recovery_complete(); });
+                        m_recovery_state = RecoveryState::None;
+                        break;
                     }
-                    auto payload_size = packet.buffer->buffer->data() + packet.buffer->buffer->size() - (u8*)tcp_packet.payload();
-                    unacked_packets.size -= payload_size;
-                    evaluate_block_conditions();
-                    unacked_packets.packets.take_first();
-                    removed++;
-                } else {
+                    // RFC 6582, 3.2 step 5: A partial ACK means that the segment after
+                    // the one we retransmitted was lost as well.
+                    if (!m_sack_permitted)
+                        m_congestion_control.with([&](auto& congestion_control) { congestion_control->on_partial_ack(bytes_acknowledged); });
+                    if (!unacked_packets.packets.is_empty())
+                        unacked_packets.packets.first().is_lost = true;
+                    mark_lost_packets(unacked_packets);
+                    retransmit_lost_packets(unacked_packets, true);
+                    break;
+                case RecoveryState::RetransmitTimeout:
+                    // Slow start back up, resending the rest of the lost data as the window allows.
+                    m_congestion_control.with([&](auto& congestion_control) {
+                        congestion_control->on_ack(bytes_acknowledged, now, m_smoothed_rtt);
+                    });
+                    if (has_recovered)
+                        m_recovery_state = RecoveryState::None;
+                    break;
+                }
+            } else if (is_duplicate_ack) {
+                ++m_duplicate_acks_received;
+                switch (m_recovery_state) {
+                case RecoveryState::None:
+                    if (m_duplicate_acks_received == duplicate_ack_threshold)
+                        enter_fast_recovery(unacked_packets);
+                    break;
+                case RecoveryState::FastRecovery:
+                    if (m_sack_permitted)
+                        mark_lost_packets(unacked_packets);
+                    else
+                        m_congestion_control.with([](auto& congestion_control) { congestion_control->on_duplicate_ack_during_recovery(); });
+                    break;
+                case RecoveryState::RetransmitTimeout:
+                    // RFC 6582, 4: Don't start another recovery for data sent before the timeout.
                     break;
                 }
             }
@@ -387,9 +531,13 @@ void TCPSocket::receive_tcp_packet(TCPPacket const& packet, u16 size)
             if (unacked_packets.packets.is_empty()) {
                 m_retransmit_attempts = 0;
                 dequeue_for_retransmit();
+            } else {
+                retransmit_lost_packets(unacked_packets, false);
             }
 
-            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
+            // Any of these may have opened up the window for blocked writers.
+            if (removed > 0 || is_duplicate_ack || window_changed)
+                evaluate_block_conditions();
         });
     }
 
@@ -397,6 +545,140 @@ void TCPSocket::receive_tcp_packet(TCPPacket const& packet, u16 size)
     m_bytes_in += packet.header_size() + size;
 }
 
+void TCPSocket::update_rtt_estimate(Duration sample)
+{
+    // RFC 6298, 2: "G" is the granularity of the clock the retransmission timer runs on.
+    constexpr i64 clock_granularity = 10'000;
+
+    auto measured_rtt = sample.to_microseconds();
+    i64 smoothed_rtt = 0;
+    i64 rtt_variance = 0;
+    if (!m_smoothed_rtt.has_value()) {
+        // RFC 6298, 2.2: "SRTT <- R, RTTVAR <- R/2"
+        smoothed_rtt = measured_rtt;
+        rtt_variance = measured_rtt / 2;
+    } else {
+        // RFC 6298, 2.3: "RTTVAR <- (1 - beta) * RTTVAR + beta * |SRTT - R'|" and
+        // "SRTT <- (1 - alpha) * SRTT + alpha * R'", with alpha = 1/8 and beta = 1/4.
+        smoothed_rtt = m_smoothed_rtt->to_microseconds();
+        auto deviation = smoothed_rtt > measured_rtt ? smoothed_rtt - measured_rtt : measured_rtt - smoothed_rtt;
+        rtt_variance = (3 * m_rtt_variance.to_microseconds() + deviation) / 4;
+        smoothed_rtt = (7 * smoothed_rtt + measured_rtt) / 8;
+    }
+    m_smoothed_rtt = Duration::from_microseconds(smoothed_rtt);
+    m_rtt_variance = Duration::from_microseconds(rtt_variance);
+
+    // RFC 6298, 2.3: "RTO <- SRTT + max (G, K*RTTVAR)" where K = 4, rounded up to
+    // a second (2.4) and capped at sixty seconds (2.5).
+    auto retransmission_timeout = Duration::from_microseconds(smoothed_rtt + max(clock_granularity, 4 * rtt_variance));
+    m_retransmission_timeout = clamp(retransmission_timeout, minimum_retransmission_timeout, maximum_retransmission_timeout);
+}
+
+size_t TCPSocket::bytes_in_flight(UnackedPackets const& unacked_packets)
+{
+    size_t bytes = 0;
+    for (auto const& packet : unacked_packets.packets) {
+        if (!packet.is_sacked && !packet.is_lost)
+            bytes += packet.payload_size;
+    }
+    return bytes;
+}
+
+size_t TCPSocket::sendable_bytes(UnackedPackets const& unacked_packets) const
+{
+    auto congestion_window = m_congestion_control.with([](auto const& congestion_control) { return congestion_control->congestion_window(); });
+    auto in_flight = bytes_in_flight(unacked_packets);
+    if (in_flight >= congestion_window || unacked_packets.size >= m_send_window_size)
+        return 0;
+    return min(congestion_window - in_flight, m_send_window_size - unacked_packets.size);
+}
+
+void TCPSocket::process_sack_option(TCPPacket const& packet, UnackedPackets& unacked_packets)
+{
+    packet.for_each_option([&](auto const& option) {
+        if (option.kind() != TCPOptionKind::SACK)
+            return;
+        auto const& sack_option = static_cast<TCPOptionSACK const&>(option);
+        if (!sack_option.is_valid())
+            return;
+        for (size_t i = 0; i < sack_option.block_count(); ++i) {
+            u32 left_edge = sack_option.block(i).left_edge;
+            u32 right_edge = sack_option.block(i).right_edge;
+            for (auto& outgoing_packet : unacked_packets.packets) {
+                if (sequence_number_before(outgoing_packet.sequence_number, left_edge))
+                    continue;
+                if (sequence_number_after(outgoing_packet.ack_number, right_edge))
+                    break;
+                outgoing_packet.is_sacked = true;
+                outgoing_packet.is_lost = false;
+            }
+        }
+    });
+}
+
+void TCPSocket::mark_lost_packets(UnackedPackets& unacked_packets)
+{
+    if (!m_sack_permitted)
+        return;
+
+    // RFC 6675, 4: A segment is lost once at least DupThresh segments above it have
+    // been SACKed. Segments we already resent during this recovery are left alone.
+    size_t sacked_packets_above = 0;
+    for (auto const& packet : unacked_packets.packets) {
+        if (packet.is_sacked)
+            ++sacked_packets_above;
+    }
+    for (auto& packet : unacked_packets.packets) {
+        if (packet.is_sacked) {
+            --sacked_packets_above;
+            continue;
+        }
+        if (sacked_packets_above < duplicate_ack_threshold)
+            break;
+        if (packet.retransmitted_in_recovery != m_recovery_episode)
+            packet.is_lost = true;
+    }
+}
+
+void TCPSocket::enter_fast_recovery(UnackedPackets& unacked_packets)
+{
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) entering fast recovery", this);
+
+    // RFC 6582, 3.2 step 2: "record the highest sequence number transmitted in the variable recover".
+    m_recovery_point = m_sequence_number;
+    m_recovery_state = RecoveryState::FastRecovery;
+    ++m_recovery_episode;
+    ++m_fast_retransmits;
+
+    m_congestion_control.with([&](auto& congestion_control) {
+        congestion_control->on_fast_retransmit(unacked_packets.size, !m_sack_permitted);
+    });
+
+    unacked_packets.packets.first().is_lost = true;
+    mark_lost_packets(unacked_packets);
+    retransmit_lost_packets(unacked_packets, true);
+}
+
+void TCPSocket::retransmit_lost_packets(UnackedPackets& unacked_packets, bool must_send_first)
+{
+    auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
+    auto routing_decision = route_to(peer_address(), local_address(), adapter);
+    if (routing_decision.is_zero())
+        return;
+
+    auto congestion_window = m_congestion_control.with([](auto const& congestion_control) { return congestion_control->congestion_window(); });
+    auto in_flight = bytes_in_flight(unacked_packets);
+    for (auto& packet : unacked_packets.packets) {
+        if (!packet.is_lost)
+            continue;
+        if (in_flight >= congestion_window && !must_send_first)
+            break;
+        must_send_first = false;
+        retransmit_packet(packet, routing_decision);
+        in_flight += packet.payload_size;
+    }
+}
+
 bool TCPSocket::should_delay_next_ack() const
 {
     // FIXME: We don't know the MSS here so make a reasonable guess.
@@ -479,6 +761,15 @@ ErrorOr<void> TCPSocket::setsockopt(int level, int option, Userspace<void const*
             return EINVAL;
         m_no_delay = value;
         return {};
+    case TCP_CONGESTION: {
+        if (user_value_size > TCP_CA_NAME_MAX)
+            return EINVAL;
+        auto name = TRY(Process::get_syscall_name_string_fixed_buffer<TCP_CA_NAME_MAX>(static_ptr_cast<char const*>(user_value), user_value_size));
+        auto algorithm = TCPCongestionControl::algorithm_from_string(name.representable_view());
+        if (!algorithm.has_value())
+            return ENOENT;
+        return set_congestion_control_algorithm(*algorithm);
+    }
     default:
         dbgln("setsockopt({}) at IPPROTO_TCP not implemented.", option);
         return ENOPROTOOPT;
@@ -504,6 +795,16 @@ ErrorOr<void> TCPSocket::getsockopt(OpenFileDescription& description, int level,
         size = sizeof(nodelay);
         return copy_to_user(value_size, &size);
     }
+    case TCP_CONGESTION: {
+        // NOTE: The algorithm names are string literals, so they are null-terminated.
+        auto name = TCPCongestionControl::to_string(congestion_state().algorithm);
+        auto length = name.length() + 1;
+        if (size < length)
+            return EINVAL;
+        TRY(copy_to_user(static_ptr_cast<char*>(value), name.characters_without_null_termination(), length));
+        size = length;
+        return copy_to_user(value_size, &size);
+    }
     default:
         dbgln("getsockopt({}) at IPPROTO_TCP not implemented.", option);
         return ENOPROTOOPT;
@@ -700,20 +1001,14 @@ void TCPSocket::dequeue_for_retransmit()
 
 void TCPSocket::retransmit_packets()
 {
-    auto now = TimeManagement::the().monotonic_time();
-
-    // RFC6298 says we should have at least one second between retransmits. According to
-    // RFC1122 we must do exponential backoff - even for SYN packets.
-    i64 retransmit_interval = 1;
-    for (decltype(m_retransmit_attempts) i = 0; i < m_retransmit_attempts; i++)
-        retransmit_interval *= 2;
+    auto now = TimeManagement::the().monotonic_time(TimePrecision::Precise);
 
-    if (m_last_retransmit_time > now - Duration::from_seconds(retransmit_interval))
+    if (now < m_retransmit_timer_start + m_retransmission_timeout)
         return;
 
     dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) handling retransmit", this);
 
-    m_last_retransmit_time = now;
+    m_retransmit_timer_start = now;
     ++m_retransmit_attempts;
 
     if (m_retransmit_attempts > maximum_retransmits) {
@@ -723,49 +1018,76 @@ void TCPSocket::retransmit_packets()
         return;
     }
 
-    auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
-    auto routing_decision = route_to(peer_address(), local_address(), adapter);
-    if (routing_decision.is_zero())
-        return;
+    ++m_retransmit_timeouts;
 
-    m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-        for (auto& packet : unacked_packets.packets) {
-            packet.tx_counter++;
-
-            if constexpr (TCP_SOCKET_DEBUG) {
-                auto& tcp_packet = *(TCPPacket const*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
-                    local_address(), local_port(),
-                    peer_address(), peer_port(),
-                    (tcp_packet.has_syn() ? "SYN " : ""),
-                    (tcp_packet.has_ack() ? "ACK " : ""),
-                    (tcp_packet.has_fin() ? "FIN " : ""),
-                    (tcp_packet.has_rst() ? "RST " : ""),
-                    tcp_packet.sequence_number(),
-                    tcp_packet.ack_number(),
-                    packet.tx_counter);
-            }
+    // RFC 6298, 5.5: "The host MUST set RTO <- RTO * 2 ("back off the timer")". According
+    // to RFC1122 this applies to SYN packets as well.
+    m_retransmission_timeout = min(m_retransmission_timeout + m_retransmission_timeout, maximum_retransmission_timeout);
 
-            size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
-            if (ipv4_payload_offset != packet.ipv4_payload_offset) {
-                // FIXME: Add support for this. This can happen if after a route change
-                // we ended up on another adapter which doesn't have the same layer 2 type
-                // like the previous adapter.
-                VERIFY_NOT_REACHED();
-            }
+    m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+        if (unacked_packets.packets.is_empty())
+            return;
 
-            auto packet_buffer = packet.buffer->bytes();
+        m_congestion_control.with([&](auto& congestion_control) {
+            congestion_control->on_retransmit_timeout(unacked_packets.size);
+        });
 
-            routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
-                local_address(), routing_decision.next_hop, peer_address(),
-                IPv4Protocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
-            routing_decision.adapter->send_packet(packet_buffer);
-            m_packets_out++;
-            m_bytes_out += packet_buffer.size();
+        // RFC 6582, 4: Everything sent so far is presumed lost, and RFC 2018, 8 says the
+        // peer may have discarded data it SACKed, so that can't be trusted anymore either.
+        // With the window down to one segment, only the oldest one goes out right away
+        // (RFC 6298, 5.4); ACKs for it clock out the rest.
+        m_recovery_point = m_sequence_number;
+        m_recovery_state = RecoveryState::RetransmitTimeout;
+        ++m_recovery_episode;
+        m_duplicate_acks_received = 0;
+        for (auto& packet : unacked_packets.packets) {
+            packet.is_sacked = false;
+            packet.is_lost = true;
         }
+
+        retransmit_lost_packets(unacked_packets, true);
     });
 }
 
+void TCPSocket::retransmit_packet(OutgoingPacket& packet, RoutingDecision const& routing_decision)
+{
+    packet.tx_counter++;
+    packet.is_lost = false;
+    packet.retransmitted_in_recovery = m_recovery_episode;
+
+    if constexpr (TCP_SOCKET_DEBUG) {
+        auto& tcp_packet = *(TCPPacket const*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
+        dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
+            local_address(), local_port(),
+            peer_address(), peer_port(),
+            (tcp_packet.has_syn() ? "SYN " : ""),
+            (tcp_packet.has_ack() ? "ACK " : ""),
+            (tcp_packet.has_fin() ? "FIN " : ""),
+            (tcp_packet.has_rst() ? "RST " : ""),
+            tcp_packet.sequence_number(),
+            tcp_packet.ack_number(),
+            packet.tx_counter);
+    }
+
+    size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
+    if (ipv4_payload_offset != packet.ipv4_payload_offset) {
+        // FIXME: Add support for this. This can happen if after a route change
+        // we ended up on another adapter which doesn't have the same layer 2 type
+        // like the previous adapter.
+        VERIFY_NOT_REACHED();
+    }
+
+    auto packet_buffer = packet.buffer->bytes();
+
+    routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
+        local_address(), routing_decision.next_hop, peer_address(),
+        IPv4Protocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
+    routing_decision.adapter->send_packet(packet_buffer);
+    m_packets_out++;
+    m_bytes_out += packet_buffer.size();
+    m_retransmitted_packets++;
+}
+
 bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size) const
 {
     if (!IPv4Socket::can_write(file_description, size))
@@ -778,7 +1100,7 @@ bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size)
         return true;
 
     return m_unacked_packets.with_shared([&](auto& unacked_packets) {
-        return unacked_packets.size + size <= m_send_window_size;
+        return sendable_bytes(unacked_packets) > 0;
     });
 }
 }
@@ -15,6 +15,7 @@
 #include <Kernel/Library/LockWeakPtr.h>
 #include <Kernel/Locking/MutexProtected.h>
 #include <Kernel/Net/IPv4/Socket.h>
+#include <Kernel/Net/TCPCongestionControl.h>
 #include <Kernel/Time/TimerQueue.h>
 
 namespace Kernel {
@@ -137,12 +138,32 @@ public:
     u32 packets_out() const { return m_packets_out; }
     u32 bytes_out() const { return m_bytes_out; }
 
+    struct CongestionState {
+        TCPCongestionControl::Algorithm algorithm;
+        u32 maximum_segment_size { 0 };
+        u32 congestion_window { 0 };
+        u32 slow_start_threshold { 0 };
+    };
+    CongestionState congestion_state() const;
+
+    Optional<Duration> smoothed_rtt() const { return m_smoothed_rtt; }
+    Duration rtt_variance() const { return m_rtt_variance; }
+    Duration retransmission_timeout() const { return m_retransmission_timeout; }
+    u32 retransmitted_packets() const { return m_retransmitted_packets; }
+    u32 fast_retransmits() const { return m_fast_retransmits; }
+    u32 retransmit_timeouts() const { return m_retransmit_timeouts; }
+    bool is_sack_permitted() const { return m_sack_permitted; }
+
     void set_send_window_scale(size_t scale)
     {
         m_window_scaling_supported = true;
         m_send_window_scale = scale;
     }
 
+    void set_peer_maximum_segment_size(u16 size) { m_peer_maximum_segment_size = size; }
+    void set_sack_permitted() { m_sack_permitted = true; }
+    ErrorOr<void> set_congestion_control_algorithm(TCPCongestionControl::Algorithm);
+
     // FIXME: Make this configurable?
     static constexpr u32 maximum_duplicate_acks = 5;
     void set_duplicate_acks(u32 acks) { m_duplicate_acks = acks; }
@@ -180,7 +201,7 @@ protected:
     void set_direction(Direction direction) { m_direction = direction; }
 
 private:
-    explicit TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullRefPtr<Timer> timer);
+    explicit TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullRefPtr<Timer> timer, NonnullOwnPtr<TCPCongestionControl>);
     virtual StringView class_name() const override { return "TCPSocket"sv; }
 
     virtual void shut_down_for_writing() override;
@@ -198,6 +219,9 @@ private:
     void enqueue_for_retransmit();
     void dequeue_for_retransmit();
 
+    size_t maximum_segment_size(RoutingDecision const&) const;
+    void update_rtt_estimate(Duration sample);
+
     static constexpr size_t receive_window_scale()
     {
         auto buffer_size_bit_length = AK::log2(receive_buffer_size) + 1;
@@ -220,11 +244,19 @@ private:
     u32 m_bytes_out { 0 };
 
     struct OutgoingPacket {
+        u32 sequence_number { 0 };
         u32 ack_number { 0 };
+        size_t payload_size { 0 };
         RefPtr<PacketWithTimestamp> buffer;
         size_t ipv4_payload_offset;
         LockWeakPtr<NetworkAdapter> adapter;
+        MonotonicTime sent_time;
         int tx_counter { 0 };
+        // The peer told us it holds this segment (RFC 2018).
+        bool is_sacked { false };
+        // Considered lost and waiting to be retransmitted.
+        bool is_lost { false };
+        u32 retransmitted_in_recovery { 0 };
     };
 
     struct UnackedPackets {
@@ -232,10 +264,53 @@ private:
         size_t size { 0 };
     };
 
+    // RFC 6675 "pipe": the unacknowledged bytes we believe are still in the network.
+    static size_t bytes_in_flight(UnackedPackets const&);
+    size_t sendable_bytes(UnackedPackets const&) const;
+
+    void process_sack_option(TCPPacket const&, UnackedPackets&);
+    void mark_lost_packets(UnackedPackets&);
+    void enter_fast_recovery(UnackedPackets&);
+    void retransmit_lost_packets(UnackedPackets&, bool must_send_first);
+    void retransmit_packet(OutgoingPacket&, RoutingDecision const&);
+
     MutexProtected<UnackedPackets> m_unacked_packets;
 
     u32 m_duplicate_acks { 0 };
 
+    enum class RecoveryState {
+        None,
+        FastRecovery,
+        RetransmitTimeout,
+    };
+
+    // RFC 5681, 3.2: "The fast retransmit algorithm uses the arrival of 3 duplicate ACKs".
+    static constexpr u32 duplicate_ack_threshold = 3;
+    u32 m_duplicate_acks_received { 0 };
+    RecoveryState m_recovery_state { RecoveryState::None };
+    // RFC 6582 "recover": the highest sequence number sent when the loss was detected.
+    u32 m_recovery_point { 0 };
+    // Bumped for every loss, so segments resent during the current recovery aren't sent yet again.
+    u32 m_recovery_episode { 0 };
+    bool m_sack_permitted { false };
+
+    // RFC 9293, 3.7.1: The send MSS to assume when the peer didn't announce one.
+    static constexpr u16 default_maximum_segment_size = 536;
+    SpinlockProtected<NonnullOwnPtr<TCPCongestionControl>, LockRank::None> m_congestion_control;
+    Optional<u16> m_peer_maximum_segment_size;
+
+    // RFC 6298 round-trip time estimation.
+    static constexpr Duration initial_retransmission_timeout = Duration::from_seconds(1);
+    static constexpr Duration minimum_retransmission_timeout = Duration::from_seconds(1);
+    static constexpr Duration maximum_retransmission_timeout = Duration::from_seconds(60);
+    Optional<Duration> m_smoothed_rtt;
+    Duration m_rtt_variance;
+    Duration m_retransmission_timeout { initial_retransmission_timeout };
+
+    u32 m_retransmitted_packets { 0 };
+    u32 m_fast_retransmits { 0 };
+    u32 m_retransmit_timeouts { 0 };
+
     u32 m_last_ack_number_sent { 0 };
     MonotonicTime m_last_ack_sent_time;
 
@@ -243,7 +318,7 @@ private:
 
     // FIXME: Make this configurable (sysctl)
     static constexpr u32 maximum_retransmits = 5;
-    MonotonicTime m_last_retransmit_time;
+    MonotonicTime m_retransmit_timer_start;
     u32 m_retransmit_attempts { 0 };
 
     // Default to maximum window size. receive_tcp_packet() will update from the
@@ -4,8 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
+#include <Kernel/Arch/Delay.h>
 #include <Kernel/Bus/PCI/IDs.h>
 #include <Kernel/Bus/VirtIO/Transport/PCIe/TransportLink.h>
+#include <Kernel/Net/FlowHash.h>
+#include <Kernel/Net/NetworkTask.h>
 #include <Kernel/Net/NetworkingManagement.h>
 #include <Kernel/Net/VirtIO/VirtIONetworkAdapter.h>
 
@@ -69,6 +73,19 @@ struct [[gnu::packed]] VirtIONetConfig {
     LittleEndian<u32> supported_hash_types;
 };
 
+static constexpr u8 VIRTIO_NET_CTRL_MQ = 4;
+static constexpr u8 VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET = 0;
+static constexpr u16 VIRTIO_NET_CTRL_MQ_VQ_PAIRS_MIN = 1;
+static constexpr u16 VIRTIO_NET_CTRL_MQ_VQ_PAIRS_MAX = 0x8000;
+
+static constexpr u8 VIRTIO_NET_OK = 0;
+
+struct [[gnu::packed]] VirtIONetCtrlMQ {
+    u8 command_class;
+    u8 command;
+    LittleEndian<u16> virtqueue_pairs;
+};
+
 struct [[gnu::packed]] VirtIONetHdr {
     u8 flags;
     u8 gso_type;
@@ -84,12 +101,12 @@ struct [[gnu::packed]] VirtIONetHdr {
 
 using namespace VirtIO;
 
-static constexpr u16 RECEIVEQ = 0;
-static constexpr u16 TRANSMITQ = 1;
-
 static constexpr size_t MAX_RX_FRAME_SIZE = 1514; // Non-jumbo Ethernet frame limit.
-static constexpr size_t RX_BUFFER_SIZE = sizeof(VirtIONetHdr) * MAX_RX_FRAME_SIZE;
+static constexpr size_t RX_BUFFER_SIZE = sizeof(VirtIONetHdr) + MAX_RX_FRAME_SIZE;
 static constexpr u16 MAX_INFLIGHT_PACKETS = 128;
+// Every queue pair gets its own buffers, but we don't want to use an ever growing
+// amount of memory for each pair on machines with many processors.
+static constexpr u16 MIN_INFLIGHT_PACKETS_PER_QUEUE = 32;
 
 UNMAP_AFTER_INIT ErrorOr<bool> VirtIONetworkAdapter::probe(PCI::DeviceIdentifier const& pci_device_identifier)
 {
@@ -115,9 +132,6 @@ UNMAP_AFTER_INIT VirtIONetworkAdapter::VirtIONetworkAdapter(StringView interface
 
 UNMAP_AFTER_INIT ErrorOr<void> VirtIONetworkAdapter::initialize(Badge<NetworkingManagement>)
 {
-    m_rx_buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Rx buffer"sv, RX_BUFFER_SIZE * MAX_INFLIGHT_PACKETS));
-    m_tx_buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Tx buffer"sv, RX_BUFFER_SIZE * MAX_INFLIGHT_PACKETS));
-
     return initialize_virtio_resources();
 }
 
@@ -127,6 +141,7 @@ UNMAP_AFTER_INIT ErrorOr<void> VirtIONetworkAdapter::initialize_virtio_resources
     TRY(Device::initialize_virtio_resources());
     m_device_config = TRY(transport_entity().get_config(VirtIO::ConfigurationType::Device));
 
+    u16 maximum_queue_pairs = 1;
     TRY(negotiate_features([&](u64 supported_features) {
         u64 negotiated = 0;
         if (is_feature_set(supported_features, VIRTIO_NET_F_STATUS))
@@ -137,30 +152,101 @@ UNMAP_AFTER_INIT ErrorOr<void> VirtIONetworkAdapter::initialize_virtio_resources
             negotiated |= VIRTIO_NET_F_SPEED_DUPLEX;
         if (is_feature_set(supported_features, VIRTIO_NET_F_MTU))
             negotiated |= VIRTIO_NET_F_MTU;
+        // The number of queue pairs can only be changed through the control queue.
+        if (is_feature_set(supported_features, VIRTIO_NET_F_MQ | VIRTIO_NET_F_CTRL_VQ)) {
+            u16 device_queue_pairs = transport_entity().config_read16(*m_device_config, offsetof(VirtIONetConfig, max_virtqueue_pairs));
+            // The control queue comes after all the queue pairs the device has, so we
+            // have to set up every one of them even if we only use a few.
+            if (device_queue_pairs > VIRTIO_NET_CTRL_MQ_VQ_PAIRS_MIN && device_queue_pairs <= MAX_CPU_COUNT) {
+                negotiated |= VIRTIO_NET_F_MQ | VIRTIO_NET_F_CTRL_VQ;
+                maximum_queue_pairs = device_queue_pairs;
+            }
+        }
         return negotiated;
     }));
 
     TRY(handle_device_config_change());
-    TRY(setup_queues(2)); // receive & transmit
+
+    u16 queue_pair_count = 1;
+    if (is_feature_accepted(VIRTIO_NET_F_MQ)) {
+        queue_pair_count = min(maximum_queue_pairs, NetworkTask::worker_count());
+        m_control_queue_index = 2 * maximum_queue_pairs;
+        m_control_buffer = TRY(MM.allocate_dma_buffer_page("VirtIONetworkAdapter control buffer"sv, Memory::Region::Access::ReadWrite));
+        TRY(setup_queues(2 * maximum_queue_pairs + 1)); // receive & transmit for every pair, and control
+    } else {
+        TRY(setup_queues(2)); // receive & transmit
+    }
+
+    auto inflight_packets = max(MAX_INFLIGHT_PACKETS / queue_pair_count, MIN_INFLIGHT_PACKETS_PER_QUEUE);
+    for (u16 pair = 0; pair < queue_pair_count; ++pair) {
+        TRY(m_queue_pairs.try_append({
+            .rx_buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Rx buffer"sv, RX_BUFFER_SIZE * inflight_packets)),
+            .tx_buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Tx buffer"sv, RX_BUFFER_SIZE * inflight_packets)),
+        }));
+    }
 
     finish_init();
 
-    {
+    for (u16 pair = 0; pair < queue_pair_count; ++pair) {
         // Supply receive buffers.
-        auto& rx_queue = get_queue(RECEIVEQ);
+        auto& rx_buffers = *m_queue_pairs[pair].rx_buffers;
+        auto& rx_queue = get_queue(receive_queue_index(pair));
         SpinlockLocker queue_lock(rx_queue.lock());
         VirtIO::QueueChain chain(rx_queue);
-        while (m_rx_buffers->available_bytes() > RX_BUFFER_SIZE) {
+        while (rx_buffers.available_bytes() > RX_BUFFER_SIZE) {
             // We know that the RingBuffer will not wraparound in this loop. But it's still awkward.
-            auto buffer_start = MUST(m_rx_buffers->reserve_space(RX_BUFFER_SIZE));
+            auto buffer_start = MUST(rx_buffers.reserve_space(RX_BUFFER_SIZE));
             VERIFY(chain.add_buffer_to_chain(buffer_start, RX_BUFFER_SIZE, VirtIO::BufferType::DeviceWritable));
-            supply_chain_and_notify(RECEIVEQ, chain);
+            supply_chain_and_notify(receive_queue_index(pair), chain);
         }
     }
 
+    if (queue_pair_count > 1) {
+        if (auto result = set_active_queue_pairs(queue_pair_count); result.is_error()) {
+            // The device keeps using the first pair only, so we do as well.
+            dmesgln("VirtIONetworkAdapter: Failed to enable {} queue pairs: {}", queue_pair_count, result.error());
+            m_queue_pairs.shrink(1);
+        }
+    }
+    dmesgln("VirtIONetworkAdapter: Using {} queue pair(s)", m_queue_pairs.size());
+
     return {};
 }
 
+UNMAP_AFTER_INIT ErrorOr<void> VirtIONetworkAdapter::set_active_queue_pairs(u16 count)
+{
+    VERIFY(m_control_queue_index.has_value());
+    VERIFY(count >= VIRTIO_NET_CTRL_MQ_VQ_PAIRS_MIN && count <= VIRTIO_NET_CTRL_MQ_VQ_PAIRS_MAX);
+
+    auto& request = *reinterpret_cast<VirtIONetCtrlMQ*>(m_control_buffer->vaddr().as_ptr());
+    request.command_class = VIRTIO_NET_CTRL_MQ;
+    request.command = VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET;
+    request.virtqueue_pairs = count;
+    auto& ack = *(m_control_buffer->vaddr().as_ptr() + sizeof(VirtIONetCtrlMQ));
+    ack = 0xff;
+
+    auto buffer_start = m_control_buffer->physical_page(0)->paddr();
+    auto& queue = get_queue(*m_control_queue_index);
+    queue.disable_interrupts();
+    SpinlockLocker lock(queue.lock());
+    VirtIO::QueueChain chain { queue };
+    chain.add_buffer_to_chain(buffer_start, sizeof(VirtIONetCtrlMQ), VirtIO::BufferType::DeviceReadable);
+    chain.add_buffer_to_chain(buffer_start.offset(sizeof(VirtIONetCtrlMQ)), sizeof(u8), VirtIO::BufferType::DeviceWritable);
+    supply_chain_and_notify(*m_control_queue_index, chain);
+    full_memory_barrier();
+
+    ScopeGuard clear_used_buffers([&] {
+        queue.discard_used_buffers();
+    });
+    // The device should answer right away, so give up after 100ms.
+    for (size_t elapsed_microseconds = 0; elapsed_microseconds < 100'000; ++elapsed_microseconds) {
+        if (queue.new_data_available())
+            return ack == VIRTIO_NET_OK ? ErrorOr<void> {} : Error::from_errno(EIO);
+        microseconds_delay(1);
+    }
+    return Error::from_errno(EBUSY);
+}
+
 ErrorOr<void> VirtIONetworkAdapter::handle_device_config_change()
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: handle_device_config_change");
@@ -196,41 +282,60 @@ void VirtIONetworkAdapter::handle_queue_update(u16 queue_index)
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: handle_queue_update {}", queue_index);
 
-    if (queue_index == RECEIVEQ) {
-        // FIXME: Disable interrupts while receiving as recommended by the spec.
-        auto& queue = get_queue(RECEIVEQ);
-        SpinlockLocker queue_lock(queue.lock());
-        size_t used;
-        VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
-
-        while (!popped_chain.is_empty()) {
-            VERIFY(popped_chain.length() == 1);
-            popped_chain.for_each([&](PhysicalAddress addr, size_t length) {
-                size_t offset = addr.as_ptr() - m_rx_buffers->start_of_region().as_ptr();
-                auto* message = reinterpret_cast<VirtIONetHdr*>(m_rx_buffers->vaddr().offset(offset).as_ptr());
-                did_receive({ message->frame, length - sizeof(VirtIONetHdr) });
-            });
-
-            supply_chain_and_notify(RECEIVEQ, popped_chain);
-            popped_chain = queue.pop_used_buffer_chain(used);
-        }
-    } else if (queue_index == TRANSMITQ) {
-        auto& queue = get_queue(TRANSMITQ);
-        SpinlockLocker queue_lock(queue.lock());
-        SpinlockLocker ringbuffer_lock(m_tx_buffers->lock());
-
-        size_t used;
-        VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
-        do {
-            popped_chain.for_each([this](PhysicalAddress address, size_t length) {
-                m_tx_buffers->reclaim_space(address, length);
-            });
-            popped_chain.release_buffer_slots_to_queue();
-            popped_chain = queue.pop_used_buffer_chain(used);
-        } while (!popped_chain.is_empty());
-    } else {
+    // Control commands are sent synchronously, so there is nothing to do for them here.
+    if (queue_index == m_control_queue_index)
+        return;
+
+    u16 pair = queue_index / 2;
+    if (pair >= m_queue_pairs.size()) {
         dmesgln("VirtIONetworkAdapter: unexpected update for queue {}", queue_index);
+        return;
     }
+
+    if (queue_index == receive_queue_index(pair))
+        receive(pair);
+    else
+        reclaim_transmit_buffers(pair);
+}
+
+void VirtIONetworkAdapter::receive(u16 pair)
+{
+    // FIXME: Disable interrupts while receiving as recommended by the spec.
+    auto& rx_buffers = *m_queue_pairs[pair].rx_buffers;
+    auto& queue = get_queue(receive_queue_index(pair));
+    SpinlockLocker queue_lock(queue.lock());
+    size_t used;
+    VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
+
+    while (!popped_chain.is_empty()) {
+        VERIFY(popped_chain.length() == 1);
+        popped_chain.for_each([&](PhysicalAddress addr, size_t length) {
+            size_t offset = addr.as_ptr() - rx_buffers.start_of_region().as_ptr();
+            auto* message = reinterpret_cast<VirtIONetHdr*>(rx_buffers.vaddr().offset(offset).as_ptr());
+            did_receive({ message->frame, length - sizeof(VirtIONetHdr) });
+        });
+
+        supply_chain_and_notify(receive_queue_index(pair), popped_chain);
+        popped_chain = queue.pop_used_buffer_chain(used);
+    }
+}
+
+void VirtIONetworkAdapter::reclaim_transmit_buffers(u16 pair)
+{
+    auto& tx_buffers = *m_queue_pairs[pair].tx_buffers;
+    auto& queue = get_queue(transmit_queue_index(pair));
+    SpinlockLocker queue_lock(queue.lock());
+    SpinlockLocker ringbuffer_lock(tx_buffers.lock());
+
+    size_t used;
+    VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
+    do {
+        popped_chain.for_each([&tx_buffers](PhysicalAddress address, size_t length) {
+            tx_buffers.reclaim_space(address, length);
+        });
+        popped_chain.release_buffer_slots_to_queue();
+        popped_chain = queue.pop_used_buffer_chain(used);
+    } while (!popped_chain.is_empty());
 }
 
 static bool copy_data_to_chain(VirtIO::QueueChain& chain, Memory::RingBuffer& ring, u8 const* data, size_t length)
@@ -256,12 +361,15 @@ void VirtIONetworkAdapter::send_raw(ReadonlyBytes payload)
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: send_raw length={}", payload.size());
 
-    auto& queue = get_queue(TRANSMITQ);
+    // Packets of one flow always leave through the same queue, so they can't overtake each other.
+    u16 pair = m_queue_pairs.size() > 1 ? compute_flow_hash(payload) % m_queue_pairs.size() : 0;
+    auto& tx_buffers = *m_queue_pairs[pair].tx_buffers;
+    auto& queue = get_queue(transmit_queue_index(pair));
     SpinlockLocker queue_lock(queue.lock());
     VirtIO::QueueChain chain(queue);
 
-    SpinlockLocker ringbuffer_lock(m_tx_buffers->lock());
-    if (m_tx_buffers->available_bytes() < sizeof(VirtIONetHdr) + payload.size()) {
+    SpinlockLocker ringbuffer_lock(tx_buffers.lock());
+    if (tx_buffers.available_bytes() < sizeof(VirtIONetHdr) + payload.size()) {
         // We can drop packets that don't fit to apply back pressure on eager senders.
         dmesgln("VirtIONetworkAdapter: not enough space in the buffer. Dropping packet");
         return;
@@ -269,10 +377,10 @@ void VirtIONetworkAdapter::send_raw(ReadonlyBytes payload)
 
     // FIXME: Handle errors from pushing to the chain and rewind the RingBuffer.
     VirtIONetHdr hdr {};
-    VERIFY(copy_data_to_chain(chain, *m_tx_buffers, reinterpret_cast<u8*>(&hdr), sizeof(hdr)));
-    VERIFY(copy_data_to_chain(chain, *m_tx_buffers, payload.data(), payload.size()));
+    VERIFY(copy_data_to_chain(chain, tx_buffers, reinterpret_cast<u8*>(&hdr), sizeof(hdr)));
+    VERIFY(copy_data_to_chain(chain, tx_buffers, payload.data(), payload.size()));
 
-    supply_chain_and_notify(TRANSMITQ, chain);
+    supply_chain_and_notify(transmit_queue_index(pair), chain);
 }
 
 }
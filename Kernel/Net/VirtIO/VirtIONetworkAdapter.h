@@ -43,6 +43,13 @@ private:
     // NetworkAdapter
     virtual void send_raw(ReadonlyBytes) override;
 
+    static u16 receive_queue_index(u16 pair) { return 2 * pair; }
+    static u16 transmit_queue_index(u16 pair) { return 2 * pair + 1; }
+
+    ErrorOr<void> set_active_queue_pairs(u16 count);
+    void receive(u16 pair);
+    void reclaim_transmit_buffers(u16 pair);
+
 private:
     VirtIO::Configuration const* m_device_config { nullptr };
 
@@ -52,8 +59,16 @@ private:
     i32 m_link_speed { LINKSPEED_INVALID };
     bool m_link_duplex { false };
 
-    OwnPtr<Memory::RingBuffer> m_rx_buffers;
-    OwnPtr<Memory::RingBuffer> m_tx_buffers;
+    // With VIRTIO_NET_F_MQ the device spreads flows over several receive queues,
+    // and we spread outgoing flows over the transmit queues in the same way.
+    struct QueuePair {
+        NonnullOwnPtr<Memory::RingBuffer> rx_buffers;
+        NonnullOwnPtr<Memory::RingBuffer> tx_buffers;
+    };
+    Vector<QueuePair> m_queue_pairs;
+
+    Optional<u16> m_control_queue_index;
+    OwnPtr<Memory::Region> m_control_buffer;
 };
 
 }
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ScopeGuard.h>
+#include <Kernel/API/POSIX/sys/epoll.h>
+#include <Kernel/FileSystem/EventPoll.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+ErrorOr<FlatPtr> Process::sys$epoll_create1(int flags)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    if (flags & ~EPOLL_CLOEXEC)
+        return EINVAL;
+
+    auto event_poll = TRY(EventPoll::try_create());
+    auto description = TRY(OpenFileDescription::try_create(move(event_poll)));
+    description->set_readable(true);
+
+    return m_fds.with_exclusive([&](auto& fds) -> ErrorOr<FlatPtr> {
+        auto fd_allocation = TRY(fds.allocate());
+        fds[fd_allocation.fd].set(move(description), (flags & EPOLL_CLOEXEC) ? FD_CLOEXEC : 0);
+        return fd_allocation.fd;
+    });
+}
+
+ErrorOr<FlatPtr> Process::sys$epoll_ctl(Userspace<Syscall::SC_epoll_ctl_params const*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    auto description = TRY(open_file_description(params.epfd));
+    if (!description->is_event_poll())
+        return EINVAL;
+    auto* event_poll = description->event_poll();
+
+    auto target_description = TRY(open_file_description(params.fd));
+    if (target_description == description)
+        return EINVAL;
+
+    epoll_event event {};
+    if (params.op == EPOLL_CTL_ADD || params.op == EPOLL_CTL_MOD)
+        TRY(copy_from_user(&event, params.event));
+
+    switch (params.op) {
+    case EPOLL_CTL_ADD:
+        TRY(event_poll->add_watch(*target_description, params.fd, event));
+        return 0;
+    case EPOLL_CTL_MOD:
+        TRY(event_poll->modify_watch(*target_description, params.fd, event));
+        return 0;
+    case EPOLL_CTL_DEL:
+        TRY(event_poll->remove_watch(*target_description, params.fd));
+        return 0;
+    default:
+        return EINVAL;
+    }
+}
+
+ErrorOr<FlatPtr> Process::sys$epoll_pwait(Userspace<Syscall::SC_epoll_pwait_params const*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.maxevents <= 0)
+        return EINVAL;
+
+    auto description = TRY(open_file_description(params.epfd));
+    if (!description->is_event_poll())
+        return EINVAL;
+    auto* event_poll = description->event_poll();
+
+    // The deadline is fixed here, so waking up without any events doesn't extend the wait.
+    Thread::BlockTimeout timeout;
+    bool should_block = true;
+    if (params.timeout) {
+        auto timeout_time = TRY(copy_time_from_user(params.timeout));
+        timeout = Thread::BlockTimeout(false, &timeout_time);
+        should_block = timeout_time > Duration::zero();
+    }
+
+    sigset_t sigmask = {};
+    if (params.sigmask)
+        TRY(copy_from_user(&sigmask, params.sigmask));
+
+    // There can't be more ready watches than open file descriptions.
+    Vector<epoll_event> events;
+    TRY(events.try_resize(min(static_cast<size_t>(params.maxevents), OpenFileDescriptions::max_open())));
+
+    auto* current_thread = Thread::current();
+
+    u32 previous_signal_mask = 0;
+    if (params.sigmask)
+        previous_signal_mask = current_thread->update_signal_mask(sigmask);
+    ScopeGuard rollback_signal_mask([&]() {
+        if (params.sigmask)
+            current_thread->update_signal_mask(previous_signal_mask);
+    });
+
+    while (true) {
+        auto count = TRY(event_poll->collect_ready_events(events));
+        if (count > 0) {
+            TRY(copy_n_to_user(params.events, events.data(), count));
+            return count;
+        }
+        if (!should_block)
+            return 0;
+
+        // The event poll is readable while any of its watches was notified, so this
+        // only blocks until the next state change of a watched file.
+        auto unblock_flags = Thread::FileBlocker::BlockFlags::None;
+        auto result = current_thread->block<Thread::ReadBlocker>(timeout, *description, unblock_flags);
+        if (result.was_interrupted())
+            return EINTR;
+        if (result == Thread::BlockResult::InterruptedByTimeout)
+            should_block = false;
+    }
+}
+
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+// https://pubs.opengroup.org/onlinepubs/9699919799/functions/posix_fadvise.html
+ErrorOr<FlatPtr> Process::sys$posix_fadvise(int fd, off_t offset, off_t length, int advice)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    // [EINVAL] The value of advice is invalid, or the value of len is less than zero.
+    if (offset < 0 || length < 0)
+        return EINVAL;
+
+    auto description = TRY(open_file_description(fd));
+
+    // [ESPIPE] The fd argument is associated with a pipe or FIFO.
+    if (description->is_fifo())
+        return ESPIPE;
+
+    // NOTE: We only track the access pattern for the whole file, so the range is ignored.
+    switch (advice) {
+    case POSIX_FADV_NORMAL:
+        description->set_access_pattern(OpenFileDescription::AccessPattern::Normal);
+        break;
+    case POSIX_FADV_SEQUENTIAL:
+        description->set_access_pattern(OpenFileDescription::AccessPattern::Sequential);
+        break;
+    case POSIX_FADV_RANDOM:
+        description->set_access_pattern(OpenFileDescription::AccessPattern::Random);
+        break;
+    case POSIX_FADV_DONTNEED:
+    case POSIX_FADV_NOREUSE:
+    case POSIX_FADV_WILLNEED:
+        // Per POSIX, these "may affect the performance of other operations", but don't have to.
+        break;
+    default:
+        return EINVAL;
+    }
+    return 0;
+}
+
+}
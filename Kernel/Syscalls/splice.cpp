@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/Checked.h>
+#include <AK/NumericLimits.h>
+#include <Kernel/API/POSIX/fcntl.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+// Data moves between the two files through this much kernel memory at a time,
+// so it never has to be copied out to userspace and back in again.
+static constexpr size_t splice_buffer_size = 64 * KiB;
+
+ErrorOr<FlatPtr> Process::sys$splice(Userspace<Syscall::SC_splice_params const*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.flags & ~(SPLICE_F_MOVE | SPLICE_F_NONBLOCK | SPLICE_F_MORE | SPLICE_F_GIFT))
+        return EINVAL;
+    if (params.length == 0)
+        return 0;
+    auto length = min(params.length, static_cast<size_t>(NumericLimits<ssize_t>::max()));
+
+    auto input = TRY(open_file_description(params.fd_in));
+    if (!input->is_readable())
+        return EBADF;
+    if (input->is_directory())
+        return EISDIR;
+    auto output = TRY(open_file_description(params.fd_out));
+    if (!output->is_writable())
+        return EBADF;
+    if (input == output)
+        return EINVAL;
+
+    dbgln_if(IO_DEBUG, "sys$splice({}, {}, {})", params.fd_in, params.fd_out, length);
+
+    // Seekable input is always read at an explicit offset, so that nothing is lost if
+    // the output takes less than we read. Its file offset is only moved at the very end.
+    bool input_is_seekable = input->file().is_seekable();
+    off_t input_offset = 0;
+    if (params.offset_in) {
+        if (!input_is_seekable)
+            return ESPIPE;
+        TRY(copy_from_user(&input_offset, params.offset_in));
+        if (input_offset < 0)
+            return EINVAL;
+    } else if (input_is_seekable) {
+        input_offset = input->offset();
+    }
+
+    Optional<off_t> output_offset;
+    if (params.offset_out) {
+        if (!output->file().is_seekable())
+            return ESPIPE;
+        off_t offset = 0;
+        TRY(copy_from_user(&offset, params.offset_out));
+        if (offset < 0)
+            return EINVAL;
+        output_offset = offset;
+    }
+
+    // The offsets only ever move forward by what was transferred, so limiting the length
+    // like this makes sure that none of the offset calculations below can overflow.
+    auto limit_length_to_offset = [&](off_t offset) {
+        if (Checked<off_t>::addition_would_overflow(offset, static_cast<off_t>(length)))
+            length = NumericLimits<off_t>::max() - offset;
+    };
+    if (input_is_seekable) {
+        limit_length_to_offset(input_offset);
+        if (length == 0)
+            return 0;
+    }
+    if (output_offset.has_value()) {
+        limit_length_to_offset(output_offset.value());
+        if (length == 0)
+            return EFBIG;
+    }
+
+    bool may_block = !(params.flags & SPLICE_F_NONBLOCK);
+    auto buffer = TRY(ByteBuffer::create_uninitialized(min(length, splice_buffer_size)));
+    auto kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer.data());
+
+    auto wait_for = [&](OpenFileDescription& description, BlockFlags block_flags) -> ErrorOr<void> {
+        if (!may_block || !description.is_blocking())
+            return EAGAIN;
+        auto unblock_flags = BlockFlags::None;
+        auto result = block_flags == BlockFlags::Read
+            ? Thread::current()->block<Thread::ReadBlocker>({}, description, unblock_flags)
+            : Thread::current()->block<Thread::WriteBlocker>({}, description, unblock_flags);
+        if (result.was_interrupted())
+            return EINTR;
+        return {};
+    };
+
+    size_t total_transferred = 0;
+    auto transfer = [&]() -> ErrorOr<void> {
+        while (total_transferred < length) {
+            // Like read() and write(), only wait if nothing has been transferred yet.
+            if (!input->can_read()) {
+                if (total_transferred > 0)
+                    return {};
+                TRY(wait_for(*input, BlockFlags::Read));
+                continue;
+            }
+            if (!output->can_write()) {
+                if (total_transferred > 0)
+                    return {};
+                TRY(wait_for(*output, BlockFlags::Write));
+                continue;
+            }
+
+            auto chunk_size = min(buffer.size(), length - total_transferred);
+            auto nread = input_is_seekable
+                ? TRY(input->read(kernel_buffer, input_offset + total_transferred, chunk_size))
+                : TRY(input->read(kernel_buffer, chunk_size));
+            if (nread == 0)
+                return {};
+
+            auto chunk_output_offset = output_offset.map([&](auto offset) { return static_cast<off_t>(offset + total_transferred); });
+            if (input_is_seekable) {
+                auto nwritten = TRY(do_write(*output, kernel_buffer, nread, chunk_output_offset));
+                total_transferred += nwritten;
+                if (nwritten < nread)
+                    return {};
+                continue;
+            }
+
+            // Data that was taken out of a pipe or socket can't be put back, so all of it
+            // has to be written, even if that means blocking on a non-blocking output.
+            size_t nwritten = 0;
+            while (nwritten < nread) {
+                auto result = do_write(*output, kernel_buffer.offset(nwritten), nread - nwritten, chunk_output_offset.map([&](auto offset) { return static_cast<off_t>(offset + nwritten); }));
+                if (result.is_error() && result.error().code() == EAGAIN) {
+                    auto unblock_flags = BlockFlags::None;
+                    if (Thread::current()->block<Thread::WriteBlocker>({}, *output, unblock_flags).was_interrupted())
+                        break;
+                    continue;
+                }
+                if (result.is_error()) {
+                    if (total_transferred + nwritten == 0)
+                        return result.release_error();
+                    break;
+                }
+                nwritten += result.value();
+            }
+            total_transferred += nwritten;
+            if (nwritten < nread)
+                return {};
+        }
+        return {};
+    }();
+
+    if (transfer.is_error() && total_transferred == 0)
+        return transfer.release_error();
+
+    if (params.offset_in) {
+        off_t new_offset = input_offset + total_transferred;
+        TRY(copy_to_user(params.offset_in, &new_offset));
+    } else if (input_is_seekable) {
+        TRY(input->seek(input_offset + total_transferred, SEEK_SET));
+    }
+    if (params.offset_out) {
+        off_t new_offset = output_offset.value() + total_transferred;
+        TRY(copy_to_user(params.offset_out, &new_offset));
+    }
+    return total_transferred;
+}
+
+}
@@ -346,6 +346,9 @@ public:
     void tracer_trap(Thread&, RegisterState const&);
 
     ErrorOr<FlatPtr> sys$emuctl();
+    ErrorOr<FlatPtr> sys$epoll_create1(int flags);
+    ErrorOr<FlatPtr> sys$epoll_ctl(Userspace<Syscall::SC_epoll_ctl_params const*>);
+    ErrorOr<FlatPtr> sys$epoll_pwait(Userspace<Syscall::SC_epoll_pwait_params const*>);
     ErrorOr<FlatPtr> sys$yield();
     ErrorOr<FlatPtr> sys$sync();
     ErrorOr<FlatPtr> sys$beep(int tone);
@@ -383,6 +386,7 @@ public:
     ErrorOr<FlatPtr> sys$lseek(int fd, Userspace<off_t*>, int whence);
     ErrorOr<FlatPtr> sys$ftruncate(int fd, off_t);
     ErrorOr<FlatPtr> sys$futimens(Userspace<Syscall::SC_futimens_params const*>);
+    ErrorOr<FlatPtr> sys$posix_fadvise(int fd, off_t, off_t, int advice);
     ErrorOr<FlatPtr> sys$posix_fallocate(int fd, off_t, off_t);
     ErrorOr<FlatPtr> sys$kill(pid_t pid_or_pgid, int sig);
     [[noreturn]] void sys$exit(int status);
@@ -397,6 +401,7 @@ public:
     ErrorOr<FlatPtr> sys$msync(Userspace<void*>, size_t, int flags);
     ErrorOr<FlatPtr> sys$purge(int mode);
     ErrorOr<FlatPtr> sys$poll(Userspace<Syscall::SC_poll_params const*>);
+    ErrorOr<FlatPtr> sys$splice(Userspace<Syscall::SC_splice_params const*>);
     ErrorOr<FlatPtr> sys$get_dir_entries(int fd, Userspace<void*>, size_t);
     ErrorOr<FlatPtr> sys$getcwd(Userspace<char*>, size_t);
     ErrorOr<FlatPtr> sys$chdir(Userspace<char const*>, size_t);
@@ -6,7 +6,6 @@
 
 #include <AK/BuiltinWrappers.h>
 #include <AK/ScopeGuard.h>
-#include <AK/Singleton.h>
 #include <AK/Time.h>
 #include <Kernel/Arch/TrapFrame.h>
 #include <Kernel/Debug.h>
@@ -40,13 +39,49 @@ struct ThreadReadyQueue {
     IntrusiveList<&Thread::m_ready_queue_node> thread_list;
 };
 
-struct ThreadReadyQueues {
-    u32 mask {};
-    static constexpr size_t count = sizeof(mask) * 8;
-    Array<ThreadReadyQueue, count> queues;
+// Every processor owns one set of ready queues, so picking the next thread to run
+// on one core never has to contend with context switches happening on another.
+class ThreadReadyQueues {
+public:
+    static ProcessorSpecificDataID processor_specific_data_id() { return ProcessorSpecificDataID::Scheduler; }
+
+    static constexpr size_t count = sizeof(u32) * 8;
+
+    Thread* pull_next_runnable_thread(u32 affinity_mask);
+    Thread* peek_next_runnable_thread(u32 affinity_mask);
+    bool dequeue(Thread&, u32 processor);
+    void enqueue(Thread&, u32 priority, u32 processor);
+
+    // NOTE: These are read without holding m_lock when looking for a processor to place
+    //       a thread on or to steal work from, so they are only ever a hint.
+    u32 depth() const { return m_depth.load(AK::MemoryOrder::memory_order_relaxed); }
+    u64 steals() const { return m_steals.load(AK::MemoryOrder::memory_order_relaxed); }
+    u64 migrations() const { return m_migrations.load(AK::MemoryOrder::memory_order_relaxed); }
+
+    void did_steal() { m_steals.fetch_add(1, AK::MemoryOrder::memory_order_relaxed); }
+    void did_migrate() { m_migrations.fetch_add(1, AK::MemoryOrder::memory_order_relaxed); }
+
+private:
+    Thread* find_runnable_thread(u32 affinity_mask);
+    void remove(Thread&);
+
+    Spinlock<LockRank::None> m_lock {};
+    u32 m_mask {};
+    Array<ThreadReadyQueue, count> m_queues;
+
+    Atomic<u32> m_depth { 0 };
+    Atomic<u64> m_steals { 0 };
+    Atomic<u64> m_migrations { 0 };
 };
 
-static Singleton<SpinlockProtected<ThreadReadyQueues, LockRank::None>> g_ready_queues;
+// Thread affinity masks are 32 bits wide, so that is as many processors as we can schedule on.
+static constexpr u32 max_scheduled_processors = sizeof(u32) * 8;
+
+// The ready queues live in each processor's specific data, but we also need to look at
+// other processors' queues when placing threads and stealing work. This table is written
+// once per processor during bring-up, before its bit in s_online_processors_mask is set.
+static Array<ThreadReadyQueues*, max_scheduled_processors> s_processor_ready_queues;
+static Atomic<u32> s_online_processors_mask { 0 };
 
 static SpinlockProtected<TotalTimeScheduled, LockRank::None> g_total_time_scheduled {};
 
@@ -55,7 +90,7 @@ static void dump_thread_list(bool = false);
 static inline u32 thread_priority_to_priority_index(u32 thread_priority)
 {
     // Converts the priority in the range of THREAD_PRIORITY_MIN...THREAD_PRIORITY_MAX
-    // to a index into g_ready_queues where 0 is the highest priority bucket
+    // to a index into the ready queues where 0 is the highest priority bucket
     VERIFY(thread_priority >= THREAD_PRIORITY_MIN && thread_priority <= THREAD_PRIORITY_MAX);
     constexpr u32 thread_priority_count = THREAD_PRIORITY_MAX - THREAD_PRIORITY_MIN + 1;
     static_assert(thread_priority_count > 0);
@@ -64,74 +99,205 @@ static inline u32 thread_priority_to_priority_index(u32 thread_priority)
     return priority_bucket;
 }
 
-Thread& Scheduler::pull_next_runnable_thread()
+Thread* ThreadReadyQueues::find_runnable_thread(u32 affinity_mask)
 {
-    auto affinity_mask = 1u << Processor::current_id();
+    VERIFY(m_lock.is_locked());
+    auto priority_mask = m_mask;
+    while (priority_mask != 0) {
+        auto priority = bit_scan_forward(priority_mask);
+        VERIFY(priority > 0);
+        auto& ready_queue = m_queues[--priority];
+        for (auto& thread : ready_queue.thread_list) {
+            VERIFY(thread.m_runnable_priority == (int)priority);
+            if (thread.is_active())
+                continue;
+            if (!(thread.affinity() & affinity_mask))
+                continue;
+            return &thread;
+        }
+        priority_mask &= ~(1u << priority);
+    }
+    return nullptr;
+}
+
+void ThreadReadyQueues::remove(Thread& thread)
+{
+    VERIFY(m_lock.is_locked());
+    auto priority = thread.m_runnable_priority;
+    VERIFY(m_mask & (1u << priority));
+    auto& ready_queue = m_queues[priority];
+    thread.m_runnable_priority = -1;
+    ready_queue.thread_list.remove(thread);
+    if (ready_queue.thread_list.is_empty())
+        m_mask &= ~(1u << priority);
+    m_depth.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+}
+
+Thread* ThreadReadyQueues::pull_next_runnable_thread(u32 affinity_mask)
+{
+    SpinlockLocker lock(m_lock);
+    auto* thread = find_runnable_thread(affinity_mask);
+    if (!thread)
+        return nullptr;
+    remove(*thread);
+    // Mark it as active because we are using this thread. This is similar
+    // to comparing it with Processor::current_thread, but when there are
+    // multiple processors there's no easy way to check whether the thread
+    // is actually still needed. This prevents accidental finalization when
+    // a thread is no longer in Running state, but running on another core.
+
+    // We need to mark it active here so that this thread won't be
+    // scheduled on another core if it were to be queued before actually
+    // switching to it.
+    // FIXME: Figure out a better way maybe?
+    thread->set_active(true);
+    return thread;
+}
+
+Thread* ThreadReadyQueues::peek_next_runnable_thread(u32 affinity_mask)
+{
+    SpinlockLocker lock(m_lock);
+    return find_runnable_thread(affinity_mask);
+}
+
+bool ThreadReadyQueues::dequeue(Thread& thread, u32 processor)
+{
+    SpinlockLocker lock(m_lock);
+    if (thread.m_runnable_priority < 0) {
+        VERIFY(!thread.m_ready_queue_node.is_in_list());
+        return false;
+    }
+    // The thread may have been stolen and queued elsewhere before we got the lock.
+    if (thread.m_ready_queue_processor != processor)
+        return false;
+    remove(thread);
+    return true;
+}
+
+void ThreadReadyQueues::enqueue(Thread& thread, u32 priority, u32 processor)
+{
+    SpinlockLocker lock(m_lock);
+    VERIFY(thread.m_runnable_priority < 0);
+    thread.m_runnable_priority = (int)priority;
+    thread.m_ready_queue_processor = processor;
+    VERIFY(!thread.m_ready_queue_node.is_in_list());
+    auto& ready_queue = m_queues[priority];
+    bool was_empty = ready_queue.thread_list.is_empty();
+    ready_queue.thread_list.append(thread);
+    if (was_empty)
+        m_mask |= (1u << priority);
+    m_depth.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+}
+
+static ThreadReadyQueues& current_ready_queues()
+{
+    return ProcessorSpecific<ThreadReadyQueues>::get();
+}
+
+static void initialize_ready_queues_for_current_processor()
+{
+    auto processor = Processor::current_id();
+    VERIFY(processor < max_scheduled_processors);
+    ProcessorSpecific<ThreadReadyQueues>::initialize();
+    s_processor_ready_queues[processor] = &current_ready_queues();
+    s_online_processors_mask.fetch_or(1u << processor, AK::MemoryOrder::memory_order_release);
+}
 
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread& {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                thread.m_runnable_priority = -1;
-                ready_queue.thread_list.remove(thread);
-                if (ready_queue.thread_list.is_empty())
-                    ready_queues.mask &= ~(1u << priority);
-                // Mark it as active because we are using this thread. This is similar
-                // to comparing it with Processor::current_thread, but when there are
-                // multiple processors there's no easy way to check whether the thread
-                // is actually still needed. This prevents accidental finalization when
-                // a thread is no longer in Running state, but running on another core.
-
-                // We need to mark it active here so that this thread won't be
-                // scheduled on another core if it were to be queued before actually
-                // switching to it.
-                // FIXME: Figure out a better way maybe?
-                thread.set_active(true);
-                return thread;
-            }
-            priority_mask &= ~(1u << priority);
+template<typename Callback>
+static void for_each_online_processor(u32 first_processor, Callback callback)
+{
+    auto online_mask = s_online_processors_mask.load(AK::MemoryOrder::memory_order_acquire);
+    for (u32 i = 0; i < max_scheduled_processors; ++i) {
+        auto processor = (first_processor + i) % max_scheduled_processors;
+        if (!(online_mask & (1u << processor)))
+            continue;
+        if (callback(processor, *s_processor_ready_queues[processor]) == IterationDecision::Break)
+            return;
+    }
+}
+
+static u32 select_processor_for(Thread const& thread)
+{
+    auto current_processor = Processor::current_id();
+    auto candidates = thread.affinity() & s_online_processors_mask.load(AK::MemoryOrder::memory_order_acquire);
+    if (candidates == 0) {
+        // None of the processors this thread may run on are online yet. Park it on one
+        // that is; its own processor will steal it as soon as it starts scheduling.
+        if (s_online_processors_mask.load(AK::MemoryOrder::memory_order_acquire) & (1u << current_processor))
+            return current_processor;
+        return 0;
+    }
+
+    u32 least_loaded_processor = 0;
+    u32 least_loaded_depth = NumericLimits<u32>::max();
+    for_each_online_processor(current_processor, [&](u32 processor, ThreadReadyQueues& ready_queues) {
+        if (!(candidates & (1u << processor)))
+            return IterationDecision::Continue;
+        auto depth = ready_queues.depth();
+        if (depth < least_loaded_depth) {
+            least_loaded_processor = processor;
+            least_loaded_depth = depth;
         }
+        return IterationDecision::Continue;
+    });
 
-        auto* idle_thread = Processor::idle_thread();
-        idle_thread->set_active(true);
-        return *idle_thread;
+    // Keep the thread where it last ran (and its cache is likely still warm)
+    // unless that processor has noticeably more work queued than the least loaded one.
+    auto previous_processor = thread.cpu();
+    if ((candidates & (1u << previous_processor)) && s_processor_ready_queues[previous_processor]->depth() <= least_loaded_depth + 1)
+        return previous_processor;
+    return least_loaded_processor;
+}
+
+static Thread* steal_runnable_thread(u32 minimum_victim_depth, bool peek_only)
+{
+    auto current_processor = Processor::current_id();
+    auto affinity_mask = 1u << current_processor;
+    Thread* stolen_thread = nullptr;
+    for_each_online_processor(current_processor + 1, [&](u32 processor, ThreadReadyQueues& ready_queues) {
+        if (processor == current_processor || ready_queues.depth() < minimum_victim_depth)
+            return IterationDecision::Continue;
+        if (peek_only) {
+            stolen_thread = ready_queues.peek_next_runnable_thread(affinity_mask);
+        } else {
+            stolen_thread = ready_queues.pull_next_runnable_thread(affinity_mask);
+            if (stolen_thread)
+                dbgln_if(SCHEDULER_DEBUG, "Scheduler[{}]: Stole {} from processor {}", current_processor, *stolen_thread, processor);
+        }
+        return stolen_thread ? IterationDecision::Break : IterationDecision::Continue;
     });
+    if (stolen_thread && !peek_only)
+        current_ready_queues().did_steal();
+    return stolen_thread;
+}
+
+Thread& Scheduler::pull_next_runnable_thread()
+{
+    auto affinity_mask = 1u << Processor::current_id();
+
+    if (auto* thread = current_ready_queues().pull_next_runnable_thread(affinity_mask))
+        return *thread;
+
+    // We have nothing to do, so try to take some work off a busier processor.
+    if (auto* thread = steal_runnable_thread(1, false))
+        return *thread;
+
+    auto* idle_thread = Processor::idle_thread();
+    idle_thread->set_active(true);
+    return *idle_thread;
 }
 
 Thread* Scheduler::peek_next_runnable_thread()
 {
     auto affinity_mask = 1u << Processor::current_id();
 
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread* {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                return &thread;
-            }
-            priority_mask &= ~(1u << priority);
-        }
+    if (auto* thread = current_ready_queues().peek_next_runnable_thread(affinity_mask))
+        return thread;
 
-        // Unlike in pull_next_runnable_thread() we don't want to fall back to
-        // the idle thread. We just want to see if we have any other thread ready
-        // to be scheduled.
-        return nullptr;
-    });
+    // Unlike in pull_next_runnable_thread() we only consider other processors' threads
+    // if they have more than one waiting, as otherwise we would just be trading places
+    // with a thread that is about to run there anyway.
+    return steal_runnable_thread(2, true);
 }
 
 bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
@@ -139,24 +305,16 @@ bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
     if (thread.is_idle_thread())
         return true;
 
-    return g_ready_queues->with([&](auto& ready_queues) {
-        auto priority = thread.m_runnable_priority;
-        if (priority < 0) {
-            VERIFY(!thread.m_ready_queue_node.is_in_list());
-            return false;
-        }
+    if (thread.m_runnable_priority < 0) {
+        VERIFY(!thread.m_ready_queue_node.is_in_list());
+        return false;
+    }
 
-        if (check_affinity && !(thread.affinity() & (1 << Processor::current_id())))
-            return false;
+    if (check_affinity && !(thread.affinity() & (1 << Processor::current_id())))
+        return false;
 
-        VERIFY(ready_queues.mask & (1u << priority));
-        auto& ready_queue = ready_queues.queues[priority];
-        thread.m_runnable_priority = -1;
-        ready_queue.thread_list.remove(thread);
-        if (ready_queue.thread_list.is_empty())
-            ready_queues.mask &= ~(1u << priority);
-        return true;
-    });
+    auto processor = thread.m_ready_queue_processor;
+    return s_processor_ready_queues[processor]->dequeue(thread, processor);
 }
 
 void Scheduler::enqueue_runnable_thread(Thread& thread)
@@ -166,16 +324,11 @@ void Scheduler::enqueue_runnable_thread(Thread& thread)
         return;
     auto priority = thread_priority_to_priority_index(thread.priority());
 
-    g_ready_queues->with([&](auto& ready_queues) {
-        VERIFY(thread.m_runnable_priority < 0);
-        thread.m_runnable_priority = (int)priority;
-        VERIFY(!thread.m_ready_queue_node.is_in_list());
-        auto& ready_queue = ready_queues.queues[priority];
-        bool was_empty = ready_queue.thread_list.is_empty();
-        ready_queue.thread_list.append(thread);
-        if (was_empty)
-            ready_queues.mask |= (1u << priority);
-    });
+    auto processor = select_processor_for(thread);
+    auto& ready_queues = *s_processor_ready_queues[processor];
+    if (thread.times_scheduled() > 0 && thread.cpu() != processor)
+        ready_queues.did_migrate();
+    ready_queues.enqueue(thread, priority, processor);
 }
 
 UNMAP_AFTER_INIT void Scheduler::start()
@@ -374,6 +527,9 @@ UNMAP_AFTER_INIT void Scheduler::initialize()
     VERIFY(Processor::is_initialized()); // sanity check
     VERIFY(TimeManagement::is_initialized());
 
+    // The bootstrap processor needs its ready queues before the first threads are created.
+    initialize_ready_queues_for_current_processor();
+
     g_finalizer_wait_queue = new WaitQueue;
 
     g_finalizer_has_work.store(false, AK::MemoryOrder::memory_order_release);
@@ -387,6 +543,8 @@ UNMAP_AFTER_INIT void Scheduler::initialize()
 
 UNMAP_AFTER_INIT void Scheduler::set_idle_thread(Thread* idle_thread)
 {
+    if (!Processor::is_bootstrap_processor())
+        initialize_ready_queues_for_current_processor();
     idle_thread->set_idle_thread();
     Processor::current().set_idle_thread(*idle_thread);
     Processor::set_current_thread(*idle_thread);
@@ -508,6 +666,23 @@ TotalTimeScheduled Scheduler::get_total_time_scheduled()
     return g_total_time_scheduled.with([&](auto& total_time_scheduled) { return total_time_scheduled; });
 }
 
+ErrorOr<void> Scheduler::try_for_each_processor_statistics(Function<ErrorOr<void>(ProcessorSchedulerStatistics const&)> callback)
+{
+    auto online_mask = s_online_processors_mask.load(AK::MemoryOrder::memory_order_acquire);
+    for (u32 processor = 0; processor < max_scheduled_processors; ++processor) {
+        if (!(online_mask & (1u << processor)))
+            continue;
+        auto const& ready_queues = *s_processor_ready_queues[processor];
+        TRY(callback({
+            .processor = processor,
+            .queue_depth = ready_queues.depth(),
+            .steals = ready_queues.steals(),
+            .migrations = ready_queues.migrations(),
+        }));
+    }
+    return {};
+}
+
 void dump_thread_list(bool with_stack_traces)
 {
     dbgln("Scheduler thread list for processor {}:", Processor::current_id());
@@ -29,6 +29,13 @@ struct TotalTimeScheduled {
     u64 total_kernel { 0 };
 };
 
+struct ProcessorSchedulerStatistics {
+    u32 processor { 0 };
+    u32 queue_depth { 0 };
+    u64 steals { 0 };
+    u64 migrations { 0 };
+};
+
 class Scheduler {
 public:
     static void initialize();
@@ -55,6 +62,7 @@ public:
     static bool is_initialized();
     static TotalTimeScheduled get_total_time_scheduled();
     static void add_time_scheduled(u64, bool);
+    static ErrorOr<void> try_for_each_processor_statistics(Function<ErrorOr<void>(ProcessorSchedulerStatistics const&)>);
 };
 
 }
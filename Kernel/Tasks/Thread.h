@@ -64,6 +64,7 @@ class Thread
     friend class Process;
     friend class Scheduler;
     friend struct ThreadReadyQueue;
+    friend class ThreadReadyQueues;
 
 public:
     static Thread* current()
@@ -1094,6 +1095,7 @@ private:
 
     IntrusiveListNode<Thread> m_process_thread_list_node;
     int m_runnable_priority { -1 };
+    u32 m_ready_queue_processor { 0 };
 
     friend class WaitQueue;
 
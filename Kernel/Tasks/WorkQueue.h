@@ -17,6 +17,9 @@ namespace Kernel {
 
 extern WorkQueue* g_io_work;
 extern WorkQueue* g_ata_work;
+// NOTE: Work items in this queue may wait for block device requests, whose
+//       completion is handled in g_io_work, so they must not run there.
+extern WorkQueue* g_readahead_work;
 
 class WorkQueue {
     AK_MAKE_NONCOPYABLE(WorkQueue);
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <ImageDecoder/DecodedImageCache.h>
+#include <LibTest/TestCase.h>
+
+static ImageDecoder::DecodedImageKey make_key(u8 id)
+{
+    ImageDecoder::DecodedImageKey key {};
+    key.encoded_data_digest.data[0] = id;
+    return key;
+}
+
+static ImageDecoder::DecodeResult make_result(Gfx::IntSize size)
+{
+    ImageDecoder::DecodeResult result;
+    result.bitmaps.append(MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, size)));
+    result.durations.append(0);
+    return result;
+}
+
+static constexpr Gfx::IntSize image_size { 100, 100 };
+static constexpr size_t image_memory_usage = 100 * 100 * 4;
+
+TEST_CASE(keeps_images_that_fit)
+{
+    ImageDecoder::DecodedImageCache cache(3 * image_memory_usage);
+    cache.set(make_key(1), make_result(image_size));
+    cache.set(make_key(2), make_result(image_size));
+    EXPECT_EQ(cache.memory_usage(), 2 * image_memory_usage);
+
+    auto result = cache.get(make_key(1));
+    EXPECT(result.has_value());
+    EXPECT_EQ(result->bitmaps.size(), 1u);
+    EXPECT_EQ(result->bitmaps[0].value()->size(), image_size);
+
+    EXPECT(!cache.get(make_key(3)).has_value());
+
+    // The same key with a different ideal size is a different image.
+    auto key = make_key(1);
+    key.ideal_size = Gfx::IntSize { 50, 50 };
+    EXPECT(!cache.get(key).has_value());
+}
+
+TEST_CASE(evicts_least_recently_used_images)
+{
+    ImageDecoder::DecodedImageCache cache(3 * image_memory_usage);
+    cache.set(make_key(1), make_result(image_size));
+    cache.set(make_key(2), make_result(image_size));
+    cache.set(make_key(3), make_result(image_size));
+    EXPECT_EQ(cache.memory_usage(), 3 * image_memory_usage);
+
+    // Looking up the oldest image makes it the most recently used one, so the next one goes first.
+    EXPECT(cache.get(make_key(1)).has_value());
+    cache.set(make_key(4), make_result(image_size));
+    EXPECT_EQ(cache.memory_usage(), 3 * image_memory_usage);
+    EXPECT(!cache.get(make_key(2)).has_value());
+    EXPECT(cache.get(make_key(3)).has_value());
+    EXPECT(cache.get(make_key(1)).has_value());
+    EXPECT(cache.get(make_key(4)).has_value());
+
+    // Making room for a bigger image can take more than one eviction.
+    cache.set(make_key(5), make_result({ 100, 200 }));
+    EXPECT_EQ(cache.memory_usage(), 3 * image_memory_usage);
+    EXPECT(!cache.get(make_key(3)).has_value());
+    EXPECT(!cache.get(make_key(1)).has_value());
+    EXPECT(cache.get(make_key(4)).has_value());
+    EXPECT(cache.get(make_key(5)).has_value());
+}
+
+TEST_CASE(respects_memory_budget)
+{
+    ImageDecoder::DecodedImageCache cache(3 * image_memory_usage);
+    cache.set(make_key(1), make_result(image_size));
+
+    // An image that doesn't fit into the budget by itself isn't cached, and doesn't evict anything.
+    cache.set(make_key(2), make_result({ 1000, 1000 }));
+    EXPECT(!cache.get(make_key(2)).has_value());
+    EXPECT(cache.get(make_key(1)).has_value());
+    EXPECT_EQ(cache.memory_usage(), image_memory_usage);
+
+    // Replacing an image doesn't count it twice.
+    cache.set(make_key(1), make_result(image_size));
+    EXPECT_EQ(cache.memory_usage(), image_memory_usage);
+    cache.set(make_key(1), make_result({ 100, 200 }));
+    EXPECT_EQ(cache.memory_usage(), 2 * image_memory_usage);
+
+    // Images without any bitmaps don't take up any of the budget.
+    cache.set(make_key(3), {});
+    EXPECT(cache.get(make_key(3)).has_value());
+    EXPECT_EQ(cache.memory_usage(), 2 * image_memory_usage);
+}
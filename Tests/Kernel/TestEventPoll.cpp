@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+static void write_byte(int fd)
+{
+    char byte = 0;
+    MUST(Core::System::write(fd, { &byte, 1 }));
+}
+
+static void read_byte(int fd)
+{
+    char byte = 0;
+    EXPECT_EQ(MUST(Core::System::read(fd, { &byte, 1 })), 1u);
+}
+
+static void add_watch(int epoll_fd, int fd, u32 events)
+{
+    epoll_event event { .events = events, .data = { .fd = fd } };
+    MUST(Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event));
+}
+
+static int wait_for_events(int epoll_fd, Span<epoll_event> events)
+{
+    return MUST(Core::System::epoll_wait(epoll_fd, events, 0));
+}
+
+TEST_CASE(level_triggered)
+{
+    auto epoll_fd = MUST(Core::System::epoll_create1(EPOLL_CLOEXEC));
+    auto pipe = MUST(Core::System::pipe2(O_CLOEXEC));
+    add_watch(epoll_fd, pipe[0], EPOLLIN);
+
+    Array<epoll_event, 4> events;
+    EXPECT_EQ(wait_for_events(epoll_fd, events), 0);
+
+    write_byte(pipe[1]);
+    EXPECT_EQ(wait_for_events(epoll_fd, events), 1);
+    EXPECT_EQ(events[0].data.fd, pipe[0]);
+    EXPECT_EQ(events[0].events, EPOLLIN);
+
+    // Stays ready until the data is consumed.
+    EXPECT_EQ(wait_for_events(epoll_fd, events), 1);
+    read_byte(pipe[0]);
+    EXPECT_EQ(wait_for_events(epoll_fd, events), 0);
+
+    MUST(Core::System::close(pipe[0]));
+    MUST(Core::System::close(pipe[1]));
+    MUST(Core::System::close(epoll_fd));
+}
+
+TEST_CASE(edge_triggered)
+{
+    auto epoll_fd = MUST(Core::System::epoll_create1(EPOLL_CLOEXEC));
+    auto pipe = MUST(Core::System::pipe2(O_CLOEXEC));
+    add_watch(epoll_fd, pipe[0], EPOLLIN | EPOLLET);
+
+    Array<epoll_event, 4> events;
+    write_byte(pipe[1]);
+    EXPECT_EQ(wait_for_events(epoll_fd, events), 1);
+
+    // Only reported again once new data arrives.
+    EXPECT_EQ(wait_for_events(epoll_fd, events), 0);
+    write_byte(pipe[1]);
+    EXPECT_EQ(wait_for_events(epoll_fd, events), 1);
+
+    MUST(Core::System::close(pipe[0]));
+    MUST(Core::System::close(pipe[1]));
+    MUST(Core::System::close(epoll_fd));
+}
+
+TEST_CASE(one_shot)
+{
+    auto epoll_fd = MUST(Core::System::epoll_create1(EPOLL_CLOEXEC));
+    auto pipe = MUST(Core::System::pipe2(O_CLOEXEC));
+    add_watch(epoll_fd, pipe[0], EPOLLIN | EPOLLONESHOT);
+
+    Array<epoll_event, 4> events;
+    write_byte(pipe[1]);
+    EXPECT_EQ(wait_for_events(epoll_fd, events), 1);
+    write_byte(pipe[1]);
+    EXPECT_EQ(wait_for_events(epoll_fd, events), 0);
+
+    // Re-arming it reports the data that is still there.
+    epoll_event event { .events = EPOLLIN | EPOLLONESHOT, .data = { .fd = pipe[0] } };
+    MUST(Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, pipe[0], &event));
+    EXPECT_EQ(wait_for_events(epoll_fd, events), 1);
+
+    MUST(Core::System::close(pipe[0]));
+    MUST(Core::System::close(pipe[1]));
+    MUST(Core::System::close(epoll_fd));
+}
+
+TEST_CASE(control_errors)
+{
+    auto epoll_fd = MUST(Core::System::epoll_create1(EPOLL_CLOEXEC));
+    auto pipe = MUST(Core::System::pipe2(O_CLOEXEC));
+    add_watch(epoll_fd, pipe[0], EPOLLIN);
+
+    epoll_event event { .events = EPOLLIN, .data = { .fd = pipe[0] } };
+    auto result = Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pipe[0], &event);
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), EEXIST);
+
+    result = Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, pipe[1], &event);
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), ENOENT);
+
+    result = Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, epoll_fd, &event);
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), EINVAL);
+
+    MUST(Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, pipe[0], nullptr));
+    write_byte(pipe[1]);
+    Array<epoll_event, 4> events;
+    EXPECT_EQ(wait_for_events(epoll_fd, events), 0);
+
+    MUST(Core::System::close(pipe[0]));
+    MUST(Core::System::close(pipe[1]));
+    MUST(Core::System::close(epoll_fd));
+}
+
+TEST_CASE(closing_the_watched_fd_removes_the_watch)
+{
+    auto epoll_fd = MUST(Core::System::epoll_create1(EPOLL_CLOEXEC));
+    auto pipe = MUST(Core::System::pipe2(O_CLOEXEC));
+    add_watch(epoll_fd, pipe[0], EPOLLIN);
+
+    write_byte(pipe[1]);
+    MUST(Core::System::close(pipe[0]));
+
+    Array<epoll_event, 4> events;
+    EXPECT_EQ(wait_for_events(epoll_fd, events), 0);
+
+    MUST(Core::System::close(pipe[1]));
+    MUST(Core::System::close(epoll_fd));
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static int create_temporary_file(StringView contents)
+{
+    char pattern[] = "/tmp/splice.XXXXXX";
+    auto fd = MUST(Core::System::mkstemp(pattern));
+    MUST(Core::System::unlink({ pattern, sizeof(pattern) - 1 }));
+    EXPECT_EQ(MUST(Core::System::write(fd, contents.bytes())), static_cast<ssize_t>(contents.length()));
+    return fd;
+}
+
+TEST_CASE(splice_pipe_to_file)
+{
+    auto pipefds = MUST(Core::System::pipe2(0));
+    auto fd = create_temporary_file(""sv);
+    EXPECT_EQ(MUST(Core::System::write(pipefds[1], "hello friends"sv.bytes())), 13);
+
+    EXPECT_EQ(splice(pipefds[0], nullptr, fd, nullptr, 5, 0), 5);
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), 5);
+
+    off_t offset_out = 10;
+    EXPECT_EQ(splice(pipefds[0], nullptr, fd, &offset_out, 100, SPLICE_F_NONBLOCK), 8);
+    EXPECT_EQ(offset_out, 18);
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), 5);
+
+    char buffer[18] {};
+    EXPECT_EQ(pread(fd, buffer, sizeof(buffer), 0), 18);
+    EXPECT_EQ(StringView(buffer, 5), "hello"sv);
+    EXPECT_EQ(StringView(buffer + 10, 8), " friends"sv);
+
+    // Splicing is only allowed from a pipe without an input offset.
+    off_t offset_in = 0;
+    EXPECT_EQ(splice(pipefds[0], &offset_in, fd, nullptr, 1, 0), -1);
+    EXPECT_EQ(errno, ESPIPE);
+
+    MUST(Core::System::close(fd));
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
+
+TEST_CASE(splice_file_to_pipe)
+{
+    auto pipefds = MUST(Core::System::pipe2(0));
+    auto fd = create_temporary_file("hello friends"sv);
+    MUST(Core::System::lseek(fd, 0, SEEK_SET));
+
+    EXPECT_EQ(splice(fd, nullptr, pipefds[1], nullptr, 5, 0), 5);
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), 5);
+
+    // An explicit input offset is advanced instead of the file offset.
+    off_t offset_in = 6;
+    EXPECT_EQ(splice(fd, &offset_in, pipefds[1], nullptr, 100, 0), 7);
+    EXPECT_EQ(offset_in, 13);
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), 5);
+
+    // Nothing is left at the end of the file.
+    EXPECT_EQ(splice(fd, &offset_in, pipefds[1], nullptr, 100, 0), 0);
+
+    char buffer[12] {};
+    EXPECT_EQ(read(pipefds[0], buffer, sizeof(buffer)), 12);
+    EXPECT_EQ(StringView(buffer, 12), "hellofriends"sv);
+
+    MUST(Core::System::close(fd));
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
+
+TEST_CASE(splice_offset_at_limit)
+{
+    auto pipefds = MUST(Core::System::pipe2(0));
+    auto fd = create_temporary_file("hello friends"sv);
+    auto max_offset = NumericLimits<off_t>::max();
+
+    // Reading at the largest offset can't move the offset any further, so there is nothing to read.
+    off_t offset_in = max_offset;
+    EXPECT_EQ(splice(fd, &offset_in, pipefds[1], nullptr, 100, 0), 0);
+    EXPECT_EQ(offset_in, max_offset);
+
+    offset_in = max_offset - 2;
+    EXPECT_EQ(splice(fd, &offset_in, pipefds[1], nullptr, NumericLimits<ssize_t>::max(), 0), 0);
+    EXPECT_EQ(offset_in, max_offset - 2);
+
+    // Writing at the largest offset would make the file too large.
+    EXPECT_EQ(MUST(Core::System::write(pipefds[1], "hello"sv.bytes())), 5);
+    off_t offset_out = max_offset;
+    EXPECT_EQ(splice(pipefds[0], nullptr, fd, &offset_out, 5, 0), -1);
+    EXPECT_EQ(errno, EFBIG);
+    EXPECT_EQ(offset_out, max_offset);
+
+    // The data that couldn't be written is still in the pipe.
+    char buffer[5] {};
+    EXPECT_EQ(read(pipefds[0], buffer, sizeof(buffer)), 5);
+    EXPECT_EQ(StringView(buffer, 5), "hello"sv);
+
+    MUST(Core::System::close(fd));
+    MUST(Core::System::close(pipefds[0]));
+    MUST(Core::System::close(pipefds[1]));
+}
@@ -7,10 +7,13 @@
 #include <AK/JsonArray.h>
 #include <LibCore/File.h>
 #include <LibTest/TestCase.h>
+#include <errno.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <pthread.h>
 #include <semaphore.h>
 #include <sys/socket.h>
+#include <unistd.h>
 
 static constexpr u16 port = 1337;
 
@@ -141,6 +144,111 @@ TEST_CASE(tcp_bind_connect)
     }
 }
 
+// Sends a bare ACK with the given options to the given port, as if it came from from_port.
+static void send_ack_with_options(u16 from_port, u16 to_port, ReadonlyBytes options)
+{
+    VERIFY(options.size() % sizeof(u32) == 0 && options.size() <= 40);
+
+    int fd = socket(AF_INET, SOCK_RAW, IPPROTO_TCP);
+    EXPECT(fd >= 0);
+
+    u8 segment[60] {};
+    size_t header_size = 20 + options.size();
+    segment[0] = from_port >> 8;
+    segment[1] = from_port & 0xff;
+    segment[2] = to_port >> 8;
+    segment[3] = to_port & 0xff;
+    segment[12] = (header_size / sizeof(u32)) << 4;
+    segment[13] = 0x10; // ACK
+    segment[14] = 0xff;
+    segment[15] = 0xff;
+    memcpy(segment + 20, options.data(), options.size());
+
+    sockaddr_in dst {};
+    dst.sin_family = AF_INET;
+    dst.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    auto nwritten = sendto(fd, segment, header_size, 0, (sockaddr*)(&dst), sizeof(dst));
+    EXPECT_EQ(nwritten, static_cast<ssize_t>(header_size));
+
+    int rc = close(fd);
+    EXPECT_EQ(rc, 0);
+}
+
+TEST_CASE(tcp_malformed_sack_option)
+{
+    if (geteuid() != 0) {
+        warnln("Skipping, sending raw TCP segments requires root");
+        return;
+    }
+
+    pthread_t server = start_tcp_server();
+
+    int client_fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT(client_fd >= 0);
+
+    sockaddr_in sin {};
+    sin.sin_family = AF_INET;
+    sin.sin_port = htons(port);
+    sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int rc = connect(client_fd, (sockaddr*)(&sin), sizeof(sin));
+    EXPECT_EQ(rc, 0);
+
+    sockaddr_in client_address {};
+    socklen_t client_address_length = sizeof(client_address);
+    rc = getsockname(client_fd, (sockaddr*)(&client_address), &client_address_length);
+    EXPECT_EQ(rc, 0);
+    u16 client_port = ntohs(client_address.sin_port);
+
+    // A SACK option that claims four blocks, but runs past the end of the TCP header.
+    u8 const overrunning_option[] = { 5, 34, 0, 0 };
+    // A SACK option whose length isn't a whole number of blocks.
+    u8 const partial_block_option[] = { 5, 9, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0 };
+    // A SACK option without any blocks.
+    u8 const empty_option[] = { 5, 2, 1, 0 };
+    for (ReadonlyBytes options : { ReadonlyBytes { overrunning_option }, ReadonlyBytes { partial_block_option }, ReadonlyBytes { empty_option } }) {
+        send_ack_with_options(client_port, port, options);
+        send_ack_with_options(port, client_port, options);
+    }
+
+    // The bogus segments are out of order and dropped, so the connection keeps working.
+    u8 data = 'A';
+    int nwritten = send(client_fd, &data, sizeof(data), 0);
+    EXPECT_EQ(nwritten, 1);
+
+    rc = close(client_fd);
+    EXPECT_EQ(rc, 0);
+
+    rc = pthread_join(server, nullptr);
+    EXPECT_EQ(rc, 0);
+}
+
+TEST_CASE(tcp_congestion_control_algorithm)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT(fd >= 0);
+
+    char name[TCP_CA_NAME_MAX] {};
+    socklen_t name_length = sizeof(name);
+    int rc = getsockopt(fd, IPPROTO_TCP, TCP_CONGESTION, name, &name_length);
+    EXPECT_EQ(rc, 0);
+    EXPECT_EQ(StringView(name, strlen(name)), "cubic"sv);
+
+    rc = setsockopt(fd, IPPROTO_TCP, TCP_CONGESTION, "newreno", strlen("newreno"));
+    EXPECT_EQ(rc, 0);
+
+    name_length = sizeof(name);
+    rc = getsockopt(fd, IPPROTO_TCP, TCP_CONGESTION, name, &name_length);
+    EXPECT_EQ(rc, 0);
+    EXPECT_EQ(StringView(name, strlen(name)), "newreno"sv);
+
+    rc = setsockopt(fd, IPPROTO_TCP, TCP_CONGESTION, "vegas", strlen("vegas"));
+    EXPECT_EQ(rc, -1);
+    EXPECT_EQ(errno, ENOENT);
+
+    rc = close(fd);
+    EXPECT_EQ(rc, 0);
+}
+
 TEST_CASE(socket_connect_after_bind)
 {
     unlink("/tmp/tmp-client.test");
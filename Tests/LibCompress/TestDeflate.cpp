@@ -11,6 +11,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/Random.h>
 #include <LibCompress/Deflate.h>
+#include <LibCompress/ParallelDeflate.h>
 #include <LibCore/File.h>
 #include <cstring>
 
@@ -156,6 +157,77 @@ TEST_CASE(deflate_round_trip_compress_large)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(deflate_round_trip_compress_history)
+{
+    // The second block repeats the first one, so it can only be compressed well by referring back across the block boundary
+    auto size = Compress::DeflateCompressor::block_size * 2;
+    auto original = ByteBuffer::create_uninitialized(size).release_value();
+    fill_with_random(original.bytes().trim(size / 2));
+    original.bytes().trim(size / 2).copy_to(original.bytes().slice(size / 2));
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::DeflateCompressor::CompressionLevel::FAST));
+    EXPECT(compressed.size() < size * 3 / 4);
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
+TEST_CASE(deflate_sync_flush)
+{
+    auto const first_part = "Hello there, hello there"sv;
+    auto const second_part = ", hello there!"sv;
+
+    AllocatingMemoryStream output_stream;
+    auto deflate_stream = TRY_OR_FAIL(Compress::DeflateCompressor::construct(MaybeOwned<Stream>(output_stream)));
+    TRY_OR_FAIL(deflate_stream->write_until_depleted(first_part.bytes()));
+    TRY_OR_FAIL(deflate_stream->sync_flush());
+
+    // A sync flush ends in the length fields of an empty stored block
+    auto flushed = TRY_OR_FAIL(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
+    TRY_OR_FAIL(output_stream.read_until_filled(flushed));
+    EXPECT(flushed.bytes().slice(flushed.size() - 4) == (Array<u8, 4> { 0x00, 0x00, 0xff, 0xff }).span());
+
+    TRY_OR_FAIL(deflate_stream->write_until_depleted(second_part.bytes()));
+    TRY_OR_FAIL(deflate_stream->final_flush());
+    auto rest = TRY_OR_FAIL(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
+    TRY_OR_FAIL(output_stream.read_until_filled(rest));
+
+    auto compressed = TRY_OR_FAIL(ByteBuffer::copy(flushed));
+    TRY_OR_FAIL(compressed.try_append(rest));
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT_EQ(StringView { uncompressed.bytes() }, "Hello there, hello there, hello there!"sv);
+}
+
+TEST_CASE(deflate_round_trip_parallel)
+{
+    // Use small chunks, so that there are plenty of them.
+    size_t const chunk_size = 16 * KiB;
+    auto compressor = TRY_OR_FAIL(Compress::ParallelDeflateCompressor::create(4, Compress::DeflateCompressor::CompressionLevel::GOOD, chunk_size));
+
+    // Every chunk after the first repeats it, which only compresses well if chunks can refer back into the chunks before them.
+    auto original = ByteBuffer::create_uninitialized(16 * chunk_size + 1000).release_value();
+    fill_with_random(original.bytes().trim(chunk_size));
+    for (size_t offset = chunk_size; offset < original.size(); offset += chunk_size)
+        original.bytes().trim(chunk_size).copy_trimmed_to(original.bytes().slice(offset));
+
+    auto compressed = TRY_OR_FAIL(compressor->compress_all(original));
+    EXPECT(compressed.size() < 2 * chunk_size);
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+
+    // The same compressor can be used again.
+    fill_with_random(original);
+    compressed = TRY_OR_FAIL(compressor->compress_all(original));
+    uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
+TEST_CASE(deflate_round_trip_parallel_empty)
+{
+    auto compressor = TRY_OR_FAIL(Compress::ParallelDeflateCompressor::create(2));
+    auto compressed = TRY_OR_FAIL(compressor->compress_all({}));
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed.is_empty());
+}
+
 TEST_CASE(deflate_compress_literals)
 {
     // This byte array is known to not produce any back references with our lz77 implementation even at the highest compression settings
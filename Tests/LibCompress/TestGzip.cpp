@@ -9,6 +9,7 @@
 #include <AK/Array.h>
 #include <AK/Random.h>
 #include <LibCompress/Gzip.h>
+#include <LibCompress/ParallelDeflate.h>
 
 TEST_CASE(gzip_decompress_simple)
 {
@@ -94,6 +95,16 @@ TEST_CASE(gzip_round_trip)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(gzip_round_trip_parallel)
+{
+    auto compressor = TRY_OR_FAIL(Compress::ParallelDeflateCompressor::create(4));
+    auto original = ByteBuffer::create_zeroed(5 * Compress::ParallelDeflateCompressor::default_chunk_size / 2).release_value();
+    fill_with_random(original.bytes().trim(original.size() / 2));
+    auto compressed = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(original, compressor.ptr()));
+    auto uncompressed = TRY_OR_FAIL(Compress::GzipDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
 TEST_CASE(gzip_truncated_uncompressed_block)
 {
     Array<u8, 38> const compressed {
@@ -8,6 +8,8 @@
 
 #include <AK/Array.h>
 #include <AK/MemoryStream.h>
+#include <AK/Random.h>
+#include <LibCompress/ParallelDeflate.h>
 #include <LibCompress/Zlib.h>
 
 TEST_CASE(zlib_decompress_simple)
@@ -46,6 +48,19 @@ TEST_CASE(zlib_compress_simple)
     EXPECT(freshly_pressed.value().bytes() == compressed.span());
 }
 
+TEST_CASE(zlib_round_trip_parallel)
+{
+    auto compressor = TRY_OR_FAIL(Compress::ParallelDeflateCompressor::create(4));
+    auto original = ByteBuffer::create_zeroed(5 * Compress::ParallelDeflateCompressor::default_chunk_size / 2).release_value();
+    fill_with_random(original.bytes().trim(original.size() / 2));
+    auto compressed = TRY_OR_FAIL(Compress::ZlibCompressor::compress_all(original, *compressor));
+
+    auto stream = make<FixedMemoryStream>(compressed.bytes());
+    auto decompressor = TRY_OR_FAIL(Compress::ZlibDecompressor::create(move(stream)));
+    auto uncompressed = TRY_OR_FAIL(decompressor->read_until_eof());
+    EXPECT(uncompressed == original);
+}
+
 TEST_CASE(zlib_decompress_with_missing_end_bits)
 {
     // This test case has been extracted from compressed PNG data of `/res/icons/16x16/app-masterword.png`.
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <LibCrypto/Checksum/Adler32.h>
+#include <LibCrypto/Checksum/CRC32.h>
+#include <LibTest/TestCase.h>
+
+static constexpr size_t input_size = 64 * MiB;
+
+static ByteBuffer make_input()
+{
+    auto buffer = MUST(ByteBuffer::create_uninitialized(input_size));
+    for (size_t i = 0; i < buffer.size(); ++i)
+        buffer[i] = static_cast<u8>(i * 37 + (i >> 11));
+    return buffer;
+}
+
+BENCHMARK_CASE(adler32)
+{
+    auto input = make_input();
+    for (size_t i = 0; i < 10; ++i) {
+        auto digest = Crypto::Checksum::Adler32(input).digest();
+        AK::taint_for_optimizer(digest);
+    }
+}
+
+BENCHMARK_CASE(adler32_small_updates)
+{
+    auto input = make_input();
+    Crypto::Checksum::Adler32 adler32;
+    for (size_t offset = 0; offset < input.size(); offset += 100)
+        adler32.update(input.bytes().slice(offset, min(100uz, input.size() - offset)));
+    auto digest = adler32.digest();
+    AK::taint_for_optimizer(digest);
+}
+
+BENCHMARK_CASE(crc32)
+{
+    auto input = make_input();
+    for (size_t i = 0; i < 10; ++i) {
+        auto digest = Crypto::Checksum::CRC32(input).digest();
+        AK::taint_for_optimizer(digest);
+    }
+}
+
+BENCHMARK_CASE(crc32_small_updates)
+{
+    auto input = make_input();
+    Crypto::Checksum::CRC32 crc32;
+    for (size_t offset = 0; offset < input.size(); offset += 100)
+        crc32.update(input.bytes().slice(offset, min(100uz, input.size() - offset)));
+    auto digest = crc32.digest();
+    AK::taint_for_optimizer(digest);
+}
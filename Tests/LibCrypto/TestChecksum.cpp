@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <LibCrypto/Checksum/Adler32.h>
 #include <LibCrypto/Checksum/CRC32.h>
 #include <LibCrypto/Checksum/cksum.h>
@@ -63,3 +64,91 @@ TEST_CASE(test_crc32)
     do_test("The quick brown fox jumps over the lazy dog"sv.bytes(), 0x414FA339);
     do_test("various CRC algorithms input data"sv.bytes(), 0x9BD366AE);
 }
+
+// The accelerated implementations only kick in for longer inputs, so compare them against straightforward
+// implementations for inputs of all sizes around their block boundaries, starting at every alignment.
+static ByteBuffer make_test_input(size_t size)
+{
+    auto buffer = MUST(ByteBuffer::create_uninitialized(size));
+    u32 state = 0x12345678;
+    for (auto& byte : buffer.bytes()) {
+        state = state * 1103515245 + 12345;
+        byte = state >> 24;
+    }
+    return buffer;
+}
+
+static u32 reference_adler32(ReadonlyBytes input)
+{
+    u32 a = 1;
+    u32 b = 0;
+    for (auto byte : input) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+static u32 reference_crc32(ReadonlyBytes input)
+{
+    u32 crc = ~0u;
+    for (auto byte : input) {
+        crc ^= byte;
+        for (size_t i = 0; i < 8; ++i)
+            crc = (crc >> 1) ^ ((crc & 1) * 0xEDB88320);
+    }
+    return ~crc;
+}
+
+TEST_CASE(test_adler32_matches_reference)
+{
+    auto input = make_test_input(20000);
+
+    for (size_t offset = 0; offset < 16; ++offset) {
+        for (size_t size = 0; size < 300; ++size) {
+            auto bytes = input.bytes().slice(offset, size);
+            EXPECT_EQ(Crypto::Checksum::Adler32(bytes).digest(), reference_adler32(bytes));
+        }
+        for (size_t size : Array<size_t, 6> { 5551, 5552, 5553, 11104, 11105, 19984 }) {
+            auto bytes = input.bytes().slice(offset, size);
+            EXPECT_EQ(Crypto::Checksum::Adler32(bytes).digest(), reference_adler32(bytes));
+        }
+    }
+
+    // The worst case for overflows.
+    auto all_ones = MUST(ByteBuffer::create_uninitialized(20000));
+    all_ones.bytes().fill(0xff);
+    EXPECT_EQ(Crypto::Checksum::Adler32(all_ones).digest(), reference_adler32(all_ones));
+}
+
+TEST_CASE(test_crc32_matches_reference)
+{
+    auto input = make_test_input(5000);
+
+    for (size_t offset = 0; offset < 16; ++offset) {
+        for (size_t size = 0; size < 300; ++size) {
+            auto bytes = input.bytes().slice(offset, size);
+            EXPECT_EQ(Crypto::Checksum::CRC32(bytes).digest(), reference_crc32(bytes));
+        }
+        auto bytes = input.bytes().slice(offset, 4096 + offset);
+        EXPECT_EQ(Crypto::Checksum::CRC32(bytes).digest(), reference_crc32(bytes));
+    }
+}
+
+TEST_CASE(test_checksums_in_pieces)
+{
+    auto input = make_test_input(10000);
+
+    Crypto::Checksum::Adler32 adler32;
+    Crypto::Checksum::CRC32 crc32;
+    size_t offset = 0;
+    for (size_t piece_size = 1; offset < input.size(); piece_size = piece_size * 3 + 1) {
+        auto piece = input.bytes().slice(offset, min(piece_size, input.size() - offset));
+        adler32.update(piece);
+        crc32.update(piece);
+        offset += piece.size();
+    }
+
+    EXPECT_EQ(adler32.digest(), reference_adler32(input));
+    EXPECT_EQ(crc32.digest(), reference_crc32(input));
+}
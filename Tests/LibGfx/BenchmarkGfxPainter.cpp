@@ -52,3 +52,47 @@ BENCHMARK_CASE(fill_with_gradient)
         painter.fill_rect_with_gradient(bitmap->rect(), Color::Blue, Color::Red);
     }
 }
+
+BENCHMARK_CASE(fill_with_alpha)
+{
+    int const run_count = 100;
+    int const bitmap_size = 2000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { bitmap_size, bitmap_size }));
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.fill_rect(bitmap->rect(), Color(0, 0, 255, 128));
+    }
+}
+
+BENCHMARK_CASE(blit_with_opacity)
+{
+    int const run_count = 100;
+    int const bitmap_size = 2000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }));
+    auto source = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { bitmap_size, bitmap_size }));
+    source->fill(Color(255, 0, 0, 200));
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.blit({ 0, 0 }, source, source->rect(), 0.5f);
+    }
+}
+
+BENCHMARK_CASE(draw_scaled_bitmap_bilinear)
+{
+    int const run_count = 20;
+    int const bitmap_size = 2000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { bitmap_size, bitmap_size }));
+    auto source = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { bitmap_size / 3, bitmap_size / 3 }));
+    Gfx::Painter source_painter(source);
+    source_painter.fill_rect_with_gradient(source->rect(), Color::Blue, Color(255, 0, 0, 100));
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.draw_scaled_bitmap(bitmap->rect(), source, source->rect(), 1.0f, Gfx::Painter::ScalingMode::BilinearBlend);
+    }
+}
@@ -18,6 +18,7 @@ auto small_image = Core::File::open(TEST_INPUT("jpg/rgb24.jpg"sv), Core::File::O
 auto big_image = Core::File::open(TEST_INPUT("jpg/big_image.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
 auto rgb_image = Core::File::open(TEST_INPUT("jpg/rgb_components.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
 auto several_scans = Core::File::open(TEST_INPUT("jpg/several_scans.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
+auto restart_intervals = Core::File::open(TEST_INPUT("jpg/odd-restart.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value();
 
 BENCHMARK_CASE(small_image)
 {
@@ -42,3 +43,15 @@ BENCHMARK_CASE(several_scans)
     auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create(several_scans));
     MUST(plugin_decoder->frame(0));
 }
+
+BENCHMARK_CASE(restart_intervals_on_one_thread)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create_with_options(restart_intervals, { .decoding_thread_count = 1 }));
+    MUST(plugin_decoder->frame(0));
+}
+
+BENCHMARK_CASE(restart_intervals_on_four_threads)
+{
+    auto plugin_decoder = MUST(Gfx::JPEGImageDecoderPlugin::create_with_options(restart_intervals, { .decoding_thread_count = 4 }));
+    MUST(plugin_decoder->frame(0));
+}
@@ -7,7 +7,9 @@
 #include <AK/FixedArray.h>
 #include <LibCore/File.h>
 #include <LibGfx/ImageFormats/JPEGLoader.h>
+#include <LibGfx/ImageFormats/PNGLoader.h>
 #include <LibGfx/ImageFormats/PNGShared.h>
+#include <LibGfx/ImageFormats/PNGWriter.h>
 #include <LibTest/TestCase.h>
 
 #ifdef AK_OS_SERENITY
@@ -17,6 +19,7 @@
 #endif
 
 auto bitmap = Gfx::JPEGImageDecoderPlugin::create(Core::File::open(TEST_INPUT("jpg/big_image.jpg"sv), Core::File::OpenMode::Read).release_value()->read_until_eof().release_value()).release_value()->frame(0).release_value().image;
+auto png_image = Gfx::PNGWriter::encode(*bitmap).release_value();
 
 BENCHMARK_CASE(paeth)
 {
@@ -47,3 +50,49 @@ BENCHMARK_CASE(paeth)
         scanline_minus_1 = scanline;
     }
 }
+
+BENCHMARK_CASE(decode)
+{
+    auto plugin_decoder = MUST(Gfx::PNGImageDecoderPlugin::create(png_image));
+    MUST(plugin_decoder->frame(0));
+}
+
+// Treats the pixels of the bitmap as filtered scanlines with the given number of bytes per pixel, and unfilters them.
+static void unfilter_bitmap(Gfx::PNG::FilterType filter, u8 bytes_per_complete_pixel)
+{
+    size_t row_size = bitmap->width() * bytes_per_complete_pixel;
+    auto data = MUST(ByteBuffer::copy(bitmap->scanline_u8(0), row_size * bitmap->height()));
+    auto previous_scanline = MUST(ByteBuffer::create_zeroed(row_size));
+
+    ReadonlyBytes previous_scanline_data = previous_scanline;
+    for (int y = 0; y < bitmap->height(); ++y) {
+        auto scanline_data = data.bytes().slice(y * row_size, row_size);
+        Gfx::PNGImageDecoderPlugin::unfilter_scanline(filter, scanline_data, previous_scanline_data, bytes_per_complete_pixel);
+        previous_scanline_data = scanline_data;
+    }
+}
+
+BENCHMARK_CASE(unfilter_sub_rgb)
+{
+    unfilter_bitmap(Gfx::PNG::FilterType::Sub, 3);
+}
+
+BENCHMARK_CASE(unfilter_up_rgba)
+{
+    unfilter_bitmap(Gfx::PNG::FilterType::Up, 4);
+}
+
+BENCHMARK_CASE(unfilter_average_rgba)
+{
+    unfilter_bitmap(Gfx::PNG::FilterType::Average, 4);
+}
+
+BENCHMARK_CASE(unfilter_paeth_rgb)
+{
+    unfilter_bitmap(Gfx::PNG::FilterType::Paeth, 3);
+}
+
+BENCHMARK_CASE(unfilter_paeth_rgba)
+{
+    unfilter_bitmap(Gfx::PNG::FilterType::Paeth, 4);
+}
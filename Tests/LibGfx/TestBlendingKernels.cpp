@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Random.h>
+#include <AK/Vector.h>
+#include <LibGfx/BlendingKernels.h>
+
+// Enough pixels for the vector loops, plus a few for the scalar tails.
+static constexpr Array pixel_counts { 1, 3, 4, 7, 8, 15, 16, 33, 100 };
+
+static Gfx::ARGB32 random_pixel()
+{
+    // Fully transparent and fully opaque pixels take different paths, so make sure there are plenty of them.
+    static constexpr Array interesting_alphas { 0u, 1u, 128u, 254u, 255u };
+    auto pixel = get_random<Gfx::ARGB32>();
+    if (get_random_uniform(2) == 0)
+        pixel = (pixel & 0xffffff) | (interesting_alphas[get_random_uniform(interesting_alphas.size())] << 24);
+    return pixel;
+}
+
+static Vector<Gfx::ARGB32> random_pixels(size_t count)
+{
+    Vector<Gfx::ARGB32> pixels;
+    for (size_t i = 0; i < count; ++i)
+        pixels.append(random_pixel());
+    return pixels;
+}
+
+TEST_CASE(blend_color_over_pixels_matches_color_blend)
+{
+    for (auto count : pixel_counts) {
+        for (int round = 0; round < 200; ++round) {
+            auto color = Color::from_argb(random_pixel());
+            bool pixels_have_alpha = round % 2 == 0;
+            auto pixels = random_pixels(count);
+            auto expected = pixels;
+
+            Gfx::blend_color_over_pixels(pixels.data(), count, color, pixels_have_alpha);
+            for (auto& pixel : expected)
+                pixel = (pixels_have_alpha ? Color::from_argb(pixel) : Color::from_rgb(pixel)).blend(color).value();
+
+            EXPECT_EQ(pixels, expected);
+        }
+    }
+}
+
+TEST_CASE(blend_pixels_with_opacity_matches_color_blend)
+{
+    static constexpr Array opacities { 0.0f, 0.25f, 0.5f, 0.73f, 1.0f };
+
+    for (auto count : pixel_counts) {
+        for (int round = 0; round < 200; ++round) {
+            Gfx::OpacityBlend options {
+                .opacity = opacities[round % opacities.size()],
+                .source_has_alpha = (round & 1) != 0,
+                .source_is_rgba = (round & 2) != 0,
+                .destination_has_alpha = (round & 4) != 0,
+            };
+            auto source = random_pixels(count);
+            auto destination = random_pixels(count);
+            auto expected = destination;
+
+            Gfx::blend_pixels_with_opacity(destination.data(), source.data(), count, options);
+            for (size_t i = 0; i < count; ++i) {
+                auto source_pixel = source[i];
+                if (options.source_is_rgba)
+                    source_pixel = (source_pixel & 0xff00ff00) | ((source_pixel & 0xff) << 16) | ((source_pixel >> 16) & 0xff);
+                auto source_color = Color::from_argb(source_pixel);
+                if (options.source_has_alpha) {
+                    float pixel_opacity = source_color.alpha() / 255.0;
+                    source_color.set_alpha(255 * (options.opacity * pixel_opacity));
+                } else {
+                    source_color.set_alpha(options.opacity * 255);
+                }
+                auto destination_color = options.destination_has_alpha ? Color::from_argb(expected[i]) : Color::from_rgb(expected[i]);
+                expected[i] = destination_color.blend(source_color).value();
+            }
+
+            EXPECT_EQ(destination, expected);
+        }
+    }
+}
+
+TEST_CASE(draw_bilinear_samples_matches_color_mixed_with)
+{
+    for (auto count : pixel_counts) {
+        for (int round = 0; round < 200; ++round) {
+            auto top_left = random_pixels(count);
+            auto top_right = random_pixels(count);
+            auto bottom_left = random_pixels(count);
+            auto bottom_right = random_pixels(count);
+            Vector<float> x_ratios;
+            for (size_t i = 0; i < count; ++i)
+                x_ratios.append(get_random_uniform(1025) / 1024.0f);
+            Gfx::BilinearSamples samples {
+                .top_left = top_left.data(),
+                .top_right = top_right.data(),
+                .bottom_left = bottom_left.data(),
+                .bottom_right = bottom_right.data(),
+                .x_ratios = x_ratios.data(),
+                .y_ratio = get_random_uniform(1025) / 1024.0f,
+            };
+            float opacity = round % 3 == 0 ? 1.0f : get_random_uniform(256) / 255.0f;
+            bool should_blend = round % 2 == 0;
+            auto destination = random_pixels(count);
+            auto expected = destination;
+
+            Gfx::draw_bilinear_samples(destination.data(), samples, count, opacity, should_blend);
+            for (size_t i = 0; i < count; ++i) {
+                auto top = Color::from_argb(top_left[i]).mixed_with(Color::from_argb(top_right[i]), x_ratios[i]);
+                auto bottom = Color::from_argb(bottom_left[i]).mixed_with(Color::from_argb(bottom_right[i]), x_ratios[i]);
+                auto color = top.mixed_with(bottom, samples.y_ratio);
+                color.set_alpha(color.alpha() * opacity);
+                expected[i] = should_blend ? Color::from_argb(expected[i]).blend(color).value() : color.value();
+            }
+
+            // Whether the compiler fuses multiplications and additions depends on the target, so allow the
+            // results to be off by one.
+            for (size_t i = 0; i < count; ++i) {
+                for (auto shift : { 0, 8, 16, 24 }) {
+                    int actual_channel = (destination[i] >> shift) & 0xff;
+                    int expected_channel = (expected[i] >> shift) & 0xff;
+                    EXPECT(abs(actual_channel - expected_channel) <= 1);
+                }
+            }
+        }
+    }
+}
@@ -451,6 +451,20 @@ TEST_CASE(test_odd_mcu_restart_interval)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 102, 77 }));
 }
 
+TEST_CASE(test_restart_intervals_decoded_on_several_threads)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/odd-restart.jpg"sv)));
+    auto reference_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create_with_options(file->bytes(), { .decoding_thread_count = 1 }));
+    auto reference = TRY_OR_FAIL(expect_single_frame_of_size(*reference_decoder, { 102, 77 }));
+
+    // The image has 12 restart intervals, so this also covers threads getting different numbers of them.
+    for (size_t thread_count : { 2, 4, 7, 12, 20 }) {
+        auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create_with_options(file->bytes(), { .decoding_thread_count = thread_count }));
+        auto frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 102, 77 }));
+        EXPECT(frame.image->visually_equals(*reference.image));
+    }
+}
+
 TEST_CASE(test_jpeg_rgb_components)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/rgb_components.jpg"sv)));
@@ -769,6 +783,24 @@ TEST_CASE(test_png)
     TRY_OR_FAIL(expect_single_frame(*plugin_decoder));
 }
 
+TEST_CASE(test_png_adam7)
+{
+    auto reference_file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto reference_plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(reference_file->bytes()));
+    auto reference_frame = TRY_OR_FAIL(expect_single_frame(*reference_plugin_decoder));
+
+    // Same image, but interlaced, using all filter types, and with its image data split over many IDAT chunks.
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie-adam7.png"sv)));
+    EXPECT(Gfx::PNGImageDecoderPlugin::sniff(file->bytes()));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+
+    auto frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, reference_frame.image->size()));
+
+    for (int y = 0; y < frame.image->height(); ++y)
+        for (int x = 0; x < frame.image->width(); ++x)
+            EXPECT_EQ(frame.image->get_pixel(x, y), reference_frame.image->get_pixel(x, y));
+}
+
 TEST_CASE(test_exif)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/exif.png"sv)));
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibIPC/ConnectionFromClient.h>
+#include <LibIPC/ConnectionToServer.h>
+#include <LibIPC/SharedMemoryTransport.h>
+#include <LibTest/TestCase.h>
+#include <TestClientEndpoint.h>
+#include <TestServerEndpoint.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+class TestServerConnection final : public IPC::ConnectionFromClient<TestClientEndpoint, TestServerEndpoint> {
+    C_OBJECT(TestServerConnection);
+
+public:
+    virtual void die() override { Core::EventLoop::current().quit(0); }
+
+private:
+    explicit TestServerConnection(NonnullOwnPtr<Core::LocalSocket> socket)
+        : IPC::ConnectionFromClient<TestClientEndpoint, TestServerEndpoint>(*this, move(socket), 1)
+    {
+    }
+
+    virtual Messages::TestServer::PingResponse ping(u32 value) override { return value + 1; }
+
+    virtual void append(u32 value) override { m_values.append(value); }
+
+    virtual void append_with_file(u32 value, IPC::File const& file) override
+    {
+        if (file.fd() != -1)
+            m_values.append(value);
+    }
+
+    virtual void append_with_padding(u32 value, ByteBuffer const&) override { m_values.append(value); }
+
+    virtual Messages::TestServer::AppendedValuesResponse appended_values() override { return m_values; }
+
+    virtual void request_pong(u32 value) override { async_pong(value); }
+
+    Vector<u32> m_values;
+};
+
+class TestClientConnection final : public IPC::ConnectionToServer<TestClientEndpoint, TestServerEndpoint> {
+    C_OBJECT(TestClientConnection);
+
+public:
+    virtual void die() override { }
+
+    Optional<u32> last_pong() const { return m_last_pong; }
+
+private:
+    explicit TestClientConnection(NonnullOwnPtr<Core::LocalSocket> socket)
+        : IPC::ConnectionToServer<TestClientEndpoint, TestServerEndpoint>(*this, move(socket))
+    {
+    }
+
+    virtual void pong(u32 value) override { m_last_pong = value; }
+
+    Optional<u32> m_last_pong;
+};
+
+// Runs the server in a child process, like a real one would be.
+class ServerProcess {
+public:
+    ServerProcess()
+    {
+        int fds[2];
+        MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+        m_pid = MUST(Core::System::fork());
+        if (m_pid == 0) {
+            MUST(Core::System::close(fds[0]));
+            Core::EventLoop event_loop;
+            auto connection = TestServerConnection::construct(MUST(Core::LocalSocket::adopt_fd(fds[1])));
+            _exit(event_loop.exec());
+        }
+
+        MUST(Core::System::close(fds[1]));
+        auto socket = MUST(Core::LocalSocket::adopt_fd(fds[0]));
+        MUST(socket->set_blocking(true));
+        m_client = TestClientConnection::construct(move(socket));
+    }
+
+    ~ServerProcess()
+    {
+        m_client->shutdown();
+        (void)Core::System::waitpid(m_pid);
+    }
+
+    TestClientConnection& client() { return *m_client; }
+
+private:
+    pid_t m_pid { -1 };
+    RefPtr<TestClientConnection> m_client;
+};
+
+TEST_CASE(shared_memory_transport_is_negotiated)
+{
+    Core::EventLoop event_loop;
+    ServerProcess server;
+    auto& client = server.client();
+
+    EXPECT_EQ(client.ping(1), 2u);
+    EXPECT(!client.is_using_shared_memory_transport());
+
+    MUST(client.request_shared_memory_transport());
+    EXPECT_EQ(client.ping(2), 3u);
+    EXPECT(client.is_using_shared_memory_transport());
+    EXPECT_EQ(client.ping(3), 4u);
+}
+
+static void send_mixed_messages(TestClientConnection& client, u32 first_value, u32 count)
+{
+    auto small_padding = MUST(ByteBuffer::create_zeroed(100));
+    // Too large for the ring, so it goes over the socket.
+    auto large_padding = MUST(ByteBuffer::create_zeroed(IPC::MessageRing::max_message_size + 1));
+
+    for (u32 value = first_value; value < first_value + count; ++value) {
+        switch (value % 5) {
+        case 0:
+        case 1:
+            client.async_append(value);
+            break;
+        case 2:
+            client.async_append_with_file(value, MUST(IPC::File::clone_fd(STDIN_FILENO)));
+            break;
+        case 3:
+            client.async_append_with_padding(value, small_padding);
+            break;
+        case 4:
+            client.async_append_with_padding(value, large_padding);
+            break;
+        }
+    }
+}
+
+static void expect_all_values(Vector<u32> const& values, u32 count)
+{
+    EXPECT_EQ(values.size(), count);
+    for (u32 i = 0; i < min(values.size(), count); ++i)
+        EXPECT_EQ(values[i], i);
+}
+
+TEST_CASE(messages_stay_in_order_over_shared_memory)
+{
+    Core::EventLoop event_loop;
+    ServerProcess server;
+    auto& client = server.client();
+
+    MUST(client.request_shared_memory_transport());
+    // Messages sent before the shared memory is in use must not overtake the ones sent after.
+    send_mixed_messages(client, 0, 10);
+    (void)client.ping(0);
+    EXPECT(client.is_using_shared_memory_transport());
+
+    // Enough messages to fill the ring several times over.
+    send_mixed_messages(client, 10, 2000);
+    expect_all_values(client.appended_values(), 2010);
+}
+
+TEST_CASE(messages_from_server_over_shared_memory)
+{
+    Core::EventLoop event_loop;
+    ServerProcess server;
+    auto& client = server.client();
+
+    MUST(client.request_shared_memory_transport());
+    (void)client.ping(0);
+
+    for (u32 value = 0; value < 100; ++value) {
+        client.async_request_pong(value);
+        // The pong is not a response, so it arrives through the event loop.
+        while (client.last_pong() != value)
+            event_loop.pump();
+    }
+}
+
+static void ping_pong(bool use_shared_memory)
+{
+    Core::EventLoop event_loop;
+    ServerProcess server;
+    auto& client = server.client();
+
+    if (use_shared_memory)
+        MUST(client.request_shared_memory_transport());
+
+    for (u32 value = 0; value < 100'000; ++value)
+        EXPECT_EQ(client.ping(value), value + 1);
+
+    EXPECT_EQ(client.is_using_shared_memory_transport(), use_shared_memory);
+}
+
+BENCHMARK_CASE(ping_pong_over_socket)
+{
+    ping_pong(false);
+}
+
+BENCHMARK_CASE(ping_pong_over_shared_memory)
+{
+    ping_pong(true);
+}
+
+// The other end can keep writing to the ring while we read from it, so what we read must not change under us.
+TEST_CASE(records_are_copied_out_of_the_ring)
+{
+    Vector<u8> memory;
+    memory.resize(IPC::MessageRing::size_in_memory());
+    IPC::MessageRing ring(memory.data());
+    u8* data = memory.data() + IPC::MessageRing::size_in_memory() - IPC::MessageRing::capacity;
+
+    EXPECT(ring.try_write("friends!"sv.bytes()));
+    ByteBuffer scratch;
+    auto record = TRY_OR_FAIL(ring.peek(scratch));
+    EXPECT(record.has_value());
+    EXPECT_EQ(StringView { record->bytes }, "friends!"sv);
+
+    // Rewriting both the message and its size doesn't affect the record we already looked at.
+    __builtin_memcpy(data + sizeof(u32), "enemies!", 8);
+    u32 bogus_size = 4 * KiB;
+    __builtin_memcpy(data, &bogus_size, sizeof(bogus_size));
+    EXPECT_EQ(StringView { record->bytes }, "friends!"sv);
+
+    ring.pop(*record);
+    EXPECT(ring.is_empty());
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <AK/StringUtils.h>
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibTest/TestCase.h>
+#include <stdlib.h>
+
+// Set GC_PAUSE_BENCHMARK_HEAP_MIB to measure with a bigger heap, e.g. 500.
+static size_t live_heap_size()
+{
+    if (auto const* size_in_mib = getenv("GC_PAUSE_BENCHMARK_HEAP_MIB")) {
+        if (auto size = AK::StringUtils::convert_to_uint<size_t>({ size_in_mib, strlen(size_in_mib) }); size.has_value())
+            return size.value() * MiB;
+    }
+    return 64 * MiB;
+}
+
+static void print_statistics(StringView name, JS::Heap::CollectionStatistics const& statistics)
+{
+    if (statistics.collection_count == 0)
+        return;
+    outln("{}: {} pauses, longest {} us, average {} us", name, statistics.collection_count,
+        statistics.longest_pause_time.to_microseconds(),
+        statistics.total_pause_time.to_microseconds() / static_cast<i64>(statistics.collection_count));
+}
+
+// Builds a long-lived graph of objects, then keeps allocating short-lived ones while mutating the
+// graph, so that the heap has to run major collections with a big live heap.
+static void run_gc_pause_benchmark(bool generational_collection, bool incremental_marking)
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+    auto& heap = vm->heap();
+    heap.set_generational_collection_enabled(generational_collection);
+    heap.set_incremental_marking_enabled(incremental_marking);
+
+    // Objects end up taking roughly this much space, counting their property storage.
+    static constexpr size_t approximate_object_size = 128;
+    auto object_count = live_heap_size() / approximate_object_size;
+
+    auto objects = JS::make_handle(MUST(JS::Array::create(realm, 0)));
+    JS::GCPtr<JS::Object> previous;
+    for (size_t i = 0; i < object_count; ++i) {
+        auto object = JS::Object::create(realm, nullptr);
+        object->define_direct_property("index"_fly_string, JS::Value(static_cast<double>(i)), JS::default_attributes);
+        object->define_direct_property("previous"_fly_string, previous, JS::default_attributes);
+        objects->indexed_properties().append(object);
+        previous = object;
+    }
+
+    for (size_t i = 0; i < object_count * 4; ++i) {
+        auto garbage = JS::Object::create(realm, nullptr);
+        garbage->define_direct_property("index"_fly_string, JS::Value(static_cast<double>(i)), JS::default_attributes);
+
+        // Replace some of the old objects, so that old objects keep pointing to young ones.
+        if (i % 64 == 0)
+            objects->indexed_properties().put(i % object_count, garbage);
+    }
+
+    outln("Live heap of about {} MiB, {}, {} marking:", live_heap_size() / MiB,
+        generational_collection ? "generational"sv : "non-generational"sv,
+        incremental_marking ? "incremental"sv : "non-incremental"sv);
+    print_statistics("  Minor collection"sv, heap.minor_collection_statistics());
+    print_statistics("  Major collection"sv, heap.major_collection_statistics());
+    print_statistics("  Incremental marking slice"sv, heap.incremental_marking_statistics());
+}
+
+BENCHMARK_CASE(gc_pauses)
+{
+    run_gc_pause_benchmark(false, false);
+}
+
+BENCHMARK_CASE(gc_pauses_with_generational_collection)
+{
+    run_gc_pause_benchmark(true, false);
+}
+
+BENCHMARK_CASE(gc_pauses_with_incremental_marking)
+{
+    run_gc_pause_benchmark(false, true);
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Runtime/WeakSet.h>
+#include <LibTest/TestCase.h>
+
+static constexpr size_t holder_count = 64 * 1024;
+static constexpr size_t recent_object_count = 128 * 1024;
+
+static void swap_payloads(JS::Object& a, JS::Object& b, JS::PropertyKey const& payload_key)
+{
+    auto payload_of_a = a.get_without_side_effects(payload_key);
+    auto payload_of_b = b.get_without_side_effects(payload_key);
+    a.define_direct_property(payload_key, payload_of_b, JS::default_attributes);
+    b.define_direct_property(payload_key, payload_of_a, JS::default_attributes);
+}
+
+// Payloads keep moving between holders while major collections mark incrementally. Whenever a payload moves
+// from a holder that wasn't scanned yet into one that was, only the write barrier can keep it alive.
+TEST_CASE(incremental_marking_keeps_cells_that_move_between_slices)
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+    auto& heap = vm->heap();
+    heap.set_generational_collection_enabled(true);
+    heap.set_incremental_marking_enabled(true);
+
+    auto payload_key = JS::PropertyKey { "payload"_fly_string };
+    auto index_key = JS::PropertyKey { "index"_fly_string };
+
+    Vector<JS::Handle<JS::Object>> holders;
+    holders.ensure_capacity(holder_count);
+    auto payloads = JS::make_handle(JS::WeakSet::create(realm));
+    for (size_t i = 0; i < holder_count; ++i) {
+        auto payload = JS::Object::create(realm, nullptr);
+        payload->define_direct_property(index_key, JS::Value(static_cast<double>(i)), JS::default_attributes);
+        auto holder = JS::Object::create(realm, nullptr);
+        holder->define_direct_property(payload_key, payload, JS::default_attributes);
+        holders.unchecked_append(JS::make_handle(holder));
+        payloads->values().set(payload);
+    }
+
+    // Allocating is what drives the marking slices, so mutate the graph in between allocations. The new objects
+    // live long enough to be promoted, so that major collections keep happening.
+    auto recent_objects = JS::make_handle(MUST(JS::Array::create(realm, recent_object_count)));
+    static constexpr size_t max_step_count = 10'000'000;
+    for (size_t step = 0; step < max_step_count && heap.major_collection_statistics().collection_count < 3; ++step) {
+        recent_objects->indexed_properties().put(step % recent_object_count, JS::Object::create(realm, nullptr));
+        swap_payloads(*holders[(step * 7919) % holder_count], *holders[(step * 104729 + 1) % holder_count], payload_key);
+    }
+    EXPECT(heap.major_collection_statistics().collection_count >= 3);
+    EXPECT(heap.incremental_marking_statistics().collection_count > heap.major_collection_statistics().collection_count);
+
+    heap.collect_garbage();
+    EXPECT_EQ(payloads->values().size(), holder_count);
+    if (payloads->values().size() != holder_count)
+        return;
+
+    Vector<bool> seen_indices;
+    seen_indices.resize(holder_count);
+    for (auto& holder : holders) {
+        auto index = holder->get_without_side_effects(payload_key).as_object().get_without_side_effects(index_key).as_double();
+        EXPECT(!seen_indices[index]);
+        seen_indices[index] = true;
+    }
+}
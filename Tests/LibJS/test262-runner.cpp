@@ -576,6 +576,7 @@ int main(int argc, char** argv)
     int timeout = 10;
     bool enable_debug_printing = false;
     bool disable_core_dumping = false;
+    bool enable_jit = false;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("LibJS test262 runner for streaming tests");
@@ -584,8 +585,14 @@ int main(int argc, char** argv)
     args_parser.add_option(timeout, "Seconds before test should timeout", "timeout", 't', "seconds");
     args_parser.add_option(enable_debug_printing, "Enable debug printing", "debug", 'd');
     args_parser.add_option(disable_core_dumping, "Disable core dumping", "disable-core-dump");
+    args_parser.add_option(enable_jit, "Compile all code to native code before running it", "jit");
     args_parser.parse(arguments);
 
+    if (enable_jit) {
+        JS::Bytecode::g_jit_enabled = true;
+        JS::Bytecode::g_jit_hotness_threshold = 0;
+    }
+
 #ifdef AK_OS_GNU_HURD
     if (disable_core_dumping)
         setenv("CRASHSERVER", "/servers/crash-kill", true);
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteString.h>
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
+#include <LibRegex/Regex.h>
+
+// A made-up service log, where only a few lines are of interest.
+static Vector<ByteString> make_log_lines()
+{
+    static constexpr Array levels { "INFO"sv, "DEBUG"sv, "INFO"sv, "WARN"sv, "INFO"sv, "DEBUG"sv, "INFO"sv, "ERROR"sv };
+    static constexpr Array messages {
+        "accepted connection from 10.0.3.17:51234"sv,
+        "request GET /api/v1/items?page=3 completed in 12ms"sv,
+        "cache miss for key session:4f1c2a"sv,
+        "retrying upstream request (attempt 2 of 5)"sv,
+        "worker pool resized to 16 threads"sv,
+        "failed to open /var/lib/app/state.db: permission denied"sv,
+    };
+
+    Vector<ByteString> lines;
+    for (size_t i = 0; i < 20'000; ++i) {
+        lines.append(ByteString::formatted("2026-03-{:02} {:02}:{:02}:{:02}.{:03} [{}] pid={} {}",
+            i % 28 + 1, i / 3600 % 24, i / 60 % 60, i % 60, i * 7 % 1000,
+            levels[i % levels.size()], 1000 + i % 37, messages[i * 13 % messages.size()]));
+    }
+    return lines;
+}
+
+static Vector<ByteString> const& log_lines()
+{
+    static auto lines = make_log_lines();
+    return lines;
+}
+
+static ByteString const& log_text()
+{
+    static auto text = ByteString::join('\n', log_lines());
+    return text;
+}
+
+static size_t grep_lines(StringView pattern, bool use_lazy_dfa)
+{
+    auto options = PosixOptions { PosixFlags::Global | PosixFlags::SkipSubExprResults };
+    if (!use_lazy_dfa)
+        options |= (PosixFlags)regex::AllFlags::Internal_DisableLazyDFA;
+
+    Regex<PosixExtended> re(pattern);
+    size_t matching_lines = 0;
+    for (auto const& line : log_lines()) {
+        if (re.has_match(line, options))
+            ++matching_lines;
+    }
+    return matching_lines;
+}
+
+static size_t count_matches(StringView pattern, bool use_lazy_dfa)
+{
+    auto options = ECMAScriptOptions { ECMAScriptFlags::Global };
+    if (!use_lazy_dfa)
+        options |= (ECMAScriptFlags)regex::AllFlags::Internal_DisableLazyDFA;
+
+    Regex<ECMA262> re(pattern, options);
+    size_t matches = 0;
+    while (re.match(log_text()).success)
+        ++matches;
+    return matches;
+}
+
+// Lines with an error in them, like `grep -E`.
+static constexpr auto error_pattern = "\\[(ERROR|FATAL)\\].*(denied|refused)"sv;
+
+BENCHMARK_CASE(grep_errors_lazy_dfa)
+{
+    EXPECT(grep_lines(error_pattern, true) > 0);
+}
+
+BENCHMARK_CASE(grep_errors_backtracking)
+{
+    EXPECT(grep_lines(error_pattern, false) > 0);
+}
+
+// Something that doesn't occur at all, so every position of every line has to be ruled out.
+static constexpr auto absent_pattern = "connection (reset|closed) by [0-9]+\\.[0-9]+\\.[0-9]+\\.[0-9]+"sv;
+
+BENCHMARK_CASE(grep_absent_lazy_dfa)
+{
+    EXPECT_EQ(grep_lines(absent_pattern, true), 0u);
+}
+
+BENCHMARK_CASE(grep_absent_backtracking)
+{
+    EXPECT_EQ(grep_lines(absent_pattern, false), 0u);
+}
+
+// Slow requests in the whole log at once, like RegExp.prototype.exec() in a loop.
+static constexpr auto slow_request_pattern = "GET [^ ]+ completed in [0-9]{2,}ms"sv;
+
+BENCHMARK_CASE(slow_requests_lazy_dfa)
+{
+    EXPECT(count_matches(slow_request_pattern, true) > 0);
+}
+
+BENCHMARK_CASE(slow_requests_backtracking)
+{
+    EXPECT(count_matches(slow_request_pattern, false) > 0);
+}
+
+// Several fixed strings at once, like `grep -F -e ... -e ...`.
+BENCHMARK_CASE(fixed_strings_literal_searcher)
+{
+    auto searcher = regex::LiteralSearcher::create({ "permission denied"sv, "attempt 5 of 5"sv, "pool resized"sv });
+    auto const& text = log_text();
+
+    size_t occurrences = 0;
+    for (auto occurrence = searcher->find(text, 0); occurrence.has_value(); occurrence = searcher->find(text, occurrence->offset + 1))
+        ++occurrences;
+    EXPECT(occurrences > 0);
+}
@@ -1078,6 +1078,75 @@ TEST_CASE(optimizer_alternation)
     }
 }
 
+TEST_CASE(optimizer_required_literal)
+{
+    Array tests {
+        // Pattern, Required literal, Is a prefix, Subject, First match offset
+        Tuple { "hello\\s+world"sv, "hello"sv, true, "hello    hello world"sv, 9u },
+        Tuple { "[a-z]+ing"sv, "ing"sv, false, "ing, singing"sv, 5u },
+        Tuple { "(?:foo|bar)baz"sv, "baz"sv, false, "foo bar barbaz"sv, 8u },
+        Tuple { "x*abc"sv, "abc"sv, false, "ab xxabc"sv, 3u },
+        Tuple { "(ab)+cd"sv, "ab"sv, true, "ab abab ababcd"sv, 8u },
+        // Optional parts aren't required.
+        Tuple { "foo(bar)?baz"sv, "foo"sv, true, "foobar foobaz"sv, 7u },
+        Tuple { "ab(?:c|)d"sv, "ab"sv, true, "abc abd"sv, 4u },
+        // Alternatives and lookaround don't have a single required literal.
+        Tuple { "a|bc"sv, ""sv, false, "xbc"sv, 1u },
+        Tuple { "(?=abc)ab"sv, ""sv, false, "ab abc"sv, 3u },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.get<0>());
+        auto const& optimization_data = re.parser_result.optimization_data;
+        EXPECT_EQ(optimization_data.required_literal.value_or(""), test.get<1>());
+        EXPECT_EQ(optimization_data.required_literal_is_prefix, test.get<2>());
+
+        auto result = re.search(test.get<3>());
+        EXPECT(result.success);
+        EXPECT_EQ(result.matches.first().global_offset, test.get<4>());
+    }
+
+    // The prefilter has to agree with the matcher about case-insensitivity and where a sticky match may start.
+    Regex<ECMA262> re("hello\\s+world", ECMAScriptFlags::Insensitive);
+    EXPECT_EQ(re.search("Say HELLO World"sv).matches.first().global_offset, 4u);
+    Regex<ECMA262> sticky("hello", ECMAScriptFlags::Sticky);
+    EXPECT_EQ(sticky.match("ahello"sv).success, false);
+}
+
+TEST_CASE(literal_searcher)
+{
+    auto searcher = regex::LiteralSearcher::create({ "needle"sv, "pin"sv, "Thread"sv });
+    VERIFY(searcher.has_value());
+
+    auto haystack = ByteString::formatted("{}spin the thread{}needle", ByteString::repeated('.', 40), ByteString::repeated('.', 70));
+    auto occurrence = searcher->find(haystack, 0);
+    EXPECT(occurrence.has_value());
+    EXPECT_EQ(occurrence->offset, 41u);
+    EXPECT_EQ(occurrence->literal_index, 1u);
+
+    occurrence = searcher->find(haystack, 42);
+    EXPECT(occurrence.has_value());
+    EXPECT_EQ(occurrence->offset, 125u);
+    EXPECT_EQ(occurrence->literal_index, 0u);
+
+    occurrence = searcher->find(haystack, 42, CaseSensitivity::CaseInsensitive);
+    EXPECT(occurrence.has_value());
+    EXPECT_EQ(occurrence->offset, 49u);
+    EXPECT_EQ(occurrence->literal_index, 2u);
+
+    EXPECT(!searcher->find(haystack, 126).has_value());
+    EXPECT(!searcher->find("needl"sv, 0).has_value());
+
+    // A single literal is checked against its first and last byte, so also try it at the very end of the haystack.
+    auto single = regex::LiteralSearcher::create({ "xyz"sv });
+    for (size_t length = 3; length < 64; ++length) {
+        auto text = ByteString::formatted("{}xyz", ByteString::repeated('x', length - 3));
+        auto found = single->find(text, 0);
+        EXPECT(found.has_value());
+        EXPECT_EQ(found->offset, length - 3);
+    }
+}
+
 TEST_CASE(posix_basic_dollar_is_end_anchor)
 {
     // Ensure that a dollar sign at the end only matches the end of the line.
@@ -1197,3 +1266,64 @@ TEST_CASE(mismatching_brackets)
         EXPECT_EQ(re.parser_result.error, regex::Error::MismatchingBracket);
     }
 }
+
+TEST_CASE(lazy_dfa_agrees_with_backtracker)
+{
+    auto const patterns = Array {
+        "abc"sv,
+        "^abc$"sv,
+        "(a|b)*c"sv,
+        "^$"sv,
+        "[0-9]+-[a-z]{2,3}"sv,
+        "\\bfoo\\b"sv,
+        "(ab)+$"sv,
+        "ERROR|WARN"sv,
+        "(?:foo|bar)baz"sv,
+        "\\d\\d:\\d\\d"sv,
+        "colou?r"sv,
+        ".*foo"sv,
+        "\\w+@\\w+\\.com"sv,
+    };
+    auto const inputs = Array {
+        ""sv,
+        "abc"sv,
+        "xabcx"sv,
+        "aabbc"sv,
+        "2024-01-01 12:34 ERROR disk full"sv,
+        "12-abcd"sv,
+        "foo bar"sv,
+        "barbaz foobaz"sv,
+        "color colour"sv,
+        "me@example.com"sv,
+        "foo\nbar"sv,
+    };
+    auto const backtracking_only = (ECMAScriptFlags)regex::AllFlags::Internal_DisableLazyDFA;
+
+    for (auto pattern : patterns) {
+        for (auto flags : { ECMAScriptFlags {}, (ECMAScriptFlags)regex::AllFlags::Global, ECMAScriptFlags::Insensitive, ECMAScriptFlags::Multiline }) {
+            Regex<ECMA262> re(pattern, flags);
+            for (auto input : inputs) {
+                auto result = re.match(input);
+                auto expected = re.match(input, backtracking_only);
+                EXPECT_EQ(result.success, expected.success);
+                EXPECT_EQ(result.count, expected.count);
+                for (size_t i = 0; i < min(result.count, expected.count); ++i) {
+                    EXPECT_EQ(result.matches[i].global_offset, expected.matches[i].global_offset);
+                    EXPECT_EQ(result.matches[i].view.length(), expected.matches[i].view.length());
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(lazy_dfa_catastrophic_backtracking)
+{
+    // Without a DFA to rule these out up front, the backtracker would try exponentially many ways to split the input.
+    Regex<ECMA262> re("^(a+)+$");
+    auto result = re.match(ByteString::formatted("{}!", ByteString::repeated('a', 100)));
+    EXPECT_EQ(result.success, false);
+
+    Regex<PosixExtended> re2("(a*)*b");
+    result = re2.match(ByteString::repeated('a', 100));
+    EXPECT_EQ(result.success, false);
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Random.h>
+#include <AK/ScopeGuard.h>
+#include <AK/StringBuilder.h>
+#include <AK/StringUtils.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibSQL/AST/Parser.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/ResultSet.h>
+#include <LibTest/TestCase.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char const* db_name = "/tmp/benchmark.db";
+
+// Set SQL_BENCHMARK_ROW_COUNT to measure with a bigger table, e.g. 1000000.
+size_t row_count()
+{
+    if (auto const* count = getenv("SQL_BENCHMARK_ROW_COUNT")) {
+        if (auto value = AK::StringUtils::convert_to_uint<size_t>({ count, strlen(count) }); value.has_value())
+            return value.value();
+    }
+    return 20000;
+}
+
+SQL::ResultSet execute(NonnullRefPtr<SQL::Database> database, ByteString const& sql)
+{
+    auto parser = SQL::AST::Parser(SQL::AST::Lexer(sql));
+    auto statement = parser.next_statement();
+    VERIFY(!parser.has_errors());
+
+    auto result = statement->execute(move(database));
+    if (result.is_error()) {
+        outln("{}", result.release_error().error_string());
+        VERIFY_NOT_REACHED();
+    }
+    return result.release_value();
+}
+
+void report(StringView phase, size_t operations, Core::ElapsedTimer const& timer)
+{
+    auto elapsed = timer.elapsed_time().to_microseconds();
+    outln("{}: {} operations in {} ms ({} us per operation)", phase, operations, elapsed / 1000, elapsed / max<i64>(operations, 1));
+}
+
+}
+
+// Inserts the rows in statements of a few hundred rows each, so that every statement commits a
+// good number of pages to the write-ahead log at once, followed by point lookups on random keys
+// and range scans over the last tenth of the table.
+BENCHMARK_CASE(insert_point_lookup_range_scan)
+{
+    static constexpr size_t rows_per_statement = 500;
+    static constexpr size_t point_lookups = 20;
+    static constexpr size_t range_scans = 5;
+
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto count = row_count();
+
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    execute(database, "CREATE SCHEMA BenchmarkSchema;");
+    execute(database, "CREATE TABLE BenchmarkSchema.BenchmarkTable ( TextColumn text, IntColumn integer );");
+
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    for (size_t first_row = 0; first_row < count; first_row += rows_per_statement) {
+        StringBuilder builder;
+        builder.append("INSERT INTO BenchmarkSchema.BenchmarkTable VALUES "sv);
+        for (size_t row = first_row; row < min(first_row + rows_per_statement, count); ++row)
+            builder.appendff("{}('Row_{}', {})", row == first_row ? "" : ", ", row, row);
+        builder.append(';');
+        execute(database, builder.to_byte_string());
+    }
+    report("Insert"sv, count, timer);
+
+    timer.start();
+    for (size_t i = 0; i < point_lookups; ++i) {
+        auto key = get_random_uniform(static_cast<u32>(count));
+        auto result = execute(database, ByteString::formatted("SELECT TextColumn FROM BenchmarkSchema.BenchmarkTable WHERE IntColumn = {};", key));
+        EXPECT_EQ(result.size(), 1u);
+    }
+    report("Point lookup"sv, point_lookups, timer);
+
+    timer.start();
+    auto range_size = max(count / 10, 1uz);
+    for (size_t i = 0; i < range_scans; ++i) {
+        auto result = execute(database, ByteString::formatted("SELECT IntColumn FROM BenchmarkSchema.BenchmarkTable WHERE IntColumn >= {};", count - range_size));
+        EXPECT_EQ(result.size(), range_size);
+    }
+    report("Range scan"sv, range_scans, timer);
+}
@@ -255,6 +255,29 @@ TEST_CASE(binary_operator)
     }
 }
 
+TEST_CASE(operator_precedence)
+{
+    auto validate = [](StringView sql, SQL::AST::BinaryOperator expected_operator, bool expected_nested_lhs, bool expected_nested_rhs) {
+        auto expression = TRY_OR_FAIL(parse(sql));
+        EXPECT(is<SQL::AST::BinaryOperatorExpression>(*expression));
+
+        auto const& binary = static_cast<const SQL::AST::BinaryOperatorExpression&>(*expression);
+        EXPECT_EQ(binary.type(), expected_operator);
+        EXPECT_EQ(!is<SQL::AST::NumericLiteral>(*binary.lhs()) && !is<SQL::AST::ColumnNameExpression>(*binary.lhs()), expected_nested_lhs);
+        EXPECT_EQ(!is<SQL::AST::NumericLiteral>(*binary.rhs()) && !is<SQL::AST::ColumnNameExpression>(*binary.rhs()), expected_nested_rhs);
+    };
+
+    validate("1 + 2 * 3"sv, SQL::AST::BinaryOperator::Plus, false, true);
+    validate("1 * 2 + 3"sv, SQL::AST::BinaryOperator::Plus, true, false);
+    validate("1 - 2 - 3"sv, SQL::AST::BinaryOperator::Minus, true, false);
+    validate("1 || 2 * 3"sv, SQL::AST::BinaryOperator::Multiplication, true, false);
+    validate("1 < 2 = 3"sv, SQL::AST::BinaryOperator::Equals, true, false);
+    validate("a = 1 AND b = 2"sv, SQL::AST::BinaryOperator::And, true, true);
+    validate("a = 1 OR b = 2 AND c = 3"sv, SQL::AST::BinaryOperator::Or, true, true);
+    validate("a BETWEEN 1 AND 2 AND b = 3"sv, SQL::AST::BinaryOperator::And, true, true);
+    validate("NOT a = 1 AND b"sv, SQL::AST::BinaryOperator::And, true, false);
+}
+
 TEST_CASE(chained_expression)
 {
     EXPECT(parse("()"sv).is_error());
@@ -6,11 +6,13 @@
 
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibSQL/Heap.h>
 #include <LibTest/TestCase.h>
 
 static constexpr auto db_path = "/tmp/test.db"sv;
+static constexpr auto block_data_size = SQL::Heap::DEFAULT_PAGE_SIZE - SQL::Block::HEADER_SIZE;
 
 static NonnullRefPtr<SQL::Heap> create_heap()
 {
@@ -27,7 +29,7 @@ TEST_CASE(heap_write_large_storage_without_flush)
 
     // Write large storage spanning multiple blocks
     StringBuilder builder;
-    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    MUST(builder.try_append_repeated('x', block_data_size * 4));
     auto long_string = builder.string_view();
     TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
 
@@ -44,7 +46,7 @@ TEST_CASE(heap_write_large_storage_with_flush)
 
     // Write large storage spanning multiple blocks
     StringBuilder builder;
-    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    MUST(builder.try_append_repeated('x', block_data_size * 4));
     auto long_string = builder.string_view();
     TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
     MUST(heap->flush());
@@ -62,7 +64,7 @@ TEST_CASE(heap_overwrite_large_storage)
 
     // Write large storage spanning multiple blocks
     StringBuilder builder;
-    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    MUST(builder.try_append_repeated('x', block_data_size * 4));
     auto long_string = builder.string_view();
     TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
     MUST(heap->flush());
@@ -76,7 +78,7 @@ TEST_CASE(heap_overwrite_large_storage)
 
     // Write a smaller string and read back - heap size should be at most the previous size
     builder.clear();
-    MUST(builder.try_append_repeated('y', SQL::Block::DATA_SIZE * 2));
+    MUST(builder.try_append_repeated('y', block_data_size * 2));
     auto shorter_string = builder.string_view();
     TRY_OR_FAIL(heap->write_storage(storage_block_id, shorter_string.bytes()));
     MUST(heap->flush());
@@ -87,7 +89,7 @@ TEST_CASE(heap_overwrite_large_storage)
 
     // Write a longer string and read back - heap size is expected to grow
     builder.clear();
-    MUST(builder.try_append_repeated('z', SQL::Block::DATA_SIZE * 6));
+    MUST(builder.try_append_repeated('z', block_data_size * 6));
     auto longest_string = builder.string_view();
     TRY_OR_FAIL(heap->write_storage(storage_block_id, longest_string.bytes()));
     MUST(heap->flush());
@@ -105,7 +107,7 @@ TEST_CASE(heap_reuse_freed_blocks_after_storage_trim)
     // First, write storage spanning 4 blocks
     auto first_index = heap->request_new_block_index();
     StringBuilder builder;
-    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    MUST(builder.try_append_repeated('x', block_data_size * 4));
     auto long_string = builder.string_view();
     TRY_OR_FAIL(heap->write_storage(first_index, long_string.bytes()));
     MUST(heap->flush());
@@ -113,7 +115,7 @@ TEST_CASE(heap_reuse_freed_blocks_after_storage_trim)
 
     // Then, overwrite the first storage and reduce it to 2 blocks
     builder.clear();
-    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 2));
+    MUST(builder.try_append_repeated('x', block_data_size * 2));
     long_string = builder.string_view();
     TRY_OR_FAIL(heap->write_storage(first_index, long_string.bytes()));
     MUST(heap->flush());
@@ -134,7 +136,7 @@ TEST_CASE(heap_reuse_freed_blocks_after_reopening_file)
 
     size_t original_heap_size = 0;
     StringBuilder builder;
-    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    MUST(builder.try_append_repeated('x', block_data_size * 4));
     auto long_string = builder.string_view();
 
     {
@@ -148,7 +150,7 @@ TEST_CASE(heap_reuse_freed_blocks_after_reopening_file)
 
         // Then, overwrite the first storage and reduce it to 2 blocks
         builder.clear();
-        MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 2));
+        MUST(builder.try_append_repeated('x', block_data_size * 2));
         long_string = builder.string_view();
         TRY_OR_FAIL(heap->write_storage(first_index, long_string.bytes()));
         MUST(heap->flush());
@@ -176,7 +178,7 @@ TEST_CASE(heap_free_storage)
 
     // Write large storage spanning multiple blocks
     StringBuilder builder;
-    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    MUST(builder.try_append_repeated('x', block_data_size * 4));
     auto long_string = builder.string_view();
     TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
     MUST(heap->flush());
@@ -192,3 +194,114 @@ TEST_CASE(heap_free_storage)
     auto new_heap_size = MUST(heap->file_size_in_bytes());
     EXPECT(new_heap_size <= heap_size);
 }
+
+TEST_CASE(heap_custom_page_size)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', 3000));
+    auto long_string = builder.string_view();
+    SQL::Block::Index storage_block_id = 0;
+
+    {
+        auto heap = MUST(SQL::Heap::create(db_path, 1024));
+        MUST(heap->open());
+        EXPECT_EQ(heap->page_size(), 1024u);
+
+        // 3000 bytes need three blocks of 1024 bytes
+        storage_block_id = heap->request_new_block_index();
+        TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
+        MUST(heap->flush());
+        EXPECT_EQ(MUST(heap->file_size_in_bytes()), 4 * 1024uz);
+    }
+
+    // The page size is taken from the file, not from the argument
+    {
+        auto heap = MUST(SQL::Heap::create(db_path, 8192));
+        MUST(heap->open());
+        EXPECT_EQ(heap->page_size(), 1024u);
+        auto stored_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+        EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+    }
+
+    EXPECT(SQL::Heap::create(db_path, 1000).is_error());
+}
+
+static void copy_file(StringView from, StringView to)
+{
+    auto source = MUST(Core::File::open(from, Core::File::OpenMode::Read));
+    auto destination = MUST(Core::File::open(to, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    MUST(destination->write_until_depleted(MUST(source->read_until_eof())));
+}
+
+TEST_CASE(heap_recover_committed_storage_from_wal)
+{
+    static constexpr auto crashed_db_path = "/tmp/test-crashed.db"sv;
+    ScopeGuard guard([]() {
+        MUST(Core::System::unlink(db_path));
+        MUST(Core::System::unlink(crashed_db_path));
+    });
+
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', block_data_size * 4));
+    auto committed_string = builder.string_view();
+    SQL::Block::Index committed_block_id = 0;
+    SQL::Block::Index uncommitted_block_id = 0;
+
+    {
+        // Use a tiny buffer pool, so that uncommitted pages are evicted into the write-ahead log
+        auto heap = MUST(SQL::Heap::create(db_path, SQL::Heap::DEFAULT_PAGE_SIZE, 2));
+        MUST(heap->open());
+
+        committed_block_id = heap->request_new_block_index();
+        TRY_OR_FAIL(heap->write_storage(committed_block_id, committed_string.bytes()));
+        MUST(heap->commit());
+
+        uncommitted_block_id = heap->request_new_block_index();
+        TRY_OR_FAIL(heap->write_storage(uncommitted_block_id, committed_string.bytes()));
+        EXPECT(heap->buffer_pool_statistics().write_backs > 0);
+
+        // Pretend we crashed by copying the files before the heap gets to checkpoint
+        copy_file(db_path, crashed_db_path);
+        copy_file(heap->wal_name(), ByteString::formatted("{}-wal", crashed_db_path));
+    }
+
+    auto heap = MUST(SQL::Heap::create(crashed_db_path));
+    MUST(heap->open());
+    auto stored_string = TRY_OR_FAIL(heap->read_storage(committed_block_id));
+    EXPECT_EQ(committed_string.bytes(), stored_string.bytes());
+    EXPECT(!heap->has_block(uncommitted_block_id));
+}
+
+TEST_CASE(heap_group_commit)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto heap = create_heap();
+    auto fsync_count = heap->wal_fsync_count();
+
+    // Every commit syncs on its own by default.
+    auto first_block_id = heap->request_new_block_index();
+    TRY_OR_FAIL(heap->write_storage(first_block_id, "first"sv.bytes()));
+    MUST(heap->commit());
+    EXPECT_EQ(heap->wal_fsync_count(), fsync_count + 1);
+
+    // With group commit, all commits since the last sync share a single one.
+    heap->set_group_commit_enabled(true);
+    for (auto i = 0; i < 5; ++i) {
+        auto block_id = heap->request_new_block_index();
+        TRY_OR_FAIL(heap->write_storage(block_id, "grouped"sv.bytes()));
+        MUST(heap->commit());
+    }
+    EXPECT_EQ(heap->wal_fsync_count(), fsync_count + 1);
+
+    MUST(heap->sync());
+    EXPECT_EQ(heap->wal_fsync_count(), fsync_count + 2);
+
+    // There is nothing left to sync.
+    MUST(heap->sync());
+    EXPECT_EQ(heap->wal_fsync_count(), fsync_count + 2);
+
+    auto stored_string = TRY_OR_FAIL(heap->read_storage(first_block_id));
+    EXPECT_EQ(stored_string.bytes(), "first"sv.bytes());
+}
@@ -1060,4 +1060,223 @@ TEST_CASE(update_all_rows)
     }
 }
 
+ByteString explain(NonnullRefPtr<SQL::Database> database, ByteString const& sql)
+{
+    auto result = execute(move(database), ByteString::formatted("EXPLAIN {}", sql));
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Explain);
+
+    StringBuilder builder;
+    for (auto const& row : result)
+        builder.appendff("{}\n", row.row[0].to_byte_string());
+    return builder.to_byte_string();
+}
+
+void insert_numbered_rows(NonnullRefPtr<SQL::Database> database, int count)
+{
+    for (auto i = 0; i < count; ++i) {
+        auto result = execute(database, ByteString::formatted("INSERT INTO TestSchema.TestTable VALUES ( 'T{}', {} );", i, i));
+        EXPECT_EQ(result.size(), 1u);
+    }
+}
+
+TEST_CASE(select_using_index)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    {
+        auto database = MUST(SQL::Database::create(db_name));
+        MUST(database->open());
+        create_table(database);
+        insert_numbered_rows(database, 100);
+
+        EXPECT(explain(database, "SELECT * FROM TestSchema.TestTable WHERE IntColumn = 42;").contains("TableScan"sv));
+
+        auto result = execute(database, "CREATE INDEX TestSchema.IntIndex ON TestTable ( IntColumn );");
+        EXPECT_EQ(result.command(), SQL::SQLCommand::Create);
+
+        auto plan = explain(database, "SELECT * FROM TestSchema.TestTable WHERE IntColumn = 42;");
+        EXPECT(plan.contains("IndexScan TESTSCHEMA.TESTTABLE USING INTINDEX"sv));
+        EXPECT(!plan.contains("TableScan"sv));
+
+        result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = 42;");
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0].to_byte_string(), "T42");
+
+        result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE 42 = IntColumn;");
+        EXPECT_EQ(result.size(), 1u);
+
+        result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn >= 95 ORDER BY IntColumn;");
+        EXPECT_EQ(result.size(), 5u);
+        for (auto i = 0u; i < result.size(); ++i)
+            EXPECT_EQ(result[i].row[0], 95 + i);
+
+        result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn < 3;");
+        EXPECT_EQ(result.size(), 3u);
+
+        result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn BETWEEN 10 AND 19;");
+        EXPECT_EQ(result.size(), 10u);
+
+        result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn > 10 AND IntColumn <= 20 AND TextColumn != 'T15';");
+        EXPECT_EQ(result.size(), 9u);
+
+        result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn = ?;", placeholders(7));
+        EXPECT_EQ(result.size(), 1u);
+
+        result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn = 1000;");
+        EXPECT(result.is_empty());
+
+        result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn >= 50 LIMIT 5;");
+        EXPECT_EQ(result.size(), 5u);
+    }
+    {
+        auto database = MUST(SQL::Database::create(db_name));
+        MUST(database->open());
+
+        EXPECT(explain(database, "SELECT * FROM TestSchema.TestTable WHERE IntColumn = 42;").contains("IndexScan"sv));
+
+        auto result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = 42;");
+        EXPECT_EQ(result.size(), 1u);
+        EXPECT_EQ(result[0].row[0].to_byte_string(), "T42");
+
+        auto create_result = try_execute(database, "CREATE INDEX TestSchema.IntIndex ON TestTable ( IntColumn );");
+        EXPECT(create_result.is_error());
+        EXPECT_EQ(create_result.release_error().error(), SQL::SQLErrorCode::IndexExists);
+
+        execute(database, "CREATE INDEX IF NOT EXISTS TestSchema.IntIndex ON TestTable ( IntColumn );");
+    }
+}
+
+TEST_CASE(select_using_text_index)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+    insert_numbered_rows(database, 20);
+    execute(database, "INSERT INTO TestSchema.TestTable ( IntColumn ) VALUES ( 100 );");
+    execute(database, "CREATE INDEX TestSchema.TextIndex ON TestTable ( TextColumn );");
+
+    EXPECT(explain(database, "SELECT * FROM TestSchema.TestTable WHERE TextColumn = 'T7';").contains("IndexScan"sv));
+
+    auto result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE TextColumn = 'T7';");
+    EXPECT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].row[0], 7);
+
+    // 'T1', and 'T10' up to 'T19'.
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE TextColumn >= 'T1' AND TextColumn < 'T2';");
+    EXPECT_EQ(result.size(), 11u);
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE TextColumn < 'T1';");
+    EXPECT_EQ(result.size(), 2u);
+}
+
+TEST_CASE(index_is_kept_up_to_date)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+    execute(database, "CREATE INDEX TestSchema.IntIndex ON TestTable ( IntColumn );");
+    insert_numbered_rows(database, 50);
+
+    auto result = execute(database, "DELETE FROM TestSchema.TestTable WHERE IntColumn BETWEEN 10 AND 19;");
+    EXPECT_EQ(result.size(), 10u);
+    EXPECT(explain(database, "DELETE FROM TestSchema.TestTable WHERE IntColumn = 1;").contains("IndexScan"sv));
+
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn < 25;");
+    EXPECT_EQ(result.size(), 15u);
+
+    result = execute(database, "UPDATE TestSchema.TestTable SET IntColumn = 1000 WHERE IntColumn = 30;");
+    EXPECT_EQ(result.size(), 1u);
+
+    result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = 30;");
+    EXPECT(result.is_empty());
+
+    result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = 1000;");
+    EXPECT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].row[0].to_byte_string(), "T30");
+
+    // Rows that reuse the storage of deleted rows must be found again.
+    insert_numbered_rows(database, 20);
+    result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn BETWEEN 10 AND 19;");
+    EXPECT_EQ(result.size(), 10u);
+
+    result = execute(database, "SELECT * FROM TestSchema.TestTable;");
+    EXPECT_EQ(result.size(), 60u);
+}
+
+TEST_CASE(unique_index)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+    insert_numbered_rows(database, 10);
+    execute(database, "INSERT INTO TestSchema.TestTable ( TextColumn ) VALUES ( 'NoNumber1' ), ( 'NoNumber2' );");
+
+    auto result = execute(database, "CREATE UNIQUE INDEX TestSchema.IntIndex ON TestTable ( IntColumn );");
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Create);
+
+    auto insert_result = try_execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'Duplicate', 5 );");
+    EXPECT(insert_result.is_error());
+    EXPECT_EQ(insert_result.release_error().error(), SQL::SQLErrorCode::UniqueConstraintFailed);
+
+    auto update_result = try_execute(database, "UPDATE TestSchema.TestTable SET IntColumn = 5 WHERE IntColumn = 6;");
+    EXPECT(update_result.is_error());
+    EXPECT_EQ(update_result.release_error().error(), SQL::SQLErrorCode::UniqueConstraintFailed);
+
+    // Neither NULLs nor a row itself count as duplicates.
+    execute(database, "INSERT INTO TestSchema.TestTable ( TextColumn ) VALUES ( 'NoNumber3' );");
+    execute(database, "UPDATE TestSchema.TestTable SET IntColumn = 5 WHERE IntColumn = 5;");
+    execute(database, "DELETE FROM TestSchema.TestTable WHERE IntColumn = 5;");
+    execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'NotADuplicate', 5 );");
+
+    result = execute(database, "SELECT TextColumn FROM TestSchema.TestTable WHERE IntColumn = 5;");
+    EXPECT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].row[0].to_byte_string(), "NotADuplicate");
+
+    execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'T1', 100 );");
+    auto create_result = try_execute(database, "CREATE UNIQUE INDEX TestSchema.OtherIntIndex ON TestTable ( IntColumn );");
+    EXPECT(!create_result.is_error());
+    create_result = try_execute(database, "CREATE UNIQUE INDEX TestSchema.TextIndex ON TestTable ( TextColumn );");
+    EXPECT(create_result.is_error());
+    EXPECT_EQ(create_result.release_error().error(), SQL::SQLErrorCode::UniqueConstraintFailed);
+}
+
+TEST_CASE(select_hash_join)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_two_tables(database);
+
+    for (auto i = 0; i < 20; ++i) {
+        execute(database, ByteString::formatted("INSERT INTO TestSchema.TestTable1 VALUES ( 'Left_{}', {} );", i, i));
+        execute(database, ByteString::formatted("INSERT INTO TestSchema.TestTable2 VALUES ( 'Right_{}', {} );", i, i % 5));
+    }
+    execute(database, "INSERT INTO TestSchema.TestTable2 ( TextColumn2 ) VALUES ( 'Right_Null' );");
+
+    auto query = "SELECT TextColumn1, TextColumn2 FROM TestSchema.TestTable1, TestSchema.TestTable2 WHERE TestTable1.IntColumn = TestTable2.IntColumn ORDER BY TextColumn2;"sv;
+    EXPECT(explain(database, query).contains("HashJoin ON TESTTABLE1.INTCOLUMN = TESTTABLE2.INTCOLUMN"sv));
+
+    auto result = execute(database, query);
+    EXPECT_EQ(result.size(), 20u);
+    for (auto const& row : result) {
+        auto left_text = row.row[0].to_byte_string();
+        auto right_text = row.row[1].to_byte_string();
+        auto left = left_text.substring_view(5).to_number<int>();
+        auto right = right_text.substring_view(6).to_number<int>();
+        EXPECT_EQ(left.value(), right.value() % 5);
+    }
+
+    result = execute(database,
+        "SELECT TextColumn2 FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE TestTable2.IntColumn = TestTable1.IntColumn AND TextColumn1 = 'Left_3';");
+    EXPECT_EQ(result.size(), 4u);
+
+    // Without an equality between the tables, every pair of rows has to be looked at.
+    EXPECT(explain(database, "SELECT * FROM TestSchema.TestTable1, TestSchema.TestTable2 WHERE TestTable1.IntColumn < TestTable2.IntColumn;").contains("NestedLoopJoin"sv));
+    result = execute(database, "SELECT * FROM TestSchema.TestTable1, TestSchema.TestTable2 WHERE TestTable1.IntColumn < TestTable2.IntColumn;");
+    EXPECT_EQ(result.size(), 16u + 12u + 8u + 4u);
+}
+
 }
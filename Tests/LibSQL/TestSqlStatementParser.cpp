@@ -126,6 +126,51 @@ TEST_CASE(create_table)
     validate("CREATE TABLE test ( column1 varchar(1e3) );"sv, {}, "TEST"sv, { { "COLUMN1"sv, "VARCHAR"sv, { 1000 } } });
 }
 
+TEST_CASE(create_index)
+{
+    EXPECT(parse("CREATE INDEX"sv).is_error());
+    EXPECT(parse("CREATE INDEX index_name"sv).is_error());
+    EXPECT(parse("CREATE INDEX index_name ON"sv).is_error());
+    EXPECT(parse("CREATE INDEX index_name ON table_name"sv).is_error());
+    EXPECT(parse("CREATE INDEX index_name ON table_name ()"sv).is_error());
+    EXPECT(parse("CREATE INDEX index_name ON table_name ( column1 )"sv).is_error());
+    EXPECT(parse("CREATE UNIQUE index_name ON table_name ( column1 );"sv).is_error());
+    EXPECT(parse("CREATE INDEX IF index_name ON table_name ( column1 );"sv).is_error());
+    EXPECT(parse("CREATE INDEX IF NOT index_name ON table_name ( column1 );"sv).is_error());
+
+    struct IndexedColumn {
+        StringView name;
+        SQL::Order order { SQL::Order::Ascending };
+    };
+
+    auto validate = [](StringView sql, StringView expected_schema, StringView expected_index, StringView expected_table, Vector<IndexedColumn> expected_columns, bool expected_is_unique = false, bool expected_is_error_if_index_exists = true) {
+        auto statement = TRY_OR_FAIL(parse(sql));
+        EXPECT(is<SQL::AST::CreateIndex>(*statement));
+
+        auto const& index = static_cast<const SQL::AST::CreateIndex&>(*statement);
+        EXPECT_EQ(index.schema_name(), expected_schema);
+        EXPECT_EQ(index.index_name(), expected_index);
+        EXPECT_EQ(index.table_name(), expected_table);
+        EXPECT_EQ(index.is_unique(), expected_is_unique);
+        EXPECT_EQ(index.is_error_if_index_exists(), expected_is_error_if_index_exists);
+
+        auto const& columns = index.indexed_columns();
+        EXPECT_EQ(columns.size(), expected_columns.size());
+
+        for (size_t i = 0; i < columns.size(); ++i) {
+            EXPECT_EQ(columns[i].column_name, expected_columns[i].name);
+            EXPECT_EQ(columns[i].order, expected_columns[i].order);
+        }
+    };
+
+    validate("CREATE INDEX index_name ON table_name ( column1 );"sv, {}, "INDEX_NAME"sv, "TABLE_NAME"sv, { { "COLUMN1"sv } });
+    validate("CREATE INDEX schema_name.index_name ON table_name ( column1 );"sv, "SCHEMA_NAME"sv, "INDEX_NAME"sv, "TABLE_NAME"sv, { { "COLUMN1"sv } });
+    validate("CREATE INDEX index_name ON table_name ( column1, column2 );"sv, {}, "INDEX_NAME"sv, "TABLE_NAME"sv, { { "COLUMN1"sv }, { "COLUMN2"sv } });
+    validate("CREATE INDEX index_name ON table_name ( column1 ASC, column2 DESC );"sv, {}, "INDEX_NAME"sv, "TABLE_NAME"sv, { { "COLUMN1"sv, SQL::Order::Ascending }, { "COLUMN2"sv, SQL::Order::Descending } });
+    validate("CREATE UNIQUE INDEX index_name ON table_name ( column1 );"sv, {}, "INDEX_NAME"sv, "TABLE_NAME"sv, { { "COLUMN1"sv } }, true);
+    validate("CREATE INDEX IF NOT EXISTS index_name ON table_name ( column1 );"sv, {}, "INDEX_NAME"sv, "TABLE_NAME"sv, { { "COLUMN1"sv } }, false, false);
+}
+
 TEST_CASE(alter_table)
 {
     // This test case only contains common error cases of the AlterTable subclasses.
@@ -783,3 +828,25 @@ TEST_CASE(describe_table)
     validate("DESCRIBE TABLE TableName;"sv, {}, "TABLENAME"sv);
     validate("DESCRIBE TABLE SchemaName.TableName;"sv, "SCHEMANAME"sv, "TABLENAME"sv);
 }
+
+TEST_CASE(explain)
+{
+    EXPECT(parse("EXPLAIN"sv).is_error());
+    EXPECT(parse("EXPLAIN;"sv).is_error());
+    EXPECT(parse("EXPLAIN QUERY SELECT * FROM table_name;"sv).is_error());
+    EXPECT(parse("EXPLAIN SELECT * FROM table_name"sv).is_error());
+
+    auto validate = [](StringView sql, auto is_expected_statement) {
+        auto statement = TRY_OR_FAIL(parse(sql));
+        EXPECT(is<SQL::AST::Explain>(*statement));
+
+        auto const& explain_statement = static_cast<const SQL::AST::Explain&>(*statement);
+        EXPECT(is_expected_statement(*explain_statement.statement()));
+    };
+
+    auto is_select = [](SQL::AST::Statement const& statement) { return is<SQL::AST::Select>(statement); };
+    validate("EXPLAIN SELECT * FROM table_name;"sv, is_select);
+    validate("EXPLAIN QUERY PLAN SELECT * FROM table_name WHERE column1 = 1;"sv, is_select);
+    validate("EXPLAIN DELETE FROM table_name WHERE column1 = 1;"sv, [](auto const& statement) { return is<SQL::AST::Delete>(statement); });
+    validate("EXPLAIN UPDATE table_name SET column1 = 1;"sv, [](auto const& statement) { return is<SQL::AST::Update>(statement); });
+}
@@ -28,6 +28,7 @@
 #include <LibGUI/ToolbarContainer.h>
 #include <LibGUI/Window.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/ImageFormats/JPEGLoader.h>
 #include <LibGfx/Palette.h>
 #include <LibGfx/Rect.h>
 #include <LibMain/Main.h>
@@ -41,6 +42,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     TRY(Core::System::pledge("stdio recvfd sendfd rpath wpath cpath unix thread"));
 
+    Gfx::JPEGImageDecoderPlugin::set_default_decoding_thread_count({});
+
     auto app = TRY(GUI::Application::create(arguments));
 
     Config::pledge_domains({ "ImageViewer", "WindowManager" });
@@ -7,6 +7,7 @@
 
 #include <LibArchive/Zip.h>
 #include <LibCompress/Deflate.h>
+#include <LibCompress/ParallelDeflate.h>
 #include <LibCrypto/Checksum/CRC32.h>
 
 namespace Archive {
@@ -122,8 +123,9 @@ ErrorOr<Statistics> Zip::calculate_statistics() const
     return Statistics(file_count, directory_count, uncompressed_bytes);
 }
 
-ZipOutputStream::ZipOutputStream(NonnullOwnPtr<Stream> stream)
+ZipOutputStream::ZipOutputStream(NonnullOwnPtr<Stream> stream, Compress::ParallelDeflateCompressor* parallel_compressor)
     : m_stream(move(stream))
+    , m_parallel_compressor(parallel_compressor)
 {
 }
 
@@ -170,7 +172,13 @@ ErrorOr<ZipOutputStream::MemberInformation> ZipOutputStream::add_member_from_str
         member.modification_time = to_packed_dos_time(modification_time->hour(), modification_time->minute(), modification_time->second());
     }
 
-    auto deflate_buffer = Compress::DeflateCompressor::compress_all(buffer);
+    Crypto::Checksum::CRC32 checksum;
+    auto deflate_buffer = [&]() -> ErrorOr<ByteBuffer> {
+        if (m_parallel_compressor)
+            return m_parallel_compressor->compress_all(buffer, [&] { checksum.update(buffer); });
+        checksum.update(buffer);
+        return Compress::DeflateCompressor::compress_all(buffer);
+    }();
     auto compression_ratio = 1.f;
     auto compressed_size = buffer.size();
 
@@ -187,7 +195,6 @@ ErrorOr<ZipOutputStream::MemberInformation> ZipOutputStream::add_member_from_str
 
     member.uncompressed_size = buffer.size();
 
-    Crypto::Checksum::CRC32 checksum { buffer.bytes() };
     member.crc32 = checksum.digest();
     member.is_directory = false;
 
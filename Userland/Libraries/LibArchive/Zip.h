@@ -19,6 +19,10 @@
 #include <LibCore/DateTime.h>
 #include <string.h>
 
+namespace Compress {
+class ParallelDeflateCompressor;
+}
+
 namespace Archive {
 
 template<size_t fields_size, class T>
@@ -279,7 +283,8 @@ public:
         size_t compressed_size;
     };
 
-    ZipOutputStream(NonnullOwnPtr<Stream>);
+    // If a parallel compressor is given, members are compressed on multiple threads. It has to outlive the stream.
+    ZipOutputStream(NonnullOwnPtr<Stream>, Compress::ParallelDeflateCompressor* = nullptr);
 
     ErrorOr<void> add_member(ZipMember const&);
     ErrorOr<MemberInformation> add_member_from_stream(StringView, Stream&, Optional<Core::DateTime> const& = {});
@@ -292,6 +297,7 @@ public:
 
 private:
     NonnullOwnPtr<Stream> m_stream;
+    Compress::ParallelDeflateCompressor* m_parallel_compressor { nullptr };
     Vector<ZipMember> m_members;
 
     bool m_finished { false };
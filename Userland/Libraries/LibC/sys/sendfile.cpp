@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <fcntl.h>
+#include <sys/sendfile.h>
+
+extern "C" {
+
+ssize_t sendfile(int out_fd, int in_fd, off_t* offset, size_t count)
+{
+    // Our splice() isn't limited to pipes, so this is just its most common use.
+    return splice(in_fd, offset, out_fd, nullptr, count, 0);
+}
+}
@@ -482,7 +482,7 @@ DeflateCompressor::DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>
 
 DeflateCompressor::~DeflateCompressor()
 {
-    VERIFY(m_finished);
+    VERIFY(m_finished || m_synced);
 }
 
 ErrorOr<Bytes> DeflateCompressor::read_some(Bytes)
@@ -494,6 +494,9 @@ ErrorOr<size_t> DeflateCompressor::write_some(ReadonlyBytes bytes)
 {
     VERIFY(!m_finished);
 
+    if (!bytes.is_empty())
+        m_synced = false;
+
     size_t total_written = 0;
     while (!bytes.is_empty()) {
         auto n_written = bytes.copy_trimmed_to(pending_block().slice(m_pending_block_size));
@@ -569,7 +572,7 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             break; // no remaining candidates
 
         VERIFY(candidate < start);
-        if (start - candidate > window_size)
+        if (start - candidate > max_distance)
             break; // outside the window
 
         auto match_length = compare_match_candidate(start, candidate, previous_match_length, maximum_match_length);
@@ -607,6 +610,10 @@ void DeflateCompressor::lz77_compress_block()
         m_hash_head[hash] = window_pos;
     };
 
+    // make the data that came before this block available to back references
+    for (auto position = block_size - m_history_size; position < block_size; position++)
+        insert_hash(position, hash_sequence(&m_rolling_window[position]));
+
     auto emit_literal = [&](auto literal) {
         VERIFY(m_pending_symbol_size <= block_size + 1);
         auto index = m_pending_symbol_size++;
@@ -876,6 +883,7 @@ ErrorOr<void> DeflateCompressor::flush()
 
     if (m_compression_level == CompressionLevel::STORE) { // disabled compression fast path
         TRY(write_uncompressed());
+        update_history();
         m_pending_block_size = 0;
         return {};
     }
@@ -940,16 +948,24 @@ ErrorOr<void> DeflateCompressor::flush()
         TRY(m_output_stream->align_to_byte_boundary());
 
     // reset all block specific members
+    update_history();
     m_pending_block_size = 0;
     m_pending_symbol_size = 0;
     m_symbol_frequencies.fill(0);
     m_distance_frequencies.fill(0);
-    // On the final block this copy will potentially produce an invalid search window, but since its the final block we dont care
-    pending_block().copy_trimmed_to({ m_rolling_window, block_size });
 
     return {};
 }
 
+void DeflateCompressor::update_history()
+{
+    // The history is whatever came right before the next block, which is the end of the current history followed by the pending block
+    auto history_size = min(m_history_size + m_pending_block_size, block_size);
+    auto history_end = block_size + m_pending_block_size;
+    memmove(m_rolling_window + block_size - history_size, m_rolling_window + history_end - history_size, history_size);
+    m_history_size = history_size;
+}
+
 ErrorOr<void> DeflateCompressor::final_flush()
 {
     VERIFY(!m_finished);
@@ -959,6 +975,34 @@ ErrorOr<void> DeflateCompressor::final_flush()
     return {};
 }
 
+ErrorOr<void> DeflateCompressor::sync_flush()
+{
+    VERIFY(!m_finished);
+
+    if (m_pending_block_size != 0)
+        TRY(flush());
+
+    // an empty non-final stored block, whose length fields start on a byte boundary
+    TRY(m_output_stream->write_bits(0b000u, 3));
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0));
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0xffff));
+    TRY(m_output_stream->flush_buffer_to_stream());
+
+    m_synced = true;
+    return {};
+}
+
+void DeflateCompressor::set_dictionary(ReadonlyBytes dictionary)
+{
+    VERIFY(m_pending_block_size == 0 && m_history_size == 0);
+
+    if (dictionary.size() > block_size)
+        dictionary = dictionary.slice(dictionary.size() - block_size);
+    dictionary.copy_to({ m_rolling_window + block_size - dictionary.size(), dictionary.size() });
+    m_history_size = dictionary.size();
+}
+
 ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
@@ -138,6 +138,7 @@ public:
     static constexpr size_t max_huffman_distances = 32;
     static constexpr size_t min_match_length = 4;   // matches smaller than these are not worth the size of the back reference
     static constexpr size_t max_match_length = 258; // matches longer than these cannot be encoded using huffman codes
+    static constexpr size_t max_distance = 32 * KiB; // back references cannot reach further back than this
     static constexpr u16 empty_slot = UINT16_MAX;
 
     struct CompressionConstants {
@@ -174,6 +175,14 @@ public:
     virtual void close() override;
     ErrorOr<void> final_flush();
 
+    // Writes out all pending data without ending the stream, followed by an empty stored block that brings the
+    // output to a byte boundary. A stream that stops here can be continued by simply appending another one.
+    ErrorOr<void> sync_flush();
+
+    // Lets back references point into the given data, as if it had been compressed right before the stream
+    // started. Has to be called before writing anything.
+    void set_dictionary(ReadonlyBytes);
+
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
 
 private:
@@ -203,14 +212,17 @@ private:
     size_t fixed_block_length();
     size_t dynamic_block_length(Array<u8, max_huffman_literals> const& literal_bit_lengths, Array<u8, max_huffman_distances> const& distance_bit_lengths, Array<u8, 19> const& code_lengths_bit_lengths, Array<u16, 19> const& code_lengths_frequencies, size_t code_lengths_count);
     ErrorOr<void> flush();
+    void update_history();
 
     bool m_finished { false };
+    bool m_synced { false };
     CompressionLevel m_compression_level;
     CompressionConstants m_compression_constants;
     NonnullOwnPtr<LittleEndianOutputBitStream> m_output_stream;
 
     u8 m_rolling_window[window_size];
     size_t m_pending_block_size { 0 };
+    size_t m_history_size { 0 }; // how many bytes right before the pending block back references can point to
 
     struct [[gnu::packed]] {
         u16 distance; // back reference length
@@ -10,6 +10,7 @@
 #include <AK/BitStream.h>
 #include <AK/MemoryStream.h>
 #include <AK/String.h>
+#include <LibCompress/ParallelDeflate.h>
 #include <LibCore/DateTime.h>
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
@@ -189,8 +190,9 @@ ErrorOr<size_t> GzipDecompressor::write_some(ReadonlyBytes)
     return Error::from_errno(EBADF);
 }
 
-GzipCompressor::GzipCompressor(MaybeOwned<Stream> stream)
+GzipCompressor::GzipCompressor(MaybeOwned<Stream> stream, ParallelDeflateCompressor* parallel_compressor)
     : m_output_stream(move(stream))
+    , m_parallel_compressor(parallel_compressor)
 {
 }
 
@@ -210,11 +212,16 @@ ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
     header.extra_flags = 3;      // DEFLATE sets 2 for maximum compression and 4 for minimum compression
     header.operating_system = 3; // unix
     TRY(m_output_stream->write_until_depleted({ &header, sizeof(header) }));
-    auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
-    TRY(compressed_stream->write_until_depleted(bytes));
-    TRY(compressed_stream->final_flush());
     Crypto::Checksum::CRC32 crc32;
-    crc32.update(bytes);
+    if (m_parallel_compressor) {
+        auto compressed = TRY(m_parallel_compressor->compress_all(bytes, [&] { crc32.update(bytes); }));
+        TRY(m_output_stream->write_until_depleted(compressed));
+    } else {
+        auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
+        TRY(compressed_stream->write_until_depleted(bytes));
+        TRY(compressed_stream->final_flush());
+        crc32.update(bytes);
+    }
     TRY(m_output_stream->write_value<LittleEndian<u32>>(crc32.digest()));
     TRY(m_output_stream->write_value<LittleEndian<u32>>(bytes.size()));
     return bytes.size();
@@ -234,10 +241,10 @@ void GzipCompressor::close()
 {
 }
 
-ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes)
+ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes, ParallelDeflateCompressor* parallel_compressor)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
-    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream) };
+    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream), parallel_compressor };
 
     TRY(gzip_stream.write_until_depleted(bytes));
 
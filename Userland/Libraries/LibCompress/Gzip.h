@@ -15,6 +15,8 @@
 
 namespace Compress {
 
+class ParallelDeflateCompressor;
+
 constexpr u8 gzip_magic_1 = 0x1f;
 constexpr u8 gzip_magic_2 = 0x8b;
 struct [[gnu::packed]] BlockHeader {
@@ -83,7 +85,8 @@ private:
 
 class GzipCompressor final : public Stream {
 public:
-    GzipCompressor(MaybeOwned<Stream>);
+    // If a parallel compressor is given, it is used to compress the data on multiple threads. It has to outlive the stream.
+    GzipCompressor(MaybeOwned<Stream>, ParallelDeflateCompressor* = nullptr);
 
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
@@ -91,10 +94,11 @@ public:
     virtual bool is_open() const override;
     virtual void close() override;
 
-    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes);
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, ParallelDeflateCompressor* = nullptr);
 
 private:
     MaybeOwned<Stream> m_output_stream;
+    ParallelDeflateCompressor* m_parallel_compressor { nullptr };
 };
 
 }
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCompress/ParallelDeflate.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+
+namespace Compress {
+
+ErrorOr<NonnullOwnPtr<ParallelDeflateCompressor>> ParallelDeflateCompressor::create(size_t thread_count, CompressionLevel compression_level, size_t chunk_size)
+{
+    VERIFY(thread_count > 0);
+    VERIFY(chunk_size > 0);
+    return adopt_nonnull_own_or_enomem(new (nothrow) ParallelDeflateCompressor(thread_count, compression_level, chunk_size));
+}
+
+ParallelDeflateCompressor::ParallelDeflateCompressor(size_t thread_count, CompressionLevel compression_level, size_t chunk_size)
+    : m_compression_level(compression_level)
+    , m_chunk_size(chunk_size)
+    , m_thread_pool([](Function<void()> work) { work(); }, thread_count)
+{
+}
+
+ParallelDeflateCompressor::~ParallelDeflateCompressor() = default;
+
+ErrorOr<ByteBuffer> ParallelDeflateCompressor::compress_chunk(ReadonlyBytes dictionary, ReadonlyBytes chunk, bool is_last_chunk, CompressionLevel compression_level)
+{
+    AllocatingMemoryStream output_stream;
+    auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(output_stream), compression_level));
+    deflate_stream->set_dictionary(dictionary);
+
+    TRY(deflate_stream->write_until_depleted(chunk));
+    if (is_last_chunk)
+        TRY(deflate_stream->final_flush());
+    else
+        TRY(deflate_stream->sync_flush());
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
+    TRY(output_stream.read_until_filled(buffer));
+    return buffer;
+}
+
+ErrorOr<ByteBuffer> ParallelDeflateCompressor::compress_all(ReadonlyBytes bytes, Function<void()> const& work_while_waiting)
+{
+    // Even empty input needs a final block.
+    auto chunk_count = max(ceil_div(bytes.size(), m_chunk_size), 1uz);
+
+    Vector<ByteBuffer> compressed_chunks;
+    Vector<Optional<Error>> errors;
+    TRY(compressed_chunks.try_resize(chunk_count));
+    TRY(errors.try_resize(chunk_count));
+
+    Threading::Mutex mutex;
+    Threading::ConditionVariable all_chunks_done { mutex };
+    size_t remaining_chunks = chunk_count;
+
+    for (size_t i = 0; i < chunk_count; ++i) {
+        m_thread_pool.submit([&, i] {
+            auto offset = i * m_chunk_size;
+            auto chunk = bytes.slice(offset, min(m_chunk_size, bytes.size() - offset));
+            auto result = compress_chunk(bytes.trim(offset), chunk, i == chunk_count - 1, m_compression_level);
+
+            Threading::MutexLocker locker(mutex);
+            if (result.is_error())
+                errors[i] = result.release_error();
+            else
+                compressed_chunks[i] = result.release_value();
+
+            if (--remaining_chunks == 0)
+                all_chunks_done.signal();
+        });
+    }
+
+    if (work_while_waiting)
+        work_while_waiting();
+
+    {
+        Threading::MutexLocker locker(mutex);
+        all_chunks_done.wait_while([&] { return remaining_chunks > 0; });
+    }
+
+    size_t total_size = 0;
+    for (size_t i = 0; i < chunk_count; ++i) {
+        if (errors[i].has_value())
+            return errors[i].release_value();
+        total_size += compressed_chunks[i].size();
+    }
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(total_size));
+    size_t offset = 0;
+    for (auto const& compressed_chunk : compressed_chunks) {
+        buffer.overwrite(offset, compressed_chunk.data(), compressed_chunk.size());
+        offset += compressed_chunk.size();
+    }
+    return buffer;
+}
+
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibCompress/Deflate.h>
+#include <LibThreading/ThreadPool.h>
+
+namespace Compress {
+
+// Compresses data on a pool of threads, in the same way as pigz: the input is cut into chunks which
+// are compressed independently, each one primed with the data of the chunks before it, so that back
+// references can still reach across chunk boundaries. All chunks but the last end with a sync flush,
+// which lets their outputs be concatenated into a single deflate stream.
+//
+// The pool is kept around between calls, so a single compressor can be used for many inputs.
+class ParallelDeflateCompressor {
+    AK_MAKE_NONCOPYABLE(ParallelDeflateCompressor);
+    AK_MAKE_NONMOVABLE(ParallelDeflateCompressor);
+
+public:
+    using CompressionLevel = DeflateCompressor::CompressionLevel;
+
+    // Every chunk costs us a sync flush and a fresh set of huffman codes, so chunks shouldn't be too small.
+    static constexpr size_t default_chunk_size = 128 * KiB;
+
+    static ErrorOr<NonnullOwnPtr<ParallelDeflateCompressor>> create(size_t thread_count, CompressionLevel = CompressionLevel::GOOD, size_t chunk_size = default_chunk_size);
+    ~ParallelDeflateCompressor();
+
+    CompressionLevel compression_level() const { return m_compression_level; }
+
+    // Returns a complete deflate stream holding the given bytes. While the chunks are being compressed,
+    // the calling thread runs work_while_waiting, e.g. to calculate a checksum of the input.
+    ErrorOr<ByteBuffer> compress_all(ReadonlyBytes, Function<void()> const& work_while_waiting = {});
+
+private:
+    ParallelDeflateCompressor(size_t thread_count, CompressionLevel, size_t chunk_size);
+
+    static ErrorOr<ByteBuffer> compress_chunk(ReadonlyBytes dictionary, ReadonlyBytes chunk, bool is_last_chunk, CompressionLevel);
+
+    CompressionLevel m_compression_level;
+    size_t m_chunk_size { 0 };
+    Threading::ThreadPool<Function<void()>> m_thread_pool;
+};
+
+}
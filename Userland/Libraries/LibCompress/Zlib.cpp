@@ -11,6 +11,7 @@
 #include <AK/TypeCasts.h>
 #include <AK/Types.h>
 #include <LibCompress/Deflate.h>
+#include <LibCompress/ParallelDeflate.h>
 #include <LibCompress/Zlib.h>
 
 namespace Compress {
@@ -73,7 +74,7 @@ ErrorOr<NonnullOwnPtr<ZlibCompressor>> ZlibCompressor::construct(MaybeOwned<Stre
     auto compressor_stream = TRY(DeflateCompressor::construct(MaybeOwned(*stream), static_cast<DeflateCompressor::CompressionLevel>(compression_level)));
 
     auto zlib_compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ZlibCompressor(move(stream), move(compressor_stream))));
-    TRY(zlib_compressor->write_header(compression_method, compression_level));
+    TRY(write_header(*zlib_compressor->m_output_stream, compression_method, compression_level));
 
     return zlib_compressor;
 }
@@ -89,7 +90,7 @@ ZlibCompressor::~ZlibCompressor()
     VERIFY(m_finished);
 }
 
-ErrorOr<void> ZlibCompressor::write_header(ZlibCompressionMethod compression_method, ZlibCompressionLevel compression_level)
+ErrorOr<void> ZlibCompressor::write_header(Stream& stream, ZlibCompressionMethod compression_method, ZlibCompressionLevel compression_level)
 {
     u8 compression_info = 0;
     if (compression_method == ZlibCompressionMethod::Deflate) {
@@ -108,7 +109,7 @@ ErrorOr<void> ZlibCompressor::write_header(ZlibCompressionMethod compression_met
 
     // FIXME: Support pre-defined dictionaries.
 
-    TRY(m_output_stream->write_value(header.as_u16));
+    TRY(stream.write_value(header.as_u16));
 
     return {};
 }
@@ -171,4 +172,25 @@ ErrorOr<ByteBuffer> ZlibCompressor::compress_all(ReadonlyBytes bytes, ZlibCompre
     return buffer;
 }
 
+ErrorOr<ByteBuffer> ZlibCompressor::compress_all(ReadonlyBytes bytes, ParallelDeflateCompressor& parallel_compressor)
+{
+    auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+
+    // Map the level back the same way construct() maps it forward. The header has no room for Deflate's "Best" level.
+    auto compression_level = min(static_cast<u8>(parallel_compressor.compression_level()), to_underlying(ZlibCompressionLevel::Best));
+    TRY(write_header(*output_stream, ZlibCompressionMethod::Deflate, static_cast<ZlibCompressionLevel>(compression_level)));
+
+    Crypto::Checksum::Adler32 adler32_checksum;
+    auto compressed = TRY(parallel_compressor.compress_all(bytes, [&] { adler32_checksum.update(bytes); }));
+    TRY(output_stream->write_until_depleted(compressed));
+
+    NetworkOrdered<u32> adler_sum = adler32_checksum.digest();
+    TRY(output_stream->write_value(adler_sum));
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream->used_buffer_size()));
+    TRY(output_stream->read_until_filled(buffer.bytes()));
+
+    return buffer;
+}
+
 }
@@ -18,6 +18,8 @@
 
 namespace Compress {
 
+class ParallelDeflateCompressor;
+
 enum class ZlibCompressionMethod : u8 {
     Deflate = 8,
 };
@@ -74,10 +76,11 @@ public:
     ErrorOr<void> finish();
 
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, ZlibCompressionLevel = ZlibCompressionLevel::Default);
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, ParallelDeflateCompressor&);
 
 private:
     ZlibCompressor(MaybeOwned<Stream> stream, NonnullOwnPtr<Stream> compressor_stream);
-    ErrorOr<void> write_header(ZlibCompressionMethod, ZlibCompressionLevel);
+    static ErrorOr<void> write_header(Stream&, ZlibCompressionMethod, ZlibCompressionLevel);
 
     bool m_finished { false };
     MaybeOwned<Stream> m_output_stream;
@@ -20,6 +20,10 @@
 #include <sys/select.h>
 #include <unistd.h>
 
+#ifdef AK_OS_SERENITY
+#    include <sys/epoll.h>
+#endif
+
 namespace Core {
 
 namespace {
@@ -33,6 +37,37 @@ static pthread_rwlock_t* s_thread_data_lock = nullptr;
 thread_local pthread_t s_thread_id;
 thread_local OwnPtr<ThreadData> s_this_thread_data;
 
+bool has_flag(int value, int flag)
+{
+    return (value & flag) == flag;
+}
+
+#ifdef AK_OS_SERENITY
+// The kernel keeps the interest set, so a wakeup costs the same no matter how many idle notifiers there are.
+u32 notification_type_to_epoll_events(NotificationType type)
+{
+    u32 events = 0;
+    if (has_flag(type, NotificationType::Read))
+        events |= EPOLLIN;
+    if (has_flag(type, NotificationType::Write))
+        events |= EPOLLOUT;
+    return events;
+}
+
+NotificationType epoll_events_to_notification_type(u32 events)
+{
+    NotificationType type = NotificationType::None;
+    if (has_flag(events, EPOLLIN))
+        type |= NotificationType::Read;
+    if (has_flag(events, EPOLLOUT))
+        type |= NotificationType::Write;
+    if (has_flag(events, EPOLLHUP))
+        type |= NotificationType::HangUp;
+    if (has_flag(events, EPOLLERR))
+        type |= NotificationType::Error;
+    return type;
+}
+#else
 short notification_type_to_poll_events(NotificationType type)
 {
     short events = 0;
@@ -42,11 +77,7 @@ short notification_type_to_poll_events(NotificationType type)
         events |= POLLOUT;
     return events;
 }
-
-bool has_flag(int value, int flag)
-{
-    return (value & flag) == flag;
-}
+#endif
 
 class EventLoopTimeout {
 public:
@@ -280,18 +311,57 @@ struct ThreadData {
 
         wake_pipe_fds = result.release_value();
 
+#ifdef AK_OS_SERENITY
+        // A forked child must not share the interest set of its parent, so always start with a new one.
+        if (epoll_fd != -1)
+            close(epoll_fd);
+        auto epoll_fd_or_error = Core::System::epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd_or_error.is_error()) {
+            warnln("\033[31;1mFailed to create event loop epoll:\033[0m {}", epoll_fd_or_error.error());
+            VERIFY_NOT_REACHED();
+        }
+        epoll_fd = epoll_fd_or_error.release_value();
+
+        // The wake pipe informs us of POSIX signals as well as manual calls to wake()
+        VERIFY(notifiers_by_fd.is_empty());
+        epoll_event event { .events = EPOLLIN, .data = { .fd = wake_pipe_fds[0] } };
+        MUST(Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_pipe_fds[0], &event));
+#else
         // The wake pipe informs us of POSIX signals as well as manual calls to wake()
         VERIFY(poll_fds.size() == 0);
         poll_fds.append({ .fd = wake_pipe_fds[0], .events = POLLIN, .revents = 0 });
         notifier_by_index.append(nullptr);
+#endif
     }
 
+#ifdef AK_OS_SERENITY
+    void update_epoll_interest(int fd, int operation)
+    {
+        u32 events = 0;
+        if (auto notifiers = notifiers_by_fd.get(fd); notifiers.has_value()) {
+            for (auto* notifier : *notifiers)
+                events |= notification_type_to_epoll_events(notifier->type());
+        }
+        epoll_event event { .events = events, .data = { .fd = fd } };
+        // Like poll() did, tolerate notifiers for fds that were already closed.
+        auto result = Core::System::epoll_ctl(epoll_fd, operation, fd, &event);
+        if (result.is_error() && operation != EPOLL_CTL_DEL)
+            dbgln("EventLoopImplementationUnix: Failed to update interest in fd {}: {}", fd, result.error());
+    }
+#endif
+
     // Each thread has its own timers, notifiers and a wake pipe.
     TimeoutSet timeouts;
 
+#ifdef AK_OS_SERENITY
+    int epoll_fd { -1 };
+    // Several notifiers can share an fd, while the interest set only has one entry for it.
+    HashMap<int, Vector<Notifier*, 1>> notifiers_by_fd;
+#else
     Vector<pollfd> poll_fds;
     HashMap<Notifier*, size_t> notifier_by_ptr;
     Vector<Notifier*> notifier_by_index;
+#endif
 
     // The wake pipe is used to notify another event loop that someone has called wake(), or a signal has been received.
     // wake() writes 0i32 into the pipe, signals write the signal number (guaranteed non-zero).
@@ -383,7 +453,13 @@ retry:
 
 try_select_again:
     // select() and wait for file system events, calls to wake(), POSIX signals, or timer expirations.
+#ifdef AK_OS_SERENITY
+    // Level-triggered, so anything that doesn't fit in here is reported again on the next iteration.
+    Array<epoll_event, 64> ready_events;
+    ErrorOr<int> error_or_marked_fd_count = System::epoll_wait(thread_data.epoll_fd, ready_events, should_wait_forever ? -1 : timeout);
+#else
     ErrorOr<int> error_or_marked_fd_count = System::poll(thread_data.poll_fds, should_wait_forever ? -1 : timeout);
+#endif
     auto time_after_poll = MonotonicTime::now_coarse();
     // Because POSIX, we might spuriously return from select() with EINTR; just select again.
     if (error_or_marked_fd_count.is_error()) {
@@ -393,9 +469,20 @@ try_select_again:
         VERIFY_NOT_REACHED();
     }
 
+    bool wake_pipe_is_readable = false;
+#ifdef AK_OS_SERENITY
+    auto marked_events = ready_events.span().trim(error_or_marked_fd_count.value());
+    for (auto& event : marked_events) {
+        if (event.data.fd == thread_data.wake_pipe_fds[0])
+            wake_pipe_is_readable = has_flag(event.events, EPOLLIN);
+    }
+#else
+    wake_pipe_is_readable = has_flag(thread_data.poll_fds[0].revents, POLLIN);
+#endif
+
     // We woke up due to a call to wake() or a POSIX signal.
     // Handle signals and see whether we need to handle events as well.
-    if (has_flag(thread_data.poll_fds[0].revents, POLLIN)) {
+    if (wake_pipe_is_readable) {
         int wake_events[8];
         ssize_t nread;
         // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
@@ -424,6 +511,19 @@ try_select_again:
             goto retry;
     }
 
+#ifdef AK_OS_SERENITY
+    // Handle file system notifiers by making them normal events.
+    for (auto& event : marked_events) {
+        auto notifiers = thread_data.notifiers_by_fd.get(event.data.fd);
+        if (!notifiers.has_value())
+            continue;
+        for (auto* notifier : *notifiers) {
+            auto type = epoll_events_to_notification_type(event.events) & notifier->type();
+            if (type != NotificationType::None)
+                ThreadEventQueue::current().post_event(*notifier, make<NotifierActivationEvent>(notifier->fd(), type));
+        }
+    }
+#else
     if (error_or_marked_fd_count.value() != 0) {
         // Handle file system notifiers by making them normal events.
         for (size_t i = 1; i < thread_data.poll_fds.size(); ++i) {
@@ -444,6 +544,7 @@ try_select_again:
                 ThreadEventQueue::current().post_event(notifier, make<NotifierActivationEvent>(notifier.fd(), type));
         }
     }
+#endif
 
     // Handle expired timers.
     thread_data.timeouts.fire_expired(time_after_poll);
@@ -520,9 +621,13 @@ void EventLoopImplementationUnix::notify_forked_and_in_child()
 {
     auto& thread_data = ThreadData::the();
     thread_data.timeouts.clear();
+#ifdef AK_OS_SERENITY
+    thread_data.notifiers_by_fd.clear();
+#else
     thread_data.poll_fds.clear();
     thread_data.notifier_by_ptr.clear();
     thread_data.notifier_by_index.clear();
+#endif
     thread_data.initialize_wake_pipe();
     if (auto* info = signals_info<false>()) {
         info->signal_handlers.clear();
@@ -678,6 +783,11 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
 {
     auto& thread_data = ThreadData::the();
 
+#ifdef AK_OS_SERENITY
+    auto& notifiers = thread_data.notifiers_by_fd.ensure(notifier.fd());
+    notifiers.append(&notifier);
+    thread_data.update_epoll_interest(notifier.fd(), notifiers.size() == 1 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD);
+#else
     thread_data.notifier_by_ptr.set(&notifier, thread_data.poll_fds.size());
     thread_data.notifier_by_index.append(&notifier);
     thread_data.poll_fds.append({
@@ -685,6 +795,7 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
         .events = notification_type_to_poll_events(notifier.type()),
         .revents = 0,
     });
+#endif
 
     notifier.set_owner_thread(s_thread_id);
 }
@@ -696,6 +807,18 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
         return;
 
     auto& thread_data = *thread_data_ptr;
+#ifdef AK_OS_SERENITY
+    auto it = thread_data.notifiers_by_fd.find(notifier.fd());
+    VERIFY(it != thread_data.notifiers_by_fd.end());
+    bool did_remove = it->value.remove_first_matching([&](auto* other) { return other == &notifier; });
+    VERIFY(did_remove);
+    if (it->value.is_empty()) {
+        thread_data.notifiers_by_fd.remove(it);
+        thread_data.update_epoll_interest(notifier.fd(), EPOLL_CTL_DEL);
+    } else {
+        thread_data.update_epoll_interest(notifier.fd(), EPOLL_CTL_MOD);
+    }
+#else
     auto it = thread_data.notifier_by_ptr.find(&notifier);
     VERIFY(it != thread_data.notifier_by_ptr.end());
 
@@ -709,6 +832,7 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
     }
     thread_data.poll_fds.take_last();
     thread_data.notifier_by_index.take_last();
+#endif
 }
 
 void EventLoopManagerUnix::did_post_event()
@@ -196,6 +196,13 @@ public:
     ErrorOr<void> set_blocking(bool enabled) override { return m_helper.set_blocking(enabled); }
     ErrorOr<void> set_close_on_exec(bool enabled) override { return m_helper.set_close_on_exec(enabled); }
 
+    Optional<int> fd() const
+    {
+        if (!is_open())
+            return {};
+        return m_helper.fd();
+    }
+
     virtual ~TCPSocket() override { close(); }
 
 private:
@@ -433,6 +440,9 @@ public:
 
     virtual size_t buffer_size() const override { return m_helper.buffer_size(); }
 
+    // Writes aren't buffered, so the fd can be written to directly (e.g. with sendfile()).
+    Optional<int> fd() const { return m_helper.stream().fd(); }
+
     virtual ~BufferedSocket() override = default;
 
 private:
@@ -49,6 +49,11 @@
 #    include <Kernel/API/Unshare.h>
 #endif
 
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+#    include <sys/epoll.h>
+#    include <sys/sendfile.h>
+#endif
+
 namespace Core::System {
 
 #ifdef AK_OS_SERENITY
@@ -243,6 +248,13 @@ ErrorOr<void> access(StringView pathname, int mode, int flags = 0);
 ErrorOr<ByteString> readlink(StringView pathname);
 ErrorOr<int> poll(Span<struct pollfd>, int timeout);
 
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+ErrorOr<int> epoll_create1(int flags);
+ErrorOr<void> epoll_ctl(int epfd, int op, int fd, struct epoll_event* event);
+ErrorOr<int> epoll_wait(int epfd, Span<struct epoll_event>, int timeout);
+ErrorOr<size_t> sendfile(int out_fd, int in_fd, off_t* offset, size_t count);
+#endif
+
 #ifdef AK_OS_SERENITY
 ErrorOr<void> create_block_device(StringView name, mode_t mode, unsigned major, unsigned minor);
 ErrorOr<void> create_char_device(StringView name, mode_t mode, unsigned major, unsigned minor);
@@ -281,6 +293,7 @@ private:
 ErrorOr<AddressInfoVector> getaddrinfo(char const* nodename, char const* servname, struct addrinfo const& hints);
 
 #ifdef AK_OS_SERENITY
+ErrorOr<void> posix_fadvise(int fd, off_t offset, off_t length, int advice);
 ErrorOr<void> posix_fallocate(int fd, off_t offset, off_t length);
 #endif
 
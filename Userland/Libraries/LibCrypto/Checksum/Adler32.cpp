@@ -4,13 +4,19 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/CPUFeatures.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <LibCrypto/Checksum/Adler32.h>
 
 namespace Crypto::Checksum {
 
-void Adler32::update(ReadonlyBytes data)
+static constexpr u32 modulus = 65521;
+
+template<>
+void Adler32::update_impl<CPUFeatures::None>(ReadonlyBytes data)
 {
     // See https://github.com/SerenityOS/serenity/pull/24408#discussion_r1609051678
     constexpr size_t iterations_without_overflow = 380368439;
@@ -32,14 +38,86 @@ void Adler32::update(ReadonlyBytes data)
             state_a += byte;
             state_b += state_a;
         }
-        state_a %= 65521;
-        state_b %= 65521;
+        state_a %= modulus;
+        state_b %= modulus;
         data = data.slice(chunk.size());
     }
     m_state_a = state_a;
     m_state_b = state_b;
 }
 
+#if AK_CAN_CODEGEN_FOR_X86_SSSE3
+template<>
+[[gnu::target("ssse3")]] void Adler32::update_impl<CPUFeatures::X86_SSSE3>(ReadonlyBytes data)
+{
+    using AK::SIMD::c8x16, AK::SIMD::i16x8, AK::SIMD::u32x4;
+
+    // This is the largest block after which the sums still fit into 32 bits, starting from sums of
+    // at most 65520, and it happens to be a multiple of 16. See NMAX in zlib's adler32.c.
+    constexpr size_t max_block_size = 5552;
+
+    // Every byte of a 16-byte vector is added to state_b once for every byte that follows it in
+    // the vector, and once more for itself.
+    constexpr c8x16 weights { 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+    constexpr i16x8 ones { 1, 1, 1, 1, 1, 1, 1, 1 };
+
+    u32 state_a = m_state_a;
+    u32 state_b = m_state_b;
+
+    while (data.size()) {
+        auto block = data.trim(max_block_size);
+        auto vector_count = block.size() / 16;
+
+        // Lane-wise partial sums, the first lanes of which start out with the current state.
+        u32x4 sums_a { state_a, 0, 0, 0 };
+        u32x4 sums_b { state_b, 0, 0, 0 };
+        // The sum of all values state_a had before each vector; all of these are added to state_b 16 times.
+        u32x4 previous_sums_a {};
+
+        for (size_t i = 0; i < vector_count; ++i) {
+            auto bytes = AK::SIMD::load_unaligned<c8x16>(block.data() + i * 16);
+
+            previous_sums_a += sums_a;
+            sums_a += bit_cast<u32x4>(__builtin_ia32_psadbw128(bytes, c8x16 {}));
+            auto weighted_pairs = __builtin_ia32_pmaddubsw128(bytes, weights);
+            sums_b += bit_cast<u32x4>(__builtin_ia32_pmaddwd128(weighted_pairs, ones));
+        }
+        sums_b += previous_sums_a * 16;
+
+        state_a = (sums_a[0] + sums_a[1] + sums_a[2] + sums_a[3]) % modulus;
+        state_b = (sums_b[0] + sums_b[1] + sums_b[2] + sums_b[3]) % modulus;
+
+        for (u8 byte : block.slice(vector_count * 16)) {
+            state_a += byte;
+            state_b += state_a;
+        }
+        state_a %= modulus;
+        state_b %= modulus;
+
+        data = data.slice(block.size());
+    }
+
+    m_state_a = state_a;
+    m_state_b = state_b;
+}
+#endif
+
+decltype(Adler32::update_dispatched) Adler32::update_dispatched = [] {
+    CPUFeatures features = detect_cpu_features();
+
+    if constexpr (is_valid_feature(CPUFeatures::X86_SSSE3)) {
+        if (has_flag(features, CPUFeatures::X86_SSSE3))
+            return &Adler32::update_impl<CPUFeatures::X86_SSSE3>;
+    }
+
+    return &Adler32::update_impl<CPUFeatures::None>;
+}();
+
+void Adler32::update(ReadonlyBytes data)
+{
+    (this->*update_dispatched)(data);
+}
+
 u32 Adler32::digest()
 {
     return (m_state_b << 16) | m_state_a;
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/CPUFeatures.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <LibCrypto/Checksum/ChecksumFunction.h>
@@ -31,6 +32,11 @@ public:
     virtual u32 digest() override;
 
 private:
+    template<CPUFeatures>
+    void update_impl(ReadonlyBytes);
+
+    static void (Adler32::*const update_dispatched)(ReadonlyBytes);
+
     u32 m_state_a { 1 };
     u32 m_state_b { 0 };
 };
@@ -5,7 +5,10 @@
  */
 
 #include <AK/Array.h>
+#include <AK/CPUFeatures.h>
 #include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <LibCrypto/Checksum/CRC32.h>
@@ -46,8 +49,6 @@ void CRC32::update(ReadonlyBytes span)
     }
 }
 
-// FIXME: On Intel, use _mm_crc32_u8 / _mm_crc32_u64 if available (SSE 4.2).
-
 #else
 
 static constexpr size_t ethernet_polynomial = 0xEDB88320;
@@ -104,7 +105,8 @@ static constexpr u32 single_byte_crc(u32 crc, u8 byte)
     return (crc >> 8) ^ table[0][(crc & 0xff) ^ byte];
 }
 
-void CRC32::update(ReadonlyBytes data)
+template<>
+void CRC32::update_impl<CPUFeatures::None>(ReadonlyBytes data)
 {
     // The provided data may not be aligned to a 4-byte boundary, required to reinterpret its address
     // into a u32 in the loop below. So we split the bytes into two segments: the misaligned bytes
@@ -159,7 +161,8 @@ static constexpr auto generate_table()
 
 static constexpr auto table = generate_table();
 
-void CRC32::update(ReadonlyBytes data)
+template<>
+void CRC32::update_impl<CPUFeatures::None>(ReadonlyBytes data)
 {
     for (size_t i = 0; i < data.size(); i++) {
         m_state = table[(m_state ^ data.at(i)) & 0xFF] ^ (m_state >> 8);
@@ -167,6 +170,108 @@ void CRC32::update(ReadonlyBytes data)
 }
 
 #    endif
+
+// Note: The crc32 instruction that comes with SSE4.2 calculates CRC-32C, which uses a different polynomial
+//       than ours, so it is of no use here. Instead, we use carry-less multiplication to fold the input into
+//       a 128-bit remainder, as described in Intel's "Fast CRC Computation for Generic Polynomials Using
+//       PCLMULQDQ Instruction" paper. The constants below are the bit-reflected ones given at its end.
+#    if AK_CAN_CODEGEN_FOR_X86_PCLMUL
+using illx2 = signed long long int __attribute__((vector_size(16)));
+
+template<u8 selector>
+[[gnu::target("pclmul"), gnu::always_inline]] static inline AK::SIMD::u64x2 carry_less_multiply(AK::SIMD::u64x2 a, AK::SIMD::u64x2 b)
+{
+    return bit_cast<AK::SIMD::u64x2>(__builtin_ia32_pclmulqdq128(bit_cast<illx2>(a), bit_cast<illx2>(b), selector));
+}
+
+// Multiplies both halves of the remainder by x^(distance) mod P, shifting it forward to be combined with
+// the data that many bits further on.
+[[gnu::target("pclmul"), gnu::always_inline]] static inline AK::SIMD::u64x2 fold(AK::SIMD::u64x2 remainder, AK::SIMD::u64x2 constants)
+{
+    return carry_less_multiply<0x00>(remainder, constants) ^ carry_less_multiply<0x11>(remainder, constants);
+}
+
+// Requires at least 64 bytes of data, and its size to be a multiple of 16.
+[[gnu::target("pclmul")]] static u32 crc32_with_carry_less_multiplication(u32 crc, ReadonlyBytes data)
+{
+    using AK::SIMD::u32x4, AK::SIMD::u64x2;
+
+    constexpr u64x2 fold_by_four_constants { 0x1'5444'2bd4, 0x1'c6e4'1596 };
+    constexpr u64x2 fold_by_one_constants { 0x1'7519'97d0, 0x0'ccaa'009e };
+    constexpr u64x2 fold_to_64_bits_constants { 0x1'63cd'6124, 0 };
+    constexpr u64x2 barrett_constants { 0x1'db71'0641, 0x1'f701'1641 };
+    constexpr u64x2 low_32_bits_mask { 0xffff'ffff, 0xffff'ffff };
+
+    VERIFY(data.size() >= 64 && data.size() % 16 == 0);
+
+    auto const* bytes = data.data();
+    auto remaining = data.size();
+    auto load = [&](size_t offset) { return AK::SIMD::load_unaligned<u64x2>(bytes + offset); };
+
+    u64x2 remainders[4] { load(0), load(16), load(32), load(48) };
+    remainders[0] ^= bit_cast<u64x2>(u32x4 { crc, 0, 0, 0 });
+    bytes += 64;
+    remaining -= 64;
+
+    // Fold four remainders at a time, to keep several multiplications in flight.
+    while (remaining >= 64) {
+        for (size_t i = 0; i < 4; ++i)
+            remainders[i] = fold(remainders[i], fold_by_four_constants) ^ load(i * 16);
+        bytes += 64;
+        remaining -= 64;
+    }
+
+    auto remainder = remainders[0];
+    for (size_t i = 1; i < 4; ++i)
+        remainder = fold(remainder, fold_by_one_constants) ^ remainders[i];
+
+    while (remaining >= 16) {
+        remainder = fold(remainder, fold_by_one_constants) ^ load(0);
+        bytes += 16;
+        remaining -= 16;
+    }
+
+    // Fold the 128-bit remainder down to 64 bits...
+    remainder = carry_less_multiply<0x10>(remainder, fold_by_one_constants) ^ u64x2 { remainder[1], 0 };
+    auto words = bit_cast<u32x4>(remainder);
+    remainder = carry_less_multiply<0x00>(remainder & low_32_bits_mask, fold_to_64_bits_constants) ^ bit_cast<u64x2>(u32x4 { words[1], words[2], words[3], 0 });
+
+    // ...and reduce those to the final 32 bits with a Barrett reduction.
+    auto quotient = carry_less_multiply<0x10>(remainder & low_32_bits_mask, barrett_constants);
+    remainder ^= carry_less_multiply<0x00>(quotient & low_32_bits_mask, barrett_constants);
+
+    return bit_cast<u32x4>(remainder)[1];
+}
+
+template<>
+[[gnu::target("pclmul")]] void CRC32::update_impl<CPUFeatures::X86_PCLMUL>(ReadonlyBytes data)
+{
+    if (data.size() >= 64) {
+        auto folded_size = data.size() & ~15uz;
+        m_state = crc32_with_carry_less_multiplication(m_state, data.trim(folded_size));
+        data = data.slice(folded_size);
+    }
+
+    update_impl<CPUFeatures::None>(data);
+}
+#    endif
+
+decltype(CRC32::update_dispatched) CRC32::update_dispatched = [] {
+    CPUFeatures features = detect_cpu_features();
+
+    if constexpr (is_valid_feature(CPUFeatures::X86_PCLMUL)) {
+        if (has_flag(features, CPUFeatures::X86_PCLMUL))
+            return &CRC32::update_impl<CPUFeatures::X86_PCLMUL>;
+    }
+
+    return &CRC32::update_impl<CPUFeatures::None>;
+}();
+
+void CRC32::update(ReadonlyBytes data)
+{
+    (this->*update_dispatched)(data);
+}
+
 #endif
 
 u32 CRC32::digest()
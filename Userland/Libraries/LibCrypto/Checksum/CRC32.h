@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/CPUFeatures.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <LibCrypto/Checksum/ChecksumFunction.h>
@@ -30,6 +31,11 @@ public:
     virtual u32 digest() override;
 
 private:
+    template<CPUFeatures>
+    void update_impl(ReadonlyBytes);
+
+    static void (CRC32::*const update_dispatched)(ReadonlyBytes);
+
     u32 m_state { ~0u };
 };
 
@@ -55,6 +55,10 @@ ConnectionToWindowServer::ConnectionToWindowServer(NonnullOwnPtr<Core::LocalSock
     Gfx::FontDatabase::set_fixed_width_font_query(message->fixed_width_font_query());
     Gfx::FontDatabase::set_window_title_font_query(message->window_title_font_query());
     m_client_id = message->client_id();
+
+    // Most window messages are small and frequent, which is where the shared memory rings pay off.
+    if (auto result = request_shared_memory_transport(); result.is_error())
+        dbgln("Failed to set up shared memory transport to WindowServer: {}", result.error());
 }
 
 void ConnectionToWindowServer::fast_greet(Vector<Gfx::IntRect> const&, u32, u32, u32, Core::AnonymousBuffer const&, ByteString const&, ByteString const&, ByteString const&, Vector<bool> const&, i32)
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/BitCast.h>
+#include <AK/CPUFeatures.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <LibGfx/BlendingKernels.h>
+
+namespace Gfx {
+
+using namespace AK::SIMD;
+
+template<typename U32Vector, typename I32Vector, typename U16Vector, typename F32Vector>
+struct PixelVectors {
+    using U32 = U32Vector;
+    using I32 = I32Vector;
+    using U16 = U16Vector;
+    using F32 = F32Vector;
+    static constexpr size_t size = vector_length<U32Vector>;
+};
+
+using PixelVectors4 = PixelVectors<u32x4, i32x4, u16x8, f32x4>;
+using PixelVectors8 = PixelVectors<u32x8, i32x8, u16x16, f32x8>;
+
+template<typename V>
+ALWAYS_INLINE static typename V::F32 convert_to_float(typename V::U32 values)
+{
+    // All values we convert fit in an i32, and signed conversions are much cheaper than unsigned ones.
+    return __builtin_convertvector(bit_cast<typename V::I32>(values), typename V::F32);
+}
+
+template<typename V>
+ALWAYS_INLINE static typename V::U32 convert_to_integer(typename V::F32 values)
+{
+    return bit_cast<typename V::U32>(__builtin_convertvector(values, typename V::I32));
+}
+
+template<typename V>
+ALWAYS_INLINE static typename V::U32 round_to_integer(typename V::F32 values)
+{
+    // Rounds to the nearest integer with ties going to the even one, like the cvtss2si behind round_to() does.
+    constexpr float magic = 1.5f * (1 << 23);
+    return convert_to_integer<V>((values + magic) - magic);
+}
+
+template<typename V, typename T>
+ALWAYS_INLINE static T select_lanes(typename V::I32 mask, T if_true, T if_false)
+{
+    auto bits = bit_cast<typename V::U32>(mask);
+    return bit_cast<T>((bit_cast<typename V::U32>(if_true) & bits) | (bit_cast<typename V::U32>(if_false) & ~bits));
+}
+
+template<typename T>
+ALWAYS_INLINE static T swap_red_and_blue(T pixels)
+{
+    return (pixels & 0xff00ff00) | ((pixels & 0xff) << 16) | ((pixels >> 16) & 0xff);
+}
+
+// Color::blend(), for any destination alpha.
+template<typename V>
+ALWAYS_INLINE static typename V::U32 blend(typename V::U32 destination, typename V::U32 source)
+{
+    using U32 = typename V::U32;
+    using I32 = typename V::I32;
+
+    U32 destination_alpha = destination >> 24;
+    U32 source_alpha = source >> 24;
+
+    // All operands and intermediate results are integers below 2^24, which floats represent exactly. The quotient
+    // is either an integer or at least 1/65025 away from the next one, which is more than the rounding error of
+    // the division, so truncating it gives the same result as the integer division in Color::blend().
+    auto da = convert_to_float<V>(destination_alpha);
+    auto sa = convert_to_float<V>(source_alpha);
+    auto divisor = 255 * (da + sa) - da * sa;
+    auto destination_weight = da * (255 - sa);
+    auto source_weight = 255 * sa;
+    auto blend_channel = [&](int shift) -> U32 {
+        auto dc = convert_to_float<V>((destination >> shift) & 0xff);
+        auto sc = convert_to_float<V>((source >> shift) & 0xff);
+        return convert_to_integer<V>((dc * destination_weight + sc * source_weight) / divisor) << shift;
+    };
+    U32 result = blend_channel(0) | blend_channel(8) | blend_channel(16) | (convert_to_integer<V>(divisor / 255) << 24);
+
+    result = select_lanes<V>(static_cast<I32>(source_alpha == 0), destination, result);
+    return select_lanes<V>(static_cast<I32>((destination_alpha == 0) | (source_alpha == 255)), source, result);
+}
+
+// Color::blend() for a destination that is known to be opaque, which is a lot cheaper.
+template<typename V>
+ALWAYS_INLINE static typename V::U32 blend_over_opaque(typename V::U32 destination, typename V::U32 source)
+{
+    using U32 = typename V::U32;
+    using U16 = typename V::U16;
+
+    // With an opaque destination, Color::blend() comes down to (destination * (255 - alpha) + source * alpha) / 255.
+    // That never exceeds 255 * 255, so two channels can be blended at once in 16-bit lanes.
+    U32 source_alpha = source >> 24;
+    U32 inverse_alpha = 255 - source_alpha;
+    auto source_weights = bit_cast<U16>(source_alpha | (source_alpha << 16));
+    auto destination_weights = bit_cast<U16>(inverse_alpha | (inverse_alpha << 16));
+    auto blend_channel_pair = [&](U32 destination_pair, U32 source_pair) -> U32 {
+        auto sum = bit_cast<U16>(destination_pair & 0x00ff00ff) * destination_weights + bit_cast<U16>(source_pair & 0x00ff00ff) * source_weights;
+        // This is exactly sum / 255 for sums up to 255 * 255.
+        return bit_cast<U32>((sum + 1 + (sum >> 8)) >> 8);
+    };
+
+    U32 red_and_blue = blend_channel_pair(destination, source);
+    U32 green = blend_channel_pair(destination >> 8, source >> 8) & 0xff;
+    return 0xff000000 | red_and_blue | (green << 8);
+}
+
+// Color::mixed_with().
+template<typename V>
+ALWAYS_INLINE static typename V::U32 mix(typename V::U32 a, typename V::U32 b, typename V::F32 weight)
+{
+    using U32 = typename V::U32;
+    using I32 = typename V::I32;
+
+    U32 a_alpha = a >> 24;
+    U32 b_alpha = b >> 24;
+    auto a_alpha_float = convert_to_float<V>(a_alpha);
+    auto b_alpha_float = convert_to_float<V>(b_alpha);
+    auto mixed_alpha = a_alpha_float + (b_alpha_float - a_alpha_float) * weight;
+
+    // Colors with the same alpha (or the same color channels) are interpolated directly, all others are mixed
+    // with premultiplied alpha.
+    auto should_interpolate = static_cast<I32>((a_alpha == b_alpha) | ((a & 0xffffff) == (b & 0xffffff)));
+    auto mix_channel = [&](int shift) -> U32 {
+        auto a_channel = convert_to_float<V>((a >> shift) & 0xff);
+        auto b_channel = convert_to_float<V>((b >> shift) & 0xff);
+        auto interpolated = a_channel + (b_channel - a_channel) * weight;
+        auto a_premultiplied = a_channel * a_alpha_float;
+        auto b_premultiplied = b_channel * b_alpha_float;
+        auto premultiplied = (a_premultiplied + (b_premultiplied - a_premultiplied) * weight) / mixed_alpha;
+        return (round_to_integer<V>(select_lanes<V>(should_interpolate, interpolated, premultiplied)) & 0xff) << shift;
+    };
+    return mix_channel(0) | mix_channel(8) | mix_channel(16) | ((round_to_integer<V>(mixed_alpha) & 0xff) << 24);
+}
+
+template<typename V, bool pixels_have_alpha>
+ALWAYS_INLINE static void blend_color_over_pixels_impl(ARGB32* pixels, size_t count, Color color)
+{
+    using U32 = typename V::U32;
+
+    U32 source = U32 {} + color.value();
+    size_t i = 0;
+    for (; i + V::size <= count; i += V::size) {
+        auto destination = load_unaligned<U32>(pixels + i);
+        if constexpr (pixels_have_alpha)
+            store_unaligned(pixels + i, blend<V>(destination, source));
+        else
+            store_unaligned(pixels + i, blend_over_opaque<V>(destination, source));
+    }
+    for (; i < count; ++i) {
+        auto destination = pixels_have_alpha ? Color::from_argb(pixels[i]) : Color::from_rgb(pixels[i]);
+        pixels[i] = destination.blend(color).value();
+    }
+}
+
+template<typename V>
+ALWAYS_INLINE static void blend_color_over_pixels_impl(ARGB32* pixels, size_t count, Color color, bool pixels_have_alpha)
+{
+    if (pixels_have_alpha)
+        blend_color_over_pixels_impl<V, true>(pixels, count, color);
+    else
+        blend_color_over_pixels_impl<V, false>(pixels, count, color);
+}
+
+template<typename V, bool destination_has_alpha>
+ALWAYS_INLINE static void blend_pixels_with_opacity_impl(ARGB32* destination, ARGB32 const* source, size_t count, OpacityBlend const& options)
+{
+    using U32 = typename V::U32;
+
+    // These are the same expressions as in the original per-pixel code, so that they round the same way.
+    Array<u32, 256> alpha_for_source_alpha;
+    bool source_alpha_is_unchanged = true;
+    if (options.source_has_alpha) {
+        for (u32 alpha = 0; alpha < 256; ++alpha) {
+            float pixel_opacity = alpha / 255.0;
+            alpha_for_source_alpha[alpha] = static_cast<u8>(255 * (options.opacity * pixel_opacity));
+            source_alpha_is_unchanged &= alpha_for_source_alpha[alpha] == alpha;
+        }
+    }
+    u32 const alpha_for_opaque_source = static_cast<u8>(options.opacity * 255);
+
+    size_t i = 0;
+    for (; i + V::size <= count; i += V::size) {
+        auto pixels = load_unaligned<U32>(source + i);
+        if (options.source_is_rgba)
+            pixels = swap_red_and_blue(pixels);
+        if (!options.source_has_alpha) {
+            pixels = (pixels & 0xffffff) | (alpha_for_opaque_source << 24);
+        } else if (!source_alpha_is_unchanged) {
+            for (size_t lane = 0; lane < V::size; ++lane)
+                pixels[lane] = (pixels[lane] & 0xffffff) | (alpha_for_source_alpha[pixels[lane] >> 24] << 24);
+        }
+
+        auto destination_pixels = load_unaligned<U32>(destination + i);
+        if constexpr (destination_has_alpha)
+            store_unaligned(destination + i, blend<V>(destination_pixels, pixels));
+        else
+            store_unaligned(destination + i, blend_over_opaque<V>(destination_pixels, pixels));
+    }
+
+    for (; i < count; ++i) {
+        auto pixel = source[i];
+        if (options.source_is_rgba)
+            pixel = swap_red_and_blue(pixel);
+        if (options.source_has_alpha)
+            pixel = (pixel & 0xffffff) | (alpha_for_source_alpha[pixel >> 24] << 24);
+        else
+            pixel = (pixel & 0xffffff) | (alpha_for_opaque_source << 24);
+        auto destination_color = destination_has_alpha ? Color::from_argb(destination[i]) : Color::from_rgb(destination[i]);
+        destination[i] = destination_color.blend(Color::from_argb(pixel)).value();
+    }
+}
+
+template<typename V>
+ALWAYS_INLINE static void blend_pixels_with_opacity_impl(ARGB32* destination, ARGB32 const* source, size_t count, OpacityBlend const& options)
+{
+    if (options.destination_has_alpha)
+        blend_pixels_with_opacity_impl<V, true>(destination, source, count, options);
+    else
+        blend_pixels_with_opacity_impl<V, false>(destination, source, count, options);
+}
+
+template<typename V>
+ALWAYS_INLINE static void draw_bilinear_samples_impl(ARGB32* destination, BilinearSamples const& samples, size_t count, float opacity, bool should_blend)
+{
+    using U32 = typename V::U32;
+    using F32 = typename V::F32;
+
+    F32 y_ratio = F32 {} + samples.y_ratio;
+    size_t i = 0;
+    for (; i + V::size <= count; i += V::size) {
+        auto x_ratio = load_unaligned<F32>(samples.x_ratios + i);
+        auto top = mix<V>(load_unaligned<U32>(samples.top_left + i), load_unaligned<U32>(samples.top_right + i), x_ratio);
+        auto bottom = mix<V>(load_unaligned<U32>(samples.bottom_left + i), load_unaligned<U32>(samples.bottom_right + i), x_ratio);
+        auto pixels = mix<V>(top, bottom, y_ratio);
+        pixels = (pixels & 0xffffff) | ((convert_to_integer<V>(convert_to_float<V>(pixels >> 24) * opacity) & 0xff) << 24);
+
+        if (should_blend)
+            store_unaligned(destination + i, blend<V>(load_unaligned<U32>(destination + i), pixels));
+        else
+            store_unaligned(destination + i, pixels);
+    }
+
+    for (; i < count; ++i) {
+        auto top = Color::from_argb(samples.top_left[i]).mixed_with(Color::from_argb(samples.top_right[i]), samples.x_ratios[i]);
+        auto bottom = Color::from_argb(samples.bottom_left[i]).mixed_with(Color::from_argb(samples.bottom_right[i]), samples.x_ratios[i]);
+        auto pixel = top.mixed_with(bottom, samples.y_ratio);
+        pixel.set_alpha(pixel.alpha() * opacity);
+        destination[i] = should_blend ? Color::from_argb(destination[i]).blend(pixel).value() : pixel.value();
+    }
+}
+
+static void blend_color_over_pixels_default(ARGB32* pixels, size_t count, Color color, bool pixels_have_alpha)
+{
+    blend_color_over_pixels_impl<PixelVectors4>(pixels, count, color, pixels_have_alpha);
+}
+
+static void blend_pixels_with_opacity_default(ARGB32* destination, ARGB32 const* source, size_t count, OpacityBlend const& options)
+{
+    blend_pixels_with_opacity_impl<PixelVectors4>(destination, source, count, options);
+}
+
+static void draw_bilinear_samples_default(ARGB32* destination, BilinearSamples const& samples, size_t count, float opacity, bool should_blend)
+{
+    draw_bilinear_samples_impl<PixelVectors4>(destination, samples, count, opacity, should_blend);
+}
+
+#if AK_CAN_CODEGEN_FOR_X86_AVX2
+[[gnu::target("avx2")]] static void blend_color_over_pixels_avx2(ARGB32* pixels, size_t count, Color color, bool pixels_have_alpha)
+{
+    blend_color_over_pixels_impl<PixelVectors8>(pixels, count, color, pixels_have_alpha);
+}
+
+[[gnu::target("avx2")]] static void blend_pixels_with_opacity_avx2(ARGB32* destination, ARGB32 const* source, size_t count, OpacityBlend const& options)
+{
+    blend_pixels_with_opacity_impl<PixelVectors8>(destination, source, count, options);
+}
+
+[[gnu::target("avx2")]] static void draw_bilinear_samples_avx2(ARGB32* destination, BilinearSamples const& samples, size_t count, float opacity, bool should_blend)
+{
+    draw_bilinear_samples_impl<PixelVectors8>(destination, samples, count, opacity, should_blend);
+}
+#endif
+
+// The 4-wide versions are plain SSE2 on x86-64, and whatever the compiler makes of the vector types elsewhere.
+#if AK_CAN_CODEGEN_FOR_X86_AVX2
+template<typename Kernel>
+static Kernel pick_kernel(Kernel default_kernel, Kernel avx2_kernel)
+{
+    if (has_flag(detect_cpu_features(), CPUFeatures::X86_AVX2))
+        return avx2_kernel;
+    return default_kernel;
+}
+
+static auto const s_blend_color_over_pixels = pick_kernel(blend_color_over_pixels_default, blend_color_over_pixels_avx2);
+static auto const s_blend_pixels_with_opacity = pick_kernel(blend_pixels_with_opacity_default, blend_pixels_with_opacity_avx2);
+static auto const s_draw_bilinear_samples = pick_kernel(draw_bilinear_samples_default, draw_bilinear_samples_avx2);
+#else
+static auto const s_blend_color_over_pixels = blend_color_over_pixels_default;
+static auto const s_blend_pixels_with_opacity = blend_pixels_with_opacity_default;
+static auto const s_draw_bilinear_samples = draw_bilinear_samples_default;
+#endif
+
+void blend_color_over_pixels(ARGB32* pixels, size_t count, Color color, bool pixels_have_alpha)
+{
+    s_blend_color_over_pixels(pixels, count, color, pixels_have_alpha);
+}
+
+void blend_pixels_with_opacity(ARGB32* destination, ARGB32 const* source, size_t count, OpacityBlend const& options)
+{
+    s_blend_pixels_with_opacity(destination, source, count, options);
+}
+
+void draw_bilinear_samples(ARGB32* destination, BilinearSamples const& samples, size_t count, float opacity, bool should_blend)
+{
+    s_draw_bilinear_samples(destination, samples, count, opacity, should_blend);
+}
+
+}
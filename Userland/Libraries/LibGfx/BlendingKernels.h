@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+#include <LibGfx/Color.h>
+
+namespace Gfx {
+
+// The inner loops of Painter, working on many pixels at once with vector instructions (AVX2 where the CPU has
+// it, SSE2 or the vector unit of the target otherwise). They give exactly the same results as doing the same
+// thing pixel by pixel with Color.
+
+// Like pixels[i] = (has_alpha ? Color::from_argb(pixels[i]) : Color::from_rgb(pixels[i])).blend(color).value().
+void blend_color_over_pixels(ARGB32* pixels, size_t count, Color color, bool pixels_have_alpha);
+
+struct OpacityBlend {
+    float opacity { 1.0f };
+    // Otherwise, the source pixels are treated as opaque.
+    bool source_has_alpha { false };
+    bool source_is_rgba { false };
+    bool destination_has_alpha { false };
+};
+
+// Blends the source pixels over the destination pixels, after scaling their alpha by the opacity.
+// This is what Painter::blit_with_opacity() does.
+void blend_pixels_with_opacity(ARGB32* destination, ARGB32 const* source, size_t count, OpacityBlend const&);
+
+struct BilinearSamples {
+    ARGB32 const* top_left { nullptr };
+    ARGB32 const* top_right { nullptr };
+    ARGB32 const* bottom_left { nullptr };
+    ARGB32 const* bottom_right { nullptr };
+    float const* x_ratios { nullptr };
+    float y_ratio { 0 };
+};
+
+// Mixes each group of four samples like Color::mixed_with() does, first horizontally and then vertically, and
+// scales the alpha of the result by the opacity. The result is then blended over the destination pixels (taking
+// their alpha channel as is), or just stored if should_blend is false.
+void draw_bilinear_samples(ARGB32* destination, BilinearSamples const&, size_t count, float opacity, bool should_blend);
+
+}
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <AK/Debug.h>
 #include <AK/Endian.h>
 #include <AK/Error.h>
@@ -12,17 +13,27 @@
 #include <AK/HashMap.h>
 #include <AK/Math.h>
 #include <AK/MemoryStream.h>
+#include <AK/NeverDestroyed.h>
 #include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/String.h>
 #include <AK/Try.h>
 #include <AK/Vector.h>
+#include <LibCore/System.h>
 #include <LibGfx/ImageFormats/JPEGLoader.h>
 #include <LibGfx/ImageFormats/JPEGShared.h>
 #include <LibGfx/ImageFormats/TIFFLoader.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/ThreadPool.h>
+#include <string.h>
 
 namespace Gfx {
 
+using namespace AK::SIMD;
+
 struct MacroblockMeta {
     u32 total { 0 };
     u32 padded_total { 0 };
@@ -227,6 +238,43 @@ public:
         return {};
     }
 
+    // Reads the entropy-coded data of a scan, up to the marker that ends it, which is then returned by the
+    // next read_u16(). The offsets of the restart markers within the data are appended to restart_marker_offsets.
+    ErrorOr<ByteBuffer> read_entropy_coded_data(Vector<size_t>& restart_marker_offsets)
+    {
+        ByteBuffer data;
+        while (!m_saved_marker.has_value()) {
+            if (m_byte_offset == m_current_size)
+                TRY(refill_buffer());
+
+            auto const available = m_buffer.span().slice(m_byte_offset, m_current_size - m_byte_offset);
+            auto const* next_ff = static_cast<u8 const*>(memchr(available.data(), 0xFF, available.size()));
+            auto const run_length = next_ff ? static_cast<size_t>(next_ff - available.data()) : available.size();
+            TRY(data.try_append(available.data(), run_length));
+            m_byte_offset += run_length;
+            if (!next_ff)
+                continue;
+
+            m_byte_offset++;
+            u8 next_byte = TRY(read_u8());
+            // B.1.1.2 - Any marker may optionally be preceded by any number of fill bytes.
+            while (next_byte == 0xFF)
+                next_byte = TRY(read_u8());
+
+            Marker const marker = 0xFF00 | next_byte;
+            if (marker >= JPEG_RST0 && marker <= JPEG_RST7)
+                TRY(restart_marker_offsets.try_append(data.size()));
+            else if (next_byte != 0x00)
+                m_saved_marker = marker;
+
+            if (!m_saved_marker.has_value()) {
+                TRY(data.try_append(0xFF));
+                TRY(data.try_append(next_byte));
+            }
+        }
+        return data;
+    }
+
     Optional<u16>& saved_marker(Badge<HuffmanStream>)
     {
         return m_saved_marker;
@@ -404,6 +452,17 @@ struct Scan {
     {
     }
 
+    // The same scan, read from another stream.
+    Scan(Scan const& other, HuffmanStream stream)
+        : components(other.components)
+        , spectral_selection_start(other.spectral_selection_start)
+        , spectral_selection_end(other.spectral_selection_end)
+        , successive_approximation_high(other.successive_approximation_high)
+        , successive_approximation_low(other.successive_approximation_low)
+        , huffman_stream(stream)
+    {
+    }
+
     // B.2.3 - Scan header syntax
     Vector<ScanComponent, 4> components;
 
@@ -416,6 +475,10 @@ struct Scan {
 
     u64 end_of_bands_run_count { 0 };
 
+    // F.2.1.3.1 - Huffman decoding of DC coefficients
+    // The prediction is initialized to 0 at the beginning of the scan and of each restart interval.
+    Array<i16, 4> previous_dc_values {};
+
     // See the note on Figure B.4 - Scan header syntax
     bool are_components_interleaved() const
     {
@@ -470,7 +533,6 @@ struct JPEGLoadingContext {
     u16 dc_restart_interval { 0 };
     HashMap<u8, HuffmanTable> dc_tables;
     HashMap<u8, HuffmanTable> ac_tables;
-    Array<i16, 4> previous_dc_values {};
     MacroblockMeta mblock_meta;
     JPEGStream stream;
     JPEGDecoderOptions options;
@@ -516,7 +578,7 @@ enum class JPEGDecodingMode {
 };
 
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock, ScanComponent const& scan_component)
+static ErrorOr<void> add_dc(JPEGLoadingContext const& context, Scan& scan, Macroblock& macroblock, ScanComponent const& scan_component)
 {
     auto maybe_table = context.dc_tables.get(scan_component.dc_destination_id);
     if (!maybe_table.has_value()) {
@@ -525,7 +587,6 @@ static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock,
     }
 
     auto& dc_table = maybe_table.value();
-    auto& scan = *context.current_scan;
 
     auto* select_component = get_component(macroblock, scan_component.component.index);
     auto& coefficient = select_component[0];
@@ -553,7 +614,7 @@ static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock,
     if (dc_length != 0 && dc_diff < (1 << (dc_length - 1)))
         dc_diff -= (1 << dc_length) - 1;
 
-    auto& previous_dc = context.previous_dc_values[scan_component.component.index];
+    auto& previous_dc = scan.previous_dc_values[scan_component.component.index];
     previous_dc += dc_diff;
     coefficient = previous_dc << scan.successive_approximation_low;
 
@@ -597,7 +658,7 @@ static bool is_progressive(StartOfFrame::FrameType frame_type)
 }
 
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock, ScanComponent const& scan_component)
+static ErrorOr<void> add_ac(JPEGLoadingContext const& context, Scan& scan, Macroblock& macroblock, ScanComponent const& scan_component)
 {
     auto maybe_table = context.ac_tables.get(scan_component.ac_destination_id);
     if (!maybe_table.has_value()) {
@@ -608,8 +669,6 @@ static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock,
     auto& ac_table = maybe_table.value();
     auto* select_component = get_component(macroblock, scan_component.component.index);
 
-    auto& scan = *context.current_scan;
-
     // Compute the AC coefficients.
 
     // 0th coefficient is the dc, which is already handled
@@ -731,45 +790,34 @@ static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock,
  * we are dealing with three components) will fill up the blocks with chroma data.
  */
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> build_macroblocks(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
+static ErrorOr<void> build_data_unit(JPEGLoadingContext const& context, Scan& scan, Macroblock& block, ScanComponent const& scan_component)
 {
-    for (auto const& scan_component : context.current_scan->components) {
+    if constexpr (DecodingMode == JPEGDecodingMode::Sequential) {
+        TRY(add_dc<DecodingMode>(context, scan, block, scan_component));
+        TRY(add_ac<DecodingMode>(context, scan, block, scan_component));
+    } else {
+        if (scan.spectral_selection_start == 0)
+            TRY(add_dc<DecodingMode>(context, scan, block, scan_component));
+        if (scan.spectral_selection_end != 0)
+            TRY(add_ac<DecodingMode>(context, scan, block, scan_component));
+
+        // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
+        if (scan.end_of_bands_run_count > 0)
+            --scan.end_of_bands_run_count;
+    }
+
+    return {};
+}
+
+template<JPEGDecodingMode DecodingMode>
+static ErrorOr<void> build_macroblocks(JPEGLoadingContext const& context, Scan& scan, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
+{
+    for (auto const& scan_component : scan.components) {
         for (u8 vfactor_i = 0; vfactor_i < scan_component.component.sampling_factors.vertical; vfactor_i++) {
             for (u8 hfactor_i = 0; hfactor_i < scan_component.component.sampling_factors.horizontal; hfactor_i++) {
                 // A.2.3 - Interleaved order
                 u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                if (!context.current_scan->are_components_interleaved()) {
-                    macroblock_index = vcursor * context.mblock_meta.hpadded_count + (hfactor_i + (hcursor * scan_component.component.sampling_factors.vertical) + (vfactor_i * scan_component.component.sampling_factors.horizontal));
-
-                    // A.2.4 Completion of partial MCU
-                    // If the component is [and only if!] to be interleaved, the encoding process
-                    // shall also extend the number of samples by one or more additional blocks.
-
-                    // Horizontally
-                    if (macroblock_index >= context.mblock_meta.hcount && macroblock_index % context.mblock_meta.hpadded_count >= context.mblock_meta.hcount)
-                        continue;
-                    // Vertically
-                    if (macroblock_index >= context.mblock_meta.hpadded_count * context.mblock_meta.vcount)
-                        continue;
-                }
-
-                Macroblock& block = macroblocks[macroblock_index];
-
-                if constexpr (DecodingMode == JPEGDecodingMode::Sequential) {
-                    TRY(add_dc<DecodingMode>(context, block, scan_component));
-                    TRY(add_ac<DecodingMode>(context, block, scan_component));
-                } else {
-                    if (context.current_scan->spectral_selection_start == 0)
-                        TRY(add_dc<DecodingMode>(context, block, scan_component));
-                    if (context.current_scan->spectral_selection_end != 0)
-                        TRY(add_ac<DecodingMode>(context, block, scan_component));
-
-                    // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
-                    if (context.current_scan->end_of_bands_run_count > 0) {
-                        --context.current_scan->end_of_bands_run_count;
-                        continue;
-                    }
-                }
+                TRY(build_data_unit<DecodingMode>(context, scan, macroblocks[macroblock_index], scan_component));
             }
         }
     }
@@ -789,61 +837,228 @@ static bool is_dct_based(StartOfFrame::FrameType frame_type)
         || frame_type == StartOfFrame::FrameType::Differential_Progressive_DCT_Arithmetic;
 }
 
-static void reset_decoder(JPEGLoadingContext& context)
+static void reset_decoder(JPEGLoadingContext const& context, Scan& scan)
 {
     // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
-    context.current_scan->end_of_bands_run_count = 0;
+    scan.end_of_bands_run_count = 0;
 
     // E.2.4 Control procedure for decoding a restart interval
     if (is_dct_based(context.frame.type)) {
-        context.previous_dc_values = {};
+        scan.previous_dc_values = {};
         return;
     }
 
     VERIFY_NOT_REACHED();
 }
 
-static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+// A.2.2 - Non-interleaved order
+// A non-interleaved scan only contains one component, and each of its MCUs is a single data unit. As the
+// encoder doesn't complete partial MCUs of such scans (A.2.4), they are laid out in the component's own
+// dimensions instead of the padded ones of the frame.
+static u32 mcus_per_row(JPEGLoadingContext const& context, Scan const& scan)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
-            // FIXME: This is likely wrong for non-interleaved scans.
-            VERIFY(context.mblock_meta.hpadded_count % context.sampling_factors.horizontal == 0);
-            u32 number_of_mcus_decoded_so_far = ((vcursor / context.sampling_factors.vertical) * context.mblock_meta.hpadded_count + hcursor) / context.sampling_factors.horizontal;
+    if (!scan.are_components_interleaved()) {
+        auto const& component = scan.components[0].component;
+        return ceil_div<u32, u32>(context.mblock_meta.hcount * component.sampling_factors.horizontal, context.sampling_factors.horizontal);
+    }
 
-            auto& huffman_stream = context.current_scan->huffman_stream;
+    VERIFY(context.mblock_meta.hpadded_count % context.sampling_factors.horizontal == 0);
+    return context.mblock_meta.hpadded_count / context.sampling_factors.horizontal;
+}
 
-            if (context.dc_restart_interval > 0) {
-                if (number_of_mcus_decoded_so_far != 0 && number_of_mcus_decoded_so_far % context.dc_restart_interval == 0) {
-                    reset_decoder(context);
+static u32 mcus_per_column(JPEGLoadingContext const& context, Scan const& scan)
+{
+    if (!scan.are_components_interleaved()) {
+        auto const& component = scan.components[0].component;
+        return ceil_div<u32, u32>(context.mblock_meta.vcount * component.sampling_factors.vertical, context.sampling_factors.vertical);
+    }
 
-                    // Restart markers are stored in byte boundaries. Advance the huffman stream cursor to
-                    //  the 0th bit of the next byte.
-                    TRY(huffman_stream.advance_to_byte_boundary());
+    return ceil_div<u32, u32>(context.mblock_meta.vcount, context.sampling_factors.vertical);
+}
 
-                    // Skip the restart marker (RSTn).
-                    TRY(huffman_stream.discard_bits(8));
-                }
+static u32 total_number_of_mcus(JPEGLoadingContext const& context, Scan const& scan)
+{
+    return mcus_per_row(context, scan) * mcus_per_column(context, scan);
+}
+
+template<JPEGDecodingMode DecodingMode>
+static ErrorOr<void> build_mcu(JPEGLoadingContext const& context, Scan& scan, Vector<Macroblock>& macroblocks, u32 mcu, u32 mcus_in_a_row)
+{
+    u32 const row = mcu / mcus_in_a_row;
+    u32 const column = mcu % mcus_in_a_row;
+
+    if (scan.are_components_interleaved())
+        return build_macroblocks<DecodingMode>(context, scan, macroblocks, column * context.sampling_factors.horizontal, row * context.sampling_factors.vertical);
+
+    // The data unit goes where it would have been in an interleaved scan.
+    auto const& scan_component = scan.components[0];
+    auto const& sampling_factors = scan_component.component.sampling_factors;
+    u32 const vcursor = (row / sampling_factors.vertical) * context.sampling_factors.vertical + row % sampling_factors.vertical;
+    u32 const hcursor = (column / sampling_factors.horizontal) * context.sampling_factors.horizontal + column % sampling_factors.horizontal;
+    return build_data_unit<DecodingMode>(context, scan, macroblocks[vcursor * context.mblock_meta.hpadded_count + hcursor], scan_component);
+}
+
+// Decodes the MCUs from first_mcu up to (but not including) end_mcu. The huffman stream of the scan has to be
+// at the start of the scan or of the restart interval that first_mcu is in.
+static ErrorOr<void> decode_mcus(JPEGLoadingContext const& context, Scan& scan, Vector<Macroblock>& macroblocks, u32 first_mcu, u32 end_mcu)
+{
+    auto const mcus_in_a_row = mcus_per_row(context, scan);
+
+    for (u32 mcu = first_mcu; mcu < end_mcu; ++mcu) {
+        auto& huffman_stream = scan.huffman_stream;
+
+        if (context.dc_restart_interval > 0) {
+            if (mcu != 0 && mcu % context.dc_restart_interval == 0) {
+                reset_decoder(context, scan);
+
+                // Restart markers are stored in byte boundaries. Advance the huffman stream cursor to
+                //  the 0th bit of the next byte.
+                TRY(huffman_stream.advance_to_byte_boundary());
+
+                // Skip the restart marker (RSTn).
+                TRY(huffman_stream.discard_bits(8));
             }
+        }
 
-            auto result = [&]() {
-                if (is_progressive(context.frame.type))
-                    return build_macroblocks<JPEGDecodingMode::Progressive>(context, macroblocks, hcursor, vcursor);
-                return build_macroblocks<JPEGDecodingMode::Sequential>(context, macroblocks, hcursor, vcursor);
-            }();
+        auto result = [&]() {
+            if (is_progressive(context.frame.type))
+                return build_mcu<JPEGDecodingMode::Progressive>(context, scan, macroblocks, mcu, mcus_in_a_row);
+            return build_mcu<JPEGDecodingMode::Sequential>(context, scan, macroblocks, mcu, mcus_in_a_row);
+        }();
 
-            if (result.is_error()) {
-                if constexpr (JPEG_DEBUG) {
-                    dbgln("Failed to build Macroblock {}: {}", number_of_mcus_decoded_so_far, result.error());
-                    dbgln("Huffman stream byte offset {:#x}", context.stream.byte_offset());
-                }
-                return result.release_error();
+        if (result.is_error()) {
+            if constexpr (JPEG_DEBUG) {
+                dbgln("Failed to build Macroblock {}: {}", mcu, result.error());
+                dbgln("Huffman stream byte offset {:#x}", context.stream.byte_offset());
             }
+            return result.release_error();
         }
     }
     return {};
 }
 
+// Restart intervals don't depend on each other, so we can decode them on several threads at once. Spinning up
+// threads only pays off for big enough images though.
+static constexpr u32 minimum_mcus_per_decoding_thread = 1024;
+static constexpr size_t maximum_decoding_thread_count = 8;
+
+static Threading::ThreadPool<Function<void()>>& decoding_thread_pool()
+{
+    // This is shared by all decoders, and lives as long as the process.
+    static NeverDestroyed<Threading::ThreadPool<Function<void()>>> thread_pool(
+        [](Function<void()> work) { work(); },
+        clamp(Core::System::hardware_concurrency(), 2uz, maximum_decoding_thread_count) - 1);
+    return *thread_pool;
+}
+
+static size_t decoding_thread_count(JPEGLoadingContext const& context, Scan const& scan)
+{
+    if (context.dc_restart_interval == 0 || is_progressive(context.frame.type) || !scan.are_components_interleaved())
+        return 1;
+
+    auto const total_mcus = total_number_of_mcus(context, scan);
+    auto const restart_interval_count = ceil_div<u32, u32>(total_mcus, context.dc_restart_interval);
+    if (context.options.decoding_thread_count.has_value())
+        return clamp(*context.options.decoding_thread_count, 1uz, restart_interval_count);
+
+    auto const thread_count = min(Core::System::hardware_concurrency(), maximum_decoding_thread_count);
+    return clamp(min<size_t>(thread_count, total_mcus / minimum_mcus_per_decoding_thread), 1uz, restart_interval_count);
+}
+
+struct RestartIntervalRange {
+    u32 first_mcu { 0 };
+    u32 end_mcu { 0 };
+    ReadonlyBytes data;
+};
+
+static ErrorOr<void> decode_restart_interval_range(JPEGLoadingContext const& context, Scan const& scan, Vector<Macroblock>& macroblocks, RestartIntervalRange const& range)
+{
+    // The fake EOI marker at the end lets the huffman stream know where the data ends, just like the marker
+    // after the scan does when decoding from the file itself.
+    auto data = TRY(ByteBuffer::create_uninitialized(range.data.size() + 2));
+    data.overwrite(0, range.data.data(), range.data.size());
+    data[range.data.size()] = 0xFF;
+    data[range.data.size() + 1] = JPEG_EOI & 0xFF;
+
+    auto stream = TRY(JPEGStream::create(TRY(try_make<FixedMemoryStream>(data.bytes()))));
+    Scan range_scan(scan, HuffmanStream { stream });
+    return decode_mcus(context, range_scan, macroblocks, range.first_mcu, range.end_mcu);
+}
+
+static ErrorOr<void> decode_restart_intervals_in_parallel(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks, size_t thread_count)
+{
+    auto const& scan = *context.current_scan;
+
+    // To find out where each restart interval starts, we have to read all the data of the scan upfront.
+    Vector<size_t> restart_marker_offsets;
+    auto data = TRY(context.stream.read_entropy_coded_data(restart_marker_offsets));
+
+    auto const total_mcus = total_number_of_mcus(context, scan);
+    auto const restart_interval_count = ceil_div<u32, u32>(total_mcus, context.dc_restart_interval);
+    if (restart_marker_offsets.size() + 1 != restart_interval_count) {
+        // The decoder will notice what's wrong with the data as well, no need to make up a different error.
+        dbgln_if(JPEG_DEBUG, "Expected {} restart intervals, found {}", restart_interval_count, restart_marker_offsets.size() + 1);
+        thread_count = 1;
+    }
+
+    Vector<RestartIntervalRange> ranges;
+    TRY(ranges.try_ensure_capacity(thread_count));
+    for (size_t i = 0; i < thread_count; ++i) {
+        u32 const first_interval = restart_interval_count * i / thread_count;
+        u32 const end_interval = restart_interval_count * (i + 1) / thread_count;
+        // Every range but the first starts with the restart marker that precedes its first interval.
+        size_t const start_offset = i == 0 ? 0 : restart_marker_offsets[first_interval - 1];
+        size_t const end_offset = i == thread_count - 1 ? data.size() : restart_marker_offsets[end_interval - 1];
+        ranges.unchecked_append({
+            .first_mcu = i == 0 ? 0 : first_interval * context.dc_restart_interval,
+            .end_mcu = i == thread_count - 1 ? total_mcus : end_interval * context.dc_restart_interval,
+            .data = data.bytes().slice(start_offset, end_offset - start_offset),
+        });
+    }
+
+    Vector<Optional<Error>> errors;
+    TRY(errors.try_resize(ranges.size()));
+
+    Threading::Mutex mutex;
+    Threading::ConditionVariable all_ranges_done { mutex };
+    size_t remaining_ranges = ranges.size() - 1;
+
+    for (size_t i = 1; i < ranges.size(); ++i) {
+        decoding_thread_pool().submit([&, i] {
+            auto result = decode_restart_interval_range(context, scan, macroblocks, ranges[i]);
+
+            Threading::MutexLocker locker(mutex);
+            if (result.is_error())
+                errors[i] = result.release_error();
+            if (--remaining_ranges == 0)
+                all_ranges_done.signal();
+        });
+    }
+
+    // The first range is decoded on this thread.
+    if (auto result = decode_restart_interval_range(context, scan, macroblocks, ranges[0]); result.is_error())
+        errors[0] = result.release_error();
+
+    {
+        Threading::MutexLocker locker(mutex);
+        all_ranges_done.wait_while([&] { return remaining_ranges > 0; });
+    }
+
+    for (auto& error : errors) {
+        if (error.has_value())
+            return error.release_value();
+    }
+    return {};
+}
+
+static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+{
+    auto& scan = *context.current_scan;
+    if (auto thread_count = decoding_thread_count(context, scan); thread_count > 1)
+        return decode_restart_intervals_in_parallel(context, macroblocks, thread_count);
+    return decode_mcus(context, scan, macroblocks, 0, total_number_of_mcus(context, scan));
+}
+
 static bool is_frame_marker(Marker const marker)
 {
     // B.1.1.3 - Marker assignments
@@ -1421,8 +1636,11 @@ static void dequantize(JPEGLoadingContext& context, Vector<Macroblock>& macroblo
                         u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[macroblock_index];
                         auto* block_component = get_component(block, i);
-                        for (u32 k = 0; k < 64; k++)
-                            block_component[k] *= table[k];
+                        for (u32 k = 0; k < 64; k += 8) {
+                            // Only the low 16 bits of the products are kept, so the signedness of the table doesn't matter.
+                            auto const factors = bit_cast<i16x8>(load_unaligned<u16x8>(table.data() + k));
+                            store_unaligned(block_component + k, load_unaligned<i16x8>(block_component + k) * factors);
+                        }
                     }
                 }
             }
@@ -1430,6 +1648,61 @@ static void dequantize(JPEGLoadingContext& context, Vector<Macroblock>& macroblo
     }
 }
 
+template<SIMDVector V>
+ALWAYS_INLINE static V clamp_lanes(V values, ElementOf<V> min, ElementOf<V> max)
+{
+    auto const below = values < min;
+    values = (values & ~below) | (min & below);
+    auto const above = values > max;
+    return (values & ~above) | (max & above);
+}
+
+static void transpose_8x8(Array<i16x8, 8>& rows)
+{
+    // Interleaves 16-bit, then 32-bit, then 64-bit lanes of pairs of rows, the usual unpack-based transpose.
+    auto const low_16 = [](i16x8 a, i16x8 b) { return __builtin_shufflevector(a, b, 0, 8, 1, 9, 2, 10, 3, 11); };
+    auto const high_16 = [](i16x8 a, i16x8 b) { return __builtin_shufflevector(a, b, 4, 12, 5, 13, 6, 14, 7, 15); };
+    auto const low_32 = [](i16x8 a, i16x8 b) {
+        return bit_cast<i16x8>(__builtin_shufflevector(bit_cast<i32x4>(a), bit_cast<i32x4>(b), 0, 4, 1, 5));
+    };
+    auto const high_32 = [](i16x8 a, i16x8 b) {
+        return bit_cast<i16x8>(__builtin_shufflevector(bit_cast<i32x4>(a), bit_cast<i32x4>(b), 2, 6, 3, 7));
+    };
+    auto const low_64 = [](i16x8 a, i16x8 b) {
+        return bit_cast<i16x8>(__builtin_shufflevector(bit_cast<i64x2>(a), bit_cast<i64x2>(b), 0, 2));
+    };
+    auto const high_64 = [](i16x8 a, i16x8 b) {
+        return bit_cast<i16x8>(__builtin_shufflevector(bit_cast<i64x2>(a), bit_cast<i64x2>(b), 1, 3));
+    };
+
+    i16x8 const a0 = low_16(rows[0], rows[1]);
+    i16x8 const a1 = high_16(rows[0], rows[1]);
+    i16x8 const a2 = low_16(rows[2], rows[3]);
+    i16x8 const a3 = high_16(rows[2], rows[3]);
+    i16x8 const a4 = low_16(rows[4], rows[5]);
+    i16x8 const a5 = high_16(rows[4], rows[5]);
+    i16x8 const a6 = low_16(rows[6], rows[7]);
+    i16x8 const a7 = high_16(rows[6], rows[7]);
+
+    i16x8 const b0 = low_32(a0, a2);
+    i16x8 const b1 = high_32(a0, a2);
+    i16x8 const b2 = low_32(a1, a3);
+    i16x8 const b3 = high_32(a1, a3);
+    i16x8 const b4 = low_32(a4, a6);
+    i16x8 const b5 = high_32(a4, a6);
+    i16x8 const b6 = low_32(a5, a7);
+    i16x8 const b7 = high_32(a5, a7);
+
+    rows[0] = low_64(b0, b4);
+    rows[1] = high_64(b0, b4);
+    rows[2] = low_64(b1, b5);
+    rows[3] = high_64(b1, b5);
+    rows[4] = low_64(b2, b6);
+    rows[5] = high_64(b2, b6);
+    rows[6] = low_64(b3, b7);
+    rows[7] = high_64(b3, b7);
+}
+
 static void inverse_dct_8x8(i16* block_component)
 {
     // Does a 2-D IDCT by doing two 1-D IDCTs as described in https://unix4lyfe.org/dct/
@@ -1449,140 +1722,91 @@ static void inverse_dct_8x8(i16* block_component)
     static float const s6 = AK::cos(6.0f / 16.0f * AK::Pi<float>) / 2.0f;
     static float const s7 = AK::cos(7.0f / 16.0f * AK::Pi<float>) / 2.0f;
 
-    for (u32 k = 0; k < 8; ++k) {
-        float const g0 = block_component[0 * 8 + k] * s0;
-        float const g1 = block_component[4 * 8 + k] * s4;
-        float const g2 = block_component[2 * 8 + k] * s2;
-        float const g3 = block_component[6 * 8 + k] * s6;
-        float const g4 = block_component[5 * 8 + k] * s5;
-        float const g5 = block_component[1 * 8 + k] * s1;
-        float const g6 = block_component[7 * 8 + k] * s7;
-        float const g7 = block_component[3 * 8 + k] * s3;
-
-        float const f0 = g0;
-        float const f1 = g1;
-        float const f2 = g2;
-        float const f3 = g3;
-        float const f4 = g4 - g7;
-        float const f5 = g5 + g6;
-        float const f6 = g5 - g6;
-        float const f7 = g4 + g7;
-
-        float const e0 = f0;
-        float const e1 = f1;
-        float const e2 = f2 - f3;
-        float const e3 = f2 + f3;
-        float const e4 = f4;
-        float const e5 = f5 - f7;
-        float const e6 = f6;
-        float const e7 = f5 + f7;
-        float const e8 = f4 + f6;
-
-        float const d0 = e0;
-        float const d1 = e1;
-        float const d2 = e2 * m1;
-        float const d3 = e3;
-        float const d4 = e4 * m2;
-        float const d5 = e5 * m3;
-        float const d6 = e6 * m4;
-        float const d7 = e7;
-        float const d8 = e8 * m5;
-
-        float const c0 = d0 + d1;
-        float const c1 = d0 - d1;
-        float const c2 = d2 - d3;
-        float const c3 = d3;
-        float const c4 = d4 + d8;
-        float const c5 = d5 + d7;
-        float const c6 = d6 - d8;
-        float const c7 = d7;
-        float const c8 = c5 - c6;
-
-        float const b0 = c0 + c3;
-        float const b1 = c1 + c2;
-        float const b2 = c1 - c2;
-        float const b3 = c0 - c3;
-        float const b4 = c4 - c8;
-        float const b5 = c8;
-        float const b6 = c6 - c7;
-        float const b7 = c7;
-
-        block_component[0 * 8 + k] = b0 + b7;
-        block_component[1 * 8 + k] = b1 + b6;
-        block_component[2 * 8 + k] = b2 + b5;
-        block_component[3 * 8 + k] = b3 + b4;
-        block_component[4 * 8 + k] = b3 - b4;
-        block_component[5 * 8 + k] = b2 - b5;
-        block_component[6 * 8 + k] = b1 - b6;
-        block_component[7 * 8 + k] = b0 - b7;
-    }
-    for (u32 l = 0; l < 8; ++l) {
-        float const g0 = block_component[l * 8 + 0] * s0;
-        float const g1 = block_component[l * 8 + 4] * s4;
-        float const g2 = block_component[l * 8 + 2] * s2;
-        float const g3 = block_component[l * 8 + 6] * s6;
-        float const g4 = block_component[l * 8 + 5] * s5;
-        float const g5 = block_component[l * 8 + 1] * s1;
-        float const g6 = block_component[l * 8 + 7] * s7;
-        float const g7 = block_component[l * 8 + 3] * s3;
-
-        float const f0 = g0;
-        float const f1 = g1;
-        float const f2 = g2;
-        float const f3 = g3;
-        float const f4 = g4 - g7;
-        float const f5 = g5 + g6;
-        float const f6 = g5 - g6;
-        float const f7 = g4 + g7;
-
-        float const e0 = f0;
-        float const e1 = f1;
-        float const e2 = f2 - f3;
-        float const e3 = f2 + f3;
-        float const e4 = f4;
-        float const e5 = f5 - f7;
-        float const e6 = f6;
-        float const e7 = f5 + f7;
-        float const e8 = f4 + f6;
-
-        float const d0 = e0;
-        float const d1 = e1;
-        float const d2 = e2 * m1;
-        float const d3 = e3;
-        float const d4 = e4 * m2;
-        float const d5 = e5 * m3;
-        float const d6 = e6 * m4;
-        float const d7 = e7;
-        float const d8 = e8 * m5;
-
-        float const c0 = d0 + d1;
-        float const c1 = d0 - d1;
-        float const c2 = d2 - d3;
-        float const c3 = d3;
-        float const c4 = d4 + d8;
-        float const c5 = d5 + d7;
-        float const c6 = d6 - d8;
-        float const c7 = d7;
-        float const c8 = c5 - c6;
-
-        float const b0 = c0 + c3;
-        float const b1 = c1 + c2;
-        float const b2 = c1 - c2;
-        float const b3 = c0 - c3;
-        float const b4 = c4 - c8;
-        float const b5 = c8;
-        float const b6 = c6 - c7;
-        float const b7 = c7;
-
-        block_component[l * 8 + 0] = b0 + b7;
-        block_component[l * 8 + 1] = b1 + b6;
-        block_component[l * 8 + 2] = b2 + b5;
-        block_component[l * 8 + 3] = b3 + b4;
-        block_component[l * 8 + 4] = b3 - b4;
-        block_component[l * 8 + 5] = b2 - b5;
-        block_component[l * 8 + 6] = b1 - b6;
-        block_component[l * 8 + 7] = b0 - b7;
-    }
+    // Each vector holds one row of the block, so the 1-D IDCT of all eight columns is done at once. Transposing
+    // the block lets us do the rows the same way. The intermediate results are truncated to i16 like they would
+    // be if the block was transformed one column and one row at a time.
+    auto const inverse_dct_1d = [&](Array<i16x8, 8>& values) {
+        auto const to_float = [](i16x8 value) { return __builtin_convertvector(value, f32x8); };
+        auto const to_i16 = [](f32x8 value) { return __builtin_convertvector(__builtin_convertvector(value, i32x8), i16x8); };
+
+        f32x8 const g0 = to_float(values[0]) * s0;
+        f32x8 const g1 = to_float(values[4]) * s4;
+        f32x8 const g2 = to_float(values[2]) * s2;
+        f32x8 const g3 = to_float(values[6]) * s6;
+        f32x8 const g4 = to_float(values[5]) * s5;
+        f32x8 const g5 = to_float(values[1]) * s1;
+        f32x8 const g6 = to_float(values[7]) * s7;
+        f32x8 const g7 = to_float(values[3]) * s3;
+
+        f32x8 const f0 = g0;
+        f32x8 const f1 = g1;
+        f32x8 const f2 = g2;
+        f32x8 const f3 = g3;
+        f32x8 const f4 = g4 - g7;
+        f32x8 const f5 = g5 + g6;
+        f32x8 const f6 = g5 - g6;
+        f32x8 const f7 = g4 + g7;
+
+        f32x8 const e0 = f0;
+        f32x8 const e1 = f1;
+        f32x8 const e2 = f2 - f3;
+        f32x8 const e3 = f2 + f3;
+        f32x8 const e4 = f4;
+        f32x8 const e5 = f5 - f7;
+        f32x8 const e6 = f6;
+        f32x8 const e7 = f5 + f7;
+        f32x8 const e8 = f4 + f6;
+
+        f32x8 const d0 = e0;
+        f32x8 const d1 = e1;
+        f32x8 const d2 = e2 * m1;
+        f32x8 const d3 = e3;
+        f32x8 const d4 = e4 * m2;
+        f32x8 const d5 = e5 * m3;
+        f32x8 const d6 = e6 * m4;
+        f32x8 const d7 = e7;
+        f32x8 const d8 = e8 * m5;
+
+        f32x8 const c0 = d0 + d1;
+        f32x8 const c1 = d0 - d1;
+        f32x8 const c2 = d2 - d3;
+        f32x8 const c3 = d3;
+        f32x8 const c4 = d4 + d8;
+        f32x8 const c5 = d5 + d7;
+        f32x8 const c6 = d6 - d8;
+        f32x8 const c7 = d7;
+        f32x8 const c8 = c5 - c6;
+
+        f32x8 const b0 = c0 + c3;
+        f32x8 const b1 = c1 + c2;
+        f32x8 const b2 = c1 - c2;
+        f32x8 const b3 = c0 - c3;
+        f32x8 const b4 = c4 - c8;
+        f32x8 const b5 = c8;
+        f32x8 const b6 = c6 - c7;
+        f32x8 const b7 = c7;
+
+        values[0] = to_i16(b0 + b7);
+        values[1] = to_i16(b1 + b6);
+        values[2] = to_i16(b2 + b5);
+        values[3] = to_i16(b3 + b4);
+        values[4] = to_i16(b3 - b4);
+        values[5] = to_i16(b2 - b5);
+        values[6] = to_i16(b1 - b6);
+        values[7] = to_i16(b0 - b7);
+    };
+
+    Array<i16x8, 8> rows;
+    for (u32 i = 0; i < 8; ++i)
+        rows[i] = load_unaligned<i16x8>(block_component + i * 8);
+
+    inverse_dct_1d(rows);
+    transpose_8x8(rows);
+    inverse_dct_1d(rows);
+    transpose_8x8(rows);
+
+    for (u32 i = 0; i < 8; ++i)
+        store_unaligned(block_component + i * 8, rows[i]);
 }
 
 static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
@@ -1604,28 +1828,26 @@ static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& m
     }
 
     // F.2.1.5 - Inverse DCT (IDCT)
-    auto const level_shift = 1 << (context.frame.precision - 1);
-    auto const max_value = (1 << context.frame.precision) - 1;
+    i16 const level_shift = 1 << (context.frame.precision - 1);
+    i16 const max_value = (1 << context.frame.precision) - 1;
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
             for (u8 vfactor_i = 0; vfactor_i < context.sampling_factors.vertical; ++vfactor_i) {
                 for (u8 hfactor_i = 0; hfactor_i < context.sampling_factors.horizontal; ++hfactor_i) {
                     u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hcursor + hfactor_i);
-                    for (u8 i = 0; i < 8; ++i) {
-                        for (u8 j = 0; j < 8; ++j) {
+                    auto& block = macroblocks[mb_index];
+                    for (auto* block_component : { block.r, block.g, block.b, block.k }) {
+                        for (u8 i = 0; i < 64; i += 8) {
+                            // Clamping before shifting keeps the values in range of an i16.
+                            auto values = load_unaligned<i16x8>(block_component + i);
+                            values = clamp_lanes(values, -level_shift, max_value - level_shift) + level_shift;
 
                             // FIXME: This just truncate all coefficients, it's an easy way to support (read hack)
                             //        12 bits JPEGs without rewriting all color transformations.
-                            auto const clamp_to_8_bits = [&](u16 color) -> u8 {
-                                if (context.frame.precision == 8)
-                                    return static_cast<u8>(color);
-                                return static_cast<u8>(color >> 4);
-                            };
-
-                            macroblocks[mb_index].r[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].r[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].g[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].g[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].b[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].b[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].k[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].k[i * 8 + j] + level_shift, 0, max_value));
+                            if (context.frame.precision != 8)
+                                values >>= 4;
+
+                            store_unaligned(block_component + i, values);
                         }
                     }
                 }
@@ -1653,22 +1875,26 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
             for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
                 u32 const component_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
                 Macroblock& component_block = macroblocks[component_block_index];
-                auto* block_component_source = get_component(component_block, component_i);
 
-                // Overflows are intentional.
-                for (u8 vfactor_i = context.sampling_factors.vertical - 1; vfactor_i < context.sampling_factors.vertical; --vfactor_i) {
-                    for (u8 hfactor_i = context.sampling_factors.horizontal - 1; hfactor_i < context.sampling_factors.horizontal; --hfactor_i) {
+                // The first destination block is also the source, so work from a copy.
+                Array<i16, 64> block_component_source;
+                memcpy(block_component_source.data(), get_component(component_block, component_i), sizeof(block_component_source));
+
+                for (u8 vfactor_i = 0; vfactor_i < context.sampling_factors.vertical; ++vfactor_i) {
+                    for (u8 hfactor_i = 0; hfactor_i < context.sampling_factors.horizontal; ++hfactor_i) {
                         u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[macroblock_index];
                         auto* block_component_destination = get_component(block, component_i);
-                        for (u8 i = 7; i < 8; --i) {
-                            for (u8 j = 7; j < 8; --j) {
-                                u8 const pixel = i * 8 + j;
-                                // The component is 8x8 subsampled 2x2. Upsample its 2x2 4x4 tiles.
-                                u32 const component_pxrow = (i / context.sampling_factors.vertical) + 4 * vfactor_i;
-                                u32 const component_pxcol = (j / context.sampling_factors.horizontal) + 4 * hfactor_i;
-                                u32 const component_pixel = component_pxrow * 8 + component_pxcol;
-                                block_component_destination[pixel] = block_component_source[component_pixel];
+                        for (u8 i = 0; i < 8; ++i) {
+                            // The component is 8x8 subsampled 2x2. Upsample its 2x2 4x4 tiles.
+                            u32 const component_pxrow = (i / context.sampling_factors.vertical) + 4 * vfactor_i;
+                            auto const* source_row = block_component_source.data() + component_pxrow * 8 + 4 * hfactor_i;
+                            auto* destination_row = block_component_destination + i * 8;
+                            if (context.sampling_factors.horizontal == 1) {
+                                store_unaligned(destination_row, load_unaligned<i16x8>(source_row));
+                            } else {
+                                auto const half_row = load_unaligned<i16x4>(source_row);
+                                store_unaligned(destination_row, __builtin_shufflevector(half_row, half_row, 0, 0, 1, 1, 2, 2, 3, 3));
                             }
                         }
                     }
@@ -1687,13 +1913,21 @@ static void ycbcr_to_rgb(Vector<Macroblock>& macroblocks)
         auto* y = macroblock.y;
         auto* cb = macroblock.cb;
         auto* cr = macroblock.cr;
-        for (u8 i = 0; i < 64; ++i) {
-            int r = y[i] + 1.402f * (cr[i] - 128);
-            int g = y[i] - 0.3441f * (cb[i] - 128) - 0.7141f * (cr[i] - 128);
-            int b = y[i] + 1.772f * (cb[i] - 128);
-            y[i] = clamp(r, 0, 255);
-            cb[i] = clamp(g, 0, 255);
-            cr[i] = clamp(b, 0, 255);
+        for (u8 i = 0; i < 64; i += 8) {
+            auto const to_float = [](i16x8 value) { return __builtin_convertvector(value, f32x8); };
+            auto const to_i16 = [](f32x8 value) {
+                return __builtin_convertvector(clamp_lanes(__builtin_convertvector(value, i32x8), 0, 255), i16x8);
+            };
+
+            auto const luma = to_float(load_unaligned<i16x8>(y + i));
+            auto const blue_difference = to_float(load_unaligned<i16x8>(cb + i) - 128);
+            auto const red_difference = to_float(load_unaligned<i16x8>(cr + i) - 128);
+            auto const r = luma + 1.402f * red_difference;
+            auto const g = luma - 0.3441f * blue_difference - 0.7141f * red_difference;
+            auto const b = luma + 1.772f * blue_difference;
+            store_unaligned(y + i, to_i16(r));
+            store_unaligned(cb + i, to_i16(g));
+            store_unaligned(cr + i, to_i16(b));
         }
     }
 }
@@ -1787,16 +2021,29 @@ static ErrorOr<void> compose_bitmap(JPEGLoadingContext& context, Vector<Macroblo
 {
     context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { context.frame.width, context.frame.height }));
 
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
+    auto const to_channel = [](i16 const* values) {
+        return __builtin_convertvector(__builtin_convertvector(load_unaligned<i16x8>(values), u8x8), u32x8);
+    };
+
+    for (u32 y = 0; y < context.frame.height; y++) {
         u32 const block_row = y / 8;
         u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
+        auto* scanline = context.bitmap->scanline(y);
+        for (u32 block_column = 0; block_column * 8 < context.frame.width; block_column++) {
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
-            u32 const pixel_index = pixel_row * 8 + pixel_column;
-            Color const color { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index] };
-            context.bitmap->set_pixel(x, y, color);
+            u32 const x = block_column * 8;
+            u32 const pixel_index = pixel_row * 8;
+
+            if (x + 8 <= context.frame.width) {
+                auto const pixels = 0xff000000 | to_channel(block.y + pixel_index) << 16 | to_channel(block.cb + pixel_index) << 8 | to_channel(block.cr + pixel_index);
+                store_unaligned(scanline + x, pixels);
+                continue;
+            }
+
+            for (u32 pixel_column = 0; x + pixel_column < context.frame.width; pixel_column++) {
+                Color const color { (u8)block.y[pixel_index + pixel_column], (u8)block.cb[pixel_index + pixel_column], (u8)block.cr[pixel_index + pixel_column] };
+                scanline[x + pixel_column] = color.value();
+            }
         }
     }
 
@@ -2002,9 +2249,16 @@ bool JPEGImageDecoderPlugin::sniff(ReadonlyBytes data)
         && data.data()[2] == 0xFF;
 }
 
+static Optional<size_t> s_default_decoding_thread_count = JPEGDecoderOptions {}.decoding_thread_count;
+
+void JPEGImageDecoderPlugin::set_default_decoding_thread_count(Optional<size_t> thread_count)
+{
+    s_default_decoding_thread_count = thread_count;
+}
+
 ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create(ReadonlyBytes data)
 {
-    return create_with_options(data, {});
+    return create_with_options(data, { .decoding_thread_count = s_default_decoding_thread_count });
 }
 
 ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create_with_options(ReadonlyBytes data, JPEGDecoderOptions options)
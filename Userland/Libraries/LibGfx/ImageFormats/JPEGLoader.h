@@ -25,6 +25,11 @@ struct JPEGDecoderOptions {
         PDF,
     };
     CMYK cmyk { CMYK::Normal };
+
+    // Images with restart intervals can be decoded on several threads. As not every process is allowed to create
+    // threads, they are decoded on the calling thread by default. Without a value, the number of threads is decided
+    // from the size of the image and the number of CPUs.
+    Optional<size_t> decoding_thread_count { 1 };
 };
 
 class JPEGImageDecoderPlugin : public ImageDecoderPlugin {
@@ -33,6 +38,9 @@ public:
     static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create(ReadonlyBytes);
     static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create_with_options(ReadonlyBytes, JPEGDecoderOptions = {});
 
+    // Used by decoders made through create(), which is how Gfx::ImageDecoder makes them.
+    static void set_default_decoding_thread_count(Optional<size_t>);
+
     virtual ~JPEGImageDecoderPlugin() override;
     virtual IntSize size() override;
 
@@ -8,6 +8,7 @@
 #include <AK/Debug.h>
 #include <AK/Endian.h>
 #include <AK/MemoryStream.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Vector.h>
 #include <LibCompress/Zlib.h>
 #include <LibGfx/ImageFormats/PNGLoader.h>
@@ -82,11 +83,6 @@ struct EmbeddedICCProfile {
     ReadonlyBytes compressed_data;
 };
 
-struct Scanline {
-    PNG::FilterType filter;
-    ReadonlyBytes data {};
-};
-
 struct [[gnu::packed]] PaletteEntry {
     u8 r;
     u8 g;
@@ -132,7 +128,7 @@ enum RenderingIntent {
 struct AnimationFrame {
     fcTL_Chunk const& fcTL;
     RefPtr<Bitmap> bitmap;
-    ByteBuffer compressed_data;
+    Vector<ReadonlyBytes> image_data_chunks;
 
     AnimationFrame(fcTL_Chunk const& fcTL)
         : fcTL(fcTL)
@@ -185,10 +181,8 @@ struct PNGLoadingContext {
     bool has_seen_idat_chunk { false };
     bool has_seen_actl_chunk_before_idat { false };
     bool has_alpha() const { return to_underlying(color_type) & 4 || palette_transparency_data.size() > 0; }
-    Vector<Scanline> scanlines;
-    ByteBuffer unfiltered_data;
     RefPtr<Gfx::Bitmap> bitmap;
-    ByteBuffer compressed_data;
+    Vector<ReadonlyBytes> image_data_chunks;
     Vector<PaletteEntry> palette_data;
     ByteBuffer palette_transparency_data;
     Vector<AnimationFrame> animation_frames;
@@ -279,6 +273,51 @@ private:
     size_t m_size_remaining { 0 };
 };
 
+// The zlib stream of an image is split across its IDAT (or fdAT) chunks. This reads it straight out of
+// the chunks, without copying it into one buffer first.
+class ImageDataStream final : public Stream {
+public:
+    explicit ImageDataStream(Vector<ReadonlyBytes> const& chunks)
+        : m_chunks(chunks)
+    {
+    }
+
+    virtual ErrorOr<Bytes> read_some(Bytes bytes) override
+    {
+        size_t nread = 0;
+        while (nread < bytes.size() && m_chunk_index < m_chunks.size()) {
+            auto remaining = m_chunks[m_chunk_index].slice(m_offset_in_chunk);
+            auto copied = remaining.copy_trimmed_to(bytes.slice(nread));
+            nread += copied;
+            m_offset_in_chunk += copied;
+            if (m_offset_in_chunk == m_chunks[m_chunk_index].size()) {
+                ++m_chunk_index;
+                m_offset_in_chunk = 0;
+            }
+        }
+        return bytes.trim(nread);
+    }
+
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override { return Error::from_errno(EBADF); }
+
+    virtual bool is_eof() const override
+    {
+        for (size_t i = m_chunk_index; i < m_chunks.size(); ++i) {
+            if (m_chunks[i].size() > (i == m_chunk_index ? m_offset_in_chunk : 0))
+                return false;
+        }
+        return true;
+    }
+
+    virtual bool is_open() const override { return true; }
+    virtual void close() override { }
+
+private:
+    Vector<ReadonlyBytes> const& m_chunks;
+    size_t m_chunk_index { 0 };
+    size_t m_offset_in_chunk { 0 };
+};
+
 static ErrorOr<void> process_chunk(Streamer&, PNGLoadingContext& context);
 
 union [[gnu::packed]] Pixel {
@@ -293,6 +332,96 @@ union [[gnu::packed]] Pixel {
 };
 static_assert(AssertSize<Pixel, 4>());
 
+// Sub, Average and Paeth depend on the unfiltered pixel to the left, so pixels have to be done one after the other.
+// All bytes of a pixel can be done at once though. Returns the number of bytes that were unfiltered.
+template<PNG::FilterType filter, size_t bytes_per_complete_pixel, typename PixelVector>
+static size_t unfilter_pixels(Bytes scanline_data, ReadonlyBytes previous_scanlines_data)
+{
+    if (scanline_data.size() < sizeof(PixelVector))
+        return 0;
+
+    // Pixels with 3 or 6 bytes are loaded as 4 or 8 bytes. Clearing the extra bytes of the neighbors makes all
+    // filters leave the extra bytes alone, so they can be stored back as they are.
+    PixelVector neighbor_mask {};
+    for (size_t i = 0; i < bytes_per_complete_pixel; ++i)
+        neighbor_mask[i] = 0xff;
+
+    PixelVector left {};
+    PixelVector upper_left {};
+    auto pixel = AK::SIMD::load_unaligned<PixelVector>(scanline_data.data());
+    size_t i = 0;
+    while (true) {
+        auto const above = AK::SIMD::load_unaligned<PixelVector>(previous_scanlines_data.data() + i) & neighbor_mask;
+        if constexpr (filter == PNG::FilterType::Sub) {
+            pixel += left;
+        } else if constexpr (filter == PNG::FilterType::Average) {
+            // This is (left + above) / 2, without overflowing.
+            pixel += (left & above) + ((left ^ above) >> 1);
+        } else if constexpr (filter == PNG::FilterType::Paeth) {
+            pixel += PNG::paeth_predictor(left, above, upper_left);
+        }
+
+        // The next pixel overlaps with this one when they aren't a whole vector wide, so load it before storing
+        // this one. Loading it afterwards would have to wait for the store.
+        bool const has_next_pixel = i + bytes_per_complete_pixel + sizeof(PixelVector) <= scanline_data.size();
+        PixelVector next_pixel {};
+        if (has_next_pixel)
+            next_pixel = AK::SIMD::load_unaligned<PixelVector>(scanline_data.data() + i + bytes_per_complete_pixel);
+        AK::SIMD::store_unaligned(scanline_data.data() + i, pixel);
+        i += bytes_per_complete_pixel;
+        if (!has_next_pixel)
+            break;
+
+        left = pixel & neighbor_mask;
+        upper_left = above;
+        pixel = next_pixel;
+    }
+    return i;
+}
+
+template<PNG::FilterType filter>
+static void unfilter_bytes(Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel, size_t start)
+{
+    for (size_t i = start; i < scanline_data.size(); ++i) {
+        // All bytes before bytes_per_complete_pixel are guaranteed to have no valid byte at index
+        // (i - bytes_per_complete pixel). All such invalid byte indexes are treated as 0.
+        u8 left = (i < bytes_per_complete_pixel) ? 0 : scanline_data[i - bytes_per_complete_pixel];
+        u8 above = previous_scanlines_data[i];
+        if constexpr (filter == PNG::FilterType::Sub) {
+            scanline_data[i] += left;
+        } else if constexpr (filter == PNG::FilterType::Average) {
+            u8 average = (static_cast<u32>(left) + above) / 2;
+            scanline_data[i] += average;
+        } else if constexpr (filter == PNG::FilterType::Paeth) {
+            u8 upper_left = (i < bytes_per_complete_pixel) ? 0 : previous_scanlines_data[i - bytes_per_complete_pixel];
+            scanline_data[i] += PNG::paeth_predictor(left, above, upper_left);
+        }
+    }
+}
+
+template<PNG::FilterType filter>
+static void unfilter_scanline_with_left_neighbors(Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel)
+{
+    size_t unfiltered_bytes = 0;
+    switch (bytes_per_complete_pixel) {
+    case 3:
+        unfiltered_bytes = unfilter_pixels<filter, 3, AK::SIMD::u8x4>(scanline_data, previous_scanlines_data);
+        break;
+    case 4:
+        unfiltered_bytes = unfilter_pixels<filter, 4, AK::SIMD::u8x4>(scanline_data, previous_scanlines_data);
+        break;
+    case 6:
+        unfiltered_bytes = unfilter_pixels<filter, 6, AK::SIMD::u8x8>(scanline_data, previous_scanlines_data);
+        break;
+    case 8:
+        unfiltered_bytes = unfilter_pixels<filter, 8, AK::SIMD::u8x8>(scanline_data, previous_scanlines_data);
+        break;
+    default:
+        break;
+    }
+    unfilter_bytes<filter>(scanline_data, previous_scanlines_data, bytes_per_complete_pixel, unfiltered_bytes);
+}
+
 void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel)
 {
     // https://www.w3.org/TR/png-3/#9Filter-types
@@ -301,168 +430,108 @@ void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scan
     case PNG::FilterType::None:
         break;
     case PNG::FilterType::Sub:
-        // This loop starts at bytes_per_complete_pixel because all bytes before that are
-        // guaranteed to have no valid byte at index (i - bytes_per_complete pixel).
-        // All such invalid byte indexes should be treated as 0, and adding 0 to the current
-        // byte would do nothing, so the first bytes_per_complete_pixel bytes can instead
-        // just be skipped.
-        for (size_t i = bytes_per_complete_pixel; i < scanline_data.size(); ++i) {
-            u8 left = scanline_data[i - bytes_per_complete_pixel];
-            scanline_data[i] += left;
-        }
+        unfilter_scanline_with_left_neighbors<PNG::FilterType::Sub>(scanline_data, previous_scanlines_data, bytes_per_complete_pixel);
         break;
-    case PNG::FilterType::Up:
-        for (size_t i = 0; i < scanline_data.size(); ++i) {
+    case PNG::FilterType::Up: {
+        size_t i = 0;
+        for (; i + sizeof(AK::SIMD::u8x16) <= scanline_data.size(); i += sizeof(AK::SIMD::u8x16)) {
+            auto above = AK::SIMD::load_unaligned<AK::SIMD::u8x16>(previous_scanlines_data.data() + i);
+            AK::SIMD::store_unaligned(scanline_data.data() + i, AK::SIMD::load_unaligned<AK::SIMD::u8x16>(scanline_data.data() + i) + above);
+        }
+        for (; i < scanline_data.size(); ++i) {
             u8 above = previous_scanlines_data[i];
             scanline_data[i] += above;
         }
         break;
+    }
     case PNG::FilterType::Average:
-        for (size_t i = 0; i < scanline_data.size(); ++i) {
-            u32 left = (i < bytes_per_complete_pixel) ? 0 : scanline_data[i - bytes_per_complete_pixel];
-            u32 above = previous_scanlines_data[i];
-            u8 average = (left + above) / 2;
-            scanline_data[i] += average;
-        }
+        unfilter_scanline_with_left_neighbors<PNG::FilterType::Average>(scanline_data, previous_scanlines_data, bytes_per_complete_pixel);
         break;
     case PNG::FilterType::Paeth:
-        for (size_t i = 0; i < scanline_data.size(); ++i) {
-            u8 left = (i < bytes_per_complete_pixel) ? 0 : scanline_data[i - bytes_per_complete_pixel];
-            u8 above = previous_scanlines_data[i];
-            u8 upper_left = (i < bytes_per_complete_pixel) ? 0 : previous_scanlines_data[i - bytes_per_complete_pixel];
-            scanline_data[i] += PNG::paeth_predictor(left, above, upper_left);
-        }
+        unfilter_scanline_with_left_neighbors<PNG::FilterType::Paeth>(scanline_data, previous_scanlines_data, bytes_per_complete_pixel);
         break;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_without_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_grayscale_without_alpha(ReadonlyBytes scanline, Pixel* pixels, int width)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* gray_values = reinterpret_cast<T const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = gray_values[i];
-            pixel.g = gray_values[i];
-            pixel.b = gray_values[i];
-            pixel.a = 0xff;
-        }
+    auto* gray_values = reinterpret_cast<T const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = gray_values[i];
+        pixel.g = gray_values[i];
+        pixel.b = gray_values[i];
+        pixel.a = 0xff;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_with_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_grayscale_with_alpha(ReadonlyBytes scanline, Pixel* pixels, int width)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* tuples = reinterpret_cast<Tuple<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = tuples[i].gray;
-            pixel.g = tuples[i].gray;
-            pixel.b = tuples[i].gray;
-            pixel.a = tuples[i].a;
-        }
+    auto* tuples = reinterpret_cast<Tuple<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = tuples[i].gray;
+        pixel.g = tuples[i].gray;
+        pixel.b = tuples[i].gray;
+        pixel.a = tuples[i].a;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_without_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_triplets_without_alpha(ReadonlyBytes scanline, Pixel* pixels, int width)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            pixel.a = 0xff;
-        }
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        pixel.a = 0xff;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_with_transparency_value(PNGLoadingContext& context, Triplet<T> transparency_value)
+ALWAYS_INLINE static void unpack_triplets_with_transparency_value(ReadonlyBytes scanline, Pixel* pixels, int width, Triplet<T> transparency_value)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            if (triplets[i] == transparency_value)
-                pixel.a = 0x00;
-            else
-                pixel.a = 0xff;
-        }
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        if (triplets[i] == transparency_value)
+            pixel.a = 0x00;
+        else
+            pixel.a = 0xff;
     }
 }
 
-NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
+// Unpacks one unfiltered scanline to BGRA pixels.
+NEVER_INLINE FLATTEN static ErrorOr<void> unpack_scanline(PNGLoadingContext const& context, ReadonlyBytes scanline, ARGB32* destination, int width)
 {
-    // First unfilter the scanlines:
-
-    // FIXME: Instead of creating a separate buffer for the scanlines that need to be
-    //        mutated, the mutation could be done in place (if the data was non-const).
-    size_t bytes_per_scanline = context.scanlines[0].data.size();
-    size_t bytes_needed_for_all_unfiltered_scanlines = 0;
-    for (int y = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            bytes_needed_for_all_unfiltered_scanlines += bytes_per_scanline;
-        }
-    }
-    context.unfiltered_data = TRY(ByteBuffer::create_uninitialized(bytes_needed_for_all_unfiltered_scanlines));
-
-    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
-    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
-    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
-    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
-    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
-    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
-    u8 bytes_per_complete_pixel = ceil_div(context.bit_depth, (u8)8) * context.channels;
-
-    u8 dummy_scanline_bytes[bytes_per_scanline];
-    memset(dummy_scanline_bytes, 0, sizeof(dummy_scanline_bytes));
-    auto previous_scanlines_data = ReadonlyBytes { dummy_scanline_bytes, sizeof(dummy_scanline_bytes) };
-
-    for (int y = 0, data_start = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            auto scanline_data_slice = context.unfiltered_data.bytes().slice(data_start, bytes_per_scanline);
-
-            // Copy the current values over and set the scanline's data to the to-be-mutated slice
-            context.scanlines[y].data.copy_to(scanline_data_slice);
-            context.scanlines[y].data = scanline_data_slice;
-
-            PNGImageDecoderPlugin::unfilter_scanline(context.scanlines[y].filter, scanline_data_slice, previous_scanlines_data, bytes_per_complete_pixel);
+    auto* pixels = reinterpret_cast<Pixel*>(destination);
 
-            data_start += bytes_per_scanline;
-        }
-        previous_scanlines_data = context.scanlines[y].data;
-    }
-
-    // Now unpack the scanlines to RGBA:
     switch (context.color_type) {
     case PNG::ColorType::Greyscale:
         if (context.bit_depth == 8) {
-            unpack_grayscale_without_alpha<u8>(context);
+            unpack_grayscale_without_alpha<u8>(scanline, pixels, width);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_without_alpha<u16>(context);
+            unpack_grayscale_without_alpha<u16>(scanline, pixels, width);
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto bit_depth_squared = context.bit_depth * context.bit_depth;
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* gray_values = context.scanlines[y].data.data();
-                for (int x = 0; x < context.width; ++x) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
-                    auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[x];
-                    pixel.r = value * (0xff / bit_depth_squared);
-                    pixel.g = value * (0xff / bit_depth_squared);
-                    pixel.b = value * (0xff / bit_depth_squared);
-                    pixel.a = 0xff;
-                }
+            auto* gray_values = scanline.data();
+            for (int x = 0; x < width; ++x) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
+                auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = pixels[x];
+                pixel.r = value * (0xff / bit_depth_squared);
+                pixel.g = value * (0xff / bit_depth_squared);
+                pixel.b = value * (0xff / bit_depth_squared);
+                pixel.a = 0xff;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -470,9 +539,9 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::GreyscaleWithAlpha:
         if (context.bit_depth == 8) {
-            unpack_grayscale_with_alpha<u8>(context);
+            unpack_grayscale_with_alpha<u8>(scanline, pixels, width);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_with_alpha<u16>(context);
+            unpack_grayscale_with_alpha<u16>(scanline, pixels, width);
         } else {
             VERIFY_NOT_REACHED();
         }
@@ -480,39 +549,35 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     case PNG::ColorType::Truecolor:
         if (context.palette_transparency_data.size() == 6) {
             if (context.bit_depth == 8) {
-                unpack_triplets_with_transparency_value<u8>(context, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
+                unpack_triplets_with_transparency_value<u8>(scanline, pixels, width, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
             } else if (context.bit_depth == 16) {
                 u16 tr = context.palette_transparency_data[0] | context.palette_transparency_data[1] << 8;
                 u16 tg = context.palette_transparency_data[2] | context.palette_transparency_data[3] << 8;
                 u16 tb = context.palette_transparency_data[4] | context.palette_transparency_data[5] << 8;
-                unpack_triplets_with_transparency_value<u16>(context, Triplet<u16> { tr, tg, tb });
+                unpack_triplets_with_transparency_value<u16>(scanline, pixels, width, Triplet<u16> { tr, tg, tb });
             } else {
                 VERIFY_NOT_REACHED();
             }
         } else {
             if (context.bit_depth == 8)
-                unpack_triplets_without_alpha<u8>(context);
+                unpack_triplets_without_alpha<u8>(scanline, pixels, width);
             else if (context.bit_depth == 16)
-                unpack_triplets_without_alpha<u16>(context);
+                unpack_triplets_without_alpha<u16>(scanline, pixels, width);
             else
                 VERIFY_NOT_REACHED();
         }
         break;
     case PNG::ColorType::TruecolorWithAlpha:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                memcpy(context.bitmap->scanline(y), context.scanlines[y].data.data(), context.scanlines[y].data.size());
-            }
+            memcpy(pixels, scanline.data(), width * sizeof(Pixel));
         } else if (context.bit_depth == 16) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* quartets = reinterpret_cast<Quartet<u16> const*>(context.scanlines[y].data.data());
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    pixel.r = quartets[i].r & 0xFF;
-                    pixel.g = quartets[i].g & 0xFF;
-                    pixel.b = quartets[i].b & 0xFF;
-                    pixel.a = quartets[i].a & 0xFF;
-                }
+            auto* quartets = reinterpret_cast<Quartet<u16> const*>(scanline.data());
+            for (int i = 0; i < width; ++i) {
+                auto& pixel = pixels[i];
+                pixel.r = quartets[i].r & 0xFF;
+                pixel.g = quartets[i].g & 0xFF;
+                pixel.b = quartets[i].b & 0xFF;
+                pixel.a = quartets[i].a & 0xFF;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -520,42 +585,38 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::IndexedColor:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_index = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if (palette_index[i] >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at((int)palette_index[i]);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
-                        ? context.palette_transparency_data[palette_index[i]]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_index = scanline.data();
+            for (int i = 0; i < width; ++i) {
+                auto& pixel = pixels[i];
+                if (palette_index[i] >= context.palette_data.size())
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+                auto& color = context.palette_data.at((int)palette_index[i]);
+                auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
+                    ? context.palette_transparency_data[palette_index[i]]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_indices = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
-                    auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if ((size_t)palette_index >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at(palette_index);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
-                        ? context.palette_transparency_data[palette_index]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_indices = scanline.data();
+            for (int i = 0; i < width; ++i) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
+                auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = pixels[i];
+                if ((size_t)palette_index >= context.palette_data.size())
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+                auto& color = context.palette_data.at(palette_index);
+                auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
+                    ? context.palette_transparency_data[palette_index]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -567,12 +628,9 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     }
 
     // Swap r and b values:
-    for (int y = 0; y < context.height; ++y) {
-        auto* pixels = (Pixel*)context.bitmap->scanline(y);
-        for (int i = 0; i < context.bitmap->width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
-        }
+    for (int i = 0; i < width; ++i) {
+        auto& x = pixels[i];
+        swap(x.r, x.b);
     }
 
     return {};
@@ -683,8 +741,6 @@ static bool decode_png_chunks(PNGLoadingContext& context)
 
     size_t data_remaining = context.data_size - (context.data_current_ptr - context.data);
 
-    context.compressed_data.ensure_capacity(context.data_size);
-
     Streamer streamer(context.data_current_ptr, data_remaining);
     while (!streamer.at_end() && !context.has_seen_iend) {
         if (auto result = process_chunk(streamer, context); result.is_error()) {
@@ -700,36 +756,76 @@ static bool decode_png_chunks(PNGLoadingContext& context)
     return true;
 }
 
-static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, ByteBuffer& decompression_buffer)
-{
-    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
-
-    for (int y = 0; y < context.height; ++y) {
-        u8 filter_byte;
-        if (!streamer.read(filter_byte)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-
-        if (filter_byte > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
-        }
+// Inflates the image data and undoes the filtering one scanline at a time, so that only two scanlines of
+// decompressed data are in memory at once.
+class ScanlineDecoder {
+public:
+    static ErrorOr<NonnullOwnPtr<ScanlineDecoder>> create(PNGLoadingContext& context, Vector<ReadonlyBytes> const& image_data_chunks)
+    {
+        auto decoder = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ScanlineDecoder(context, image_data_chunks)));
+        decoder->m_decompressor = TRY(Compress::ZlibDecompressor::create(MaybeOwned<Stream> { decoder->m_image_data }));
+        return decoder;
+    }
 
-        context.scanlines.append({ MUST(PNG::filter_type(filter_byte)) });
-        auto& scanline_buffer = context.scanlines.last().data;
-        auto row_size = context.compute_row_size_for_width(context.width);
+    // Has to be called before the first scanline of the image, and of each Adam7 pass, which don't
+    // filter against the pass before them.
+    ErrorOr<void> start_image(int width)
+    {
+        auto row_size = m_context.compute_row_size_for_width(width);
         if (row_size.has_overflow())
             return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
 
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
+        // Each scanline starts with its filter type.
+        m_scanline = TRY(ByteBuffer::create_zeroed(row_size.value() + 1));
+        m_previous_scanline = TRY(ByteBuffer::create_zeroed(row_size.value() + 1));
+        return {};
+    }
+
+    ErrorOr<ReadonlyBytes> next_scanline()
+    {
+        swap(m_scanline, m_previous_scanline);
+        if (m_decompressor->read_until_filled(m_scanline).is_error())
             return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
+
+        auto filter = TRY(PNG::filter_type(m_scanline[0]));
+        auto scanline_data = m_scanline.bytes().slice(1);
+        PNGImageDecoderPlugin::unfilter_scanline(filter, scanline_data, m_previous_scanline.bytes().slice(1), m_bytes_per_complete_pixel);
+        return scanline_data;
     }
 
+private:
+    ScanlineDecoder(PNGLoadingContext& context, Vector<ReadonlyBytes> const& image_data_chunks)
+        : m_context(context)
+        , m_image_data(image_data_chunks)
+    {
+        // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
+        // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
+        // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
+        // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
+        // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
+        // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
+        m_bytes_per_complete_pixel = ceil_div(context.bit_depth, (u8)8) * context.channels;
+    }
+
+    PNGLoadingContext& m_context;
+    ImageDataStream m_image_data;
+    OwnPtr<Compress::ZlibDecompressor> m_decompressor;
+    u8 m_bytes_per_complete_pixel { 0 };
+    ByteBuffer m_scanline;
+    ByteBuffer m_previous_scanline;
+};
+
+static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, Vector<ReadonlyBytes> const& image_data_chunks)
+{
+    auto decoder = TRY(ScanlineDecoder::create(context, image_data_chunks));
+    TRY(decoder->start_image(context.width));
+
     context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
-    return unfilter(context);
+    for (int y = 0; y < context.height; ++y) {
+        auto scanline = TRY(decoder->next_scanline());
+        TRY(unpack_scanline(context, scanline, context.bitmap->scanline(y), context.width));
+    }
+    return {};
 }
 
 static int adam7_height(PNGLoadingContext& context, int pass)
@@ -782,59 +878,56 @@ static int adam7_startx[8] = { 0, 0, 4, 0, 2, 0, 1, 0 };
 static int adam7_stepy[8] = { 1, 8, 8, 8, 4, 4, 2, 2 };
 static int adam7_stepx[8] = { 1, 8, 8, 4, 4, 2, 2, 1 };
 
-static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, int pass)
+static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, ScanlineDecoder& decoder, int pass, Vector<ARGB32>& pass_pixels)
 {
-    auto subimage_context = context.create_subimage_context(adam7_width(context, pass), adam7_height(context, pass));
+    int const width = adam7_width(context, pass);
+    int const height = adam7_height(context, pass);
 
     // For small images, some passes might be empty
-    if (!subimage_context.width || !subimage_context.height)
+    if (!width || !height)
         return {};
 
-    for (int y = 0; y < subimage_context.height; ++y) {
-        u8 filter_byte;
-        if (!streamer.read(filter_byte)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
+    TRY(decoder.start_image(width));
+    TRY(pass_pixels.try_resize(width));
 
-        if (filter_byte > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
-        }
-
-        subimage_context.scanlines.append({ MUST(PNG::filter_type(filter_byte)) });
-        auto& scanline_buffer = subimage_context.scanlines.last().data;
+    // Copy the pass's pixels into the main image according to the pass pattern
+    for (int y = 0, dy = adam7_starty[pass]; y < height; ++y, dy += adam7_stepy[pass]) {
+        auto scanline = TRY(decoder.next_scanline());
+        TRY(unpack_scanline(context, scanline, pass_pixels.data(), width));
+        if (dy >= context.height)
+            continue;
 
-        auto row_size = context.compute_row_size_for_width(subimage_context.width);
-        if (row_size.has_overflow())
-            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-    }
-
-    subimage_context.bitmap = TRY(Bitmap::create(context.bitmap->format(), { subimage_context.width, subimage_context.height }));
-    TRY(unfilter(subimage_context));
-
-    // Copy the subimage data into the main image according to the pass pattern
-    for (int y = 0, dy = adam7_starty[pass]; y < subimage_context.height && dy < context.height; ++y, dy += adam7_stepy[pass]) {
-        for (int x = 0, dx = adam7_startx[pass]; x < subimage_context.width && dx < context.width; ++x, dx += adam7_stepx[pass]) {
-            context.bitmap->set_pixel(dx, dy, subimage_context.bitmap->get_pixel(x, y));
-        }
+        auto* destination = context.bitmap->scanline(dy);
+        for (int x = 0, dx = adam7_startx[pass]; x < width && dx < context.width; ++x, dx += adam7_stepx[pass])
+            destination[dx] = pass_pixels[x];
     }
     return {};
 }
 
-static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, ByteBuffer& decompression_buffer)
+static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, Vector<ReadonlyBytes> const& image_data_chunks)
 {
-    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
+    auto decoder = TRY(ScanlineDecoder::create(context, image_data_chunks));
     context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
+
+    // Each pass goes straight into the bitmap, so it holds a coarser version of the image after each of them.
+    Vector<ARGB32> pass_pixels;
     for (int pass = 1; pass <= 7; ++pass)
-        TRY(decode_adam7_pass(context, streamer, pass));
+        TRY(decode_adam7_pass(context, *decoder, pass, pass_pixels));
     return {};
 }
 
+static ErrorOr<void> decode_png_image_data(PNGLoadingContext& context, Vector<ReadonlyBytes> const& image_data_chunks)
+{
+    switch (context.interlace_method) {
+    case PngInterlaceMethod::Null:
+        return decode_png_bitmap_simple(context, image_data_chunks);
+    case PngInterlaceMethod::Adam7:
+        return decode_png_adam7(context, image_data_chunks);
+    default:
+        return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
+    }
+}
+
 static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
 {
     if (context.state < PNGLoadingContext::State::ChunksDecoded) {
@@ -848,33 +941,11 @@ static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
     if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
         return Error::from_string_literal("PNGImageDecoderPlugin: Didn't see a PLTE chunk for a palletized image, or it was empty.");
 
-    auto compressed_data_stream = make<FixedMemoryStream>(context.compressed_data.span());
-    auto decompressor_or_error = Compress::ZlibDecompressor::create(move(compressed_data_stream));
-    if (decompressor_or_error.is_error()) {
+    if (auto result = decode_png_image_data(context, context.image_data_chunks); result.is_error()) {
         context.state = PNGLoadingContext::State::Error;
-        return decompressor_or_error.release_error();
-    }
-    auto decompressor = decompressor_or_error.release_value();
-    auto result_or_error = decompressor->read_until_eof();
-    if (result_or_error.is_error()) {
-        context.state = PNGLoadingContext::State::Error;
-        return result_or_error.release_error();
-    }
-    auto decompression_buffer = result_or_error.release_value();
-    context.compressed_data.clear();
-
-    context.scanlines.ensure_capacity(context.height);
-    switch (context.interlace_method) {
-    case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(context, decompression_buffer));
-        break;
-    case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(context, decompression_buffer));
-        break;
-    default:
-        context.state = PNGLoadingContext::State::Error;
-        return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
+        return result.release_error();
     }
+    context.image_data_chunks.clear();
 
     context.state = PNGLoadingContext::State::BitmapDecoded;
     return {};
@@ -889,23 +960,9 @@ static ErrorOr<RefPtr<Bitmap>> decode_png_animation_frame_bitmap(PNGLoadingConte
 
     auto frame_rect = animation_frame.rect();
     auto frame_context = context.create_subimage_context(frame_rect.width(), frame_rect.height());
+    frame_context.interlace_method = context.interlace_method;
 
-    auto compressed_data_stream = make<FixedMemoryStream>(animation_frame.compressed_data.span());
-    auto decompressor = TRY(Compress::ZlibDecompressor::create(move(compressed_data_stream)));
-    auto decompression_buffer = TRY(decompressor->read_until_eof());
-    frame_context.compressed_data.clear();
-
-    frame_context.scanlines.ensure_capacity(frame_context.height);
-    switch (context.interlace_method) {
-    case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(frame_context, decompression_buffer));
-        break;
-    case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(frame_context, decompression_buffer));
-        break;
-    default:
-        return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
-    }
+    TRY(decode_png_image_data(frame_context, animation_frame.image_data_chunks));
 
     context.state = PNGLoadingContext::State::BitmapDecoded;
     return move(frame_context.bitmap);
@@ -1004,7 +1061,7 @@ static ErrorOr<void> process_IHDR(ReadonlyBytes data, PNGLoadingContext& context
 
 static ErrorOr<void> process_IDAT(ReadonlyBytes data, PNGLoadingContext& context)
 {
-    context.compressed_data.append(data);
+    TRY(context.image_data_chunks.try_append(data));
     if (context.state < PNGLoadingContext::State::ImageDataChunkDecoded)
         context.state = PNGLoadingContext::State::ImageDataChunkDecoded;
     return {};
@@ -1175,8 +1232,7 @@ static ErrorOr<void> process_fdAT(ReadonlyBytes data, PNGLoadingContext& context
     if (context.animation_frames.is_empty())
         return Error::from_string_literal("No frame available");
     auto& current_animation_frame = context.animation_frames[context.animation_frames.size() - 1];
-    auto compressed_data = data.slice(4);
-    current_animation_frame.compressed_data.append(compressed_data.data(), compressed_data.size());
+    TRY(current_animation_frame.image_data_chunks.try_append(data.slice(4)));
     return {};
 }
 
@@ -55,23 +55,34 @@ ALWAYS_INLINE u8 paeth_predictor(u8 a, u8 b, u8 c)
     return c;
 }
 
-ALWAYS_INLINE AK::SIMD::u8x4 paeth_predictor(AK::SIMD::u8x4 a, AK::SIMD::u8x4 b, AK::SIMD::u8x4 c)
+template<typename U8Vector, typename I16Vector>
+ALWAYS_INLINE U8Vector paeth_predictor(U8Vector a, U8Vector b, U8Vector c)
 {
     using namespace AK::SIMD;
-    auto a16 = simd_cast<i16x4>(a);
-    auto b16 = simd_cast<i16x4>(b);
-    auto c16 = simd_cast<i16x4>(c);
+    auto a16 = simd_cast<I16Vector>(a);
+    auto b16 = simd_cast<I16Vector>(b);
+    auto c16 = simd_cast<I16Vector>(c);
 
     auto p16 = a16 + b16 - c16;
     auto pa16 = abs(p16 - a16);
     auto pb16 = abs(p16 - b16);
     auto pc16 = abs(p16 - c16);
 
-    auto mask_a = simd_cast<u8x4>((pa16 <= pb16) & (pa16 <= pc16));
-    auto mask_b = ~mask_a & simd_cast<u8x4>(pb16 <= pc16);
+    auto mask_a = simd_cast<U8Vector>((pa16 <= pb16) & (pa16 <= pc16));
+    auto mask_b = ~mask_a & simd_cast<U8Vector>(pb16 <= pc16);
     auto mask_c = ~(mask_a | mask_b);
 
     return (a & mask_a) | (b & mask_b) | (c & mask_c);
 }
 
+ALWAYS_INLINE AK::SIMD::u8x4 paeth_predictor(AK::SIMD::u8x4 a, AK::SIMD::u8x4 b, AK::SIMD::u8x4 c)
+{
+    return paeth_predictor<AK::SIMD::u8x4, AK::SIMD::i16x4>(a, b, c);
+}
+
+ALWAYS_INLINE AK::SIMD::u8x8 paeth_predictor(AK::SIMD::u8x8 a, AK::SIMD::u8x8 b, AK::SIMD::u8x8 c)
+{
+    return paeth_predictor<AK::SIMD::u8x8, AK::SIMD::i16x8>(a, b, c);
+}
+
 };
@@ -26,6 +26,7 @@
 #include <AK/StringBuilder.h>
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
+#include <LibGfx/BlendingKernels.h>
 #include <LibGfx/CharacterBitmap.h>
 #include <LibGfx/Palette.h>
 #include <LibGfx/Path.h>
@@ -109,9 +110,9 @@ void Painter::fill_physical_rect(IntRect const& physical_rect, Color color)
     size_t const dst_skip = m_target->pitch() / sizeof(ARGB32);
 
     auto dst_format = target()->format();
+    VERIFY(dst_format == BitmapFormat::BGRA8888 || dst_format == BitmapFormat::BGRx8888);
     for (int i = physical_rect.height() - 1; i >= 0; --i) {
-        for (int j = 0; j < physical_rect.width(); ++j)
-            dst[j] = color_for_format(dst_format, dst[j]).blend(color).value();
+        blend_color_over_pixels(dst, physical_rect.width(), color, dst_format == BitmapFormat::BGRA8888);
         dst += dst_skip;
     }
 }
@@ -824,39 +825,19 @@ struct BlitState {
     BitmapFormat src_format;
 };
 
-// FIXME: This is a hack to support blit_with_opacity() with RGBA8888 source.
-//        Ideally we'd have a more generic solution that allows any source format.
-static void swap_red_and_blue_channels(Color& color)
-{
-    u32 rgba = color.value();
-    u32 bgra = (rgba & 0xff00ff00)
-        | ((rgba & 0x000000ff) << 16)
-        | ((rgba & 0x00ff0000) >> 16);
-    color = Color::from_argb(bgra);
-}
-
-// FIXME: This function is very unoptimized.
 template<BlitState::AlphaState has_alpha>
 static void do_blit_with_opacity(BlitState& state)
 {
+    OpacityBlend options {
+        .opacity = state.opacity,
+        .source_has_alpha = (has_alpha & BlitState::SrcAlpha) != 0,
+        // FIXME: This is a hack to support blit_with_opacity() with RGBA8888 source.
+        //        Ideally we'd have a more generic solution that allows any source format.
+        .source_is_rgba = state.src_format == BitmapFormat::RGBA8888,
+        .destination_has_alpha = (has_alpha & BlitState::DstAlpha) != 0,
+    };
     for (int row = 0; row < state.row_count; ++row) {
-        for (int x = 0; x < state.column_count; ++x) {
-            Color dest_color = (has_alpha & BlitState::DstAlpha) ? Color::from_argb(state.dst[x]) : Color::from_rgb(state.dst[x]);
-            if constexpr (has_alpha & BlitState::SrcAlpha) {
-                Color src_color_with_alpha = Color::from_argb(state.src[x]);
-                if (state.src_format == BitmapFormat::RGBA8888)
-                    swap_red_and_blue_channels(src_color_with_alpha);
-                float pixel_opacity = src_color_with_alpha.alpha() / 255.0;
-                src_color_with_alpha.set_alpha(255 * (state.opacity * pixel_opacity));
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
-            } else {
-                Color src_color_with_alpha = Color::from_rgb(state.src[x]);
-                if (state.src_format == BitmapFormat::RGBA8888)
-                    swap_red_and_blue_channels(src_color_with_alpha);
-                src_color_with_alpha.set_alpha(state.opacity * 255);
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
-            }
-        }
+        blend_pixels_with_opacity(state.dst, state.src, state.column_count, options);
         state.dst += state.dst_pitch;
         state.src += state.src_pitch;
     }
@@ -1220,6 +1201,49 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
     i64 src_left = src_rect.left() * shift;
     i64 src_top = src_rect.top() * shift;
 
+    if constexpr (scaling_mode == Painter::ScalingMode::BilinearBlend) {
+        // Gather the samples for a run of pixels at a time, and leave mixing and blending them to the vectorized kernel.
+        static constexpr int run_length = 64;
+        Array<ARGB32, run_length> top_left;
+        Array<ARGB32, run_length> top_right;
+        Array<ARGB32, run_length> bottom_left;
+        Array<ARGB32, run_length> bottom_right;
+        Array<float, run_length> x_ratios;
+
+        for (int y = clipped_rect.top(); y < clipped_rect.bottom(); ++y) {
+            auto shifted_y = (y - dst_rect.y()) * vscale + src_top + bilinear_offset_y;
+            auto scaled_y0 = clamp(shifted_y >> 32, clipped_src_rect.top(), clipped_src_rect.bottom() - 1);
+            auto scaled_y1 = clamp((shifted_y >> 32) + 1, clipped_src_rect.top(), clipped_src_rect.bottom() - 1);
+            float y_ratio = (shifted_y & fractional_mask) / static_cast<float>(shift);
+
+            for (int run_start = clipped_rect.left(); run_start < clipped_rect.right(); run_start += run_length) {
+                int count = min(run_length, clipped_rect.right() - run_start);
+                for (int i = 0; i < count; ++i) {
+                    auto shifted_x = (run_start + i - dst_rect.x()) * hscale + src_left + bilinear_offset_x;
+                    auto scaled_x0 = clamp(shifted_x >> 32, clipped_src_rect.left(), clipped_src_rect.right() - 1);
+                    auto scaled_x1 = clamp((shifted_x >> 32) + 1, clipped_src_rect.left(), clipped_src_rect.right() - 1);
+                    x_ratios[i] = (shifted_x & fractional_mask) / static_cast<float>(shift);
+
+                    top_left[i] = get_pixel(source, scaled_x0, scaled_y0).value();
+                    top_right[i] = get_pixel(source, scaled_x1, scaled_y0).value();
+                    bottom_left[i] = get_pixel(source, scaled_x0, scaled_y1).value();
+                    bottom_right[i] = get_pixel(source, scaled_x1, scaled_y1).value();
+                }
+
+                BilinearSamples samples {
+                    .top_left = top_left.data(),
+                    .top_right = top_right.data(),
+                    .bottom_left = bottom_left.data(),
+                    .bottom_right = bottom_right.data(),
+                    .x_ratios = x_ratios.data(),
+                    .y_ratio = y_ratio,
+                };
+                draw_bilinear_samples(target.scanline(y) + run_start, samples, count, opacity, has_alpha_channel);
+            }
+        }
+        return;
+    }
+
     for (int y = clipped_rect.top(); y < clipped_rect.bottom(); ++y) {
         auto* scanline = reinterpret_cast<Color*>(target.scanline(y));
         auto desired_y = (y - dst_rect.y()) * vscale + src_top;
@@ -1228,28 +1252,7 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
             auto desired_x = (x - dst_rect.x()) * hscale + src_left;
 
             Color src_pixel;
-            if constexpr (scaling_mode == Painter::ScalingMode::BilinearBlend) {
-                auto shifted_x = desired_x + bilinear_offset_x;
-                auto shifted_y = desired_y + bilinear_offset_y;
-
-                auto scaled_x0 = clamp(shifted_x >> 32, clipped_src_rect.left(), clipped_src_rect.right() - 1);
-                auto scaled_x1 = clamp((shifted_x >> 32) + 1, clipped_src_rect.left(), clipped_src_rect.right() - 1);
-                auto scaled_y0 = clamp(shifted_y >> 32, clipped_src_rect.top(), clipped_src_rect.bottom() - 1);
-                auto scaled_y1 = clamp((shifted_y >> 32) + 1, clipped_src_rect.top(), clipped_src_rect.bottom() - 1);
-
-                float x_ratio = (shifted_x & fractional_mask) / static_cast<float>(shift);
-                float y_ratio = (shifted_y & fractional_mask) / static_cast<float>(shift);
-
-                auto top_left = get_pixel(source, scaled_x0, scaled_y0);
-                auto top_right = get_pixel(source, scaled_x1, scaled_y0);
-                auto bottom_left = get_pixel(source, scaled_x0, scaled_y1);
-                auto bottom_right = get_pixel(source, scaled_x1, scaled_y1);
-
-                auto top = top_left.mixed_with(top_right, x_ratio);
-                auto bottom = bottom_left.mixed_with(bottom_right, x_ratio);
-
-                src_pixel = top.mixed_with(bottom, y_ratio);
-            } else if constexpr (scaling_mode == Painter::ScalingMode::SmoothPixels) {
+            if constexpr (scaling_mode == Painter::ScalingMode::SmoothPixels) {
                 auto scaled_x1 = clamp(desired_x >> 32, clipped_src_rect.left(), clipped_src_rect.right() - 1);
                 auto scaled_x0 = clamp(scaled_x1 - 1, clipped_src_rect.left(), clipped_src_rect.right() - 1);
                 auto scaled_y1 = clamp(desired_y >> 32, clipped_src_rect.top(), clipped_src_rect.bottom() - 1);
@@ -5,14 +5,53 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/MemoryStream.h>
 #include <LibCore/System.h>
 #include <LibIPC/Connection.h>
 #include <LibIPC/File.h>
 #include <LibIPC/Stub.h>
+#include <sched.h>
 #include <sys/select.h>
 
 namespace IPC {
 
+// These set up the shared memory transport, and are handled by the connection itself. They look like
+// messages of an endpoint whose magic number is zero, which no real endpoint has.
+static constexpr u32 control_message_magic = 0;
+
+enum class ControlMessage : u32 {
+    // Sent by the client, along with the file descriptor and size of the shared memory.
+    OfferSharedMemory,
+    // Sent by the server. All of its messages after this one are sent over shared memory.
+    AcceptSharedMemory,
+    // Sent by the client. All of its messages after this one are sent over shared memory.
+    StartUsingSharedMemory,
+};
+
+static ErrorOr<MessageBuffer> encode_control_message(ControlMessage message)
+{
+    MessageBuffer buffer;
+    TRY(buffer.append_data(reinterpret_cast<u8 const*>(&control_message_magic), sizeof(control_message_magic)));
+    TRY(buffer.append_data(reinterpret_cast<u8 const*>(&message), sizeof(message)));
+    return buffer;
+}
+
+static bool is_control_message(ReadonlyBytes bytes)
+{
+    u32 magic = 0;
+    if (bytes.size() < sizeof(magic) + sizeof(ControlMessage))
+        return false;
+    memcpy(&magic, bytes.data(), sizeof(magic));
+    return magic == control_message_magic;
+}
+
+// How long a wait for the shared memory ring may take before we check whether the socket has been closed.
+static constexpr int socket_poll_interval_ms = 100;
+
+// How often we give the other end a chance to make room in the ring, before we consider it unresponsive.
+// This matches how long we keep retrying writes to a full socket.
+static constexpr size_t max_attempts_to_write_to_ring = 100;
+
 struct CoreEventLoopDeferredInvoker final : public DeferredInvoker {
     virtual ~CoreEventLoopDeferredInvoker() = default;
 
@@ -48,7 +87,10 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer, MessageKind kin
     if (!m_socket->is_open())
         return Error::from_string_literal("Trying to post_message during IPC shutdown");
 
-    if (auto result = buffer.transfer_message(*m_socket, kind == MessageKind::Sync); result.is_error()) {
+    auto result = m_sends_over_shared_memory
+        ? post_message_over_shared_memory(buffer, kind)
+        : buffer.transfer_message(*m_socket, kind == MessageKind::Sync);
+    if (result.is_error()) {
         shutdown_with_error(result.error());
         return result.release_error();
     }
@@ -57,6 +99,101 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer, MessageKind kin
     return {};
 }
 
+ErrorOr<void> ConnectionBase::post_message_over_shared_memory(MessageBuffer& buffer, MessageKind kind)
+{
+    auto& ring = m_shared_memory_transport->outgoing();
+
+    // File descriptors can only be passed over the socket. The ring then only gets a marker, so that the other end
+    // knows where the message goes among the others. Once the message is on the socket there is no taking it back,
+    // so the marker has to be in the ring before that.
+    bool use_socket = buffer.has_file_descriptors() || buffer.payload().size() > MessageRing::max_message_size;
+
+    auto wake_reader = [&]() -> ErrorOr<void> {
+        if (ring.wake_reader() == MessageRing::WakeUp::OverSocket) {
+            // The other end is waiting in its event loop, so ring the doorbell with an empty message.
+            MessageBuffer doorbell;
+            TRY(doorbell.transfer_message(*m_socket, kind == MessageKind::Sync));
+        }
+        return {};
+    };
+
+    for (size_t attempt = 0;; ++attempt) {
+        if (use_socket ? ring.try_write_socket_marker() : ring.try_write(buffer.payload()))
+            break;
+
+        if (attempt == max_attempts_to_write_to_ring)
+            return Error::from_string_literal("IPC::post_message: Peer buffer overflowed");
+
+        // The ring is full. The other end may be busy sending to us too, so make room on our side before waiting.
+        TRY(wake_reader());
+        TRY(drain_messages_from_peer());
+        sched_yield();
+    }
+
+    if (use_socket) {
+        // The message itself wakes up the other end if it waits in its event loop, no need to ring the doorbell.
+        (void)ring.wake_reader();
+        return buffer.transfer_message(*m_socket, kind == MessageKind::Sync);
+    }
+    return wake_reader();
+}
+
+ErrorOr<void> ConnectionBase::request_shared_memory_transport()
+{
+    if (!SharedMemoryTransport::is_supported() || m_shared_memory_transport)
+        return {};
+
+    auto transport = TRY(SharedMemoryTransport::create());
+    auto buffer = TRY(encode_control_message(ControlMessage::OfferSharedMemory));
+    u32 size = transport->buffer().size();
+    TRY(buffer.append_data(reinterpret_cast<u8 const*>(&size), sizeof(size)));
+    TRY(buffer.append_file_descriptor(TRY(Core::System::dup(transport->buffer().fd()))));
+
+    m_shared_memory_transport = move(transport);
+    return post_message(move(buffer), MessageKind::Async);
+}
+
+ErrorOr<void> ConnectionBase::handle_control_message(ReadonlyBytes bytes)
+{
+    FixedMemoryStream stream { bytes };
+    TRY(stream.discard(sizeof(control_message_magic)));
+    auto message = static_cast<ControlMessage>(TRY(stream.read_value<u32>()));
+
+    switch (message) {
+    case ControlMessage::OfferSharedMemory: {
+        auto size = TRY(stream.read_value<u32>());
+        if (m_unprocessed_fds.is_empty())
+            return Error::from_string_literal("Shared memory was offered without a file descriptor");
+        auto file = m_unprocessed_fds.dequeue();
+
+        // If we can't use the shared memory for whatever reason, we simply don't answer, and the other end will keep using the socket.
+        if (m_shared_memory_transport)
+            return Error::from_string_literal("Shared memory was offered more than once");
+        auto buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(file.take_fd(), size));
+        m_shared_memory_transport = TRY(SharedMemoryTransport::attach(move(buffer)));
+
+        TRY(post_message(TRY(encode_control_message(ControlMessage::AcceptSharedMemory)), MessageKind::Async));
+        m_sends_over_shared_memory = true;
+        return {};
+    }
+    case ControlMessage::AcceptSharedMemory:
+        if (!m_shared_memory_transport || m_receives_over_shared_memory)
+            return Error::from_string_literal("Unexpected acceptance of shared memory");
+        m_receives_over_shared_memory = true;
+
+        TRY(post_message(TRY(encode_control_message(ControlMessage::StartUsingSharedMemory)), MessageKind::Async));
+        m_sends_over_shared_memory = true;
+        return {};
+    case ControlMessage::StartUsingSharedMemory:
+        if (!m_shared_memory_transport || m_receives_over_shared_memory)
+            return Error::from_string_literal("Unexpected start of shared memory use");
+        m_receives_over_shared_memory = true;
+        return {};
+    }
+
+    return Error::from_string_literal("Unknown control message");
+}
+
 void ConnectionBase::shutdown()
 {
     m_socket->close();
@@ -101,6 +238,23 @@ void ConnectionBase::wait_for_socket_to_become_readable()
     VERIFY(maybe_did_become_readable.value());
 }
 
+void ConnectionBase::wait_for_messages_from_peer()
+{
+    if (!m_receives_over_shared_memory || m_waiting_for_message_from_socket) {
+        wait_for_socket_to_become_readable();
+        return;
+    }
+
+    // Every message comes through the ring, even those sent over the socket, but we only learn about
+    // the other end going away from the socket.
+    auto& ring = m_shared_memory_transport->incoming();
+    while (!ring.wait_for_record(socket_poll_interval_ms)) {
+        auto can_read = m_socket->can_read_without_blocking(0);
+        if (can_read.is_error() || can_read.value())
+            return;
+    }
+}
+
 ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without_blocking()
 {
     Vector<u8> bytes;
@@ -160,6 +314,84 @@ ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without
     return bytes;
 }
 
+void ConnectionBase::try_parse_messages(Vector<u8> const& bytes, size_t& index)
+{
+    u32 message_size = 0;
+    for (; index + sizeof(message_size) <= bytes.size(); index += message_size) {
+        memcpy(&message_size, bytes.data() + index, sizeof(message_size));
+        if (bytes.size() - index - sizeof(uint32_t) < message_size)
+            break;
+        index += sizeof(message_size);
+
+        // Empty messages only tell us to look at the shared memory ring.
+        if (message_size == 0)
+            continue;
+
+        auto remaining_bytes = ReadonlyBytes { bytes.data() + index, message_size };
+        if (is_control_message(remaining_bytes)) {
+            if (auto result = handle_control_message(remaining_bytes); result.is_error())
+                dbgln("IPC::ConnectionBase::try_parse_messages: {}", result.error());
+            continue;
+        }
+
+        auto message = decode_message(remaining_bytes);
+        if (message.is_error())
+            break;
+
+        if (m_receives_over_shared_memory)
+            m_messages_from_socket.append(message.release_value());
+        else
+            m_unprocessed_messages.append(message.release_value());
+    }
+}
+
+ErrorOr<void> ConnectionBase::drain_messages_from_shared_memory()
+{
+    auto& ring = m_shared_memory_transport->incoming();
+    bool received_messages = false;
+    m_waiting_for_message_from_socket = false;
+
+    for (;;) {
+        for (;;) {
+            auto record_or_error = ring.peek(m_ring_scratch_buffer);
+            if (record_or_error.is_error()) {
+                shutdown();
+                return record_or_error.release_error();
+            }
+            auto record = record_or_error.release_value();
+            if (!record.has_value())
+                break;
+
+            if (record->is_socket_marker) {
+                // The message hasn't fully arrived over the socket yet, so we'll have to wait for it there.
+                m_waiting_for_message_from_socket = m_messages_from_socket.is_empty();
+                if (m_waiting_for_message_from_socket)
+                    break;
+                m_unprocessed_messages.append(m_messages_from_socket.take_first());
+            } else {
+                // Just like on the socket, a message that doesn't make sense ends the connection.
+                auto message = decode_message(record->bytes);
+                if (message.is_error()) {
+                    shutdown();
+                    return message.release_error();
+                }
+                m_unprocessed_messages.append(message.release_value());
+            }
+            ring.pop(*record);
+            received_messages = true;
+        }
+
+        if (m_waiting_for_message_from_socket || ring.prepare_to_wait_in_event_loop())
+            break;
+    }
+
+    if (received_messages) {
+        m_responsiveness_timer->stop();
+        did_become_responsive();
+    }
+    return {};
+}
+
 ErrorOr<void> ConnectionBase::drain_messages_from_peer()
 {
     auto bytes = TRY(read_as_much_as_possible_from_socket_without_blocking());
@@ -179,6 +411,9 @@ ErrorOr<void> ConnectionBase::drain_messages_from_peer()
         m_unprocessed_bytes = move(remaining_bytes);
     }
 
+    if (m_receives_over_shared_memory)
+        TRY(drain_messages_from_shared_memory());
+
     if (!m_unprocessed_messages.is_empty()) {
         m_deferred_invoker->schedule([strong_this = NonnullRefPtr(*this)] {
             strong_this->handle_messages();
@@ -203,7 +438,7 @@ OwnPtr<IPC::Message> ConnectionBase::wait_for_specific_endpoint_message_impl(u32
         if (!m_socket->is_open())
             break;
 
-        wait_for_socket_to_become_readable();
+        wait_for_messages_from_peer();
         if (drain_messages_from_peer().is_error())
             break;
     }
@@ -18,6 +18,7 @@
 #include <LibIPC/File.h>
 #include <LibIPC/Forward.h>
 #include <LibIPC/Message.h>
+#include <LibIPC/SharedMemoryTransport.h>
 #include <errno.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -50,6 +51,12 @@ public:
     };
     ErrorOr<void> post_message(Message const&, MessageKind = MessageKind::Async);
 
+    // Offers the other end to carry messages through a pair of rings in shared memory instead of the socket.
+    // Once it has agreed, messages with file descriptors (and messages too large for the rings) are still sent
+    // over the socket, and the rings only tell the other end when to pick them up, to keep messages in order.
+    ErrorOr<void> request_shared_memory_transport();
+    bool is_using_shared_memory_transport() const { return m_sends_over_shared_memory; }
+
     void shutdown();
     virtual void die() { }
 
@@ -60,15 +67,20 @@ protected:
 
     virtual void may_have_become_unresponsive() { }
     virtual void did_become_responsive() { }
-    virtual void try_parse_messages(Vector<u8> const& bytes, size_t& index) = 0;
+    virtual ErrorOr<NonnullOwnPtr<Message>> decode_message(ReadonlyBytes) = 0;
     virtual void shutdown_with_error(Error const&);
 
     OwnPtr<IPC::Message> wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id);
     void wait_for_socket_to_become_readable();
+    void wait_for_messages_from_peer();
     ErrorOr<Vector<u8>> read_as_much_as_possible_from_socket_without_blocking();
+    void try_parse_messages(Vector<u8> const& bytes, size_t& index);
     ErrorOr<void> drain_messages_from_peer();
+    ErrorOr<void> drain_messages_from_shared_memory();
 
     ErrorOr<void> post_message(MessageBuffer, MessageKind);
+    ErrorOr<void> post_message_over_shared_memory(MessageBuffer&, MessageKind);
+    ErrorOr<void> handle_control_message(ReadonlyBytes);
     void handle_messages();
 
     IPC::Stub& m_local_stub;
@@ -81,6 +93,14 @@ protected:
     Queue<IPC::File> m_unprocessed_fds;
     ByteBuffer m_unprocessed_bytes;
 
+    OwnPtr<SharedMemoryTransport> m_shared_memory_transport;
+    bool m_sends_over_shared_memory { false };
+    bool m_receives_over_shared_memory { false };
+    // Messages that came over the socket while the rings are in use wait here until the ring says it's their turn.
+    Vector<NonnullOwnPtr<Message>> m_messages_from_socket;
+    bool m_waiting_for_message_from_socket { false };
+    ByteBuffer m_ring_scratch_buffer;
+
     u32 m_local_endpoint_magic { 0 };
 
     NonnullOwnPtr<DeferredInvoker> m_deferred_invoker;
@@ -132,33 +152,20 @@ protected:
         return {};
     }
 
-    virtual void try_parse_messages(Vector<u8> const& bytes, size_t& index) override
+    virtual ErrorOr<NonnullOwnPtr<Message>> decode_message(ReadonlyBytes bytes) override
     {
-        u32 message_size = 0;
-        for (; index + sizeof(message_size) < bytes.size(); index += message_size) {
-            memcpy(&message_size, bytes.data() + index, sizeof(message_size));
-            if (message_size == 0 || bytes.size() - index - sizeof(uint32_t) < message_size)
-                break;
-            index += sizeof(message_size);
-            auto remaining_bytes = ReadonlyBytes { bytes.data() + index, message_size };
-
-            auto local_message = LocalEndpoint::decode_message(remaining_bytes, m_unprocessed_fds);
-            if (!local_message.is_error()) {
-                m_unprocessed_messages.append(local_message.release_value());
-                continue;
-            }
-
-            auto peer_message = PeerEndpoint::decode_message(remaining_bytes, m_unprocessed_fds);
-            if (!peer_message.is_error()) {
-                m_unprocessed_messages.append(peer_message.release_value());
-                continue;
-            }
-
-            dbgln("Failed to parse a message");
-            dbgln("Local endpoint error: {}", local_message.error());
-            dbgln("Peer endpoint error: {}", peer_message.error());
-            break;
-        }
+        auto local_message = LocalEndpoint::decode_message(bytes, m_unprocessed_fds);
+        if (!local_message.is_error())
+            return local_message.release_value();
+
+        auto peer_message = PeerEndpoint::decode_message(bytes, m_unprocessed_fds);
+        if (!peer_message.is_error())
+            return peer_message.release_value();
+
+        dbgln("Failed to parse a message");
+        dbgln("Local endpoint error: {}", local_message.error());
+        dbgln("Peer endpoint error: {}", peer_message.error());
+        return peer_message.release_error();
     }
 };
 
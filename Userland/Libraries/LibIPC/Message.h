@@ -46,6 +46,10 @@ public:
 
     ErrorOr<void> transfer_message(Core::LocalSocket& socket, bool block_event_loop = false);
 
+    bool has_file_descriptors() const { return !m_fds.is_empty(); }
+    // The encoded message, without the size that is prepended to it on the socket.
+    ReadonlyBytes payload() const { return m_data.span().slice(sizeof(u32)); }
+
 private:
     Vector<u8, 1024> m_data;
     Vector<NonnullRefPtr<AutoCloseFileDescriptor>, 1> m_fds;
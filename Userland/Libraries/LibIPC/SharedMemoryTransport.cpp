@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StdLibExtras.h>
+#include <LibIPC/SharedMemoryTransport.h>
+#include <time.h>
+
+#if defined(AK_OS_SERENITY)
+#    include <serenity.h>
+#elif defined(AK_OS_LINUX)
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+namespace IPC {
+
+static_assert(is_power_of_two(MessageRing::capacity));
+
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+static void futex_wait_for_change(u32 volatile* address, u32 value, int timeout_ms)
+{
+#    if defined(AK_OS_SERENITY)
+    timespec deadline {};
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (timeout_ms % 1000) * 1'000'000;
+    if (deadline.tv_nsec >= 1'000'000'000) {
+        ++deadline.tv_sec;
+        deadline.tv_nsec -= 1'000'000'000;
+    }
+    futex_wait(const_cast<u32*>(address), value, &deadline, CLOCK_MONOTONIC, true);
+#    else
+    timespec timeout { .tv_sec = timeout_ms / 1000, .tv_nsec = (timeout_ms % 1000) * 1'000'000 };
+    syscall(SYS_futex, address, FUTEX_WAIT, value, &timeout, nullptr, 0);
+#    endif
+}
+
+static void futex_wake_all(u32 volatile* address)
+{
+#    if defined(AK_OS_SERENITY)
+    futex_wake(const_cast<u32*>(address), NumericLimits<i32>::max(), true);
+#    else
+    syscall(SYS_futex, address, FUTEX_WAKE, NumericLimits<i32>::max(), nullptr, nullptr, 0);
+#    endif
+}
+#endif
+
+size_t MessageRing::size_in_memory()
+{
+    return sizeof(Header) + capacity;
+}
+
+MessageRing::MessageRing(u8* memory)
+    : m_header(reinterpret_cast<Header*>(memory))
+    , m_data(memory + sizeof(Header))
+{
+}
+
+u32 MessageRing::read_u32(u32 position) const
+{
+    // Records start at multiples of four, so this never wraps around.
+    u32 value;
+    __builtin_memcpy(&value, m_data + position % capacity, sizeof(value));
+    return value;
+}
+
+void MessageRing::copy_in(u32 position, ReadonlyBytes bytes)
+{
+    auto offset = position % capacity;
+    auto first_part = min(bytes.size(), capacity - offset);
+    __builtin_memcpy(m_data + offset, bytes.data(), first_part);
+    __builtin_memcpy(m_data, bytes.data() + first_part, bytes.size() - first_part);
+}
+
+void MessageRing::copy_out(u32 position, Bytes bytes) const
+{
+    auto offset = position % capacity;
+    auto first_part = min(bytes.size(), capacity - offset);
+    __builtin_memcpy(bytes.data(), m_data + offset, first_part);
+    __builtin_memcpy(bytes.data() + first_part, m_data, bytes.size() - first_part);
+}
+
+bool MessageRing::try_write_record(u32 size, ReadonlyBytes payload)
+{
+    auto record_size = sizeof(u32) + align_up_to(payload.size(), sizeof(u32));
+
+    auto tail = m_header->tail.load(AK::MemoryOrder::memory_order_relaxed);
+    auto head = m_header->head.load(AK::MemoryOrder::memory_order_acquire);
+    if (capacity - (tail - head) < record_size)
+        return false;
+
+    copy_in(tail, { reinterpret_cast<u8 const*>(&size), sizeof(size) });
+    copy_in(tail + sizeof(u32), payload);
+
+    // This has to be sequentially consistent with the load of the reader state in wake_reader(), or
+    // a reader that is about to wait could miss the record.
+    m_header->tail.store(tail + record_size);
+    return true;
+}
+
+bool MessageRing::try_write(ReadonlyBytes message)
+{
+    VERIFY(message.size() <= max_message_size);
+    return try_write_record(message.size(), message);
+}
+
+bool MessageRing::try_write_socket_marker()
+{
+    return try_write_record(socket_marker, {});
+}
+
+MessageRing::WakeUp MessageRing::wake_reader()
+{
+    // The reader state is written by the other end, so it may hold anything. A reader that doesn't say how
+    // it waits is treated as one that is still running.
+    auto state = m_header->reader_state.exchange(to_underlying(ReaderState::Running));
+    if (state == to_underlying(ReaderState::WaitingOnFutex)) {
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+        futex_wake_all(m_header->reader_state.ptr());
+#endif
+        return WakeUp::NotNeeded;
+    }
+    if (state == to_underlying(ReaderState::WaitingInEventLoop))
+        return WakeUp::OverSocket;
+    return WakeUp::NotNeeded;
+}
+
+ErrorOr<Optional<MessageRing::Record>> MessageRing::peek(ByteBuffer& scratch) const
+{
+    auto head = m_header->head.load(AK::MemoryOrder::memory_order_relaxed);
+    auto tail = m_header->tail.load(AK::MemoryOrder::memory_order_acquire);
+    if (head == tail)
+        return Optional<Record> {};
+
+    auto size = read_u32(head);
+    if (size == socket_marker)
+        return Record { .is_socket_marker = true, .size_in_ring = sizeof(u32) };
+
+    // The other end may not play by the rules, so don't trust the size it gave us.
+    auto size_in_ring = sizeof(u32) + align_up_to(size, sizeof(u32));
+    if (size > max_message_size || size_in_ring > tail - head)
+        return Error::from_string_literal("Invalid record in message ring");
+
+    TRY(scratch.try_resize(size));
+    copy_out(head + sizeof(u32), scratch.bytes());
+    return Record { .bytes = scratch.bytes(), .size_in_ring = static_cast<u32>(size_in_ring) };
+}
+
+void MessageRing::pop(Record const& record)
+{
+    auto head = m_header->head.load(AK::MemoryOrder::memory_order_relaxed);
+    m_header->head.store(head + record.size_in_ring, AK::MemoryOrder::memory_order_release);
+}
+
+bool MessageRing::is_empty() const
+{
+    return m_header->head.load(AK::MemoryOrder::memory_order_relaxed) == m_header->tail.load();
+}
+
+bool MessageRing::prepare_to_wait_in_event_loop()
+{
+    m_header->reader_state.store(to_underlying(ReaderState::WaitingInEventLoop));
+    if (is_empty())
+        return true;
+    m_header->reader_state.store(to_underlying(ReaderState::Running));
+    return false;
+}
+
+bool MessageRing::wait_for_record(int timeout_ms)
+{
+    m_header->reader_state.store(to_underlying(ReaderState::WaitingOnFutex));
+    if (is_empty()) {
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+        futex_wait_for_change(m_header->reader_state.ptr(), to_underlying(ReaderState::WaitingOnFutex), timeout_ms);
+#else
+        (void)timeout_ms;
+        VERIFY_NOT_REACHED();
+#endif
+    }
+    m_header->reader_state.store(to_underlying(ReaderState::Running));
+    return !is_empty();
+}
+
+bool SharedMemoryTransport::is_supported()
+{
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+    return true;
+#else
+    return false;
+#endif
+}
+
+ErrorOr<NonnullOwnPtr<SharedMemoryTransport>> SharedMemoryTransport::create()
+{
+    VERIFY(is_supported());
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(2 * MessageRing::size_in_memory()));
+    return adopt_nonnull_own_or_enomem(new (nothrow) SharedMemoryTransport(move(buffer), Side::Client));
+}
+
+ErrorOr<NonnullOwnPtr<SharedMemoryTransport>> SharedMemoryTransport::attach(Core::AnonymousBuffer buffer)
+{
+    if (!is_supported())
+        return Error::from_string_literal("Shared memory transport is not supported on this system");
+    if (buffer.size() != 2 * MessageRing::size_in_memory())
+        return Error::from_string_literal("Shared memory transport has an unexpected size");
+    return adopt_nonnull_own_or_enomem(new (nothrow) SharedMemoryTransport(move(buffer), Side::Server));
+}
+
+SharedMemoryTransport::SharedMemoryTransport(Core::AnonymousBuffer buffer, Side side)
+    : m_buffer(move(buffer))
+    , m_outgoing(m_buffer.data<u8>() + (side == Side::Client ? 0 : MessageRing::size_in_memory()))
+    , m_incoming(m_buffer.data<u8>() + (side == Side::Client ? MessageRing::size_in_memory() : 0))
+{
+}
+
+}
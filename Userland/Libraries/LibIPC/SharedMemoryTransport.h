@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/ByteBuffer.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/Types.h>
+#include <LibCore/AnonymousBuffer.h>
+
+namespace IPC {
+
+// A ring of messages in shared memory, written by one end of a connection and read by the other.
+// Every record is a u32 size followed by that many bytes, padded to a multiple of four.
+//
+// When the reader runs out of records, it tells the writer how it is going to wait for more: either
+// on the futex in the ring itself, or in its event loop, in which case the writer has to ring the
+// doorbell by sending an empty message over the socket. A reader that is still busy doesn't need to be
+// woken at all, which is what makes bursts of messages cheap.
+class MessageRing {
+    AK_MAKE_NONCOPYABLE(MessageRing);
+
+public:
+    // Stands in for a message that was sent over the socket instead, so that it is handled in order.
+    static constexpr u32 socket_marker = NumericLimits<u32>::max();
+
+    static constexpr size_t capacity = 64 * KiB;
+    // Larger messages are sent over the socket, so that a single message can't hog the entire ring.
+    static constexpr size_t max_message_size = capacity / 4;
+
+    static size_t size_in_memory();
+
+    // Expects zeroed memory, or memory that another MessageRing already uses.
+    explicit MessageRing(u8* memory);
+
+    // Writer side.
+    [[nodiscard]] bool try_write(ReadonlyBytes message);
+    [[nodiscard]] bool try_write_socket_marker();
+
+    enum class WakeUp {
+        NotNeeded,
+        OverSocket,
+    };
+    // Must be called after writing, to make sure the reader will notice the new records.
+    WakeUp wake_reader();
+
+    // Reader side.
+    struct Record {
+        bool is_socket_marker { false };
+        ReadonlyBytes bytes;
+        // How much of the ring the record takes up, as validated by peek().
+        u32 size_in_ring { 0 };
+    };
+    // The other end can still write to the ring while we look at a record, so its bytes are always copied
+    // into the scratch buffer first.
+    ErrorOr<Optional<Record>> peek(ByteBuffer& scratch) const;
+    void pop(Record const&);
+    bool is_empty() const;
+
+    // Announces that the reader is going back to its event loop. Returns false if a record came in
+    // while doing so, in which case the reader should look at the ring again instead.
+    [[nodiscard]] bool prepare_to_wait_in_event_loop();
+
+    // Blocks until the ring has a record, or until the timeout expires. Returns whether there is a record.
+    bool wait_for_record(int timeout_ms);
+
+private:
+    enum class ReaderState : u32 {
+        Running,
+        WaitingOnFutex,
+        WaitingInEventLoop,
+    };
+
+    struct Header {
+        // Both positions only ever grow (and wrap around), so that a full ring can be told apart from an empty one.
+        AK_CACHE_ALIGNED Atomic<u32> head { 0 };
+        AK_CACHE_ALIGNED Atomic<u32> tail { 0 };
+        AK_CACHE_ALIGNED Atomic<u32> reader_state { to_underlying(ReaderState::Running) };
+    };
+
+    u32 read_u32(u32 position) const;
+    void copy_in(u32 position, ReadonlyBytes);
+    void copy_out(u32 position, Bytes) const;
+    bool try_write_record(u32 size, ReadonlyBytes payload);
+
+    Header* m_header { nullptr };
+    u8* m_data { nullptr };
+};
+
+// The pair of rings shared by the two ends of a connection. The end that asked for them (the client)
+// writes to the first ring, the other end (the server) to the second one.
+class SharedMemoryTransport {
+    AK_MAKE_NONCOPYABLE(SharedMemoryTransport);
+    AK_MAKE_NONMOVABLE(SharedMemoryTransport);
+
+public:
+    // The rings rely on futexes, which are not available everywhere.
+    static bool is_supported();
+
+    static ErrorOr<NonnullOwnPtr<SharedMemoryTransport>> create();
+    static ErrorOr<NonnullOwnPtr<SharedMemoryTransport>> attach(Core::AnonymousBuffer);
+
+    Core::AnonymousBuffer const& buffer() const { return m_buffer; }
+
+    MessageRing& outgoing() { return m_outgoing; }
+    MessageRing& incoming() { return m_incoming; }
+
+private:
+    enum class Side {
+        Client,
+        Server,
+    };
+
+    SharedMemoryTransport(Core::AnonymousBuffer, Side);
+
+    Core::AnonymousBuffer m_buffer;
+    MessageRing m_outgoing;
+    MessageRing m_incoming;
+};
+
+}
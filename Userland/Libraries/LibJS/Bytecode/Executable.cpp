@@ -8,6 +8,8 @@
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/SourceCode.h>
 
 namespace JS::Bytecode {
@@ -40,6 +42,15 @@ Executable::Executable(
 
 Executable::~Executable() = default;
 
+JIT::NativeExecutable const* Executable::get_or_create_native_executable()
+{
+    if (!m_did_try_jitting) {
+        m_did_try_jitting = true;
+        m_native_executable = JIT::Compiler::compile(*this);
+    }
+    return m_native_executable.ptr();
+}
+
 void Executable::dump() const
 {
     warnln("\033[37;1mJS bytecode executable\033[0m \"{}\"", name);
@@ -102,10 +102,21 @@ public:
 
     [[nodiscard]] UnrealizedSourceRange source_range_at(size_t offset) const;
 
+    // Counts how often this executable was entered and how many loop iterations it ran,
+    // so that only hot code is handed to the JIT compiler.
+    u32 hotness { 0 };
+
+    // Compiles this executable to native code the first time it's asked for. Returns
+    // null if that isn't possible, in which case it keeps running in the interpreter.
+    JIT::NativeExecutable const* get_or_create_native_executable();
+
     void dump() const;
 
 private:
     virtual void visit_edges(Visitor&) override;
+
+    OwnPtr<JIT::NativeExecutable> m_native_executable;
+    bool m_did_try_jitting { false };
 };
 
 }
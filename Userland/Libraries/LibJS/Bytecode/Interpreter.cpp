@@ -14,6 +14,7 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -38,6 +39,8 @@
 namespace JS::Bytecode {
 
 bool g_dump_bytecode = false;
+bool g_jit_enabled = false;
+u32 g_jit_hotness_threshold = 1000;
 
 static ByteString format_operand(StringView name, Operand operand, Bytecode::Executable const& executable)
 {
@@ -331,6 +334,74 @@ Interpreter::HandleExceptionResponse Interpreter::handle_exception(size_t& progr
     VERIFY_NOT_REACHED();
 }
 
+bool Interpreter::continue_pending_unwind(size_t& program_counter, Label resume_target)
+{
+    auto& running_execution_context = this->running_execution_context();
+    if (auto exception = reg(Register::exception()); !exception.is_empty())
+        return handle_exception(program_counter, exception) == HandleExceptionResponse::ContinueInThisExecutable;
+    if (!saved_return_value().is_empty()) {
+        do_return(saved_return_value());
+        if (auto handlers = current_executable().exception_handlers_for_offset(program_counter); handlers.has_value()) {
+            if (auto finalizer = handlers.value().finalizer_offset; finalizer.has_value()) {
+                VERIFY(!running_execution_context.unwind_contexts.is_empty());
+                auto& unwind_context = running_execution_context.unwind_contexts.last();
+                VERIFY(unwind_context.executable == m_current_executable);
+                reg(Register::saved_return_value()) = reg(Register::return_value());
+                reg(Register::return_value()) = {};
+                program_counter = finalizer.value();
+                // the unwind_context will be pop'ed when entering the finally block
+                return true;
+            }
+        }
+        return false;
+    }
+    auto const old_scheduled_jump = running_execution_context.previously_scheduled_jumps.take_last();
+    if (m_scheduled_jump.has_value()) {
+        program_counter = m_scheduled_jump.value();
+        m_scheduled_jump = {};
+    } else {
+        program_counter = resume_target.address();
+        // set the scheduled jump to the old value if we continue
+        // where we left it
+        m_scheduled_jump = old_scheduled_jump;
+    }
+    return true;
+}
+
+void Interpreter::schedule_jump(size_t& program_counter, Label target)
+{
+    m_scheduled_jump = target.address();
+    auto finalizer = current_executable().exception_handlers_for_offset(program_counter).value().finalizer_offset;
+    VERIFY(finalizer.has_value());
+    program_counter = finalizer.value();
+}
+
+bool Interpreter::is_hot(Executable& executable)
+{
+    if (executable.hotness >= g_jit_hotness_threshold)
+        return true;
+    ++executable.hotness;
+    return false;
+}
+
+void Interpreter::run_native(JIT::NativeExecutable const& native_executable, size_t& program_counter)
+{
+    auto* registers_and_constants_and_locals = m_registers_and_constants_and_locals.data();
+    auto* arguments = running_execution_context().arguments.data();
+    for (;;) {
+        switch (native_executable.run(*this, registers_and_constants_and_locals, arguments, program_counter)) {
+        case JIT::NativeExecutable::ExitReason::Return:
+            return;
+        case JIT::NativeExecutable::ExitReason::Exception:
+            if (handle_exception(program_counter, reg(Register::exception())) == HandleExceptionResponse::ExitFromExecutable)
+                return;
+            break;
+        case JIT::NativeExecutable::ExitReason::Continue:
+            break;
+        }
+    }
+}
+
 // FIXME: GCC takes a *long* time to compile with flattening, and it will time out our CI. :|
 #if defined(AK_COMPILER_CLANG)
 #    define FLATTEN_ON_CLANG FLATTEN
@@ -355,6 +426,13 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
     TemporaryChange change(m_program_counter, Optional<size_t&>(program_counter));
 
+    if (g_jit_enabled && is_hot(executable)) {
+        if (auto const* native_executable = executable.get_or_create_native_executable()) {
+            run_native(*native_executable, program_counter);
+            return;
+        }
+    }
+
     // Declare a lookup table for computed goto with each of the `handle_*` labels
     // to avoid the overhead of a switch statement.
     // This is a GCC extension, but it's also supported by Clang.
@@ -406,7 +484,15 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
         handle_Jump: {
             auto& instruction = *reinterpret_cast<Op::Jump const*>(&bytecode[program_counter]);
+            auto is_back_edge = instruction.target().address() <= program_counter;
             program_counter = instruction.target().address();
+            // Loops make an executable hot too, and switch to native code in the middle of it.
+            if (g_jit_enabled && is_back_edge && is_hot(executable)) [[unlikely]] {
+                if (auto const* native_executable = executable.get_or_create_native_executable()) {
+                    run_native(*native_executable, program_counter);
+                    return;
+                }
+            }
             goto start;
         }
 
@@ -496,46 +582,14 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
         handle_ContinuePendingUnwind: {
             auto& instruction = *reinterpret_cast<Op::ContinuePendingUnwind const*>(&bytecode[program_counter]);
-            if (auto exception = reg(Register::exception()); !exception.is_empty()) {
-                if (handle_exception(program_counter, exception) == HandleExceptionResponse::ExitFromExecutable)
-                    return;
-                goto start;
-            }
-            if (!saved_return_value().is_empty()) {
-                do_return(saved_return_value());
-                if (auto handlers = executable.exception_handlers_for_offset(program_counter); handlers.has_value()) {
-                    if (auto finalizer = handlers.value().finalizer_offset; finalizer.has_value()) {
-                        VERIFY(!running_execution_context.unwind_contexts.is_empty());
-                        auto& unwind_context = running_execution_context.unwind_contexts.last();
-                        VERIFY(unwind_context.executable == m_current_executable);
-                        reg(Register::saved_return_value()) = reg(Register::return_value());
-                        reg(Register::return_value()) = {};
-                        program_counter = finalizer.value();
-                        // the unwind_context will be pop'ed when entering the finally block
-                        goto start;
-                    }
-                }
+            if (!continue_pending_unwind(program_counter, instruction.resume_target()))
                 return;
-            }
-            auto const old_scheduled_jump = running_execution_context.previously_scheduled_jumps.take_last();
-            if (m_scheduled_jump.has_value()) {
-                program_counter = m_scheduled_jump.value();
-                m_scheduled_jump = {};
-            } else {
-                program_counter = instruction.resume_target().address();
-                // set the scheduled jump to the old value if we continue
-                // where we left it
-                m_scheduled_jump = old_scheduled_jump;
-            }
             goto start;
         }
 
         handle_ScheduleJump: {
             auto& instruction = *reinterpret_cast<Op::ScheduleJump const*>(&bytecode[program_counter]);
-            m_scheduled_jump = instruction.target().address();
-            auto finalizer = executable.exception_handlers_for_offset(program_counter).value().finalizer_offset;
-            VERIFY(finalizer.has_value());
-            program_counter = finalizer.value();
+            schedule_jump(program_counter, instruction.target());
             goto start;
         }
 
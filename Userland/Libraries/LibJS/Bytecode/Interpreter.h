@@ -67,6 +67,10 @@ public:
     }
 
     void enter_unwind_context();
+    // Both return with the program counter at the instruction to continue at. continue_pending_unwind()
+    // returns false if there is none, because the executable is done.
+    [[nodiscard]] bool continue_pending_unwind(size_t& program_counter, Label resume_target);
+    void schedule_jump(size_t& program_counter, Label target);
     void leave_unwind_context();
     void catch_exception(Operand dst);
     void restore_scheduled_jump();
@@ -82,6 +86,8 @@ public:
 
 private:
     void run_bytecode(size_t entry_point);
+    void run_native(JIT::NativeExecutable const&, size_t& program_counter);
+    bool is_hot(Executable&);
 
     enum class HandleExceptionResponse {
         ExitFromExecutable,
@@ -102,6 +108,9 @@ private:
 };
 
 extern bool g_dump_bytecode;
+extern bool g_jit_enabled;
+// How many times an executable has to be entered or loop before it gets compiled to native code.
+extern u32 g_jit_hotness_threshold;
 
 ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM&, ASTNode const&, JS::FunctionKind kind, DeprecatedFlyString const& name);
 ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM&, ECMAScriptFunctionObject const&);
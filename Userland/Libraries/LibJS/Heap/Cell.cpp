@@ -15,6 +15,11 @@ void JS::Cell::initialize(JS::Realm&)
 {
 }
 
+void JS::Cell::did_write()
+{
+    heap().did_write_to_cell({}, *this);
+}
+
 void JS::Cell::Visitor::visit(JS::Value value)
 {
     if (value.is_cell())
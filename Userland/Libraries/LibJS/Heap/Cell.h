@@ -47,6 +47,25 @@ public:
     State state() const { return m_state; }
     void set_state(State state) { m_state = state; }
 
+    // Cells that survived a collection are old, and are only collected again by a major collection.
+    bool is_old() const { return m_old; }
+    void set_old(Badge<Heap>) { m_old = true; }
+
+    bool is_remembered() const { return m_remembered; }
+    void set_remembered(Badge<Heap>, bool b) { m_remembered = b; }
+
+    bool has_precise_write_barrier() const { return m_has_precise_write_barrier; }
+    void set_has_precise_write_barrier(Badge<Heap>) { m_has_precise_write_barrier = true; }
+
+    // Must be called whenever one of this cell's GC edges changes after construction, so that the
+    // next minor collection finds young cells that are only reachable through this one, and so that
+    // incremental marking scans this cell again if it has already been marked.
+    ALWAYS_INLINE void write_barrier()
+    {
+        if ((m_old && !m_remembered) || m_mark) [[unlikely]]
+            did_write();
+    }
+
     virtual StringView class_name() const = 0;
 
     class Visitor {
@@ -169,9 +188,14 @@ protected:
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
 private:
+    void did_write();
+
     bool m_mark : 1 { false };
     bool m_overrides_must_survive_garbage_collection : 1 { false };
     State m_state : 1 { State::Live };
+    bool m_old : 1 { false };
+    bool m_remembered : 1 { false };
+    bool m_has_precise_write_barrier : 1 { false };
 };
 
 }
@@ -36,6 +36,10 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     auto& block = *m_usable_blocks.last();
     auto* cell = block.allocate();
     VERIFY(cell);
+    if (!block.has_young_cells()) {
+        block.set_has_young_cells(true);
+        heap.did_allocate_in_block({}, block);
+    }
     if (block.is_full())
         m_full_blocks.append(*m_usable_blocks.last());
     return cell;
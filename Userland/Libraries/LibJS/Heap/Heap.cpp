@@ -72,9 +72,15 @@ void Heap::will_allocate(size_t size)
     if (should_collect_on_every_allocation()) {
         m_allocated_bytes_since_last_gc = 0;
         collect_garbage();
-    } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
+    } else if (m_incremental_marking_visitor) {
+        // No minor collections can happen until marking is done, so allocations pay for marking instead.
+        if (m_allocated_bytes_since_last_gc + size > INCREMENTAL_MARKING_SLICE_BYTES) {
+            m_allocated_bytes_since_last_gc = 0;
+            collect_garbage(CollectionType::CollectYoungGeneration);
+        }
+    } else if (m_allocated_bytes_since_last_gc + size > (m_generational_collection_enabled ? NURSERY_BYTES_THRESHOLD : m_gc_bytes_threshold)) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(CollectionType::CollectYoungGeneration);
     }
 
     m_allocated_bytes_since_last_gc += size;
@@ -269,21 +275,72 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     perf_event(PERF_EVENT_SIGNPOST, gc_perf_string_id, global_gc_counter++);
 #endif
 
-    Core::ElapsedTimer collection_measurement_timer;
-    if (print_report)
-        collection_measurement_timer.start();
+    auto collection_measurement_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
 
-    if (collection_type == CollectionType::CollectGarbage) {
+    // Once enough cells were promoted, it's time to look for garbage among the old ones as well.
+    bool should_start_incremental_marking = false;
+    if (collection_type == CollectionType::CollectYoungGeneration && !m_incremental_marking_visitor
+        && (!m_generational_collection_enabled || m_promoted_bytes_since_last_major_gc >= m_gc_bytes_threshold)) {
+        collection_type = CollectionType::CollectGarbage;
+        should_start_incremental_marking = m_incremental_marking_enabled;
+    }
+
+    if (collection_type != CollectionType::CollectEverything) {
         if (m_gc_deferrals) {
+            // Whether to start incremental marking is decided again once deferral ends.
+            auto deferred_collection_type = should_start_incremental_marking ? CollectionType::CollectYoungGeneration : collection_type;
+            if (!m_should_gc_when_deferral_ends || deferred_collection_type == CollectionType::CollectGarbage)
+                m_collection_type_when_deferral_ends = deferred_collection_type;
             m_should_gc_when_deferral_ends = true;
             return;
         }
-        HashMap<Cell*, HeapRoot> roots;
-        gather_roots(roots);
-        mark_live_cells(roots);
+
+        if (should_start_incremental_marking) {
+            start_incremental_marking();
+            m_incremental_marking_statistics.record_pause(collection_measurement_timer.elapsed_time());
+            return;
+        }
+
+        if (m_incremental_marking_visitor) {
+            // A minor collection while marking is in progress is just another marking slice.
+            if (collection_type == CollectionType::CollectYoungGeneration) {
+                if (!perform_incremental_marking_slice(collection_measurement_timer)) {
+                    m_incremental_marking_statistics.record_pause(collection_measurement_timer.elapsed_time());
+                    return;
+                }
+                collection_type = CollectionType::CollectGarbage;
+            }
+            finish_incremental_marking();
+        } else {
+            HashMap<Cell*, HeapRoot> roots;
+            gather_roots(roots);
+            mark_live_cells(roots, collection_type);
+        }
+    } else if (m_incremental_marking_visitor) {
+        abandon_incremental_marking();
     }
-    finalize_unmarked_cells();
-    sweep_dead_cells(print_report, collection_measurement_timer);
+
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        finalize_unmarked_young_cells();
+        sweep_dead_young_cells(print_report, collection_measurement_timer);
+        m_minor_collection_statistics.record_pause(collection_measurement_timer.elapsed_time());
+    } else {
+        finalize_unmarked_cells();
+        sweep_dead_cells(print_report, collection_measurement_timer);
+        m_major_collection_statistics.record_pause(collection_measurement_timer.elapsed_time());
+    }
+}
+
+void Heap::CollectionStatistics::record_pause(Duration pause_time)
+{
+    ++collection_count;
+    total_pause_time += pause_time;
+    longest_pause_time = max(longest_pause_time, pause_time);
+
+    size_t bucket = 0;
+    while (bucket < histogram_bucket_count - 1 && pause_time >= histogram_bucket_upper_bound(bucket))
+        ++bucket;
+    ++pause_time_histogram[bucket];
 }
 
 void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
@@ -389,8 +446,9 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots, Heap::CollectionType collection_type)
         : m_heap(heap)
+        , m_only_young_cells(collection_type == Heap::CollectionType::CollectYoungGeneration)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
         m_heap.for_each_block([&](auto& block) {
@@ -401,12 +459,21 @@ public:
         for (auto* root : roots.keys()) {
             visit(root);
         }
+
+        // Old cells are never marked by a minor collection, instead the ones that may point to young cells
+        // have their edges visited right away.
+        if (m_only_young_cells) {
+            for (auto& cell : m_heap.m_remembered_cells)
+                cell->visit_edges(*this);
+        }
     }
 
     virtual void visit_impl(Cell& cell) override
     {
         if (cell.is_marked())
             return;
+        if (m_only_young_cells && cell.is_old())
+            return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
         cell.set_marked(true);
@@ -426,6 +493,8 @@ public:
                 return;
             if (cell->state() != Cell::State::Live)
                 return;
+            if (m_only_young_cells && cell->is_old())
+                return;
             cell->set_marked(true);
             m_work_queue.append(*cell);
         });
@@ -438,28 +507,139 @@ public:
         }
     }
 
+    // Returns true once there is nothing left to mark.
+    bool mark_live_cells_for(Core::ElapsedTimer const& timer, Duration duration)
+    {
+        static constexpr size_t cells_between_clock_checks = 128;
+
+        while (!m_work_queue.is_empty()) {
+            for (size_t i = 0; i < cells_between_clock_checks && !m_work_queue.is_empty(); ++i)
+                m_work_queue.take_last()->visit_edges(*this);
+            if (timer.elapsed_time() >= duration)
+                break;
+        }
+        return m_work_queue.is_empty();
+    }
+
+    void did_allocate_block(HeapBlock& block)
+    {
+        m_all_live_heap_blocks.set(&block);
+        m_min_block_address = min(m_min_block_address, bit_cast<FlatPtr>(&block));
+        m_max_block_address = max(m_max_block_address, bit_cast<FlatPtr>(&block) + HeapBlockBase::block_size);
+    }
+
 private:
     Heap& m_heap;
     Vector<NonnullGCPtr<Cell>> m_work_queue;
     HashTable<HeapBlock*> m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
+    bool m_only_young_cells { false };
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots, CollectionType collection_type)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor(*this, roots);
+    MarkingVisitor visitor(*this, roots, collection_type);
 
     visitor.mark_all_live_cells();
 
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        // Old uprooted cells can only be collected by the next major collection.
+        m_uprooted_cells.remove_all_matching([](auto& cell) {
+            if (cell->is_old())
+                return false;
+            cell->set_marked(false);
+            return true;
+        });
+        return;
+    }
+
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
 
     m_uprooted_cells.clear();
 }
 
+void Heap::start_incremental_marking()
+{
+    dbgln_if(HEAP_DEBUG, "start_incremental_marking:");
+
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+    m_incremental_marking_visitor = make<MarkingVisitor>(*this, roots, CollectionType::CollectGarbage);
+}
+
+bool Heap::perform_incremental_marking_slice(Core::ElapsedTimer const& timer)
+{
+    for (auto& cell : m_cells_to_rescan)
+        m_incremental_marking_visitor->visit(cell.ptr());
+    m_cells_to_rescan.clear();
+
+    return m_incremental_marking_visitor->mark_live_cells_for(timer, INCREMENTAL_MARKING_SLICE_DURATION);
+}
+
+void Heap::finish_incremental_marking()
+{
+    dbgln_if(HEAP_DEBUG, "finish_incremental_marking:");
+
+    auto visitor = m_incremental_marking_visitor.release_nonnull();
+    for (auto& cell : m_cells_to_rescan)
+        visitor->visit(cell.ptr());
+    m_cells_to_rescan.clear();
+
+    // The roots may have changed completely since marking started.
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+    for (auto* root : roots.keys())
+        visitor->visit(root);
+
+    // Writes to cells without a precise write barrier went unnoticed, so all of the marked ones are scanned again.
+    for (auto& cell : m_remembered_cells) {
+        if (cell->is_marked() && !cell->has_precise_write_barrier())
+            cell->visit_edges(*visitor);
+    }
+    for (auto* block : m_blocks_with_young_cells) {
+        block->for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (!cell->is_old() && cell->is_marked() && !cell->has_precise_write_barrier())
+                cell->visit_edges(*visitor);
+        });
+    }
+
+    visitor->mark_all_live_cells();
+
+    for (auto& inverse_root : m_uprooted_cells)
+        inverse_root->set_marked(false);
+
+    m_uprooted_cells.clear();
+}
+
+void Heap::abandon_incremental_marking()
+{
+    dbgln_if(HEAP_DEBUG, "abandon_incremental_marking:");
+
+    m_incremental_marking_visitor = nullptr;
+    m_cells_to_rescan.clear();
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            cell->set_marked(false);
+        });
+        return IterationDecision::Continue;
+    });
+}
+
+void Heap::did_allocate_during_incremental_marking(Cell& cell)
+{
+    // New cells are scanned by the following slices, rather than all at once when marking finishes.
+    m_incremental_marking_visitor->visit(&cell);
+}
+
+void Heap::did_allocate_block_during_incremental_marking(HeapBlock& block)
+{
+    m_incremental_marking_visitor->did_allocate_block(block);
+}
+
 bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
 {
     if (!cell.overrides_must_survive_garbage_collection({}))
@@ -478,9 +658,39 @@ void Heap::finalize_unmarked_cells()
     });
 }
 
+void Heap::finalize_unmarked_young_cells()
+{
+    for (auto* block : m_blocks_with_young_cells) {
+        block->for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            if (!cell->is_old() && !cell->is_marked() && !cell_must_survive_garbage_collection(*cell))
+                cell->finalize();
+        });
+    }
+}
+
+void Heap::promote_cell(Cell& cell)
+{
+    cell.set_old({});
+
+    // Cells without a precise write barrier stay in the remembered set for good, so that every minor
+    // collection rescans them.
+    if (!cell.has_precise_write_barrier() && !cell.is_remembered()) {
+        cell.set_remembered({}, true);
+        m_remembered_cells.append(cell);
+    }
+}
+
 void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
+
+    // Every surviving cell is promoted below, which rebuilds these from scratch.
+    m_remembered_cells.clear();
+    for (auto* block : m_blocks_with_young_cells)
+        block->set_has_young_cells(false);
+    m_blocks_with_young_cells.clear();
+    m_promoted_bytes_since_last_major_gc = 0;
+
     Vector<HeapBlock*, 32> empty_blocks;
     Vector<HeapBlock*, 32> full_blocks_that_became_usable;
 
@@ -500,6 +710,8 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
                 collected_cell_bytes += block.cell_size();
             } else {
                 cell->set_marked(false);
+                cell->set_remembered({}, false);
+                promote_cell(*cell);
                 block_has_live_cells = true;
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
@@ -553,6 +765,83 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     }
 }
 
+void Heap::sweep_dead_young_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+{
+    dbgln_if(HEAP_DEBUG, "sweep_dead_young_cells:");
+
+    // Precisely tracked cells will be remembered again by their write barrier if they need to be.
+    m_remembered_cells.remove_all_matching([](auto& cell) {
+        if (!cell->has_precise_write_barrier())
+            return false;
+        cell->set_remembered({}, false);
+        return true;
+    });
+
+    Vector<HeapBlock*, 32> empty_blocks;
+    Vector<HeapBlock*, 32> full_blocks_that_became_usable;
+
+    size_t collected_cells = 0;
+    size_t promoted_cells = 0;
+    size_t collected_cell_bytes = 0;
+    size_t promoted_cell_bytes = 0;
+
+    for (auto* block : exchange(m_blocks_with_young_cells, {})) {
+        block->set_has_young_cells(false);
+        bool block_has_live_cells = false;
+        bool block_was_full = block->is_full();
+        block->for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (cell->is_old()) {
+                block_has_live_cells = true;
+                return;
+            }
+            if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
+                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+                block->deallocate(cell);
+                ++collected_cells;
+                collected_cell_bytes += block->cell_size();
+            } else {
+                cell->set_marked(false);
+                promote_cell(*cell);
+                block_has_live_cells = true;
+                ++promoted_cells;
+                promoted_cell_bytes += block->cell_size();
+            }
+        });
+        if (!block_has_live_cells)
+            empty_blocks.append(block);
+        else if (block_was_full != block->is_full())
+            full_blocks_that_became_usable.append(block);
+    }
+
+    for (auto& weak_container : m_weak_containers)
+        weak_container.remove_dead_cells({});
+
+    for (auto* block : empty_blocks) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
+        block->cell_allocator().block_did_become_empty({}, *block);
+    }
+
+    for (auto* block : full_blocks_that_became_usable) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
+        block->cell_allocator().block_did_become_usable({}, *block);
+    }
+
+    m_promoted_bytes_since_last_major_gc += promoted_cell_bytes;
+
+    if (print_report) {
+        Duration const time_spent = measurement_timer.elapsed_time();
+
+        dbgln("Minor garbage collection report");
+        dbgln("=============================================");
+        dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
+        dbgln(" Promoted cells: {} ({} bytes)", promoted_cells, promoted_cell_bytes);
+        dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+        dbgln("Remembered cells: {}", m_remembered_cells.size());
+        dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        dbgln("=============================================");
+    }
+}
+
 void Heap::defer_gc()
 {
     ++m_gc_deferrals;
@@ -565,7 +854,7 @@ void Heap::undefer_gc()
 
     if (!m_gc_deferrals) {
         if (m_should_gc_when_deferral_ends)
-            collect_garbage();
+            collect_garbage(m_collection_type_when_deferral_ends);
         m_should_gc_when_deferral_ends = false;
     }
 }
@@ -6,11 +6,14 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/HashTable.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -28,6 +31,20 @@
 
 namespace JS {
 
+// Cell types that call Cell::write_barrier() whenever one of their GC edges changes after construction.
+// Old cells of every other type are rescanned by each minor collection. This is deliberately not
+// inherited, since subclasses usually bring edges of their own.
+template<typename T>
+inline constexpr bool has_precise_write_barrier = false;
+template<>
+inline constexpr bool has_precise_write_barrier<Object> = true;
+template<>
+inline constexpr bool has_precise_write_barrier<Array> = true;
+template<>
+inline constexpr bool has_precise_write_barrier<PrimitiveString> = true;
+
+class MarkingVisitor;
+
 class Heap : public HeapBase {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -42,7 +59,11 @@ public:
         auto* memory = allocate_cell<T>();
         defer_gc();
         new (memory) T(forward<Args>(args)...);
+        if constexpr (has_precise_write_barrier<T>)
+            memory->set_has_precise_write_barrier({});
         undefer_gc();
+        if (m_incremental_marking_visitor) [[unlikely]]
+            did_allocate_during_incremental_marking(*memory);
         return *static_cast<T*>(memory);
     }
 
@@ -52,13 +73,22 @@ public:
         auto* memory = allocate_cell<T>();
         defer_gc();
         new (memory) T(forward<Args>(args)...);
+        if constexpr (has_precise_write_barrier<T>)
+            memory->set_has_precise_write_barrier({});
         undefer_gc();
         auto* cell = static_cast<T*>(memory);
         memory->initialize(realm);
+        if (m_incremental_marking_visitor) [[unlikely]]
+            did_allocate_during_incremental_marking(*memory);
         return *cell;
     }
 
     enum class CollectionType {
+        // A minor collection, which only collects cells allocated since the last collection. Unless generational
+        // collection is enabled, this is only a hint that the collection wasn't explicitly requested, and the
+        // whole heap is collected instead.
+        CollectYoungGeneration,
+        // A major collection of the whole heap.
         CollectGarbage,
         CollectEverything,
     };
@@ -66,6 +96,37 @@ public:
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
     AK::JsonObject dump_graph();
 
+    struct CollectionStatistics {
+        static constexpr size_t histogram_bucket_count = 12;
+
+        // Bucket i counts pauses shorter than this, the last bucket counts all the longer ones.
+        static Duration histogram_bucket_upper_bound(size_t index) { return Duration::from_microseconds(250ll << index); }
+
+        void record_pause(Duration);
+
+        size_t collection_count { 0 };
+        Duration total_pause_time;
+        Duration longest_pause_time;
+        AK::Array<size_t, histogram_bucket_count> pause_time_histogram {};
+    };
+
+    CollectionStatistics const& minor_collection_statistics() const { return m_minor_collection_statistics; }
+    CollectionStatistics const& major_collection_statistics() const { return m_major_collection_statistics; }
+    CollectionStatistics const& incremental_marking_statistics() const { return m_incremental_marking_statistics; }
+
+    // When enabled, the marking phase of major collections that were not explicitly requested is split
+    // into short slices that run in between allocations.
+    bool is_incremental_marking_enabled() const { return m_incremental_marking_enabled; }
+    void set_incremental_marking_enabled(bool enabled) { m_incremental_marking_enabled = enabled; }
+    bool is_incremental_marking_in_progress() const { return m_incremental_marking_visitor; }
+
+    // When enabled, collections that were not explicitly requested only collect young cells, until enough cells
+    // were promoted for a major collection. Old cells without a precise write barrier have to be rescanned by
+    // every minor collection, which costs about as much as marking the old heap, so this is off until all cell
+    // types have such a barrier.
+    bool is_generational_collection_enabled() const { return m_generational_collection_enabled; }
+    void set_generational_collection_enabled(bool enabled) { m_generational_collection_enabled = enabled; }
+
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
@@ -85,6 +146,8 @@ public:
     void did_destroy_execution_context(Badge<ExecutionContext>, ExecutionContext&);
 
     void register_cell_allocator(Badge<CellAllocator>, CellAllocator&);
+    void did_allocate_in_block(Badge<CellAllocator>, HeapBlock&);
+    void did_write_to_cell(Badge<Cell>, Cell&);
 
     void uproot_cell(Cell* cell);
 
@@ -116,9 +179,20 @@ private:
     void gather_roots(HashMap<Cell*, HeapRoot>&);
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells, CollectionType);
     void finalize_unmarked_cells();
+    void finalize_unmarked_young_cells();
     void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void sweep_dead_young_cells(bool print_report, Core::ElapsedTimer const&);
+    void promote_cell(Cell&);
+
+    void start_incremental_marking();
+    // Returns true once marking can be finished.
+    bool perform_incremental_marking_slice(Core::ElapsedTimer const&);
+    void finish_incremental_marking();
+    void abandon_incremental_marking();
+    void did_allocate_during_incremental_marking(Cell&);
+    void did_allocate_block_during_incremental_marking(HeapBlock&);
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
@@ -141,8 +215,26 @@ private:
     }
 
     static constexpr size_t GC_MIN_BYTES_THRESHOLD { 4 * 1024 * 1024 };
+    static constexpr size_t NURSERY_BYTES_THRESHOLD { 4 * 1024 * 1024 };
+    static constexpr size_t INCREMENTAL_MARKING_SLICE_BYTES { 512 * 1024 };
+    static constexpr Duration INCREMENTAL_MARKING_SLICE_DURATION = Duration::from_milliseconds(1);
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
+    size_t m_promoted_bytes_since_last_major_gc { 0 };
+
+    // Old cells that may point to young cells. These are the roots of a minor collection besides the usual ones.
+    Vector<GCPtr<Cell>> m_remembered_cells;
+    Vector<HeapBlock*> m_blocks_with_young_cells;
+
+    CollectionStatistics m_minor_collection_statistics;
+    CollectionStatistics m_major_collection_statistics;
+    CollectionStatistics m_incremental_marking_statistics;
+
+    bool m_generational_collection_enabled { false };
+    bool m_incremental_marking_enabled { false };
+    OwnPtr<MarkingVisitor> m_incremental_marking_visitor;
+    // Cells that were written to after being marked. They are unmarked, so that they're scanned again.
+    Vector<GCPtr<Cell>> m_cells_to_rescan;
 
     bool m_should_collect_on_every_allocation { false };
 
@@ -158,6 +250,7 @@ private:
 
     size_t m_gc_deferrals { 0 };
     bool m_should_gc_when_deferral_ends { false };
+    CollectionType m_collection_type_when_deferral_ends { CollectionType::CollectYoungGeneration };
 
     bool m_collecting_garbage { false };
 };
@@ -215,4 +308,27 @@ inline void Heap::register_cell_allocator(Badge<CellAllocator>, CellAllocator& a
     m_all_cell_allocators.append(allocator);
 }
 
+inline void Heap::did_allocate_in_block(Badge<CellAllocator>, HeapBlock& block)
+{
+    m_blocks_with_young_cells.append(&block);
+    if (m_incremental_marking_visitor) [[unlikely]]
+        did_allocate_block_during_incremental_marking(block);
+}
+
+inline void Heap::did_write_to_cell(Badge<Cell>, Cell& cell)
+{
+    if (cell.is_old() && !cell.is_remembered()) {
+        cell.set_remembered({}, true);
+        m_remembered_cells.append(cell);
+    }
+
+    // Incremental marking may have scanned this cell already. There is no barrier on the cells that
+    // lose an edge, so the new edge has to be found by scanning the cell again (an incremental update
+    // barrier rather than a snapshot-at-the-beginning one).
+    if (cell.is_marked() && m_incremental_marking_visitor) {
+        cell.set_marked(false);
+        m_cells_to_rescan.append(cell);
+    }
+}
+
 }
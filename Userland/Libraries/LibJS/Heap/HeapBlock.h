@@ -92,6 +92,11 @@ public:
 
     CellAllocator& cell_allocator() { return m_cell_allocator; }
 
+    // Set for blocks that received allocations since the last collection, which are the only
+    // ones minor collections have to sweep.
+    bool has_young_cells() const { return m_has_young_cells; }
+    void set_has_young_cells(bool b) { m_has_young_cells = b; }
+
 private:
     HeapBlock(Heap&, CellAllocator&, size_t cell_size);
 
@@ -111,6 +116,7 @@ private:
     CellAllocator& m_cell_allocator;
     size_t m_cell_size { 0 };
     size_t m_next_lazy_freelist_index { 0 };
+    bool m_has_young_cells { false };
     GCPtr<FreelistEntry> m_freelist;
     alignas(__BIGGEST_ALIGNMENT__) u8 m_storage[];
 
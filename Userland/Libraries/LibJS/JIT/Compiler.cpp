@@ -0,0 +1,643 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/WeakPtr.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::JIT {
+
+#ifdef JIT_ARCH_SUPPORTED
+
+using Assembler = ::JIT::Assembler;
+using Operand = Assembler::Operand;
+using Condition = Assembler::Condition;
+
+static_assert(IsTriviallyCopyable<Value>, "Values are passed to the helpers in registers");
+
+// The helpers below are called from the native code. They return 0 unless they threw,
+// in which case the exception has been put into the exception register.
+
+static u64 throw_from_helper(Bytecode::Interpreter& interpreter, Value exception)
+{
+    interpreter.reg(Bytecode::Register::exception()) = exception;
+    return 1;
+}
+
+template<typename OpType>
+static u64 cxx_execute(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    if constexpr (IsSame<decltype(instruction.execute_impl(interpreter)), void>) {
+        instruction.execute_impl(interpreter);
+    } else {
+        auto result = instruction.execute_impl(interpreter);
+        if (result.is_error())
+            return throw_from_helper(interpreter, result.error_value());
+    }
+    return 0;
+}
+
+static u64 cxx_to_boolean(Value value)
+{
+    return value.to_boolean();
+}
+
+static ThrowCompletionOr<Value> loosely_equals(VM& vm, Value lhs, Value rhs)
+{
+    return Value(TRY(is_loosely_equal(vm, lhs, rhs)));
+}
+
+static ThrowCompletionOr<Value> loosely_inequals(VM& vm, Value lhs, Value rhs)
+{
+    return Value(!TRY(is_loosely_equal(vm, lhs, rhs)));
+}
+
+static ThrowCompletionOr<Value> strict_equals(VM&, Value lhs, Value rhs)
+{
+    return Value(is_strictly_equal(lhs, rhs));
+}
+
+static ThrowCompletionOr<Value> strict_inequals(VM&, Value lhs, Value rhs)
+{
+    return Value(!is_strictly_equal(lhs, rhs));
+}
+
+// Returned by the comparison helpers of conditional jumps instead of true or false.
+static constexpr u64 comparison_threw = 2;
+
+template<ThrowCompletionOr<Value> (*compare)(VM&, Value, Value)>
+static u64 cxx_jump_comparison(Bytecode::Interpreter& interpreter, Value lhs, Value rhs)
+{
+    auto result = compare(interpreter.vm(), lhs, rhs);
+    if (result.is_error()) {
+        throw_from_helper(interpreter, result.error_value());
+        return comparison_threw;
+    }
+    return result.value().to_boolean();
+}
+
+static void cxx_enter_unwind_context(Bytecode::Interpreter& interpreter)
+{
+    interpreter.enter_unwind_context();
+}
+
+static u64 cxx_continue_pending_unwind(Bytecode::Interpreter& interpreter, Bytecode::Op::ContinuePendingUnwind const& instruction, size_t* program_counter)
+{
+    if (!interpreter.continue_pending_unwind(*program_counter, instruction.resume_target()))
+        return to_underlying(NativeExecutable::ExitReason::Return);
+    return to_underlying(NativeExecutable::ExitReason::Continue);
+}
+
+static u64 cxx_schedule_jump(Bytecode::Interpreter& interpreter, Bytecode::Op::ScheduleJump const& instruction, size_t* program_counter)
+{
+    interpreter.schedule_jump(*program_counter, instruction.target());
+    return to_underlying(NativeExecutable::ExitReason::Continue);
+}
+
+Operand Compiler::slot(Bytecode::Operand operand) const
+{
+    return Operand::Mem64BaseAndOffset(REGISTERS_BASE, operand.index() * sizeof(Value));
+}
+
+void Compiler::load_vm_value(Assembler::Reg dst, Bytecode::Operand src)
+{
+    m_assembler.mov(Operand::Register(dst), slot(src));
+}
+
+void Compiler::store_vm_value(Bytecode::Operand dst, Assembler::Reg src)
+{
+    m_assembler.mov(slot(dst), Operand::Register(src));
+}
+
+void Compiler::jump_if_not_tag(Assembler::Reg value, u64 tag, Assembler::Label& label)
+{
+    m_assembler.mov(Operand::Register(GPR3), Operand::Register(value));
+    m_assembler.shift_right(Operand::Register(GPR3), Operand::Imm(TAG_SHIFT));
+    m_assembler.jump_if(Operand::Register(GPR3), Condition::NotEqualTo, Operand::Imm(tag), label);
+}
+
+void Compiler::jump_if_not_int32(Assembler::Reg value, Assembler::Label& label)
+{
+    jump_if_not_tag(value, INT32_TAG, label);
+}
+
+void Compiler::box_int32(Assembler::Reg reg)
+{
+    m_assembler.mov32(Operand::Register(reg), Operand::Register(reg));
+    m_assembler.mov(Operand::Register(GPR3), Operand::Imm(SHIFTED_INT32_TAG));
+    m_assembler.bitwise_or(Operand::Register(reg), Operand::Register(GPR3));
+}
+
+void Compiler::store_program_counter()
+{
+    m_assembler.mov(Operand::Register(GPR3), Operand::Imm(m_current_program_counter));
+    m_assembler.mov(Operand::Mem64BaseAndOffset(PROGRAM_COUNTER, 0), Operand::Register(GPR3));
+}
+
+void Compiler::check_exception()
+{
+    m_assembler.jump_if(Operand::Register(RETURN_VALUE), Condition::NotEqualTo, Operand::Imm(0), m_exit_with_exception);
+}
+
+void Compiler::jump_to(Bytecode::Label const& target)
+{
+    auto it = m_instruction_labels.find(target.address());
+    VERIFY(it != m_instruction_labels.end());
+    m_assembler.jump(it->value);
+}
+
+void Compiler::compile_slow_case(Bytecode::Instruction const& instruction, u64 helper)
+{
+    store_program_counter();
+    m_assembler.mov(Operand::Register(ARG0), Operand::Register(INTERPRETER));
+    m_assembler.mov(Operand::Register(ARG1), Operand::Imm(bit_cast<u64>(&instruction)));
+    m_assembler.native_call(helper);
+    check_exception();
+}
+
+template<typename OpType>
+void Compiler::compile_op(OpType const& instruction)
+{
+    compile_slow_case(instruction, bit_cast<u64>(&cxx_execute<OpType>));
+}
+
+void Compiler::compile_op(Bytecode::Op::Mov const& instruction)
+{
+    load_vm_value(GPR0, instruction.src());
+    store_vm_value(instruction.dst(), GPR0);
+}
+
+void Compiler::compile_op(Bytecode::Op::GetArgument const& instruction)
+{
+    m_assembler.mov(Operand::Register(GPR0), Operand::Mem64BaseAndOffset(ARGUMENTS_BASE, instruction.index() * sizeof(Value)));
+    store_vm_value(instruction.dst(), GPR0);
+}
+
+void Compiler::compile_op(Bytecode::Op::SetArgument const& instruction)
+{
+    load_vm_value(GPR0, instruction.src());
+    m_assembler.mov(Operand::Mem64BaseAndOffset(ARGUMENTS_BASE, instruction.index() * sizeof(Value)), Operand::Register(GPR0));
+}
+
+void Compiler::compile_op(Bytecode::Op::End const& instruction)
+{
+    load_vm_value(GPR0, instruction.value());
+    store_vm_value(Bytecode::Operand(Bytecode::Register::accumulator()), GPR0);
+    m_assembler.jump(m_exit_with_return);
+}
+
+void Compiler::compile_op(Bytecode::Op::Return const& instruction)
+{
+    compile_slow_case(instruction, bit_cast<u64>(&cxx_execute<Bytecode::Op::Return>));
+    m_assembler.jump(m_exit_with_return);
+}
+
+void Compiler::compile_op(Bytecode::Op::Await const& instruction)
+{
+    compile_slow_case(instruction, bit_cast<u64>(&cxx_execute<Bytecode::Op::Await>));
+    m_assembler.jump(m_exit_with_return);
+}
+
+void Compiler::compile_op(Bytecode::Op::Yield const& instruction)
+{
+    compile_slow_case(instruction, bit_cast<u64>(&cxx_execute<Bytecode::Op::Yield>));
+    m_assembler.jump(m_exit_with_return);
+}
+
+void Compiler::compile_op(Bytecode::Op::Jump const& instruction)
+{
+    jump_to(instruction.target());
+}
+
+// Leaves zero in RETURN_VALUE if the condition is falsy, and something else if it's truthy.
+void Compiler::compile_to_boolean(Bytecode::Operand condition)
+{
+    Assembler::Label not_boolean;
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_vm_value(ARG0, condition);
+
+    // Booleans keep their value in the lowest bit.
+    jump_if_not_tag(ARG0, BOOLEAN_TAG, not_boolean);
+    m_assembler.mov(Operand::Register(RETURN_VALUE), Operand::Register(ARG0));
+    m_assembler.bitwise_and(Operand::Register(RETURN_VALUE), Operand::Imm(1));
+    m_assembler.jump(done);
+
+    not_boolean.link(m_assembler);
+    jump_if_not_int32(ARG0, slow_case);
+    m_assembler.mov32(Operand::Register(RETURN_VALUE), Operand::Register(ARG0));
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    m_assembler.native_call(bit_cast<u64>(&cxx_to_boolean));
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpIf const& instruction)
+{
+    compile_to_boolean(instruction.condition());
+    m_assembler.jump_if(Operand::Register(RETURN_VALUE), Condition::NotEqualTo, Operand::Imm(0), label_for(instruction.true_target()));
+    jump_to(instruction.false_target());
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpTrue const& instruction)
+{
+    compile_to_boolean(instruction.condition());
+    m_assembler.jump_if(Operand::Register(RETURN_VALUE), Condition::NotEqualTo, Operand::Imm(0), label_for(instruction.target()));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpFalse const& instruction)
+{
+    compile_to_boolean(instruction.condition());
+    m_assembler.jump_if(Operand::Register(RETURN_VALUE), Condition::EqualTo, Operand::Imm(0), label_for(instruction.target()));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpNullish const& instruction)
+{
+    load_vm_value(GPR0, instruction.condition());
+    m_assembler.shift_right(Operand::Register(GPR0), Operand::Imm(TAG_SHIFT));
+    m_assembler.bitwise_and(Operand::Register(GPR0), Operand::Imm(IS_NULLISH_EXTRACT_PATTERN));
+    m_assembler.jump_if(Operand::Register(GPR0), Condition::EqualTo, Operand::Imm(IS_NULLISH_PATTERN), label_for(instruction.true_target()));
+    jump_to(instruction.false_target());
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpUndefined const& instruction)
+{
+    load_vm_value(GPR0, instruction.condition());
+    m_assembler.shift_right(Operand::Register(GPR0), Operand::Imm(TAG_SHIFT));
+    m_assembler.jump_if(Operand::Register(GPR0), Condition::EqualTo, Operand::Imm(UNDEFINED_TAG), label_for(instruction.true_target()));
+    jump_to(instruction.false_target());
+}
+
+template<typename OpType>
+void Compiler::compile_jump_comparison_op(OpType const& instruction, Condition condition, u64 slow_case_helper)
+{
+    Assembler::Label slow_case;
+
+    load_vm_value(ARG1, instruction.lhs());
+    load_vm_value(ARG2, instruction.rhs());
+    jump_if_not_int32(ARG1, slow_case);
+    jump_if_not_int32(ARG2, slow_case);
+
+    m_assembler.mov(Operand::Register(GPR1), Operand::Register(ARG1));
+    m_assembler.sign_extend_32_to_64_bits(GPR1);
+    m_assembler.mov(Operand::Register(GPR2), Operand::Register(ARG2));
+    m_assembler.sign_extend_32_to_64_bits(GPR2);
+    m_assembler.jump_if(Operand::Register(GPR1), condition, Operand::Register(GPR2), label_for(instruction.true_target()));
+    jump_to(instruction.false_target());
+
+    slow_case.link(m_assembler);
+    store_program_counter();
+    m_assembler.mov(Operand::Register(ARG0), Operand::Register(INTERPRETER));
+    m_assembler.native_call(slow_case_helper);
+    m_assembler.jump_if(Operand::Register(RETURN_VALUE), Condition::EqualTo, Operand::Imm(comparison_threw), m_exit_with_exception);
+    m_assembler.jump_if(Operand::Register(RETURN_VALUE), Condition::NotEqualTo, Operand::Imm(0), label_for(instruction.true_target()));
+    jump_to(instruction.false_target());
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpLessThan const& instruction)
+{
+    compile_jump_comparison_op(instruction, Condition::SignedLessThan, bit_cast<u64>(&cxx_jump_comparison<less_than>));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpLessThanEquals const& instruction)
+{
+    compile_jump_comparison_op(instruction, Condition::SignedLessThanOrEqualTo, bit_cast<u64>(&cxx_jump_comparison<less_than_equals>));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpGreaterThan const& instruction)
+{
+    compile_jump_comparison_op(instruction, Condition::SignedGreaterThan, bit_cast<u64>(&cxx_jump_comparison<greater_than>));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpGreaterThanEquals const& instruction)
+{
+    compile_jump_comparison_op(instruction, Condition::SignedGreaterThanOrEqualTo, bit_cast<u64>(&cxx_jump_comparison<greater_than_equals>));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpLooselyEquals const& instruction)
+{
+    compile_jump_comparison_op(instruction, Condition::EqualTo, bit_cast<u64>(&cxx_jump_comparison<loosely_equals>));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpLooselyInequals const& instruction)
+{
+    compile_jump_comparison_op(instruction, Condition::NotEqualTo, bit_cast<u64>(&cxx_jump_comparison<loosely_inequals>));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpStrictlyEquals const& instruction)
+{
+    compile_jump_comparison_op(instruction, Condition::EqualTo, bit_cast<u64>(&cxx_jump_comparison<strict_equals>));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpStrictlyInequals const& instruction)
+{
+    compile_jump_comparison_op(instruction, Condition::NotEqualTo, bit_cast<u64>(&cxx_jump_comparison<strict_inequals>));
+}
+
+void Compiler::compile_op(Bytecode::Op::EnterUnwindContext const& instruction)
+{
+    store_program_counter();
+    m_assembler.mov(Operand::Register(ARG0), Operand::Register(INTERPRETER));
+    m_assembler.native_call(bit_cast<u64>(&cxx_enter_unwind_context));
+    jump_to(instruction.entry_point());
+}
+
+// These can continue almost anywhere, so they leave it to the caller to find the way there.
+void Compiler::compile_op(Bytecode::Op::ContinuePendingUnwind const& instruction)
+{
+    store_program_counter();
+    m_assembler.mov(Operand::Register(ARG0), Operand::Register(INTERPRETER));
+    m_assembler.mov(Operand::Register(ARG1), Operand::Imm(bit_cast<u64>(&instruction)));
+    m_assembler.mov(Operand::Register(ARG2), Operand::Register(PROGRAM_COUNTER));
+    m_assembler.native_call(bit_cast<u64>(&cxx_continue_pending_unwind));
+    m_assembler.jump(m_exit);
+}
+
+void Compiler::compile_op(Bytecode::Op::ScheduleJump const& instruction)
+{
+    store_program_counter();
+    m_assembler.mov(Operand::Register(ARG0), Operand::Register(INTERPRETER));
+    m_assembler.mov(Operand::Register(ARG1), Operand::Imm(bit_cast<u64>(&instruction)));
+    m_assembler.mov(Operand::Register(ARG2), Operand::Register(PROGRAM_COUNTER));
+    m_assembler.native_call(bit_cast<u64>(&cxx_schedule_jump));
+    m_assembler.jump(m_exit);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_binary_op(OpType const& instruction, Function<void(Assembler::Label& slow_case)> emit_operation)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_vm_value(GPR1, instruction.lhs());
+    load_vm_value(GPR2, instruction.rhs());
+    jump_if_not_int32(GPR1, slow_case);
+    jump_if_not_int32(GPR2, slow_case);
+
+    // Operates on the low 32 bits of GPR0 and GPR2, the tags are put back afterwards.
+    m_assembler.mov(Operand::Register(GPR0), Operand::Register(GPR1));
+    emit_operation(slow_case);
+    box_int32(GPR0);
+    store_vm_value(instruction.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_slow_case(instruction, bit_cast<u64>(&cxx_execute<OpType>));
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_op(Bytecode::Op::Add const& instruction)
+{
+    compile_int32_binary_op(instruction, [&](auto& slow_case) {
+        m_assembler.add32(Operand::Register(GPR0), Operand::Register(GPR2), slow_case);
+    });
+}
+
+void Compiler::compile_op(Bytecode::Op::Sub const& instruction)
+{
+    compile_int32_binary_op(instruction, [&](auto& slow_case) {
+        m_assembler.sub32(Operand::Register(GPR0), Operand::Register(GPR2), slow_case);
+    });
+}
+
+void Compiler::compile_op(Bytecode::Op::Mul const& instruction)
+{
+    compile_int32_binary_op(instruction, [&](auto& slow_case) {
+        m_assembler.mul32(Operand::Register(GPR0), Operand::Register(GPR2), slow_case);
+    });
+}
+
+void Compiler::compile_op(Bytecode::Op::BitwiseAnd const& instruction)
+{
+    compile_int32_binary_op(instruction, [&](auto&) {
+        m_assembler.bitwise_and(Operand::Register(GPR0), Operand::Register(GPR2));
+    });
+}
+
+void Compiler::compile_op(Bytecode::Op::BitwiseOr const& instruction)
+{
+    compile_int32_binary_op(instruction, [&](auto&) {
+        m_assembler.bitwise_or(Operand::Register(GPR0), Operand::Register(GPR2));
+    });
+}
+
+void Compiler::compile_op(Bytecode::Op::BitwiseXor const& instruction)
+{
+    compile_int32_binary_op(instruction, [&](auto&) {
+        m_assembler.bitwise_xor32(Operand::Register(GPR0), Operand::Register(GPR2));
+    });
+}
+
+template<typename OpType>
+void Compiler::compile_int32_comparison_op(OpType const& instruction, Condition condition)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_vm_value(GPR1, instruction.lhs());
+    load_vm_value(GPR2, instruction.rhs());
+    jump_if_not_int32(GPR1, slow_case);
+    jump_if_not_int32(GPR2, slow_case);
+
+    m_assembler.sign_extend_32_to_64_bits(GPR1);
+    m_assembler.sign_extend_32_to_64_bits(GPR2);
+    m_assembler.mov(Operand::Register(GPR0), Operand::Imm(Value(false).encoded()));
+    m_assembler.mov(Operand::Register(GPR3), Operand::Imm(Value(true).encoded()));
+    m_assembler.cmp(Operand::Register(GPR1), Operand::Register(GPR2));
+    m_assembler.mov_if(condition, Operand::Register(GPR0), Operand::Register(GPR3));
+    store_vm_value(instruction.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_slow_case(instruction, bit_cast<u64>(&cxx_execute<OpType>));
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_op(Bytecode::Op::LessThan const& instruction)
+{
+    compile_int32_comparison_op(instruction, Condition::SignedLessThan);
+}
+
+void Compiler::compile_op(Bytecode::Op::LessThanEquals const& instruction)
+{
+    compile_int32_comparison_op(instruction, Condition::SignedLessThanOrEqualTo);
+}
+
+void Compiler::compile_op(Bytecode::Op::GreaterThan const& instruction)
+{
+    compile_int32_comparison_op(instruction, Condition::SignedGreaterThan);
+}
+
+void Compiler::compile_op(Bytecode::Op::GreaterThanEquals const& instruction)
+{
+    compile_int32_comparison_op(instruction, Condition::SignedGreaterThanOrEqualTo);
+}
+
+void Compiler::compile_op(Bytecode::Op::Increment const& instruction)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_vm_value(GPR0, instruction.dst());
+    jump_if_not_int32(GPR0, slow_case);
+    m_assembler.inc32(Operand::Register(GPR0), slow_case);
+    box_int32(GPR0);
+    store_vm_value(instruction.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_slow_case(instruction, bit_cast<u64>(&cxx_execute<Bytecode::Op::Increment>));
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_op(Bytecode::Op::Decrement const& instruction)
+{
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_vm_value(GPR0, instruction.dst());
+    jump_if_not_int32(GPR0, slow_case);
+    m_assembler.dec32(Operand::Register(GPR0), slow_case);
+    box_int32(GPR0);
+    store_vm_value(instruction.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_slow_case(instruction, bit_cast<u64>(&cxx_execute<Bytecode::Op::Decrement>));
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_op(Bytecode::Op::GetById const& instruction)
+{
+    // The inline path only handles own properties of objects whose shape is in the cache,
+    // lookups through the prototype chain are left to the C++ code.
+    static_assert(sizeof(WeakPtr<Shape>) == sizeof(void*));
+    static_assert(sizeof(GCPtr<Shape>) == sizeof(void*));
+
+    Assembler::Label slow_case;
+    Assembler::Label done;
+
+    load_vm_value(GPR0, instruction.base());
+    jump_if_not_tag(GPR0, OBJECT_TAG, slow_case);
+
+    // Cells keep their pointer in the low 48 bits, sign extended.
+    m_assembler.shift_left(Operand::Register(GPR0), Operand::Imm(16));
+    m_assembler.arithmetic_right_shift(Operand::Register(GPR0), Operand::Imm(16));
+
+    auto& cache = m_executable.property_lookup_caches[instruction.cache_index()];
+    m_assembler.mov(Operand::Register(GPR1), Operand::Imm(bit_cast<u64>(&cache)));
+
+    // if (cache.prototype) goto slow_case;
+    m_assembler.mov(Operand::Register(GPR2), Operand::Mem64BaseAndOffset(GPR1, __builtin_offsetof(Bytecode::PropertyLookupCache, prototype)));
+    m_assembler.jump_if(Operand::Register(GPR2), Condition::NotEqualTo, Operand::Imm(0), slow_case);
+
+    // if (&object->shape() != cache.shape) goto slow_case;
+    m_assembler.mov(Operand::Register(GPR2), Operand::Mem64BaseAndOffset(GPR1, __builtin_offsetof(Bytecode::PropertyLookupCache, shape)));
+    m_assembler.jump_if(Operand::Register(GPR2), Condition::EqualTo, Operand::Imm(0), slow_case);
+    m_assembler.mov(Operand::Register(GPR2), Operand::Mem64BaseAndOffset(GPR2, AK::WeakLink::pointer_offset()));
+    m_assembler.mov(Operand::Register(GPR3), Operand::Mem64BaseAndOffset(GPR0, Object::shape_offset()));
+    m_assembler.jump_if(Operand::Register(GPR3), Condition::NotEqualTo, Operand::Register(GPR2), slow_case);
+
+    // dst = object->get_direct(cache.property_offset.value());
+    // NOTE: Optional keeps its value at the start, and the offset is always set together with the shape.
+    m_assembler.mov32(Operand::Register(GPR2), Operand::Mem64BaseAndOffset(GPR1, __builtin_offsetof(Bytecode::PropertyLookupCache, property_offset)));
+    m_assembler.shift_left(Operand::Register(GPR2), Operand::Imm(3));
+    m_assembler.mov(Operand::Register(GPR3), Operand::Mem64BaseAndOffset(GPR0, Object::storage_offset() + Vector<Value>::outline_buffer_offset()));
+    m_assembler.add(Operand::Register(GPR3), Operand::Register(GPR2));
+    m_assembler.mov(Operand::Register(GPR0), Operand::Mem64BaseAndOffset(GPR3, 0));
+    store_vm_value(instruction.dst(), GPR0);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_slow_case(instruction, bit_cast<u64>(&cxx_execute<Bytecode::Op::GetById>));
+
+    done.link(m_assembler);
+}
+
+Assembler::Label& Compiler::label_for(Bytecode::Label const& target)
+{
+    auto it = m_instruction_labels.find(target.address());
+    VERIFY(it != m_instruction_labels.end());
+    return it->value;
+}
+
+OwnPtr<NativeExecutable> Compiler::compile_executable()
+{
+    // Every instruction gets its label up front, so that jumps can refer to the ones that come later.
+    for (Bytecode::InstructionStreamIterator it(m_executable.bytecode); !it.at_end(); ++it)
+        m_instruction_labels.set(it.offset(), {});
+
+    // u64 entry(Value* registers_and_constants_and_locals, Value* arguments, Interpreter*, u8 const* entry, size_t* program_counter)
+    m_assembler.enter();
+    m_assembler.mov(Operand::Register(REGISTERS_BASE), Operand::Register(ARG0));
+    m_assembler.mov(Operand::Register(ARGUMENTS_BASE), Operand::Register(ARG1));
+    m_assembler.mov(Operand::Register(INTERPRETER), Operand::Register(ARG2));
+    m_assembler.mov(Operand::Register(PROGRAM_COUNTER), Operand::Register(ARG4));
+    m_assembler.jump(Operand::Register(ARG3));
+
+    for (Bytecode::InstructionStreamIterator it(m_executable.bytecode); !it.at_end(); ++it) {
+        m_current_program_counter = it.offset();
+        m_instruction_labels.find(m_current_program_counter)->value.link(m_assembler);
+
+        auto const& instruction = *it;
+        switch (instruction.type()) {
+#define CASE_BYTECODE_OP(OpTitleCase)                                                     \
+    case Bytecode::Instruction::Type::OpTitleCase:                                        \
+        compile_op(static_cast<Bytecode::Op::OpTitleCase const&>(instruction)); \
+        break;
+            ENUMERATE_BYTECODE_OPS(CASE_BYTECODE_OP)
+#undef CASE_BYTECODE_OP
+        }
+    }
+
+    // Every basic block ends in a terminator, so this can't be reached by falling off the end.
+    m_assembler.verify_not_reached();
+
+    m_exit_with_return.link(m_assembler);
+    m_assembler.mov(Operand::Register(RETURN_VALUE), Operand::Imm(to_underlying(NativeExecutable::ExitReason::Return)));
+    m_assembler.jump(m_exit);
+
+    m_exit_with_exception.link(m_assembler);
+    m_assembler.mov(Operand::Register(RETURN_VALUE), Operand::Imm(to_underlying(NativeExecutable::ExitReason::Exception)));
+
+    // The exit reason is in RETURN_VALUE by the time we get here.
+    m_exit.link(m_assembler);
+    m_assembler.exit();
+
+    HashMap<size_t, size_t> entry_points;
+    entry_points.ensure_capacity(m_instruction_labels.size());
+    for (auto const& [program_counter, label] : m_instruction_labels)
+        entry_points.set(program_counter, label.offset_of_label_in_instruction_stream.value());
+
+    return NativeExecutable::try_create(m_output, move(entry_points), m_executable.name);
+}
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable& executable)
+{
+    Compiler compiler { executable };
+    return compiler.compile_executable();
+}
+
+#else
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable&)
+{
+    return nullptr;
+}
+
+#endif
+
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <LibJIT/Assembler.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+namespace JS::JIT {
+
+// A baseline compiler that translates a whole Bytecode::Executable to machine code, one
+// instruction at a time. Common cases like int32 arithmetic, comparisons, jumps and
+// cached property lookups get inline fast paths, everything else calls back into the
+// same C++ the interpreter uses, so both tiers always agree on the results.
+class Compiler {
+public:
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable&);
+
+#ifdef JIT_ARCH_SUPPORTED
+private:
+    using Assembler = ::JIT::Assembler;
+
+    // Pinned for the whole run of the native code. These are all callee-saved.
+    // NOTE: The assembler can't encode memory operands based on RSP, RBP, R12 or R13,
+    //       so those are never used to address memory.
+    static constexpr auto REGISTERS_BASE = Assembler::Reg::RBX;
+    static constexpr auto ARGUMENTS_BASE = Assembler::Reg::R15;
+    static constexpr auto PROGRAM_COUNTER = Assembler::Reg::R14;
+    static constexpr auto INTERPRETER = Assembler::Reg::R12;
+
+    // Arguments and return value of native calls (System V AMD64 ABI).
+    static constexpr auto ARG0 = Assembler::Reg::RDI;
+    static constexpr auto ARG1 = Assembler::Reg::RSI;
+    static constexpr auto ARG2 = Assembler::Reg::RDX;
+    static constexpr auto ARG3 = Assembler::Reg::RCX;
+    static constexpr auto ARG4 = Assembler::Reg::R8;
+    static constexpr auto RETURN_VALUE = Assembler::Reg::RAX;
+
+    // Scratch registers, clobbered by native calls.
+    static constexpr auto GPR0 = Assembler::Reg::RAX;
+    static constexpr auto GPR1 = Assembler::Reg::R9;
+    static constexpr auto GPR2 = Assembler::Reg::R10;
+    static constexpr auto GPR3 = Assembler::Reg::R11;
+
+    explicit Compiler(Bytecode::Executable& executable)
+        : m_executable(executable)
+        , m_assembler(m_output)
+    {
+    }
+
+    OwnPtr<NativeExecutable> compile_executable();
+
+    template<typename OpType>
+    void compile_op(OpType const&);
+
+    void compile_op(Bytecode::Op::Mov const&);
+    void compile_op(Bytecode::Op::GetArgument const&);
+    void compile_op(Bytecode::Op::SetArgument const&);
+    void compile_op(Bytecode::Op::End const&);
+    void compile_op(Bytecode::Op::Return const&);
+    void compile_op(Bytecode::Op::Await const&);
+    void compile_op(Bytecode::Op::Yield const&);
+    void compile_op(Bytecode::Op::Jump const&);
+    void compile_op(Bytecode::Op::JumpIf const&);
+    void compile_op(Bytecode::Op::JumpTrue const&);
+    void compile_op(Bytecode::Op::JumpFalse const&);
+    void compile_op(Bytecode::Op::JumpNullish const&);
+    void compile_op(Bytecode::Op::JumpUndefined const&);
+#define DECLARE_COMPILE_JUMP_COMPARISON_OP(op_TitleCase, ...) \
+    void compile_op(Bytecode::Op::Jump##op_TitleCase const&);
+    JS_ENUMERATE_COMPARISON_OPS(DECLARE_COMPILE_JUMP_COMPARISON_OP)
+#undef DECLARE_COMPILE_JUMP_COMPARISON_OP
+    void compile_op(Bytecode::Op::EnterUnwindContext const&);
+    void compile_op(Bytecode::Op::ContinuePendingUnwind const&);
+    void compile_op(Bytecode::Op::ScheduleJump const&);
+    void compile_op(Bytecode::Op::Add const&);
+    void compile_op(Bytecode::Op::Sub const&);
+    void compile_op(Bytecode::Op::Mul const&);
+    void compile_op(Bytecode::Op::BitwiseAnd const&);
+    void compile_op(Bytecode::Op::BitwiseOr const&);
+    void compile_op(Bytecode::Op::BitwiseXor const&);
+    void compile_op(Bytecode::Op::LessThan const&);
+    void compile_op(Bytecode::Op::LessThanEquals const&);
+    void compile_op(Bytecode::Op::GreaterThan const&);
+    void compile_op(Bytecode::Op::GreaterThanEquals const&);
+    void compile_op(Bytecode::Op::Increment const&);
+    void compile_op(Bytecode::Op::Decrement const&);
+    void compile_op(Bytecode::Op::GetById const&);
+
+    template<typename OpType>
+    void compile_int32_binary_op(OpType const&, Function<void(Assembler::Label& slow_case)> emit_operation);
+    template<typename OpType>
+    void compile_int32_comparison_op(OpType const&, Assembler::Condition);
+    template<typename OpType>
+    void compile_jump_comparison_op(OpType const&, Assembler::Condition, u64 slow_case_helper);
+
+    // Calls the C++ implementation of the instruction and checks for an exception.
+    void compile_slow_case(Bytecode::Instruction const&, u64 helper);
+    void compile_to_boolean(Bytecode::Operand);
+
+    Assembler::Operand slot(Bytecode::Operand) const;
+    void load_vm_value(Assembler::Reg, Bytecode::Operand);
+    void store_vm_value(Bytecode::Operand, Assembler::Reg);
+
+    void jump_if_not_int32(Assembler::Reg value, Assembler::Label&);
+    void jump_if_not_tag(Assembler::Reg value, u64 tag, Assembler::Label&);
+    // Turns the low 32 bits of the register into an int32 Value.
+    void box_int32(Assembler::Reg);
+    void store_program_counter();
+    void check_exception();
+    void jump_to(Bytecode::Label const&);
+    Assembler::Label& label_for(Bytecode::Label const&);
+
+    Bytecode::Executable& m_executable;
+    Vector<u8> m_output;
+    Assembler m_assembler;
+
+    // Every instruction is a possible entry point, so each one gets a label.
+    HashMap<size_t, Assembler::Label> m_instruction_labels;
+    size_t m_current_program_counter { 0 };
+
+    Assembler::Label m_exit;
+    Assembler::Label m_exit_with_exception;
+    Assembler::Label m_exit_with_return;
+#endif
+};
+
+}
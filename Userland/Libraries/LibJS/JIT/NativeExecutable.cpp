@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibJIT/GDB.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+OwnPtr<NativeExecutable> NativeExecutable::try_create(ReadonlyBytes machine_code, HashMap<size_t, size_t> entry_points, StringView name)
+{
+    // The code is only ever writable before it's executable, never both at once.
+    auto* code = mmap(nullptr, machine_code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED) {
+        dbgln("LibJS JIT: Failed to map memory for native code: {}", strerror(errno));
+        return nullptr;
+    }
+    memcpy(code, machine_code.data(), machine_code.size());
+    if (mprotect(code, machine_code.size(), PROT_READ | PROT_EXEC) < 0) {
+        dbgln("LibJS JIT: Failed to make native code executable: {}", strerror(errno));
+        munmap(code, machine_code.size());
+        return nullptr;
+    }
+
+    auto gdb_object = ::JIT::GDB::build_gdb_image({ static_cast<u8 const*>(code), machine_code.size() }, "LibJS JIT"sv, name.is_empty() ? "(anonymous)"sv : name);
+    if (gdb_object.has_value())
+        ::JIT::GDB::register_into_gdb(gdb_object->span());
+
+    auto* native_executable = new (nothrow) NativeExecutable(code, machine_code.size(), move(entry_points), move(gdb_object));
+    if (!native_executable) {
+        if (gdb_object.has_value())
+            ::JIT::GDB::unregister_from_gdb(gdb_object->span());
+        munmap(code, machine_code.size());
+        return nullptr;
+    }
+    return adopt_own(*native_executable);
+}
+
+NativeExecutable::NativeExecutable(void* code, size_t size, HashMap<size_t, size_t> entry_points, Optional<FixedArray<u8>> gdb_object)
+    : m_code(code)
+    , m_size(size)
+    , m_entry_points(move(entry_points))
+    , m_gdb_object(move(gdb_object))
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    if (m_gdb_object.has_value())
+        ::JIT::GDB::unregister_from_gdb(m_gdb_object->span());
+    munmap(m_code, m_size);
+}
+
+NativeExecutable::ExitReason NativeExecutable::run(Bytecode::Interpreter& interpreter, Value* registers_and_constants_and_locals, Value* arguments, size_t& program_counter) const
+{
+    auto native_offset = m_entry_points.get(program_counter);
+    VERIFY(native_offset.has_value());
+
+    // The code starts with a prologue that jumps to the entry address once everything is set up.
+    using EntryFunction = u64 (*)(Value* registers_and_constants_and_locals, Value* arguments, Bytecode::Interpreter*, u8 const* entry, size_t* program_counter);
+    auto* code = static_cast<u8 const*>(m_code);
+    auto entry_function = reinterpret_cast<EntryFunction>(m_code);
+    return static_cast<ExitReason>(entry_function(registers_and_constants_and_locals, arguments, &interpreter, code + *native_offset, &program_counter));
+}
+
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FixedArray.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/StringView.h>
+#include <LibJS/Forward.h>
+
+namespace JS::JIT {
+
+// Machine code for a whole Bytecode::Executable. It can be entered at the start of any
+// bytecode instruction, and keeps running until the executable returns, throws an
+// exception, or wants to continue somewhere only the interpreter can find.
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    // Returned from the machine code in RAX.
+    enum class ExitReason : u64 {
+        // The executable is done, the result is in the return value register.
+        Return = 0,
+        // The instruction at the program counter threw, the exception is in the exception register.
+        Exception = 1,
+        // Execution should continue at the program counter, which was set by a helper.
+        Continue = 2,
+    };
+
+    // entry_points maps bytecode offsets to offsets into machine_code.
+    static OwnPtr<NativeExecutable> try_create(ReadonlyBytes machine_code, HashMap<size_t, size_t> entry_points, StringView name);
+    ~NativeExecutable();
+
+    [[nodiscard]] bool can_enter_at(size_t program_counter) const { return m_entry_points.contains(program_counter); }
+
+    // Runs the code starting at the instruction at program_counter, and leaves it pointing
+    // at the instruction that returned or threw, or the one to continue at.
+    ExitReason run(Bytecode::Interpreter&, Value* registers_and_constants_and_locals, Value* arguments, size_t& program_counter) const;
+
+private:
+    NativeExecutable(void* code, size_t size, HashMap<size_t, size_t> entry_points, Optional<FixedArray<u8>> gdb_object);
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    HashMap<size_t, size_t> m_entry_points;
+    Optional<FixedArray<u8>> m_gdb_object;
+};
+
+}
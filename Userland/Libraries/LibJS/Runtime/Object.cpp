@@ -549,6 +549,7 @@ ThrowCompletionOr<void> Object::private_field_add(PrivateName const& name, Value
 
     if (!m_private_elements)
         m_private_elements = make<Vector<PrivateElement>>();
+    write_barrier();
 
     // 4. Append PrivateElement { [[Key]]: P, [[Kind]]: field, [[Value]]: value } to O.[[PrivateElements]].
     m_private_elements->empend(name, PrivateElement::Kind::Field, value);
@@ -577,6 +578,7 @@ ThrowCompletionOr<void> Object::private_method_or_accessor_add(PrivateElement el
 
     if (!m_private_elements)
         m_private_elements = make<Vector<PrivateElement>>();
+    write_barrier();
 
     // 5. Append method to O.[[PrivateElements]].
     m_private_elements->append(move(element));
@@ -634,6 +636,7 @@ ThrowCompletionOr<void> Object::private_set(PrivateName const& name, Value value
     // 3. If entry.[[Kind]] is field, then
     if (entry->kind == PrivateElement::Kind::Field) {
         // a. Set entry.[[Value]] to value.
+        write_barrier();
         entry->value = value;
         return {};
     }
@@ -1168,8 +1171,10 @@ Optional<ValueAndAttributes> Object::storage_get(PropertyKey const& property_key
             return {};
 
         if (m_has_intrinsic_accessors) {
-            if (auto accessor = find_intrinsic_accessor(this, property_key); accessor.has_value())
+            if (auto accessor = find_intrinsic_accessor(this, property_key); accessor.has_value()) {
+                const_cast<Object&>(*this).write_barrier();
                 const_cast<Object&>(*this).m_storage[metadata->offset] = (*accessor)(shape().realm());
+            }
         }
 
         value = m_storage[metadata->offset];
@@ -1191,6 +1196,7 @@ bool Object::storage_has(PropertyKey const& property_key) const
 void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes const& value_and_attributes)
 {
     VERIFY(property_key.is_valid());
+    write_barrier();
 
     auto [value, attributes, _] = value_and_attributes;
 
@@ -1235,6 +1241,7 @@ void Object::storage_delete(PropertyKey const& property_key)
 {
     VERIFY(property_key.is_valid());
     VERIFY(storage_has(property_key));
+    write_barrier();
 
     if (property_key.is_number())
         return m_indexed_properties.remove(property_key.as_number());
@@ -1263,6 +1270,7 @@ void Object::set_prototype(Object* new_prototype)
 {
     if (prototype() == new_prototype)
         return;
+    write_barrier();
     m_shape = shape().create_prototype_transition(new_prototype);
 }
 
@@ -209,15 +209,32 @@ public:
     virtual void visit_edges(Cell::Visitor&) override;
 
     Value get_direct(size_t index) const { return m_storage[index]; }
-    void put_direct(size_t index, Value value) { m_storage[index] = value; }
+    void put_direct(size_t index, Value value)
+    {
+        write_barrier();
+        m_storage[index] = value;
+    }
 
     IndexedProperties const& indexed_properties() const { return m_indexed_properties; }
-    IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+    // NOTE: Mutable access may be used to store new values, so it has to go through the write barrier.
+    IndexedProperties& indexed_properties()
+    {
+        write_barrier();
+        return m_indexed_properties;
+    }
+    void set_indexed_property_elements(Vector<Value>&& values)
+    {
+        write_barrier();
+        m_indexed_properties = IndexedProperties(move(values));
+    }
 
     Shape& shape() { return *m_shape; }
     Shape const& shape() const { return *m_shape; }
 
+    // Used by the JIT to inline cached property lookups.
+    static constexpr size_t shape_offset() { return __builtin_offsetof(Object, m_shape); }
+    static constexpr size_t storage_offset() { return __builtin_offsetof(Object, m_storage); }
+
     void convert_to_prototype_if_needed();
 
     template<typename T>
@@ -254,7 +271,11 @@ protected:
     bool m_is_typed_array { false };
 
 private:
-    void set_shape(Shape& shape) { m_shape = &shape; }
+    void set_shape(Shape& shape)
+    {
+        write_barrier();
+        m_shape = &shape;
+    }
 
     Object* prototype() { return shape().prototype(); }
 
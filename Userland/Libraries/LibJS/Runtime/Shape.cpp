@@ -5,6 +5,7 @@
  */
 
 #include <LibJS/Heap/DeferGC.h>
+#include <LibJS/Heap/HeapBlock.h>
 #include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/VM.h>
 
@@ -15,6 +16,90 @@ JS_DEFINE_ALLOCATOR(PrototypeChainValidity);
 
 static HashTable<JS::GCPtr<Shape>> s_all_prototype_shapes;
 
+NonnullRefPtr<PropertyTable> PropertyTable::create(u32 capacity)
+{
+    auto table = adopt_ref(*new PropertyTable);
+    table->m_entries.ensure_capacity(capacity);
+    return table;
+}
+
+NonnullRefPtr<PropertyTable> PropertyTable::clone(u32 entry_count, u32 capacity) const
+{
+    VERIFY(entry_count <= m_entries.size());
+    auto table = create(max(entry_count, capacity));
+    table->m_entries.append(m_entries.data(), entry_count);
+    table->rebuild_index();
+    return table;
+}
+
+Optional<u32> PropertyTable::find(StringOrSymbol const& key, u32 entry_count) const
+{
+    if (entry_count <= LINEAR_SEARCH_THRESHOLD || !m_index) {
+        for (u32 i = 0; i < entry_count; ++i) {
+            if (m_entries[i].key.is_identical_to(key))
+                return i;
+        }
+        return {};
+    }
+
+    // The index also covers the entries that other shapes appended after ours.
+    auto index = m_index->get(key);
+    if (!index.has_value() || *index >= entry_count)
+        return {};
+    return index;
+}
+
+bool PropertyTable::can_append(u32 entry_count) const
+{
+    if (m_entries.size() != entry_count)
+        return false;
+    // Growing the entries would leave other shapes iterating over them with dangling pointers.
+    return ref_count() == 1 || m_entries.size() < m_entries.capacity();
+}
+
+void PropertyTable::append(StringOrSymbol const& key, PropertyMetadata metadata)
+{
+    m_entries.append({ key, metadata });
+    if (m_index)
+        m_index->set(key, m_entries.size() - 1);
+    else if (m_entries.size() > LINEAR_SEARCH_THRESHOLD)
+        rebuild_index();
+}
+
+void PropertyTable::remove(u32 index)
+{
+    VERIFY(ref_count() == 1);
+    auto removed_offset = m_entries[index].value.offset;
+    m_entries.remove(index);
+    for (auto& entry : m_entries) {
+        VERIFY(entry.value.offset != removed_offset);
+        if (entry.value.offset > removed_offset)
+            --entry.value.offset;
+    }
+    rebuild_index();
+}
+
+void PropertyTable::rebuild_index()
+{
+    if (m_entries.size() <= LINEAR_SEARCH_THRESHOLD) {
+        m_index = nullptr;
+        return;
+    }
+    m_index = make<HashMap<StringOrSymbol, u32>>();
+    m_index->ensure_capacity(m_entries.size());
+    for (u32 i = 0; i < m_entries.size(); ++i)
+        m_index->set(m_entries[i].key, i);
+}
+
+size_t PropertyTable::memory_usage() const
+{
+    auto bytes = sizeof(PropertyTable) + m_entries.capacity() * sizeof(Entry);
+    // NOTE: This is a rough estimate, as it doesn't account for the bucket bookkeeping of the HashMap.
+    if (m_index)
+        bytes += sizeof(*m_index) + m_index->capacity() * (sizeof(StringOrSymbol) + sizeof(u32));
+    return bytes;
+}
+
 Shape::~Shape()
 {
     if (m_is_prototype_shape)
@@ -29,9 +114,8 @@ NonnullGCPtr<Shape> Shape::create_cacheable_dictionary_transition()
     new_shape->m_prototype = m_prototype;
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
     ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = m_property_table->clone(m_property_count, m_property_count);
+    new_shape->m_property_count = m_property_count;
     return new_shape;
 }
 
@@ -43,9 +127,8 @@ NonnullGCPtr<Shape> Shape::create_uncacheable_dictionary_transition()
     new_shape->m_prototype = m_prototype;
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
     ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = m_property_table->clone(m_property_count, m_property_count);
+    new_shape->m_property_count = m_property_count;
     return new_shape;
 }
 
@@ -214,62 +297,80 @@ Optional<PropertyMetadata> Shape::lookup(StringOrSymbol const& property_key) con
 {
     if (m_property_count == 0)
         return {};
-    auto property = property_table().get(property_key);
-    if (!property.has_value())
+    ensure_property_table();
+    auto index = m_property_table->find(property_key, m_property_count);
+    if (!index.has_value())
         return {};
-    return property;
+    return (*m_property_table)[*index].value;
 }
 
-FLATTEN OrderedHashMap<StringOrSymbol, PropertyMetadata> const& Shape::property_table() const
+FLATTEN ReadonlySpan<PropertyTable::Entry> Shape::property_table() const
 {
     ensure_property_table();
-    return *m_property_table;
+    return m_property_table->entries(m_property_count);
 }
 
 void Shape::ensure_property_table() const
 {
     if (m_property_table)
         return;
-    m_property_table = make<OrderedHashMap<StringOrSymbol, PropertyMetadata>>();
 
-    u32 next_offset = 0;
+    RefPtr<PropertyTable> table;
+    u32 entry_count = 0;
 
     Vector<Shape const&, 64> transition_chain;
     transition_chain.append(*this);
     for (auto shape = m_previous; shape; shape = shape->m_previous) {
         if (shape->m_property_table) {
-            *m_property_table = *shape->m_property_table;
-            next_offset = shape->m_property_count;
+            table = shape->m_property_table;
+            entry_count = shape->m_property_count;
             break;
         }
         transition_chain.append(*shape);
     }
 
+    // Leaves room for the shapes that will most likely be created by further put transitions.
+    auto capacity_for_copy = [&] { return max(m_property_count, entry_count) * 2; };
+
+    if (!table)
+        table = PropertyTable::create(capacity_for_copy());
+
     for (auto const& shape : transition_chain.in_reverse()) {
-        if (!shape.m_property_key.is_valid()) {
-            // Ignore prototype transitions as they don't affect the key map.
-            continue;
-        }
-        if (shape.m_transition_type == TransitionType::Put) {
-            m_property_table->set(shape.m_property_key, { next_offset++, shape.m_attributes });
-        } else if (shape.m_transition_type == TransitionType::Configure) {
-            auto it = m_property_table->find(shape.m_property_key);
-            VERIFY(it != m_property_table->end());
-            it->value.attributes = shape.m_attributes;
-        } else if (shape.m_transition_type == TransitionType::Delete) {
-            auto remove_it = m_property_table->find(shape.m_property_key);
-            VERIFY(remove_it != m_property_table->end());
-            auto removed_offset = remove_it->value.offset;
-            m_property_table->remove(remove_it);
-            for (auto& it : *m_property_table) {
-                if (it.value.offset > removed_offset)
-                    --it.value.offset;
+        // NOTE: Prototype transitions don't affect the key map, they can just share the table.
+        if (shape.m_property_key.is_valid()) {
+            if (shape.m_transition_type == TransitionType::Put) {
+                if (!table->can_append(entry_count))
+                    table = table->clone(entry_count, capacity_for_copy());
+                table->append(shape.m_property_key, { entry_count++, shape.m_attributes });
+            } else {
+                if (table->ref_count() > 1)
+                    table = table->clone(entry_count, capacity_for_copy());
+                auto index = table->find(shape.m_property_key, entry_count);
+                VERIFY(index.has_value());
+                if (shape.m_transition_type == TransitionType::Configure) {
+                    (*table)[*index].value.attributes = shape.m_attributes;
+                } else {
+                    VERIFY(shape.m_transition_type == TransitionType::Delete);
+                    table->remove(*index);
+                    --entry_count;
+                }
             }
-            --next_offset;
         }
+        VERIFY(entry_count == shape.m_property_count);
+
+        // The shapes in between get to share the table as well, which makes it append-only from now on.
+        if (!shape.m_property_table)
+            shape.m_property_table = table;
     }
 }
 
+void Shape::ensure_property_table_is_not_shared()
+{
+    ensure_property_table();
+    if (m_property_table->ref_count() > 1 || m_property_table->size() != m_property_count)
+        m_property_table = m_property_table->clone(m_property_count, m_property_count);
+}
+
 NonnullGCPtr<Shape> Shape::create_delete_transition(StringOrSymbol const& property_key)
 {
     if (auto existing_shape = get_or_prune_cached_delete_transition(property_key))
@@ -286,10 +387,16 @@ void Shape::add_property_without_transition(StringOrSymbol const& property_key,
 {
     VERIFY(property_key.is_valid());
     ensure_property_table();
-    if (m_property_table->set(property_key, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry) {
-        VERIFY(m_property_count < NumericLimits<u32>::max());
-        ++m_property_count;
+    if (auto index = m_property_table->find(property_key, m_property_count); index.has_value()) {
+        ensure_property_table_is_not_shared();
+        (*m_property_table)[*index].value = { m_property_count, attributes };
+        return;
     }
+    VERIFY(m_property_count < NumericLimits<u32>::max());
+    if (!m_property_table->can_append(m_property_count))
+        ensure_property_table_is_not_shared();
+    m_property_table->append(property_key, { m_property_count, attributes });
+    ++m_property_count;
 }
 
 FLATTEN void Shape::add_property_without_transition(PropertyKey const& property_key, PropertyAttributes attributes)
@@ -302,23 +409,23 @@ void Shape::set_property_attributes_without_transition(StringOrSymbol const& pro
 {
     VERIFY(is_dictionary());
     VERIFY(m_property_table);
-    auto it = m_property_table->find(property_key);
-    VERIFY(it != m_property_table->end());
-    it->value.attributes = attributes;
-    m_property_table->set(property_key, it->value);
+    ensure_property_table_is_not_shared();
+    auto index = m_property_table->find(property_key, m_property_count);
+    VERIFY(index.has_value());
+    (*m_property_table)[*index].value.attributes = attributes;
 }
 
 void Shape::remove_property_without_transition(StringOrSymbol const& property_key, u32 offset)
 {
     VERIFY(is_uncacheable_dictionary());
     VERIFY(m_property_table);
-    if (m_property_table->remove(property_key))
-        --m_property_count;
-    for (auto& it : *m_property_table) {
-        VERIFY(it.value.offset != offset);
-        if (it.value.offset > offset)
-            --it.value.offset;
-    }
+    ensure_property_table_is_not_shared();
+    auto index = m_property_table->find(property_key, m_property_count);
+    if (!index.has_value())
+        return;
+    VERIFY((*m_property_table)[*index].value.offset == offset);
+    m_property_table->remove(*index);
+    --m_property_count;
 }
 
 NonnullGCPtr<Shape> Shape::create_for_prototype(NonnullGCPtr<Realm> realm, GCPtr<Object> prototype)
@@ -340,13 +447,49 @@ NonnullGCPtr<Shape> Shape::clone_for_prototype()
     new_shape->m_is_prototype_shape = true;
     new_shape->m_prototype = m_prototype;
     ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = m_property_table->clone(m_property_count, m_property_count);
+    new_shape->m_property_count = m_property_count;
     new_shape->m_prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
     return new_shape;
 }
 
+Shape::MemoryStatistics Shape::memory_statistics(Heap& heap)
+{
+    MemoryStatistics statistics;
+    HashTable<PropertyTable const*> seen_property_tables;
+
+    auto transition_table_bytes = [](auto const& transitions) -> size_t {
+        if (!transitions)
+            return 0;
+        // NOTE: Like PropertyTable::memory_usage(), this leaves out the bucket bookkeeping.
+        return sizeof(*transitions) + transitions->capacity() * (sizeof(typename RemoveCVReference<decltype(*transitions)>::KeyType) + sizeof(WeakPtr<Shape>));
+    };
+
+    cell_allocator.allocator->for_each_block([&](HeapBlock& block) {
+        if (&block.heap() != &heap)
+            return IterationDecision::Continue;
+        block.for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            auto const& shape = static_cast<Shape const&>(*cell);
+            ++statistics.shape_count;
+            statistics.shape_bytes += sizeof(Shape);
+            statistics.transition_table_bytes += transition_table_bytes(shape.m_forward_transitions);
+            statistics.transition_table_bytes += transition_table_bytes(shape.m_prototype_transitions);
+            statistics.transition_table_bytes += transition_table_bytes(shape.m_delete_transitions);
+
+            if (!shape.m_property_table)
+                return;
+            statistics.unshared_property_table_bytes += sizeof(PropertyTable) + shape.m_property_count * sizeof(PropertyTable::Entry);
+            if (seen_property_tables.set(shape.m_property_table.ptr()) == AK::HashSetResult::InsertedNewEntry) {
+                ++statistics.property_table_count;
+                statistics.property_table_bytes += shape.m_property_table->memory_usage();
+            }
+        });
+        return IterationDecision::Continue;
+    });
+
+    return statistics;
+}
+
 void Shape::set_prototype_without_transition(Object* new_prototype)
 {
     VERIFY(new_prototype);
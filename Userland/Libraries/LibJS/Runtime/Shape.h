@@ -8,6 +8,8 @@
 
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/Span.h>
 #include <AK/StringView.h>
 #include <AK/WeakPtr.h>
 #include <AK/Weakable.h>
@@ -24,6 +26,47 @@ struct PropertyMetadata {
     PropertyAttributes attributes { 0 };
 };
 
+// The properties of one or more shapes, in the order they were added. Shapes along a chain of put
+// transitions share a single table and each of them only sees the first property_count() entries, so
+// a table that is referenced by more than one shape must only ever be appended to, and only without
+// reallocating its entries.
+class PropertyTable : public RefCounted<PropertyTable> {
+public:
+    struct Entry {
+        StringOrSymbol key;
+        PropertyMetadata value;
+    };
+
+    static NonnullRefPtr<PropertyTable> create(u32 capacity = 0);
+    NonnullRefPtr<PropertyTable> clone(u32 entry_count, u32 capacity) const;
+
+    u32 size() const { return m_entries.size(); }
+
+    // Only looks at the first entry_count entries.
+    Optional<u32> find(StringOrSymbol const&, u32 entry_count) const;
+
+    Entry& operator[](u32 index) { return m_entries[index]; }
+    Entry const& operator[](u32 index) const { return m_entries[index]; }
+    ReadonlySpan<Entry> entries(u32 entry_count) const { return m_entries.span().trim(entry_count); }
+
+    bool can_append(u32 entry_count) const;
+    void append(StringOrSymbol const&, PropertyMetadata);
+    void remove(u32 index);
+
+    size_t memory_usage() const;
+
+private:
+    PropertyTable() = default;
+
+    // Small tables are searched linearly, which is faster than hashing the key for them.
+    static constexpr u32 LINEAR_SEARCH_THRESHOLD = 8;
+
+    void rebuild_index();
+
+    Vector<Entry> m_entries;
+    OwnPtr<HashMap<StringOrSymbol, u32>> m_index;
+};
+
 struct TransitionKey {
     StringOrSymbol property_key;
     PropertyAttributes attributes { 0 };
@@ -95,13 +138,21 @@ public:
     Object const* prototype() const { return m_prototype; }
 
     Optional<PropertyMetadata> lookup(StringOrSymbol const&) const;
-    OrderedHashMap<StringOrSymbol, PropertyMetadata> const& property_table() const;
+    ReadonlySpan<PropertyTable::Entry> property_table() const;
     u32 property_count() const { return m_property_count; }
 
-    struct Property {
-        StringOrSymbol key;
-        PropertyMetadata value;
+    using Property = PropertyTable::Entry;
+
+    struct MemoryStatistics {
+        size_t shape_count { 0 };
+        size_t shape_bytes { 0 };
+        size_t property_table_count { 0 };
+        size_t property_table_bytes { 0 };
+        // What the property tables would take up if every shape had its own.
+        size_t unshared_property_table_bytes { 0 };
+        size_t transition_table_bytes { 0 };
     };
+    static MemoryStatistics memory_statistics(Heap&);
 
     void set_prototype_without_transition(Object* new_prototype);
 
@@ -121,10 +172,11 @@ private:
     [[nodiscard]] GCPtr<Shape> get_or_prune_cached_delete_transition(StringOrSymbol const&);
 
     void ensure_property_table() const;
+    void ensure_property_table_is_not_shared();
 
     NonnullGCPtr<Realm> m_realm;
 
-    mutable OwnPtr<OrderedHashMap<StringOrSymbol, PropertyMetadata>> m_property_table;
+    mutable RefPtr<PropertyTable> m_property_table;
 
     OwnPtr<HashMap<TransitionKey, WeakPtr<Shape>>> m_forward_transitions;
     OwnPtr<HashMap<GCPtr<Object>, WeakPtr<Shape>>> m_prototype_transitions;
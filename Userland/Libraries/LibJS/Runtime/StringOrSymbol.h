@@ -112,6 +112,12 @@ public:
         return true;
     }
 
+    // Same as operator==, since strings are interned, but without having to look at the kinds of the keys first.
+    ALWAYS_INLINE bool is_identical_to(StringOrSymbol const& other) const
+    {
+        return m_bits == other.m_bits;
+    }
+
     StringOrSymbol& operator=(StringOrSymbol const& other)
     {
         if (this != &other) {
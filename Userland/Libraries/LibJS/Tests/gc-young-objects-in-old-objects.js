@@ -0,0 +1,53 @@
+// Allocates enough garbage to trigger a few minor collections.
+function churn() {
+    let garbage;
+    for (let i = 0; i < 100_000; ++i) garbage = { i, s: "x" + i };
+    return garbage;
+}
+
+test("young objects only reachable through old objects survive minor collections", () => {
+    class WithPrivateField {
+        #value;
+        set(value) {
+            this.#value = value;
+        }
+        get() {
+            return this.#value;
+        }
+    }
+
+    const object = {};
+    const array = [];
+    const withPrivateField = new WithPrivateField();
+    const map = new Map();
+
+    // Makes all of the above old.
+    gc();
+
+    for (let i = 0; i < 10; ++i) {
+        object["property" + i] = { i };
+        array.push({ i });
+        withPrivateField.set({ i });
+        map.set(i, { i });
+        Object.setPrototypeOf(object, { prototypeOf: i });
+        churn();
+    }
+
+    for (let i = 0; i < 10; ++i) {
+        expect(object["property" + i].i).toBe(i);
+        expect(array[i].i).toBe(i);
+        expect(map.get(i).i).toBe(i);
+    }
+    expect(withPrivateField.get().i).toBe(9);
+    expect(object.prototypeOf).toBe(9);
+});
+
+test("young strings stored in old arrays survive minor collections", () => {
+    const strings = [];
+    gc();
+    for (let i = 0; i < 10; ++i) {
+        strings[i] = "string" + i;
+        churn();
+    }
+    for (let i = 0; i < 10; ++i) expect(strings[i]).toBe("string" + i);
+});
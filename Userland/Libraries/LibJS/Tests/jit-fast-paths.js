@@ -0,0 +1,130 @@
+// These run often enough to be compiled to native code when the JIT is enabled,
+// and check that the inline fast paths agree with the interpreter at their edges.
+
+test("int32 arithmetic overflows into doubles", () => {
+    let sum = 0;
+    for (let i = 0; i < 2000; ++i) sum = sum + 2147483647;
+    expect(sum).toBe(2147483647 * 2000);
+
+    let difference = 0;
+    for (let i = 0; i < 2000; ++i) difference = difference - 2147483647;
+    expect(difference).toBe(-2147483647 * 2000);
+
+    let product = 1;
+    for (let i = 0; i < 40; ++i) product = product * 3;
+    expect(product).toBe(3 ** 40);
+
+    let counter = 2147483640;
+    for (let i = 0; i < 2000; ++i) counter++;
+    expect(counter).toBe(2147485640);
+
+    counter = -2147483640;
+    for (let i = 0; i < 2000; ++i) counter--;
+    expect(counter).toBe(-2147485640);
+});
+
+test("int32 bitwise operations", () => {
+    let value = 0;
+    for (let i = 0; i < 2000; ++i) value = (value ^ i) | (i & 0xff);
+    let expected = 0;
+    for (let i = 0; i < 2000; ++i) expected = Number(BigInt.asIntN(32, (BigInt(expected) ^ BigInt(i)) | (BigInt(i) & 0xffn)));
+    expect(value).toBe(expected);
+    expect(-1 & -1).toBe(-1);
+    expect(-1 ^ 0).toBe(-1);
+});
+
+test("mixed types take the slow path", () => {
+    const values = [1, 1.5, "2", true, null, undefined, 10n, {}];
+    const results = [];
+    for (let i = 0; i < 2000; ++i) {
+        const value = values[i % values.length];
+        if (typeof value === "bigint") continue;
+        results.push(1 + value < 3);
+    }
+    expect(results.slice(0, 7)).toEqual([true, true, false, true, true, false, false]);
+});
+
+test("comparisons of int32 and non-int32 values", () => {
+    let count = 0;
+    for (let i = -1000; i < 1000; ++i) {
+        if (i < 0) count++;
+        if (i <= 0.5) count++;
+        if (i > "10") count++;
+        if (i >= -0) count++;
+        if (i == "5") count++;
+        if (i === 5) count++;
+        if (i != 7) count++;
+        if (i !== "7") count++;
+    }
+    expect(count).toBe(1000 + 1001 + 989 + 1000 + 1 + 1 + 1999 + 2000);
+});
+
+test("property lookups when the shape changes", () => {
+    function getX(object) {
+        return object.x;
+    }
+
+    const objects = [{ x: 1 }, { y: 2, x: 3 }, Object.create({ x: 4 }), { x: "five" }];
+    let results = [];
+    for (let i = 0; i < 2000; ++i) results.push(getX(objects[i % objects.length]));
+    expect(results.slice(0, 4)).toEqual([1, 3, 4, "five"]);
+
+    const object = { x: 1 };
+    for (let i = 0; i < 2000; ++i) getX(object);
+    delete object.x;
+    expect(getX(object)).toBeUndefined();
+    object.x = 2;
+    expect(getX(object)).toBe(2);
+    expect(getX(5)).toBeUndefined();
+    expect(() => getX(null)).toThrow(TypeError);
+});
+
+test("exceptions and finally blocks", () => {
+    let log = [];
+    for (let i = 0; i < 2000; ++i) {
+        try {
+            if (i % 500 === 0) throw i;
+            if (i === 1999) break;
+            continue;
+        } catch (e) {
+            log.push(`catch ${e}`);
+        } finally {
+            if (i % 500 === 0 || i === 1999) log.push(`finally ${i}`);
+        }
+    }
+    expect(log).toEqual([
+        "catch 0",
+        "finally 0",
+        "catch 500",
+        "finally 500",
+        "catch 1000",
+        "finally 1000",
+        "catch 1500",
+        "finally 1500",
+        "finally 1999",
+    ]);
+
+    function returnFromFinally() {
+        for (let i = 0; ; ++i) {
+            try {
+                if (i === 1000) return "try";
+            } finally {
+                if (i === 1000) return "finally";
+            }
+        }
+    }
+    expect(returnFromFinally()).toBe("finally");
+});
+
+test("nullish and undefined checks", () => {
+    const values = [null, undefined, 0, "", false, NaN];
+    let nullish = 0;
+    let fallback = 0;
+    for (let i = 0; i < 2000; ++i) {
+        const value = values[i % values.length];
+        if (value == null) nullish++;
+        if ((value ?? "fallback") === "fallback") fallback++;
+    }
+    expect(nullish).toBe(668);
+    expect(fallback).toBe(668);
+});
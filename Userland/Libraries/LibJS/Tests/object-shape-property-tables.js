@@ -0,0 +1,76 @@
+// Objects built up the same way share their shapes, and shapes along a chain of transitions share
+// their property tables. These check that no shape sees properties that were added by another one.
+
+test("sibling shapes don't see each other's properties", () => {
+    const a = { x: 1 };
+    const b = { x: 1 };
+    a.y = 2;
+    b.z = 3;
+    const c = { x: 1 };
+
+    expect(Object.keys(a)).toEqual(["x", "y"]);
+    expect(Object.keys(b)).toEqual(["x", "z"]);
+    expect(Object.keys(c)).toEqual(["x"]);
+    expect(a.z).toBeUndefined();
+    expect(b.y).toBeUndefined();
+    expect(c.y).toBeUndefined();
+    expect(c.z).toBeUndefined();
+    expect("y" in c).toBeFalse();
+});
+
+test("shapes with many properties", () => {
+    const make = count => {
+        const object = {};
+        for (let i = 0; i < count; ++i) object["p" + i] = i;
+        return object;
+    };
+
+    const small = make(5);
+    const large = make(50);
+    const larger = make(100);
+    const branch = make(30);
+    branch.other = "other";
+
+    expect(Object.keys(small).length).toBe(5);
+    expect(small.p4).toBe(4);
+    expect(small.p5).toBeUndefined();
+    expect(large.p49).toBe(49);
+    expect(large.p50).toBeUndefined();
+    expect(larger.p99).toBe(99);
+    expect(branch.p29).toBe(29);
+    expect(branch.p30).toBeUndefined();
+    expect(branch.other).toBe("other");
+    expect(large.other).toBeUndefined();
+    expect(Object.keys(branch).at(-1)).toBe("other");
+});
+
+test("deleting and reconfiguring properties", () => {
+    const a = { x: 1, y: 2, z: 3 };
+    const b = { x: 1, y: 2, z: 3 };
+    delete a.y;
+    Object.defineProperty(b, "y", { enumerable: false });
+
+    expect(Object.keys(a)).toEqual(["x", "z"]);
+    expect(a.z).toBe(3);
+    expect(Object.keys(b)).toEqual(["x", "z"]);
+    expect(b.y).toBe(2);
+
+    const c = { x: 1, y: 2, z: 3 };
+    expect(Object.keys(c)).toEqual(["x", "y", "z"]);
+    c.w = 4;
+    expect(c.w).toBe(4);
+    expect(a.w).toBeUndefined();
+});
+
+test("symbol keys", () => {
+    const s1 = Symbol("s1");
+    const s2 = Symbol("s2");
+    const a = { [s1]: 1 };
+    const b = { [s1]: 1 };
+    a[s2] = 2;
+
+    expect(a[s2]).toBe(2);
+    expect(b[s2]).toBeUndefined();
+    expect(Object.getOwnPropertySymbols(a)).toEqual([s1, s2]);
+    expect(Object.getOwnPropertySymbols(b)).toEqual([s1]);
+});
@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <AK/CharacterTypes.h>
+#include <AK/Debug.h>
+#include <AK/QuickSort.h>
+#include <AK/Utf16View.h>
+#include <AK/Utf32View.h>
+#include <LibRegex/RegexDFA.h>
+
+namespace regex {
+
+// Each cache may hold about this much before it is thrown away and rebuilt from scratch.
+static constexpr size_t c_dfa_cache_memory_budget = 2 * MiB;
+
+// If the cache has to be rebuilt this often during a single run, the DFA isn't paying for itself.
+static constexpr size_t c_dfa_max_cache_clears_per_run = 4;
+
+void LazyDFA::Cache::clear()
+{
+    states.clear();
+    state_for_nodes.clear();
+    start_state.clear();
+    start_state_at_beginning.clear();
+    memory_usage = 0;
+}
+
+OwnPtr<LazyDFA> LazyDFA::try_create(ByteCode const& bytecode)
+{
+    auto dfa = adopt_own(*new LazyDFA(bytecode));
+    auto& nodes = dfa->m_nodes;
+
+    HashMap<size_t, u32> node_for_instruction;
+    Vector<size_t> instructions_to_visit;
+
+    auto node_for = [&](size_t instruction_position) -> u32 {
+        if (auto node = node_for_instruction.get(instruction_position); node.has_value())
+            return *node;
+
+        u32 index = nodes.size();
+        nodes.append({});
+        nodes.last().instruction_position = instruction_position;
+        node_for_instruction.set(instruction_position, index);
+        instructions_to_visit.append(instruction_position);
+        return index;
+    };
+
+    auto relative_target = [](size_t position, ssize_t offset) -> size_t {
+        return static_cast<size_t>(static_cast<ssize_t>(position) + offset);
+    };
+
+    dfa->m_start_node = node_for(0);
+
+    while (!instructions_to_visit.is_empty()) {
+        auto instruction_position = instructions_to_visit.take_last();
+        auto index = node_for_instruction.get(instruction_position).value();
+
+        // The backtracker treats running off the end of the bytecode as a successful match.
+        if (instruction_position >= bytecode.size()) {
+            nodes[index].kind = Node::Kind::Accept;
+            continue;
+        }
+
+        MatchState state;
+        state.instruction_position = instruction_position;
+        auto& opcode = bytecode.get_opcode(state);
+        auto next_position = instruction_position + opcode.size();
+
+        Node::Kind kind = Node::Kind::Epsilon;
+        Vector<u32, 2> next;
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Jump:
+            next.append(node_for(relative_target(next_position, static_cast<OpCode_Jump const&>(opcode).offset())));
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            next.append(node_for(relative_target(next_position, static_cast<OpCode_ForkJump const&>(opcode).offset())));
+            next.append(node_for(next_position));
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            next.append(node_for(next_position));
+            next.append(node_for(relative_target(next_position, static_cast<OpCode_ForkStay const&>(opcode).offset())));
+            break;
+        case OpCodeId::JumpNonEmpty:
+            // Whether this jumps depends on the position at the last checkpoint, so allow both.
+            next.append(node_for(relative_target(next_position, static_cast<OpCode_JumpNonEmpty const&>(opcode).offset())));
+            next.append(node_for(next_position));
+            break;
+        case OpCodeId::Repeat:
+            // Repetition counts aren't tracked, which turns x{n} into x+.
+            next.append(node_for(instruction_position - static_cast<OpCode_Repeat const&>(opcode).offset()));
+            next.append(node_for(next_position));
+            break;
+        case OpCodeId::CheckBoundary:
+            // Word boundaries depend on the previous code unit, so treat them as always passing.
+        case OpCodeId::ResetRepeat:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+            next.append(node_for(next_position));
+            break;
+        case OpCodeId::CheckBegin:
+            kind = Node::Kind::CheckBegin;
+            next.append(node_for(next_position));
+            break;
+        case OpCodeId::CheckEnd:
+            kind = Node::Kind::CheckEnd;
+            next.append(node_for(next_position));
+            break;
+        case OpCodeId::Exit:
+            kind = Node::Kind::Dead;
+            break;
+        case OpCodeId::Compare: {
+            auto const& compare = static_cast<OpCode_Compare const&>(opcode);
+            auto arguments_count = compare.arguments_count();
+            Optional<Vector<u32>> string;
+
+            size_t offset = instruction_position + 3;
+            for (size_t i = 0; i < arguments_count; ++i) {
+                switch (static_cast<CharacterCompareType>(bytecode.at(offset++))) {
+                case CharacterCompareType::Reference:
+                    return nullptr;
+                case CharacterCompareType::String: {
+                    // Strings consume more than one code unit, so they're only supported on their own,
+                    // where they can be split into a chain of single code unit compares.
+                    if (arguments_count != 1)
+                        return nullptr;
+                    auto length = bytecode.at(offset++);
+                    string = Vector<u32> {};
+                    for (size_t k = 0; k < length; ++k)
+                        string->append(static_cast<u32>(bytecode.at(offset++)));
+                    break;
+                }
+                case CharacterCompareType::LookupTable:
+                    offset += bytecode.at(offset) + 1;
+                    break;
+                case CharacterCompareType::Char:
+                case CharacterCompareType::CharClass:
+                case CharacterCompareType::CharRange:
+                case CharacterCompareType::GeneralCategory:
+                case CharacterCompareType::Property:
+                case CharacterCompareType::Script:
+                case CharacterCompareType::ScriptExtension:
+                    ++offset;
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            if (!string.has_value()) {
+                kind = Node::Kind::Compare;
+                next.append(node_for(next_position));
+                break;
+            }
+
+            auto after_string = node_for(next_position);
+            if (string->is_empty()) {
+                next.append(after_string);
+                break;
+            }
+
+            // Build the chain back to front, the first code unit is compared by this node.
+            auto following = after_string;
+            for (size_t k = string->size() - 1; k > 0; --k) {
+                Node unit_node;
+                unit_node.kind = Node::Kind::CompareUnit;
+                unit_node.instruction_position = instruction_position;
+                unit_node.unit = string->at(k);
+                unit_node.next.append(following);
+                following = nodes.size();
+                nodes.append(move(unit_node));
+            }
+            kind = Node::Kind::CompareUnit;
+            nodes[index].unit = string->first();
+            next.append(following);
+            break;
+        }
+        case OpCodeId::FailForks:
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+            // Lookaround needs to look at input that isn't consumed, which a DFA can't do.
+            return nullptr;
+        }
+
+        nodes[index].kind = kind;
+        nodes[index].next = move(next);
+    }
+
+    dbgln_if(REGEX_DEBUG, "LazyDFA: Built an NFA with {} nodes", nodes.size());
+    return dfa;
+}
+
+bool LazyDFA::prepare(Context& context, MatchInput const& input) const
+{
+    auto const& view = input.view;
+    auto options = input.regex_options;
+
+    if (options.has_flag_set(AllFlags::MatchNotBeginOfLine) || options.has_flag_set(AllFlags::MatchNotEndOfLine))
+        return false;
+
+    ViewKind view_kind;
+    if (view.is_string_view())
+        view_kind = ViewKind::StringView;
+    else if (view.is_u16_view())
+        view_kind = ViewKind::Utf16View;
+    else if (view.is_u32_view())
+        view_kind = ViewKind::Utf32View;
+    else
+        return false;
+
+    // Only work with views where every code unit is also a position the backtracker can be at.
+    if (view.unicode() && view_kind != ViewKind::Utf32View)
+        return false;
+
+    // These don't change what a Compare opcode does, no need to throw away the caches for them.
+    for (auto flag : { AllFlags::Global, AllFlags::Sticky, AllFlags::SingleMatch, AllFlags::SkipSubExprResults, AllFlags::SkipTrimEmptyMatches, AllFlags::StringCopyMatches, AllFlags::Internal_Stateful })
+        options.reset_flag(flag);
+
+    if (options.value() != context.options.value() || view_kind != context.view_kind || view.unicode() != context.unicode) {
+        context.options = options;
+        context.view_kind = view_kind;
+        context.unicode = view.unicode();
+        // With these, ^ and $ also match around line terminators in the middle of the view.
+        context.line_anchors_always_pass = options.has_flag_set(AllFlags::Multiline) && options.has_flag_set(AllFlags::Internal_ConsiderNewline);
+        context.anchored.clear();
+        context.unanchored.clear();
+    }
+
+    return true;
+}
+
+LazyDFA::Result LazyDFA::search(Context& context, MatchInput const& input, size_t start_position) const
+{
+    return run(context, input, start_position, false);
+}
+
+LazyDFA::Result LazyDFA::match_at(Context& context, MatchInput const& input, size_t position) const
+{
+    return run(context, input, position, true);
+}
+
+LazyDFA::Result LazyDFA::run(Context& context, MatchInput const& input, size_t position, bool anchored) const
+{
+    if (!prepare(context, input))
+        return Result::GaveUp;
+
+    auto const& view = input.view;
+    auto length = view.length_in_code_units();
+    if (position > length)
+        return Result::GaveUp;
+
+    auto& cache = anchored ? context.anchored : context.unanchored;
+    size_t clears = 0;
+
+    auto state_index = start_state(context, cache, position == 0);
+    if (!state_index.has_value()) {
+        cache.clear();
+        state_index = start_state(context, cache, position == 0);
+        if (!state_index.has_value())
+            return Result::GaveUp;
+    }
+
+    for (auto i = position;; ++i) {
+        auto const& state = *cache.states[*state_index];
+        if (state.is_accepting)
+            return Result::MayMatch;
+        if (state.nodes.is_empty())
+            return Result::NoMatch;
+        if (i == length)
+            return accepts_at_end(context, state, i == 0) ? Result::MayMatch : Result::NoMatch;
+
+        auto code_unit = view.code_unit_at(i);
+        // Without the unicode flag, the backtracker still reads surrogate pairs as one code point in places.
+        if (context.view_kind == ViewKind::Utf16View && is_unicode_surrogate(code_unit))
+            return Result::GaveUp;
+
+        auto next_index = transition(context, cache, *state_index, code_unit, anchored);
+        if (!next_index.has_value()) {
+            if (++clears > c_dfa_max_cache_clears_per_run)
+                return Result::GaveUp;
+
+            auto nodes = state.nodes;
+            cache.clear();
+            state_index = intern_state(cache, move(nodes));
+            if (!state_index.has_value())
+                return Result::GaveUp;
+            next_index = transition(context, cache, *state_index, code_unit, anchored);
+            if (!next_index.has_value())
+                return Result::GaveUp;
+        }
+        state_index = next_index;
+    }
+}
+
+Optional<u32> LazyDFA::start_state(Context const& context, Cache& cache, bool at_beginning) const
+{
+    auto& start_state = at_beginning ? cache.start_state_at_beginning : cache.start_state;
+    if (start_state.has_value())
+        return start_state;
+
+    Vector<u32> nodes;
+    Vector<bool> seen;
+    seen.resize(m_nodes.size());
+    add_closure(context, nodes, seen, m_start_node, at_beginning, false);
+    start_state = intern_state(cache, move(nodes));
+    return start_state;
+}
+
+Optional<u32> LazyDFA::transition(Context const& context, Cache& cache, u32 state_index, u32 code_unit, bool anchored) const
+{
+    auto& state = *cache.states[state_index];
+    if (code_unit < state.narrow_transitions.size()) {
+        if (auto next = state.narrow_transitions[code_unit]; next != unknown_state)
+            return next;
+    } else if (auto next = state.wide_transitions.get(code_unit); next.has_value()) {
+        return *next;
+    }
+
+    Vector<u32> nodes;
+    Vector<bool> seen;
+    seen.resize(m_nodes.size());
+    for (auto node_index : state.nodes) {
+        auto const& node = m_nodes[node_index];
+        if (node.kind != Node::Kind::Compare && node.kind != Node::Kind::CompareUnit)
+            continue;
+        if (node_matches(context, node, code_unit))
+            add_closure(context, nodes, seen, node.next.first(), false, false);
+    }
+
+    // A match may start at any position, so the next state always includes the start of the pattern as well.
+    if (!anchored)
+        add_closure(context, nodes, seen, m_start_node, false, false);
+
+    auto next = intern_state(cache, move(nodes));
+    if (!next.has_value())
+        return {};
+
+    if (code_unit < state.narrow_transitions.size()) {
+        state.narrow_transitions[code_unit] = *next;
+    } else {
+        state.wide_transitions.set(code_unit, *next);
+        cache.memory_usage += sizeof(u32) * 4;
+    }
+    return next;
+}
+
+Optional<u32> LazyDFA::intern_state(Cache& cache, Vector<u32>&& nodes) const
+{
+    quick_sort(nodes);
+    if (auto existing = cache.state_for_nodes.get(nodes); existing.has_value())
+        return *existing;
+
+    auto memory_usage = sizeof(State) + nodes.size() * sizeof(u32) * 2;
+    if (cache.memory_usage + memory_usage > c_dfa_cache_memory_budget)
+        return {};
+    cache.memory_usage += memory_usage;
+
+    auto state = make<State>();
+    state->nodes = nodes;
+    state->narrow_transitions.fill(unknown_state);
+    state->is_accepting = any_of(nodes, [&](auto node) { return m_nodes[node].kind == Node::Kind::Accept; });
+
+    u32 index = cache.states.size();
+    cache.states.append(move(state));
+    cache.state_for_nodes.set(move(nodes), index);
+    return index;
+}
+
+bool LazyDFA::accepts_at_end(Context const& context, State const& state, bool at_beginning) const
+{
+    if (state.is_accepting)
+        return true;
+
+    Vector<u32> nodes;
+    Vector<bool> seen;
+    seen.resize(m_nodes.size());
+    for (auto node_index : state.nodes) {
+        if (m_nodes[node_index].kind == Node::Kind::CheckEnd)
+            add_closure(context, nodes, seen, node_index, at_beginning, true);
+    }
+    return any_of(nodes, [&](auto node) { return m_nodes[node].kind == Node::Kind::Accept; });
+}
+
+void LazyDFA::add_closure(Context const& context, Vector<u32>& nodes, Vector<bool>& seen, u32 start_node, bool at_beginning, bool at_end) const
+{
+    Vector<u32, 16> nodes_to_visit;
+    nodes_to_visit.append(start_node);
+
+    while (!nodes_to_visit.is_empty()) {
+        auto node_index = nodes_to_visit.take_last();
+        if (seen[node_index])
+            continue;
+        seen[node_index] = true;
+
+        auto const& node = m_nodes[node_index];
+        switch (node.kind) {
+        case Node::Kind::Epsilon:
+            nodes_to_visit.extend(node.next);
+            break;
+        case Node::Kind::CheckBegin:
+            if (at_beginning || context.line_anchors_always_pass)
+                nodes_to_visit.extend(node.next);
+            break;
+        case Node::Kind::CheckEnd:
+            // Whether this passes is only known once the end of the input is reached, so keep it around until then.
+            if (at_end || context.line_anchors_always_pass)
+                nodes_to_visit.extend(node.next);
+            else
+                nodes.append(node_index);
+            break;
+        case Node::Kind::Compare:
+        case Node::Kind::CompareUnit:
+        case Node::Kind::Accept:
+            nodes.append(node_index);
+            break;
+        case Node::Kind::Dead:
+            break;
+        }
+    }
+}
+
+bool LazyDFA::node_matches(Context const& context, Node const& node, u32 code_unit) const
+{
+    if (node.kind == Node::Kind::Compare)
+        return evaluate_compare(context, node.instruction_position, code_unit);
+
+    if (code_unit == node.unit)
+        return true;
+    if (!context.options.has_flag_set(AllFlags::Insensitive))
+        return false;
+    // Case-insensitive string compares outside of ASCII use full case folding, just let the backtracker decide.
+    if (!is_ascii(code_unit) || !is_ascii(node.unit))
+        return true;
+    return to_ascii_lowercase(code_unit) == to_ascii_lowercase(node.unit);
+}
+
+bool LazyDFA::evaluate_compare(Context const& context, size_t instruction_position, u32 code_unit) const
+{
+    char narrow_unit = static_cast<char>(code_unit);
+    u16 utf16_unit = static_cast<u16>(code_unit);
+
+    MatchInput input;
+    input.regex_options = context.options;
+    switch (context.view_kind) {
+    case ViewKind::StringView:
+        input.view = StringView { &narrow_unit, 1 };
+        break;
+    case ViewKind::Utf16View:
+        input.view = Utf16View { ReadonlySpan<u16> { &utf16_unit, 1 } };
+        break;
+    case ViewKind::Utf32View:
+        input.view = Utf32View { &code_unit, 1 };
+        break;
+    }
+    input.view.set_unicode(context.unicode);
+
+    MatchState state;
+    state.instruction_position = instruction_position;
+    auto& opcode = m_bytecode->get_opcode(state);
+    auto result = opcode.execute(input, state);
+    return result == ExecutionResult::Continue && state.string_position == 1;
+}
+
+}
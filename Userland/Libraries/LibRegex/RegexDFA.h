@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+#include "RegexOptions.h"
+
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// A lazily built DFA over the bytecode of a pattern, used to find out quickly whether a match is possible at all.
+//
+// The NFA is read straight out of the bytecode when the pattern is compiled: forks and jumps become epsilon
+// transitions, and Compare opcodes consume one code unit. DFA states are sets of NFA nodes, and are only built
+// (and then cached in a LazyDFA::Context) once the input actually reaches them. Anything whose outcome depends on more than the current code unit (repetition counters,
+// empty-loop checks, word boundaries, line anchors in multiline mode) is over-approximated, so the DFA may accept
+// input that the backtracker will reject but never the other way around. Patterns with backreferences or lookaround
+// can't be represented at all.
+class LazyDFA {
+public:
+    enum class Result {
+        NoMatch,
+        MayMatch,
+        GaveUp,
+    };
+
+    class Context;
+
+    static OwnPtr<LazyDFA> try_create(ByteCode const&);
+
+    void set_bytecode(ByteCode const& bytecode) { m_bytecode = &bytecode; }
+
+    // Whether a match could start anywhere in the view at or after the given position.
+    Result search(Context&, MatchInput const&, size_t start_position) const;
+
+    // Whether a match could start at exactly the given position.
+    Result match_at(Context&, MatchInput const&, size_t position) const;
+
+private:
+    struct Node {
+        enum class Kind : u8 {
+            Epsilon,
+            Compare,
+            CompareUnit,
+            CheckBegin,
+            CheckEnd,
+            Accept,
+            Dead,
+        };
+
+        Kind kind { Kind::Dead };
+        size_t instruction_position { 0 };
+        u32 unit { 0 };
+        Vector<u32, 2> next;
+    };
+
+    struct NodeSetTraits : public DefaultTraits<Vector<u32>> {
+        static unsigned hash(Vector<u32> const& nodes) { return Traits<ReadonlySpan<u32>>::hash(nodes.span()); }
+        static bool equals(Vector<u32> const& a, Vector<u32> const& b) { return a == b; }
+    };
+
+    static constexpr u32 unknown_state = NumericLimits<u32>::max();
+
+    struct State {
+        Vector<u32> nodes;
+        bool is_accepting { false };
+        AK::Array<u32, 256> narrow_transitions;
+        HashMap<u32, u32> wide_transitions;
+    };
+
+    struct Cache {
+        Vector<NonnullOwnPtr<State>> states;
+        HashMap<Vector<u32>, u32, NodeSetTraits> state_for_nodes;
+        Optional<u32> start_state;
+        Optional<u32> start_state_at_beginning;
+        size_t memory_usage { 0 };
+
+        void clear();
+    };
+
+    enum class ViewKind : u8 {
+        StringView,
+        Utf16View,
+        Utf32View,
+    };
+
+public:
+    // The DFA states built during one match call. The LazyDFA itself doesn't change once it has been created,
+    // so matches that run at the same time only have to use a context each.
+    class Context {
+    private:
+        friend class LazyDFA;
+
+        // Compare opcodes are evaluated by running them on a view that holds just the code unit in question,
+        // so their results depend on the options and the kind of view. The caches are dropped when either changes.
+        AllOptions options {};
+        ViewKind view_kind { ViewKind::StringView };
+        bool unicode { false };
+        bool line_anchors_always_pass { false };
+
+        Cache anchored;
+        Cache unanchored;
+    };
+
+private:
+    explicit LazyDFA(ByteCode const& bytecode)
+        : m_bytecode(&bytecode)
+    {
+    }
+
+    bool prepare(Context&, MatchInput const&) const;
+    Result run(Context&, MatchInput const&, size_t position, bool anchored) const;
+    Optional<u32> start_state(Context const&, Cache&, bool at_beginning) const;
+    Optional<u32> transition(Context const&, Cache&, u32 state_index, u32 code_unit, bool anchored) const;
+    Optional<u32> intern_state(Cache&, Vector<u32>&& nodes) const;
+    bool accepts_at_end(Context const&, State const&, bool at_beginning) const;
+
+    void add_closure(Context const&, Vector<u32>& nodes, Vector<bool>& seen, u32 node, bool at_beginning, bool at_end) const;
+    bool node_matches(Context const&, Node const&, u32 code_unit) const;
+    bool evaluate_compare(Context const&, size_t instruction_position, u32 code_unit) const;
+
+    ByteCode const* m_bytecode { nullptr };
+    Vector<Node> m_nodes;
+    u32 m_start_node { 0 };
+};
+
+}
@@ -51,5 +51,6 @@ enum __RegexAllFlags {
     __Regex_Internal_BrowserExtended = __Regex_Global << 17,     // Internal flag; enable browser-specific ECMA262 extensions.
     __Regex_Internal_ConsiderNewline = __Regex_Global << 18,     // Internal flag; allow matchers to consider newlines as line separators.
     __Regex_Internal_ECMA262DotSemantics = __Regex_Global << 19, // Internal flag; use ECMA262 semantics for dot ('.') - disallow CR/LF/LS/PS instead of just CR.
-    __Regex_Last = __Regex_Internal_ECMA262DotSemantics,
+    __Regex_Internal_DisableLazyDFA = __Regex_Global << 20,      // Internal flag; always use the backtracking matcher.
+    __Regex_Last = __Regex_Internal_DisableLazyDFA,
 };
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "RegexLiteralSearcher.h"
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/CharacterTypes.h>
+#include <AK/SIMDExtras.h>
+#include <string.h>
+
+namespace regex {
+
+using AK::SIMD::u8x16;
+
+static u8x16 splat(u8 byte)
+{
+    u8x16 vector;
+    for (size_t i = 0; i < AK::SIMD::vector_length<u8x16>; ++i)
+        vector[i] = byte;
+    return vector;
+}
+
+static u8 fold(u8 byte, CaseSensitivity case_sensitivity)
+{
+    return case_sensitivity == CaseSensitivity::CaseInsensitive ? to_ascii_lowercase(byte) : byte;
+}
+
+Optional<LiteralSearcher> LiteralSearcher::create(Vector<ByteString> literals)
+{
+    if (literals.is_empty() || literals.size() > NumericLimits<u32>::max())
+        return {};
+    return LiteralSearcher(move(literals));
+}
+
+LiteralSearcher::LiteralSearcher(Vector<ByteString> literals)
+    : m_literals(move(literals))
+{
+    m_shortest_length = m_literals.first().length();
+    for (size_t i = 0; i < m_literals.size(); ++i) {
+        m_shortest_length = min(m_shortest_length, m_literals[i].length());
+        if (m_literals[i].is_empty() && !m_empty_literal_index.has_value())
+            m_empty_literal_index = i;
+    }
+
+    build_anchors(CaseSensitivity::CaseInsensitive);
+    build_anchors(CaseSensitivity::CaseSensitive);
+}
+
+void LiteralSearcher::build_anchors(CaseSensitivity case_sensitivity)
+{
+    auto& anchors = m_anchors[to_underlying(case_sensitivity)];
+
+    auto add_byte = [&](AK::Array<bool, 256>& set, u8 byte) {
+        set[byte] = true;
+        if (case_sensitivity == CaseSensitivity::CaseInsensitive && is_ascii_alpha(byte)) {
+            set[to_ascii_lowercase(byte)] = true;
+            set[to_ascii_uppercase(byte)] = true;
+        }
+    };
+
+    auto to_vectors = [](AK::Array<bool, 256> const& set, AK::Array<u8x16, max_vectorized_anchor_bytes>& vectors) -> Optional<size_t> {
+        size_t count = 0;
+        for (size_t byte = 0; byte < set.size(); ++byte) {
+            if (!set[byte])
+                continue;
+            if (count == vectors.size())
+                return {};
+            vectors[count++] = splat(byte);
+        }
+        return count;
+    };
+
+    for (auto const& literal : m_literals) {
+        if (!literal.is_empty())
+            add_byte(anchors.is_first_byte, literal[0]);
+    }
+
+    if (auto count = to_vectors(anchors.is_first_byte, anchors.first_bytes); count.has_value()) {
+        anchors.vectorized = true;
+        anchors.first_byte_count = *count;
+
+        // With a single literal, also checking its last byte weeds out most false candidates for free.
+        if (m_literals.size() == 1 && m_shortest_length >= 2) {
+            AK::Array<bool, 256> is_last_byte {};
+            add_byte(is_last_byte, m_literals.first()[m_shortest_length - 1]);
+            anchors.last_byte_count = to_vectors(is_last_byte, anchors.last_bytes).value_or(0);
+        }
+    }
+
+    AK::Array<u32, 257> bucket_sizes {};
+    for (auto const& literal : m_literals) {
+        if (!literal.is_empty())
+            ++bucket_sizes[fold(literal[0], case_sensitivity)];
+    }
+    for (size_t byte = 0; byte < 256; ++byte)
+        anchors.bucket_start[byte + 1] = anchors.bucket_start[byte] + bucket_sizes[byte];
+
+    anchors.literal_indices.resize(anchors.bucket_start[256]);
+    bucket_sizes.fill(0);
+    for (size_t i = 0; i < m_literals.size(); ++i) {
+        if (m_literals[i].is_empty())
+            continue;
+        auto byte = fold(m_literals[i][0], case_sensitivity);
+        anchors.literal_indices[anchors.bucket_start[byte] + bucket_sizes[byte]++] = i;
+    }
+}
+
+Optional<size_t> LiteralSearcher::literal_at(u8 const* data, size_t size, size_t position, CaseSensitivity case_sensitivity) const
+{
+    auto const& anchors = m_anchors[to_underlying(case_sensitivity)];
+    auto byte = fold(data[position], case_sensitivity);
+
+    for (auto i = anchors.bucket_start[byte]; i < anchors.bucket_start[byte + 1]; ++i) {
+        auto index = anchors.literal_indices[i];
+        auto const& literal = m_literals[index];
+        if (size - position < literal.length())
+            continue;
+
+        if (case_sensitivity == CaseSensitivity::CaseSensitive) {
+            if (memcmp(data + position, literal.characters(), literal.length()) == 0)
+                return index;
+        } else {
+            StringView candidate { data + position, literal.length() };
+            if (candidate.equals_ignoring_ascii_case(literal))
+                return index;
+        }
+    }
+    return {};
+}
+
+Optional<LiteralSearcher::Occurrence> LiteralSearcher::find(StringView haystack, size_t start, CaseSensitivity case_sensitivity) const
+{
+    auto size = haystack.length();
+    if (start > size)
+        return {};
+    if (m_empty_literal_index.has_value())
+        return Occurrence { start, *m_empty_literal_index };
+    if (size - start < m_shortest_length)
+        return {};
+
+    auto const& anchors = m_anchors[to_underlying(case_sensitivity)];
+    auto const* data = reinterpret_cast<u8 const*>(haystack.characters_without_null_termination());
+    auto position = start;
+
+    if (anchors.vectorized) {
+        auto last_byte_offset = anchors.last_byte_count != 0 ? m_shortest_length - 1 : 0;
+
+        for (; size - position >= last_byte_offset + sizeof(u8x16); position += sizeof(u8x16)) {
+            auto chunk = AK::SIMD::load_unaligned<u8x16>(data + position);
+            auto mask = chunk == anchors.first_bytes[0];
+            for (size_t i = 1; i < anchors.first_byte_count; ++i)
+                mask |= chunk == anchors.first_bytes[i];
+
+            if (anchors.last_byte_count != 0) {
+                auto last_chunk = AK::SIMD::load_unaligned<u8x16>(data + position + last_byte_offset);
+                auto last_mask = last_chunk == anchors.last_bytes[0];
+                for (size_t i = 1; i < anchors.last_byte_count; ++i)
+                    last_mask |= last_chunk == anchors.last_bytes[i];
+                mask &= last_mask;
+            }
+
+            // Every lane is either all ones or all zeroes, so each candidate shows up as a whole byte of set bits.
+            u64 halves[2];
+            __builtin_memcpy(halves, &mask, sizeof(halves));
+            for (size_t half = 0; half < 2; ++half) {
+                for (auto bits = halves[half]; bits != 0;) {
+                    auto lane = count_trailing_zeroes(bits) / 8;
+                    bits &= ~(0xffull << (lane * 8));
+
+                    auto candidate = position + half * 8 + lane;
+                    if (auto index = literal_at(data, size, candidate, case_sensitivity); index.has_value())
+                        return Occurrence { candidate, *index };
+                }
+            }
+        }
+    }
+
+    for (; size - position >= m_shortest_length; ++position) {
+        if (!anchors.is_first_byte[data[position]])
+            continue;
+        if (auto index = literal_at(data, size, position, case_sensitivity); index.has_value())
+            return Occurrence { position, *index };
+    }
+
+    return {};
+}
+
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/ByteString.h>
+#include <AK/Optional.h>
+#include <AK/SIMD.h>
+#include <AK/StringUtils.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// Finds the leftmost occurrence of any of a set of byte strings.
+//
+// Candidate positions are found 16 bytes at a time by comparing against the first bytes of the literals (and, for a
+// single literal, its last byte too), similar to a vectorized memchr. With too many distinct first bytes for that to
+// pay off, it falls back to a byte-at-a-time scan through a lookup table. Candidates are then verified against the
+// literals that start with that byte. Case-insensitive searches only fold ASCII, as the matcher does.
+class LiteralSearcher {
+public:
+    struct Occurrence {
+        size_t offset { 0 };
+        size_t literal_index { 0 };
+    };
+
+    static Optional<LiteralSearcher> create(Vector<ByteString> literals);
+
+    Optional<Occurrence> find(StringView haystack, size_t start, CaseSensitivity = CaseSensitivity::CaseSensitive) const;
+
+    Vector<ByteString> const& literals() const { return m_literals; }
+
+private:
+    explicit LiteralSearcher(Vector<ByteString> literals);
+
+    static constexpr size_t max_vectorized_anchor_bytes = 4;
+
+    struct Anchors {
+        AK::Array<bool, 256> is_first_byte {};
+        AK::Array<AK::SIMD::u8x16, max_vectorized_anchor_bytes> first_bytes {};
+        AK::Array<AK::SIMD::u8x16, max_vectorized_anchor_bytes> last_bytes {};
+        size_t first_byte_count { 0 };
+        size_t last_byte_count { 0 };
+        bool vectorized { false };
+
+        // Indices of the literals, grouped by their (possibly case-folded) first byte.
+        AK::Array<u32, 257> bucket_start {};
+        Vector<u32> literal_indices;
+    };
+
+    void build_anchors(CaseSensitivity);
+    Optional<size_t> literal_at(u8 const* data, size_t size, size_t position, CaseSensitivity) const;
+
+    Vector<ByteString> m_literals;
+    size_t m_shortest_length { 0 };
+    Optional<size_t> m_empty_literal_index;
+    Anchors m_anchors[2];
+};
+
+}
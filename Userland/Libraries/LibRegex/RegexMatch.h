@@ -67,6 +67,16 @@ public:
         return m_view.has<StringView>();
     }
 
+    bool is_u16_view() const
+    {
+        return m_view.has<Utf16View>();
+    }
+
+    bool is_u32_view() const
+    {
+        return m_view.has<Utf32View>();
+    }
+
     StringView string_view() const
     {
         return m_view.get<StringView>();
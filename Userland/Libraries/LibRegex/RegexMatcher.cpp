@@ -99,6 +99,19 @@ ByteString Regex<Parser>::error_string(Optional<ByteString> message) const
     return eb.to_byte_string();
 }
 
+template<typename Parser>
+Matcher<Parser>::Matcher(Regex<Parser> const* pattern, Optional<typename ParserTraits<Parser>::OptionsType> regex_options)
+    : m_pattern(pattern)
+    , m_regex_options(regex_options.value_or({}))
+{
+    // A plain substring search is already as fast as it gets.
+    if (!m_pattern->parser_result.optimization_data.pure_substring_search.has_value())
+        m_dfa = LazyDFA::try_create(m_pattern->parser_result.bytecode);
+
+    if (auto const& literal = m_pattern->parser_result.optimization_data.required_literal; literal.has_value())
+        m_literal_searcher = LiteralSearcher::create({ *literal });
+}
+
 template<typename Parser>
 RegexResult Matcher<Parser>::match(RegexStringView view, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
 {
@@ -184,6 +197,10 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         continue_search = false;
 
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
+    auto use_lazy_dfa = m_dfa && !input.regex_options.has_flag_set(AllFlags::Internal_DisableLazyDFA);
+    LazyDFA::Context dfa_context;
+    auto literal_case_sensitivity = input.regex_options.has_flag_set(AllFlags::Insensitive) ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive;
+    auto literal_is_prefix = m_pattern->parser_result.optimization_data.required_literal_is_prefix;
 
     for (auto const& view : views) {
         if (lines_to_skip != 0) {
@@ -200,7 +217,26 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         state.string_position_in_code_units = view_index;
         bool succeeded = false;
 
-        if (view_index == view_length && m_pattern->parser_result.match_length_minimum == 0) {
+        // Every match contains the required literal (if there is one), so the next occurrence of it bounds where
+        // a match can start. The literal is made up of bytes, so this only works on byte strings.
+        auto use_literal_searcher = m_literal_searcher.has_value() && view.is_string_view() && !view.unicode();
+        Optional<size_t> next_literal_offset;
+        auto find_next_literal = [&] {
+            auto occurrence = m_literal_searcher->find(view.string_view(), view_index, literal_case_sensitivity);
+            next_literal_offset = occurrence.map([](auto& occurrence) { return occurrence.offset; });
+        };
+
+        bool may_match = true;
+        if (use_literal_searcher) {
+            find_next_literal();
+            may_match = next_literal_offset.has_value();
+        }
+
+        // When the lazy DFA can rule out a match anywhere in this view, there's no need to run the backtracker at all.
+        if (may_match && use_lazy_dfa)
+            may_match = m_dfa->search(dfa_context, input, view_index) != LazyDFA::Result::NoMatch;
+
+        if (may_match && view_index == view_length && m_pattern->parser_result.match_length_minimum == 0) {
             // Run the code until it tries to consume something.
             // This allows non-consuming code to run on empty strings, for instance
             // e.g. "Exit"
@@ -231,7 +267,7 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             }
         }
 
-        for (; view_index <= view_length; ++view_index) {
+        for (; may_match && view_index <= view_length; ++view_index) {
             if (view_index == view_length && input.regex_options.has_flag_set(AllFlags::Multiline))
                 break;
 
@@ -245,6 +281,27 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             if (match_length_minimum && match_length_minimum > view_length - view_index)
                 break;
 
+            if (use_literal_searcher) {
+                if (next_literal_offset.has_value() && *next_literal_offset < view_index)
+                    find_next_literal();
+                if (!next_literal_offset.has_value())
+                    break;
+
+                if (literal_is_prefix && *next_literal_offset != view_index) {
+                    if (!continue_search)
+                        break;
+                    // Skip straight to the next occurrence (the loop increments view_index once more).
+                    view_index = *next_literal_offset - 1;
+                    continue;
+                }
+            }
+
+            if (use_lazy_dfa && m_dfa->match_at(dfa_context, input, view_index) == LazyDFA::Result::NoMatch) {
+                if (!continue_search)
+                    break;
+                continue;
+            }
+
             input.column = match_count;
             input.match_index = match_count;
 
@@ -7,6 +7,8 @@
 #pragma once
 
 #include "RegexByteCode.h"
+#include "RegexDFA.h"
+#include "RegexLiteralSearcher.h"
 #include "RegexMatch.h"
 #include "RegexOptions.h"
 #include "RegexParser.h"
@@ -52,11 +54,7 @@ template<class Parser>
 class Matcher final {
 
 public:
-    Matcher(Regex<Parser> const* pattern, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {})
-        : m_pattern(pattern)
-        , m_regex_options(regex_options.value_or({}))
-    {
-    }
+    Matcher(Regex<Parser> const* pattern, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {});
     ~Matcher() = default;
 
     RegexResult match(RegexStringView, Optional<typename ParserTraits<Parser>::OptionsType> = {}) const;
@@ -70,6 +68,8 @@ public:
     void reset_pattern(Badge<Regex<Parser>>, Regex<Parser> const* pattern)
     {
         m_pattern = pattern;
+        if (m_dfa)
+            m_dfa->set_bytecode(pattern->parser_result.bytecode);
     }
 
 private:
@@ -77,6 +77,8 @@ private:
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+    OwnPtr<LazyDFA> m_dfa;
+    Optional<LiteralSearcher> m_literal_searcher;
 };
 
 template<class Parser>
@@ -232,6 +234,7 @@ private:
     void run_optimization_passes();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
+    void find_required_literal();
 };
 
 // free standing functions for match, search and has_match
@@ -29,14 +29,18 @@ void Regex<Parser>::run_optimization_passes()
     parser_result.bytecode.flatten();
 
     auto blocks = split_basic_blocks(parser_result.bytecode);
-    if (attempt_rewrite_entire_match_as_substring_search(blocks))
+    if (attempt_rewrite_entire_match_as_substring_search(blocks)) {
+        find_required_literal();
         return;
+    }
 
     // Rewrite fork loops as atomic groups
     // e.g. a*b -> (ATOMIC a*)b
     attempt_rewrite_loops_as_atomic_groups(blocks);
 
     parser_result.bytecode.flatten();
+
+    find_required_literal();
 }
 
 template<typename Parser>
@@ -572,6 +576,133 @@ bool Regex<Parser>::attempt_rewrite_entire_match_as_substring_search(BasicBlockL
     return true;
 }
 
+template<typename Parser>
+void Regex<Parser>::find_required_literal()
+{
+    auto& bytecode = parser_result.bytecode;
+    auto bytecode_size = bytecode.size();
+    auto is_unicode = parser_result.options.has_flag_set(AllFlags::Unicode);
+
+    // An instruction is on every path through the pattern unless some forward jump or fork skips over it.
+    // Backward jumps don't matter, as whatever they jump back to has to get past the instruction again.
+    Vector<int> skip_count_changes;
+    skip_count_changes.resize(bytecode_size + 1);
+
+    MatchState state;
+    while (state.instruction_position < bytecode_size) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto next_position = state.instruction_position + opcode.size();
+
+        ssize_t offset = 0;
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Jump:
+            offset = static_cast<OpCode_Jump const&>(opcode).offset();
+            break;
+        case OpCodeId::JumpNonEmpty:
+            offset = static_cast<OpCode_JumpNonEmpty const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            offset = static_cast<OpCode_ForkJump const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            offset = static_cast<OpCode_ForkStay const&>(opcode).offset();
+            break;
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+        case OpCodeId::Exit:
+            // Lookaround moves the string position around behind our back.
+            return;
+        default:
+            break;
+        }
+
+        if (offset > 0) {
+            ++skip_count_changes[next_position];
+            --skip_count_changes[min(next_position + offset, bytecode_size)];
+        }
+        state.instruction_position = next_position;
+    }
+
+    // Runs of single-character compares on every path are matched one after another the first time they're reached,
+    // so every match contains them as a literal. If nothing consumes anything before a run, every match starts with it.
+    StringBuilder run;
+    bool run_is_prefix = false;
+    bool seen_compare = false;
+    ByteString longest;
+    ByteString prefix;
+
+    auto finish_run = [&] {
+        if (run.is_empty())
+            return;
+        auto literal = run.to_byte_string();
+        if (run_is_prefix)
+            prefix = literal;
+        if (literal.length() > longest.length())
+            longest = literal;
+        run.clear();
+    };
+
+    int skip_count = 0;
+    state.instruction_position = 0;
+    while (state.instruction_position < bytecode_size) {
+        auto& opcode = bytecode.get_opcode(state);
+        for (auto position = state.instruction_position; position < state.instruction_position + opcode.size(); ++position)
+            skip_count += skip_count_changes[position];
+        auto is_on_every_path = skip_count == 0;
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto& compare = static_cast<OpCode_Compare const&>(opcode);
+            auto extends_run = is_on_every_path && compare.arguments_count() == 1;
+            auto flat_compares = compare.flat_compares();
+            for (auto& flat_compare : flat_compares) {
+                if (flat_compare.type != CharacterCompareType::Char || flat_compare.value > (is_unicode ? 0x7f : 0xff))
+                    extends_run = false;
+            }
+
+            if (!extends_run) {
+                finish_run();
+            } else {
+                if (run.is_empty())
+                    run_is_prefix = !seen_compare;
+                for (auto& flat_compare : flat_compares)
+                    run.append(bit_cast<char>(static_cast<u8>(flat_compare.value)));
+            }
+            seen_compare = true;
+            break;
+        }
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+        case OpCodeId::ResetRepeat:
+        case OpCodeId::Checkpoint:
+            // These don't consume anything, so they don't break up a run.
+            break;
+        default:
+            finish_run();
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+    finish_run();
+
+    // A prefix tells us exactly where a match can start, so prefer it unless it's much less selective.
+    if (!prefix.is_empty() && (prefix.length() >= 3 || prefix.length() >= longest.length())) {
+        parser_result.optimization_data.required_literal = move(prefix);
+        parser_result.optimization_data.required_literal_is_prefix = true;
+    } else if (!longest.is_empty()) {
+        parser_result.optimization_data.required_literal = move(longest);
+    }
+}
+
 template<typename Parser>
 void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const& basic_blocks)
 {
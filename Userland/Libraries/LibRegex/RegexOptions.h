@@ -36,6 +36,7 @@ enum class AllFlags {
     Internal_BrowserExtended = __Regex_Internal_BrowserExtended,         // Only for ECMA262, Enable the behaviors defined in section B.1.4. of the ECMA262 spec.
     Internal_ConsiderNewline = __Regex_Internal_ConsiderNewline,         // Only for ECMA262, Allow multiline matches to consider newlines as line boundaries.
     Internal_ECMA262DotSemantics = __Regex_Internal_ECMA262DotSemantics, // Use ECMA262 dot semantics: disallow matching CR/LF/LS/PS instead of just CR.
+    Internal_DisableLazyDFA = __Regex_Internal_DisableLazyDFA,           // Never use the lazy DFA, only the backtracking matcher.
     Last = Internal_BrowserExtended,
 };
 
@@ -58,6 +58,8 @@ public:
 
         struct {
             Optional<ByteString> pure_substring_search;
+            Optional<ByteString> required_literal;
+            bool required_literal_is_prefix { false };
         } optimization_data {};
     };
 
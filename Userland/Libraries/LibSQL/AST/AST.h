@@ -703,6 +703,7 @@ public:
     }
 
     NonnullRefPtr<Expression> const& expression() const { return m_expression; }
+    virtual ResultOr<Value> evaluate(ExecutionContext&) const override;
 
 private:
     NonnullRefPtr<Expression> m_expression;
@@ -831,6 +832,41 @@ private:
     bool m_is_error_if_table_exists;
 };
 
+class CreateIndex : public Statement {
+public:
+    struct IndexedColumn {
+        ByteString column_name;
+        Order order { Order::Ascending };
+    };
+
+    CreateIndex(ByteString schema_name, ByteString index_name, ByteString table_name, Vector<IndexedColumn> indexed_columns, bool is_unique, bool is_error_if_index_exists)
+        : m_schema_name(move(schema_name))
+        , m_index_name(move(index_name))
+        , m_table_name(move(table_name))
+        , m_indexed_columns(move(indexed_columns))
+        , m_is_unique(is_unique)
+        , m_is_error_if_index_exists(is_error_if_index_exists)
+    {
+    }
+
+    ByteString const& schema_name() const { return m_schema_name; }
+    ByteString const& index_name() const { return m_index_name; }
+    ByteString const& table_name() const { return m_table_name; }
+    Vector<IndexedColumn> const& indexed_columns() const { return m_indexed_columns; }
+    bool is_unique() const { return m_is_unique; }
+    bool is_error_if_index_exists() const { return m_is_error_if_index_exists; }
+
+    ResultOr<ResultSet> execute(ExecutionContext&) const override;
+
+private:
+    ByteString m_schema_name;
+    ByteString m_index_name;
+    ByteString m_table_name;
+    Vector<IndexedColumn> m_indexed_columns;
+    bool m_is_unique;
+    bool m_is_error_if_index_exists;
+};
+
 class AlterTable : public Statement {
 public:
     ByteString const& schema_name() const { return m_schema_name; }
@@ -1107,4 +1143,18 @@ private:
     NonnullRefPtr<QualifiedTableName> m_qualified_table_name;
 };
 
+class Explain : public Statement {
+public:
+    explicit Explain(NonnullRefPtr<Statement> statement)
+        : m_statement(move(statement))
+    {
+    }
+
+    NonnullRefPtr<Statement> const& statement() const { return m_statement; }
+    ResultOr<ResultSet> execute(ExecutionContext&) const override;
+
+private:
+    NonnullRefPtr<Statement> m_statement;
+};
+
 }
@@ -5,6 +5,7 @@
  */
 
 #include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/QueryPlan.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Meta.h>
 #include <LibSQL/Row.h>
@@ -17,10 +18,16 @@ ResultOr<ResultSet> Delete::execute(ExecutionContext& context) const
     auto const& table_name = m_qualified_table_name->table_name();
     auto table_def = TRY(context.database->get_table(schema_name, table_name));
 
-    ResultSet result { SQLCommand::Delete };
+    Vector<Row> matched_rows;
+
+    // Removing rows while walking through them would pull the ground from under our feet.
+    auto access_path = TRY(plan_table_access(context, table_def, where_clause()));
+    while (true) {
+        auto table_row = TRY(access_path->next_row(context));
+        if (!table_row.has_value())
+            break;
 
-    for (auto& table_row : TRY(context.database->select_all(*table_def))) {
-        context.current_row = &table_row;
+        context.current_row = &table_row.value();
 
         if (auto const& where_clause = this->where_clause()) {
             auto where_result = TRY(where_clause->evaluate(context)).to_bool();
@@ -28,6 +35,12 @@ ResultOr<ResultSet> Delete::execute(ExecutionContext& context) const
                 continue;
         }
 
+        TRY(matched_rows.try_append(table_row.release_value()));
+    }
+
+    ResultSet result { SQLCommand::Delete };
+
+    for (auto& table_row : matched_rows) {
         TRY(context.database->remove(table_row));
 
         // FIXME: Implement the RETURNING clause.
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/QueryPlan.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/ResultSet.h>
+
+namespace SQL::AST {
+
+static ResultOr<void> explain_select(ExecutionContext& context, Select const& select, Vector<ByteString>& lines)
+{
+    size_t depth = 0;
+
+    if (select.limit_clause())
+        lines.append(ByteString::formatted("{}Limit", ByteString::repeated(' ', 2 * depth++)));
+
+    if (!select.ordering_term_list().is_empty()) {
+        StringBuilder builder;
+        builder.append(ByteString::repeated(' ', 2 * depth++));
+        builder.append("Sort BY "sv);
+        for (size_t i = 0; i < select.ordering_term_list().size(); ++i) {
+            auto const& term = select.ordering_term_list()[i];
+            if (i > 0)
+                builder.append(", "sv);
+            builder.append(expression_to_string(term->expression()));
+            if (term->order() == Order::Descending)
+                builder.append(" DESC"sv);
+        }
+        lines.append(builder.to_byte_string());
+    }
+
+    auto plan = TRY(plan_select(context, select));
+    plan->explain(lines, depth);
+    return {};
+}
+
+static ResultOr<void> explain_table_access(ExecutionContext& context, StringView operation, QualifiedTableName const& qualified_table_name, RefPtr<Expression> const& where_clause, Vector<ByteString>& lines)
+{
+    auto table_def = TRY(context.database->get_table(qualified_table_name.schema_name(), qualified_table_name.table_name()));
+    lines.append(ByteString::formatted("{} {}.{}", operation, table_def->parent()->name(), table_def->name()));
+
+    auto access_path = TRY(plan_table_access(context, table_def, where_clause));
+    if (!where_clause) {
+        access_path->explain(lines, 1);
+        return {};
+    }
+
+    lines.append(ByteString::formatted("  Filter WHERE {}", expression_to_string(*where_clause)));
+    access_path->explain(lines, 2);
+    return {};
+}
+
+ResultOr<ResultSet> Explain::execute(ExecutionContext& context) const
+{
+    Vector<ByteString> lines;
+
+    if (is<Select>(*m_statement)) {
+        TRY(explain_select(context, static_cast<Select const&>(*m_statement), lines));
+    } else if (is<Update>(*m_statement)) {
+        auto const& update = static_cast<Update const&>(*m_statement);
+        TRY(explain_table_access(context, "Update"sv, update.qualified_table_name(), update.where_clause(), lines));
+    } else if (is<Delete>(*m_statement)) {
+        auto const& delete_statement = static_cast<Delete const&>(*m_statement);
+        TRY(explain_table_access(context, "Delete"sv, delete_statement.qualified_table_name(), delete_statement.where_clause(), lines));
+    } else {
+        return Result { SQLCommand::Explain, SQLErrorCode::NotYetImplemented, "Only SELECT, UPDATE, and DELETE statements can be explained"sv };
+    }
+
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    descriptor->append({ "", "", "plan", SQLType::Text, Order::Ascending });
+
+    ResultSet result { SQLCommand::Explain, { "plan" } };
+    TRY(result.try_ensure_capacity(lines.size()));
+
+    for (auto& line : lines) {
+        Tuple tuple(descriptor);
+        tuple[0] = move(line);
+        result.insert_row(tuple, Tuple {});
+    }
+
+    return result;
+}
+
+}
@@ -241,4 +241,17 @@ ResultOr<Value> MatchExpression::evaluate(ExecutionContext& context) const
     }
 }
 
+ResultOr<Value> BetweenExpression::evaluate(ExecutionContext& context) const
+{
+    auto value = TRY(expression()->evaluate(context));
+    auto lower_bound = TRY(lhs()->evaluate(context));
+    auto upper_bound = TRY(rhs()->evaluate(context));
+
+    if (value.is_null() || lower_bound.is_null() || upper_bound.is_null())
+        return Value {};
+
+    auto is_between = value.compare(lower_bound) >= 0 && value.compare(upper_bound) <= 0;
+    return Value { invert_expression() ? !is_between : is_between };
+}
+
 }
@@ -51,6 +51,10 @@ ResultOr<ResultSet> Insert::execute(ExecutionContext& context) const
             row[element_index] = move(values[ix]);
         }
 
+        // The row is reused for every set of values, so it must not look like the row inserted last.
+        row.set_block_index(0);
+        TRY(context.database->check_unique_constraints(row));
+
         TRY(context.database->insert(row));
         result.insert_row(row, {});
     }
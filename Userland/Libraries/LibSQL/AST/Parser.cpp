@@ -41,8 +41,9 @@ NonnullRefPtr<Statement> Parser::parse_statement()
         consume();
         if (match(TokenType::Schema))
             return parse_create_schema_statement();
-        else
-            return parse_create_table_statement();
+        if (match(TokenType::Unique) || match(TokenType::Index))
+            return parse_create_index_statement();
+        return parse_create_table_statement();
     case TokenType::Alter:
         return parse_alter_table_statement();
     case TokenType::Drop:
@@ -57,8 +58,10 @@ NonnullRefPtr<Statement> Parser::parse_statement()
         return parse_delete_statement({});
     case TokenType::Select:
         return parse_select_statement({});
+    case TokenType::Explain:
+        return parse_explain_statement();
     default:
-        expected("CREATE, ALTER, DROP, DESCRIBE, INSERT, UPDATE, DELETE, or SELECT"sv);
+        expected("CREATE, ALTER, DROP, DESCRIBE, EXPLAIN, INSERT, UPDATE, DELETE, or SELECT"sv);
         return create_ast_node<ErrorStatement>();
     }
 }
@@ -129,6 +132,41 @@ NonnullRefPtr<CreateTable> Parser::parse_create_table_statement()
     return create_ast_node<CreateTable>(move(schema_name), move(table_name), move(column_definitions), is_temporary, is_error_if_table_exists);
 }
 
+NonnullRefPtr<CreateIndex> Parser::parse_create_index_statement()
+{
+    // https://sqlite.org/lang_createindex.html
+    bool is_unique = consume_if(TokenType::Unique);
+    consume(TokenType::Index);
+
+    bool is_error_if_index_exists = true;
+    if (consume_if(TokenType::If)) {
+        consume(TokenType::Not);
+        consume(TokenType::Exists);
+        is_error_if_index_exists = false;
+    }
+
+    ByteString schema_name;
+    ByteString index_name;
+    parse_schema_and_table_name(schema_name, index_name);
+
+    consume(TokenType::On);
+    ByteString table_name = consume(TokenType::Identifier).value();
+
+    Vector<CreateIndex::IndexedColumn> indexed_columns;
+    parse_comma_separated_list(true, [&]() {
+        CreateIndex::IndexedColumn column { consume(TokenType::Identifier).value() };
+        if (consume_if(TokenType::Desc))
+            column.order = Order::Descending;
+        else
+            consume_if(TokenType::Asc);
+        indexed_columns.append(move(column));
+    });
+
+    // FIXME: Parse the "WHERE" clause of partial indexes.
+
+    return create_ast_node<CreateIndex>(move(schema_name), move(index_name), move(table_name), move(indexed_columns), is_unique, is_error_if_index_exists);
+}
+
 NonnullRefPtr<AlterTable> Parser::parse_alter_table_statement()
 {
     // https://sqlite.org/lang_altertable.html
@@ -194,6 +232,18 @@ NonnullRefPtr<DescribeTable> Parser::parse_describe_table_statement()
     return create_ast_node<DescribeTable>(move(table_name));
 }
 
+NonnullRefPtr<Explain> Parser::parse_explain_statement()
+{
+    // https://sqlite.org/eqp.html
+    consume(TokenType::Explain);
+
+    // We only know how to explain the query plan, so that is what we do even if it wasn't asked for.
+    if (consume_if(TokenType::Query))
+        consume(TokenType::Plan);
+
+    return create_ast_node<Explain>(parse_statement());
+}
+
 NonnullRefPtr<Insert> Parser::parse_insert_statement(RefPtr<CommonTableExpressionList> common_table_expression_list)
 {
     // https://sqlite.org/lang_insert.html
@@ -389,6 +439,11 @@ RefPtr<CommonTableExpressionList> Parser::parse_common_table_expression_list()
 }
 
 NonnullRefPtr<Expression> Parser::parse_expression()
+{
+    return parse_expression(0);
+}
+
+NonnullRefPtr<Expression> Parser::parse_expression(int minimum_precedence)
 {
     if (++m_parser_state.m_current_expression_depth > Limits::maximum_expression_tree_depth) {
         syntax_error(ByteString::formatted("Exceeded maximum expression tree depth of {}", Limits::maximum_expression_tree_depth));
@@ -398,7 +453,9 @@ NonnullRefPtr<Expression> Parser::parse_expression()
     // https://sqlite.org/lang_expr.html
     auto expression = parse_primary_expression();
 
-    if (match_secondary_expression())
+    // Secondary expressions bind to the expression on their left for as long as their operator
+    // binds more tightly than the one we are parsing the right-hand side of.
+    while (match_secondary_expression() && secondary_expression_precedence() >= minimum_precedence)
         expression = parse_secondary_expression(move(expression));
 
     // FIXME: Parse 'function-name'.
@@ -490,6 +547,39 @@ NonnullRefPtr<Expression> Parser::parse_secondary_expression(NonnullRefPtr<Expre
     return create_ast_node<ErrorExpression>();
 }
 
+int Parser::secondary_expression_precedence() const
+{
+    switch (m_parser_state.m_token.type()) {
+    case TokenType::Collate:
+        return Precedence::Collate;
+    case TokenType::DoublePipe:
+        return Precedence::Concatenate;
+    case TokenType::Asterisk:
+    case TokenType::Divide:
+    case TokenType::Modulus:
+        return Precedence::Multiplicative;
+    case TokenType::Plus:
+    case TokenType::Minus:
+        return Precedence::Additive;
+    case TokenType::ShiftLeft:
+    case TokenType::ShiftRight:
+    case TokenType::Ampersand:
+    case TokenType::Pipe:
+        return Precedence::Bitwise;
+    case TokenType::LessThan:
+    case TokenType::LessThanEquals:
+    case TokenType::GreaterThan:
+    case TokenType::GreaterThanEquals:
+        return Precedence::Comparison;
+    case TokenType::And:
+        return Precedence::And;
+    case TokenType::Or:
+        return Precedence::Or;
+    default:
+        return Precedence::Equality;
+    }
+}
+
 bool Parser::match_secondary_expression() const
 {
     return match(TokenType::Not)
@@ -602,19 +692,19 @@ RefPtr<Expression> Parser::parse_column_name_expression(Optional<ByteString> wit
 RefPtr<Expression> Parser::parse_unary_operator_expression()
 {
     if (consume_if(TokenType::Minus))
-        return create_ast_node<UnaryOperatorExpression>(UnaryOperator::Minus, parse_expression());
+        return create_ast_node<UnaryOperatorExpression>(UnaryOperator::Minus, parse_expression(Precedence::Collate));
 
     if (consume_if(TokenType::Plus))
-        return create_ast_node<UnaryOperatorExpression>(UnaryOperator::Plus, parse_expression());
+        return create_ast_node<UnaryOperatorExpression>(UnaryOperator::Plus, parse_expression(Precedence::Collate));
 
     if (consume_if(TokenType::Tilde))
-        return create_ast_node<UnaryOperatorExpression>(UnaryOperator::BitwiseNot, parse_expression());
+        return create_ast_node<UnaryOperatorExpression>(UnaryOperator::BitwiseNot, parse_expression(Precedence::Collate));
 
     if (consume_if(TokenType::Not)) {
         if (match(TokenType::Exists))
             return parse_exists_expression(true);
         else
-            return create_ast_node<UnaryOperatorExpression>(UnaryOperator::Not, parse_expression());
+            return create_ast_node<UnaryOperatorExpression>(UnaryOperator::Not, parse_expression(Precedence::Equality));
     }
 
     return {};
@@ -623,58 +713,58 @@ RefPtr<Expression> Parser::parse_unary_operator_expression()
 RefPtr<Expression> Parser::parse_binary_operator_expression(NonnullRefPtr<Expression> lhs)
 {
     if (consume_if(TokenType::DoublePipe))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Concatenate, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Concatenate, move(lhs), parse_expression(Precedence::Concatenate + 1));
 
     if (consume_if(TokenType::Asterisk))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Multiplication, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Multiplication, move(lhs), parse_expression(Precedence::Multiplicative + 1));
 
     if (consume_if(TokenType::Divide))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Division, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Division, move(lhs), parse_expression(Precedence::Multiplicative + 1));
 
     if (consume_if(TokenType::Modulus))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Modulo, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Modulo, move(lhs), parse_expression(Precedence::Multiplicative + 1));
 
     if (consume_if(TokenType::Plus))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Plus, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Plus, move(lhs), parse_expression(Precedence::Additive + 1));
 
     if (consume_if(TokenType::Minus))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Minus, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Minus, move(lhs), parse_expression(Precedence::Additive + 1));
 
     if (consume_if(TokenType::ShiftLeft))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::ShiftLeft, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::ShiftLeft, move(lhs), parse_expression(Precedence::Bitwise + 1));
 
     if (consume_if(TokenType::ShiftRight))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::ShiftRight, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::ShiftRight, move(lhs), parse_expression(Precedence::Bitwise + 1));
 
     if (consume_if(TokenType::Ampersand))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::BitwiseAnd, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::BitwiseAnd, move(lhs), parse_expression(Precedence::Bitwise + 1));
 
     if (consume_if(TokenType::Pipe))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::BitwiseOr, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::BitwiseOr, move(lhs), parse_expression(Precedence::Bitwise + 1));
 
     if (consume_if(TokenType::LessThan))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::LessThan, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::LessThan, move(lhs), parse_expression(Precedence::Comparison + 1));
 
     if (consume_if(TokenType::LessThanEquals))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::LessThanEquals, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::LessThanEquals, move(lhs), parse_expression(Precedence::Comparison + 1));
 
     if (consume_if(TokenType::GreaterThan))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::GreaterThan, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::GreaterThan, move(lhs), parse_expression(Precedence::Comparison + 1));
 
     if (consume_if(TokenType::GreaterThanEquals))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::GreaterThanEquals, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::GreaterThanEquals, move(lhs), parse_expression(Precedence::Comparison + 1));
 
     if (consume_if(TokenType::Equals) || consume_if(TokenType::EqualsEquals))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Equals, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Equals, move(lhs), parse_expression(Precedence::Equality + 1));
 
     if (consume_if(TokenType::NotEquals1) || consume_if(TokenType::NotEquals2))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::NotEquals, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::NotEquals, move(lhs), parse_expression(Precedence::Equality + 1));
 
     if (consume_if(TokenType::And))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::And, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::And, move(lhs), parse_expression(Precedence::And + 1));
 
     if (consume_if(TokenType::Or))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Or, move(lhs), parse_expression());
+        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Or, move(lhs), parse_expression(Precedence::Or + 1));
 
     return {};
 }
@@ -780,7 +870,7 @@ RefPtr<Expression> Parser::parse_is_expression(NonnullRefPtr<Expression> express
         invert_expression = true;
     }
 
-    auto rhs = parse_expression();
+    auto rhs = parse_expression(Precedence::Equality + 1);
     return create_ast_node<IsExpression>(move(expression), move(rhs), invert_expression);
 }
 
@@ -789,31 +879,31 @@ RefPtr<Expression> Parser::parse_match_expression(NonnullRefPtr<Expression> lhs,
     auto parse_escape = [this]() {
         RefPtr<Expression> escape;
         if (consume_if(TokenType::Escape)) {
-            escape = parse_expression();
+            escape = parse_expression(Precedence::Equality + 1);
         }
         return escape;
     };
 
     if (consume_if(TokenType::Like)) {
-        NonnullRefPtr<Expression> rhs = parse_expression();
+        NonnullRefPtr<Expression> rhs = parse_expression(Precedence::Equality + 1);
         RefPtr<Expression> escape = parse_escape();
         return create_ast_node<MatchExpression>(MatchOperator::Like, move(lhs), move(rhs), move(escape), invert_expression);
     }
 
     if (consume_if(TokenType::Glob)) {
-        NonnullRefPtr<Expression> rhs = parse_expression();
+        NonnullRefPtr<Expression> rhs = parse_expression(Precedence::Equality + 1);
         RefPtr<Expression> escape = parse_escape();
         return create_ast_node<MatchExpression>(MatchOperator::Glob, move(lhs), move(rhs), move(escape), invert_expression);
     }
 
     if (consume_if(TokenType::Match)) {
-        NonnullRefPtr<Expression> rhs = parse_expression();
+        NonnullRefPtr<Expression> rhs = parse_expression(Precedence::Equality + 1);
         RefPtr<Expression> escape = parse_escape();
         return create_ast_node<MatchExpression>(MatchOperator::Match, move(lhs), move(rhs), move(escape), invert_expression);
     }
 
     if (consume_if(TokenType::Regexp)) {
-        NonnullRefPtr<Expression> rhs = parse_expression();
+        NonnullRefPtr<Expression> rhs = parse_expression(Precedence::Equality + 1);
         RefPtr<Expression> escape = parse_escape();
         return create_ast_node<MatchExpression>(MatchOperator::Regexp, move(lhs), move(rhs), move(escape), invert_expression);
     }
@@ -839,19 +929,11 @@ RefPtr<Expression> Parser::parse_between_expression(NonnullRefPtr<Expression> ex
 
     consume();
 
-    auto nested = parse_expression();
-    if (!is<BinaryOperatorExpression>(*nested)) {
-        expected("Binary Expression"sv);
-        return create_ast_node<ErrorExpression>();
-    }
-
-    auto const& binary_expression = static_cast<BinaryOperatorExpression const&>(*nested);
-    if (binary_expression.type() != BinaryOperator::And) {
-        expected("AND Expression"sv);
-        return create_ast_node<ErrorExpression>();
-    }
+    auto lhs = parse_expression(Precedence::Equality + 1);
+    consume(TokenType::And);
+    auto rhs = parse_expression(Precedence::Equality + 1);
 
-    return create_ast_node<BetweenExpression>(move(expression), binary_expression.lhs(), binary_expression.rhs(), invert_expression);
+    return create_ast_node<BetweenExpression>(move(expression), move(lhs), move(rhs), invert_expression);
 }
 
 RefPtr<Expression> Parser::parse_in_expression(NonnullRefPtr<Expression> expression, bool invert_expression)
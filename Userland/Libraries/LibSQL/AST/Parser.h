@@ -15,6 +15,19 @@
 
 namespace SQL::AST {
 
+namespace Precedence {
+// https://sqlite.org/lang_expr.html#operators_and_parse_affecting_attributes
+constexpr int Or = 1;
+constexpr int And = 2;
+constexpr int Equality = 3;
+constexpr int Comparison = 4;
+constexpr int Bitwise = 5;
+constexpr int Additive = 6;
+constexpr int Multiplicative = 7;
+constexpr int Concatenate = 8;
+constexpr int Collate = 9;
+}
+
 namespace Limits {
 // https://www.sqlite.org/limits.html
 constexpr size_t maximum_expression_tree_depth = 1000;
@@ -60,18 +73,22 @@ private:
     NonnullRefPtr<Statement> parse_statement_with_expression_list(RefPtr<CommonTableExpressionList>);
     NonnullRefPtr<CreateSchema> parse_create_schema_statement();
     NonnullRefPtr<CreateTable> parse_create_table_statement();
+    NonnullRefPtr<CreateIndex> parse_create_index_statement();
     NonnullRefPtr<AlterTable> parse_alter_table_statement();
     NonnullRefPtr<DropTable> parse_drop_table_statement();
     NonnullRefPtr<DescribeTable> parse_describe_table_statement();
+    NonnullRefPtr<Explain> parse_explain_statement();
     NonnullRefPtr<Insert> parse_insert_statement(RefPtr<CommonTableExpressionList>);
     NonnullRefPtr<Update> parse_update_statement(RefPtr<CommonTableExpressionList>);
     NonnullRefPtr<Delete> parse_delete_statement(RefPtr<CommonTableExpressionList>);
     NonnullRefPtr<Select> parse_select_statement(RefPtr<CommonTableExpressionList>);
     RefPtr<CommonTableExpressionList> parse_common_table_expression_list();
 
+    NonnullRefPtr<Expression> parse_expression(int minimum_precedence);
     NonnullRefPtr<Expression> parse_primary_expression();
     NonnullRefPtr<Expression> parse_secondary_expression(NonnullRefPtr<Expression> primary);
     bool match_secondary_expression() const;
+    int secondary_expression_precedence() const;
     RefPtr<Expression> parse_literal_value_expression();
     RefPtr<Expression> parse_bind_parameter_expression();
     RefPtr<Expression> parse_column_name_expression(Optional<ByteString> with_parsed_identifier = {}, bool with_parsed_period = false);
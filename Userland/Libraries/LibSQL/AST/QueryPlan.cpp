@@ -0,0 +1,850 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <AK/Function.h>
+#include <AK/StringBuilder.h>
+#include <LibSQL/AST/QueryPlan.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Meta.h>
+#include <math.h>
+
+namespace SQL::AST {
+
+// Without statistics, we assume that every table is this large. This is what makes
+// the planner prefer an index over scanning the table whenever it can use one.
+static constexpr double assumed_table_rows = 1'000'000;
+
+static constexpr size_t max_tables_in_join = 64;
+
+static NonnullRefPtr<TupleDescriptor> concatenate_descriptors(TupleDescriptor const& left, TupleDescriptor const& right)
+{
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    for (auto const& element : left)
+        descriptor->append(element);
+    for (auto const& element : right)
+        descriptor->append(element);
+    return descriptor;
+}
+
+static Tuple combine_rows(NonnullRefPtr<TupleDescriptor> const& descriptor, Tuple const& left, Tuple const& right)
+{
+    // Assigning the values one by one keeps the tuple on the descriptor of the join.
+    Tuple row(descriptor);
+    for (size_t i = 0; i < left.size(); ++i)
+        row[i] = left[i];
+    for (size_t i = 0; i < right.size(); ++i)
+        row[left.size() + i] = right[i];
+    return row;
+}
+
+static ResultOr<bool> evaluate_condition(ExecutionContext& context, Expression const& condition, Tuple& row)
+{
+    context.current_row = &row;
+    auto result = TRY(condition.evaluate(context)).to_bool();
+    return result.has_value() && result.value();
+}
+
+void QueryPlanNode::append_explain_line(Vector<ByteString>& lines, size_t depth, StringView description) const
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < depth; ++i)
+        builder.append("  "sv);
+    builder.appendff("{} (rows={}, cost={})", description, static_cast<u64>(ceil(m_estimated_rows)), static_cast<u64>(ceil(m_estimated_cost)));
+    lines.append(builder.to_byte_string());
+}
+
+SingleRow::SingleRow()
+    : QueryPlanNode(adopt_ref(*new TupleDescriptor), 1, 1)
+{
+}
+
+ResultOr<Optional<Tuple>> SingleRow::next(ExecutionContext&)
+{
+    if (m_done)
+        return Optional<Tuple> {};
+
+    m_done = true;
+    return Optional<Tuple> { Tuple { descriptor() } };
+}
+
+void SingleRow::explain(Vector<ByteString>& lines, size_t depth) const
+{
+    append_explain_line(lines, depth, "SingleRow"sv);
+}
+
+TableAccess::TableAccess(NonnullRefPtr<TableDef> table, double estimated_rows, double estimated_cost)
+    : QueryPlanNode(table->to_tuple_descriptor(), estimated_rows, estimated_cost)
+    , m_table(move(table))
+{
+}
+
+ResultOr<Optional<Tuple>> TableAccess::next(ExecutionContext& context)
+{
+    auto row = TRY(next_row(context));
+    if (!row.has_value())
+        return Optional<Tuple> {};
+
+    // Stored rows don't know the name of their table, but the plan needs it to tell apart columns of different tables.
+    Tuple tuple(descriptor());
+    for (size_t i = 0; i < row->size(); ++i)
+        tuple[i] = (*row)[i];
+    return Optional<Tuple> { move(tuple) };
+}
+
+TableScan::TableScan(NonnullRefPtr<TableDef> table, double estimated_rows)
+    : TableAccess(move(table), estimated_rows, estimated_rows)
+{
+}
+
+ResultOr<Optional<Row>> TableScan::next_row(ExecutionContext& context)
+{
+    if (!m_started) {
+        m_started = true;
+        m_next_block_index = m_table->block_index();
+    }
+
+    if (m_next_block_index == 0)
+        return Optional<Row> {};
+
+    auto row = TRY(context.database->read_row(*m_table, m_next_block_index));
+    m_next_block_index = row.next_block_index();
+    return Optional<Row> { move(row) };
+}
+
+void TableScan::explain(Vector<ByteString>& lines, size_t depth) const
+{
+    append_explain_line(lines, depth, ByteString::formatted("TableScan {}.{}", m_table->parent()->name(), m_table->name()));
+}
+
+IndexScan::IndexScan(NonnullRefPtr<TableDef> table, NonnullRefPtr<IndexDef> index, Range range, double estimated_rows, double estimated_cost)
+    : TableAccess(move(table), estimated_rows, estimated_cost)
+    , m_index(move(index))
+    , m_range(move(range))
+{
+}
+
+ResultOr<Optional<Row>> IndexScan::next_row(ExecutionContext& context)
+{
+    if (!m_tree) {
+        m_tree = TRY(context.database->get_index_tree(*m_index));
+
+        if (m_range.lower_bound.has_value())
+            m_iterator = m_tree->lower_bound(Database::make_index_prefix(*m_index, { &m_range.lower_bound.value(), 1 }));
+        else
+            m_iterator = m_tree->begin();
+
+        if (m_range.upper_bound.has_value())
+            m_upper_bound = Database::make_index_prefix(*m_index, { &m_range.upper_bound.value(), 1 });
+    }
+
+    while (!m_iterator->is_end()) {
+        auto const& entry = **m_iterator;
+        if (m_upper_bound.has_value() && entry.compare(*m_upper_bound) > 0)
+            break;
+
+        auto block_index = entry.block_index();
+        ++*m_iterator;
+
+        // Entries of removed rows stay behind in the index with a null pointer.
+        if (block_index == 0)
+            continue;
+
+        return Optional<Row> { TRY(context.database->read_row(*m_table, block_index)) };
+    }
+
+    return Optional<Row> {};
+}
+
+void IndexScan::explain(Vector<ByteString>& lines, size_t depth) const
+{
+    StringBuilder builder;
+    builder.appendff("IndexScan {}.{} USING {} WHERE ", m_table->parent()->name(), m_table->name(), m_index->name());
+    for (size_t i = 0; i < m_range.conditions.size(); ++i) {
+        if (i > 0)
+            builder.append(" AND "sv);
+        builder.append(expression_to_string(m_range.conditions[i]));
+    }
+    append_explain_line(lines, depth, builder.string_view());
+}
+
+Filter::Filter(NonnullOwnPtr<QueryPlanNode> child, Vector<NonnullRefPtr<Expression>> conditions, double estimated_rows)
+    : QueryPlanNode(child->descriptor(), estimated_rows, child->estimated_cost() + child->estimated_rows())
+    , m_child(move(child))
+    , m_conditions(move(conditions))
+{
+}
+
+ResultOr<Optional<Tuple>> Filter::next(ExecutionContext& context)
+{
+    while (true) {
+        auto row = TRY(m_child->next(context));
+        if (!row.has_value())
+            return Optional<Tuple> {};
+
+        bool matches = true;
+        for (auto const& condition : m_conditions) {
+            if (!TRY(evaluate_condition(context, condition, row.value()))) {
+                matches = false;
+                break;
+            }
+        }
+
+        if (matches)
+            return row;
+    }
+}
+
+void Filter::explain(Vector<ByteString>& lines, size_t depth) const
+{
+    StringBuilder builder;
+    builder.append("Filter WHERE "sv);
+    for (size_t i = 0; i < m_conditions.size(); ++i) {
+        if (i > 0)
+            builder.append(" AND "sv);
+        builder.append(expression_to_string(m_conditions[i]));
+    }
+    append_explain_line(lines, depth, builder.string_view());
+    m_child->explain(lines, depth + 1);
+}
+
+NestedLoopJoin::NestedLoopJoin(NonnullOwnPtr<QueryPlanNode> left, NonnullOwnPtr<QueryPlanNode> right, double estimated_rows, double estimated_cost)
+    : QueryPlanNode(concatenate_descriptors(left->descriptor(), right->descriptor()), estimated_rows, estimated_cost)
+    , m_left(move(left))
+    , m_right(move(right))
+{
+}
+
+ResultOr<Optional<Tuple>> NestedLoopJoin::next(ExecutionContext& context)
+{
+    if (!m_right_rows_read) {
+        while (true) {
+            auto row = TRY(m_right->next(context));
+            if (!row.has_value())
+                break;
+            TRY(m_right_rows.try_append(row.release_value()));
+        }
+        m_right_rows_read = true;
+    }
+
+    if (m_right_rows.is_empty())
+        return Optional<Tuple> {};
+
+    while (!m_left_row.has_value() || m_right_row_index == m_right_rows.size()) {
+        m_left_row = TRY(m_left->next(context));
+        if (!m_left_row.has_value())
+            return Optional<Tuple> {};
+        m_right_row_index = 0;
+    }
+
+    return Optional<Tuple> { combine_rows(descriptor(), m_left_row.value(), m_right_rows[m_right_row_index++]) };
+}
+
+void NestedLoopJoin::explain(Vector<ByteString>& lines, size_t depth) const
+{
+    append_explain_line(lines, depth, "NestedLoopJoin"sv);
+    m_left->explain(lines, depth + 1);
+    m_right->explain(lines, depth + 1);
+}
+
+HashJoin::HashJoin(NonnullOwnPtr<QueryPlanNode> left, NonnullOwnPtr<QueryPlanNode> right, NonnullRefPtr<Expression> condition, NonnullRefPtr<Expression> left_key, NonnullRefPtr<Expression> right_key, bool is_numeric_key, double estimated_rows, double estimated_cost)
+    : QueryPlanNode(concatenate_descriptors(left->descriptor(), right->descriptor()), estimated_rows, estimated_cost)
+    , m_left(move(left))
+    , m_right(move(right))
+    , m_condition(move(condition))
+    , m_left_key(move(left_key))
+    , m_right_key(move(right_key))
+    , m_is_numeric_key(is_numeric_key)
+{
+}
+
+// Returns the value rows are bucketed by, or nothing if the row can't match any other row.
+ResultOr<Optional<Value>> HashJoin::evaluate_key(ExecutionContext& context, Expression const& key, Tuple& row) const
+{
+    context.current_row = &row;
+    auto value = TRY(key.evaluate(context));
+    if (value.is_null())
+        return Optional<Value> {};
+    if (!m_is_numeric_key)
+        return Optional<Value> { move(value) };
+
+    // Numbers compare equal to each other after rounding, so that is what we bucket them by.
+    // Numbers too large to round can only ever match each other, and are kept apart.
+    if (auto number = value.to_int<i64>(); number.has_value())
+        return Optional<Value> { Value { number.value() } };
+    return Optional<Value> { move(value) };
+}
+
+ResultOr<Optional<Tuple>> HashJoin::next(ExecutionContext& context)
+{
+    if (!m_right_rows_read) {
+        while (true) {
+            auto row = TRY(m_right->next(context));
+            if (!row.has_value())
+                break;
+
+            auto key = TRY(evaluate_key(context, m_right_key, row.value()));
+            if (!key.has_value())
+                continue;
+
+            if (key->type() == SQLType::Float)
+                TRY(m_unbucketed_rows.try_append(m_right_rows.size()));
+            else
+                TRY(m_buckets.ensure(key->hash()).try_append(m_right_rows.size()));
+
+            TRY(m_right_keys.try_append(key.release_value()));
+            TRY(m_right_rows.try_append(row.release_value()));
+        }
+        m_right_rows_read = true;
+    }
+
+    if (m_right_rows.is_empty())
+        return Optional<Tuple> {};
+
+    while (true) {
+        while (m_matches && m_match_index < m_matches->size()) {
+            auto right_index = m_matches->at(m_match_index++);
+
+            // Keys that have been rounded are exact, so most other rows of the bucket can be ruled out cheaply.
+            if (m_left_key_value->type() != SQLType::Float && m_left_key_value->compare(m_right_keys[right_index]) != 0)
+                continue;
+
+            auto row = combine_rows(descriptor(), m_left_row.value(), m_right_rows[right_index]);
+            if (TRY(evaluate_condition(context, m_condition, row)))
+                return Optional<Tuple> { move(row) };
+        }
+
+        m_matches = nullptr;
+        m_left_row = TRY(m_left->next(context));
+        if (!m_left_row.has_value())
+            return Optional<Tuple> {};
+
+        m_left_key_value = TRY(evaluate_key(context, m_left_key, m_left_row.value()));
+        if (!m_left_key_value.has_value())
+            continue;
+
+        m_match_index = 0;
+        if (m_left_key_value->type() == SQLType::Float)
+            m_matches = &m_unbucketed_rows;
+        else if (auto bucket = m_buckets.find(m_left_key_value->hash()); bucket != m_buckets.end())
+            m_matches = &bucket->value;
+    }
+}
+
+void HashJoin::explain(Vector<ByteString>& lines, size_t depth) const
+{
+    append_explain_line(lines, depth, ByteString::formatted("HashJoin ON {}", expression_to_string(m_condition)));
+    m_left->explain(lines, depth + 1);
+    m_right->explain(lines, depth + 1);
+}
+
+ByteString expression_to_string(Expression const& expression)
+{
+    auto operand_to_string = [](Expression const& operand) {
+        auto string = expression_to_string(operand);
+        if (is<BinaryOperatorExpression>(operand) || is<BetweenExpression>(operand))
+            return ByteString::formatted("({})", string);
+        return string;
+    };
+
+    if (is<NumericLiteral>(expression))
+        return Value { static_cast<NumericLiteral const&>(expression).value() }.to_byte_string();
+    if (is<StringLiteral>(expression))
+        return ByteString::formatted("'{}'", static_cast<StringLiteral const&>(expression).value());
+    if (is<BooleanLiteral>(expression))
+        return static_cast<BooleanLiteral const&>(expression).value() ? "TRUE"sv : "FALSE"sv;
+    if (is<NullLiteral>(expression))
+        return "NULL"sv;
+    if (is<Placeholder>(expression))
+        return "?"sv;
+
+    if (is<ColumnNameExpression>(expression)) {
+        auto const& column = static_cast<ColumnNameExpression const&>(expression);
+        if (column.table_name().is_empty())
+            return column.column_name();
+        return ByteString::formatted("{}.{}", column.table_name(), column.column_name());
+    }
+
+    if (is<UnaryOperatorExpression>(expression)) {
+        auto const& unary = static_cast<UnaryOperatorExpression const&>(expression);
+        auto separator = unary.type() == UnaryOperator::Not ? " "sv : ""sv;
+        return ByteString::formatted("{}{}{}", UnaryOperator_name(unary.type()), separator, operand_to_string(unary.expression()));
+    }
+
+    if (is<BinaryOperatorExpression>(expression)) {
+        auto const& binary = static_cast<BinaryOperatorExpression const&>(expression);
+        auto name = StringView { BinaryOperator_name(binary.type()), strlen(BinaryOperator_name(binary.type())) };
+        return ByteString::formatted("{} {} {}", operand_to_string(binary.lhs()), name.to_uppercase_string(), operand_to_string(binary.rhs()));
+    }
+
+    if (is<BetweenExpression>(expression)) {
+        auto const& between = static_cast<BetweenExpression const&>(expression);
+        return ByteString::formatted("{}{} BETWEEN {} AND {}", operand_to_string(between.expression()), between.invert_expression() ? " NOT"sv : ""sv, operand_to_string(between.lhs()), operand_to_string(between.rhs()));
+    }
+
+    if (is<ChainedExpression>(expression)) {
+        auto const& chain = static_cast<ChainedExpression const&>(expression);
+        StringBuilder builder;
+        builder.append('(');
+        for (size_t i = 0; i < chain.expressions().size(); ++i) {
+            if (i > 0)
+                builder.append(", "sv);
+            builder.append(expression_to_string(chain.expressions()[i]));
+        }
+        builder.append(')');
+        return builder.to_byte_string();
+    }
+
+    return "..."sv;
+}
+
+//==================================================================================================
+// Planning
+//==================================================================================================
+
+using TableSet = u64;
+
+static void collect_conjuncts(NonnullRefPtr<Expression> const& expression, Vector<NonnullRefPtr<Expression>>& conjuncts)
+{
+    if (is<BinaryOperatorExpression>(*expression)) {
+        auto const& binary = static_cast<BinaryOperatorExpression const&>(*expression);
+        if (binary.type() == BinaryOperator::And) {
+            collect_conjuncts(binary.lhs(), conjuncts);
+            collect_conjuncts(binary.rhs(), conjuncts);
+            return;
+        }
+    }
+
+    // A parenthesized expression on its own evaluates to the truth of its only element.
+    if (is<ChainedExpression>(*expression)) {
+        auto const& chain = static_cast<ChainedExpression const&>(*expression);
+        if (chain.expressions().size() == 1) {
+            collect_conjuncts(chain.expressions().first(), conjuncts);
+            return;
+        }
+    }
+
+    conjuncts.append(expression);
+}
+
+static Vector<NonnullRefPtr<Expression>> split_conjuncts(RefPtr<Expression> const& expression)
+{
+    Vector<NonnullRefPtr<Expression>> conjuncts;
+    if (expression)
+        collect_conjuncts(*expression, conjuncts);
+    return conjuncts;
+}
+
+static Optional<size_t> resolve_column(ColumnNameExpression const& column, ReadonlySpan<NonnullRefPtr<TableDef>> tables)
+{
+    Optional<size_t> table_index;
+
+    for (size_t i = 0; i < tables.size(); ++i) {
+        auto const& table = tables[i];
+        if (!column.table_name().is_empty() && column.table_name() != table->name())
+            continue;
+
+        auto has_column = any_of(table->columns(), [&](auto const& table_column) { return table_column->name() == column.column_name(); });
+        if (!has_column)
+            continue;
+
+        // Leave ambiguous columns for evaluation to complain about.
+        if (table_index.has_value())
+            return {};
+        table_index = i;
+    }
+
+    return table_index;
+}
+
+// Returns the set of tables the expression reads from, or nothing if that can't be told.
+static Optional<TableSet> referenced_tables(Expression const& expression, ReadonlySpan<NonnullRefPtr<TableDef>> tables)
+{
+    auto combine = [&](std::initializer_list<Expression const*> operands) -> Optional<TableSet> {
+        TableSet result = 0;
+        for (auto const* operand : operands) {
+            if (!operand)
+                continue;
+            auto operand_tables = referenced_tables(*operand, tables);
+            if (!operand_tables.has_value())
+                return {};
+            result |= operand_tables.value();
+        }
+        return result;
+    };
+
+    if (is<NumericLiteral>(expression) || is<StringLiteral>(expression) || is<BlobLiteral>(expression) || is<BooleanLiteral>(expression) || is<NullLiteral>(expression) || is<Placeholder>(expression))
+        return 0;
+
+    if (is<ColumnNameExpression>(expression)) {
+        auto table_index = resolve_column(static_cast<ColumnNameExpression const&>(expression), tables);
+        if (!table_index.has_value())
+            return {};
+        return static_cast<TableSet>(1) << table_index.value();
+    }
+
+    if (is<BetweenExpression>(expression)) {
+        auto const& between = static_cast<BetweenExpression const&>(expression);
+        return combine({ between.expression().ptr(), between.lhs().ptr(), between.rhs().ptr() });
+    }
+
+    if (is<MatchExpression>(expression)) {
+        auto const& match = static_cast<MatchExpression const&>(expression);
+        return combine({ match.lhs().ptr(), match.rhs().ptr(), match.escape().ptr() });
+    }
+
+    if (is<BinaryOperatorExpression>(expression) || is<IsExpression>(expression)) {
+        auto const& nested = static_cast<NestedDoubleExpression const&>(expression);
+        return combine({ nested.lhs().ptr(), nested.rhs().ptr() });
+    }
+
+    if (is<UnaryOperatorExpression>(expression) || is<CastExpression>(expression) || is<CollateExpression>(expression) || is<NullExpression>(expression))
+        return combine({ static_cast<NestedExpression const&>(expression).expression().ptr() });
+
+    if (is<ChainedExpression>(expression)) {
+        TableSet result = 0;
+        for (auto const& element : static_cast<ChainedExpression const&>(expression).expressions()) {
+            auto element_tables = referenced_tables(element, tables);
+            if (!element_tables.has_value())
+                return {};
+            result |= element_tables.value();
+        }
+        return result;
+    }
+
+    // Sub-selects, CASE, and the like.
+    return {};
+}
+
+static double estimated_selectivity(Expression const& condition)
+{
+    if (is<BinaryOperatorExpression>(condition) && static_cast<BinaryOperatorExpression const&>(condition).type() == BinaryOperator::Equals)
+        return 0.1;
+    return 0.25;
+}
+
+// Evaluates a constant expression, if its value can be compared against the entries of an index on a column of the given type.
+static Optional<Value> evaluate_index_constant(ExecutionContext& context, Expression const& expression, SQLType column_type)
+{
+    auto expression_tables = referenced_tables(expression, {});
+    if (!expression_tables.has_value() || expression_tables.value() != 0)
+        return {};
+
+    auto value_or_error = expression.evaluate(context);
+    if (value_or_error.is_error())
+        return {};
+    auto value = value_or_error.release_value();
+
+    switch (column_type) {
+    case SQLType::Integer:
+    case SQLType::Float:
+        if (value.type() != SQLType::Integer && value.type() != SQLType::Float)
+            return {};
+        return Database::index_key_value(value, column_type);
+    case SQLType::Text:
+        if (value.type() != SQLType::Text)
+            return {};
+        return value;
+    default:
+        return {};
+    }
+}
+
+struct IndexBound {
+    Optional<Value> lower_bound;
+    Optional<Value> upper_bound;
+    bool is_equality { false };
+};
+
+// Finds the range of index entries a condition can be true for. Integers compare equal to
+// numbers that round to them, so numeric bounds are made wide enough to include those.
+static Optional<IndexBound> index_bound_for_condition(ExecutionContext& context, Expression const& condition, TableDef const& table, KeyPartDef const& key_part)
+{
+    auto is_key_column = [&](Expression const& expression) {
+        if (!is<ColumnNameExpression>(expression))
+            return false;
+
+        auto const& column = static_cast<ColumnNameExpression const&>(expression);
+        return column.column_name() == key_part.name() && (column.table_name().is_empty() || column.table_name() == table.name());
+    };
+
+    auto widen = [](Value const& value, double delta) {
+        if (value.type() != SQLType::Float)
+            return value;
+        return Value { value.to_double().value() + delta };
+    };
+
+    if (is<BetweenExpression>(condition)) {
+        auto const& between = static_cast<BetweenExpression const&>(condition);
+        if (between.invert_expression() || !is_key_column(between.expression()))
+            return {};
+
+        auto lower_bound = evaluate_index_constant(context, between.lhs(), key_part.type());
+        auto upper_bound = evaluate_index_constant(context, between.rhs(), key_part.type());
+        if (!lower_bound.has_value() || !upper_bound.has_value())
+            return {};
+
+        return IndexBound { widen(lower_bound.value(), -0.5), widen(upper_bound.value(), 0.5) };
+    }
+
+    if (!is<BinaryOperatorExpression>(condition))
+        return {};
+
+    auto const& binary = static_cast<BinaryOperatorExpression const&>(condition);
+    auto type = binary.type();
+    Expression const* constant = nullptr;
+
+    if (is_key_column(binary.lhs())) {
+        constant = binary.rhs().ptr();
+    } else if (is_key_column(binary.rhs())) {
+        constant = binary.lhs().ptr();
+
+        switch (type) {
+        case BinaryOperator::LessThan:
+            type = BinaryOperator::GreaterThan;
+            break;
+        case BinaryOperator::LessThanEquals:
+            type = BinaryOperator::GreaterThanEquals;
+            break;
+        case BinaryOperator::GreaterThan:
+            type = BinaryOperator::LessThan;
+            break;
+        case BinaryOperator::GreaterThanEquals:
+            type = BinaryOperator::LessThanEquals;
+            break;
+        default:
+            break;
+        }
+    } else {
+        return {};
+    }
+
+    auto value = evaluate_index_constant(context, *constant, key_part.type());
+    if (!value.has_value())
+        return {};
+
+    switch (type) {
+    case BinaryOperator::Equals:
+        return IndexBound { widen(value.value(), -0.5), widen(value.value(), 0.5), true };
+    case BinaryOperator::GreaterThan:
+    case BinaryOperator::GreaterThanEquals:
+        return IndexBound { widen(value.value(), -0.5), {} };
+    case BinaryOperator::LessThan:
+    case BinaryOperator::LessThanEquals:
+        return IndexBound { {}, widen(value.value(), 0.5) };
+    default:
+        return {};
+    }
+}
+
+static NonnullOwnPtr<TableAccess> choose_access_path(ExecutionContext& context, NonnullRefPtr<TableDef> const& table, ReadonlySpan<NonnullRefPtr<Expression>> conditions)
+{
+    NonnullOwnPtr<TableAccess> best_access_path = make<TableScan>(table, assumed_table_rows);
+
+    for (auto const& index : table->indexes()) {
+        auto const& key_part = *index->key_definition().first();
+        IndexScan::Range range;
+
+        for (auto const& condition : conditions) {
+            auto bound = index_bound_for_condition(context, condition, *table, key_part);
+            if (!bound.has_value())
+                continue;
+
+            if (bound->lower_bound.has_value() && (!range.lower_bound.has_value() || bound->lower_bound->compare(*range.lower_bound) > 0))
+                range.lower_bound = bound->lower_bound;
+            if (bound->upper_bound.has_value() && (!range.upper_bound.has_value() || bound->upper_bound->compare(*range.upper_bound) < 0))
+                range.upper_bound = bound->upper_bound;
+            range.is_equality |= bound->is_equality;
+            range.conditions.append(condition);
+        }
+
+        if (range.conditions.is_empty())
+            continue;
+
+        double estimated_rows = 0;
+        if (range.is_equality)
+            estimated_rows = (index->unique() && index->size() == 1) ? 1 : 10;
+        else if (range.lower_bound.has_value() && range.upper_bound.has_value())
+            estimated_rows = assumed_table_rows / 64;
+        else
+            estimated_rows = assumed_table_rows / 4;
+
+        // Every row found through the index costs a lookup of its own.
+        auto estimated_cost = log2(assumed_table_rows) + estimated_rows * 2;
+        if (estimated_cost < best_access_path->estimated_cost())
+            best_access_path = make<IndexScan>(table, index, move(range), estimated_rows, estimated_cost);
+    }
+
+    return best_access_path;
+}
+
+ResultOr<NonnullOwnPtr<TableAccess>> plan_table_access(ExecutionContext& context, NonnullRefPtr<TableDef> table, RefPtr<Expression> const& where_clause)
+{
+    Vector<NonnullRefPtr<Expression>> conditions;
+    for (auto& conjunct : split_conjuncts(where_clause)) {
+        if (referenced_tables(conjunct, { &table, 1 }) == static_cast<TableSet>(1))
+            conditions.append(move(conjunct));
+    }
+
+    return choose_access_path(context, table, conditions);
+}
+
+// Wraps the plan in a filter for the conditions, unless there are none.
+static NonnullOwnPtr<QueryPlanNode> add_filter(NonnullOwnPtr<QueryPlanNode> plan, Vector<NonnullRefPtr<Expression>> conditions, ReadonlySpan<NonnullRefPtr<Expression>> conditions_used_by_plan = {})
+{
+    if (conditions.is_empty())
+        return plan;
+
+    auto estimated_rows = plan->estimated_rows();
+    for (auto const& condition : conditions) {
+        auto is_used_by_plan = any_of(conditions_used_by_plan, [&](auto const& used) { return used.ptr() == condition.ptr(); });
+        if (!is_used_by_plan)
+            estimated_rows *= estimated_selectivity(condition);
+    }
+
+    return make<Filter>(move(plan), move(conditions), max(estimated_rows, 1.0));
+}
+
+ResultOr<NonnullOwnPtr<QueryPlanNode>> plan_select(ExecutionContext& context, Select const& select)
+{
+    Vector<NonnullRefPtr<TableDef>> tables;
+    for (auto const& table_descriptor : select.table_or_subquery_list()) {
+        if (!table_descriptor->is_table())
+            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
+
+        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
+        if (table_def->num_columns() == 0)
+            continue;
+
+        TRY(tables.try_append(move(table_def)));
+    }
+
+    if (tables.size() > max_tables_in_join)
+        return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Joins of more than 64 tables are not yet implemented"sv };
+
+    struct Conjunct {
+        NonnullRefPtr<Expression> expression;
+        Optional<TableSet> tables;
+        bool is_placed { false };
+    };
+
+    Vector<Conjunct> conjuncts;
+    for (auto& expression : split_conjuncts(select.where_clause())) {
+        auto expression_tables = referenced_tables(expression, tables);
+        TRY(conjuncts.try_append({ move(expression), expression_tables }));
+    }
+
+    auto take_conjuncts = [&](Function<bool(Optional<TableSet> const&)> predicate) {
+        Vector<NonnullRefPtr<Expression>> taken;
+        for (auto& conjunct : conjuncts) {
+            if (!conjunct.is_placed && predicate(conjunct.tables)) {
+                conjunct.is_placed = true;
+                taken.append(conjunct.expression);
+            }
+        }
+        return taken;
+    };
+
+    auto plan_table = [&](size_t table_index) -> NonnullOwnPtr<QueryPlanNode> {
+        auto table_set = static_cast<TableSet>(1) << table_index;
+        auto conditions = take_conjuncts([&](auto const& condition_tables) { return condition_tables == table_set; });
+
+        auto access_path = choose_access_path(context, tables[table_index], conditions);
+        Vector<NonnullRefPtr<Expression>> conditions_used_by_index;
+        if (is<IndexScan>(*access_path))
+            conditions_used_by_index = static_cast<IndexScan const&>(*access_path).range().conditions;
+
+        return add_filter(move(access_path), move(conditions), conditions_used_by_index);
+    };
+
+    if (tables.is_empty()) {
+        NonnullOwnPtr<QueryPlanNode> plan = make<SingleRow>();
+        return add_filter(move(plan), take_conjuncts([](auto const&) { return true; }));
+    }
+
+    // Joins are done left-deep, in the order the tables appear in the FROM clause.
+    auto plan = plan_table(0);
+    TableSet joined_tables = 1;
+
+    for (size_t table_index = 1; table_index < tables.size(); ++table_index) {
+        auto table_set = static_cast<TableSet>(1) << table_index;
+        auto right = plan_table(table_index);
+
+        // Look for an equality between a column of the tables joined so far and a column of this table.
+        Conjunct* join_condition = nullptr;
+        RefPtr<Expression> left_key;
+        RefPtr<Expression> right_key;
+        bool is_numeric_key = false;
+
+        for (auto& conjunct : conjuncts) {
+            if (conjunct.is_placed || !conjunct.tables.has_value() || !is<BinaryOperatorExpression>(*conjunct.expression))
+                continue;
+
+            auto const& binary = static_cast<BinaryOperatorExpression const&>(*conjunct.expression);
+            if (binary.type() != BinaryOperator::Equals || !is<ColumnNameExpression>(*binary.lhs()) || !is<ColumnNameExpression>(*binary.rhs()))
+                continue;
+
+            auto lhs_table = resolve_column(static_cast<ColumnNameExpression const&>(*binary.lhs()), tables);
+            auto rhs_table = resolve_column(static_cast<ColumnNameExpression const&>(*binary.rhs()), tables);
+            if (!lhs_table.has_value() || !rhs_table.has_value())
+                continue;
+
+            auto column_type = [&](ColumnNameExpression const& column, size_t index) {
+                for (auto const& table_column : tables[index]->columns()) {
+                    if (table_column->name() == column.column_name())
+                        return table_column->type();
+                }
+                VERIFY_NOT_REACHED();
+            };
+            auto is_numeric = [](SQLType type) { return type == SQLType::Integer || type == SQLType::Float; };
+
+            auto lhs_type = column_type(static_cast<ColumnNameExpression const&>(*binary.lhs()), *lhs_table);
+            auto rhs_type = column_type(static_cast<ColumnNameExpression const&>(*binary.rhs()), *rhs_table);
+            if (!(is_numeric(lhs_type) && is_numeric(rhs_type)) && !(lhs_type == SQLType::Text && rhs_type == SQLType::Text))
+                continue;
+
+            auto lhs_set = static_cast<TableSet>(1) << *lhs_table;
+            auto rhs_set = static_cast<TableSet>(1) << *rhs_table;
+            if ((lhs_set & joined_tables) && rhs_set == table_set) {
+                left_key = binary.lhs();
+                right_key = binary.rhs();
+            } else if ((rhs_set & joined_tables) && lhs_set == table_set) {
+                left_key = binary.rhs();
+                right_key = binary.lhs();
+            } else {
+                continue;
+            }
+
+            join_condition = &conjunct;
+            is_numeric_key = is_numeric(lhs_type);
+            break;
+        }
+
+        auto left_rows = plan->estimated_rows();
+        auto right_rows = right->estimated_rows();
+        auto children_cost = plan->estimated_cost() + right->estimated_cost();
+
+        if (join_condition) {
+            join_condition->is_placed = true;
+            auto estimated_rows = max(left_rows, right_rows);
+            auto estimated_cost = children_cost + left_rows + right_rows;
+            plan = make<HashJoin>(move(plan), move(right), join_condition->expression, left_key.release_nonnull(), right_key.release_nonnull(), is_numeric_key, estimated_rows, estimated_cost);
+        } else {
+            auto estimated_rows = left_rows * right_rows;
+            plan = make<NestedLoopJoin>(move(plan), move(right), estimated_rows, children_cost + estimated_rows);
+        }
+
+        joined_tables |= table_set;
+        plan = add_filter(move(plan), take_conjuncts([&](auto const& condition_tables) {
+            return condition_tables.has_value() && condition_tables.value() != 0 && (condition_tables.value() & ~joined_tables) == 0;
+        }));
+    }
+
+    // Whatever is left reads no table at all, or could not be placed.
+    return add_filter(move(plan), take_conjuncts([](auto const&) { return true; }));
+}
+
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/BTree.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Result.h>
+#include <LibSQL/Row.h>
+#include <LibSQL/Tuple.h>
+
+namespace SQL::AST {
+
+/**
+ * A query plan is a tree of QueryPlanNodes. Rows are pulled from the root one at a
+ * time, and every node pulls rows from its children only when it needs them; a query
+ * that stops early never reads the rest of its tables.
+ *
+ * The planner has no statistics about the tables, so like SQLite without ANALYZE it
+ * assumes every table to be large and estimates the rows produced by each node from
+ * the shape of the predicates alone. The estimates are only used to pick between
+ * alternative plans, and are shown by EXPLAIN.
+ */
+class QueryPlanNode {
+public:
+    virtual ~QueryPlanNode() = default;
+
+    // Produces the next row, or nothing once the node is exhausted.
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) = 0;
+    virtual void explain(Vector<ByteString>& lines, size_t depth) const = 0;
+
+    NonnullRefPtr<TupleDescriptor> const& descriptor() const { return m_descriptor; }
+    double estimated_rows() const { return m_estimated_rows; }
+    double estimated_cost() const { return m_estimated_cost; }
+
+protected:
+    QueryPlanNode(NonnullRefPtr<TupleDescriptor> descriptor, double estimated_rows, double estimated_cost)
+        : m_descriptor(move(descriptor))
+        , m_estimated_rows(estimated_rows)
+        , m_estimated_cost(estimated_cost)
+    {
+    }
+
+    void append_explain_line(Vector<ByteString>& lines, size_t depth, StringView description) const;
+
+private:
+    NonnullRefPtr<TupleDescriptor> m_descriptor;
+    double m_estimated_rows { 0 };
+    double m_estimated_cost { 0 };
+};
+
+// Produces a single empty row, for SELECT statements without a FROM clause.
+class SingleRow final : public QueryPlanNode {
+public:
+    SingleRow();
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+    virtual void explain(Vector<ByteString>&, size_t depth) const override;
+
+private:
+    bool m_done { false };
+};
+
+// Reads the rows of a single table. Statements that modify the rows they find can get
+// at the rows themselves, instead of the tuples passed up the plan.
+class TableAccess : public QueryPlanNode {
+public:
+    TableDef& table() { return *m_table; }
+
+    virtual ResultOr<Optional<Row>> next_row(ExecutionContext&) = 0;
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+protected:
+    TableAccess(NonnullRefPtr<TableDef>, double estimated_rows, double estimated_cost);
+
+    NonnullRefPtr<TableDef> m_table;
+};
+
+class TableScan final : public TableAccess {
+public:
+    TableScan(NonnullRefPtr<TableDef>, double estimated_rows);
+
+    virtual ResultOr<Optional<Row>> next_row(ExecutionContext&) override;
+    virtual void explain(Vector<ByteString>&, size_t depth) const override;
+
+private:
+    bool m_started { false };
+    Block::Index m_next_block_index { 0 };
+};
+
+// Reads the rows whose first indexed column falls into a range, in index order. The
+// range is allowed to be wider than the predicates it came from; those predicates are
+// still evaluated on every row.
+class IndexScan final : public TableAccess {
+public:
+    struct Range {
+        Optional<Value> lower_bound;
+        Optional<Value> upper_bound;
+        bool is_equality { false };
+        Vector<NonnullRefPtr<Expression>> conditions;
+    };
+
+    IndexScan(NonnullRefPtr<TableDef>, NonnullRefPtr<IndexDef>, Range, double estimated_rows, double estimated_cost);
+
+    Range const& range() const { return m_range; }
+
+    virtual ResultOr<Optional<Row>> next_row(ExecutionContext&) override;
+    virtual void explain(Vector<ByteString>&, size_t depth) const override;
+
+private:
+    NonnullRefPtr<IndexDef> m_index;
+    Range m_range;
+    RefPtr<BTree> m_tree;
+    Optional<BTreeIterator> m_iterator;
+    Optional<Key> m_upper_bound;
+};
+
+// Passes on the rows of its child for which all of its conditions are true.
+class Filter final : public QueryPlanNode {
+public:
+    Filter(NonnullOwnPtr<QueryPlanNode>, Vector<NonnullRefPtr<Expression>> conditions, double estimated_rows);
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+    virtual void explain(Vector<ByteString>&, size_t depth) const override;
+
+private:
+    NonnullOwnPtr<QueryPlanNode> m_child;
+    Vector<NonnullRefPtr<Expression>> m_conditions;
+};
+
+// Pairs every row of the left child with every row of the right child. The rows of
+// the right child are read once and kept in memory.
+class NestedLoopJoin final : public QueryPlanNode {
+public:
+    NestedLoopJoin(NonnullOwnPtr<QueryPlanNode> left, NonnullOwnPtr<QueryPlanNode> right, double estimated_rows, double estimated_cost);
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+    virtual void explain(Vector<ByteString>&, size_t depth) const override;
+
+private:
+    NonnullOwnPtr<QueryPlanNode> m_left;
+    NonnullOwnPtr<QueryPlanNode> m_right;
+
+    bool m_right_rows_read { false };
+    Vector<Tuple> m_right_rows;
+    Optional<Tuple> m_left_row;
+    size_t m_right_row_index { 0 };
+};
+
+// Pairs the rows of its children whose join keys are equal. The rows of the right child
+// are read once into a hash table, and the rows of the left child are looked up in it.
+// Keys are compared loosely, so the equality this join came from still has to be checked.
+class HashJoin final : public QueryPlanNode {
+public:
+    HashJoin(NonnullOwnPtr<QueryPlanNode> left, NonnullOwnPtr<QueryPlanNode> right, NonnullRefPtr<Expression> condition, NonnullRefPtr<Expression> left_key, NonnullRefPtr<Expression> right_key, bool is_numeric_key, double estimated_rows, double estimated_cost);
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+    virtual void explain(Vector<ByteString>&, size_t depth) const override;
+
+private:
+    ResultOr<Optional<Value>> evaluate_key(ExecutionContext&, Expression const&, Tuple&) const;
+
+    NonnullOwnPtr<QueryPlanNode> m_left;
+    NonnullOwnPtr<QueryPlanNode> m_right;
+    NonnullRefPtr<Expression> m_condition;
+    NonnullRefPtr<Expression> m_left_key;
+    NonnullRefPtr<Expression> m_right_key;
+    bool m_is_numeric_key { false };
+
+    bool m_right_rows_read { false };
+    Vector<Tuple> m_right_rows;
+    Vector<Value> m_right_keys;
+    HashMap<u32, Vector<size_t>> m_buckets;
+    Vector<size_t> m_unbucketed_rows;
+
+    Optional<Tuple> m_left_row;
+    Optional<Value> m_left_key_value;
+    Vector<size_t> const* m_matches { nullptr };
+    size_t m_match_index { 0 };
+};
+
+ResultOr<NonnullOwnPtr<QueryPlanNode>> plan_select(ExecutionContext&, Select const&);
+ResultOr<NonnullOwnPtr<TableAccess>> plan_table_access(ExecutionContext&, NonnullRefPtr<TableDef>, RefPtr<Expression> const& where_clause);
+
+ByteString expression_to_string(Expression const&);
+
+}
@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Checked.h>
 #include <AK/NumericLimits.h>
 #include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/QueryPlan.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Meta.h>
 #include <LibSQL/Row.h>
@@ -85,32 +87,27 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 
     ResultSet result { SQLCommand::Select, move(column_names) };
 
-    auto descriptor = adopt_ref(*new TupleDescriptor);
-    Tuple tuple(descriptor);
-    Vector<Tuple> rows;
-    descriptor->empend("__unity__"sv);
-    tuple.append(Value { true });
-    rows.append(tuple);
+    size_t limit_value = NumericLimits<size_t>::max();
+    size_t offset_value = 0;
 
-    for (auto& table_descriptor : table_or_subquery_list()) {
-        if (!table_descriptor->is_table())
-            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
-
-        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
-        if (table_def->num_columns() == 0)
-            continue;
+    if (m_limit_clause != nullptr) {
+        auto limit = TRY(m_limit_clause->limit_expression()->evaluate(context));
+        if (!limit.is_null()) {
+            auto limit_value_maybe = limit.to_int<size_t>();
+            if (!limit_value_maybe.has_value())
+                return Result { SQLCommand::Select, SQLErrorCode::SyntaxError, "LIMIT clause must evaluate to an integer value"sv };
 
-        auto old_descriptor_size = descriptor->size();
-        descriptor->extend(table_def->to_tuple_descriptor());
+            limit_value = limit_value_maybe.value();
+        }
 
-        while (!rows.is_empty() && (rows.first().size() == old_descriptor_size)) {
-            auto cartesian_row = rows.take_first();
-            auto table_rows = TRY(context.database->select_all(*table_def));
+        if (m_limit_clause->offset_expression() != nullptr) {
+            auto offset = TRY(m_limit_clause->offset_expression()->evaluate(context));
+            if (!offset.is_null()) {
+                auto offset_value_maybe = offset.to_int<size_t>();
+                if (!offset_value_maybe.has_value())
+                    return Result { SQLCommand::Select, SQLErrorCode::SyntaxError, "OFFSET clause must evaluate to an integer value"sv };
 
-            for (auto& table_row : table_rows) {
-                auto new_row = cartesian_row;
-                new_row.extend(table_row);
-                rows.append(new_row);
+                offset_value = offset_value_maybe.value();
             }
         }
     }
@@ -123,15 +120,22 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
     }
     Tuple sort_key(sort_descriptor);
 
-    for (auto& row : rows) {
-        context.current_row = &row;
+    // Without an ordering, the rows come out in the order we find them, and we can stop
+    // looking as soon as we have found all the rows the LIMIT clause lets through.
+    auto rows_needed = NumericLimits<size_t>::max();
+    if (!has_ordering && !Checked<size_t>::addition_would_overflow(offset_value, limit_value))
+        rows_needed = offset_value + limit_value;
 
-        if (where_clause()) {
-            auto where_result = TRY(where_clause()->evaluate(context)).to_bool();
-            if (!where_result.has_value() || !where_result.value())
-                continue;
-        }
+    auto plan = TRY(plan_select(context, *this));
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    Tuple tuple(descriptor);
 
+    while (result.size() < rows_needed) {
+        auto row = TRY(plan->next(context));
+        if (!row.has_value())
+            break;
+
+        context.current_row = &row.value();
         tuple.clear();
 
         for (auto& col : columns) {
@@ -149,33 +153,10 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 
         result.insert_row(tuple, sort_key);
     }
+    context.current_row = nullptr;
 
-    if (m_limit_clause != nullptr) {
-        size_t limit_value = NumericLimits<size_t>::max();
-        size_t offset_value = 0;
-
-        auto limit = TRY(m_limit_clause->limit_expression()->evaluate(context));
-        if (!limit.is_null()) {
-            auto limit_value_maybe = limit.to_int<size_t>();
-            if (!limit_value_maybe.has_value())
-                return Result { SQLCommand::Select, SQLErrorCode::SyntaxError, "LIMIT clause must evaluate to an integer value"sv };
-
-            limit_value = limit_value_maybe.value();
-        }
-
-        if (m_limit_clause->offset_expression() != nullptr) {
-            auto offset = TRY(m_limit_clause->offset_expression()->evaluate(context));
-            if (!offset.is_null()) {
-                auto offset_value_maybe = offset.to_int<size_t>();
-                if (!offset_value_maybe.has_value())
-                    return Result { SQLCommand::Select, SQLErrorCode::SyntaxError, "OFFSET clause must evaluate to an integer value"sv };
-
-                offset_value = offset_value_maybe.value();
-            }
-        }
-
+    if (m_limit_clause != nullptr)
         result.limit(offset_value, limit_value);
-    }
 
     return result;
 }
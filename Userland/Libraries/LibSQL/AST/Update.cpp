@@ -5,6 +5,7 @@
  */
 
 #include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/QueryPlan.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Meta.h>
 #include <LibSQL/Row.h>
@@ -19,8 +20,14 @@ ResultOr<ResultSet> Update::execute(ExecutionContext& context) const
 
     Vector<Row> matched_rows;
 
-    for (auto& table_row : TRY(context.database->select_all(*table_def))) {
-        context.current_row = &table_row;
+    // All rows are found before any of them changes, so that the changes can't affect which rows are found.
+    auto access_path = TRY(plan_table_access(context, table_def, where_clause()));
+    while (true) {
+        auto table_row = TRY(access_path->next_row(context));
+        if (!table_row.has_value())
+            break;
+
+        context.current_row = &table_row.value();
 
         if (auto const& where_clause = this->where_clause()) {
             auto where_result = TRY(where_clause->evaluate(context)).to_bool();
@@ -28,8 +35,9 @@ ResultOr<ResultSet> Update::execute(ExecutionContext& context) const
                 continue;
         }
 
-        TRY(matched_rows.try_append(move(table_row)));
+        TRY(matched_rows.try_append(table_row.release_value()));
     }
+    context.current_row = nullptr;
 
     ResultSet result { SQLCommand::Update };
 
@@ -52,6 +60,7 @@ ResultOr<ResultSet> Update::execute(ExecutionContext& context) const
                 table_row[column_index] = row_value;
             }
 
+            TRY(context.database->check_unique_constraints(table_row));
             TRY(context.database->update(table_row));
             result.insert_row(table_row, {});
         }
@@ -103,6 +103,28 @@ BTreeIterator BTree::find(Key const& key)
     return end();
 }
 
+BTreeIterator BTree::lower_bound(Key const& key)
+{
+    if (!m_root)
+        initialize_root();
+
+    // Walk down to the leaf the key would be inserted in, remembering the
+    // first entry not less than the key on every level. The last one we saw
+    // is the closest one.
+    Optional<BTreeIterator> candidate;
+    for (auto* node = m_root.ptr(); node;) {
+        auto ix = 0u;
+        while (ix < node->size() && (*node)[ix] < key)
+            ++ix;
+        if (ix < node->size())
+            candidate = BTreeIterator(node, (int)ix);
+        if (node->is_leaf())
+            break;
+        node = node->down_node(ix);
+    }
+    return candidate.value_or(end());
+}
+
 void BTree::list_tree()
 {
     if (!m_root)
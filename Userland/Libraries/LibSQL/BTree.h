@@ -101,6 +101,7 @@ public:
     bool update_key_pointer(Key const&);
     Optional<u32> get(Key&);
     BTreeIterator find(Key const& key);
+    BTreeIterator lower_bound(Key const& key);
     BTreeIterator begin();
     static BTreeIterator end();
     void list_tree();
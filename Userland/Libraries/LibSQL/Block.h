@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2021, Jan de Visser <jan@de-visser.net>
+ * Copyright (c) 2023, Jelle Raaijmakers <jelle@gmta.nl>
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace SQL {
+
+/**
+ * A Block represents a single discrete page inside the Heap, and acts as the
+ * container format for the actual data we are storing. Every page except page 0,
+ * the zero / super block, starts with a header holding the number of bytes of data
+ * stored in the page and the index of the next block, followed by the data itself.
+ *
+ * If data needs to be stored that is larger than what fits in a single page, Blocks
+ * are chained together by setting the next block index and the data is reconstructed
+ * by repeatedly reading blocks until the next block index is 0.
+ *
+ * The size of a page is chosen when the Heap is first created, see Heap::page_size().
+ */
+class Block {
+public:
+    typedef u32 Index;
+
+    static constexpr u32 SIZE_IN_BYTES_OFFSET = 0;
+    static constexpr u32 NEXT_BLOCK_OFFSET = sizeof(u32);
+    static constexpr u32 HEADER_SIZE = sizeof(u32) + sizeof(Index);
+};
+
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/QuickSort.h>
+#include <LibSQL/BufferPool.h>
+
+namespace SQL {
+
+PinnedPage::~PinnedPage()
+{
+    if (m_pool)
+        m_pool->unpin(*m_page);
+}
+
+BufferPool::BufferPool(u32 page_size, size_t capacity, ReadPage read_page, WriteBackPage write_back_page)
+    : m_page_size(page_size)
+    , m_capacity(max(capacity, 1uz))
+    , m_read_page(move(read_page))
+    , m_write_back_page(move(write_back_page))
+{
+}
+
+BufferPool::~BufferPool()
+{
+    m_unpinned_pages.clear();
+    m_pages.clear();
+}
+
+ErrorOr<PinnedPage> BufferPool::pin(Block::Index index)
+{
+    auto* page = TRY(find_or_create(index, true));
+    return PinnedPage { *this, *page };
+}
+
+ErrorOr<PinnedPage> BufferPool::pin_without_reading(Block::Index index)
+{
+    auto* page = TRY(find_or_create(index, false));
+    return PinnedPage { *this, *page };
+}
+
+ErrorOr<Page*> BufferPool::find_or_create(Block::Index index, bool read_page)
+{
+    if (auto page = m_pages.get(index); page.has_value()) {
+        ++m_statistics.hits;
+        auto& existing_page = **page;
+        if (existing_page.m_pin_count++ == 0)
+            m_unpinned_pages.remove(existing_page);
+        return &existing_page;
+    }
+
+    ++m_statistics.misses;
+    auto buffer = TRY(make_room());
+    if (read_page)
+        TRY(m_read_page(index, buffer.bytes()));
+    else
+        buffer.zero_fill();
+
+    auto page = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Page(index, move(buffer))));
+    page->m_pin_count = 1;
+
+    auto* page_pointer = page.ptr();
+    TRY(m_pages.try_set(index, move(page)));
+    return page_pointer;
+}
+
+ErrorOr<ByteBuffer> BufferPool::make_room()
+{
+    if (m_pages.size() < m_capacity || m_unpinned_pages.is_empty())
+        return ByteBuffer::create_uninitialized(m_page_size);
+
+    auto& victim = *m_unpinned_pages.first();
+    dbgln_if(SQL_DEBUG, "BufferPool: evicting page {} (dirty: {})", victim.index(), victim.is_dirty());
+
+    if (victim.is_dirty()) {
+        TRY(m_write_back_page(victim));
+        ++m_statistics.write_backs;
+    }
+    ++m_statistics.evictions;
+
+    // Hand the victim's buffer over to the new page, instead of allocating a fresh one.
+    auto buffer = move(victim.m_buffer);
+    m_unpinned_pages.remove(victim);
+    m_pages.remove(victim.index());
+    return buffer;
+}
+
+void BufferPool::unpin(Page& page)
+{
+    VERIFY(page.m_pin_count > 0);
+    if (--page.m_pin_count == 0)
+        m_unpinned_pages.append(page);
+}
+
+Vector<Page*> BufferPool::dirty_pages()
+{
+    Vector<Page*> pages;
+    for (auto& it : m_pages) {
+        if (it.value->is_dirty())
+            pages.append(it.value.ptr());
+    }
+    quick_sort(pages, [](Page const* a, Page const* b) { return a->index() < b->index(); });
+    return pages;
+}
+
+}
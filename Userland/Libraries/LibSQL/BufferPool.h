@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+#include <LibSQL/Block.h>
+
+namespace SQL {
+
+class BufferPool;
+
+/**
+ * A Page is the in-memory copy of a single block of the Heap. Pages are owned by
+ * the BufferPool and can only be accessed while pinned, see PinnedPage. Anyone
+ * modifying the bytes of a page has to mark it dirty, so that it ends up on disk.
+ */
+class Page {
+    AK_MAKE_NONCOPYABLE(Page);
+    AK_MAKE_NONMOVABLE(Page);
+
+public:
+    Block::Index index() const { return m_index; }
+
+    Bytes bytes() { return m_buffer.bytes(); }
+    ReadonlyBytes bytes() const { return m_buffer.bytes(); }
+
+    bool is_dirty() const { return m_dirty; }
+    void set_dirty() { m_dirty = true; }
+
+private:
+    friend class BufferPool;
+
+    Page(Block::Index index, ByteBuffer buffer)
+        : m_index(index)
+        , m_buffer(move(buffer))
+    {
+    }
+
+    Block::Index m_index { 0 };
+    ByteBuffer m_buffer;
+    bool m_dirty { false };
+    u32 m_pin_count { 0 };
+    IntrusiveListNode<Page> m_lru_node;
+
+public:
+    using LRUList = IntrusiveList<&Page::m_lru_node>;
+};
+
+/**
+ * Keeps a page pinned in the BufferPool for as long as it is alive, which
+ * guarantees that the page will not be evicted underneath its user.
+ */
+class PinnedPage {
+    AK_MAKE_NONCOPYABLE(PinnedPage);
+
+public:
+    PinnedPage(PinnedPage&& other)
+        : m_pool(exchange(other.m_pool, nullptr))
+        , m_page(exchange(other.m_page, nullptr))
+    {
+    }
+
+    ~PinnedPage();
+
+    Page* operator->() { return m_page; }
+    Page const* operator->() const { return m_page; }
+    Page& operator*() { return *m_page; }
+    Page const& operator*() const { return *m_page; }
+
+private:
+    friend class BufferPool;
+
+    PinnedPage(BufferPool& pool, Page& page)
+        : m_pool(&pool)
+        , m_page(&page)
+    {
+    }
+
+    BufferPool* m_pool { nullptr };
+    Page* m_page { nullptr };
+};
+
+/**
+ * A fixed-size cache of the Heap's pages. When the pool is full, the least recently
+ * used page that is not pinned is evicted to make room; dirty pages are handed to the
+ * write-back callback before they go. If every page is pinned, the pool temporarily
+ * grows beyond its capacity instead.
+ */
+class BufferPool {
+    AK_MAKE_NONCOPYABLE(BufferPool);
+    AK_MAKE_NONMOVABLE(BufferPool);
+
+public:
+    using ReadPage = Function<ErrorOr<void>(Block::Index, Bytes)>;
+    using WriteBackPage = Function<ErrorOr<void>(Page const&)>;
+
+    struct Statistics {
+        size_t hits { 0 };
+        size_t misses { 0 };
+        size_t evictions { 0 };
+        size_t write_backs { 0 };
+    };
+
+    BufferPool(u32 page_size, size_t capacity, ReadPage, WriteBackPage);
+    ~BufferPool();
+
+    u32 page_size() const { return m_page_size; }
+    size_t capacity() const { return m_capacity; }
+    size_t size() const { return m_pages.size(); }
+    Statistics const& statistics() const { return m_statistics; }
+
+    [[nodiscard]] bool contains(Block::Index index) const { return m_pages.contains(index); }
+
+    // Pins the page, reading it in if it isn't in the pool yet.
+    ErrorOr<PinnedPage> pin(Block::Index);
+
+    // Pins the page without reading it in, for pages that are about to be overwritten in full.
+    // If the page is already in the pool, its contents are left alone.
+    ErrorOr<PinnedPage> pin_without_reading(Block::Index);
+
+    // Returns the dirty pages sorted by their index; the caller is responsible for marking them clean.
+    Vector<Page*> dirty_pages();
+    void mark_clean(Page& page) { page.m_dirty = false; }
+
+private:
+    friend class PinnedPage;
+
+    ErrorOr<Page*> find_or_create(Block::Index, bool read_page);
+    ErrorOr<ByteBuffer> make_room();
+    void unpin(Page&);
+
+    u32 m_page_size { 0 };
+    size_t m_capacity { 0 };
+    ReadPage m_read_page;
+    WriteBackPage m_write_back_page;
+
+    HashMap<Block::Index, NonnullOwnPtr<Page>> m_pages;
+
+    // Pages that aren't pinned, least recently used first.
+    Page::LRUList m_unpinned_pages;
+
+    Statistics m_statistics;
+};
+
+}
@@ -5,7 +5,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/ByteString.h>
+#include <AK/QuickSort.h>
 #include <LibSQL/BTree.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Heap.h>
@@ -47,6 +49,11 @@ ResultOr<void> Database::open()
         m_heap->set_table_columns_root(m_table_columns->root());
     };
 
+    m_table_indexes = TRY(BTree::create(m_serializer, IndexDef::index_def()->to_tuple_descriptor(), m_heap->table_indexes_root()));
+    m_table_indexes->on_new_root = [&]() {
+        m_heap->set_table_indexes_root(m_table_indexes->root());
+    };
+
     m_open = true;
 
     auto ensure_schema_exists = [&](auto schema_name) -> ResultOr<NonnullRefPtr<SchemaDef>> {
@@ -83,10 +90,16 @@ Database::~Database() = default;
 ErrorOr<void> Database::commit()
 {
     VERIFY(is_open());
-    TRY(m_heap->flush());
+    TRY(m_heap->commit());
     return {};
 }
 
+ErrorOr<void> Database::sync()
+{
+    VERIFY(is_open());
+    return m_heap->sync();
+}
+
 ResultOr<void> Database::add_schema(SchemaDef const& schema)
 {
     VERIFY(is_open());
@@ -172,9 +185,208 @@ ResultOr<NonnullRefPtr<TableDef>> Database::get_table(ByteString const& schema,
     for (auto it = m_table_columns->find(column_key); !it.is_end() && ((*it)["table_hash"].to_int<u32>() == table_hash); ++it)
         table_def->append_column(*it);
 
+    auto index_key = IndexDef::make_key(table_def);
+    for (auto it = m_table_indexes->find(index_key); !it.is_end() && ((*it)["table_hash"].to_int<u32>() == table_hash); ++it) {
+        auto index_def = TRY(IndexDef::create(table_def.ptr(), (*it)["index_name"].to_byte_string(), (*it)["unique"].to_int<int>() == 1, (*it).block_index()));
+
+        // The key parts of an index are stored like the columns of a table, with the index as their parent.
+        auto index_hash = index_def->hash();
+        auto key_part_key = index_def->make_key_part_key();
+        for (auto part = m_table_columns->find(key_part_key); !part.is_end() && ((*part)["table_hash"].to_int<u32>() == index_hash); ++part)
+            index_def->append_column(*part);
+
+        table_def->append_index(move(index_def));
+    }
+
     return table_def;
 }
 
+ResultOr<void> Database::add_index(TableDef& table, IndexDef& index)
+{
+    VERIFY(is_open());
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+
+    for (auto const& existing_index : table.indexes()) {
+        if (existing_index->name() == index.name())
+            return Result { SQLCommand::Unknown, SQLErrorCode::IndexExists, index.name() };
+    }
+
+    auto rows = TRY(select_all(table));
+
+    if (index.unique()) {
+        Vector<Key> entries;
+        TRY(entries.try_ensure_capacity(rows.size()));
+        for (auto const& row : rows)
+            entries.unchecked_append(make_index_entry(index, row));
+
+        // Sorting puts rows with equal key values next to each other. The row's
+        // block index at the end of each entry does not take part in this.
+        auto key_size = index_entry_descriptor(index)->size() - 1;
+        auto compare_keys = [&](Key const& a, Key const& b) {
+            for (auto ix = 0u; ix < key_size; ix++) {
+                if (auto result = a[ix].compare(b[ix]); result != 0)
+                    return result;
+            }
+            return 0;
+        };
+        quick_sort(entries, [&](Key const& a, Key const& b) { return compare_keys(a, b) < 0; });
+
+        for (auto ix = 1u; ix < entries.size(); ix++) {
+            if (!has_null_key_part(index, entries[ix]) && compare_keys(entries[ix - 1], entries[ix]) == 0)
+                return Result { SQLCommand::Unknown, SQLErrorCode::UniqueConstraintFailed, index.name() };
+        }
+    }
+
+    if (!m_table_indexes->insert(index.key()))
+        return Result { SQLCommand::Unknown, SQLErrorCode::IndexExists, index.name() };
+
+    for (auto& key_part : index.key_definition()) {
+        if (!m_table_columns->insert(key_part->key()))
+            VERIFY_NOT_REACHED();
+    }
+
+    table.append_index(index);
+
+    for (auto const& row : rows) {
+        auto entry = make_index_entry(index, row);
+        TRY(insert_index_entry(index, entry));
+    }
+
+    return {};
+}
+
+ErrorOr<NonnullRefPtr<BTree>> Database::get_index_tree(IndexDef& index)
+{
+    VERIFY(is_open());
+
+    auto index_hash = index.hash();
+    if (auto it = m_index_trees.find(index_hash); it != m_index_trees.end())
+        return it->value;
+
+    auto tree = TRY(BTree::create(m_serializer, index_entry_descriptor(index), index.block_index()));
+    tree->on_new_root = [this, &tree = *tree, index = NonnullRefPtr { index }]() {
+        // The tree can't report a failure to store its new root, so insert_index_entry() does that.
+        index->set_block_index(tree.root());
+        m_indexes_with_new_root.append(index);
+    };
+
+    TRY(m_index_trees.try_set(index_hash, tree));
+    return tree;
+}
+
+NonnullRefPtr<TupleDescriptor> Database::index_entry_descriptor(IndexDef const& index)
+{
+    // An index entry holds two values per key part: whether the row's value is present, and the
+    // value itself. NULL does not compare equal to anything, not even to itself, so it can't be
+    // stored in an entry that we need to find again later. After the key parts comes the row's
+    // block index, to tell apart rows with equal keys. The entry's pointer leads to the row.
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    for (auto const& part : index.key_definition()) {
+        descriptor->append({ "", "", "$present", SQLType::Integer, part->sort_order() });
+        descriptor->append({ "", "", part->name(), part->type(), part->sort_order() });
+    }
+    descriptor->append({ "", "", "$row", SQLType::Integer, Order::Ascending });
+    return descriptor;
+}
+
+Value Database::index_key_value(Value const& value, SQLType type)
+{
+    // Integer and Float columns may hold values of either type, and the two do not compare
+    // consistently against each other. Keep all numbers in the index as floating point, so
+    // that the entries have a well-defined order.
+    if (value.is_null() || (type != SQLType::Integer && type != SQLType::Float))
+        return value;
+
+    if (auto number = value.to_double(); number.has_value())
+        return Value { *number };
+    return value;
+}
+
+static Value placeholder_for_null(SQLType type)
+{
+    switch (type) {
+    case SQLType::Text:
+        return Value { ByteString {} };
+    case SQLType::Boolean:
+        return Value { false };
+    default:
+        return Value { 0.0 };
+    }
+}
+
+Key Database::make_index_prefix(IndexDef const& index, ReadonlySpan<Value> values)
+{
+    VERIFY(values.size() <= index.size());
+
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    auto entry_descriptor = index_entry_descriptor(index);
+    for (auto ix = 0u; ix < 2 * values.size(); ix++)
+        descriptor->append((*entry_descriptor)[ix]);
+
+    Key prefix(descriptor);
+    for (auto ix = 0u; ix < values.size(); ix++) {
+        auto type = index.key_definition()[ix]->type();
+        if (values[ix].is_null()) {
+            prefix[2 * ix] = 0;
+            prefix[2 * ix + 1] = placeholder_for_null(type);
+        } else {
+            prefix[2 * ix] = 1;
+            prefix[2 * ix + 1] = index_key_value(values[ix], type);
+        }
+    }
+    return prefix;
+}
+
+bool Database::has_null_key_part(IndexDef const& index, Key const& entry)
+{
+    for (auto ix = 0u; ix < index.size(); ix++) {
+        if (entry[2 * ix].to_int<int>() == 0)
+            return true;
+    }
+    return false;
+}
+
+Key Database::make_index_entry(IndexDef const& index, Row const& row) const
+{
+    Vector<Value> values;
+    for (auto const& part : index.key_definition())
+        values.append(row[part->name()]);
+    auto prefix = make_index_prefix(index, values);
+
+    Key entry(index_entry_descriptor(index));
+    for (auto ix = 0u; ix < prefix.size(); ix++)
+        entry[ix] = prefix[ix];
+
+    entry[prefix.size()] = row.block_index();
+    entry.set_block_index(row.block_index());
+    return entry;
+}
+
+ResultOr<void> Database::insert_index_entry(IndexDef& index, Key& entry)
+{
+    auto tree = TRY(get_index_tree(index));
+
+    // The entry may still be in the tree as a tombstone, if the row's storage got reused.
+    if (!tree->update_key_pointer(entry) && !tree->insert(entry))
+        return Result { SQLCommand::Unknown, SQLErrorCode::InternalError, ByteString::formatted("Could not add an entry to index '{}'", index.name()) };
+
+    for (auto& index_with_new_root : exchange(m_indexes_with_new_root, {})) {
+        if (!m_table_indexes->update_key_pointer(index_with_new_root->key()))
+            return Result { SQLCommand::Unknown, SQLErrorCode::InternalError, ByteString::formatted("Could not store the root of index '{}'", index_with_new_root->name()) };
+    }
+    return {};
+}
+
+ErrorOr<void> Database::remove_index_entry(IndexDef& index, Key& entry)
+{
+    auto tree = TRY(get_index_tree(index));
+
+    // FIXME: The BTree cannot remove keys yet, so we leave a tombstone behind instead.
+    entry.set_block_index(0);
+    tree->update_key_pointer(entry);
+    return {};
+}
+
 ErrorOr<Vector<Row>> Database::select_all(TableDef& table)
 {
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
@@ -184,6 +396,39 @@ ErrorOr<Vector<Row>> Database::select_all(TableDef& table)
     return ret;
 }
 
+ErrorOr<Row> Database::read_row(TableDef& table, Block::Index block_index)
+{
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+    return m_serializer.deserialize_block<Row>(block_index, table, block_index);
+}
+
+ResultOr<void> Database::check_unique_constraints(Row const& row)
+{
+    for (auto& index : row.table().indexes()) {
+        if (!index->unique())
+            continue;
+
+        Vector<Value> values;
+        for (auto const& part : index->key_definition())
+            values.append(row[part->name()]);
+
+        // NULL values never conflict with each other.
+        if (any_of(values, [](auto const& value) { return value.is_null(); }))
+            continue;
+
+        auto key = make_index_prefix(*index, values);
+
+        auto tree = TRY(get_index_tree(*index));
+        for (auto it = tree->lower_bound(key); !it.is_end() && (*it).compare(key) == 0; ++it) {
+            auto row_block_index = (*it).block_index();
+            if (row_block_index != 0 && row_block_index != row.block_index())
+                return Result { SQLCommand::Unknown, SQLErrorCode::UniqueConstraintFailed, index->name() };
+        }
+    }
+
+    return {};
+}
+
 ErrorOr<Vector<Row>> Database::match(TableDef& table, Key const& key)
 {
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
@@ -200,20 +445,24 @@ ErrorOr<Vector<Row>> Database::match(TableDef& table, Key const& key)
     return ret;
 }
 
-ErrorOr<void> Database::insert(Row& row)
+ResultOr<void> Database::insert(Row& row)
 {
     VERIFY(m_table_cache.get(row.table().key().hash()).has_value());
     // TODO: implement table constraints such as unique, foreign key, etc.
 
     row.set_block_index(m_heap->request_new_block_index());
     row.set_next_block_index(row.table().block_index());
-    TRY(update(row));
+    TRY(write_row(row));
 
-    // TODO update indexes defined on table.
+    for (auto& index : row.table().indexes()) {
+        auto entry = make_index_entry(*index, row);
+        TRY(insert_index_entry(*index, entry));
+    }
 
     auto table_key = row.table().key();
     table_key.set_block_index(row.block_index());
-    VERIFY(m_tables->update_key_pointer(table_key));
+    if (!m_tables->update_key_pointer(table_key))
+        return Result { SQLCommand::Unknown, SQLErrorCode::InternalError, ByteString::formatted("Could not store the first row of table '{}'", row.table().name()) };
     row.table().set_block_index(row.block_index());
     return {};
 }
@@ -223,6 +472,15 @@ ErrorOr<void> Database::remove(Row& row)
     auto& table = row.table();
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
 
+    // The row may have been read before removing another row relinked it, so trust the stored link only.
+    auto stored_row = TRY(read_row(table, row.block_index()));
+    row.set_next_block_index(stored_row.next_block_index());
+
+    for (auto& index : table.indexes()) {
+        auto entry = make_index_entry(*index, row);
+        TRY(remove_index_entry(*index, entry));
+    }
+
     TRY(m_heap->free_storage(row.block_index()));
 
     if (table.block_index() == row.block_index()) {
@@ -239,7 +497,7 @@ ErrorOr<void> Database::remove(Row& row)
 
         if (current.next_block_index() == row.block_index()) {
             current.set_next_block_index(row.next_block_index());
-            TRY(update(current));
+            TRY(write_row(current));
             break;
         }
 
@@ -249,15 +507,37 @@ ErrorOr<void> Database::remove(Row& row)
     return {};
 }
 
-ErrorOr<void> Database::update(Row& tuple)
+ResultOr<void> Database::update(Row& row)
 {
-    VERIFY(m_table_cache.get(tuple.table().key().hash()).has_value());
+    auto& table = row.table();
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
     // TODO: implement table constraints such as unique, foreign key, etc.
 
-    m_serializer.reset();
-    m_serializer.serialize_and_write<Tuple>(tuple);
+    if (table.indexes().is_empty()) {
+        TRY(write_row(row));
+        return {};
+    }
 
-    // TODO update indexes defined on table.
+    auto old_row = TRY(read_row(table, row.block_index()));
+    TRY(write_row(row));
+
+    for (auto& index : table.indexes()) {
+        auto old_entry = make_index_entry(*index, old_row);
+        auto new_entry = make_index_entry(*index, row);
+        if (old_entry.compare(new_entry) == 0)
+            continue;
+
+        TRY(remove_index_entry(*index, old_entry));
+        TRY(insert_index_entry(*index, new_entry));
+    }
+
+    return {};
+}
+
+ErrorOr<void> Database::write_row(Row& row)
+{
+    m_serializer.reset();
+    m_serializer.serialize_and_write<Tuple>(row);
     return {};
 }
 
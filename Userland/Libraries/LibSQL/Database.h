@@ -8,8 +8,10 @@
 #pragma once
 
 #include <AK/ByteString.h>
+#include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefPtr.h>
+#include <AK/Vector.h>
 #include <LibSQL/Forward.h>
 #include <LibSQL/Heap.h>
 #include <LibSQL/Meta.h>
@@ -31,6 +33,10 @@ public:
     ResultOr<void> open();
     bool is_open() const { return m_open; }
     ErrorOr<void> commit();
+
+    // See Heap::set_group_commit_enabled().
+    void set_group_commit_enabled(bool enabled) { m_heap->set_group_commit_enabled(enabled); }
+    ErrorOr<void> sync();
     ErrorOr<size_t> file_size_in_bytes() const { return m_heap->file_size_in_bytes(); }
 
     ResultOr<void> add_schema(SchemaDef const&);
@@ -41,24 +47,42 @@ public:
     static Key get_table_key(ByteString const&, ByteString const&);
     ResultOr<NonnullRefPtr<TableDef>> get_table(ByteString const&, ByteString const&);
 
+    ResultOr<void> add_index(TableDef&, IndexDef&);
+    ErrorOr<NonnullRefPtr<BTree>> get_index_tree(IndexDef&);
+    static NonnullRefPtr<TupleDescriptor> index_entry_descriptor(IndexDef const&);
+    static Value index_key_value(Value const&, SQLType);
+    static Key make_index_prefix(IndexDef const&, ReadonlySpan<Value>);
+    static bool has_null_key_part(IndexDef const&, Key const& entry);
+
     ErrorOr<Vector<Row>> select_all(TableDef&);
     ErrorOr<Vector<Row>> match(TableDef&, Key const&);
-    ErrorOr<void> insert(Row&);
+    ErrorOr<Row> read_row(TableDef&, Block::Index);
+    ResultOr<void> check_unique_constraints(Row const&);
+    ResultOr<void> insert(Row&);
     ErrorOr<void> remove(Row&);
-    ErrorOr<void> update(Row&);
+    ResultOr<void> update(Row&);
 
 private:
     explicit Database(NonnullRefPtr<Heap>);
 
+    ErrorOr<void> write_row(Row&);
+    Key make_index_entry(IndexDef const&, Row const&) const;
+    ResultOr<void> insert_index_entry(IndexDef&, Key&);
+    ErrorOr<void> remove_index_entry(IndexDef&, Key&);
+
     bool m_open { false };
     NonnullRefPtr<Heap> m_heap;
     Serializer m_serializer;
     RefPtr<BTree> m_schemas;
     RefPtr<BTree> m_tables;
     RefPtr<BTree> m_table_columns;
+    RefPtr<BTree> m_table_indexes;
 
     HashMap<u32, NonnullRefPtr<SchemaDef>> m_schema_cache;
     HashMap<u32, NonnullRefPtr<TableDef>> m_table_cache;
+    HashMap<u32, NonnullRefPtr<BTree>> m_index_trees;
+    // Indexes whose tree got a new root that isn't stored in their definition yet.
+    Vector<NonnullRefPtr<IndexDef>> m_indexes_with_new_root;
 };
 
 }
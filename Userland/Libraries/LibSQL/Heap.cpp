@@ -8,28 +8,48 @@
 #include <AK/ByteString.h>
 #include <AK/Format.h>
 #include <AK/QuickSort.h>
+#include <AK/StdLibExtras.h>
 #include <LibCore/System.h>
 #include <LibSQL/Heap.h>
 #include <sys/stat.h>
 
 namespace SQL {
 
-ErrorOr<NonnullRefPtr<Heap>> Heap::create(ByteString file_name)
+constexpr static auto FILE_ID = "SerenitySQL "sv;
+constexpr static auto VERSION_OFFSET = FILE_ID.length();
+constexpr static auto PAGE_SIZE_OFFSET = VERSION_OFFSET + sizeof(u32);
+constexpr static auto SCHEMAS_ROOT_OFFSET = PAGE_SIZE_OFFSET + sizeof(u32);
+constexpr static auto TABLES_ROOT_OFFSET = SCHEMAS_ROOT_OFFSET + sizeof(u32);
+constexpr static auto TABLE_COLUMNS_ROOT_OFFSET = TABLES_ROOT_OFFSET + sizeof(u32);
+constexpr static auto TABLE_INDEXES_ROOT_OFFSET = TABLE_COLUMNS_ROOT_OFFSET + sizeof(u32);
+constexpr static auto USER_VALUES_OFFSET = TABLE_INDEXES_ROOT_OFFSET + sizeof(u32);
+
+ErrorOr<NonnullRefPtr<Heap>> Heap::create(ByteString file_name, u32 page_size, size_t buffer_pool_pages)
 {
-    return adopt_nonnull_ref_or_enomem(new (nothrow) Heap(move(file_name)));
+    if (page_size < Heap::MIN_PAGE_SIZE || page_size > Heap::MAX_PAGE_SIZE || !is_power_of_two(page_size))
+        return Error::from_string_literal("Heap::create(): page size must be a power of two between 512 and 65536 bytes");
+    return adopt_nonnull_ref_or_enomem(new (nothrow) Heap(move(file_name), page_size, buffer_pool_pages));
 }
 
-Heap::Heap(ByteString file_name)
+Heap::Heap(ByteString file_name, u32 page_size, size_t buffer_pool_pages)
     : m_name(move(file_name))
+    , m_page_size(page_size)
+    , m_buffer_pool_pages(buffer_pool_pages)
 {
 }
 
 Heap::~Heap()
 {
-    if (m_file && !m_write_ahead_log.is_empty()) {
-        if (auto maybe_error = flush(); maybe_error.is_error())
-            warnln("~Heap({}): {}", name(), maybe_error.error());
+    if (!m_buffer_pool)
+        return;
+
+    if (auto maybe_error = flush(); maybe_error.is_error()) {
+        warnln("~Heap({}): {}", name(), maybe_error.error());
+        return;
     }
+
+    // Everything made it into the database file, so the write-ahead log has nothing left to offer.
+    (void)Core::System::unlink(wal_name());
 }
 
 ErrorOr<void> Heap::open()
@@ -50,54 +70,116 @@ ErrorOr<void> Heap::open()
         file_size = stat_buffer.st_size;
     }
 
-    if (file_size > 0) {
-        m_next_block = file_size / Block::SIZE;
-        m_highest_block_written = m_next_block - 1;
-    }
-
-    auto file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
-    m_file = TRY(Core::InputBufferedFile::create(move(file)));
+    m_file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
 
     if (file_size > 0) {
-        if (auto error_maybe = read_zero_block(); error_maybe.is_error()) {
+        if (auto error_maybe = read_header_from_file(); error_maybe.is_error()) {
             m_file = nullptr;
             return error_maybe.release_error();
         }
+
+        // FIXME: We should more gracefully handle version incompatibilities. For now, we drop the database.
+        if (m_version != VERSION) {
+            dbgln_if(SQL_DEBUG, "Heap file {} opened has incompatible version {}. Deleting for version {}.", name(), m_version, VERSION);
+            m_file = nullptr;
+            m_version = VERSION;
+
+            TRY(Core::System::unlink(name()));
+            if (auto result = Core::System::unlink(wal_name()); result.is_error() && result.error().code() != ENOENT)
+                return result.release_error();
+            return open();
+        }
+
+        if (file_size < m_page_size) {
+            m_file = nullptr;
+            return Error::from_string_literal("Heap::open(): Zero page truncated");
+        }
+        m_highest_block_in_file = file_size / m_page_size - 1;
     } else {
-        TRY(initialize_zero_block());
+        TRY(create_file());
     }
 
-    // FIXME: We should more gracefully handle version incompatibilities. For now, we drop the database.
-    if (m_version != VERSION) {
-        dbgln_if(SQL_DEBUG, "Heap file {} opened has incompatible version {}. Deleting for version {}.", name(), m_version, VERSION);
-        m_file = nullptr;
+    m_wal = TRY(WriteAheadLog::open(wal_name(), m_page_size));
+    if (file_size == 0)
+        TRY(m_wal->reset());
 
-        TRY(Core::System::unlink(name()));
-        return open();
-    }
+    m_buffer_pool = make<BufferPool>(
+        m_page_size, m_buffer_pool_pages,
+        [this](Block::Index index, Bytes buffer) { return read_page(index, buffer); },
+        [this](Page const& page) { return m_wal->append_page(page.index(), page.bytes()); });
+
+    m_next_block = max(m_highest_block_in_file, m_wal->highest_page_index().value_or(0)) + 1;
+    TRY(read_zero_block());
+
+    // Whatever the log holds was committed before we were last closed; move it into the database file right away.
+    if (m_wal->committed_page_count() > 0)
+        TRY(checkpoint());
 
     // Perform a heap scan to find all free blocks
     // FIXME: this is very inefficient; store free blocks in a persistent heap structure
-    for (Block::Index index = 1; index <= m_highest_block_written; ++index) {
-        auto block_data = TRY(read_raw_block(index));
-        auto size_in_bytes = *reinterpret_cast<u32*>(block_data.data());
+    auto buffer = TRY(ByteBuffer::create_uninitialized(m_page_size));
+    for (Block::Index index = 1; index < m_next_block; ++index) {
+        TRY(read_page(index, buffer));
+        u32 size_in_bytes;
+        memcpy(&size_in_bytes, buffer.offset_pointer(Block::SIZE_IN_BYTES_OFFSET), sizeof(u32));
         if (size_in_bytes == 0)
             TRY(m_free_block_indices.try_append(index));
     }
 
-    dbgln_if(SQL_DEBUG, "Heap file {} opened; number of blocks = {}; free blocks = {}", name(), m_highest_block_written, m_free_block_indices.size());
+    dbgln_if(SQL_DEBUG, "Heap file {} opened; page size = {}; number of blocks = {}; free blocks = {}", name(), m_page_size, m_next_block - 1, m_free_block_indices.size());
+    return {};
+}
+
+ErrorOr<void> Heap::read_header_from_file()
+{
+    Array<u8, PAGE_SIZE_OFFSET + sizeof(u32)> header;
+    TRY(m_file->seek(0, SeekMode::SetPosition));
+    if (auto result = m_file->read_until_filled(header); result.is_error() || StringView { header.span().trim(FILE_ID.length()) } != FILE_ID) {
+        warnln("{}: Zero page corrupt. This is probably not a {} heap file"sv, name(), FILE_ID);
+        return Error::from_string_literal("Heap()::read_header_from_file(): Zero page corrupt. This is probably not a SerenitySQL heap file");
+    }
+
+    memcpy(&m_version, header.data() + VERSION_OFFSET, sizeof(u32));
+    if (m_version != VERSION)
+        return {};
+
+    u32 page_size;
+    memcpy(&page_size, header.data() + PAGE_SIZE_OFFSET, sizeof(u32));
+    if (page_size < MIN_PAGE_SIZE || page_size > MAX_PAGE_SIZE || !is_power_of_two(page_size))
+        return Error::from_string_literal("Heap()::read_header_from_file(): Invalid page size");
+    m_page_size = page_size;
+    return {};
+}
+
+ErrorOr<void> Heap::create_file()
+{
+    m_version = VERSION;
+    m_schemas_root = 0;
+    m_tables_root = 0;
+    m_table_columns_root = 0;
+    m_table_indexes_root = 0;
+    m_next_block = 1;
+    m_highest_block_in_file = 0;
+    for (auto& user : m_user_values)
+        user = 0u;
+
+    // The zero page goes straight into the file, so that we can always tell the page size from the file alone.
+    auto buffer = TRY(ByteBuffer::create_uninitialized(m_page_size));
+    write_zero_block(buffer);
+    TRY(write_page_to_file(0, buffer));
+    TRY(Core::System::fsync(m_file->fd()));
     return {};
 }
 
 ErrorOr<size_t> Heap::file_size_in_bytes() const
 {
-    TRY(m_file->seek(0, SeekMode::FromEndPosition));
-    return TRY(m_file->tell());
+    auto highest_block = max(m_highest_block_in_file, m_wal->highest_page_index().value_or(0));
+    return (static_cast<size_t>(highest_block) + 1) * m_page_size;
 }
 
 bool Heap::has_block(Block::Index index) const
 {
-    return (index <= m_highest_block_written || m_write_ahead_log.contains(index))
+    return (index <= m_highest_block_in_file || m_wal->contains(index) || m_buffer_pool->contains(index))
         && !m_free_block_indices.contains_slow(index);
 }
 
@@ -115,10 +197,17 @@ ErrorOr<ByteBuffer> Heap::read_storage(Block::Index index)
     // Reconstruct the data storage from a potential chain of blocks
     ByteBuffer data;
     while (index > 0) {
-        auto block = TRY(read_block(index));
-        dbgln_if(SQL_DEBUG, "  -> {} bytes", block.size_in_bytes());
-        TRY(data.try_append(block.data().bytes().slice(0, block.size_in_bytes())));
-        index = block.next_block();
+        VERIFY(index < m_next_block);
+        auto page = TRY(m_buffer_pool->pin(index));
+        auto bytes = page->bytes();
+
+        u32 size_in_bytes;
+        memcpy(&size_in_bytes, bytes.offset(Block::SIZE_IN_BYTES_OFFSET), sizeof(u32));
+        dbgln_if(SQL_DEBUG, "  -> {} bytes", size_in_bytes);
+        VERIFY(size_in_bytes <= block_data_size());
+
+        TRY(data.try_append(bytes.slice(Block::HEADER_SIZE, size_in_bytes)));
+        memcpy(&index, bytes.offset(Block::NEXT_BLOCK_OFFSET), sizeof(Block::Index));
     }
     return data;
 }
@@ -138,28 +227,27 @@ ErrorOr<void> Heap::write_storage(Block::Index index, ReadonlyBytes data)
     u32 offset_in_data = 0;
     Block::Index existing_next_block_index = 0;
     while (remaining_size > 0) {
-        auto block_data_size = AK::min(remaining_size, Block::DATA_SIZE);
+        VERIFY(index < m_next_block);
+        auto block_data_size = AK::min(remaining_size, this->block_data_size());
         remaining_size -= block_data_size;
 
-        ByteBuffer block_data;
-        if (has_block(index)) {
-            auto existing_block = TRY(read_block(index));
-            block_data = existing_block.data();
-            TRY(block_data.try_resize(block_data_size));
-            existing_next_block_index = existing_block.next_block();
-        } else {
-            block_data = TRY(ByteBuffer::create_uninitialized(block_data_size));
-            existing_next_block_index = 0;
-        }
+        // Blocks that never existed before are about to be overwritten in full, so don't bother reading them in.
+        auto page = TRY(has_block(index) ? m_buffer_pool->pin(index) : m_buffer_pool->pin_without_reading(index));
+        auto bytes = page->bytes();
+        memcpy(&existing_next_block_index, bytes.offset(Block::NEXT_BLOCK_OFFSET), sizeof(Block::Index));
 
         Block::Index next_block_index = existing_next_block_index;
         if (next_block_index == 0 && remaining_size > 0)
             next_block_index = request_new_block_index();
         else if (remaining_size == 0)
             next_block_index = 0;
+        VERIFY(next_block_index < m_next_block);
 
-        block_data.bytes().overwrite(0, data.offset(offset_in_data), block_data_size);
-        TRY(write_block({ index, block_data_size, next_block_index, move(block_data) }));
+        bytes.overwrite(Block::SIZE_IN_BYTES_OFFSET, &block_data_size, sizeof(u32));
+        bytes.overwrite(Block::NEXT_BLOCK_OFFSET, &next_block_index, sizeof(Block::Index));
+        bytes.overwrite(Block::HEADER_SIZE, data.offset(offset_in_data), block_data_size);
+        bytes.slice(Block::HEADER_SIZE + block_data_size).fill(0);
+        page->set_dirty();
 
         index = next_block_index;
         offset_in_data += block_data_size;
@@ -172,154 +260,142 @@ ErrorOr<void> Heap::write_storage(Block::Index index, ReadonlyBytes data)
     return {};
 }
 
-ErrorOr<ByteBuffer> Heap::read_raw_block(Block::Index index)
+ErrorOr<void> Heap::free_storage(Block::Index index)
 {
-    VERIFY(m_file);
-    VERIFY(index < m_next_block);
-
-    if (auto wal_entry = m_write_ahead_log.get(index); wal_entry.has_value())
-        return wal_entry.value();
+    dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
+    VERIFY(index > 0);
 
-    TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
-    auto buffer = TRY(ByteBuffer::create_uninitialized(Block::SIZE));
-    TRY(m_file->read_until_filled(buffer));
-    return buffer;
-}
+    while (index > 0) {
+        VERIFY(has_block(index));
+        auto page = TRY(m_buffer_pool->pin(index));
+        auto bytes = page->bytes();
 
-ErrorOr<Block> Heap::read_block(Block::Index index)
-{
-    dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
+        Block::Index next_block_index;
+        memcpy(&next_block_index, bytes.offset(Block::NEXT_BLOCK_OFFSET), sizeof(Block::Index));
 
-    auto buffer = TRY(read_raw_block(index));
-    auto size_in_bytes = *reinterpret_cast<u32*>(buffer.offset_pointer(0));
-    auto next_block = *reinterpret_cast<Block::Index*>(buffer.offset_pointer(sizeof(u32)));
-    auto data = TRY(buffer.slice(Block::HEADER_SIZE, Block::DATA_SIZE));
+        // Zero out freed blocks to facilitate a free block scan upon opening the database later
+        bytes.fill(0);
+        page->set_dirty();
+        TRY(m_free_block_indices.try_append(index));
 
-    return Block { index, size_in_bytes, next_block, move(data) };
+        index = next_block_index;
+    }
+    return {};
 }
 
-ErrorOr<void> Heap::write_raw_block(Block::Index index, ReadonlyBytes data)
+ErrorOr<void> Heap::read_page(Block::Index index, Bytes buffer)
 {
-    dbgln_if(SQL_DEBUG, "Write raw block {}", index);
-
-    VERIFY(m_file);
-    VERIFY(data.size() == Block::SIZE);
+    VERIFY(buffer.size() == m_page_size);
 
-    TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
-    TRY(m_file->write_until_depleted(data));
+    if (m_wal->contains(index))
+        return m_wal->read_page(index, buffer);
 
-    if (index > m_highest_block_written)
-        m_highest_block_written = index;
+    // Pages beyond the end of the file have never been written.
+    if (index > m_highest_block_in_file) {
+        buffer.fill(0);
+        return {};
+    }
 
+    TRY(m_file->seek(static_cast<i64>(index) * m_page_size, SeekMode::SetPosition));
+    TRY(m_file->read_until_filled(buffer));
     return {};
 }
 
-ErrorOr<void> Heap::write_raw_block_to_wal(Block::Index index, ByteBuffer&& data)
+ErrorOr<void> Heap::write_page_to_file(Block::Index index, ReadonlyBytes data)
 {
-    dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
-    VERIFY(index < m_next_block);
-    VERIFY(data.size() == Block::SIZE);
+    dbgln_if(SQL_DEBUG, "Write page {} to file", index);
+    VERIFY(data.size() == m_page_size);
 
-    TRY(m_write_ahead_log.try_set(index, move(data)));
+    TRY(m_file->seek(static_cast<i64>(index) * m_page_size, SeekMode::SetPosition));
+    TRY(m_file->write_until_depleted(data));
 
+    if (index > m_highest_block_in_file)
+        m_highest_block_in_file = index;
     return {};
 }
 
-ErrorOr<void> Heap::write_block(Block const& block)
+ErrorOr<void> Heap::commit()
 {
-    dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, block.index());
-    VERIFY(block.index() < m_next_block);
-    VERIFY(block.next_block() < m_next_block);
-    VERIFY(block.size_in_bytes() > 0);
-    VERIFY(block.data().size() <= Block::DATA_SIZE);
-
-    auto size_in_bytes = block.size_in_bytes();
-    auto next_block = block.next_block();
-
-    auto heap_data = TRY(ByteBuffer::create_zeroed(Block::SIZE));
-    heap_data.overwrite(0, &size_in_bytes, sizeof(size_in_bytes));
-    heap_data.overwrite(sizeof(size_in_bytes), &next_block, sizeof(next_block));
+    VERIFY(m_buffer_pool);
 
-    block.data().bytes().copy_to(heap_data.bytes().slice(Block::HEADER_SIZE));
+    auto dirty_pages = m_buffer_pool->dirty_pages();
+    dbgln_if(SQL_DEBUG, "{}(): {} dirty pages", __FUNCTION__, dirty_pages.size());
+    for (auto* page : dirty_pages) {
+        TRY(m_wal->append_page(page->index(), page->bytes()));
+        m_buffer_pool->mark_clean(*page);
+    }
+    TRY(m_wal->commit());
 
-    return write_raw_block_to_wal(block.index(), move(heap_data));
+    if (m_wal->committed_page_count() >= CHECKPOINT_THRESHOLD_PAGES)
+        TRY(checkpoint());
+    else if (!m_group_commit_enabled)
+        TRY(m_wal->sync());
+    return {};
 }
 
-ErrorOr<void> Heap::free_storage(Block::Index index)
+ErrorOr<void> Heap::sync()
 {
-    dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
-    VERIFY(index > 0);
-
-    while (index > 0) {
-        auto block = TRY(read_block(index));
-        TRY(free_block(block));
-        index = block.next_block();
-    }
-    return {};
+    VERIFY(m_buffer_pool);
+    return m_wal->sync();
 }
 
-ErrorOr<void> Heap::free_block(Block const& block)
+ErrorOr<void> Heap::checkpoint()
 {
-    auto index = block.index();
-    dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
+    VERIFY(!m_wal->has_uncommitted_pages());
 
-    VERIFY(index > 0);
-    VERIFY(has_block(index));
+    auto indices = m_wal->committed_pages();
+    if (indices.is_empty())
+        return {};
+    quick_sort(indices);
 
-    // Zero out freed blocks to facilitate a free block scan upon opening the database later
-    auto zeroed_data = TRY(ByteBuffer::create_zeroed(Block::SIZE));
-    TRY(write_raw_block_to_wal(index, move(zeroed_data)));
+    auto buffer = TRY(ByteBuffer::create_uninitialized(m_page_size));
+    for (auto index : indices) {
+        TRY(m_wal->read_page(index, buffer));
+        TRY(write_page_to_file(index, buffer));
+    }
 
-    return m_free_block_indices.try_append(index);
+    // The log may only forget about these pages once they are safely on disk.
+    TRY(Core::System::fsync(m_file->fd()));
+    TRY(m_wal->reset());
+
+    dbgln_if(SQL_DEBUG, "WAL checkpointed; {} pages; new number of blocks = {}", indices.size(), m_highest_block_in_file);
+    return {};
 }
 
 ErrorOr<void> Heap::flush()
 {
-    VERIFY(m_file);
-    auto indices = m_write_ahead_log.keys();
-    quick_sort(indices);
-    for (auto index : indices) {
-        dbgln_if(SQL_DEBUG, "Flushing block {}", index);
-        auto& data = m_write_ahead_log.get(index).value();
-        TRY(write_raw_block(index, data));
-    }
-    m_write_ahead_log.clear();
-    dbgln_if(SQL_DEBUG, "WAL flushed; new number of blocks = {}", m_highest_block_written);
-    return {};
+    TRY(commit());
+    return checkpoint();
 }
 
-constexpr static auto FILE_ID = "SerenitySQL "sv;
-constexpr static auto VERSION_OFFSET = FILE_ID.length();
-constexpr static auto SCHEMAS_ROOT_OFFSET = VERSION_OFFSET + sizeof(u32);
-constexpr static auto TABLES_ROOT_OFFSET = SCHEMAS_ROOT_OFFSET + sizeof(u32);
-constexpr static auto TABLE_COLUMNS_ROOT_OFFSET = TABLES_ROOT_OFFSET + sizeof(u32);
-constexpr static auto USER_VALUES_OFFSET = TABLE_COLUMNS_ROOT_OFFSET + sizeof(u32);
-
 ErrorOr<void> Heap::read_zero_block()
 {
     dbgln_if(SQL_DEBUG, "Read zero block from {}", name());
 
-    auto block = TRY(read_raw_block(0));
-    auto file_id_buffer = TRY(block.slice(0, FILE_ID.length()));
-    auto file_id = StringView(file_id_buffer);
+    auto page = TRY(m_buffer_pool->pin(0));
+    auto block = page->bytes();
+    auto file_id = StringView(block.trim(FILE_ID.length()));
     if (file_id != FILE_ID) {
         warnln("{}: Zero page corrupt. This is probably not a {} heap file"sv, name(), FILE_ID);
         return Error::from_string_literal("Heap()::read_zero_block(): Zero page corrupt. This is probably not a SerenitySQL heap file");
     }
 
-    memcpy(&m_version, block.offset_pointer(VERSION_OFFSET), sizeof(u32));
+    memcpy(&m_version, block.offset(VERSION_OFFSET), sizeof(u32));
     dbgln_if(SQL_DEBUG, "Version: {}.{}", (m_version & 0xFFFF0000) >> 16, (m_version & 0x0000FFFF));
 
-    memcpy(&m_schemas_root, block.offset_pointer(SCHEMAS_ROOT_OFFSET), sizeof(u32));
+    memcpy(&m_schemas_root, block.offset(SCHEMAS_ROOT_OFFSET), sizeof(u32));
     dbgln_if(SQL_DEBUG, "Schemas root node: {}", m_schemas_root);
 
-    memcpy(&m_tables_root, block.offset_pointer(TABLES_ROOT_OFFSET), sizeof(u32));
+    memcpy(&m_tables_root, block.offset(TABLES_ROOT_OFFSET), sizeof(u32));
     dbgln_if(SQL_DEBUG, "Tables root node: {}", m_tables_root);
 
-    memcpy(&m_table_columns_root, block.offset_pointer(TABLE_COLUMNS_ROOT_OFFSET), sizeof(u32));
+    memcpy(&m_table_columns_root, block.offset(TABLE_COLUMNS_ROOT_OFFSET), sizeof(u32));
     dbgln_if(SQL_DEBUG, "Table columns root node: {}", m_table_columns_root);
 
-    memcpy(m_user_values.data(), block.offset_pointer(USER_VALUES_OFFSET), m_user_values.size() * sizeof(u32));
+    memcpy(&m_table_indexes_root, block.offset(TABLE_INDEXES_ROOT_OFFSET), sizeof(u32));
+    dbgln_if(SQL_DEBUG, "Table indexes root node: {}", m_table_indexes_root);
+
+    memcpy(m_user_values.data(), block.offset(USER_VALUES_OFFSET), m_user_values.size() * sizeof(u32));
     for (auto ix = 0u; ix < m_user_values.size(); ix++) {
         if (m_user_values[ix])
             dbgln_if(SQL_DEBUG, "User value {}: {}", ix, m_user_values[ix]);
@@ -327,41 +403,36 @@ ErrorOr<void> Heap::read_zero_block()
     return {};
 }
 
-ErrorOr<void> Heap::update_zero_block()
+void Heap::write_zero_block(Bytes buffer_bytes)
 {
     dbgln_if(SQL_DEBUG, "Write zero block to {}", name());
     dbgln_if(SQL_DEBUG, "Version: {}.{}", (m_version & 0xFFFF0000) >> 16, (m_version & 0x0000FFFF));
     dbgln_if(SQL_DEBUG, "Schemas root node: {}", m_schemas_root);
     dbgln_if(SQL_DEBUG, "Tables root node: {}", m_tables_root);
     dbgln_if(SQL_DEBUG, "Table Columns root node: {}", m_table_columns_root);
+    dbgln_if(SQL_DEBUG, "Table Indexes root node: {}", m_table_indexes_root);
     for (auto ix = 0u; ix < m_user_values.size(); ix++) {
         if (m_user_values[ix] > 0)
             dbgln_if(SQL_DEBUG, "User value {}: {}", ix, m_user_values[ix]);
     }
 
-    auto buffer = TRY(ByteBuffer::create_zeroed(Block::SIZE));
-    auto buffer_bytes = buffer.bytes();
+    buffer_bytes.fill(0);
     buffer_bytes.overwrite(0, FILE_ID.characters_without_null_termination(), FILE_ID.length());
     buffer_bytes.overwrite(VERSION_OFFSET, &m_version, sizeof(u32));
+    buffer_bytes.overwrite(PAGE_SIZE_OFFSET, &m_page_size, sizeof(u32));
     buffer_bytes.overwrite(SCHEMAS_ROOT_OFFSET, &m_schemas_root, sizeof(u32));
     buffer_bytes.overwrite(TABLES_ROOT_OFFSET, &m_tables_root, sizeof(u32));
     buffer_bytes.overwrite(TABLE_COLUMNS_ROOT_OFFSET, &m_table_columns_root, sizeof(u32));
+    buffer_bytes.overwrite(TABLE_INDEXES_ROOT_OFFSET, &m_table_indexes_root, sizeof(u32));
     buffer_bytes.overwrite(USER_VALUES_OFFSET, m_user_values.data(), m_user_values.size() * sizeof(u32));
-
-    return write_raw_block_to_wal(0, move(buffer));
 }
 
-ErrorOr<void> Heap::initialize_zero_block()
+ErrorOr<void> Heap::update_zero_block()
 {
-    m_version = VERSION;
-    m_schemas_root = 0;
-    m_tables_root = 0;
-    m_table_columns_root = 0;
-    m_next_block = 1;
-    m_highest_block_written = 0;
-    for (auto& user : m_user_values)
-        user = 0u;
-    return update_zero_block();
+    auto page = TRY(m_buffer_pool->pin(0));
+    write_zero_block(page->bytes());
+    page->set_dirty();
+    return {};
 }
 
 }
@@ -10,51 +10,16 @@
 #include <AK/Array.h>
 #include <AK/ByteString.h>
 #include <AK/Debug.h>
-#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/Vector.h>
 #include <LibCore/File.h>
+#include <LibSQL/Block.h>
+#include <LibSQL/BufferPool.h>
+#include <LibSQL/WriteAheadLog.h>
 
 namespace SQL {
 
-/**
- * A Block represents a single discrete chunk of 1024 bytes inside the Heap, and
- * acts as the container format for the actual data we are storing. This structure
- * is used for everything except block 0, the zero / super block.
- *
- * If data needs to be stored that is larger than 1016 bytes, Blocks are chained
- * together by setting the next block index and the data is reconstructed by
- * repeatedly reading blocks until the next block index is 0.
- */
-class Block {
-public:
-    typedef u32 Index;
-
-    static constexpr u32 SIZE = 1024;
-    static constexpr u32 HEADER_SIZE = sizeof(u32) + sizeof(Index);
-    static constexpr u32 DATA_SIZE = SIZE - HEADER_SIZE;
-
-    Block(Index index, u32 size_in_bytes, Index next_block, ByteBuffer data)
-        : m_index(index)
-        , m_size_in_bytes(size_in_bytes)
-        , m_next_block(next_block)
-        , m_data(move(data))
-    {
-        VERIFY(index > 0);
-    }
-
-    Index index() const { return m_index; }
-    u32 size_in_bytes() const { return m_size_in_bytes; }
-    Index next_block() const { return m_next_block; }
-    ByteBuffer const& data() const { return m_data; }
-
-private:
-    Index m_index;
-    u32 m_size_in_bytes;
-    Index m_next_block;
-    ByteBuffer m_data;
-};
-
 /**
  * A Heap is a logical container for database (SQL) data. Conceptually a
  * Heap can be a database file, or a memory block, or another storage medium.
@@ -63,19 +28,39 @@ private:
  *
  * A Heap can be thought of the backing storage of a single database. It's
  * assumed that a single SQL database is backed by a single Heap.
+ *
+ * Pages are accessed through a BufferPool. Changed pages are written to the
+ * WriteAheadLog when the Heap commits, and are only copied into the database
+ * file itself when the log is checkpointed.
  */
 class Heap : public RefCounted<Heap> {
 public:
-    static constexpr u32 VERSION = 5;
+    static constexpr u32 VERSION = 7;
+
+    static constexpr u32 DEFAULT_PAGE_SIZE = 4096;
+    static constexpr u32 MIN_PAGE_SIZE = 512;
+    static constexpr u32 MAX_PAGE_SIZE = 64 * KiB;
+    static constexpr size_t DEFAULT_BUFFER_POOL_PAGES = 1024;
 
-    static ErrorOr<NonnullRefPtr<Heap>> create(ByteString);
+    // Once the write-ahead log holds this many pages, a commit also checkpoints the log.
+    static constexpr size_t CHECKPOINT_THRESHOLD_PAGES = 1000;
+
+    // The page size is only used when creating a new database file; existing files keep their own page size.
+    static ErrorOr<NonnullRefPtr<Heap>> create(ByteString, u32 page_size = DEFAULT_PAGE_SIZE, size_t buffer_pool_pages = DEFAULT_BUFFER_POOL_PAGES);
     virtual ~Heap();
 
     ByteString const& name() const { return m_name; }
+    ByteString wal_name() const { return ByteString::formatted("{}-wal", m_name); }
 
     ErrorOr<void> open();
     ErrorOr<size_t> file_size_in_bytes() const;
 
+    u32 page_size() const { return m_page_size; }
+    u32 block_data_size() const { return m_page_size - Block::HEADER_SIZE; }
+
+    BufferPool::Statistics const& buffer_pool_statistics() const { return m_buffer_pool->statistics(); }
+    size_t wal_fsync_count() const { return m_wal->fsync_count(); }
+
     [[nodiscard]] bool has_block(Block::Index) const;
     [[nodiscard]] Block::Index request_new_block_index();
 
@@ -102,6 +87,14 @@ public:
         m_table_columns_root = root;
         update_zero_block().release_value_but_fixme_should_propagate_errors();
     }
+
+    Block::Index table_indexes_root() const { return m_table_indexes_root; }
+
+    void set_table_indexes_root(Block::Index root)
+    {
+        m_table_indexes_root = root;
+        update_zero_block().release_value_but_fixme_should_propagate_errors();
+    }
     u32 version() const { return m_version; }
 
     u32 user_value(size_t index) const
@@ -119,34 +112,48 @@ public:
     ErrorOr<void> write_storage(Block::Index, ReadonlyBytes);
     ErrorOr<void> free_storage(Block::Index);
 
+    // Makes all changes so far durable by appending them to the write-ahead log.
+    ErrorOr<void> commit();
+
+    // With group commit, commit() only appends the changes to the write-ahead log. They become durable once sync()
+    // is called, which takes care of all commits since the previous sync() at once. Until then, a crash may lose them.
+    [[nodiscard]] bool is_group_commit_enabled() const { return m_group_commit_enabled; }
+    void set_group_commit_enabled(bool enabled) { m_group_commit_enabled = enabled; }
+    ErrorOr<void> sync();
+
+    // Commits, and then copies all committed pages into the database file.
     ErrorOr<void> flush();
 
 private:
-    explicit Heap(ByteString);
+    Heap(ByteString, u32 page_size, size_t buffer_pool_pages);
 
-    ErrorOr<ByteBuffer> read_raw_block(Block::Index);
-    ErrorOr<void> write_raw_block(Block::Index, ReadonlyBytes);
-    ErrorOr<void> write_raw_block_to_wal(Block::Index, ByteBuffer&&);
+    ErrorOr<void> read_header_from_file();
+    ErrorOr<void> create_file();
 
-    ErrorOr<Block> read_block(Block::Index);
-    ErrorOr<void> write_block(Block const&);
-    ErrorOr<void> free_block(Block const&);
+    ErrorOr<void> read_page(Block::Index, Bytes);
+    ErrorOr<void> write_page_to_file(Block::Index, ReadonlyBytes);
+    ErrorOr<void> checkpoint();
 
     ErrorOr<void> read_zero_block();
-    ErrorOr<void> initialize_zero_block();
+    void write_zero_block(Bytes);
     ErrorOr<void> update_zero_block();
 
     ByteString m_name;
-
-    OwnPtr<Core::InputBufferedFile> m_file;
-    Block::Index m_highest_block_written { 0 };
+    u32 m_page_size { DEFAULT_PAGE_SIZE };
+    size_t m_buffer_pool_pages { DEFAULT_BUFFER_POOL_PAGES };
+
+    OwnPtr<Core::File> m_file;
+    OwnPtr<WriteAheadLog> m_wal;
+    OwnPtr<BufferPool> m_buffer_pool;
+    bool m_group_commit_enabled { false };
+    Block::Index m_highest_block_in_file { 0 };
     Block::Index m_next_block { 1 };
     Block::Index m_schemas_root { 0 };
     Block::Index m_tables_root { 0 };
     Block::Index m_table_columns_root { 0 };
+    Block::Index m_table_indexes_root { 0 };
     u32 m_version { VERSION };
     Array<u32, 16> m_user_values { 0 };
-    HashMap<Block::Index, ByteBuffer> m_write_ahead_log;
     Vector<Block::Index> m_free_block_indices;
 };
 
@@ -114,10 +114,12 @@ public:
     bool unique() const { return m_unique; }
     [[nodiscard]] size_t size() const { return m_key_definition.size(); }
     void append_column(ByteString, SQLType, Order = Order::Ascending);
+    void append_column(Key const&);
     Key key() const override;
     [[nodiscard]] NonnullRefPtr<TupleDescriptor> to_tuple_descriptor() const;
     static NonnullRefPtr<IndexDef> index_def();
     static Key make_key(TableDef const& table_def);
+    Key make_key_part_key() const;
 
 private:
     IndexDef(TableDef*, ByteString, bool unique, u32 pointer);
@@ -135,6 +137,7 @@ public:
     Key key() const override;
     void append_column(ByteString, SQLType);
     void append_column(Key const&);
+    void append_index(NonnullRefPtr<IndexDef>);
     size_t num_columns() { return m_columns.size(); }
     size_t num_indexes() { return m_indexes.size(); }
     Vector<NonnullRefPtr<ColumnDef>> const& columns() const { return m_columns; }
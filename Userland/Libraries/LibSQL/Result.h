@@ -19,6 +19,7 @@ namespace SQL {
     S(Create)                     \
     S(Delete)                     \
     S(Describe)                   \
+    S(Explain)                    \
     S(Insert)                     \
     S(Select)                     \
     S(Update)
@@ -48,6 +49,7 @@ constexpr char const* command_tag(SQLCommand command)
     S(ColumnDoesNotExist, "Column '{}' does not exist")                                           \
     S(DatabaseDoesNotExist, "Database '{}' does not exist")                                       \
     S(DatabaseUnavailable, "Database Unavailable")                                                \
+    S(IndexExists, "Index '{}' already exist")                                                    \
     S(IntegerOperatorTypeMismatch, "Cannot apply '{}' operator to non-numeric operands")          \
     S(IntegerOverflow, "Operation would cause integer overflow")                                  \
     S(InternalError, "{}")                                                                        \
@@ -65,7 +67,8 @@ constexpr char const* command_tag(SQLCommand command)
     S(StatementUnavailable, "Statement with id '{}' Unavailable")                                 \
     S(SyntaxError, "Syntax Error")                                                                \
     S(TableDoesNotExist, "Table '{}' does not exist")                                             \
-    S(TableExists, "Table '{}' already exist")
+    S(TableExists, "Table '{}' already exist")                                                    \
+    S(UniqueConstraintFailed, "Unique constraint of index '{}' failed")
 
 enum class SQLErrorCode {
 #undef __ENUMERATE_SQL_ERROR
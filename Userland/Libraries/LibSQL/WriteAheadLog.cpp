@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Random.h>
+#include <LibCore/System.h>
+#include <LibSQL/WriteAheadLog.h>
+
+namespace SQL {
+
+static constexpr auto FILE_ID = "SerenitySQL WAL "sv;
+static constexpr auto VERSION_OFFSET = FILE_ID.length();
+static constexpr auto PAGE_SIZE_OFFSET = VERSION_OFFSET + sizeof(u32);
+static constexpr auto SALT_OFFSET = PAGE_SIZE_OFFSET + sizeof(u32);
+
+// Write out buffered records once they take up this much memory, even if nobody is committing yet.
+static constexpr size_t MAX_BUFFERED_RECORDS_SIZE = 1 * MiB;
+
+static u32 checksum_words(u32 seed, ReadonlyBytes bytes)
+{
+    VERIFY(bytes.size() % sizeof(u32) == 0);
+
+    u32 first = seed;
+    u32 second = ~seed;
+    for (size_t offset = 0; offset < bytes.size(); offset += sizeof(u32)) {
+        u32 word;
+        memcpy(&word, bytes.offset(offset), sizeof(word));
+        first += word + second;
+        second += first;
+    }
+    return first ^ second;
+}
+
+ErrorOr<NonnullOwnPtr<WriteAheadLog>> WriteAheadLog::open(ByteString path, u32 page_size)
+{
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::ReadWrite));
+    auto log = TRY(adopt_nonnull_own_or_enomem(new (nothrow) WriteAheadLog(move(path), move(file), page_size)));
+    TRY(log->recover());
+    return log;
+}
+
+WriteAheadLog::WriteAheadLog(ByteString path, NonnullOwnPtr<Core::File> file, u32 page_size)
+    : m_path(move(path))
+    , m_file(move(file))
+    , m_page_size(page_size)
+{
+}
+
+ErrorOr<void> WriteAheadLog::recover()
+{
+    auto file_size = TRY(m_file->size());
+    if (file_size < FILE_HEADER_SIZE)
+        return reset();
+
+    Array<u8, FILE_HEADER_SIZE> file_header;
+    TRY(m_file->seek(0, SeekMode::SetPosition));
+    TRY(m_file->read_until_filled(file_header));
+
+    u32 version;
+    u32 page_size;
+    memcpy(&version, file_header.data() + VERSION_OFFSET, sizeof(u32));
+    memcpy(&page_size, file_header.data() + PAGE_SIZE_OFFSET, sizeof(u32));
+    memcpy(&m_salt, file_header.data() + SALT_OFFSET, sizeof(u32));
+    if (StringView { file_header.span().trim(FILE_ID.length()) } != FILE_ID || version != VERSION || page_size != m_page_size) {
+        dbgln_if(SQL_DEBUG, "WAL {} does not belong to this heap, discarding it", m_path);
+        return reset();
+    }
+
+    // Replay the records, but only believe page records once a commit record vouches for them.
+    HashMap<Block::Index, u64> pages_since_last_commit;
+    auto data = TRY(ByteBuffer::create_uninitialized(m_page_size));
+    u64 offset = FILE_HEADER_SIZE;
+    u64 end_of_last_commit = offset;
+    u32 running_checksum = m_salt;
+    m_last_checksum = m_salt;
+
+    while (offset + RECORD_HEADER_SIZE <= file_size) {
+        RecordHeader header;
+        TRY(m_file->seek(offset, SeekMode::SetPosition));
+        TRY(m_file->read_until_filled({ &header, sizeof(header) }));
+        if (header.salt != m_salt)
+            break;
+
+        ReadonlyBytes record_data;
+        if (header.type == RecordType::Page) {
+            if (offset + RECORD_HEADER_SIZE + m_page_size > file_size)
+                break;
+            TRY(m_file->read_until_filled(data));
+            record_data = data;
+        } else if (header.type != RecordType::Commit) {
+            break;
+        }
+
+        m_last_checksum = running_checksum;
+        if (checksum(header, record_data) != header.checksum)
+            break;
+        running_checksum = header.checksum;
+
+        if (header.type == RecordType::Page) {
+            TRY(pages_since_last_commit.try_set(header.page_index, offset + RECORD_HEADER_SIZE));
+        } else {
+            for (auto& it : pages_since_last_commit)
+                TRY(m_committed_pages.try_set(it.key, it.value));
+            pages_since_last_commit.clear();
+            end_of_last_commit = offset + RECORD_HEADER_SIZE;
+        }
+        offset += RECORD_HEADER_SIZE + record_data.size();
+    }
+
+    // Pick up from the last commit, and throw away whatever came after it.
+    m_last_checksum = m_salt;
+    if (end_of_last_commit > FILE_HEADER_SIZE) {
+        RecordHeader last_commit;
+        TRY(m_file->seek(end_of_last_commit - RECORD_HEADER_SIZE, SeekMode::SetPosition));
+        TRY(m_file->read_until_filled({ &last_commit, sizeof(last_commit) }));
+        m_last_checksum = last_commit.checksum;
+    }
+    if (end_of_last_commit < file_size)
+        TRY(m_file->truncate(end_of_last_commit));
+    m_buffered_records_offset = end_of_last_commit;
+
+    dbgln_if(SQL_DEBUG, "WAL {} recovered; {} committed pages", m_path, m_committed_pages.size());
+    return {};
+}
+
+ErrorOr<void> WriteAheadLog::write_file_header()
+{
+    Array<u8, FILE_HEADER_SIZE> file_header {};
+    memcpy(file_header.data(), FILE_ID.characters_without_null_termination(), FILE_ID.length());
+    memcpy(file_header.data() + VERSION_OFFSET, &VERSION, sizeof(u32));
+    memcpy(file_header.data() + PAGE_SIZE_OFFSET, &m_page_size, sizeof(u32));
+    memcpy(file_header.data() + SALT_OFFSET, &m_salt, sizeof(u32));
+
+    TRY(m_file->seek(0, SeekMode::SetPosition));
+    TRY(m_file->write_until_depleted(file_header));
+    return {};
+}
+
+Optional<Block::Index> WriteAheadLog::highest_page_index() const
+{
+    Optional<Block::Index> highest;
+    auto visit = [&](auto const& pages) {
+        for (auto& it : pages) {
+            if (!highest.has_value() || it.key > *highest)
+                highest = it.key;
+        }
+    };
+    visit(m_committed_pages);
+    visit(m_uncommitted_pages);
+    return highest;
+}
+
+Vector<Block::Index> WriteAheadLog::committed_pages() const
+{
+    return m_committed_pages.keys();
+}
+
+u32 WriteAheadLog::checksum(RecordHeader const& header, ReadonlyBytes data) const
+{
+    auto header_bytes = ReadonlyBytes { &header, offsetof(RecordHeader, checksum) };
+    return checksum_words(checksum_words(m_last_checksum, header_bytes), data);
+}
+
+ErrorOr<void> WriteAheadLog::read_page(Block::Index index, Bytes buffer)
+{
+    VERIFY(buffer.size() == m_page_size);
+
+    auto offset = m_uncommitted_pages.get(index);
+    if (!offset.has_value())
+        offset = m_committed_pages.get(index);
+    VERIFY(offset.has_value());
+
+    if (*offset >= m_buffered_records_offset) {
+        m_buffered_records.span().slice(*offset - m_buffered_records_offset, m_page_size).copy_to(buffer);
+        return {};
+    }
+
+    TRY(m_file->seek(*offset, SeekMode::SetPosition));
+    TRY(m_file->read_until_filled(buffer));
+    return {};
+}
+
+ErrorOr<void> WriteAheadLog::append_record(RecordType type, Block::Index page_index, ReadonlyBytes data)
+{
+    RecordHeader header { type, page_index, m_salt, 0 };
+    header.checksum = checksum(header, data);
+
+    auto record_offset = m_buffered_records_offset + m_buffered_records.size();
+    TRY(m_buffered_records.try_append(reinterpret_cast<u8 const*>(&header), sizeof(header)));
+    TRY(m_buffered_records.try_append(data.data(), data.size()));
+    m_last_checksum = header.checksum;
+
+    if (type == RecordType::Page)
+        TRY(m_uncommitted_pages.try_set(page_index, record_offset + RECORD_HEADER_SIZE));
+    return {};
+}
+
+ErrorOr<void> WriteAheadLog::append_page(Block::Index index, ReadonlyBytes page)
+{
+    dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
+    VERIFY(page.size() == m_page_size);
+
+    TRY(append_record(RecordType::Page, index, page));
+    if (m_buffered_records.size() >= MAX_BUFFERED_RECORDS_SIZE)
+        TRY(write_buffered_records());
+    return {};
+}
+
+ErrorOr<void> WriteAheadLog::write_buffered_records()
+{
+    if (m_buffered_records.is_empty())
+        return {};
+
+    TRY(m_file->seek(m_buffered_records_offset, SeekMode::SetPosition));
+    TRY(m_file->write_until_depleted(m_buffered_records));
+    m_buffered_records_offset += m_buffered_records.size();
+    m_buffered_records.clear_with_capacity();
+    return {};
+}
+
+ErrorOr<void> WriteAheadLog::commit()
+{
+    if (m_uncommitted_pages.is_empty())
+        return {};
+
+    dbgln_if(SQL_DEBUG, "{}(): {} pages", __FUNCTION__, m_uncommitted_pages.size());
+    TRY(append_record(RecordType::Commit, 0, {}));
+    TRY(write_buffered_records());
+    ++m_unsynced_commit_count;
+
+    for (auto& it : m_uncommitted_pages)
+        TRY(m_committed_pages.try_set(it.key, it.value));
+    m_uncommitted_pages.clear();
+    return {};
+}
+
+ErrorOr<void> WriteAheadLog::sync()
+{
+    if (m_unsynced_commit_count == 0)
+        return {};
+
+    dbgln_if(SQL_DEBUG, "{}(): {} commits", __FUNCTION__, m_unsynced_commit_count);
+    TRY(Core::System::fsync(m_file->fd()));
+    ++m_fsync_count;
+    m_unsynced_commit_count = 0;
+    return {};
+}
+
+ErrorOr<void> WriteAheadLog::reset()
+{
+    VERIFY(m_uncommitted_pages.is_empty());
+
+    // A new salt makes sure that nothing left over from before can pass for a record of the new log.
+    m_salt = get_random<u32>();
+    m_last_checksum = m_salt;
+    m_committed_pages.clear();
+    m_buffered_records.clear_with_capacity();
+    // The database file now holds everything that was committed, which is as durable as it gets.
+    m_unsynced_commit_count = 0;
+
+    TRY(m_file->truncate(0));
+    TRY(write_file_header());
+    m_buffered_records_offset = FILE_HEADER_SIZE;
+    return {};
+}
+
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+#include <LibCore/File.h>
+#include <LibSQL/Block.h>
+
+namespace SQL {
+
+/**
+ * The WriteAheadLog is an append-only file next to the Heap's database file, holding
+ * copies of pages that have been changed but not yet copied into the database file.
+ *
+ * The log starts with a header, followed by records: a page record holds a full copy
+ * of a single page, and a commit record makes all page records before it durable.
+ * Every record carries a checksum over itself and all records before it, so on open
+ * we only believe the log up to the last intact commit record; anything after it was
+ * never committed and is thrown away.
+ *
+ * Records are gathered in memory and written out with a single write() when
+ * committing. Commits only become durable once the log is synced, which makes all
+ * commits since the previous sync durable with a single fsync(). Committing and then
+ * syncing right away costs one fsync() per commit, however many pages it touches;
+ * syncing once for a group of commits shares that cost between all of them. When the
+ * Heap checkpoints, it copies the committed pages into the database file and resets
+ * the log.
+ */
+class WriteAheadLog {
+public:
+    static constexpr u32 VERSION = 1;
+
+    static ErrorOr<NonnullOwnPtr<WriteAheadLog>> open(ByteString path, u32 page_size);
+
+    ByteString const& path() const { return m_path; }
+    u32 page_size() const { return m_page_size; }
+
+    [[nodiscard]] bool contains(Block::Index index) const { return m_uncommitted_pages.contains(index) || m_committed_pages.contains(index); }
+    [[nodiscard]] bool has_uncommitted_pages() const { return !m_uncommitted_pages.is_empty(); }
+    [[nodiscard]] size_t committed_page_count() const { return m_committed_pages.size(); }
+    Optional<Block::Index> highest_page_index() const;
+    Vector<Block::Index> committed_pages() const;
+
+    ErrorOr<void> read_page(Block::Index, Bytes);
+    ErrorOr<void> append_page(Block::Index, ReadonlyBytes);
+    ErrorOr<void> commit();
+
+    // Makes all commits so far durable.
+    ErrorOr<void> sync();
+    [[nodiscard]] bool has_unsynced_commits() const { return m_unsynced_commit_count > 0; }
+
+    // Empties the log, once all committed pages have safely made it into the database file.
+    ErrorOr<void> reset();
+
+    size_t fsync_count() const { return m_fsync_count; }
+
+private:
+    enum class RecordType : u32 {
+        Page = 1,
+        Commit = 2,
+    };
+
+    struct RecordHeader {
+        RecordType type;
+        Block::Index page_index;
+        u32 salt;
+        u32 checksum;
+    };
+
+    static constexpr size_t FILE_HEADER_SIZE = 32;
+    static constexpr size_t RECORD_HEADER_SIZE = sizeof(RecordHeader);
+
+    WriteAheadLog(ByteString path, NonnullOwnPtr<Core::File>, u32 page_size);
+
+    ErrorOr<void> recover();
+    ErrorOr<void> write_file_header();
+    ErrorOr<void> append_record(RecordType, Block::Index, ReadonlyBytes data);
+    ErrorOr<void> write_buffered_records();
+    u32 checksum(RecordHeader const&, ReadonlyBytes data) const;
+
+    ByteString m_path;
+    NonnullOwnPtr<Core::File> m_file;
+    u32 m_page_size { 0 };
+    u32 m_salt { 0 };
+    u32 m_last_checksum { 0 };
+
+    // Records that have not been written to the file yet, starting at m_buffered_records_offset.
+    Vector<u8> m_buffered_records;
+    u64 m_buffered_records_offset { 0 };
+
+    // File offsets of the most recent copy of each page.
+    HashMap<Block::Index, u64> m_committed_pages;
+    HashMap<Block::Index, u64> m_uncommitted_pages;
+
+    size_t m_unsynced_commit_count { 0 };
+    size_t m_fsync_count { 0 };
+};
+
+}
@@ -301,6 +301,8 @@ inline JSFileResult TestRunner::run_file_test(ByteString const& test_path)
     g_vm->pop_execution_context();
 
     g_vm->heap().set_should_collect_on_every_allocation(g_collect_on_every_allocation);
+    // Minor collections are off by default, but the tests should still cover them and their write barriers.
+    g_vm->heap().set_generational_collection_enabled(true);
 
     if (g_run_file) {
         auto result = g_run_file(test_path, *realm, global_execution_context);
@@ -92,6 +92,7 @@ int main(int argc, char** argv)
 #endif
     bool print_json = false;
     bool per_file = false;
+    bool enable_jit = false;
     StringView specified_test_root;
     ByteString common_path;
     ByteString test_glob;
@@ -118,6 +119,7 @@ int main(int argc, char** argv)
     args_parser.add_option(per_file, "Show detailed per-file results as JSON (implies -j)", "per-file");
     args_parser.add_option(g_collect_on_every_allocation, "Collect garbage after every allocation", "collect-often", 'g');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(enable_jit, "Compile all code to native code before running it", "jit");
     args_parser.add_option(test_glob, "Only run tests matching the given glob", "filter", 'f', "glob");
     for (auto& entry : g_extra_args)
         args_parser.add_option(*entry.key, entry.value.get<0>().characters(), entry.value.get<1>().characters(), entry.value.get<2>());
@@ -128,6 +130,11 @@ int main(int argc, char** argv)
     if (per_file)
         print_json = true;
 
+    if (enable_jit) {
+        JS::Bytecode::g_jit_enabled = true;
+        JS::Bytecode::g_jit_hotness_threshold = 0;
+    }
+
     test_glob = ByteString::formatted("*{}*", test_glob);
 
     if (getenv("DISABLE_DBG_OUTPUT")) {
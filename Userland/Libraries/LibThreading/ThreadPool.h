@@ -35,8 +35,10 @@ struct ThreadPoolLooper {
             if (!wait)
                 return IterationDecision::Continue;
 
+            // Look again with the mutex held, as work submitted before we started waiting would not wake us up.
             pool.m_mutex.lock();
-            pool.m_work_available.wait();
+            if (!pool.m_should_exit && pool.m_work_queue.with_locked([](auto& queue) { return queue.is_empty(); }))
+                pool.m_work_available.wait();
             pool.m_mutex.unlock();
         }
 
@@ -86,7 +88,7 @@ public:
     void request_exit()
     {
         m_should_exit.store(true, AK::MemoryOrder::memory_order_release);
-        m_work_available.broadcast();
+        notify_work_available();
     }
 
     bool was_exit_requested() const
@@ -99,7 +101,7 @@ public:
         m_work_queue.with_locked([&](auto& queue) {
             queue.enqueue({ move(work) });
         });
-        m_work_available.broadcast();
+        notify_work_available();
     }
 
     void wait_for_all()
@@ -120,6 +122,12 @@ public:
     }
 
 private:
+    void notify_work_available()
+    {
+        MutexLocker locker(m_mutex);
+        m_work_available.broadcast();
+    }
+
     template<typename... Args>
     void initialize_workers(size_t concurrency, Args&&... looper_args)
     {
@@ -59,7 +59,8 @@ WebIDL::ExceptionOr<ImportMap> parse_import_map_string(JS::Realm& realm, ByteStr
     }
 
     // 7. If parsed's keys contains any items besides "imports" or "scopes", then the user agent should report a warning to the console indicating that an invalid top-level key was present in the import map.
-    for (auto& key : parsed_object.shape().property_table().keys()) {
+    for (auto& it : parsed_object.shape().property_table()) {
+        auto const& key = it.key;
         if (key.as_string().is_one_of("imports", "scopes"))
             continue;
 
@@ -107,7 +108,8 @@ WebIDL::ExceptionOr<ModuleSpecifierMap> sort_and_normalise_module_specifier_map(
     ModuleSpecifierMap normalised;
 
     // 2. For each specifierKey → value of originalMap:
-    for (auto& specifier_key : original_map.shape().property_table().keys()) {
+    for (auto& it : original_map.shape().property_table()) {
+        auto const& specifier_key = it.key;
         auto value = TRY(original_map.get(specifier_key.as_string()));
 
         // 1. Let normalizedSpecifierKey be the result of normalizing a specifier key given specifierKey and baseURL.
@@ -177,7 +179,8 @@ WebIDL::ExceptionOr<HashMap<URL::URL, ModuleSpecifierMap>> sort_and_normalise_sc
     HashMap<URL::URL, ModuleSpecifierMap> normalised;
 
     // 2. For each scopePrefix → potentialSpecifierMap of originalMap:
-    for (auto& scope_prefix : original_map.shape().property_table().keys()) {
+    for (auto& it : original_map.shape().property_table()) {
+        auto const& scope_prefix = it.key;
         auto potential_specifier_map = TRY(original_map.get(scope_prefix.as_string()));
 
         // 1. If potentialSpecifierMap is not an ordered map, then throw a TypeError indicating that the value of the scope with prefix scopePrefix needs to be a JSON object.
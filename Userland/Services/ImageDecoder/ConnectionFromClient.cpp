@@ -7,44 +7,84 @@
 #include <AK/Debug.h>
 #include <ImageDecoder/ConnectionFromClient.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
+#include <LibCore/System.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
+#include <LibGfx/Painter.h>
 
 namespace ImageDecoder {
 
+// Each client has its own ImageDecoder process, so these limits are per client, and so is the cache.
+static constexpr size_t decoded_image_cache_memory_budget = 128 * MiB;
+static constexpr size_t maximum_decoding_thread_count = 4;
+
 ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> socket)
     : IPC::ConnectionFromClient<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>(*this, move(socket), 1)
+    , m_cache(decoded_image_cache_memory_budget)
+    , m_event_loop(Core::EventLoop::current())
+    , m_decoding_thread_pool([](Function<void()> work) { work(); }, clamp(Core::System::hardware_concurrency(), 1uz, maximum_decoding_thread_count))
+{
+}
+
+ConnectionFromClient::~ConnectionFromClient()
 {
+    // The decoding threads finish all queued work before they exit, so don't leave them any.
+    m_queued_jobs.with_locked([](auto& queue) { queue.clear(); });
 }
 
 void ConnectionFromClient::die()
 {
-    for (auto& [_, job] : m_pending_jobs) {
-        job->cancel();
-    }
+    m_queued_jobs.with_locked([](auto& queue) { queue.clear(); });
+    for (auto& [_, job] : m_pending_jobs)
+        job->canceled = true;
+    for (auto& [_, job] : m_jobs_in_progress)
+        job->canceled = true;
+    m_jobs_in_progress.clear();
     m_pending_jobs.clear();
 
-    Threading::quit_background_thread();
     Core::EventLoop::current().quit(0);
 }
 
-static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>>& bitmaps, Vector<u32>& durations)
+// Frames larger than the ideal size are scaled down to fit into it right away, so the full-size frame is neither
+// kept around nor sent to the client. The bitmaps are put into anonymous buffers here, on the decoding thread,
+// so that sending them doesn't have to copy them on the main thread.
+static ErrorOr<NonnullRefPtr<Gfx::Bitmap>> prepare_bitmap_for_client(NonnullRefPtr<Gfx::Bitmap> bitmap, Optional<Gfx::IntSize> ideal_size)
+{
+    if (!ideal_size.has_value() || ideal_size->is_empty() || (bitmap->width() <= ideal_size->width() && bitmap->height() <= ideal_size->height()))
+        return bitmap->to_bitmap_backed_by_anonymous_buffer();
+
+    auto scale = min(ideal_size->width() / static_cast<float>(bitmap->width()), ideal_size->height() / static_cast<float>(bitmap->height()));
+    Gfx::IntSize scaled_size { max(1, round_to<int>(bitmap->width() * scale)), max(1, round_to<int>(bitmap->height() * scale)) };
+
+    auto scaled_bitmap = TRY(Gfx::Bitmap::create_shareable(bitmap->has_alpha_channel() ? Gfx::BitmapFormat::BGRA8888 : Gfx::BitmapFormat::BGRx8888, scaled_size));
+    Gfx::Painter painter(*scaled_bitmap);
+    painter.draw_scaled_bitmap(scaled_bitmap->rect(), *bitmap, bitmap->rect(), 1.0f, Gfx::Painter::ScalingMode::BoxSampling);
+    return scaled_bitmap;
+}
+
+static ErrorOr<void> decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>>& bitmaps, Vector<u32>& durations, Atomic<bool> const& canceled)
 {
     for (size_t i = 0; i < decoder.frame_count(); ++i) {
+        if (canceled)
+            return Error::from_errno(ECANCELED);
+
         auto frame_or_error = decoder.frame(i, ideal_size);
-        if (frame_or_error.is_error()) {
-            bitmaps.append({});
-            durations.append(0);
-        } else {
+        if (!frame_or_error.is_error()) {
             auto frame = frame_or_error.release_value();
-            bitmaps.append(frame.image.release_nonnull());
-            durations.append(frame.duration);
+            if (auto bitmap_or_error = prepare_bitmap_for_client(frame.image.release_nonnull(), ideal_size); !bitmap_or_error.is_error()) {
+                bitmaps.append(bitmap_or_error.release_value());
+                durations.append(frame.duration);
+                continue;
+            }
         }
+        bitmaps.append({});
+        durations.append(0);
     }
+    return {};
 }
 
-static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type)
+static ErrorOr<DecodeResult> decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type, Atomic<bool> const& canceled)
 {
     auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() }, known_mime_type));
 
@@ -54,7 +94,7 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
     if (!decoder->frame_count())
         return Error::from_string_literal("Could not decode image from encoded data");
 
-    ConnectionFromClient::DecodeResult result;
+    DecodeResult result;
     result.is_animated = decoder->is_animated();
     result.loop_count = decoder->loop_count();
 
@@ -70,7 +110,7 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
         }
     }
 
-    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), result.bitmaps, result.durations);
+    TRY(decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), result.bitmaps, result.durations, canceled));
 
     if (result.bitmaps.is_empty())
         return Error::from_string_literal("Could not decode image");
@@ -78,25 +118,7 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
     return result;
 }
 
-NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
-{
-    return Job::construct(
-        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type)](auto&) -> ErrorOr<DecodeResult> {
-            return TRY(decode_image_to_details(encoded_buffer, ideal_size, mime_type));
-        },
-        [strong_this = NonnullRefPtr(*this), image_id](DecodeResult result) -> ErrorOr<void> {
-            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, result.bitmaps, result.durations, result.scale);
-            strong_this->m_pending_jobs.remove(image_id);
-            return {};
-        },
-        [strong_this = NonnullRefPtr(*this), image_id](Error error) -> void {
-            if (strong_this->is_open())
-                strong_this->async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", error)));
-            strong_this->m_pending_jobs.remove(image_id);
-        });
-}
-
-Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type)
+Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type, ImageDecoder::DecodePriority const& priority)
 {
     auto image_id = m_next_image_id++;
 
@@ -106,16 +128,130 @@ Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_i
         return image_id;
     }
 
-    m_pending_jobs.set(image_id, make_decode_image_job(image_id, encoded_buffer, ideal_size, mime_type));
+    auto job = adopt_ref(*new Job(encoded_buffer, ideal_size, mime_type, priority));
+    job->image_ids.append(image_id);
+    m_pending_jobs.set(image_id, job);
+
+    // Hashing a big image takes a while too, so it's done on a decoding thread as well.
+    m_decoding_thread_pool.submit([this, job = move(job)]() mutable { hash_job(move(job)); });
 
     return image_id;
 }
 
-void ConnectionFromClient::cancel_decoding(i64 image_id)
+// This runs on a decoding thread.
+void ConnectionFromClient::hash_job(NonnullRefPtr<Job> job)
+{
+    if (job->canceled)
+        return;
+
+    auto digest = Crypto::Hash::SHA256::hash(job->encoded_buffer.data<u8>(), job->encoded_buffer.size());
+
+    m_event_loop.deferred_invoke([this, job = move(job), digest] {
+        did_hash_job(job, digest);
+    });
+    m_event_loop.wake();
+}
+
+void ConnectionFromClient::did_hash_job(NonnullRefPtr<Job> job, Crypto::Hash::SHA256::DigestType const& digest)
 {
-    if (auto job = m_pending_jobs.take(image_id); job.has_value()) {
-        job.value()->cancel();
+    if (job->canceled)
+        return;
+
+    job->key.encoded_data_digest = digest;
+
+    if (auto result = m_cache.get(job->key); result.has_value()) {
+        for (auto image_id : job->image_ids) {
+            dbgln_if(IMAGE_DECODER_DEBUG, "Image {} is in the cache", image_id);
+            m_pending_jobs.remove(image_id);
+            async_did_decode_image(image_id, result->is_animated, result->loop_count, result->bitmaps, result->durations, result->scale);
+        }
+        return;
     }
+
+    // The same image is already being decoded for another request, so wait for that.
+    if (auto it = m_jobs_in_progress.find(job->key); it != m_jobs_in_progress.end()) {
+        auto& job_in_progress = it->value;
+        for (auto image_id : job->image_ids) {
+            job_in_progress->image_ids.append(image_id);
+            m_pending_jobs.set(image_id, job_in_progress);
+        }
+        if (job->priority > job_in_progress->priority)
+            m_queued_jobs.with_locked([&](auto&) { job_in_progress->priority = job->priority; });
+        return;
+    }
+
+    m_jobs_in_progress.set(job->key, job);
+    m_queued_jobs.with_locked([&](auto& queue) { queue.append(move(job)); });
+    m_decoding_thread_pool.submit([this] { decode_next_job(); });
+}
+
+// This runs on a decoding thread, once for every job that was queued. The jobs aren't decoded in the order they were
+// queued in though, as visible images go first.
+void ConnectionFromClient::decode_next_job()
+{
+    auto job = m_queued_jobs.with_locked([](auto& queue) -> RefPtr<Job> {
+        // Canceled jobs are taken out of the queue, so the queue can run out before the calls to this do.
+        if (queue.is_empty())
+            return nullptr;
+        auto index = queue.find_first_index_if([](auto& job) { return job->priority == DecodePriority::Visible; }).value_or(0);
+        return queue.take(index);
+    });
+    if (!job)
+        return;
+
+    job->result = decode_image_to_details(job->encoded_buffer, job->key.ideal_size, job->key.mime_type, job->canceled);
+
+    m_event_loop.deferred_invoke([this, job = job.release_nonnull()] {
+        did_finish_job(*job);
+    });
+    m_event_loop.wake();
+}
+
+void ConnectionFromClient::forget_job(Job& job)
+{
+    // Jobs for the same image that are still being hashed aren't in progress yet, so make sure this is the right one.
+    if (auto it = m_jobs_in_progress.find(job.key); it != m_jobs_in_progress.end() && it->value.ptr() == &job)
+        m_jobs_in_progress.remove(it);
+}
+
+void ConnectionFromClient::did_finish_job(Job& job)
+{
+    forget_job(job);
+    for (auto image_id : job.image_ids)
+        m_pending_jobs.remove(image_id);
+
+    auto result = job.result.release_value();
+    if (result.is_error()) {
+        if (is_open()) {
+            for (auto image_id : job.image_ids)
+                async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", result.error())));
+        }
+        return;
+    }
+
+    // Even if nobody is waiting for it anymore, the image might be requested again.
+    auto decode_result = result.release_value();
+    m_cache.set(job.key, decode_result);
+    for (auto image_id : job.image_ids)
+        async_did_decode_image(image_id, decode_result.is_animated, decode_result.loop_count, decode_result.bitmaps, decode_result.durations, decode_result.scale);
+}
+
+void ConnectionFromClient::cancel_decoding(i64 image_id)
+{
+    auto maybe_job = m_pending_jobs.take(image_id);
+    if (!maybe_job.has_value())
+        return;
+
+    auto job = maybe_job.release_value();
+    job->image_ids.remove_first_matching([&](auto id) { return id == image_id; });
+    if (!job->image_ids.is_empty())
+        return;
+
+    job->canceled = true;
+    m_queued_jobs.with_locked([&](auto& queue) {
+        queue.remove_first_matching([&](auto& queued_job) { return queued_job.ptr() == job.ptr(); });
+    });
+    forget_job(*job);
 }
 
 }
@@ -6,12 +6,16 @@
 
 #pragma once
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/HashMap.h>
+#include <ImageDecoder/DecodePriority.h>
+#include <ImageDecoder/DecodedImageCache.h>
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
 #include <LibIPC/ConnectionFromClient.h>
-#include <LibThreading/BackgroundAction.h>
+#include <LibThreading/MutexProtected.h>
+#include <LibThreading/ThreadPool.h>
 
 namespace ImageDecoder {
 
@@ -20,30 +24,54 @@ class ConnectionFromClient final
     C_OBJECT(ConnectionFromClient);
 
 public:
-    ~ConnectionFromClient() override = default;
+    ~ConnectionFromClient() override;
 
     virtual void die() override;
 
-    struct DecodeResult {
-        bool is_animated = false;
-        u32 loop_count = 0;
-        Gfx::FloatPoint scale { 1, 1 };
-        Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>> bitmaps;
-        Vector<u32> durations;
-    };
-
 private:
-    using Job = Threading::BackgroundAction<DecodeResult>;
+    // Requests for the same image share one job. A job is first handed to a decoding thread to hash the encoded data,
+    // which is what the requests are matched up by, and then to decode it unless that's done or underway already.
+    // Only the decoding threads touch the result until the job is handed back to the main thread, everything else
+    // is only used on the main thread.
+    struct Job : public AtomicRefCounted<Job> {
+        Job(Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, DecodePriority priority)
+            : key { .encoded_data_digest = {}, .ideal_size = ideal_size, .mime_type = move(mime_type) }
+            , encoded_buffer(move(encoded_buffer))
+            , priority(priority)
+        {
+        }
+
+        DecodedImageKey key;
+        Core::AnonymousBuffer encoded_buffer;
+        DecodePriority priority;
+        Atomic<bool> canceled { false };
+        Optional<ErrorOr<DecodeResult>> result;
+        Vector<i64> image_ids;
+    };
 
     explicit ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket>);
 
-    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type) override;
+    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type, ImageDecoder::DecodePriority const& priority) override;
     virtual void cancel_decoding(i64 image_id) override;
 
-    NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+    void hash_job(NonnullRefPtr<Job>);
+    void did_hash_job(NonnullRefPtr<Job>, Crypto::Hash::SHA256::DigestType const&);
+    void decode_next_job();
+    void did_finish_job(Job&);
+    void forget_job(Job&);
 
     i64 m_next_image_id { 0 };
     HashMap<i64, NonnullRefPtr<Job>> m_pending_jobs;
+    HashMap<DecodedImageKey, NonnullRefPtr<Job>> m_jobs_in_progress;
+    DecodedImageCache m_cache;
+
+    // Jobs that haven't been picked up by a decoding thread yet, oldest first.
+    Threading::MutexProtected<Vector<NonnullRefPtr<Job>>> m_queued_jobs;
+
+    Core::EventLoop& m_event_loop;
+
+    // This has to come last, so that the decoding threads are gone before anything they use.
+    Threading::ThreadPool<Function<void()>> m_decoding_thread_pool;
 };
 
 }
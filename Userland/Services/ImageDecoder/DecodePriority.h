@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace ImageDecoder {
+
+// Decoding requests for visible images are started before any background request.
+enum class DecodePriority : u8 {
+    Background,
+    Visible,
+};
+
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <ImageDecoder/DecodedImageCache.h>
+
+namespace ImageDecoder {
+
+static size_t memory_usage_of(DecodeResult const& result)
+{
+    size_t memory_usage = 0;
+    for (auto const& bitmap : result.bitmaps) {
+        if (bitmap.has_value())
+            memory_usage += bitmap.value()->size_in_bytes();
+    }
+    return memory_usage;
+}
+
+Optional<DecodeResult> DecodedImageCache::get(DecodedImageKey const& key)
+{
+    auto entry = m_entries.take(key);
+    if (!entry.has_value())
+        return {};
+
+    // Put the entry back at the end, as it's now the most recently used one.
+    auto result = entry->result;
+    m_entries.set(key, entry.release_value());
+    return result;
+}
+
+void DecodedImageCache::set(DecodedImageKey const& key, DecodeResult const& result)
+{
+    if (auto entry = m_entries.take(key); entry.has_value())
+        m_memory_usage -= entry->memory_usage;
+
+    auto memory_usage = memory_usage_of(result);
+    if (memory_usage > m_memory_budget)
+        return;
+
+    evict_least_recently_used_entries(memory_usage);
+    m_entries.set(key, Entry { result, memory_usage });
+    m_memory_usage += memory_usage;
+}
+
+void DecodedImageCache::evict_least_recently_used_entries(size_t memory_needed)
+{
+    while (!m_entries.is_empty() && m_memory_usage + memory_needed > m_memory_budget) {
+        auto it = m_entries.begin();
+        m_memory_usage -= it->value.memory_usage;
+        m_entries.remove(it);
+    }
+}
+
+}
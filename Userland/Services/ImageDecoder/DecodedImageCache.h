@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Point.h>
+#include <LibGfx/Size.h>
+
+namespace ImageDecoder {
+
+struct DecodeResult {
+    bool is_animated = false;
+    u32 loop_count = 0;
+    Gfx::FloatPoint scale { 1, 1 };
+    Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>> bitmaps;
+    Vector<u32> durations;
+};
+
+// Decoding the same data with the same parameters gives the same result, so the encoded data is identified by its
+// hash. It's a cryptographic one so that different data can't be made to collide with an image that is cached.
+struct DecodedImageKey {
+    Crypto::Hash::SHA256::DigestType encoded_data_digest;
+    Optional<Gfx::IntSize> ideal_size;
+    Optional<ByteString> mime_type;
+
+    bool operator==(DecodedImageKey const&) const = default;
+};
+
+// Keeps the most recently used decoded images around, as long as their bitmaps fit into the memory budget.
+// The bitmaps are backed by anonymous buffers, so sending them to the client again doesn't copy them.
+class DecodedImageCache {
+public:
+    explicit DecodedImageCache(size_t memory_budget)
+        : m_memory_budget(memory_budget)
+    {
+    }
+
+    Optional<DecodeResult> get(DecodedImageKey const&);
+    void set(DecodedImageKey const&, DecodeResult const&);
+
+    size_t memory_usage() const { return m_memory_usage; }
+
+private:
+    struct Entry {
+        DecodeResult result;
+        size_t memory_usage { 0 };
+    };
+
+    void evict_least_recently_used_entries(size_t memory_needed);
+
+    // Ordered from least to most recently used.
+    OrderedHashMap<DecodedImageKey, Entry> m_entries;
+    size_t m_memory_budget { 0 };
+    size_t m_memory_usage { 0 };
+};
+
+}
+
+template<>
+struct AK::Traits<ImageDecoder::DecodedImageKey> : public DefaultTraits<ImageDecoder::DecodedImageKey> {
+    static unsigned hash(ImageDecoder::DecodedImageKey const& key)
+    {
+        // The digest is as good a hash as any, and the other parts of the key are nearly always the same.
+        unsigned hash = 0;
+        __builtin_memcpy(&hash, key.encoded_data_digest.data, sizeof(hash));
+        return hash;
+    }
+};
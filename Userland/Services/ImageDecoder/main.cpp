@@ -7,6 +7,7 @@
 #include <ImageDecoder/ConnectionFromClient.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/System.h>
+#include <LibGfx/ImageFormats/JPEGLoader.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
 
@@ -19,5 +20,9 @@ ErrorOr<int> serenity_main(Main::Arguments)
     auto client = TRY(IPC::take_over_accepted_client_from_system_server<ImageDecoder::ConnectionFromClient>());
 
     TRY(Core::System::pledge("stdio recvfd sendfd thread"));
+
+    // We're allowed to create threads, so let big JPEGs be decoded on several of them.
+    Gfx::JPEGImageDecoderPlugin::set_default_decoding_thread_count({});
+
     return event_loop.exec();
 }
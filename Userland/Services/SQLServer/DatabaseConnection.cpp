@@ -45,6 +45,9 @@ ErrorOr<NonnullRefPtr<DatabaseConnection>> DatabaseConnection::create(StringView
         }
     }
 
+    // Statements are only reported as done once the database was synced, see SQLStatement::execute().
+    database->set_group_commit_enabled(true);
+
     return adopt_nonnull_ref_or_enomem(new (nothrow) DatabaseConnection(move(database), move(database_name), client_id));
 }
 
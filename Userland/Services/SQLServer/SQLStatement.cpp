@@ -15,6 +15,25 @@ namespace SQLServer {
 static HashMap<SQL::StatementID, NonnullRefPtr<SQLStatement>> s_statements;
 static SQL::StatementID s_next_statement_id = 0;
 
+static HashMap<SQL::Database*, Vector<Function<void(ErrorOr<void> const&)>>> s_callbacks_waiting_for_sync;
+
+// Statements that finish executing in the same event loop iteration all wait for a single sync of their database,
+// rather than each of them syncing on its own (group commit).
+static void after_database_sync(NonnullRefPtr<SQL::Database> database, Function<void(ErrorOr<void> const&)> callback)
+{
+    auto& callbacks = s_callbacks_waiting_for_sync.ensure(database.ptr());
+    callbacks.append(move(callback));
+    if (callbacks.size() > 1)
+        return;
+
+    Core::deferred_invoke([database = move(database)] {
+        auto callbacks = s_callbacks_waiting_for_sync.take(database.ptr()).release_value();
+        auto result = database->sync();
+        for (auto& callback : callbacks)
+            callback(result);
+    });
+}
+
 RefPtr<SQLStatement> SQLStatement::statement_for(SQL::StatementID statement_id)
 {
     if (s_statements.contains(statement_id))
@@ -69,38 +88,44 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
 
     auto execution_id = m_next_execution_id++;
 
-    Core::deferred_invoke([this, strong_this = NonnullRefPtr(*this), placeholder_values = move(placeholder_values), execution_id] {
+    Core::deferred_invoke([this, strong_this = NonnullRefPtr(*this), placeholder_values = move(placeholder_values), execution_id]() mutable {
         auto execution_result = m_statement->execute(connection().database(), placeholder_values);
 
-        if (execution_result.is_error()) {
-            report_error(execution_result.release_error(), execution_id);
-            return;
-        }
-
-        auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
-        if (!client_connection) {
-            warnln("Cannot return statement execution results. Client disconnected");
-            return;
-        }
-
-        auto result = execution_result.release_value();
-        auto result_size = result.size();
-
-        if (should_send_result_rows(result)) {
-            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
-
-            m_ongoing_executions.set(execution_id, { move(result), result_size });
-            ready_for_next_result(execution_id);
-        } else {
-            if (result.command() == SQL::SQLCommand::Insert)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result_size, 0, 0);
-            else if (result.command() == SQL::SQLCommand::Update)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result_size, 0);
-            else if (result.command() == SQL::SQLCommand::Delete)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result_size);
-            else
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
-        }
+        // Only report back once the changes made by the statement are durable.
+        after_database_sync(connection().database(), [this, strong_this = move(strong_this), execution_id, execution_result = move(execution_result)](ErrorOr<void> const& sync_result) mutable {
+            if (sync_result.is_error())
+                execution_result = SQL::Result { Error::copy(sync_result.error()) };
+
+            if (execution_result.is_error()) {
+                report_error(execution_result.release_error(), execution_id);
+                return;
+            }
+
+            auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
+            if (!client_connection) {
+                warnln("Cannot return statement execution results. Client disconnected");
+                return;
+            }
+
+            auto result = execution_result.release_value();
+            auto result_size = result.size();
+
+            if (should_send_result_rows(result)) {
+                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
+
+                m_ongoing_executions.set(execution_id, { move(result), result_size });
+                ready_for_next_result(execution_id);
+            } else {
+                if (result.command() == SQL::SQLCommand::Insert)
+                    client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result_size, 0, 0);
+                else if (result.command() == SQL::SQLCommand::Update)
+                    client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result_size, 0);
+                else if (result.command() == SQL::SQLCommand::Delete)
+                    client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result_size);
+                else
+                    client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
+            }
+        });
     });
 
     return execution_id;
@@ -136,6 +161,7 @@ bool SQLStatement::should_send_result_rows(SQL::ResultSet const& result) const
 
     switch (result.command()) {
     case SQL::SQLCommand::Describe:
+    case SQL::SQLCommand::Explain:
     case SQL::SQLCommand::Select:
         return true;
     default:
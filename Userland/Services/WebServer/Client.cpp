@@ -172,11 +172,11 @@ ErrorOr<bool> Client::handle_request(HTTP::HttpRequest const& request)
         .type = TRY(String::from_utf8(Core::guess_mime_type_based_on_filename(real_path.bytes_as_string_view()))),
         .length = static_cast<u64>(TRY(FileSystem::size_from_stat(real_path.bytes_as_string_view())))
     };
-    TRY(send_response(*stream, request, move(info)));
+    TRY(send_file_response(*stream, request, move(info)));
     return true;
 }
 
-ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& request, ContentInfo content_info)
+ErrorOr<void> Client::send_response_headers(HTTP::HttpRequest const& request, ContentInfo const& content_info)
 {
     StringBuilder builder;
     TRY(builder.try_append("HTTP/1.0 200 OK\r\n"sv));
@@ -194,6 +194,38 @@ ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& r
     auto builder_contents = TRY(builder.to_byte_buffer());
     TRY(m_socket->write_until_depleted(builder_contents));
     log_response(200, request);
+    return {};
+}
+
+ErrorOr<void> Client::send_file_response(Core::File& file, HTTP::HttpRequest const& request, ContentInfo content_info)
+{
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+    auto socket_fd = m_socket->fd();
+    if (!socket_fd.has_value())
+        return Error::from_errno(EBADF);
+
+    TRY(send_response_headers(request, content_info));
+
+    // Let the kernel move the file straight into the socket instead of copying it through our buffers.
+    u64 remaining = content_info.length;
+    while (remaining > 0) {
+        auto nsent = TRY(Core::System::sendfile(*socket_fd, file.fd(), nullptr, min(remaining, static_cast<u64>(NumericLimits<ssize_t>::max()))));
+        // The file got shorter since we looked at its size.
+        if (nsent == 0)
+            break;
+        remaining -= nsent;
+    }
+
+    finish_response(request);
+    return {};
+#else
+    return send_response(file, request, move(content_info));
+#endif
+}
+
+ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& request, ContentInfo content_info)
+{
+    TRY(send_response_headers(request, content_info));
 
     char buffer[PAGE_SIZE];
     do {
@@ -213,6 +245,12 @@ ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& r
         }
     } while (true);
 
+    finish_response(request);
+    return {};
+}
+
+void Client::finish_response(HTTP::HttpRequest const& request)
+{
     auto keep_alive = false;
     if (auto it = request.headers().headers().find_if([](auto& header) { return header.name.equals_ignoring_ascii_case("Connection"sv); }); !it.is_end()) {
         if (it->value.trim_whitespace().equals_ignoring_ascii_case("keep-alive"sv))
@@ -220,8 +258,6 @@ ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& r
     }
     if (!keep_alive)
         m_socket->close();
-
-    return {};
 }
 
 ErrorOr<void> Client::send_redirect(StringView redirect_path, HTTP::HttpRequest const& request)
@@ -14,19 +14,29 @@
 #include "Window.h"
 #include "WindowManager.h"
 #include "WindowSwitcher.h"
+#include <AK/Array.h>
 #include <AK/Debug.h>
 #include <AK/Memory.h>
 #include <AK/ScopeGuard.h>
 #include <AK/TemporaryChange.h>
+#include <AK/Time.h>
+#include <LibCore/System.h>
 #include <LibCore/Timer.h>
 #include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Painter.h>
 #include <LibGfx/StylePainter.h>
 #include <LibThreading/BackgroundAction.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
 
 namespace WindowServer {
 
+// Small enough that a frame with only a few dirty rects still gives every thread some tiles, and large enough
+// that each tile is worth handing to a thread.
+static constexpr int compose_tile_size = 128;
+static constexpr unsigned max_default_compose_thread_count = 7;
+
 Compositor& Compositor::the()
 {
     static Compositor s_the;
@@ -147,6 +157,12 @@ void Compositor::did_construct_window_manager(Badge<WindowManager>)
     m_wallpaper_mode = mode_to_enum(g_config->read_entry("Background", "Mode", "Center"));
     m_custom_background_color = Color::from_string(g_config->read_entry("Background", "Color", ""));
 
+    // The compositor thread paints tiles as well, so by default there is one helper thread less than there are cores.
+    auto default_thread_count = min(max(Core::System::hardware_concurrency(), 1u) - 1, max_default_compose_thread_count);
+    m_compose_thread_count = g_config->read_num_entry<size_t>("Compositor", "Threads", default_thread_count);
+    if (m_compose_thread_count > 0)
+        m_compose_thread_pool = make<Threading::ThreadPool<Function<void()>>>([](Function<void()> work) { work(); }, m_compose_thread_count);
+
     invalidate_screen();
     invalidate_occlusions();
     compose();
@@ -180,6 +196,8 @@ void Compositor::compose()
         return;
     }
 
+    auto compose_start_time = MonotonicTime::now();
+
     if (m_occlusions_dirty) {
         m_occlusions_dirty = false;
         recompute_occlusions();
@@ -328,6 +346,11 @@ void Compositor::compose()
         }
     };
 
+    using PaintTarget = CompositorScreenData::PaintCommand::Target;
+    auto plan_paint = [](Screen& screen, PaintTarget target, Gfx::IntRect const& rect, Function<void(Gfx::Painter&)> paint) {
+        screen.compositor_screen_data().m_paint_commands.append({ target, rect, move(paint) });
+    };
+
     {
         // Paint any desktop wallpaper rects that are not somehow underneath any window transparency
         // rects and outside of any opaque window areas
@@ -338,8 +361,9 @@ void Compositor::compose()
                 if (!screen_render_rect.is_empty()) {
                     dbgln_if(COMPOSE_DEBUG, "  render wallpaper opaque: {} on screen #{}", screen_render_rect, screen.index());
                     prepare_rect(screen, render_rect);
-                    auto& back_painter = *screen.compositor_screen_data().m_back_painter;
-                    paint_wallpaper(screen, back_painter, render_rect, screen_rect);
+                    plan_paint(screen, PaintTarget::BackBuffer, render_rect, [&, render_rect, screen_rect](Gfx::Painter& painter) {
+                        paint_wallpaper(screen, painter, render_rect, screen_rect);
+                    });
                 }
                 return IterationDecision::Continue;
             });
@@ -352,8 +376,9 @@ void Compositor::compose()
                 if (!screen_render_rect.is_empty()) {
                     dbgln_if(COMPOSE_DEBUG, "  render wallpaper transparent: {} on screen #{}", screen_render_rect, screen.index());
                     prepare_transparency_rect(screen, render_rect);
-                    auto& temp_painter = *screen.compositor_screen_data().m_temp_painter;
-                    paint_wallpaper(screen, temp_painter, render_rect, screen_rect);
+                    plan_paint(screen, PaintTarget::TempBuffer, render_rect, [&, render_rect, screen_rect](Gfx::Painter& painter) {
+                        paint_wallpaper(screen, painter, render_rect, screen_rect);
+                    });
                 }
                 return IterationDecision::Continue;
             });
@@ -374,84 +399,91 @@ void Compositor::compose()
         dbgln_if(COMPOSE_DEBUG, "  window {} frame rect: {}", window.title(), frame_rect);
 
         RefPtr<Gfx::Bitmap> backing_store = window.backing_store();
-        auto compose_window_rect = [&](Screen& screen, Gfx::Painter& painter, Gfx::IntRect const& rect) {
-            if (!window.is_fullscreen()) {
-                rect.for_each_intersected(frame_rects, [&](Gfx::IntRect const& intersected_rect) {
-                    Gfx::PainterStateSaver saver(painter);
-                    painter.add_clip_rect(intersected_rect);
-                    painter.translate(transition_offset);
-                    dbgln_if(COMPOSE_DEBUG, "    render frame: {}", intersected_rect);
-                    window.frame().paint(screen, painter, intersected_rect.translated(-transition_offset));
-                    return IterationDecision::Continue;
-                });
-            }
 
-            auto update_window_rect = window_rect.intersected(rect);
-            if (update_window_rect.is_empty())
-                return;
+        // Decide where we would paint this window's backing store.
+        // This is subtly different from widow.rect(), because window
+        // size may be different from its backing store size. This
+        // happens when the window has been resized and the client
+        // has not yet attached a new backing store. In this case,
+        // we want to try to blit the backing store at the same place
+        // it was previously, and fill the rest of the window with its
+        // background color.
+        Gfx::IntRect backing_rect;
+        backing_rect.set_size(window.backing_store_visible_size());
+        switch (WindowManager::the().resize_direction_of_window(window)) {
+        case ResizeDirection::None:
+        case ResizeDirection::Right:
+        case ResizeDirection::Down:
+        case ResizeDirection::DownRight:
+            backing_rect.set_location(window_rect.location());
+            break;
+        case ResizeDirection::Left:
+        case ResizeDirection::Up:
+        case ResizeDirection::UpLeft:
+            backing_rect.set_right_without_resize(window_rect.right());
+            backing_rect.set_bottom_without_resize(window_rect.bottom());
+            break;
+        case ResizeDirection::UpRight:
+            backing_rect.set_left(window.rect().left());
+            backing_rect.set_bottom_without_resize(window_rect.bottom());
+            break;
+        case ResizeDirection::DownLeft:
+            backing_rect.set_right_without_resize(window_rect.right());
+            backing_rect.set_top(window_rect.top());
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+            break;
+        }
 
-            auto clear_window_rect = [&](Gfx::IntRect const& clear_rect) {
-                painter.fill_rect(clear_rect, wm.palette().window());
-            };
+        bool is_unresponsive = window.client() && window.client()->is_unresponsive();
+        auto window_color = wm.palette().window();
+
+        // The frame is rendered into its cache up front, so that painting it from another thread only has to blit.
+        auto compose_window_rect = [&](Screen& screen, Gfx::IntRect const& rect) -> Function<void(Gfx::Painter&)> {
+            WindowFrame::PerScaleRenderedCache* frame_cache = nullptr;
+            if (!window.is_fullscreen())
+                frame_cache = window.frame().render_to_cache(screen);
+
+            return [&frame = window.frame(), frame_cache, frame_rects, rect, transition_offset, window_rect, backing_store, backing_rect, is_unresponsive, window_color](Gfx::Painter& painter) {
+                if (frame_cache) {
+                    rect.for_each_intersected(frame_rects, [&](Gfx::IntRect const& intersected_rect) {
+                        Gfx::PainterStateSaver saver(painter);
+                        painter.add_clip_rect(intersected_rect);
+                        painter.translate(transition_offset);
+                        dbgln_if(COMPOSE_DEBUG, "    render frame: {}", intersected_rect);
+                        frame_cache->paint(frame, painter, intersected_rect.translated(-transition_offset));
+                        return IterationDecision::Continue;
+                    });
+                }
 
-            if (!backing_store) {
-                clear_window_rect(update_window_rect);
-                return;
-            }
+                auto update_window_rect = window_rect.intersected(rect);
+                if (update_window_rect.is_empty())
+                    return;
 
-            // Decide where we would paint this window's backing store.
-            // This is subtly different from widow.rect(), because window
-            // size may be different from its backing store size. This
-            // happens when the window has been resized and the client
-            // has not yet attached a new backing store. In this case,
-            // we want to try to blit the backing store at the same place
-            // it was previously, and fill the rest of the window with its
-            // background color.
-            Gfx::IntRect backing_rect;
-            backing_rect.set_size(window.backing_store_visible_size());
-            switch (WindowManager::the().resize_direction_of_window(window)) {
-            case ResizeDirection::None:
-            case ResizeDirection::Right:
-            case ResizeDirection::Down:
-            case ResizeDirection::DownRight:
-                backing_rect.set_location(window_rect.location());
-                break;
-            case ResizeDirection::Left:
-            case ResizeDirection::Up:
-            case ResizeDirection::UpLeft:
-                backing_rect.set_right_without_resize(window_rect.right());
-                backing_rect.set_bottom_without_resize(window_rect.bottom());
-                break;
-            case ResizeDirection::UpRight:
-                backing_rect.set_left(window.rect().left());
-                backing_rect.set_bottom_without_resize(window_rect.bottom());
-                break;
-            case ResizeDirection::DownLeft:
-                backing_rect.set_right_without_resize(window_rect.right());
-                backing_rect.set_top(window_rect.top());
-                break;
-            default:
-                VERIFY_NOT_REACHED();
-                break;
-            }
+                if (!backing_store) {
+                    painter.fill_rect(update_window_rect, window_color);
+                    return;
+                }
 
-            Gfx::IntRect dirty_rect_in_backing_coordinates = update_window_rect.intersected(backing_rect)
-                                                                 .translated(-backing_rect.location());
+                Gfx::IntRect dirty_rect_in_backing_coordinates = update_window_rect.intersected(backing_rect)
+                                                                     .translated(-backing_rect.location());
 
-            if (!dirty_rect_in_backing_coordinates.is_empty()) {
-                auto dst = backing_rect.location().translated(dirty_rect_in_backing_coordinates.location());
+                if (!dirty_rect_in_backing_coordinates.is_empty()) {
+                    auto dst = backing_rect.location().translated(dirty_rect_in_backing_coordinates.location());
 
-                if (window.client() && window.client()->is_unresponsive()) {
-                    painter.blit_filtered(dst, *backing_store, dirty_rect_in_backing_coordinates, [](Color src) {
-                        return src.to_grayscale().darkened(0.75f);
-                    });
-                } else {
-                    painter.blit(dst, *backing_store, dirty_rect_in_backing_coordinates);
+                    if (is_unresponsive) {
+                        painter.blit_filtered(dst, *backing_store, dirty_rect_in_backing_coordinates, [](Color src) {
+                            return src.to_grayscale().darkened(0.75f);
+                        });
+                    } else {
+                        painter.blit(dst, *backing_store, dirty_rect_in_backing_coordinates);
+                    }
                 }
-            }
 
-            for (auto background_rect : update_window_rect.shatter(backing_rect))
-                clear_window_rect(background_rect);
+                for (auto background_rect : update_window_rect.shatter(backing_rect))
+                    painter.fill_rect(background_rect, window_color);
+            };
         };
 
         auto& dirty_rects = window.dirty_rects();
@@ -476,10 +508,7 @@ void Compositor::compose()
                     dbgln_if(COMPOSE_DEBUG, "    render opaque: {} on screen #{}", screen_render_rect, screen->index());
 
                     prepare_rect(*screen, screen_render_rect);
-                    auto& back_painter = *screen->compositor_screen_data().m_back_painter;
-                    Gfx::PainterStateSaver saver(back_painter);
-                    back_painter.add_clip_rect(screen_render_rect);
-                    compose_window_rect(*screen, back_painter, screen_render_rect);
+                    plan_paint(*screen, PaintTarget::BackBuffer, screen_render_rect, compose_window_rect(*screen, screen_render_rect));
                 }
                 return IterationDecision::Continue;
             });
@@ -497,9 +526,10 @@ void Compositor::compose()
                         continue;
                     dbgln_if(COMPOSE_DEBUG, "    render wallpaper: {} on screen #{}", screen_render_rect, screen->index());
 
-                    auto& temp_painter = *screen->compositor_screen_data().m_temp_painter;
                     prepare_transparency_rect(*screen, screen_render_rect);
-                    paint_wallpaper(*screen, temp_painter, screen_render_rect, screen_rect);
+                    plan_paint(*screen, PaintTarget::TempBuffer, screen_render_rect, [&, screen, screen_render_rect, screen_rect](Gfx::Painter& painter) {
+                        paint_wallpaper(*screen, painter, screen_render_rect, screen_rect);
+                    });
                 }
                 return IterationDecision::Continue;
             });
@@ -515,10 +545,7 @@ void Compositor::compose()
                     dbgln_if(COMPOSE_DEBUG, "    render transparent: {} on screen #{}", screen_render_rect, screen->index());
 
                     prepare_transparency_rect(*screen, screen_render_rect);
-                    auto& temp_painter = *screen->compositor_screen_data().m_temp_painter;
-                    Gfx::PainterStateSaver saver(temp_painter);
-                    temp_painter.add_clip_rect(screen_render_rect);
-                    compose_window_rect(*screen, temp_painter, screen_render_rect);
+                    plan_paint(*screen, PaintTarget::TempBuffer, screen_render_rect, compose_window_rect(*screen, screen_render_rect));
                 }
                 return IterationDecision::Continue;
             });
@@ -540,7 +567,11 @@ void Compositor::compose()
                 return IterationDecision::Continue;
             });
         }
+    }
+
+    paint_planned_commands();
 
+    if (m_invalidated_window) {
         // Check that there are no overlapping transparent and opaque flush rectangles
         VERIFY(![&]() {
             bool is_overlapping = false;
@@ -599,8 +630,145 @@ void Compositor::compose()
         screen_data.draw_cursor(cursor_screen, cursor_rect);
     }
 
+    auto compose_time = MonotonicTime::now() - compose_start_time;
+
     Screen::for_each([&](auto& screen) {
+        auto& screen_data = screen.compositor_screen_data();
+        bool is_flushing = screen_data.m_have_flush_rects;
+        auto flush_start_time = MonotonicTime::now();
         flush(screen);
+        if (is_flushing) {
+            auto compose_microseconds = static_cast<u64>(compose_time.to_microseconds());
+            auto flush_microseconds = static_cast<u64>((MonotonicTime::now() - flush_start_time).to_microseconds());
+            auto& stats = screen_data.m_frame_stats;
+            ++stats.frame_count;
+            stats.total_compose_microseconds += compose_microseconds;
+            stats.max_compose_microseconds = max(stats.max_compose_microseconds, compose_microseconds);
+            stats.total_paint_microseconds += screen_data.m_paint_microseconds_this_frame.load();
+            stats.total_tile_count += screen_data.m_tile_count_this_frame;
+            stats.total_flush_microseconds += flush_microseconds;
+            stats.max_flush_microseconds = max(stats.max_flush_microseconds, flush_microseconds);
+        }
+        screen_data.m_paint_microseconds_this_frame = 0;
+        screen_data.m_tile_count_this_frame = 0;
+        return IterationDecision::Continue;
+    });
+}
+
+void Compositor::paint_planned_commands()
+{
+    struct Tile {
+        Screen* screen { nullptr };
+        Gfx::IntRect rect;
+    };
+    Vector<Tile> tiles;
+
+    Screen::for_each([&](auto& screen) {
+        auto& screen_data = screen.compositor_screen_data();
+        if (screen_data.m_paint_commands.is_empty())
+            return IterationDecision::Continue;
+
+        // Only the tiles that anything is painted into need any work.
+        auto screen_rect = screen.rect();
+        auto columns = ceil_div(screen_rect.width(), compose_tile_size);
+        auto rows = ceil_div(screen_rect.height(), compose_tile_size);
+        Vector<bool> is_tile_painted;
+        is_tile_painted.resize(columns * rows);
+        for (auto& command : screen_data.m_paint_commands) {
+            auto rect = command.rect.intersected(screen_rect).translated(-screen_rect.location());
+            if (rect.is_empty())
+                continue;
+            for (int row = rect.top() / compose_tile_size; row <= (rect.bottom() - 1) / compose_tile_size; ++row) {
+                for (int column = rect.left() / compose_tile_size; column <= (rect.right() - 1) / compose_tile_size; ++column)
+                    is_tile_painted[row * columns + column] = true;
+            }
+        }
+
+        for (int row = 0; row < rows; ++row) {
+            for (int column = 0; column < columns; ++column) {
+                if (!is_tile_painted[row * columns + column])
+                    continue;
+                Gfx::IntRect tile_rect { column * compose_tile_size, row * compose_tile_size, compose_tile_size, compose_tile_size };
+                tiles.append({ &screen, tile_rect.translated(screen_rect.location()).intersected(screen_rect) });
+                ++screen_data.m_tile_count_this_frame;
+            }
+        }
+        return IterationDecision::Continue;
+    });
+
+    // Commands are painted in the order they were planned, but as tiles don't overlap, the tiles themselves
+    // can be painted in any order.
+    auto paint_tile = [](Tile const& tile) {
+        auto start_time = MonotonicTime::now();
+        auto& screen_data = tile.screen->compositor_screen_data();
+
+        Gfx::Painter back_painter(*screen_data.m_back_bitmap);
+        Gfx::Painter temp_painter(*screen_data.m_temp_bitmap);
+        for (auto* painter : Array { &back_painter, &temp_painter }) {
+            painter->translate(-tile.screen->rect().location());
+            painter->add_clip_rect(tile.rect);
+        }
+
+        for (auto& command : screen_data.m_paint_commands) {
+            if (!command.rect.intersects(tile.rect))
+                continue;
+            auto& painter = command.target == CompositorScreenData::PaintCommand::Target::BackBuffer ? back_painter : temp_painter;
+            Gfx::PainterStateSaver saver(painter);
+            painter.add_clip_rect(command.rect);
+            command.paint(painter);
+        }
+
+        screen_data.m_paint_microseconds_this_frame += (MonotonicTime::now() - start_time).to_microseconds();
+    };
+
+    auto helper_count = min(m_compose_thread_count, tiles.size() > 0 ? tiles.size() - 1 : 0);
+    if (helper_count == 0) {
+        for (auto& tile : tiles)
+            paint_tile(tile);
+    } else {
+        Atomic<size_t> next_tile_index { 0 };
+        auto paint_remaining_tiles = [&] {
+            while (true) {
+                auto tile_index = next_tile_index.fetch_add(1);
+                if (tile_index >= tiles.size())
+                    break;
+                paint_tile(tiles[tile_index]);
+            }
+        };
+
+        Threading::Mutex mutex;
+        Threading::ConditionVariable all_helpers_done { mutex };
+        size_t busy_helpers = helper_count;
+        for (size_t i = 0; i < helper_count; ++i) {
+            m_compose_thread_pool->submit([&] {
+                paint_remaining_tiles();
+                Threading::MutexLocker locker(mutex);
+                if (--busy_helpers == 0)
+                    all_helpers_done.signal();
+            });
+        }
+
+        paint_remaining_tiles();
+
+        Threading::MutexLocker locker(mutex);
+        all_helpers_done.wait_while([&] { return busy_helpers > 0; });
+    }
+
+    Screen::for_each([&](auto& screen) {
+        screen.compositor_screen_data().m_paint_commands.clear_with_capacity();
+        return IterationDecision::Continue;
+    });
+}
+
+CompositorFrameStats const& Compositor::frame_stats(Screen& screen) const
+{
+    return screen.compositor_screen_data().m_frame_stats;
+}
+
+void Compositor::reset_frame_stats()
+{
+    Screen::for_each([&](auto& screen) {
+        screen.compositor_screen_data().m_frame_stats = {};
         return IterationDecision::Continue;
     });
 }
@@ -6,12 +6,15 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
+#include <AK/Function.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
 #include <LibCore/EventReceiver.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/DisjointRectSet.h>
 #include <LibGfx/Font/Font.h>
+#include <LibThreading/ThreadPool.h>
 #include <WindowServer/Overlays.h>
 
 namespace WindowServer {
@@ -32,6 +35,17 @@ enum class WallpaperMode {
     Unchecked
 };
 
+struct CompositorFrameStats {
+    u64 frame_count { 0 };
+    u64 total_compose_microseconds { 0 };
+    u64 max_compose_microseconds { 0 };
+    // Summed over all tiles, so this is more than the compose time when tiles are painted in parallel.
+    u64 total_paint_microseconds { 0 };
+    u64 total_tile_count { 0 };
+    u64 total_flush_microseconds { 0 };
+    u64 max_flush_microseconds { 0 };
+};
+
 struct CompositorScreenData {
     RefPtr<Gfx::Bitmap> m_front_bitmap;
     RefPtr<Gfx::Bitmap> m_back_bitmap;
@@ -55,6 +69,23 @@ struct CompositorScreenData {
     Gfx::DisjointIntRectSet m_flush_transparent_rects;
     Gfx::DisjointIntRectSet m_flush_special_rects;
 
+    // Painting is only planned while composing, and then carried out tile by tile, possibly on several threads.
+    // That is why a command must not touch anything but the painter it is given and what it has captured.
+    struct PaintCommand {
+        enum class Target {
+            BackBuffer,
+            TempBuffer,
+        };
+        Target target;
+        Gfx::IntRect rect;
+        Function<void(Gfx::Painter&)> paint;
+    };
+    Vector<PaintCommand> m_paint_commands;
+
+    CompositorFrameStats m_frame_stats;
+    Atomic<u64> m_paint_microseconds_this_frame { 0 };
+    u32 m_tile_count_this_frame { 0 };
+
     Gfx::Painter& overlay_painter() { return *m_temp_painter; }
 
     void init_bitmaps(Compositor&, Screen&);
@@ -184,6 +215,11 @@ public:
 
     void set_flash_flush(bool b) { m_flash_flush = b; }
 
+    // Not counting the compositor thread itself, which paints tiles as well.
+    size_t compose_thread_count() const { return m_compose_thread_count; }
+    CompositorFrameStats const& frame_stats(Screen&) const;
+    void reset_frame_stats();
+
     static NonnullOwnPtr<CompositorScreenData> create_screen_data(Badge<Screen>)
     {
         return adopt_own(*new CompositorScreenData());
@@ -204,6 +240,7 @@ private:
     void recompute_overlay_rects();
     void recompute_occlusions();
     void change_cursor(Cursor const*);
+    void paint_planned_commands();
     void flush(Screen&);
     Gfx::IntPoint window_transition_offset(Window&);
     void update_animations(Screen&, Gfx::DisjointIntRectSet& flush_rects);
@@ -251,6 +288,9 @@ private:
     Optional<Gfx::Color> m_custom_background_color;
 
     HashTable<Animation*> m_animations;
+
+    OwnPtr<Threading::ThreadPool<Function<void()>>> m_compose_thread_pool;
+    size_t m_compose_thread_count { 0 };
 };
 
 }
@@ -1357,6 +1357,32 @@ void ConnectionFromClient::set_flash_flush(bool enabled)
     Compositor::the().set_flash_flush(enabled);
 }
 
+Messages::WindowServer::GetCompositorStatsResponse ConnectionFromClient::get_compositor_stats(u32 screen_index)
+{
+    auto& compositor = Compositor::the();
+    auto* screen = Screen::find_by_index(screen_index);
+    if (!screen) {
+        dbgln("GetCompositorStats: Screen {} does not exist", screen_index);
+        return { 0, 0, 0, 0, 0, 0, 0, static_cast<u32>(compositor.compose_thread_count()) };
+    }
+
+    auto& stats = compositor.frame_stats(*screen);
+    auto average = [&](u64 total) { return stats.frame_count > 0 ? total / stats.frame_count : 0; };
+    return { stats.frame_count,
+        average(stats.total_compose_microseconds),
+        stats.max_compose_microseconds,
+        average(stats.total_paint_microseconds),
+        average(stats.total_tile_count),
+        average(stats.total_flush_microseconds),
+        stats.max_flush_microseconds,
+        static_cast<u32>(compositor.compose_thread_count()) };
+}
+
+void ConnectionFromClient::reset_compositor_stats()
+{
+    Compositor::the().reset_frame_stats();
+}
+
 void ConnectionFromClient::set_window_parent_from_client(i32 client_id, i32 parent_id, i32 child_id)
 {
     auto* child_window = window_from_id(child_id);
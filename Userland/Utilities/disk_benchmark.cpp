@@ -40,6 +40,7 @@ static Result average_result(Vector<Result> const& results)
 }
 
 static ErrorOr<Result> benchmark(ByteString const& filename, int file_size, ByteBuffer& buffer, bool allow_cache);
+static ErrorOr<u64> benchmark_sequential_read(ByteString const& filename, int file_size, ByteBuffer& buffer, bool readahead);
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
@@ -50,9 +51,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Vector<size_t> file_sizes;
     Vector<size_t> block_sizes;
     bool allow_cache = false;
+    bool compare_readahead = false;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(allow_cache, "Allow using disk cache", "cache", 'c');
+    args_parser.add_option(compare_readahead, "Compare sequential read throughput with readahead enabled and disabled", "readahead", 'r');
     args_parser.add_option(directory, "Path to a directory where we can store the disk benchmark temp file", "directory", 'd', "directory");
     args_parser.add_option(time_per_benchmark_sec, "Time elapsed per benchmark (seconds)", "time-per-benchmark", 't', "time-per-benchmark");
     args_parser.add_option(file_sizes, "A comma-separated list of file sizes", "file-size", 'f', "file-size");
@@ -80,6 +83,29 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 warnln("Not enough memory to allocate space for block size = {}", block_size);
                 continue;
             }
+            if (compare_readahead) {
+                for (auto readahead : { true, false }) {
+                    Vector<u64> results;
+
+                    outln("Running: file_size={} block_size={} readahead={}", file_size, block_size, readahead ? "on" : "off");
+                    auto timer = Core::ElapsedTimer::start_new();
+                    while (timer.elapsed_time() < time_per_benchmark) {
+                        out(".");
+                        fflush(stdout);
+                        results.append(TRY(benchmark_sequential_read(filename, file_size, buffer_result.value(), readahead)));
+                        usleep(100);
+                    }
+                    u64 average_read_bps = 0;
+                    for (auto read_bps : results)
+                        average_read_bps += read_bps;
+                    average_read_bps /= results.size();
+                    outln("Finished: runs={} time={}ms read_bps={}", results.size(), timer.elapsed_milliseconds(), average_read_bps);
+                }
+
+                sleep(1);
+                continue;
+            }
+
             Vector<Result> results;
 
             outln("Running: file_size={} block_size={}", file_size, block_size);
@@ -143,3 +169,42 @@ ErrorOr<Result> benchmark(ByteString const& filename, int file_size, ByteBuffer&
     result.read_bps = (u64)(timer.elapsed_milliseconds() ? (file_size / timer.elapsed_milliseconds()) : file_size) * 1000;
     return result;
 }
+
+ErrorOr<u64> benchmark_sequential_read(ByteString const& filename, int file_size, ByteBuffer& buffer, bool readahead)
+{
+    // Write the file past the disk cache, so that reading it back has to go to the disk.
+    int write_fd = TRY(Core::System::open(filename, O_CREAT | O_TRUNC | O_WRONLY | O_DIRECT, 0644));
+
+    auto unlink_file = ScopeGuard([filename] {
+        auto void_or_error = Core::System::unlink(filename);
+        if (void_or_error.is_error())
+            warnln("{}", void_or_error.release_error());
+    });
+
+    ssize_t total_written = 0;
+    while (total_written < file_size) {
+        auto nwritten = TRY(Core::System::write(write_fd, buffer));
+        total_written += nwritten;
+    }
+    TRY(Core::System::close(write_fd));
+
+    int fd = TRY(Core::System::open(filename, O_RDONLY));
+    auto fd_cleanup = ScopeGuard([fd] {
+        auto void_or_error = Core::System::close(fd);
+        if (void_or_error.is_error())
+            warnln("{}", void_or_error.release_error());
+    });
+
+    TRY(Core::System::posix_fadvise(fd, 0, 0, readahead ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_RANDOM));
+
+    auto timer = Core::ElapsedTimer::start_new();
+    ssize_t total_read = 0;
+    while (total_read < file_size) {
+        auto nread = TRY(Core::System::read(fd, buffer));
+        if (nread == 0)
+            break;
+        total_read += nread;
+    }
+
+    return (u64)(timer.elapsed_milliseconds() ? (file_size / timer.elapsed_milliseconds()) : file_size) * 1000;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/System.h>
+#include <LibMain/Main.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+// Every iteration makes one fd readable and waits for it, while all the other fds stay idle.
+struct Setup {
+    Array<int, 2> active_pipe;
+    Vector<int> idle_fds;
+};
+
+static ErrorOr<void> make_active_fd_ready(Setup const& setup)
+{
+    char byte = 0;
+    TRY(Core::System::write(setup.active_pipe[1], { &byte, 1 }));
+    return {};
+}
+
+static ErrorOr<void> consume_active_fd(Setup const& setup)
+{
+    char byte = 0;
+    TRY(Core::System::read(setup.active_pipe[0], { &byte, 1 }));
+    return {};
+}
+
+static ErrorOr<Duration> measure_poll(Setup const& setup, size_t iterations)
+{
+    Vector<pollfd> poll_fds;
+    for (auto fd : setup.idle_fds)
+        TRY(poll_fds.try_append({ .fd = fd, .events = POLLIN, .revents = 0 }));
+    TRY(poll_fds.try_append({ .fd = setup.active_pipe[0], .events = POLLIN, .revents = 0 }));
+
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    for (size_t i = 0; i < iterations; ++i) {
+        TRY(make_active_fd_ready(setup));
+        auto count = TRY(Core::System::poll(poll_fds, -1));
+        VERIFY(count == 1 && (poll_fds.last().revents & POLLIN));
+        TRY(consume_active_fd(setup));
+    }
+    return timer.elapsed_time();
+}
+
+static ErrorOr<Duration> measure_epoll(Setup const& setup, size_t iterations)
+{
+    auto epoll_fd = TRY(Core::System::epoll_create1(EPOLL_CLOEXEC));
+    for (auto fd : setup.idle_fds) {
+        epoll_event event { .events = EPOLLIN, .data = { .fd = fd } };
+        TRY(Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event));
+    }
+    epoll_event event { .events = EPOLLIN, .data = { .fd = setup.active_pipe[0] } };
+    TRY(Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, setup.active_pipe[0], &event));
+
+    Array<epoll_event, 8> ready_events;
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    for (size_t i = 0; i < iterations; ++i) {
+        TRY(make_active_fd_ready(setup));
+        auto count = TRY(Core::System::epoll_wait(epoll_fd, ready_events, -1));
+        VERIFY(count == 1 && ready_events[0].data.fd == setup.active_pipe[0]);
+        TRY(consume_active_fd(setup));
+    }
+    auto elapsed = timer.elapsed_time();
+
+    TRY(Core::System::close(epoll_fd));
+    return elapsed;
+}
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    size_t iterations = 10000;
+    size_t maximum_idle_fd_count = 512;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Compare the cost of waking up from poll() and epoll_wait() as the number of idle fds grows.");
+    args_parser.add_option(iterations, "Number of wakeups to measure for every fd count", "iterations", 'i', "count");
+    args_parser.add_option(maximum_idle_fd_count, "Largest number of idle fds to wait on", "idle", 'n', "count");
+    args_parser.parse(arguments);
+
+    if (iterations == 0) {
+        warnln("Iteration count must be positive");
+        return 1;
+    }
+
+    Setup setup;
+    setup.active_pipe = TRY(Core::System::pipe2(O_CLOEXEC));
+
+    // Nothing is ever written to this pipe, so every duplicate of its read end stays idle.
+    auto idle_pipe = TRY(Core::System::pipe2(O_CLOEXEC));
+
+    outln("{:>10} {:>14} {:>14}", "idle fds", "poll (ns)", "epoll (ns)");
+    for (size_t idle_fd_count = 0;;) {
+        while (setup.idle_fds.size() < idle_fd_count)
+            TRY(setup.idle_fds.try_append(TRY(Core::System::dup(idle_pipe[0]))));
+
+        auto poll_time = TRY(measure_poll(setup, iterations));
+        auto epoll_time = TRY(measure_epoll(setup, iterations));
+        outln("{:>10} {:>14} {:>14}", idle_fd_count, poll_time.to_nanoseconds() / static_cast<i64>(iterations), epoll_time.to_nanoseconds() / static_cast<i64>(iterations));
+
+        if (idle_fd_count >= maximum_idle_fd_count)
+            break;
+        idle_fd_count = min(max(idle_fd_count * 4, static_cast<size_t>(8)), maximum_idle_fd_count);
+    }
+
+    for (auto fd : setup.idle_fds)
+        TRY(Core::System::close(fd));
+    return 0;
+}
@@ -241,11 +241,30 @@ ErrorOr<int> serenity_main(Main::Arguments args)
             }
         }
 
+        // With several patterns (e.g. multiple -e or -F patterns) that each require some literal, a single pass over
+        // the line looking for all of those literals at once rules out most lines before any of the matchers run.
+        Optional<regex::LiteralSearcher> literal_prefilter;
+        if (regular_expressions.size() > 1) {
+            Vector<ByteString> required_literals;
+            for (auto& re : regular_expressions) {
+                auto const& literal = re.parser_result.optimization_data.required_literal;
+                if (!literal.has_value())
+                    break;
+                required_literals.append(*literal);
+            }
+            if (required_literals.size() == regular_expressions.size())
+                literal_prefilter = regex::LiteralSearcher::create(move(required_literals));
+        }
+        auto literal_case_sensitivity = case_insensitive ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive;
+
         auto matches = [&](StringView str, StringView filename, size_t line_number, bool print_filename, bool is_binary) {
             size_t last_printed_char_pos { 0 };
             if (is_binary && binary_mode == BinaryFileMode::Skip)
                 return false;
 
+            if (literal_prefilter.has_value() && !invert_match && !literal_prefilter->find(str, 0, literal_case_sensitivity).has_value())
+                return false;
+
             for (auto& re : regular_expressions) {
                 auto result = re.match(str, PosixFlags::Global);
                 if (!(result.success ^ invert_match))
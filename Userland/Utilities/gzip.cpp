@@ -7,6 +7,7 @@
 #include <AK/ByteString.h>
 #include <AK/LexicalPath.h>
 #include <LibCompress/Gzip.h>
+#include <LibCompress/ParallelDeflate.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
@@ -20,11 +21,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool keep_input_files { false };
     bool write_to_stdout { false };
     bool decompress { false };
+    Optional<size_t> thread_count;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(keep_input_files, "Keep (don't delete) input files", "keep", 'k');
     args_parser.add_option(write_to_stdout, "Write to stdout, keep original files unchanged", "stdout", 'c');
     args_parser.add_option(decompress, "Decompress", "decompress", 'd');
+    args_parser.add_option(thread_count, "Compress on this many threads (0 for one per processor)", "processes", 'p', "N");
     args_parser.add_positional_argument(filenames, "Files", "FILES", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -46,6 +49,19 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (write_to_stdout)
         keep_input_files = true;
 
+    // Keep a single thread pool around for all files.
+    OwnPtr<Compress::ParallelDeflateCompressor> parallel_compressor;
+    if (thread_count.has_value() && !decompress) {
+        if (*thread_count == 0)
+            thread_count = Core::System::hardware_concurrency();
+        parallel_compressor = TRY(Compress::ParallelDeflateCompressor::create(*thread_count));
+    }
+
+    // Every write to the compressor ends up as a gzip member of its own, so give every thread a few chunks' worth of data.
+    size_t buffer_size = 1 * MiB;
+    if (parallel_compressor)
+        buffer_size = max(buffer_size, *thread_count * 4 * Compress::ParallelDeflateCompressor::default_chunk_size);
+
     for (auto const& input_filename : filenames) {
         OwnPtr<Stream> output_stream;
 
@@ -74,13 +90,22 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         if (decompress) {
             input_stream = TRY(try_make<Compress::GzipDecompressor>(move(input_stream)));
         } else {
-            output_stream = TRY(try_make<Compress::GzipCompressor>(output_stream.release_nonnull()));
+            output_stream = TRY(try_make<Compress::GzipCompressor>(output_stream.release_nonnull(), parallel_compressor.ptr()));
         }
 
-        auto buffer = TRY(ByteBuffer::create_uninitialized(1 * MiB));
+        auto buffer = TRY(ByteBuffer::create_uninitialized(buffer_size));
 
         while (!input_stream->is_eof()) {
             auto span = TRY(input_stream->read_some(buffer));
+
+            // A read may return less than a full buffer, which would leave most of the threads without work.
+            if (parallel_compressor) {
+                while (span.size() < buffer.size() && !input_stream->is_eof()) {
+                    auto more = TRY(input_stream->read_some(buffer.bytes().slice(span.size())));
+                    span = buffer.bytes().trim(span.size() + more.size());
+                }
+            }
+
             TRY(output_stream->write_until_depleted(span));
         }
 
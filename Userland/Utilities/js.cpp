@@ -7,6 +7,7 @@
  */
 
 #include <AK/JsonValue.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ConfigFile.h>
@@ -529,14 +530,46 @@ private:
     int m_group_stack_depth { 0 };
 };
 
+static void print_gc_statistics(StringView name, JS::Heap::CollectionStatistics const& statistics)
+{
+    warnln("{} pauses: {}, total pause {} ms, longest pause {} us", name, statistics.collection_count, statistics.total_pause_time.to_milliseconds(), statistics.longest_pause_time.to_microseconds());
+    if (statistics.collection_count == 0)
+        return;
+
+    auto last_bucket = JS::Heap::CollectionStatistics::histogram_bucket_count - 1;
+    for (size_t i = 0; i <= last_bucket; ++i) {
+        auto count = statistics.pause_time_histogram[i];
+        if (count == 0)
+            continue;
+        if (i == last_bucket)
+            warn("  >= {:>6} us: ", JS::Heap::CollectionStatistics::histogram_bucket_upper_bound(i - 1).to_microseconds());
+        else
+            warn("   < {:>6} us: ", JS::Heap::CollectionStatistics::histogram_bucket_upper_bound(i).to_microseconds());
+        warnln("{:>6} {}", count, ByteString::repeated('#', min<size_t>(60, (count * 60 + statistics.collection_count - 1) / statistics.collection_count)));
+    }
+}
+
+static void print_shape_statistics(JS::Heap& heap)
+{
+    auto statistics = JS::Shape::memory_statistics(heap);
+    warnln("Shapes: {} ({} bytes)", statistics.shape_count, statistics.shape_bytes);
+    warnln("Property tables: {} ({} bytes, {} bytes without sharing)", statistics.property_table_count, statistics.property_table_bytes, statistics.unshared_property_table_bytes);
+    warnln("Transition tables: {} bytes", statistics.transition_table_bytes);
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction map_fixed"));
+    TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction map_fixed prot_exec"));
 
     bool gc_on_every_allocation = false;
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
+    bool print_gc_stats = false;
+    bool incremental_gc = false;
+    bool generational_gc = false;
+    bool print_shape_stats = false;
+    Optional<u32> jit_threshold;
     StringView evaluate_script;
     Vector<StringView> script_paths;
 
@@ -544,11 +577,17 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(JS::Bytecode::g_jit_enabled, "Compile hot code to native code", "jit", {});
+    args_parser.add_option(jit_threshold, "Number of calls and loop iterations before code is compiled (implies --jit)", "jit-threshold", {}, "count");
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(incremental_gc, "Mark the heap incrementally in between allocations", "incremental-gc", {});
+    args_parser.add_option(generational_gc, "Collect young cells separately in minor collections", "generational-gc", {});
+    args_parser.add_option(print_gc_stats, "Print garbage collection pause times on exit", "gc-stats", {});
+    args_parser.add_option(print_shape_stats, "Print the memory used by shapes on exit", "shape-stats", {});
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
@@ -556,12 +595,31 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    if (jit_threshold.has_value()) {
+        JS::Bytecode::g_jit_enabled = true;
+        JS::Bytecode::g_jit_hotness_threshold = jit_threshold.value();
+    }
+
     bool syntax_highlight = !disable_syntax_highlight;
 
     AK::set_debug_enabled(!disable_debug_printing);
     s_history_path = TRY(String::formatted("{}/.js-history", Core::StandardPaths::home_directory()));
 
     g_vm = TRY(JS::VM::create());
+    g_vm->heap().set_incremental_marking_enabled(incremental_gc);
+    g_vm->heap().set_generational_collection_enabled(generational_gc);
+
+    ScopeGuard gc_statistics_guard = [&] {
+        if (print_shape_stats)
+            print_shape_statistics(g_vm->heap());
+        if (!print_gc_stats)
+            return;
+        if (generational_gc)
+            print_gc_statistics("Minor collection"sv, g_vm->heap().minor_collection_statistics());
+        print_gc_statistics("Major collection"sv, g_vm->heap().major_collection_statistics());
+        if (incremental_gc)
+            print_gc_statistics("Incremental marking slice"sv, g_vm->heap().incremental_marking_statistics());
+    };
     g_vm->set_dynamic_imports_allowed(true);
 
     if (!disable_debug_printing) {
@@ -45,6 +45,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     u64 physical_uncommitted = json.get_u64("physical_uncommitted"sv).value_or(0);
     u32 kmalloc_call_count = json.get_u32("kmalloc_call_count"sv).value_or(0);
     u32 kfree_call_count = json.get_u32("kfree_call_count"sv).value_or(0);
+    u64 kmalloc_cache_hits = json.get_u64("kmalloc_cache_hits"sv).value_or(0);
+    u64 kmalloc_cache_misses = json.get_u64("kmalloc_cache_misses"sv).value_or(0);
+    u64 kmalloc_cache_refills = json.get_u64("kmalloc_cache_refills"sv).value_or(0);
+    u64 kmalloc_cache_drains = json.get_u64("kmalloc_cache_drains"sv).value_or(0);
 
     u64 kmalloc_bytes_total = kmalloc_allocated + kmalloc_available;
     u64 physical_pages_total = physical_allocated + physical_available;
@@ -66,5 +70,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     outln("Kmalloc call count: {}", kmalloc_call_count);
     outln("Kfree call count: {}", kfree_call_count);
     outln("Kmalloc/Kfree delta: {}", TRY(String::formatted("{:+}", kmalloc_call_count - kfree_call_count)));
+    outln("Kmalloc processor cache hits/misses: {}/{}", kmalloc_cache_hits, kmalloc_cache_misses);
+    outln("Kmalloc processor cache refills/drains: {}/{}", kmalloc_cache_refills, kmalloc_cache_drains);
     return 0;
 }
@@ -33,6 +33,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool flag_program = false;
     bool flag_wide = false;
     bool flag_extend = false;
+    bool flag_tcp_info = false;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("Display network connections");
@@ -44,6 +45,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(flag_program, "Show the PID and name of the program to which each socket belongs", "program", 'p');
     args_parser.add_option(flag_wide, "Do not truncate IP addresses by printing out the whole symbolic host", "wide", 'W');
     args_parser.add_option(flag_extend, "Display more information", "extend", 'e');
+    args_parser.add_option(flag_tcp_info, "Display TCP congestion control state", "info", 'i');
     args_parser.parse(arguments);
 
     TRY(Core::System::unveil("/sys/kernel/net", "r"));
@@ -91,6 +93,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     int state_column = -1;
     int user_column = -1;
     int program_column = -1;
+    int congestion_control_column = -1;
+    int congestion_window_column = -1;
+    int slow_start_threshold_column = -1;
+    int rtt_column = -1;
+    int rto_column = -1;
+    int retransmits_column = -1;
 
     auto add_column = [&](auto title, auto alignment, auto width) {
         columns.append({ title, alignment, width, {} });
@@ -105,6 +113,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     state_column = add_column("State", Alignment::Left, 11);
     user_column = flag_extend ? add_column("User", Alignment::Left, 4) : -1;
     program_column = flag_program ? add_column("PID/Program", Alignment::Left, 11) : -1;
+    if (flag_tcp_info) {
+        congestion_control_column = add_column("CC", Alignment::Left, 7);
+        congestion_window_column = add_column("Cwnd", Alignment::Right, 8);
+        slow_start_threshold_column = add_column("Ssthresh", Alignment::Right, 8);
+        rtt_column = add_column("RTT(ms)", Alignment::Right, 8);
+        rto_column = add_column("RTO(ms)", Alignment::Right, 7);
+        retransmits_column = add_column("Retrans", Alignment::Right, 7);
+    }
 
     auto print_column = [](auto& column, auto& string) {
         if (!column.width) {
@@ -252,6 +268,29 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 columns[user_column].buffer = TRY(get_formatted_user(origin_uid)).to_byte_string();
             if (flag_program && program_column != -1)
                 columns[program_column].buffer = get_formatted_program(origin_pid);
+            if (congestion_control_column != -1)
+                columns[congestion_control_column].buffer = if_object.get_byte_string("congestion_control"sv).value_or("-");
+            if (congestion_window_column != -1)
+                columns[congestion_window_column].buffer = TRY(String::number(if_object.get_u32("congestion_window"sv).value_or(0))).to_byte_string();
+            if (slow_start_threshold_column != -1) {
+                auto slow_start_threshold = if_object.get_u32("slow_start_threshold"sv).value_or(NumericLimits<u32>::max());
+                // The threshold starts out "arbitrarily high" (RFC 5681) until the first loss.
+                if (slow_start_threshold == NumericLimits<u32>::max())
+                    columns[slow_start_threshold_column].buffer = "-";
+                else
+                    columns[slow_start_threshold_column].buffer = TRY(String::number(slow_start_threshold)).to_byte_string();
+            }
+            if (rtt_column != -1) {
+                auto smoothed_rtt = if_object.get_u64("smoothed_rtt_us"sv);
+                if (smoothed_rtt.has_value())
+                    columns[rtt_column].buffer = ByteString::formatted("{}.{}", *smoothed_rtt / 1000, (*smoothed_rtt % 1000) / 100);
+                else
+                    columns[rtt_column].buffer = "-";
+            }
+            if (rto_column != -1)
+                columns[rto_column].buffer = TRY(String::number(if_object.get_u64("retransmission_timeout_ms"sv).value_or(0))).to_byte_string();
+            if (retransmits_column != -1)
+                columns[retransmits_column].buffer = TRY(String::number(if_object.get_u32("retransmitted_packets"sv).value_or(0))).to_byte_string();
 
             for (auto& column : columns)
                 print_column(column, column.buffer);
@@ -335,6 +374,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 columns[user_column].buffer = TRY(get_formatted_user(origin_uid)).to_byte_string();
             if (flag_program && program_column != -1)
                 columns[program_column].buffer = get_formatted_program(origin_pid);
+            for (auto column : { congestion_control_column, congestion_window_column, slow_start_threshold_column, rtt_column, rto_column, retransmits_column }) {
+                if (column != -1)
+                    columns[column].buffer = "-";
+            }
 
             for (auto& column : columns)
                 print_column(column, column.buffer);
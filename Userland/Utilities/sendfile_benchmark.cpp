@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/System.h>
+#include <LibMain/Main.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Sends the same file over a local socket a number of times, once by copying it through
+// a userspace buffer and once with sendfile(), while a child process drains the socket.
+
+static ErrorOr<void> copy_through_userspace(int out_fd, int in_fd, size_t length)
+{
+    auto buffer = TRY(ByteBuffer::create_uninitialized(64 * KiB));
+    TRY(Core::System::lseek(in_fd, 0, SEEK_SET));
+    while (length > 0) {
+        auto nread = TRY(Core::System::read(in_fd, buffer.bytes().trim(length)));
+        if (nread == 0)
+            break;
+        length -= nread;
+        auto remaining = buffer.bytes().trim(nread);
+        while (!remaining.is_empty())
+            remaining = remaining.slice(TRY(Core::System::write(out_fd, remaining)));
+    }
+    return {};
+}
+
+static ErrorOr<void> copy_with_sendfile(int out_fd, int in_fd, size_t length)
+{
+    off_t offset = 0;
+    while (length > 0) {
+        auto nsent = TRY(Core::System::sendfile(out_fd, in_fd, &offset, length));
+        if (nsent == 0)
+            break;
+        length -= nsent;
+    }
+    return {};
+}
+
+static ErrorOr<void> drain(int fd)
+{
+    auto buffer = TRY(ByteBuffer::create_uninitialized(64 * KiB));
+    while (TRY(Core::System::read(fd, buffer.bytes())) > 0)
+        ;
+    return {};
+}
+
+static ErrorOr<Duration> measure(StringView name, int in_fd, size_t length, size_t iterations, ErrorOr<void> (*copy)(int, int, size_t))
+{
+    int sockets[2];
+    TRY(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, sockets));
+
+    auto pid = TRY(Core::System::fork());
+    if (pid == 0) {
+        (void)Core::System::close(sockets[0]);
+        auto result = drain(sockets[1]);
+        _exit(result.is_error() ? 1 : 0);
+    }
+    TRY(Core::System::close(sockets[1]));
+
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    for (size_t i = 0; i < iterations; ++i)
+        TRY(copy(sockets[0], in_fd, length));
+    auto elapsed = timer.elapsed_time();
+
+    TRY(Core::System::close(sockets[0]));
+    TRY(Core::System::waitpid(pid));
+
+    auto total_bytes = static_cast<u64>(length) * iterations;
+    auto milliseconds = max(elapsed.to_milliseconds(), static_cast<i64>(1));
+    outln("{:>10}: {} ms, {} MiB/s", name, milliseconds, total_bytes * 1000 / MiB / milliseconds);
+    return elapsed;
+}
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    StringView path;
+    size_t iterations = 16;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Compare sending a file over a socket with read()/write() and with sendfile().");
+    args_parser.add_option(iterations, "Number of times to send the file", "iterations", 'i', "count");
+    args_parser.add_positional_argument(path, "File to send", "path");
+    args_parser.parse(arguments);
+
+    auto fd = TRY(Core::System::open(path, O_RDONLY | O_CLOEXEC));
+    auto length = static_cast<size_t>(TRY(Core::System::fstat(fd)).st_size);
+
+    TRY(measure("read/write"sv, fd, length, iterations, copy_through_userspace));
+    TRY(measure("sendfile"sv, fd, length, iterations, copy_with_sendfile));
+
+    TRY(Core::System::close(fd));
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/NumberFormat.h>
+#include <AK/Time.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/System.h>
+#include <LibMain/Main.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static ErrorOr<void> send_stream(u16 port, size_t block_size, Duration duration)
+{
+    auto fd = TRY(Core::System::socket(AF_INET, SOCK_STREAM, 0));
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    TRY(Core::System::connect(fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)));
+
+    auto buffer = TRY(ByteBuffer::create_zeroed(block_size));
+    auto timer = Core::ElapsedTimer::start_new();
+    while (timer.elapsed_time() < duration)
+        TRY(Core::System::write(fd, buffer));
+
+    TRY(Core::System::close(fd));
+    return {};
+}
+
+static ErrorOr<u64> receive_stream(int fd, size_t block_size)
+{
+    auto buffer = TRY(ByteBuffer::create_uninitialized(block_size));
+    u64 total_bytes = 0;
+    while (true) {
+        auto nread = TRY(Core::System::read(fd, buffer));
+        if (nread == 0)
+            break;
+        total_bytes += nread;
+    }
+    return total_bytes;
+}
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    size_t stream_count = 8;
+    size_t block_size = 64 * KiB;
+    i64 seconds = 10;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Measure the throughput of many concurrent TCP streams over the loopback adapter.");
+    args_parser.add_option(stream_count, "Number of concurrent streams", "streams", 'n', "count");
+    args_parser.add_option(block_size, "Size of every write", "block-size", 'b', "size");
+    args_parser.add_option(seconds, "How long every stream sends data (seconds)", "time", 't', "seconds");
+    args_parser.parse(arguments);
+
+    if (stream_count == 0 || block_size == 0 || seconds <= 0) {
+        warnln("Stream count, block size and time must be positive");
+        return 1;
+    }
+    auto duration = Duration::from_seconds(seconds);
+
+    auto listener = TRY(Core::System::socket(AF_INET, SOCK_STREAM, 0));
+    int option = 1;
+    TRY(Core::System::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option)));
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    TRY(Core::System::bind(listener, reinterpret_cast<sockaddr const*>(&address), sizeof(address)));
+    TRY(Core::System::listen(listener, stream_count));
+    socklen_t address_size = sizeof(address);
+    TRY(Core::System::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &address_size));
+    u16 port = ntohs(address.sin_port);
+
+    // Every receiver reports how many bytes it got through this pipe.
+    auto results = TRY(Core::System::pipe2(0));
+
+    outln("Running: streams={} block_size={} time={}s", stream_count, block_size, seconds);
+    auto timer = Core::ElapsedTimer::start_new();
+
+    for (size_t i = 0; i < stream_count; ++i) {
+        if (TRY(Core::System::fork()) == 0) {
+            if (auto result = send_stream(port, block_size, duration); result.is_error()) {
+                warnln("Sender {} failed: {}", i, result.error());
+                _exit(1);
+            }
+            _exit(0);
+        }
+    }
+
+    for (size_t i = 0; i < stream_count; ++i) {
+        auto fd = TRY(Core::System::accept(listener, nullptr, nullptr));
+        if (TRY(Core::System::fork()) == 0) {
+            auto total_bytes_or_error = receive_stream(fd, block_size);
+            if (total_bytes_or_error.is_error()) {
+                warnln("Receiver {} failed: {}", i, total_bytes_or_error.error());
+                _exit(1);
+            }
+            u64 total_bytes = total_bytes_or_error.value();
+            MUST(Core::System::write(results[1], { &total_bytes, sizeof(total_bytes) }));
+            _exit(0);
+        }
+        TRY(Core::System::close(fd));
+    }
+    TRY(Core::System::close(results[1]));
+
+    bool did_fail = false;
+    for (size_t i = 0; i < 2 * stream_count; ++i) {
+        auto result = TRY(Core::System::waitpid(-1));
+        if (!WIFEXITED(result.status) || WEXITSTATUS(result.status) != 0)
+            did_fail = true;
+    }
+    auto elapsed_milliseconds = max(timer.elapsed_milliseconds(), 1);
+
+    u64 total_bytes = 0;
+    u64 stream_bytes = 0;
+    while (TRY(Core::System::read(results[0], { &stream_bytes, sizeof(stream_bytes) })) == sizeof(stream_bytes))
+        total_bytes += stream_bytes;
+
+    outln("Finished: time={}ms received={} throughput={}/s", elapsed_milliseconds, human_readable_size(total_bytes), human_readable_size(total_bytes * 1000 / elapsed_milliseconds));
+    return did_fail ? 1 : 0;
+}
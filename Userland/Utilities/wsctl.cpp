@@ -7,17 +7,40 @@
 #include <LibCore/ArgsParser.h>
 #include <LibGUI/Application.h>
 #include <LibGUI/ConnectionToWindowServer.h>
+#include <LibGUI/Desktop.h>
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     auto app = TRY(GUI::Application::create(arguments));
 
     int flash_flush = -1;
+    bool show_stats = false;
+    bool reset_stats = false;
     Core::ArgsParser args_parser;
     args_parser.add_option(flash_flush, "Flash flush (repaint) rectangles", "flash-flush", 'f', "0/1");
+    args_parser.add_option(show_stats, "Show compositor frame times for each screen", "stats", 's');
+    args_parser.add_option(reset_stats, "Reset compositor frame times", "reset-stats", 'r');
     args_parser.parse(arguments);
 
+    auto& connection = GUI::ConnectionToWindowServer::the();
+
     if (flash_flush != -1)
-        GUI::ConnectionToWindowServer::the().async_set_flash_flush(flash_flush);
+        connection.async_set_flash_flush(flash_flush);
+
+    if (show_stats) {
+        auto to_milliseconds = [](u64 microseconds) { return static_cast<double>(microseconds) / 1000; };
+        for (u32 screen_index = 0; screen_index < GUI::Desktop::the().rects().size(); ++screen_index) {
+            auto stats = connection.get_compositor_stats(screen_index);
+            if (screen_index == 0)
+                outln("Compositor threads: {}", stats.compose_thread_count() + 1);
+            outln("Screen #{}: {} frames", screen_index, stats.frame_count());
+            outln("  Compose: {:.2} ms average, {:.2} ms max", to_milliseconds(stats.average_compose_microseconds()), to_milliseconds(stats.max_compose_microseconds()));
+            outln("  Paint:   {:.2} ms average over {} tiles", to_milliseconds(stats.average_paint_microseconds()), stats.average_tile_count());
+            outln("  Flush:   {:.2} ms average, {:.2} ms max", to_milliseconds(stats.average_flush_microseconds()), to_milliseconds(stats.max_flush_microseconds()));
+        }
+    }
+
+    if (reset_stats)
+        connection.async_reset_compositor_stats();
     return 0;
 }
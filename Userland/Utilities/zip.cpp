@@ -6,6 +6,7 @@
 
 #include <AK/LexicalPath.h>
 #include <LibArchive/Zip.h>
+#include <LibCompress/ParallelDeflate.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DateTime.h>
 #include <LibCore/DirIterator.h>
@@ -19,15 +20,17 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Vector<StringView> source_paths;
     bool recurse = false;
     bool force = false;
+    Optional<size_t> thread_count;
 
     Core::ArgsParser args_parser;
     args_parser.add_positional_argument(zip_path, "Zip file path", "zipfile", Core::ArgsParser::Required::Yes);
     args_parser.add_positional_argument(source_paths, "Input files to be archived", "files", Core::ArgsParser::Required::Yes);
     args_parser.add_option(recurse, "Travel the directory structure recursively", "recurse-paths", 'r');
     args_parser.add_option(force, "Overwrite existing zip file", "force", 'f');
+    args_parser.add_option(thread_count, "Compress on this many threads (0 for one per processor)", "processes", 'p', "N");
     args_parser.parse(arguments);
 
-    TRY(Core::System::pledge("stdio rpath wpath cpath"));
+    TRY(Core::System::pledge("stdio rpath wpath cpath thread"));
 
     auto cwd = TRY(Core::System::getcwd());
     TRY(Core::System::unveil(LexicalPath::absolute_path(cwd, zip_path), "wc"sv));
@@ -46,8 +49,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     }
 
     outln("Archive: {}", zip_path);
+    OwnPtr<Compress::ParallelDeflateCompressor> parallel_compressor;
+    if (thread_count.has_value()) {
+        if (*thread_count == 0)
+            thread_count = Core::System::hardware_concurrency();
+        parallel_compressor = TRY(Compress::ParallelDeflateCompressor::create(*thread_count));
+    }
+
     auto file_stream = TRY(Core::File::open(zip_path, Core::File::OpenMode::Write));
-    Archive::ZipOutputStream zip_stream(move(file_stream));
+    Archive::ZipOutputStream zip_stream(move(file_stream), parallel_compressor.ptr());
 
     auto add_file = [&](StringView path) -> ErrorOr<void> {
         auto canonicalized_path = TRY(String::from_byte_string(LexicalPath::canonicalized_path(path)));